@@ -15,3 +15,8 @@ FOUNDATION_EXPORT double AudioStreamingVersionNumber;
 FOUNDATION_EXPORT const unsigned char AudioStreamingVersionString[];
 
 // In this header, you should import all the public headers of your framework using statements like #import <AudioStreaming/PublicHeader.h>
+
+#import <AudioStreaming/AudioStreamingAtomics.h>
+#import <AudioStreaming/AudioStreamingMP3.h>
+#import <AudioStreaming/AudioStreamingFLAC.h>
+#import <AudioStreaming/AudioStreamingVorbis.h>
@@ -4,36 +4,147 @@
 //
 
 import Foundation
+#if SWIFT_PACKAGE
+    import AudioStreamingAtomics
+#endif
 
-final class Atomic<Value> {
-    private let lock = UnfairLock()
-    private var _value: Value
+/// A type that can be represented in a single machine word and thus be stored in an `Atomic`
+protocol AtomicWordRepresentable {
+    init(atomicWord: Int)
+    var atomicWord: Int { get }
+}
+
+/// The memory ordering semantics of an atomic load.
+enum AtomicLoadOrdering {
+    case relaxed
+    case acquiring
+    case sequentiallyConsistent
+}
+
+/// The memory ordering semantics of an atomic store.
+enum AtomicStoreOrdering {
+    case relaxed
+    case releasing
+    case sequentiallyConsistent
+}
+
+/// The memory ordering semantics of an atomic read-modify-write operation.
+enum AtomicUpdateOrdering {
+    case relaxed
+    case acquiring
+    case releasing
+    case acquiringAndReleasing
+    case sequentiallyConsistent
+}
+
+/// A lock-free atomic wrapper for word-sized values.
+///
+/// Unlike `Protected` this never takes a lock, which makes it safe to be accessed from the audio render thread.
+/// All operations take an explicit memory ordering, the defaults are acquire for loads and release for stores.
+final class Atomic<Value: AtomicWordRepresentable> {
+    private let storage: UnsafeMutablePointer<Int>
 
     init(_ value: Value) {
-        _value = value
+        storage = .allocate(capacity: 1)
+        storage.initialize(to: value.atomicWord)
+    }
+
+    deinit {
+        storage.deinitialize(count: 1)
+        storage.deallocate()
     }
 
-    var value: Value { lock.around { _value } }
+    var value: Value { load() }
+
+    @inline(__always)
+    func load(ordering: AtomicLoadOrdering = .acquiring) -> Value {
+        Value(atomicWord: as_atomic_word_load(storage, ordering.memoryOrder))
+    }
+
+    @inline(__always)
+    func store(_ value: Value, ordering: AtomicStoreOrdering = .releasing) {
+        as_atomic_word_store(storage, value.atomicWord, ordering.memoryOrder)
+    }
 
-    func write(_ transform: (inout Value) -> Void) {
-        lock.around { transform(&self._value) }
+    /// Stores the given value and returns the previous one
+    @discardableResult
+    @inline(__always)
+    func exchange(_ value: Value, ordering: AtomicUpdateOrdering = .acquiringAndReleasing) -> Value {
+        Value(atomicWord: as_atomic_word_exchange(storage, value.atomicWord, ordering.memoryOrder))
+    }
+
+    /// Stores the `desired` value only if the current value equals to `expected`
+    ///
+    /// - Returns: A tuple indicating whether the exchange occurred along with the value before the operation
+    @discardableResult
+    @inline(__always)
+    func compareExchange(expected: Value,
+                         desired: Value,
+                         ordering: AtomicUpdateOrdering = .acquiringAndReleasing) -> (exchanged: Bool, original: Value)
+    {
+        var expectedWord = expected.atomicWord
+        let exchanged = as_atomic_word_compare_exchange(storage, &expectedWord, desired.atomicWord, ordering.memoryOrder)
+        return (exchanged, Value(atomicWord: expectedWord))
     }
 }
 
-extension Atomic: Equatable where Value: Equatable {
-    static func == (lhs: Atomic, rhs: Atomic) -> Bool {
-        lhs.value == rhs.value
+extension Atomic where Value == Int {
+    /// Adds the given amount and returns the new value
+    @discardableResult
+    @inline(__always)
+    func add(_ operand: Int, ordering: AtomicUpdateOrdering = .acquiringAndReleasing) -> Int {
+        as_atomic_word_fetch_add(storage, operand, ordering.memoryOrder) &+ operand
+    }
+}
+
+// MARK: - Word Representable
+
+extension Int: AtomicWordRepresentable {
+    init(atomicWord: Int) { self = atomicWord }
+    var atomicWord: Int { self }
+}
+
+extension Bool: AtomicWordRepresentable {
+    init(atomicWord: Int) { self = atomicWord != 0 }
+    var atomicWord: Int { self ? 1 : 0 }
+}
+
+/// Stored by its bit pattern, words are 64 bits on the platforms supported
+extension Double: AtomicWordRepresentable {
+    init(atomicWord: Int) { self = Double(bitPattern: UInt64(UInt(bitPattern: atomicWord))) }
+    var atomicWord: Int { Int(Int64(bitPattern: bitPattern)) }
+}
+
+// MARK: - Memory Ordering
+
+private extension AtomicLoadOrdering {
+    var memoryOrder: as_memory_order {
+        switch self {
+        case .relaxed: return as_memory_order_relaxed
+        case .acquiring: return as_memory_order_acquire
+        case .sequentiallyConsistent: return as_memory_order_seq_cst
+        }
     }
 }
 
-extension Atomic: Hashable where Value: Hashable {
-    func hash(into hasher: inout Hasher) {
-        hasher.combine(value)
+private extension AtomicStoreOrdering {
+    var memoryOrder: as_memory_order {
+        switch self {
+        case .relaxed: return as_memory_order_relaxed
+        case .releasing: return as_memory_order_release
+        case .sequentiallyConsistent: return as_memory_order_seq_cst
+        }
     }
 }
 
-extension Atomic: Comparable where Value: Comparable {
-    static func < (lhs: Atomic<Value>, rhs: Atomic<Value>) -> Bool {
-        lhs.value < rhs.value
+private extension AtomicUpdateOrdering {
+    var memoryOrder: as_memory_order {
+        switch self {
+        case .relaxed: return as_memory_order_relaxed
+        case .acquiring: return as_memory_order_acquire
+        case .releasing: return as_memory_order_release
+        case .acquiringAndReleasing: return as_memory_order_acq_rel
+        case .sequentiallyConsistent: return as_memory_order_seq_cst
+        }
     }
 }
@@ -0,0 +1,151 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import Foundation
+
+/// Publishes immutable objects from any thread to a **single** reader, usually the audio render thread.
+///
+/// The reader never takes a lock, it loads the current pointer inside `read(_:)`.
+/// Objects replaced by `publish(_:)` are not released immediately, they are kept until the reader
+/// is known to have left any `read(_:)` that could have observed them, and then released on the
+/// `reclaimQueue`, or on the thread publishing or collecting when there is none. Set a reclaim queue
+/// when the reader's thread may publish, so that it never runs the last release. Values the reader may
+/// still observe when replaced are collected on the reclaim queue shortly after, rather than waiting
+/// for the next `publish(_:)`. Without a reclaim queue `collect()` releases them.
+///
+/// ```
+///  publisher                      reader
+///  ---------                      ------
+///  publish(B) ── swap A → B       read { A }  (epoch odd)
+///  retire A @ epoch                            (epoch even)
+///  reclaim   ── releases A once the epoch has moved on
+/// ```
+final class AtomicSnapshot<Value: AnyObject> {
+    private let pointer = Atomic<Int>(0)
+    /// Incremented when the reader enters and leaves a `read(_:)`, an odd value means the reader is inside.
+    private let epoch = Atomic<Int>(0)
+
+    private let lock = UnfairLock()
+    private var retired: [(epoch: Int, object: Unmanaged<Value>)] = []
+    private let reclaimQueue: DispatchQueue?
+    /// The delay of collecting values the reader may still observe, about a render cycle
+    private let collectDelay: DispatchTimeInterval = .milliseconds(20)
+    private var isCollectScheduled = false
+
+    init(_ value: Value? = nil, reclaimQueue: DispatchQueue? = nil) {
+        self.reclaimQueue = reclaimQueue
+        if let value = value {
+            pointer.store(Self.word(for: value))
+        }
+    }
+
+    deinit {
+        if let current = Self.unmanaged(from: pointer.load()) {
+            current.release()
+        }
+        retired.forEach { $0.object.release() }
+    }
+
+    /// Replaces the current value, the previous value is released once it is safe to do so.
+    func publish(_ value: Value?) {
+        let newWord = value.map(Self.word(for:)) ?? 0
+        let oldWord = pointer.exchange(newWord, ordering: .sequentiallyConsistent)
+        let currentEpoch = epoch.load(ordering: .sequentiallyConsistent)
+        lock.lock()
+        if let old = Self.unmanaged(from: oldWord) {
+            retired.append((currentEpoch, old))
+        }
+        let reclaimed = reclaim(currentEpoch: currentEpoch)
+        let schedulesCollect = shouldScheduleCollect()
+        lock.unlock()
+        release(reclaimed)
+        if schedulesCollect {
+            scheduleCollect()
+        }
+    }
+
+    /// Releases any retired values the reader can no longer observe.
+    func collect() {
+        let currentEpoch = epoch.load(ordering: .sequentiallyConsistent)
+        lock.lock()
+        let reclaimed = reclaim(currentEpoch: currentEpoch)
+        let schedulesCollect = shouldScheduleCollect()
+        lock.unlock()
+        release(reclaimed)
+        if schedulesCollect {
+            scheduleCollect()
+        }
+    }
+
+    /// Executes the given closure with the current value.
+    ///
+    /// - note: Must only be called from the single reader thread and must not be nested.
+    @inline(__always)
+    func read<Result>(_ body: (Value?) -> Result) -> Result {
+        epoch.add(1, ordering: .sequentiallyConsistent)
+        defer { epoch.add(1, ordering: .releasing) }
+        return body(latest())
+    }
+
+    /// Returns the most recently published value.
+    ///
+    /// - note: Only valid from inside a `read(_:)` closure, any value loaded while the reader is inside
+    /// stays alive until the closure returns.
+    @inline(__always)
+    func latest() -> Value? {
+        Self.unmanaged(from: pointer.load(ordering: .sequentiallyConsistent))?.takeUnretainedValue()
+    }
+
+    // MARK: Private
+
+    /// A value retired at an even epoch was swapped while the reader was outside, otherwise
+    /// it is safe once the reader has left the `read(_:)` it was in at the time.
+    ///
+    /// - Returns: The values that can be released, outside of the lock
+    private func reclaim(currentEpoch: Int) -> [Unmanaged<Value>] {
+        var reclaimed: [Unmanaged<Value>] = []
+        retired.removeAll { item in
+            guard item.epoch % 2 == 0 || item.epoch != currentEpoch else { return false }
+            reclaimed.append(item.object)
+            return true
+        }
+        return reclaimed
+    }
+
+    /// `true` when values are left retired and no collect is scheduled, must be called within the lock
+    private func shouldScheduleCollect() -> Bool {
+        guard reclaimQueue != nil, !retired.isEmpty, !isCollectScheduled else { return false }
+        isCollectScheduled = true
+        return true
+    }
+
+    private func scheduleCollect() {
+        reclaimQueue?.asyncAfter(deadline: .now() + collectDelay) { [weak self] in
+            guard let self = self else { return }
+            self.lock.around { self.isCollectScheduled = false }
+            self.collect()
+        }
+    }
+
+    private func release(_ objects: [Unmanaged<Value>]) {
+        guard !objects.isEmpty else { return }
+        guard let queue = reclaimQueue else {
+            objects.forEach { $0.release() }
+            return
+        }
+        queue.async {
+            objects.forEach { $0.release() }
+        }
+    }
+
+    private static func word(for value: Value) -> Int {
+        Int(bitPattern: Unmanaged.passRetained(value).toOpaque())
+    }
+
+    private static func unmanaged(from word: Int) -> Unmanaged<Value>? {
+        guard let raw = UnsafeRawPointer(bitPattern: word) else { return nil }
+        return Unmanaged<Value>.fromOpaque(raw)
+    }
+}
@@ -34,19 +34,36 @@ internal class AudioEntry {
         source.length
     }
 
+    var position: Int {
+        source.position
+    }
+
+    /// The buffer keeping the live stream of the entry, if it's time shifted
+    var timeShiftBuffer: TimeShiftBuffer? {
+        (source as? TimeShiftingSource)?.timeShiftBuffer
+    }
+
     var progress: Double {
-        lock.lock(); defer { lock.unlock() }
-        return seekTime + (Double(framesState.played) / outputAudioFormat.sampleRate)
+        seekTime + (Double(framesState.played.value) / outputAudioFormat.sampleRate)
     }
 
     var audioStreamFormat = AudioStreamBasicDescription()
 
-    /// Hold the seek time, if a seek was requested
-    var seekTime: Double
+    /// Hold the seek time, if a seek was requested, read by the render thread without locking
+    var seekTime: Double {
+        get { seekTimeState.value }
+        set { seekTimeState.store(newValue) }
+    }
+
+    private let seekTimeState = Atomic<Double>(0)
 
     private(set) var seekRequest: SeekRequest
     private(set) var audioStreamState: AudioStreamState
-    private(set) var framesState: EntryFramesState
+    let framesState: EntryFramesState
+    /// The metadata read, reported once playback reaches it
+    let metadataQueue = EntryMetadataQueue()
+    /// The startup phases of the entry, from requesting it until its first audio is rendered
+    let startupTimeline = StartupTimeline()
     private(set) var processedPacketsState: ProcessedPacketsState
 
     var packetDuration: Double {
@@ -67,7 +84,6 @@ internal class AudioEntry {
         self.outputAudioFormat = outputAudioFormat
         id = entryId
 
-        seekTime = 0.0
         seekRequest = SeekRequest()
         processedPacketsState = ProcessedPacketsState()
         framesState = EntryFramesState()
@@ -93,8 +109,8 @@ internal class AudioEntry {
     }
 
     func reset() {
-        lock.lock(); defer { lock.unlock() }
-        framesState = EntryFramesState()
+        framesState.reset()
+        metadataQueue.reset()
     }
 
     func has(same source: CoreAudioStreamSource) -> Bool {
@@ -103,6 +119,9 @@ internal class AudioEntry {
 
     func calculatedBitrate() -> Double {
         lock.lock(); defer { lock.unlock() }
+        if let bitRate = audioStreamState.bitRate, bitRate > 0 {
+            return bitRate
+        }
         let packets = processedPacketsState
         if packetDuration > 0 {
             let packetsCount = packets.count
@@ -117,7 +136,7 @@ internal class AudioEntry {
 
     func progressInFrames() -> Float {
         lock.lock(); defer { lock.unlock() }
-        return (Float(seekTime) * Float(audioStreamFormat.mSampleRate)) + Float(framesState.played)
+        return (Float(seekTime) * Float(audioStreamFormat.mSampleRate)) + Float(framesState.played.value)
     }
 
     func duration() -> Double {
@@ -8,20 +8,35 @@ import AVFoundation
 protocol AudioEntryProviding {
     func provideAudioEntry(url: URL, headers: [String: String]) -> AudioEntry
     func provideAudioEntry(url: URL) -> AudioEntry
+    func provideAudioEntry(mirrors: [URL], headers: [String: String]) -> AudioEntry
+    func provideAudioEntry(audio: InMemoryAudio) -> AudioEntry
 }
 
 final class AudioEntryProvider: AudioEntryProviding {
     private let networkingClient: NetworkingClient
     private let underlyingQueue: DispatchQueue
     private let outputAudioFormat: AVAudioFormat
+    private let hlsVariantSelection: HLSVariantSelection
+    private let timeShiftBufferSize: Int
+    private let parallelDownloadConnections: Int
+    /// The seconds of audio buffered by the player, which HLS variants are selected on
+    private let bufferedSeconds: () -> TimeInterval
 
     init(networkingClient: NetworkingClient,
          underlyingQueue: DispatchQueue,
-         outputAudioFormat: AVAudioFormat)
+         outputAudioFormat: AVAudioFormat,
+         hlsVariantSelection: HLSVariantSelection = .adaptive,
+         timeShiftBufferSize: Int = 0,
+         parallelDownloadConnections: Int = 1,
+         bufferedSeconds: @escaping () -> TimeInterval = { 0 })
     {
         self.networkingClient = networkingClient
         self.underlyingQueue = underlyingQueue
         self.outputAudioFormat = outputAudioFormat
+        self.hlsVariantSelection = hlsVariantSelection
+        self.timeShiftBufferSize = timeShiftBufferSize
+        self.parallelDownloadConnections = parallelDownloadConnections
+        self.bufferedSeconds = bufferedSeconds
     }
 
     func provideAudioEntry(url: URL, headers: [String: String]) -> AudioEntry {
@@ -35,21 +50,72 @@ final class AudioEntryProvider: AudioEntryProviding {
         provideAudioEntry(url: url, headers: [:])
     }
 
-    func provideAudioSource(url: URL, headers: [String: String]) -> AudioStreamSource {
+    func provideAudioEntry(mirrors: [URL], headers: [String: String]) -> AudioEntry {
+        AudioEntry(source: provideMirroredAudioSource(playlistURL: nil, mirrors: mirrors, headers: headers),
+                   entryId: AudioEntryId(id: mirrors.first?.absoluteString ?? ""),
+                   outputAudioFormat: outputAudioFormat)
+    }
+
+    func provideAudioEntry(audio: InMemoryAudio) -> AudioEntry {
+        AudioEntry(source: MemoryAudioSource(audio: audio, underlyingQueue: underlyingQueue),
+                   entryId: AudioEntryId(id: audio.id),
+                   outputAudioFormat: outputAudioFormat)
+    }
+
+    /// - parameter retriesOnError: `false` reports the transport errors, eg. for another mirror to be failed over to
+    func provideAudioSource(url: URL, headers: [String: String], retriesOnError: Bool = true) -> AudioStreamSource {
         RemoteAudioSource(networking: networkingClient,
                           url: url,
                           underlyingQueue: underlyingQueue,
-                          httpHeaders: headers)
+                          httpHeaders: headers,
+                          timeShiftBufferSize: timeShiftBufferSize,
+                          segmentedDownloadPolicy: parallelDownloadConnections > 1
+                              ? SegmentedDownloadPolicy(maximumConnections: parallelDownloadConnections)
+                              : nil,
+                          retriesOnError: retriesOnError)
     }
 
     func provideFileAudioSource(url: URL) -> CoreAudioStreamSource {
-        FileAudioSource(url: url, underlyingQueue: underlyingQueue)
+        guard MappedFileAudioSource.canMap(url: url) else {
+            return FileAudioSource(url: url, underlyingQueue: underlyingQueue)
+        }
+        return MappedFileAudioSource(url: url, underlyingQueue: underlyingQueue)
+    }
+
+    func provideHLSAudioSource(url: URL, headers: [String: String]) -> CoreAudioStreamSource {
+        HLSAudioSource(networking: networkingClient,
+                       url: url,
+                       underlyingQueue: underlyingQueue,
+                       httpHeaders: headers,
+                       variantPolicy: hlsVariantSelection.makePolicy(),
+                       bufferedSeconds: bufferedSeconds)
+    }
+
+    func provideMirroredAudioSource(playlistURL: URL?, mirrors: [URL], headers: [String: String])
+        -> CoreAudioStreamSource
+    {
+        MirroredAudioSource(networking: networkingClient,
+                            playlistURL: playlistURL,
+                            mirrors: mirrors,
+                            underlyingQueue: underlyingQueue,
+                            httpHeaders: headers) { mirror in
+            // a mirror listing another playlist isn't followed, a mirror failing is failed over from, not retried
+            HLSAudioSource.canPlay(url: mirror)
+                ? self.provideHLSAudioSource(url: mirror, headers: headers)
+                : self.provideAudioSource(url: mirror, headers: headers, retriesOnError: false)
+        }
     }
 
     func source(for url: URL, headers: [String: String]) -> CoreAudioStreamSource {
         guard !url.isFileURL else {
             return provideFileAudioSource(url: url)
         }
+        if MirroredAudioSource.canPlay(url: url) {
+            return provideMirroredAudioSource(playlistURL: url, mirrors: [], headers: headers)
+        }
+        if HLSAudioSource.canPlay(url: url) {
+            return provideHLSAudioSource(url: url, headers: headers)
+        }
         return provideAudioSource(url: url, headers: headers)
     }
 }
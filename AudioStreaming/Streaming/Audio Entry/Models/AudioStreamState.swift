@@ -11,5 +11,7 @@ final class AudioStreamState {
     var dataByteCount: UInt64?
     var dataPacketOffset: UInt64?
     var dataPacketCount: Double = 0
+    /// The average bitrate in bits per second as reported by the stream, preferred over the estimate from the processed packets
+    var bitRate: Double?
     var streamFormat = AudioStreamBasicDescription()
 }
@@ -5,8 +5,16 @@
 
 import Foundation
 
+/// The frame counters of an entry, these are read and updated from the render thread without locking.
 final class EntryFramesState {
-    var queued: Int = 0
-    var played: Int = 0
-    var lastFrameQueued: Int = -1
+    let queued = Atomic<Int>(0)
+    let played = Atomic<Int>(0)
+    let lastFrameQueued = Atomic<Int>(-1)
+
+    /// Resets the counters in place, the object itself is shared with the render thread.
+    func reset() {
+        queued.store(0)
+        played.store(0)
+        lastFrameQueued.store(-1)
+    }
 }
@@ -0,0 +1,68 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import Foundation
+
+/// The metadata read for an entry, held until playback reaches the frame it was read at.
+///
+/// Metadata is read along with the audio, ahead of playback by the audio buffered, it's queued at the frames queued
+/// when read and the render thread reports it once `EntryFramesState.played` crosses that frame.
+final class EntryMetadataQueue {
+    /// The frame of the earliest metadata queued, `Int.max` once reported or while empty, read by the render thread
+    /// without locking
+    let nextFrame = Atomic<Int>(.max)
+
+    /// The metadata kept, the oldest is dropped when more is read ahead of playback
+    private let capacity: Int
+    private let lock = UnfairLock()
+    private var items: [(frame: Int, metadata: [String: String])] = []
+
+    init(capacity: Int = 16) {
+        self.capacity = max(capacity, 1)
+    }
+
+    var isEmpty: Bool {
+        lock.around { items.isEmpty }
+    }
+
+    /// Queues the metadata read at the given frame, frames only grow between resets
+    func enqueue(_ metadata: [String: String], at frame: Int) {
+        lock.around {
+            items.append((frame, metadata))
+            if items.count > capacity {
+                items.removeFirst(items.count - capacity)
+            }
+            nextFrame.store(items[0].frame)
+        }
+    }
+
+    /// Removes the metadata playback reached, in the order it was read
+    ///
+    /// - parameter playedFrame: The frames played of the entry
+    func dequeue(reachedAt playedFrame: Int) -> [[String: String]] {
+        lock.around { () -> [[String: String]] in
+            let count = items.firstIndex(where: { $0.frame > playedFrame }) ?? items.count
+            let reached = items.prefix(count).map { $0.metadata }
+            items.removeFirst(count)
+            nextFrame.store(items.first?.frame ?? .max)
+            return reached
+        }
+    }
+
+    /// Claims the metadata playback reached from the render thread, `true` once per arming of `nextFrame`
+    @inline(__always)
+    func claim(playedFrame: Int) -> Bool {
+        let frame = nextFrame.value
+        guard playedFrame >= frame else { return false }
+        return nextFrame.compareExchange(expected: frame, desired: .max).exchanged
+    }
+
+    func reset() {
+        lock.around {
+            items.removeAll()
+            nextFrame.store(.max)
+        }
+    }
+}
@@ -10,4 +10,6 @@ final class SeekRequest {
     var requested: Bool = false
     var version = Protected<Int>(0)
     var time: Double = 0
+    /// The seconds behind the live edge of a time shifted stream to seek to, rather than `time`
+    var secondsBehindLive: Double?
 }
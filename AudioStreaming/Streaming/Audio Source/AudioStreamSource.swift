@@ -49,3 +49,8 @@ protocol AudioStreamSource: CoreAudioStreamSource {
     /// A `MetadataStreamSource` object that handles the metadata parsing
     var metadataStreamProcessor: MetadataStreamSource { get }
 }
+
+protocol TimeShiftingSource: CoreAudioStreamSource {
+    /// The buffer keeping a live stream so it can be paused and rewound, `nil` unless the stream is time shifted
+    var timeShiftBuffer: TimeShiftBuffer? { get }
+}
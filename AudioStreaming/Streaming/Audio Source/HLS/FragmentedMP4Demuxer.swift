@@ -0,0 +1,263 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import AudioToolbox
+import Foundation
+
+/// Extracts the AAC samples of fragmented MP4 segments as ADTS frames.
+///
+/// The audio specific config of the `esds` box of the initialization section provides the ADTS header fields, the
+/// `moof` boxes of the segments the sizes of the samples of the following `mdat` box. Each fragment is demuxed once
+/// its `mdat` box has been received.
+final class FragmentedMP4Demuxer: HLSSegmentDemuxer {
+    let fileType: AudioFileTypeID? = kAudioFileAAC_ADTSType
+
+    private struct AudioSpecificConfig {
+        let objectType: Int
+        let frequencyIndex: Int
+        let channelConfiguration: Int
+    }
+
+    private struct TrackFragment {
+        /// The offset of the samples in the segment
+        let dataOffset: Int
+        let sampleSizes: [Int]
+    }
+
+    private let config: AudioSpecificConfig
+
+    /// The bytes of an incomplete box
+    private var pending: [UInt8] = []
+    /// The offset of the first pending byte in the segment
+    private var segmentOffset = 0
+    private var fragment: TrackFragment?
+
+    /// Creates a demuxer for the segments of an initialization section
+    /// - parameter initializationData: The initialization section, `nil` is returned unless it has an AAC track
+    init?(initializationData: Data) {
+        let bytes = [UInt8](initializationData)
+        guard let config = FragmentedMP4Demuxer.audioSpecificConfig(in: bytes) else { return nil }
+        self.config = config
+    }
+
+    func startSegment() {
+        pending.removeAll(keepingCapacity: true)
+        segmentOffset = 0
+        fragment = nil
+    }
+
+    func demux(_ data: Data) -> Data {
+        pending.append(contentsOf: data)
+        var output = Data()
+        var offset = 0
+        while let box = FragmentedMP4Demuxer.box(in: pending, at: offset, end: pending.count),
+              offset + box.size <= pending.count
+        {
+            switch box.type {
+            case "moof":
+                fragment = trackFragment(in: pending, box: box, segmentOffset: segmentOffset + offset)
+            case "mdat":
+                if let fragment = fragment {
+                    appendSamples(of: fragment, mdat: box, mdatOffset: segmentOffset + offset, into: &output)
+                }
+                fragment = nil
+            default:
+                break
+            }
+            offset += box.size
+        }
+        pending.removeFirst(offset)
+        segmentOffset += offset
+        return output
+    }
+
+    // MARK: Fragments
+
+    private func trackFragment(in bytes: [UInt8], box moof: Box, segmentOffset: Int) -> TrackFragment? {
+        guard let traf = FragmentedMP4Demuxer.find(["traf"], in: bytes, start: moof.payloadOffset, end: moof.end),
+              let tfhd = FragmentedMP4Demuxer.find(["tfhd"], in: bytes, start: traf.payloadOffset, end: traf.end),
+              let trun = FragmentedMP4Demuxer.find(["trun"], in: bytes, start: traf.payloadOffset, end: traf.end)
+        else { return nil }
+
+        var reader = ByteReader(bytes: bytes, offset: tfhd.payloadOffset, end: tfhd.end)
+        let headerFlags = reader.read(4) & 0xFF_FFFF
+        reader.skip(4) // track id
+        // the samples are relative to the base data offset, or to the `moof` box by default
+        var baseOffset = segmentOffset
+        if headerFlags & 0x01 != 0 { baseOffset = reader.read(8) }
+        if headerFlags & 0x02 != 0 { reader.skip(4) }
+        if headerFlags & 0x08 != 0 { reader.skip(4) }
+        let defaultSampleSize = headerFlags & 0x10 != 0 ? reader.read(4) : 0
+
+        reader = ByteReader(bytes: bytes, offset: trun.payloadOffset, end: trun.end)
+        let runFlags = reader.read(4) & 0xFF_FFFF
+        let sampleCount = reader.read(4)
+        let dataOffset = runFlags & 0x01 != 0 ? Int(Int32(truncatingIfNeeded: reader.read(4))) : 0
+        if runFlags & 0x04 != 0 { reader.skip(4) }
+        var sampleSizes: [Int] = []
+        sampleSizes.reserveCapacity(sampleCount)
+        for _ in 0 ..< sampleCount where !reader.isAtEnd {
+            if runFlags & 0x100 != 0 { reader.skip(4) }
+            sampleSizes.append(runFlags & 0x200 != 0 ? reader.read(4) : defaultSampleSize)
+            if runFlags & 0x400 != 0 { reader.skip(4) }
+            if runFlags & 0x800 != 0 { reader.skip(4) }
+        }
+        return TrackFragment(dataOffset: baseOffset + dataOffset, sampleSizes: sampleSizes)
+    }
+
+    private func appendSamples(of fragment: TrackFragment, mdat: Box, mdatOffset: Int, into output: inout Data) {
+        // the position of the samples in the pending bytes
+        var position = mdat.offset + fragment.dataOffset - mdatOffset
+        for size in fragment.sampleSizes {
+            guard position >= mdat.payloadOffset, position + size <= mdat.end else { break }
+            output.append(contentsOf: adtsHeader(frameLength: size + 7))
+            output.append(contentsOf: pending[position ..< position + size])
+            position += size
+        }
+    }
+
+    private func adtsHeader(frameLength: Int) -> [UInt8] {
+        let profile = config.objectType - 1
+        let channels = config.channelConfiguration
+        return [
+            0xFF,
+            0xF1,
+            UInt8(profile << 6 | config.frequencyIndex << 2 | channels >> 2),
+            UInt8((channels & 0x03) << 6 | frameLength >> 11),
+            UInt8((frameLength >> 3) & 0xFF),
+            UInt8((frameLength & 0x07) << 5 | 0x1F),
+            0xFC,
+        ]
+    }
+
+    // MARK: Initialization section
+
+    private static func audioSpecificConfig(in bytes: [UInt8]) -> AudioSpecificConfig? {
+        let path = ["moov", "trak", "mdia", "minf", "stbl", "stsd", "mp4a", "esds"]
+        guard let esds = find(path, in: bytes, start: 0, end: bytes.count) else { return nil }
+        var reader = ByteReader(bytes: bytes, offset: esds.payloadOffset, end: esds.end)
+        reader.skip(4) // version and flags
+        guard reader.readDescriptor() == 0x03 else { return nil }
+        reader.skip(3) // ES id and flags
+        guard reader.readDescriptor() == 0x04 else { return nil }
+        reader.skip(13) // object type, stream type, buffer size and bitrates
+        guard reader.readDescriptor() == 0x05, reader.remaining >= 2 else { return nil }
+
+        let first = reader.read(1)
+        let second = reader.read(1)
+        var objectType = first >> 3
+        let frequencyIndex = (first & 0x07) << 1 | second >> 7
+        let channelConfiguration = (second >> 3) & 0x0F
+        if objectType == 5 || objectType == 29, reader.remaining >= 1 {
+            // explicit SBR signalling, the extension sampling frequency is followed by the core object type
+            let third = reader.read(1)
+            objectType = ((second << 8 | third) >> 2) & 0x1F
+        }
+        // ADTS can't carry escaped sample rates, channel layouts of a program config element or object types above 4
+        guard (1 ... 4).contains(objectType), frequencyIndex < 13, channelConfiguration > 0 else { return nil }
+        return AudioSpecificConfig(objectType: objectType,
+                                   frequencyIndex: frequencyIndex,
+                                   channelConfiguration: channelConfiguration)
+    }
+
+    // MARK: Boxes
+
+    private struct Box {
+        let type: String
+        let offset: Int
+        let headerSize: Int
+        let size: Int
+
+        var payloadOffset: Int {
+            offset + headerSize + FragmentedMP4Demuxer.skippedPayloadSize(of: type)
+        }
+
+        var end: Int {
+            offset + size
+        }
+    }
+
+    /// The bytes preceding the child boxes of the container boxes that aren't plain containers
+    private static func skippedPayloadSize(of type: String) -> Int {
+        switch type {
+        case "stsd": return 8 // version, flags and entry count
+        case "mp4a": return 28 // the audio sample entry fields
+        default: return 0
+        }
+    }
+
+    /// The box at an offset, whose header must be available, its size may exceed the available bytes
+    private static func box(in bytes: [UInt8], at offset: Int, end: Int) -> Box? {
+        guard offset + 8 <= end else { return nil }
+        var reader = ByteReader(bytes: bytes, offset: offset, end: end)
+        var size = reader.read(4)
+        let type = String(decoding: bytes[offset + 4 ..< offset + 8], as: UTF8.self)
+        reader.skip(4)
+        var headerSize = 8
+        if size == 1 {
+            guard offset + 16 <= end else { return nil }
+            size = reader.read(8)
+            headerSize = 16
+        } else if size == 0 {
+            size = end - offset
+        }
+        guard size >= headerSize else { return nil }
+        return Box(type: type, offset: offset, headerSize: headerSize, size: size)
+    }
+
+    /// Finds a box by following the path of box types from the boxes between `start` and `end`
+    private static func find(_ path: [String], in bytes: [UInt8], start: Int, end: Int) -> Box? {
+        guard let type = path.first else { return nil }
+        var offset = start
+        while let box = box(in: bytes, at: offset, end: end), box.end <= end {
+            if box.type == type {
+                if path.count == 1 { return box }
+                if let child = find(Array(path.dropFirst()), in: bytes, start: box.payloadOffset, end: box.end) {
+                    return child
+                }
+            }
+            offset = box.end
+        }
+        return nil
+    }
+
+    /// Reads big endian values, reading past the end yields zeros
+    private struct ByteReader {
+        let bytes: [UInt8]
+        var offset: Int
+        let end: Int
+
+        var remaining: Int {
+            max(end - offset, 0)
+        }
+
+        var isAtEnd: Bool {
+            offset >= end
+        }
+
+        mutating func read(_ count: Int) -> Int {
+            var value = 0
+            for index in offset ..< offset + count {
+                value = value << 8 | (index < end ? Int(bytes[index]) : 0)
+            }
+            offset += count
+            return value
+        }
+
+        mutating func skip(_ count: Int) {
+            offset += count
+        }
+
+        /// Reads the tag and the size of an MPEG-4 descriptor, the size is skipped
+        mutating func readDescriptor() -> Int {
+            let tag = read(1)
+            var sizeBytes = 1
+            while sizeBytes < 4, read(1) & 0x80 != 0 {
+                sizeBytes += 1
+            }
+            return tag
+        }
+    }
+}
@@ -0,0 +1,612 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import AudioToolbox
+import Foundation
+
+/// Plays HTTP Live Streaming audio, delivering the demuxed segments of a media playlist as one continuous stream.
+///
+/// Up to `prefetchCount` segments are downloaded ahead of the one being delivered, over the connections the shared
+/// session keeps alive. Segments are delivered in order, the one being delivered as its bytes arrive. Live playlists
+/// are reloaded as they are updated, starting a few segments before their live edge.
+///
+/// The variant of a master playlist is selected by a `HLSVariantSelectionPolicy` before each segment, given the
+/// throughput of the segment downloads and the buffered audio. Switching takes effect at the next segment to be
+/// downloaded, the segments of both variants being aligned by their sequence numbers.
+///
+/// Offsets are those of the demuxed stream. Seeking within a delivered segment is byte accurate, seeking past them
+/// starts at the segment estimated from the bitrate of the delivered segments.
+final class HLSAudioSource: CoreAudioStreamSource {
+    /// The segments from the end of a live playlist at which playback starts
+    static let liveEdgeSegmentCount = 3
+
+    /// `true` for the URLs of HLS playlists, the source of other URLs is `RemoteAudioSource`
+    static func canPlay(url: URL) -> Bool {
+        url.pathExtension.lowercased() == "m3u8"
+    }
+
+    weak var delegate: AudioStreamSourceDelegate?
+
+    private(set) var position: Int = 0
+
+    var length: Int {
+        guard let playlist = playlist, playlist.isEndList, deliveredDuration > 0 else { return 0 }
+        return Int(playlist.duration * Double(deliveredSegmentBytes) / deliveredDuration)
+    }
+
+    var audioFileHint: AudioFileTypeID {
+        demuxer?.fileType ?? kAudioFileAAC_ADTSType
+    }
+
+    let underlyingQueue: DispatchQueue
+    /// The number of segments downloaded at once
+    let prefetchCount: Int
+    /// The attempts to download a segment before failing
+    let maxAttempts = 3
+
+    private let url: URL
+    private let networkingClient: NetworkingClient
+    private let additionalRequestHeaders: [String: String]
+    private let streamOperationQueue: OperationQueue
+
+    private let variantPolicy: HLSVariantSelectionPolicy
+    private let throughputMeter: HLSThroughputMeter
+    /// The seconds of audio buffered by the player, ahead of the delivered bytes
+    private let playbackBufferedSeconds: () -> TimeInterval
+
+    /// The variants of the master playlist, ordered by ascending bandwidth
+    private var variants: [HLSVariant] = []
+    /// The variant of the current media playlist
+    private var variantIndex = 0
+    /// The media playlists of the variants played before, kept for on demand playlists
+    private var variantPlaylists: [Int: HLSMediaPlaylist] = [:]
+    /// The variants whose media playlist failed to load, which aren't switched to
+    private var unavailableVariants: Set<Int> = []
+    private var variantRequest: NetworkDataStream?
+
+    private var mediaPlaylistURL: URL?
+    private var playlist: HLSMediaPlaylist?
+    private var playlistRequest: NetworkDataStream?
+    private var reloadWorkItem: DispatchWorkItem?
+    /// `false` when the last reload of a live playlist found no new segments
+    private var hasChanged = true
+
+    /// The sequence number of the next segment to download
+    private var nextSequenceNumber = 0
+    /// The segments being downloaded, in order, the first one being delivered
+    private var downloads: [SegmentDownload] = []
+    private var initializationSections: [HLSInitializationSection: Data] = [:]
+    private var initializationRequests: [HLSInitializationSection: NetworkDataStream] = [:]
+
+    private var demuxer: HLSSegmentDemuxer?
+    private var demuxerSection: HLSInitializationSection?
+    private var demuxerVariantIndex: Int?
+    /// The demuxed bytes to drop before delivering, when seeking within a segment
+    private var bytesToSkip = 0
+    /// The delivered segments, by sequence number
+    private var deliveredSegments: [Int: DeliveredSegment] = [:]
+    private var deliveredSegmentBytes = 0
+    private var deliveredDuration: TimeInterval = 0
+
+    private var isOpen = false
+    private var hasReachedEnd = false
+
+    init(networking: NetworkingClient,
+         url: URL,
+         underlyingQueue: DispatchQueue,
+         httpHeaders: [String: String],
+         prefetchCount: Int = 3,
+         variantPolicy: HLSVariantSelectionPolicy = HLSVariantSelection.adaptive.makePolicy(),
+         throughputMeter: HLSThroughputMeter = HLSThroughputMeter(),
+         bufferedSeconds: @escaping () -> TimeInterval = { 0 })
+    {
+        networkingClient = networking
+        self.url = url
+        self.underlyingQueue = underlyingQueue
+        additionalRequestHeaders = httpHeaders
+        self.prefetchCount = max(prefetchCount, 1)
+        self.variantPolicy = variantPolicy
+        self.throughputMeter = throughputMeter
+        playbackBufferedSeconds = bufferedSeconds
+        streamOperationQueue = OperationQueue()
+        streamOperationQueue.underlyingQueue = underlyingQueue
+        streamOperationQueue.maxConcurrentOperationCount = 1
+        streamOperationQueue.name = "hls.audio.source.stream.queue"
+    }
+
+    func close() {
+        isOpen = false
+        reloadWorkItem?.cancel()
+        reloadWorkItem = nil
+        streamOperationQueue.cancelAllOperations()
+        cancel(playlistRequest)
+        playlistRequest = nil
+        cancel(variantRequest)
+        variantRequest = nil
+        initializationRequests.values.forEach(cancel)
+        initializationRequests.removeAll()
+        downloads.forEach {
+            cancel($0.request)
+            endMeasuring($0)
+        }
+        downloads.removeAll()
+    }
+
+    func seek(at offset: Int) {
+        close()
+        isOpen = true
+        hasReachedEnd = false
+        position = offset
+        bytesToSkip = 0
+        if playlist == nil {
+            loadPlaylist(url: mediaPlaylistURL ?? url)
+        } else {
+            start(at: offset)
+        }
+    }
+
+    func suspend() {
+        throughputMeter.pause()
+        streamOperationQueue.isSuspended = true
+        downloads.forEach { $0.request?.suspend() }
+    }
+
+    func resume() {
+        downloads.forEach { _ = $0.request?.resume() }
+        streamOperationQueue.isSuspended = false
+    }
+
+    // MARK: Playlists
+
+    private func loadPlaylist(url: URL) {
+        playlistRequest = fetch(url: url, byteRange: nil) { [weak self] result in
+            guard let self = self else { return }
+            self.playlistRequest = nil
+            switch result {
+            case let .success(data):
+                self.playlistLoaded(data, url: url)
+            case let .failure(error):
+                if let playlist = self.playlist, !playlist.isEndList {
+                    // a failed reload is retried, the segments already listed keep playing meanwhile
+                    self.scheduleReload()
+                } else {
+                    self.delegate?.errorOccured(source: self, error: error)
+                }
+            }
+        }
+    }
+
+    private func playlistLoaded(_ data: Data, url: URL) {
+        let parser = HLSPlaylistParser(url: url)
+        switch parser.parse(input: String(decoding: data, as: UTF8.self)) {
+        case let .success(.master(master)):
+            guard let first = master.variants.first else { return }
+            variants = master.variants.sorted { $0.selectionBandwidth < $1.selectionBandwidth }
+            // playback starts with the first variant listed, unless the policy selects another one
+            variantIndex = selectedVariantIndex(current: variants.firstIndex(of: first) ?? 0)
+            loadPlaylist(url: variants[variantIndex].url)
+        case let .success(.media(mediaPlaylist)):
+            // a reload of the playlist of a variant switched from
+            guard playlist == nil || url == mediaPlaylistURL else { return }
+            mediaPlaylistURL = url
+            if playlist == nil {
+                playlist = mediaPlaylist
+                start(at: position)
+            } else {
+                update(with: mediaPlaylist)
+                if !mediaPlaylist.isEndList {
+                    scheduleReload()
+                }
+            }
+        case let .failure(error):
+            Logger.error("hls playlist error: %@", category: .networking, args: String(describing: error))
+            delegate?.errorOccured(source: self, error: error)
+        }
+    }
+
+    /// Merges a reloaded live playlist, whose segments are identified by their sequence numbers
+    private func update(with newPlaylist: HLSMediaPlaylist) {
+        let lastSequenceNumber = playlist?.segments.last?.sequenceNumber
+        hasChanged = newPlaylist.segments.last?.sequenceNumber != lastSequenceNumber
+            || newPlaylist.isEndList != playlist?.isEndList
+        playlist = newPlaylist
+        if nextSequenceNumber < newPlaylist.mediaSequence {
+            Logger.debug("hls playlist moved past segment %d, skipping to %d",
+                         category: .networking,
+                         args: nextSequenceNumber, newPlaylist.mediaSequence)
+            nextSequenceNumber = newPlaylist.mediaSequence
+        }
+        fillPipeline()
+        deliverSegments()
+    }
+
+    private func scheduleReload() {
+        guard let playlist = playlist, let mediaPlaylistURL = mediaPlaylistURL else { return }
+        // a playlist which hasn't changed is reloaded after half the target duration
+        let interval = hasChanged ? playlist.targetDuration : playlist.targetDuration / 2
+        let workItem = DispatchWorkItem { [weak self] in
+            guard let self = self, self.isOpen else { return }
+            self.loadPlaylist(url: mediaPlaylistURL)
+        }
+        reloadWorkItem?.cancel()
+        reloadWorkItem = workItem
+        underlyingQueue.asyncAfter(deadline: .now() + max(interval, 0.5), execute: workItem)
+    }
+
+    // MARK: Segments
+
+    /// Starts downloading at the segment holding an offset of the demuxed stream
+    private func start(at offset: Int) {
+        guard isOpen, let playlist = playlist else { return }
+        if !playlist.isEndList {
+            let lastSequenceNumber = playlist.mediaSequence + playlist.segments.count
+            nextSequenceNumber = max(playlist.mediaSequence, lastSequenceNumber - HLSAudioSource.liveEdgeSegmentCount)
+            scheduleReload()
+        } else if let (sequenceNumber, delivered) = deliveredSegments.first(where: { $0.value.contains(offset) }) {
+            // a delivered segment, demuxing it again from the same variant yields the same bytes
+            if delivered.variantIndex != variantIndex, let variantPlaylist = variantPlaylists[delivered.variantIndex] {
+                switchVariant(to: delivered.variantIndex, playlist: variantPlaylist)
+            }
+            nextSequenceNumber = sequenceNumber
+            bytesToSkip = offset - delivered.range.lowerBound
+        } else {
+            nextSequenceNumber = estimatedSequenceNumber(at: offset, in: playlist)
+        }
+        fillPipeline()
+    }
+
+    private func estimatedSequenceNumber(at offset: Int, in playlist: HLSMediaPlaylist) -> Int {
+        guard offset > 0, deliveredDuration > 0, deliveredSegmentBytes > 0 else { return playlist.mediaSequence }
+        let time = Double(offset) * deliveredDuration / Double(deliveredSegmentBytes)
+        var elapsed: TimeInterval = 0
+        for segment in playlist.segments {
+            elapsed += segment.duration
+            if elapsed > time { return segment.sequenceNumber }
+        }
+        return playlist.mediaSequence + playlist.segments.count
+    }
+
+    private func segment(withSequenceNumber sequenceNumber: Int) -> HLSMediaSegment? {
+        guard let playlist = playlist else { return nil }
+        let index = sequenceNumber - playlist.mediaSequence
+        guard playlist.segments.indices.contains(index) else { return nil }
+        return playlist.segments[index]
+    }
+
+    /// Starts downloading the next segments, up to `prefetchCount` ahead
+    private func fillPipeline() {
+        guard isOpen, variantRequest == nil else { return }
+        while downloads.count < prefetchCount {
+            // the variant is selected before each segment, loading the playlist of a variant pauses the pipeline
+            guard selectVariant() else { return }
+            guard let segment = segment(withSequenceNumber: nextSequenceNumber) else { break }
+            nextSequenceNumber += 1
+            if let section = segment.initializationSection {
+                loadInitializationSection(section)
+            }
+            let download = SegmentDownload(segment: segment, variantIndex: variantIndex)
+            downloads.append(download)
+            request(download)
+        }
+        if downloads.isEmpty, let playlist = playlist, playlist.isEndList, !hasReachedEnd {
+            hasReachedEnd = true
+            delegate?.endOfFileOccured(source: self)
+        }
+    }
+
+    // MARK: Variants
+
+    /// Switches to the variant selected by the policy for the next segment
+    /// - Returns: `false` when the playlist of the selected variant is being loaded
+    private func selectVariant() -> Bool {
+        // a segment delivered before is demuxed again from its variant, when seeking within it
+        guard variants.count > 1, bytesToSkip == 0 else { return true }
+        let selected = selectedVariantIndex(current: variantIndex)
+        guard selected != variantIndex, !unavailableVariants.contains(selected) else { return true }
+        if let variantPlaylist = variantPlaylists[selected] {
+            switchVariant(to: selected, playlist: variantPlaylist)
+            return true
+        }
+        let url = variants[selected].url
+        variantRequest = fetch(url: url, byteRange: nil) { [weak self] result in
+            guard let self = self else { return }
+            self.variantRequest = nil
+            let parsed = result.map { HLSPlaylistParser(url: url).parse(input: String(decoding: $0, as: UTF8.self)) }
+            if case let .success(.success(.media(variantPlaylist))) = parsed {
+                self.switchVariant(to: selected, playlist: variantPlaylist)
+            } else {
+                Logger.error("hls variant playlist failed to load: %@", category: .networking, args: url.absoluteString)
+                self.unavailableVariants.insert(selected)
+            }
+            self.fillPipeline()
+            self.deliverSegments()
+        }
+        return false
+    }
+
+    private func selectedVariantIndex(current: Int) -> Int {
+        let context = HLSVariantSelectionContext(variants: variants,
+                                                 currentIndex: current,
+                                                 throughput: throughputMeter.estimate,
+                                                 bufferedSeconds: bufferedSeconds())
+        return min(max(variantPolicy.variantIndex(for: context), 0), variants.count - 1)
+    }
+
+    /// Continues with the segments of another variant, from the same sequence number
+    private func switchVariant(to index: Int, playlist newPlaylist: HLSMediaPlaylist) {
+        Logger.debug("hls switching to variant of %d bps at segment %d",
+                     category: .networking,
+                     args: variants[index].selectionBandwidth, nextSequenceNumber)
+        if let playlist = playlist, playlist.isEndList {
+            variantPlaylists[variantIndex] = playlist
+        }
+        variantIndex = index
+        mediaPlaylistURL = variants[index].url
+        playlist = newPlaylist
+        if nextSequenceNumber < newPlaylist.mediaSequence {
+            nextSequenceNumber = newPlaylist.mediaSequence
+        }
+        if !newPlaylist.isEndList {
+            // reloads continue with the playlist of the new variant
+            cancel(playlistRequest)
+            playlistRequest = nil
+            hasChanged = true
+            scheduleReload()
+        }
+    }
+
+    /// The seconds of audio downloaded ahead of playback, those buffered by the player and those not yet delivered
+    private func bufferedSeconds() -> TimeInterval {
+        downloads.filter(\.isComplete).reduce(playbackBufferedSeconds()) { seconds, download in
+            guard download.receivedCount > 0 else { return seconds }
+            return seconds + download.segment.duration * Double(download.data.count) / Double(download.receivedCount)
+        }
+    }
+
+    // MARK: Segment downloads
+
+    private func loadInitializationSection(_ section: HLSInitializationSection) {
+        guard initializationSections[section] == nil, initializationRequests[section] == nil else { return }
+        initializationRequests[section] = fetch(url: section.url, byteRange: section.byteRange) { [weak self] result in
+            guard let self = self else { return }
+            self.initializationRequests[section] = nil
+            switch result {
+            case let .success(data):
+                self.initializationSections[section] = data
+                self.deliverSegments()
+            case let .failure(error):
+                self.delegate?.errorOccured(source: self, error: error)
+            }
+        }
+    }
+
+    private func request(_ download: SegmentDownload) {
+        if !download.isMeasured {
+            download.isMeasured = true
+            throughputMeter.downloadStarted()
+        }
+        download.attempts += 1
+        download.isFailed = false
+        let attempt = download.attempts
+        // the bytes received by a previous attempt are dropped
+        var bytesToDrop = download.receivedCount
+        download.request = makeRequest(url: download.segment.url,
+                                       byteRange: download.segment.byteRange,
+                                       measuresThroughput: true)
+        { [weak self, weak download] event in
+            guard let self = self, let download = download, download.attempts == attempt,
+                  self.downloads.contains(where: { $0 === download })
+            else { return }
+            switch event {
+            case let .response(response):
+                if let statusCode = response?.statusCode, statusCode >= 300 {
+                    download.isFailed = true
+                }
+            case let .stream(.success(value)):
+                guard !download.isFailed, var data = value.data else { return }
+                if bytesToDrop > 0 {
+                    let dropped = min(bytesToDrop, data.count)
+                    bytesToDrop -= dropped
+                    data = Data(data.dropFirst(dropped))
+                }
+                download.receivedCount += data.count
+                download.data.append(data)
+                self.deliverSegments()
+            case let .stream(.failure(error)):
+                self.retry(download, error: error)
+            case .complete:
+                if download.isFailed {
+                    self.retry(download, error: NetworkError.serverError)
+                } else {
+                    download.isComplete = true
+                    self.endMeasuring(download)
+                    self.deliverSegments()
+                }
+            }
+        }
+    }
+
+    private func retry(_ download: SegmentDownload, error: Error) {
+        cancel(download.request)
+        guard download.attempts < maxAttempts else {
+            endMeasuring(download)
+            Logger.error("hls segment %d failed: %@",
+                         category: .networking,
+                         args: download.segment.sequenceNumber, String(describing: error))
+            delegate?.errorOccured(source: self, error: error)
+            return
+        }
+        request(download)
+    }
+
+    private func endMeasuring(_ download: SegmentDownload) {
+        guard download.isMeasured else { return }
+        download.isMeasured = false
+        throughputMeter.downloadEnded()
+    }
+
+    /// Delivers the downloaded bytes of the segments in order, completed segments are replaced by the next ones
+    private func deliverSegments() {
+        guard isOpen else { return }
+        while let download = downloads.first {
+            if let section = download.segment.initializationSection, initializationSections[section] == nil {
+                return
+            }
+            if !download.data.isEmpty {
+                let data = download.data
+                download.data = Data()
+                guard deliver(data, of: download) else { return }
+            }
+            guard download.isComplete else { return }
+            if let start = download.outputStart {
+                let delivered = DeliveredSegment(range: start ..< position, variantIndex: download.variantIndex)
+                deliveredSegments[download.segment.sequenceNumber] = delivered
+                if download.isDeliveredWhole {
+                    deliveredSegmentBytes += position - start
+                    deliveredDuration += download.segment.duration
+                }
+            }
+            downloads.removeFirst()
+            fillPipeline()
+        }
+    }
+
+    /// Demuxes and delivers bytes of a segment
+    /// - Returns: `false` when the container isn't supported
+    private func deliver(_ data: Data, of download: SegmentDownload) -> Bool {
+        if download.outputStart == nil {
+            let section = download.segment.initializationSection
+            // each variant may use another container, or other stream identifiers in the same one
+            if demuxer == nil || section != demuxerSection || download.variantIndex != demuxerVariantIndex {
+                let initializationData = section.flatMap { initializationSections[$0] }
+                demuxer = HLSSegmentDemuxers.demuxer(for: download.segment,
+                                                     initializationData: initializationData,
+                                                     firstBytes: data)
+                demuxerSection = section
+                demuxerVariantIndex = download.variantIndex
+            }
+            guard demuxer != nil else {
+                close()
+                delegate?.errorOccured(source: self, error: HLSError.unsupportedSegment)
+                return false
+            }
+            demuxer?.startSegment()
+            download.outputStart = position - bytesToSkip
+            download.isDeliveredWhole = bytesToSkip == 0
+        }
+        guard var output = demuxer?.demux(data), !output.isEmpty else { return true }
+        if bytesToSkip > 0 {
+            let skipped = min(bytesToSkip, output.count)
+            bytesToSkip -= skipped
+            output = Data(output.dropFirst(skipped))
+            guard !output.isEmpty else { return true }
+        }
+        position += output.count
+        delegate?.dataAvailable(source: self, data: output)
+        return true
+    }
+
+    // MARK: Requests
+
+    private func makeRequest(url: URL,
+                             byteRange: Range<Int>?,
+                             measuresThroughput: Bool = false,
+                             handler: @escaping (NetworkDataStream.ResponseEvent) -> Void) -> NetworkDataStream
+    {
+        var urlRequest = URLRequest(url: url)
+        urlRequest.networkServiceType = .avStreaming
+        urlRequest.cachePolicy = .reloadIgnoringLocalCacheData
+        urlRequest.timeoutInterval = 30
+
+        for header in additionalRequestHeaders {
+            urlRequest.addValue(header.value, forHTTPHeaderField: header.key)
+        }
+        if let range = byteRange {
+            urlRequest.addValue("bytes=\(range.lowerBound)-\(range.upperBound - 1)", forHTTPHeaderField: "Range")
+        }
+        let throughputMeter = self.throughputMeter
+        return networkingClient.stream(request: urlRequest)
+            .responseStream { [weak self] event in
+                // arrivals are measured as they happen, the stream queue waits while the player buffers are full
+                if measuresThroughput, case let .stream(.success(value)) = event {
+                    throughputMeter.record(byteCount: value.data?.count ?? 0)
+                }
+                self?.addStreamOperation { handler(event) }
+            }
+            .resume()
+    }
+
+    /// Downloads a whole resource, eg. a playlist
+    private func fetch(url: URL,
+                       byteRange: Range<Int>?,
+                       completion: @escaping (Result<Data, Error>) -> Void) -> NetworkDataStream
+    {
+        var data = Data()
+        var statusCode = 200
+        return makeRequest(url: url, byteRange: byteRange) { event in
+            switch event {
+            case let .response(response):
+                statusCode = response?.statusCode ?? statusCode
+            case let .stream(.success(value)):
+                data.append(value.data ?? Data())
+            case let .stream(.failure(error)):
+                completion(.failure(error))
+            case .complete:
+                completion(statusCode < 300 ? .success(data) : .failure(NetworkError.serverError))
+            }
+        }
+    }
+
+    private func cancel(_ request: NetworkDataStream?) {
+        guard let request = request else { return }
+        request.cancel()
+        networkingClient.remove(task: request)
+    }
+
+    /// Schedules the given block on the stream operation queue
+    ///
+    /// - Parameter block: A closure to be executed
+    private func addStreamOperation(_ block: @escaping () -> Void) {
+        let operation = BlockOperation(block: block)
+        streamOperationQueue.addOperation(operation)
+    }
+}
+
+/// The download of a segment, its bytes are kept until the segment is delivered
+private final class SegmentDownload {
+    let segment: HLSMediaSegment
+    /// The index of the variant the segment belongs to
+    let variantIndex: Int
+    var request: NetworkDataStream?
+    /// The received bytes not yet delivered
+    var data = Data()
+    /// The bytes received over all attempts
+    var receivedCount = 0
+    var attempts = 0
+    /// `true` when the server responded with an error status
+    var isFailed = false
+    var isComplete = false
+    /// The offset of the demuxed stream at which the segment starts, once its delivery started
+    var outputStart: Int?
+    /// `false` when the delivery started past the start of the segment
+    var isDeliveredWhole = false
+    /// `true` while the download counts towards the measured throughput
+    var isMeasured = false
+
+    init(segment: HLSMediaSegment, variantIndex: Int) {
+        self.segment = segment
+        self.variantIndex = variantIndex
+    }
+}
+
+/// The range of the demuxed stream of a delivered segment
+private struct DeliveredSegment {
+    let range: Range<Int>
+    let variantIndex: Int
+
+    func contains(_ offset: Int) -> Bool {
+        range.contains(offset)
+    }
+}
@@ -0,0 +1,68 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import Foundation
+
+/// The section holding the initialization data of fragmented MP4 segments, `EXT-X-MAP`
+struct HLSInitializationSection: Hashable {
+    let url: URL
+    let byteRange: Range<Int>?
+}
+
+struct HLSMediaSegment: Equatable {
+    let url: URL
+    /// The duration in seconds, from `EXTINF`
+    let duration: TimeInterval
+    /// The media sequence number of the segment
+    let sequenceNumber: Int
+    /// The bytes of the resource holding the segment, `nil` for the whole resource
+    let byteRange: Range<Int>?
+    let initializationSection: HLSInitializationSection?
+}
+
+/// A playlist listing the segments of a single rendition
+struct HLSMediaPlaylist: Equatable {
+    let targetDuration: TimeInterval
+    /// The sequence number of the first segment
+    let mediaSequence: Int
+    let segments: [HLSMediaSegment]
+    /// `true` once no more segments will be added, always `true` for on demand playlists
+    let isEndList: Bool
+
+    var duration: TimeInterval {
+        segments.reduce(0) { $0 + $1.duration }
+    }
+}
+
+/// A rendition listed by a master playlist, `EXT-X-STREAM-INF`
+struct HLSVariant: Equatable {
+    let url: URL
+    /// The peak bitrate in bits per second
+    let bandwidth: Int
+    /// The average bitrate in bits per second, when known
+    let averageBandwidth: Int?
+    let codecs: [String]
+}
+
+/// A playlist listing the renditions of a stream
+struct HLSMasterPlaylist: Equatable {
+    let variants: [HLSVariant]
+}
+
+enum HLSPlaylist: Equatable {
+    case master(HLSMasterPlaylist)
+    case media(HLSMediaPlaylist)
+}
+
+enum HLSError: Error, Equatable {
+    /// The playlist doesn't start with `#EXTM3U`
+    case invalidPlaylist
+    /// The segments are encrypted, which isn't supported
+    case encryptedSegments
+    /// A master playlist without variants or a media playlist without segments
+    case emptyPlaylist
+    /// A segment container other than MPEG-TS, fragmented MP4 or packed audio
+    case unsupportedSegment
+}
@@ -0,0 +1,86 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import AudioToolbox
+import Foundation
+
+/// Extracts the audio of HLS segments as an elementary stream the file stream parser reads, eg. ADTS.
+///
+/// Segments are fed in order, each one starting with `startSegment()`, so that the demuxed stream of consecutive
+/// segments is continuous.
+protocol HLSSegmentDemuxer: AnyObject {
+    /// The type of the demuxed stream, `nil` until it is known
+    var fileType: AudioFileTypeID? { get }
+
+    /// Drops the bytes of an incomplete segment and prepares for a new one
+    func startSegment()
+
+    /// Demuxes the next bytes of the current segment
+    /// - parameter data: The bytes following the ones previously passed for the segment
+    /// - Returns: The demuxed bytes available so far, may be empty
+    func demux(_ data: Data) -> Data
+}
+
+enum HLSSegmentDemuxers {
+    /// Creates the demuxer for the container of a segment
+    /// - parameter segment: The segment to demux
+    /// - parameter initializationData: The initialization section of the segment, when it has one
+    /// - parameter firstBytes: The first bytes of the segment
+    /// - Returns: A demuxer or `nil` when the container isn't supported
+    static func demuxer(for segment: HLSMediaSegment,
+                        initializationData: Data?,
+                        firstBytes: Data) -> HLSSegmentDemuxer?
+    {
+        if let initializationData = initializationData {
+            return FragmentedMP4Demuxer(initializationData: initializationData)
+        }
+        if firstBytes.first == MPEGTSDemuxer.syncByte {
+            return MPEGTSDemuxer()
+        }
+        let fileType = audioFileType(fileExtension: segment.url.pathExtension.lowercased())
+        switch fileType {
+        case kAudioFileAAC_ADTSType, kAudioFileMP3Type, kAudioFileAC3Type:
+            return PackedAudioDemuxer(fileType: fileType)
+        default:
+            return nil
+        }
+    }
+}
+
+/// Passes through packed audio segments, eg. `.aac`, dropping the ID3 tag carrying their timestamp
+final class PackedAudioDemuxer: HLSSegmentDemuxer {
+    let fileType: AudioFileTypeID?
+
+    /// The leading bytes of the segment while there aren't enough to look for a tag
+    private var header = Data()
+    private var isReadingHeader = true
+    private var bytesToSkip = 0
+
+    init(fileType: AudioFileTypeID) {
+        self.fileType = fileType
+    }
+
+    func startSegment() {
+        header.removeAll()
+        isReadingHeader = true
+        bytesToSkip = 0
+    }
+
+    func demux(_ data: Data) -> Data {
+        var data = data
+        if isReadingHeader {
+            header.append(data)
+            guard header.count >= ID3TagReader.headerSize else { return Data() }
+            isReadingHeader = false
+            data = header
+            header = Data()
+            bytesToSkip = ID3TagReader.tagSize(header: data)
+        }
+        guard bytesToSkip > 0 else { return data }
+        let skipped = min(bytesToSkip, data.count)
+        bytesToSkip -= skipped
+        return Data(data.dropFirst(skipped))
+    }
+}
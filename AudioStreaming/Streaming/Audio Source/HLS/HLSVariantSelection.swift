@@ -0,0 +1,180 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import Foundation
+
+/// How the variant of a multi-variant HLS playlist is selected
+public enum HLSVariantSelection: Equatable {
+    /// Switches between variants at segment boundaries, following the network throughput and the buffered audio
+    case adaptive
+    /// Plays the variant with the lowest bandwidth
+    case lowestBandwidth
+    /// Plays the variant with the highest bandwidth
+    case highestBandwidth
+
+    func makePolicy() -> HLSVariantSelectionPolicy {
+        switch self {
+        case .adaptive:
+            return ThroughputBufferSelectionPolicy()
+        case .lowestBandwidth:
+            return FixedVariantSelectionPolicy(selectsHighest: false)
+        case .highestBandwidth:
+            return FixedVariantSelectionPolicy(selectsHighest: true)
+        }
+    }
+}
+
+/// The state a variant is selected on, before downloading each segment
+struct HLSVariantSelectionContext {
+    /// The variants, ordered by ascending bandwidth
+    let variants: [HLSVariant]
+    /// The index of the variant of the previous segment
+    let currentIndex: Int
+    /// The estimated throughput of the segment downloads in bits per second, `nil` until enough are measured
+    let throughput: Double?
+    /// The seconds of audio downloaded ahead of playback
+    let bufferedSeconds: TimeInterval
+}
+
+/// Selects the variant of the next segment, given the measured state.
+///
+/// Policies are pure functions of the context, so they can be replayed against bandwidth traces.
+protocol HLSVariantSelectionPolicy {
+    /// Returns the index of the variant of the next segment, in the variants of the context
+    func variantIndex(for context: HLSVariantSelectionContext) -> Int
+}
+
+extension HLSVariant {
+    /// The bitrate a variant is selected on, the average bandwidth when known
+    var selectionBandwidth: Int {
+        averageBandwidth ?? bandwidth
+    }
+}
+
+/// Always selects the lowest or the highest variant
+struct FixedVariantSelectionPolicy: HLSVariantSelectionPolicy {
+    let selectsHighest: Bool
+
+    func variantIndex(for context: HLSVariantSelectionContext) -> Int {
+        selectsHighest ? max(context.variants.count - 1, 0) : 0
+    }
+}
+
+/// Selects the highest variant the throughput sustains, guarded by the buffered audio.
+///
+/// A variant is sustainable when its bandwidth fits in `upswitchFactor` of the throughput. Switching up happens
+/// one variant at a time and only with `upswitchBufferSeconds` buffered, as a throughput spike would otherwise
+/// drain a short buffer on a variant the network can't keep up with. Switching down happens as soon as the
+/// current variant exceeds the throughput, and below `lowBufferSeconds` the variant is never raised.
+struct ThroughputBufferSelectionPolicy: HLSVariantSelectionPolicy {
+    /// The fraction of the throughput a variant may use to be switched up to
+    var upswitchFactor: Double = 0.8
+    /// The fraction of the throughput the current variant may use before switching down
+    var downswitchFactor: Double = 1.0
+    /// The buffered seconds below which the variant is only ever lowered
+    var lowBufferSeconds: TimeInterval = 4
+    /// The buffered seconds required to switch up
+    var upswitchBufferSeconds: TimeInterval = 8
+
+    func variantIndex(for context: HLSVariantSelectionContext) -> Int {
+        let variants = context.variants
+        guard !variants.isEmpty else { return 0 }
+        let current = min(max(context.currentIndex, 0), variants.count - 1)
+        // the current variant is kept until downloads are measured
+        guard let throughput = context.throughput else { return current }
+
+        let sustainable = variants.lastIndex { Double($0.selectionBandwidth) <= throughput * upswitchFactor } ?? 0
+        if context.bufferedSeconds < lowBufferSeconds {
+            return min(current, sustainable)
+        }
+        if sustainable > current, context.bufferedSeconds >= upswitchBufferSeconds {
+            return current + 1
+        }
+        if Double(variants[current].selectionBandwidth) > throughput * downswitchFactor {
+            return sustainable
+        }
+        return current
+    }
+}
+
+/// Measures the throughput of segment downloads, which may overlap.
+///
+/// Arrivals are measured against the previous arrival of any download, so overlapping downloads add up to the
+/// throughput of the connection. The time without downloads, eg. while the buffer is full, isn't measured.
+///
+/// - note: Thread safe, arrivals are recorded on the networking queue while variants are selected on the
+/// source queue.
+final class HLSThroughputMeter {
+    private let lock = UnfairLock()
+    private var estimator: ThroughputEstimator
+    private var activeDownloads = 0
+    private var lastArrival: TimeInterval?
+    /// The bytes that arrived at the same time as the last arrival
+    private var coalescedByteCount = 0
+
+    private let clock: () -> TimeInterval
+
+    init(halfLife: TimeInterval = 4,
+         clock: @escaping () -> TimeInterval = { ProcessInfo.processInfo.systemUptime })
+    {
+        estimator = ThroughputEstimator(halfLife: halfLife, minimumSamples: 2)
+        self.clock = clock
+    }
+
+    /// The estimated throughput in bits per second, `nil` until enough arrivals are recorded
+    var estimate: Double? {
+        lock.around { estimator.estimate }
+    }
+
+    /// Marks the start of a download, the first arrival is measured from its start when no other is active
+    func downloadStarted() {
+        let now = clock()
+        lock.around {
+            if activeDownloads == 0 {
+                lastArrival = now
+            }
+            activeDownloads += 1
+        }
+    }
+
+    /// Marks the end of a download, whether completed or cancelled
+    func downloadEnded() {
+        lock.around {
+            activeDownloads = max(activeDownloads - 1, 0)
+            if activeDownloads == 0 {
+                lastArrival = nil
+                coalescedByteCount = 0
+            }
+        }
+    }
+
+    /// Records the arrival of downloaded bytes
+    func record(byteCount: Int) {
+        let now = clock()
+        lock.around {
+            guard let lastArrival = lastArrival else {
+                self.lastArrival = now
+                return
+            }
+            guard now > lastArrival else {
+                // arrivals without elapsed time are counted with the next one
+                coalescedByteCount += byteCount
+                return
+            }
+            estimator.record(amount: Double((coalescedByteCount + byteCount) * 8), duration: now - lastArrival)
+            coalescedByteCount = 0
+            self.lastArrival = now
+        }
+    }
+
+    /// Marks that downloads are paused for reasons other than the network, eg. the player being paused, so the
+    /// next arrival isn't measured against the time spent waiting
+    func pause() {
+        lock.around {
+            lastArrival = nil
+            coalescedByteCount = 0
+        }
+    }
+}
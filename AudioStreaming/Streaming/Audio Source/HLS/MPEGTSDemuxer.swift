@@ -0,0 +1,147 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import AudioToolbox
+import Foundation
+
+/// Extracts the first audio stream of an MPEG transport stream, ADTS AAC, MPEG audio or AC-3.
+///
+/// The program association and program map tables locate the audio stream, whose PES headers are stripped.
+/// Tables are expected to fit in a single packet, as they do in HLS segments.
+final class MPEGTSDemuxer: HLSSegmentDemuxer {
+    static let syncByte: UInt8 = 0x47
+    static let packetSize = 188
+
+    private(set) var fileType: AudioFileTypeID?
+
+    /// The bytes of an incomplete packet
+    private var pending: [UInt8] = []
+    private var programMapPID: Int?
+    private var audioPID: Int?
+    /// `true` once the start of a PES packet of the audio stream has been read in the current segment
+    private var isInPacket = false
+
+    func startSegment() {
+        pending.removeAll(keepingCapacity: true)
+        isInPacket = false
+    }
+
+    func demux(_ data: Data) -> Data {
+        pending.append(contentsOf: data)
+        var output = Data()
+        var offset = 0
+        pending.withUnsafeBufferPointer { buffer in
+            let packetSize = MPEGTSDemuxer.packetSize
+            while offset + packetSize <= buffer.count {
+                guard buffer[offset] == MPEGTSDemuxer.syncByte else {
+                    offset += 1
+                    continue
+                }
+                parse(packet: UnsafeBufferPointer(rebasing: buffer[offset ..< offset + packetSize]), into: &output)
+                offset += packetSize
+            }
+        }
+        pending.removeFirst(offset)
+        return output
+    }
+
+    private func parse(packet: UnsafeBufferPointer<UInt8>, into output: inout Data) {
+        let pid = Int(packet[1] & 0x1F) << 8 | Int(packet[2])
+        let startsUnit = packet[1] & 0x40 != 0
+        let adaptationFieldControl = (packet[3] >> 4) & 0x03
+        var payloadOffset = 4
+        if adaptationFieldControl & 0x02 != 0 {
+            payloadOffset += 1 + Int(packet[4])
+        }
+        guard adaptationFieldControl & 0x01 != 0, payloadOffset < packet.count else { return }
+        let payload = UnsafeBufferPointer(rebasing: packet[payloadOffset...])
+
+        if pid == 0 {
+            if let section = MPEGTSDemuxer.section(in: payload, startsUnit: startsUnit) {
+                parseProgramAssociation(section)
+            }
+        } else if pid == programMapPID {
+            if let section = MPEGTSDemuxer.section(in: payload, startsUnit: startsUnit) {
+                parseProgramMap(section)
+            }
+        } else if pid == audioPID {
+            appendElementaryStream(of: payload, startsUnit: startsUnit, into: &output)
+        }
+    }
+
+    /// The section starting in the payload, without its CRC
+    private static func section(in payload: UnsafeBufferPointer<UInt8>,
+                                startsUnit: Bool) -> UnsafeBufferPointer<UInt8>?
+    {
+        guard startsUnit, payload.count > 0 else { return nil }
+        let start = 1 + Int(payload[0])
+        guard start + 3 <= payload.count else { return nil }
+        let sectionLength = Int(payload[start + 1] & 0x0F) << 8 | Int(payload[start + 2])
+        let end = min(start + 3 + sectionLength - 4, payload.count)
+        guard end > start else { return nil }
+        return UnsafeBufferPointer(rebasing: payload[start ..< end])
+    }
+
+    private func parseProgramAssociation(_ section: UnsafeBufferPointer<UInt8>) {
+        var offset = 8
+        while offset + 4 <= section.count {
+            let program = Int(section[offset]) << 8 | Int(section[offset + 1])
+            if program != 0 {
+                programMapPID = Int(section[offset + 2] & 0x1F) << 8 | Int(section[offset + 3])
+                return
+            }
+            offset += 4
+        }
+    }
+
+    private func parseProgramMap(_ section: UnsafeBufferPointer<UInt8>) {
+        guard audioPID == nil, section.count >= 12 else { return }
+        let programInfoLength = Int(section[10] & 0x0F) << 8 | Int(section[11])
+        var offset = 12 + programInfoLength
+        while offset + 5 <= section.count {
+            let streamType = section[offset]
+            let pid = Int(section[offset + 1] & 0x1F) << 8 | Int(section[offset + 2])
+            let infoLength = Int(section[offset + 3] & 0x0F) << 8 | Int(section[offset + 4])
+            if let fileType = MPEGTSDemuxer.fileType(of: streamType) {
+                audioPID = pid
+                self.fileType = fileType
+                return
+            }
+            offset += 5 + infoLength
+        }
+    }
+
+    private func appendElementaryStream(of payload: UnsafeBufferPointer<UInt8>,
+                                        startsUnit: Bool,
+                                        into output: inout Data)
+    {
+        if startsUnit {
+            // a PES header, the start code prefix followed by the optional header
+            guard payload.count >= 9, payload[0] == 0, payload[1] == 0, payload[2] == 1 else {
+                isInPacket = false
+                return
+            }
+            let dataOffset = 9 + Int(payload[8])
+            guard dataOffset <= payload.count else { return }
+            isInPacket = true
+            output.append(UnsafeBufferPointer(rebasing: payload[dataOffset...]))
+        } else if isInPacket {
+            output.append(payload)
+        }
+    }
+
+    private static func fileType(of streamType: UInt8) -> AudioFileTypeID? {
+        switch streamType {
+        case 0x0F:
+            return kAudioFileAAC_ADTSType
+        case 0x03, 0x04:
+            return kAudioFileMP3Type
+        case 0x81:
+            return kAudioFileAC3Type
+        default:
+            return nil
+        }
+    }
+}
@@ -0,0 +1,220 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import AudioToolbox
+import Foundation
+
+/// Reads the ID3v2 tag leading a stream, keeping its text frames and dropping the rest, so the parser is fed from the
+/// first audio frame.
+///
+/// Tags of podcasts often carry megabytes of artwork, once the bytes left of the tag exceed `rangeRequestThreshold`
+/// while skipping a frame, `shouldSkipWithRequest` tells the source to request the stream past the tag instead of
+/// downloading it. Text frames following the skipped bytes aren't read then.
+///
+/// - note: Not thread safe, the bytes of the stream are processed on the same queue.
+final class ID3TagReader {
+    private enum State: Equatable {
+        case readingHeader
+        case readingFrames
+        /// Dropping the frame ending at the given offset
+        case skippingFrame(end: Int)
+        /// Dropping the rest of the tag
+        case skippingTag
+        case complete
+    }
+
+    static let headerSize = 10
+    /// The largest text frame that is read, larger ones are skipped
+    static let maxTextFrameSize = 4096
+
+    /// `true` for the file types that may start with an ID3v2 tag
+    static func canRead(fileType: AudioFileTypeID) -> Bool {
+        fileType == kAudioFileMP3Type || fileType == kAudioFileAAC_ADTSType
+    }
+
+    /// The size of the ID3v2 tag starting with the given header, including its header and footer, 0 when there's no tag
+    static func tagSize(header: Data) -> Int {
+        guard header.count >= headerSize else { return 0 }
+        let bytes = [UInt8](header.prefix(headerSize))
+        guard bytes[0] == 0x49, bytes[1] == 0x44, bytes[2] == 0x33 else { return 0 }
+        let hasFooter = bytes[5] & 0x10 != 0
+        return headerSize + syncsafe(bytes[6 ..< 10]) + (hasFooter ? headerSize : 0)
+    }
+
+    /// The bytes left of the tag from which it is skipped with a request rather than downloaded
+    let rangeRequestThreshold: Int
+
+    private var state: State = .readingHeader
+    /// The unread bytes of the stream from `offset`
+    private var buffer = Data()
+    /// The offset of the first byte of `buffer` in the stream
+    private var offset = 0
+    private var majorVersion: UInt8 = 0
+    /// The text frames read so far, keyed by their identifier, eg. `TIT2`
+    private var frames: [String: String] = [:]
+    private var hasReportedFrames = false
+
+    /// The size of the tag, 0 when the stream doesn't start with one or until its header is read
+    private(set) var tagSize = 0
+    /// The offset following the frames, preceding the footer if any
+    private var framesEnd = 0
+
+    /// `true` once the audio following the tag is reached
+    var isComplete: Bool {
+        state == .complete
+    }
+
+    /// `true` while skipping more than `rangeRequestThreshold` bytes of the tag which weren't received yet
+    var shouldSkipWithRequest: Bool {
+        switch state {
+        case .skippingFrame, .skippingTag:
+            return tagSize - offset >= rangeRequestThreshold
+        case .readingHeader, .readingFrames, .complete:
+            return false
+        }
+    }
+
+    init(rangeRequestThreshold: Int = 64 * 1024) {
+        self.rangeRequestThreshold = rangeRequestThreshold
+    }
+
+    /// Processes the next bytes of the stream
+    /// - Returns: The bytes following the tag
+    func process(_ data: Data) -> Data {
+        guard state != .complete else { return data }
+        buffer.append(data)
+        readTag()
+        guard state == .complete else { return Data() }
+        let audio = buffer
+        buffer = Data()
+        return audio
+    }
+
+    /// Skips the rest of the tag, the stream is read again from the returned offset
+    /// - Returns: The offset of the audio following the tag
+    func skipTag() -> Int {
+        state = .complete
+        buffer = Data()
+        offset = tagSize
+        return tagSize
+    }
+
+    /// The text frames of the tag once no more are read, only once
+    func takeFrames() -> [String: String]? {
+        guard !hasReportedFrames, !frames.isEmpty, state == .skippingTag || state == .complete else { return nil }
+        hasReportedFrames = true
+        return frames
+    }
+
+    // MARK: Private
+
+    private func readTag() {
+        while true {
+            switch state {
+            case .readingHeader:
+                guard buffer.count >= ID3TagReader.headerSize else { return }
+                readHeader()
+            case .readingFrames:
+                guard readFrame() else { return }
+            case let .skippingFrame(end):
+                guard skip(to: end) else { return }
+                state = .readingFrames
+            case .skippingTag:
+                guard skip(to: tagSize) else { return }
+                state = .complete
+            case .complete:
+                return
+            }
+        }
+    }
+
+    private func readHeader() {
+        tagSize = ID3TagReader.tagSize(header: buffer)
+        guard tagSize > 0 else {
+            state = .complete
+            return
+        }
+        let bytes = [UInt8](buffer.prefix(ID3TagReader.headerSize))
+        majorVersion = bytes[3]
+        let isUnsynchronised = bytes[5] & 0x80 != 0
+        let hasExtendedHeader = bytes[5] & 0x40 != 0
+        framesEnd = tagSize - (bytes[5] & 0x10 != 0 ? ID3TagReader.headerSize : 0)
+        consume(ID3TagReader.headerSize)
+        // frames of other versions, or behind an extended header or unsynchronisation, are skipped along the tag
+        let canReadFrames = (majorVersion == 3 || majorVersion == 4) && !isUnsynchronised && !hasExtendedHeader
+        state = canReadFrames ? .readingFrames : .skippingTag
+        Logger.debug("id3v2 tag of %d bytes", category: .networking, args: tagSize)
+    }
+
+    /// Reads the next frame, returns `false` when more bytes are needed
+    private func readFrame() -> Bool {
+        guard offset + ID3TagReader.headerSize <= framesEnd else {
+            state = .skippingTag
+            return true
+        }
+        guard buffer.count >= ID3TagReader.headerSize else { return false }
+        let header = [UInt8](buffer.prefix(ID3TagReader.headerSize))
+        // padding follows the frames
+        guard header[0] != 0 else {
+            state = .skippingTag
+            return true
+        }
+        let identifier = String(decoding: header[0 ..< 4], as: UTF8.self)
+        let size = majorVersion == 4 ? ID3TagReader.syncsafe(header[4 ..< 8]) : ID3TagReader.read(header[4 ..< 8])
+        let end = offset + ID3TagReader.headerSize + size
+        guard end <= framesEnd else {
+            state = .skippingTag
+            return true
+        }
+        // compressed, encrypted or unsynchronised frames are skipped
+        let isPlain = header[9] == 0
+        guard identifier.hasPrefix("T"), identifier != "TXXX", isPlain, size <= ID3TagReader.maxTextFrameSize else {
+            consume(min(ID3TagReader.headerSize, buffer.count))
+            state = .skippingFrame(end: end)
+            return true
+        }
+        guard buffer.count >= ID3TagReader.headerSize + size else { return false }
+        let body = buffer.subdata(in: ID3TagReader.headerSize ..< ID3TagReader.headerSize + size)
+        if let text = ID3TagReader.text(of: body) {
+            frames[identifier] = text
+        }
+        consume(ID3TagReader.headerSize + size)
+        return true
+    }
+
+    /// Drops the bytes up to the given offset, returns `false` when more bytes are needed
+    private func skip(to end: Int) -> Bool {
+        consume(min(end - offset, buffer.count))
+        return offset >= end
+    }
+
+    private func consume(_ count: Int) {
+        buffer = count < buffer.count ? buffer.subdata(in: count ..< buffer.count) : Data()
+        offset += count
+    }
+
+    /// The first value of a text frame, following its encoding byte
+    private static func text(of body: Data) -> String? {
+        guard let encoding = body.first else { return nil }
+        let bytes = body.dropFirst()
+        let string: String?
+        switch encoding {
+        case 0: string = String(data: bytes, encoding: .isoLatin1)
+        case 1: string = String(data: bytes, encoding: .utf16)
+        case 2: string = String(data: bytes, encoding: .utf16BigEndian)
+        case 3: string = String(data: bytes, encoding: .utf8)
+        default: string = nil
+        }
+        return string?.components(separatedBy: "\0").first { !$0.isEmpty }
+    }
+
+    private static func syncsafe(_ bytes: ArraySlice<UInt8>) -> Int {
+        bytes.reduce(0) { $0 << 7 | Int($1 & 0x7F) }
+    }
+
+    private static func read(_ bytes: ArraySlice<UInt8>) -> Int {
+        bytes.reduce(0) { $0 << 8 | Int($1) }
+    }
+}
@@ -0,0 +1,291 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import AudioToolbox
+import Foundation
+
+/// Moves the `moov` box of progressive MP4 files stored after their `mdat` box in front of it, as `qt-faststart` does,
+/// so `AudioFileStream` can parse them as they stream instead of failing with `notOptimized`.
+///
+/// Once `mdat` is found before `moov` the bytes are held, while the boxes following `mdat` are read from `tailOffset`,
+/// either from a request for the tail of the file or from the stream itself once it gets there. The chunk offsets of
+/// `moov` are shifted by its size and it is delivered right before `mdat`, followed by the held bytes. The boxes
+/// following `mdat` are dropped from the relocated stream.
+///
+/// - note: Not thread safe, the bytes of the file and of its tail are processed on the same queue.
+final class MP4MoovRelocator {
+    enum State: Equatable {
+        /// Reading the boxes preceding `mdat`
+        case scanning
+        /// `mdat` precedes `moov`, the bytes are held until `moov` is read from `tailOffset`
+        case awaitingMoov
+        /// `moov` precedes `mdat` in the delivered stream
+        case relocated
+        /// The file is delivered as is, it either isn't laid out as MP4 boxes, its `moov` box already precedes `mdat` or
+        /// it can't be relocated
+        case passthrough
+    }
+
+    /// The boxes read before giving up finding `mdat`
+    static let maxScannedSize = 1 << 20
+
+    /// `true` for the file types laid out as MP4 boxes
+    static func canRelocate(fileType: AudioFileTypeID) -> Bool {
+        fileType == kAudioFileM4AType || fileType == kAudioFileMPEG4Type || fileType == kAudioFileM4BType
+    }
+
+    private(set) var state: State = .scanning
+
+    /// The offset of the boxes following `mdat` in the original file, once `mdat` is found
+    var tailOffset: Int? {
+        mdat?.upperBound
+    }
+
+    /// The length of the relocated stream, once relocated
+    private(set) var relocatedLength: Int?
+
+    /// The original range of the `mdat` box
+    private var mdat: Range<Int>?
+    /// The bytes of the file from its start, while looking for `moov`
+    private var held = Data()
+    /// The bytes of the file from `tailOffset`, while looking for `moov`
+    private var tail = Data()
+    /// The boxes preceding `mdat` followed by the relocated `moov`
+    private var header = Data()
+    /// The bytes of the header to deliver before the next bytes of the file, after seeking within the header
+    private var pendingHeader = Data()
+    /// The original offset of the next byte of the file
+    private var position = 0
+    /// The original offset of the next box to read while scanning
+    private var scanOffset = 0
+
+    /// Processes the next bytes of the file
+    /// - Returns: The bytes of the relocated stream to deliver
+    func process(_ data: Data) -> Data {
+        let offset = position
+        position += data.count
+        switch state {
+        case .passthrough:
+            return data
+        case .relocated:
+            var output = pendingHeader
+            pendingHeader = Data()
+            if let mdat = mdat, offset < mdat.upperBound {
+                output.append(data.prefix(mdat.upperBound - offset))
+            }
+            return output
+        case .scanning, .awaitingMoov:
+            held.append(data)
+            if state == .scanning {
+                scanBoxes()
+            }
+            if state == .passthrough {
+                return releaseHeldBytes()
+            }
+            // the stream reached the boxes following `mdat` before the tail did
+            if let mdat = mdat, position > mdat.upperBound {
+                let start = max(offset, mdat.upperBound)
+                return appendTail(data.suffix(position - start), at: start)
+            }
+            return Data()
+        }
+    }
+
+    /// Processes bytes of the file from the given offset, as received by the request for its tail
+    /// - Returns: The bytes of the relocated stream to deliver, once `moov` is read
+    func appendTail(_ data: Data, at offset: Int) -> Data {
+        guard state == .awaitingMoov, let mdat = mdat else { return Data() }
+        // the tail is read by both the request for it and the stream, only the bytes following those read are kept
+        let tailEnd = mdat.upperBound + tail.count
+        guard offset <= tailEnd, offset + data.count > tailEnd else { return Data() }
+        tail.append(data.suffix(offset + data.count - tailEnd))
+        return relocateMoov()
+    }
+
+    /// Ends the file, `moov` won't be read if it hasn't been yet
+    /// - Returns: The held bytes to deliver as is
+    func finish() -> Data {
+        guard state == .scanning || state == .awaitingMoov else { return Data() }
+        Logger.debug("mp4 moov box not found, delivering the file as is", category: .networking)
+        return releaseHeldBytes()
+    }
+
+    /// Seeks within the relocated stream
+    /// - parameter offset: The offset in the relocated stream
+    /// - Returns: The offset of the original file to continue reading from
+    func seek(to offset: Int) -> Int {
+        guard state == .relocated, let mdat = mdat else { return offset }
+        if offset >= header.count {
+            pendingHeader = Data()
+            position = offset - header.count + mdat.lowerBound
+        } else {
+            // the header is delivered before `mdat`
+            pendingHeader = header.suffix(header.count - offset)
+            position = mdat.lowerBound
+        }
+        return position
+    }
+
+    // MARK: Boxes
+
+    private func scanBoxes() {
+        while let box = MP4MoovRelocator.box(in: held, at: scanOffset) {
+            if scanOffset == 0, box.type != "ftyp" {
+                state = .passthrough
+                return
+            }
+            switch box.type {
+            case "moov":
+                state = .passthrough
+                return
+            case "mdat" where box.size == 0:
+                // `mdat` extends to the end of the file, nothing follows it
+                state = .passthrough
+                return
+            case "mdat":
+                guard box.fits(at: scanOffset) else {
+                    state = .passthrough
+                    return
+                }
+                Logger.debug("mp4 mdat box precedes moov, reading moov from offset %d",
+                             category: .networking,
+                             args: scanOffset + box.size)
+                mdat = scanOffset ..< scanOffset + box.size
+                state = .awaitingMoov
+                return
+            default:
+                guard box.fits(at: scanOffset) else {
+                    state = .passthrough
+                    return
+                }
+                scanOffset += box.size
+            }
+        }
+        if scanOffset > MP4MoovRelocator.maxScannedSize {
+            state = .passthrough
+        }
+    }
+
+    /// Relocates `moov` once it is read from the tail
+    private func relocateMoov() -> Data {
+        var offset = 0
+        while let box = MP4MoovRelocator.box(in: tail, at: offset) {
+            guard box.fits(at: offset) else { return releaseHeldBytes() }
+            guard box.type == "moov" else {
+                offset += box.size
+                continue
+            }
+            guard offset + box.size <= tail.count else { return Data() }
+            let moov = tail.subdata(in: offset ..< offset + box.size)
+            // the chunk offsets follow `moov` once it precedes `mdat`
+            guard let mdat = mdat, let relocated = MP4MoovRelocator.shiftingChunkOffsets(of: moov, by: moov.count) else {
+                Logger.error("mp4 moov box can't be relocated", category: .networking)
+                return releaseHeldBytes()
+            }
+            header = held.prefix(mdat.lowerBound)
+            header.append(relocated)
+            relocatedLength = header.count + mdat.count
+            state = .relocated
+
+            var output = header
+            output.append(held.subdata(in: mdat.lowerBound ..< min(held.count, mdat.upperBound)))
+            held = Data()
+            tail = Data()
+            return output
+        }
+        return Data()
+    }
+
+    private func releaseHeldBytes() -> Data {
+        state = .passthrough
+        let output = held
+        held = Data()
+        tail = Data()
+        return output
+    }
+
+    /// The boxes containing those holding the chunk offsets
+    private static let containers: Set<String> = ["moov", "trak", "mdia", "minf", "stbl"]
+
+    /// Returns the `moov` box with the chunk offsets of its `stco` and `co64` boxes shifted
+    /// - Returns: `nil` when an offset overflows or a box is malformed
+    static func shiftingChunkOffsets(of moov: Data, by delta: Int) -> Data? {
+        var bytes = [UInt8](moov)
+        guard shiftChunkOffsets(in: &bytes, from: 0, to: bytes.count, by: delta) else { return nil }
+        return Data(bytes)
+    }
+
+    private static func shiftChunkOffsets(in bytes: inout [UInt8], from start: Int, to end: Int, by delta: Int) -> Bool {
+        var offset = start
+        while let box = box(in: bytes, at: offset, end: end) {
+            guard box.size == 0 || (box.size >= box.headerSize && box.size <= end - offset) else { return false }
+            let boxEnd = box.size == 0 ? end : offset + box.size
+            let payload = offset + box.headerSize
+            switch box.type {
+            case _ where containers.contains(box.type):
+                guard shiftChunkOffsets(in: &bytes, from: payload, to: boxEnd, by: delta) else { return false }
+            case "stco", "co64":
+                let width = box.type == "stco" ? 4 : 8
+                guard payload + 8 <= boxEnd else { return false }
+                let count = read(bytes, at: payload + 4, width: 4)
+                guard payload + 8 + count * width <= boxEnd else { return false }
+                for index in 0 ..< count {
+                    let entry = payload + 8 + index * width
+                    let (shifted, overflow) = read(bytes, at: entry, width: width).addingReportingOverflow(delta)
+                    guard !overflow, shifted >= 0, width == 8 || shifted <= Int(UInt32.max) else { return false }
+                    write(shifted, to: &bytes, at: entry, width: width)
+                }
+            default:
+                break
+            }
+            offset = boxEnd
+        }
+        return true
+    }
+
+    private struct Box {
+        let type: String
+        let headerSize: Int
+        /// The size of the box, `0` when it extends to the end of the file, negative for 64 bit sizes past `Int.max`
+        let size: Int
+
+        /// `true` when the box holds its header and ends at an offset that can be represented
+        func fits(at offset: Int) -> Bool {
+            size >= headerSize && size <= Int.max - offset
+        }
+    }
+
+    /// The box whose header is available at the given offset
+    private static func box(in data: Data, at offset: Int) -> Box? {
+        guard offset + 8 <= data.count else { return nil }
+        let header = [UInt8](data[data.startIndex + offset ..< data.startIndex + min(offset + 16, data.count)])
+        return box(in: header, at: 0, end: header.count)
+    }
+
+    private static func box(in bytes: [UInt8], at offset: Int, end: Int) -> Box? {
+        guard offset + 8 <= end else { return nil }
+        let type = String(decoding: bytes[offset + 4 ..< offset + 8], as: UTF8.self)
+        let size = read(bytes, at: offset, width: 4)
+        guard size == 1 else {
+            return Box(type: type, headerSize: 8, size: size)
+        }
+        guard offset + 16 <= end else { return nil }
+        return Box(type: type, headerSize: 16, size: read(bytes, at: offset + 8, width: 8))
+    }
+
+    private static func read(_ bytes: [UInt8], at offset: Int, width: Int) -> Int {
+        var value = 0
+        for index in offset ..< offset + width {
+            value = value << 8 | Int(bytes[index])
+        }
+        return value
+    }
+
+    private static func write(_ value: Int, to bytes: inout [UInt8], at offset: Int, width: Int) {
+        for index in 0 ..< width {
+            bytes[offset + index] = UInt8(truncatingIfNeeded: value >> (8 * (width - 1 - index)))
+        }
+    }
+}
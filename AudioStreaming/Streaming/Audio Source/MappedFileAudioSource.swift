@@ -0,0 +1,53 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import AVFoundation
+
+/// Reads local files by mapping them in memory, handing slices of the mapping to the delegate without copying them.
+///
+/// Slices end on `readSize` boundaries, so all but the first after a seek are page aligned, and seeking only moves
+/// the read cursor. The kernel is advised of sequential access, and of the `readAheadSize` bytes following the
+/// cursor being needed, so they're paged in ahead of the parser.
+///
+/// - note: Not thread safe, called and reading on the `underlyingQueue`.
+final class MappedFileAudioSource: MemoryAudioSource {
+    /// `true` for regular, non empty, files that can be mapped
+    static func canMap(url: URL, fileManager: FileManager = .default) -> Bool {
+        guard url.isFileURL, let attributes = try? fileManager.attributesOfItem(atPath: url.path) else { return false }
+        let size = (attributes[.size] as? Int) ?? 0
+        return attributes[.type] as? FileAttributeType == .typeRegular && size > 0
+    }
+
+    init(url: URL,
+         underlyingQueue: DispatchQueue,
+         readSize: Int = 64 * 1024,
+         readAheadSize: Int = 256 * 1024)
+    {
+        super.init(bytes: { try SharedBytes(mapping: url) },
+                   fileHint: audioFileType(fileExtension: url.pathExtension),
+                   underlyingQueue: underlyingQueue,
+                   readSize: readSize,
+                   readAheadSize: readAheadSize)
+    }
+}
+
+extension SharedBytes {
+    /// The bytes of a read only mapping of the given file, unmapped once released
+    convenience init(mapping url: URL) throws {
+        let descriptor = open(url.path, O_RDONLY)
+        guard descriptor >= 0 else { throw AudioSystemError.playerStartError }
+        defer { _ = Darwin.close(descriptor) }
+
+        var status = stat()
+        guard fstat(descriptor, &status) == 0, status.st_size > 0 else { throw AudioSystemError.playerStartError }
+        let length = Int(status.st_size)
+        guard let bytes = mmap(nil, length, PROT_READ, MAP_PRIVATE, descriptor, 0), bytes != MAP_FAILED else {
+            throw AudioSystemError.playerStartError
+        }
+        self.init(base: bytes, length: length, isMapped: true) {
+            munmap(bytes, length)
+        }
+    }
+}
@@ -0,0 +1,207 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import AVFoundation
+
+/// Audio held in memory, played with `AudioPlayer.play(audio:)` without being written to a file first
+public struct InMemoryAudio {
+    /// The identifier of the entry playing the audio, eg. as reported by `AudioPlayerDelegate`
+    public let id: String
+    /// The type of the audio, eg. `kAudioFileMP3Type`
+    public let fileType: AudioFileTypeID
+
+    let makeBytes: () -> SharedBytes
+
+    /// Audio in the given data, which isn't copied
+    public init(data: Data, fileType: AudioFileTypeID, id: String = UUID().uuidString) {
+        self.id = id
+        self.fileType = fileType
+        makeBytes = { SharedBytes(data: data) }
+    }
+
+    /// Audio in memory owned by the caller, released by the deallocator once neither the player nor the parser read
+    /// it anymore
+    public init(bytes: UnsafeRawBufferPointer,
+                fileType: AudioFileTypeID,
+                id: String = UUID().uuidString,
+                deallocator: @escaping (UnsafeRawBufferPointer) -> Void)
+    {
+        self.id = id
+        self.fileType = fileType
+        // the same bytes back every entry of the audio, they're released once
+        let bytes = SharedBytes(base: bytes.baseAddress, length: bytes.count) { deallocator(bytes) }
+        makeBytes = { bytes }
+    }
+}
+
+/// Reads audio held in memory, handing slices of it to the delegate without copying them.
+///
+/// Slices end on `readSize` boundaries, one is delivered per hop on the `underlyingQueue` while the source isn't
+/// suspended, and seeking only moves the read cursor. The bytes are kept until the source and the slices are released.
+///
+/// - note: Not thread safe, called and reading on the `underlyingQueue`.
+class MemoryAudioSource: CoreAudioStreamSource {
+    weak var delegate: AudioStreamSourceDelegate?
+
+    let underlyingQueue: DispatchQueue
+
+    private(set) var position = 0
+    private(set) var length = 0
+
+    let audioFileHint: AudioFileTypeID
+
+    private let makeBytes: () throws -> SharedBytes
+    private let readSize: Int
+    private let readAheadSize: Int
+
+    private var bytes: SharedBytes?
+    private var isOpen = false
+    private var isSuspended = false
+    private var isReadScheduled = false
+    /// Changes on close, dropping the reads scheduled before
+    private var generation = 0
+    /// The end of the bytes advised as needed
+    private var advisedOffset = 0
+
+    /// - parameter bytes: Makes the bytes on the first seek, throwing when they can't be read
+    init(bytes: @escaping () throws -> SharedBytes,
+         fileHint: AudioFileTypeID,
+         underlyingQueue: DispatchQueue,
+         readSize: Int = 64 * 1024,
+         readAheadSize: Int = 256 * 1024)
+    {
+        makeBytes = bytes
+        audioFileHint = fileHint
+        self.underlyingQueue = underlyingQueue
+        self.readSize = readSize
+        self.readAheadSize = readAheadSize
+    }
+
+    convenience init(audio: InMemoryAudio, underlyingQueue: DispatchQueue) {
+        self.init(bytes: audio.makeBytes, fileHint: audio.fileType, underlyingQueue: underlyingQueue)
+    }
+
+    func close() {
+        isOpen = false
+        isReadScheduled = false
+        generation &+= 1
+    }
+
+    func suspend() {
+        isSuspended = true
+    }
+
+    func resume() {
+        isSuspended = false
+        scheduleRead()
+    }
+
+    func seek(at offset: Int) {
+        close()
+        if bytes == nil {
+            do {
+                let bytes = try makeBytes()
+                bytes.advise(MADV_SEQUENTIAL, range: 0 ..< bytes.length)
+                self.bytes = bytes
+                length = bytes.length
+            } catch {
+                delegate?.errorOccured(source: self, error: error)
+                return
+            }
+        }
+        position = min(max(offset, 0), length)
+        advisedOffset = position
+        isOpen = true
+        isSuspended = false
+        scheduleRead()
+    }
+
+    // MARK: Private
+
+    private func scheduleRead() {
+        guard isOpen, !isSuspended, !isReadScheduled else { return }
+        isReadScheduled = true
+        let generation = self.generation
+        underlyingQueue.async { [weak self] in
+            guard let self = self, self.generation == generation else { return }
+            self.isReadScheduled = false
+            self.read()
+        }
+    }
+
+    private func read() {
+        guard let bytes = bytes, isOpen, !isSuspended else { return }
+        let generation = self.generation
+        if position < length {
+            let end = min((position / readSize + 1) * readSize, length)
+            adviseReadAhead(of: bytes, from: end)
+            let data = bytes.data(in: position ..< end)
+            position = end
+            delegate?.dataAvailable(source: self, data: data)
+            // the delegate may have closed or seeked the source
+            guard self.generation == generation else { return }
+        }
+        if position >= length {
+            isOpen = false
+            delegate?.endOfFileOccured(source: self)
+        } else {
+            scheduleRead()
+        }
+    }
+
+    /// Advises the bytes following the given offset as needed, ahead of the parser
+    private func adviseReadAhead(of bytes: SharedBytes, from offset: Int) {
+        guard offset + readSize > advisedOffset else { return }
+        let end = min(offset + readAheadSize, bytes.length)
+        guard end > max(advisedOffset, offset) else { return }
+        bytes.advise(MADV_WILLNEED, range: max(advisedOffset, offset) ..< end)
+        advisedOffset = end
+    }
+}
+
+/// Bytes handed out as `Data` slices without copying, released once their owner and all the slices are
+final class SharedBytes {
+    let length: Int
+    private let base: UnsafeRawPointer?
+    /// `true` for mapped files, which are advised of their access
+    private let isMapped: Bool
+    private let release: () -> Void
+
+    init(base: UnsafeRawPointer?, length: Int, isMapped: Bool = false, release: @escaping () -> Void) {
+        self.base = base
+        self.length = base == nil ? 0 : length
+        self.isMapped = isMapped
+        self.release = release
+    }
+
+    /// The bytes of the given data, whose storage is kept rather than copied
+    convenience init(data: Data) {
+        // the bytes of an immutable `NSData` don't move for its lifetime
+        let object = data as NSData
+        self.init(base: object.bytes, length: object.length) {
+            withExtendedLifetime(object) {}
+        }
+    }
+
+    deinit {
+        release()
+    }
+
+    /// The bytes in the given range, kept until the data is released
+    func data(in range: Range<Int>) -> Data {
+        guard let base = base, !range.isEmpty else { return Data() }
+        return Data(bytesNoCopy: UnsafeMutableRawPointer(mutating: base + range.lowerBound),
+                     count: range.count,
+                     deallocator: .custom { _, _ in withExtendedLifetime(self) {} })
+    }
+
+    /// Advises the kernel of the access to the given range of a mapped file, aligned to pages
+    func advise(_ advice: Int32, range: Range<Int>) {
+        guard isMapped, let base = base, !range.isEmpty else { return }
+        let pageSize = Int(getpagesize())
+        let start = range.lowerBound / pageSize * pageSize
+        _ = madvise(UnsafeMutableRawPointer(mutating: base + start), range.upperBound - start, advice)
+    }
+}
@@ -0,0 +1,386 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import AudioToolbox
+import Foundation
+
+/// Plays a stream published by several mirrors, listed by a `.pls` or `.m3u` playlist, from the mirror delivering
+/// audio first, failing over to the others.
+///
+/// Connecting races the mirrors as happy eyeballs does: the first mirror is connected, the next one
+/// `connectionAttemptDelay` later unless audio was delivered meanwhile, and the mirror delivering audio first is kept
+/// while the other is closed. A mirror failing to connect is replaced by the next one right away.
+///
+/// Once the mirror kept fails, or delivers nothing for `stallTimeout`, playback fails over to the next mirror at the
+/// position reached, the byte delivered for files and the live edge for live streams. An error is reported once
+/// every mirror failed.
+final class MirroredAudioSource: CoreAudioStreamSource, TimeShiftingSource {
+    /// `true` for the URLs of `.pls` and `.m3u` playlists
+    static func canPlay(url: URL) -> Bool {
+        ["pls", "m3u"].contains(url.pathExtension.lowercased())
+    }
+
+    weak var delegate: AudioStreamSourceDelegate?
+
+    var position: Int {
+        guard let source = active?.source, timeShiftBuffer != nil else { return deliveredPosition }
+        return source.position
+    }
+
+    var length: Int {
+        active?.source.length ?? 0
+    }
+
+    var audioFileHint: AudioFileTypeID {
+        (active ?? connections.first)?.source.audioFileHint ?? kAudioFileMP3Type
+    }
+
+    /// The time shift buffer of the mirror kept, it isn't carried over when failing over
+    var timeShiftBuffer: TimeShiftBuffer? {
+        (active?.source as? TimeShiftingSource)?.timeShiftBuffer
+    }
+
+    let underlyingQueue: DispatchQueue
+    /// The seconds a mirror is given to deliver audio before the next one is connected too
+    let connectionAttemptDelay: TimeInterval
+    /// The seconds without audio after which the mirror kept is failed over from, `0` disables it
+    let stallTimeout: TimeInterval
+    /// The mirrors connected at once while racing
+    let maximumRacingConnections = 2
+
+    private let playlistURL: URL?
+    private let networkingClient: NetworkingClient
+    private let additionalRequestHeaders: [String: String]
+    private let makeSource: (URL) -> CoreAudioStreamSource
+
+    private var mirrors: [URL]
+    private var playlistRequest: NetworkDataStream?
+    private var playlistData = Data()
+    private var playlistStatusCode = 200
+
+    /// The mirrors racing, or the one kept
+    private var connections: [MirrorConnection] = []
+    private var active: MirrorConnection?
+    /// The mirrors failed since a mirror last played for `stallTimeout`
+    private var failedMirrors: Set<Int> = []
+    private var keptTime = DispatchTime.now()
+    private var nextMirrorIndex = 0
+    /// The offset the mirrors are connected at
+    private var connectionOffset = 0
+    private var attemptWorkItem: DispatchWorkItem?
+    private var stallWorkItem: DispatchWorkItem?
+    private var lastDeliveryTime = DispatchTime.now()
+
+    private var deliveredPosition = 0
+    private var isOpen = false
+    private var isSuspended = false
+    private var hasEnded = false
+
+    /// - parameter makeSource: Makes the source of a mirror, reporting its errors rather than retrying them so it's
+    ///                         failed over from
+    init(networking: NetworkingClient,
+         playlistURL: URL?,
+         mirrors: [URL] = [],
+         underlyingQueue: DispatchQueue,
+         httpHeaders: [String: String],
+         connectionAttemptDelay: TimeInterval = 0.25,
+         stallTimeout: TimeInterval = 8,
+         makeSource: @escaping (URL) -> CoreAudioStreamSource)
+    {
+        networkingClient = networking
+        self.playlistURL = playlistURL
+        self.mirrors = mirrors
+        self.underlyingQueue = underlyingQueue
+        additionalRequestHeaders = httpHeaders
+        self.connectionAttemptDelay = connectionAttemptDelay
+        self.stallTimeout = stallTimeout
+        self.makeSource = makeSource
+    }
+
+    func close() {
+        isOpen = false
+        if let request = playlistRequest {
+            request.cancel()
+            networkingClient.remove(task: request)
+        }
+        playlistRequest = nil
+        closeConnections()
+    }
+
+    func seek(at offset: Int) {
+        isOpen = true
+        hasEnded = false
+        deliveredPosition = offset
+        if let active = active {
+            // the mirror kept seeks, eg. within its time shift buffer
+            active.source.seek(at: offset)
+            lastDeliveryTime = .now()
+            scheduleStallCheck(after: stallTimeout)
+            return
+        }
+        guard !mirrors.isEmpty else {
+            loadPlaylist()
+            return
+        }
+        connect(at: offset)
+    }
+
+    func suspend() {
+        isSuspended = true
+        stallWorkItem?.cancel()
+        stallWorkItem = nil
+        connections.forEach { $0.source.suspend() }
+    }
+
+    func resume() {
+        isSuspended = false
+        connections.forEach { $0.source.resume() }
+        lastDeliveryTime = .now()
+        scheduleStallCheck(after: stallTimeout)
+    }
+
+    // MARK: Playlist
+
+    private func loadPlaylist() {
+        guard let url = playlistURL, playlistRequest == nil else { return }
+        var urlRequest = URLRequest(url: url)
+        urlRequest.cachePolicy = .reloadIgnoringLocalCacheData
+        urlRequest.timeoutInterval = 30
+        for header in additionalRequestHeaders {
+            urlRequest.addValue(header.value, forHTTPHeaderField: header.key)
+        }
+        playlistData = Data()
+        playlistStatusCode = 200
+        playlistRequest = networkingClient.stream(request: urlRequest)
+            .responseStream { [weak self] event in
+                self?.underlyingQueue.async { [weak self] in
+                    self?.handlePlaylist(event: event, url: url)
+                }
+            }
+            .resume()
+    }
+
+    private func handlePlaylist(event: NetworkDataStream.ResponseEvent, url: URL) {
+        guard isOpen, let request = playlistRequest else { return }
+        switch event {
+        case let .response(response):
+            playlistStatusCode = response?.statusCode ?? playlistStatusCode
+        case let .stream(.success(value)):
+            playlistData.append(value.data ?? Data())
+        case let .stream(.failure(error)):
+            networkingClient.remove(task: request)
+            playlistRequest = nil
+            delegate?.errorOccured(source: self, error: error)
+        case .complete:
+            networkingClient.remove(task: request)
+            playlistRequest = nil
+            guard playlistStatusCode < 300 else {
+                delegate?.errorOccured(source: self, error: NetworkError.serverError)
+                return
+            }
+            switch StreamPlaylistParser(url: url).parse(input: String(decoding: playlistData, as: UTF8.self)) {
+            case let .success(mirrors):
+                Logger.debug("playlist lists %d mirrors", category: .networking, args: mirrors.count)
+                self.mirrors = mirrors
+                connect(at: deliveredPosition)
+            case let .failure(error):
+                delegate?.errorOccured(source: self, error: error)
+            }
+        }
+    }
+
+    // MARK: Racing
+
+    private func connect(at offset: Int) {
+        closeConnections()
+        connectionOffset = offset
+        attemptNextMirror()
+    }
+
+    /// Connects the next mirror not failed, and schedules the one following it unless audio is delivered first
+    private func attemptNextMirror() {
+        attemptWorkItem?.cancel()
+        attemptWorkItem = nil
+        guard isOpen, active == nil, connections.count < maximumRacingConnections else { return }
+        let connecting = Set(connections.map { $0.mirrorIndex })
+        guard let index = (0 ..< mirrors.count)
+            .map({ (nextMirrorIndex + $0) % mirrors.count })
+            .first(where: { !failedMirrors.contains($0) && !connecting.contains($0) })
+        else { return }
+        nextMirrorIndex = (index + 1) % mirrors.count
+
+        Logger.debug("connecting mirror %@", category: .networking, args: mirrors[index].absoluteString)
+        let connection = MirrorConnection(mirrorIndex: index, source: makeSource(mirrors[index]))
+        connection.owner = self
+        connections.append(connection)
+        connection.source.delegate = connection
+
+        let work = DispatchWorkItem { [weak self] in
+            self?.attemptNextMirror()
+        }
+        attemptWorkItem = work
+        underlyingQueue.asyncAfter(deadline: .now() + connectionAttemptDelay, execute: work)
+        // scheduled first, a mirror failing as it's connected attempts the next one right away
+        connection.source.seek(at: connectionOffset)
+    }
+
+    /// Keeps the mirror that delivered audio first, closing the others
+    private func keep(_ connection: MirrorConnection) {
+        Logger.debug("keeping mirror %@", category: .networking, args: mirrors[connection.mirrorIndex].absoluteString)
+        attemptWorkItem?.cancel()
+        attemptWorkItem = nil
+        connections.filter { $0 !== connection }.forEach(close)
+        connections = [connection]
+        active = connection
+        keptTime = .now()
+        nextMirrorIndex = (connection.mirrorIndex + 1) % mirrors.count
+        connection.pendingMetadata.forEach { delegate?.metadataReceived(data: $0) }
+        connection.pendingMetadata.removeAll()
+    }
+
+    /// Connects the next mirror at the position reached, files carry on from the byte delivered and live streams
+    /// from their live edge
+    private func failOver(from connection: MirrorConnection, error: Error?) {
+        // the mirrors are tried again once one played for a while, a mirror failing right away isn't retried
+        if secondsSince(keptTime) > stallTimeout {
+            failedMirrors.removeAll()
+        }
+        failedMirrors.insert(connection.mirrorIndex)
+        let offset = connection.source.length > 0 ? deliveredPosition : 0
+        closeConnections()
+        guard failedMirrors.count < mirrors.count else {
+            delegate?.errorOccured(source: self, error: error ?? NetworkError.serverError)
+            return
+        }
+        Logger.error("failing over from mirror %@", category: .networking,
+                     args: mirrors[connection.mirrorIndex].absoluteString)
+        connectionOffset = offset
+        attemptNextMirror()
+    }
+
+    private func closeConnections() {
+        attemptWorkItem?.cancel()
+        attemptWorkItem = nil
+        stallWorkItem?.cancel()
+        stallWorkItem = nil
+        connections.forEach(close)
+        connections.removeAll()
+        active = nil
+    }
+
+    private func close(_ connection: MirrorConnection) {
+        connection.owner = nil
+        connection.source.delegate = nil
+        connection.source.close()
+    }
+
+    // MARK: Stalls
+
+    private func scheduleStallCheck(after delay: TimeInterval) {
+        guard stallWorkItem == nil, stallTimeout > 0, active != nil, !isSuspended, !hasEnded else { return }
+        let work = DispatchWorkItem { [weak self] in
+            self?.checkStall()
+        }
+        stallWorkItem = work
+        underlyingQueue.asyncAfter(deadline: .now() + delay, execute: work)
+    }
+
+    private func checkStall() {
+        stallWorkItem = nil
+        guard let active = active, !isSuspended, !hasEnded else { return }
+        let elapsed = secondsSince(lastDeliveryTime)
+        guard elapsed >= stallTimeout else {
+            scheduleStallCheck(after: stallTimeout - elapsed)
+            return
+        }
+        failOver(from: active, error: nil)
+    }
+
+    private func secondsSince(_ time: DispatchTime) -> TimeInterval {
+        Double(DispatchTime.now().uptimeNanoseconds - time.uptimeNanoseconds) / 1_000_000_000
+    }
+
+    // MARK: Connection events
+
+    fileprivate func connection(_ connection: MirrorConnection, received data: Data) {
+        if active == nil {
+            keep(connection)
+        }
+        guard active === connection else { return }
+        deliveredPosition += data.count
+        delegate?.dataAvailable(source: self, data: data)
+        // measured once delivered, the delivery waits while the player's buffer is full
+        lastDeliveryTime = .now()
+        scheduleStallCheck(after: stallTimeout)
+    }
+
+    fileprivate func connection(_ connection: MirrorConnection, failedWith error: Error) {
+        if active === connection {
+            failOver(from: connection, error: error)
+            return
+        }
+        failedMirrors.insert(connection.mirrorIndex)
+        close(connection)
+        connections.removeAll { $0 === connection }
+        attemptNextMirror()
+        if connections.isEmpty {
+            delegate?.errorOccured(source: self, error: error)
+        }
+    }
+
+    fileprivate func connectionEnded(_ connection: MirrorConnection) {
+        if active == nil {
+            keep(connection)
+        }
+        guard active === connection else { return }
+        // a live stream dropped by its mirror carries on from another one
+        if connection.source.length == 0, timeShiftBuffer == nil {
+            failOver(from: connection, error: nil)
+            return
+        }
+        hasEnded = true
+        stallWorkItem?.cancel()
+        stallWorkItem = nil
+        delegate?.endOfFileOccured(source: self)
+    }
+
+    fileprivate func connection(_ connection: MirrorConnection, received metadata: [String: String]) {
+        if active === connection {
+            delegate?.metadataReceived(data: metadata)
+        } else {
+            connection.pendingMetadata.append(metadata)
+        }
+    }
+}
+
+/// The connection to a mirror, the delegate of its source
+private final class MirrorConnection: AudioStreamSourceDelegate {
+    let mirrorIndex: Int
+    let source: CoreAudioStreamSource
+    weak var owner: MirroredAudioSource?
+    /// The metadata received before the mirror is kept
+    var pendingMetadata: [[String: String]] = []
+
+    init(mirrorIndex: Int, source: CoreAudioStreamSource) {
+        self.mirrorIndex = mirrorIndex
+        self.source = source
+    }
+
+    func dataAvailable(source _: CoreAudioStreamSource, data: Data) {
+        owner?.connection(self, received: data)
+    }
+
+    func errorOccured(source _: CoreAudioStreamSource, error: Error) {
+        owner?.connection(self, failedWith: error)
+    }
+
+    func endOfFileOccured(source _: CoreAudioStreamSource) {
+        owner?.connectionEnded(self)
+    }
+
+    func metadataReceived(data: [String: String]) {
+        owner?.connection(self, received: data)
+    }
+}
@@ -8,30 +8,89 @@ import AVFoundation
 import Foundation
 import Network
 
-public class RemoteAudioSource: AudioStreamSource {
+public class RemoteAudioSource: AudioStreamSource, TimeShiftingSource {
     weak var delegate: AudioStreamSourceDelegate?
 
     var position: Int {
+        if timeShiftBuffer != nil {
+            return timeShiftPosition.value
+        }
         return seekOffset + relativePosition
     }
 
     var length: Int {
-        guard let parsedHeader = parsedHeaderOutput else { return 0 }
-        return parsedHeader.fileLength
+        if let relocatedLength = moovRelocator?.relocatedLength {
+            return relocatedLength
+        }
+        // a response without a length, eg. a live stream, has no length past its tag either
+        guard let parsedHeader = parsedHeaderOutput, parsedHeader.fileLength > 0 else { return 0 }
+        return max(parsedHeader.fileLength - (id3TagReader?.tagSize ?? 0), 0)
     }
 
     private let url: URL
     private let networkingClient: NetworkingClient
     private var streamRequest: NetworkDataStream?
 
+    /// Drops the ID3v2 tag leading MP3 and ADTS files, reporting its text frames as metadata
+    private var id3TagReader: ID3TagReader?
+    /// Moves the `moov` box of MP4 files stored after `mdat` in front of it
+    private var moovRelocator: MP4MoovRelocator?
+    /// The request for the boxes following `mdat`, while awaiting `moov`
+    private var moovRequest: NetworkDataStream?
+    private var isMoovRequested = false
+    /// The original offset of the next byte received by the `moovRequest`
+    private var moovRequestPosition: Int?
+
+    /// Downloads long files in parallel segments ahead of the stream request, `nil` downloads them with a single one
+    private let segmentedDownloadPolicy: SegmentedDownloadPolicy?
+    private var segmentedDownload: SegmentedDownload?
+    /// `false` once a server doesn't honour the ranges of the segments
+    private var canDownloadSegments = true
+    /// The offset of the file the stream request receives next
+    private var streamRequestOffset = 0
+
+    /// The bytes of live streams kept on disk while paused or rewound, `0` disables time shifting
+    private let timeShiftBufferSize: Int
+    private let timeShifting = Protected<TimeShiftBuffer?>(nil)
+    /// The offset in the time shift buffer of the next byte delivered
+    private let timeShiftPosition = Protected<Int>(0)
+    /// Suspended by the player, time shifted streams keep being received while their delivery is suspended
+    private let isDeliverySuspended = Protected<Bool>(false)
+    /// `true` until the response of the stream request arrives, the stream operation queue is suspended meanwhile
+    private var isAwaitingResponse = false
+    private let isTimeShiftDeliveryScheduled = Atomic<Bool>(false)
+    /// The stream operations receiving audio not run yet, of the stream opened last. Time shifted audio is received on
+    /// `timeShiftReceiveQueue` once they're run, so it keeps being kept while the delivery waits for the player, eg.
+    /// paused with its buffer full
+    private let receiveOperations = Protected<(pending: Int, generation: Int)>((0, 0))
+    /// Receives the time shifted audio, serialized with the stream being closed or opened again
+    private let timeShiftReceiveQueue = DispatchQueue(label: "remote.audio.source.time.shift.receive.queue")
+    private var isLiveStreamComplete = false
+    private var isEndOfFileDelivered = false
+    private let timeShiftReadSize = 16 * 1024
+    /// The metadata of the time shift buffer at the offset it precedes, the metadata in effect before the audio held
+    /// is kept too
+    private let timeShiftMetadata = Protected<[(offset: Int, metadata: [String: String])]>([])
+    /// The offset of the time shifted metadata last reported, `-1` reports the metadata in effect at the next delivery
+    private var reportedTimeShiftMetadataOffset = -1
+
+    /// The buffer keeping the live stream, `nil` unless time shifting is enabled and the stream has no length
+    var timeShiftBuffer: TimeShiftBuffer? {
+        timeShifting.value
+    }
+
     private var additionalRequestHeaders: [String: String]
 
     private var parsedHeaderOutput: HTTPHeaderParserOutput?
     private var relativePosition: Int
     private var seekOffset: Int
     private var supportsSeek: Bool
+    /// `false` until a response tells whether seeking is supported, a source opened at an offset requests its range
+    private var isSeekSupportKnown = false
 
     internal var metadataStreamProcessor: MetadataStreamSource
+    /// The metadata parsed from the data being processed, at the offset of the audio extracted it precedes
+    private var pendingMetadata: [(offset: Int, metadata: [String: String])] = []
 
     private var shouldTryParsingIcycastHeaders: Bool = false
     private let icycastHeadersProcessor: IcycastHeadersProcessor
@@ -48,6 +107,9 @@ public class RemoteAudioSource: AudioStreamSource {
     internal let netStatusService: NetStatusProvider
     internal var waitingForNetwork = false
     internal let retrierTimeout: Retrier
+    /// `false` reports the transport errors rather than requesting the stream again, eg. for another mirror to be
+    /// failed over to
+    internal let retriesOnError: Bool
 
     init(networking: NetworkingClient,
          metadataStreamSource: MetadataStreamSource,
@@ -56,7 +118,10 @@ public class RemoteAudioSource: AudioStreamSource {
          retrier: Retrier,
          url: URL,
          underlyingQueue: DispatchQueue,
-         httpHeaders: [String: String])
+         httpHeaders: [String: String],
+         timeShiftBufferSize: Int = 0,
+         segmentedDownloadPolicy: SegmentedDownloadPolicy? = nil,
+         retriesOnError: Bool = true)
     {
         networkingClient = networking
         metadataStreamProcessor = metadataStreamSource
@@ -65,6 +130,8 @@ public class RemoteAudioSource: AudioStreamSource {
         relativePosition = 0
         seekOffset = 0
         supportsSeek = false
+        self.timeShiftBufferSize = timeShiftBufferSize
+        self.segmentedDownloadPolicy = segmentedDownloadPolicy
         netStatusService = netStatusProvider
         self.icycastHeadersProcessor = icycastHeadersProcessor
         self.underlyingQueue = underlyingQueue
@@ -74,13 +141,17 @@ public class RemoteAudioSource: AudioStreamSource {
         streamOperationQueue.isSuspended = true
         streamOperationQueue.name = "remote.audio.source.data.stream.queue"
         retrierTimeout = retrier
+        self.retriesOnError = retriesOnError
         startNetworkService()
     }
 
     convenience init(networking: NetworkingClient,
                      url: URL,
                      underlyingQueue: DispatchQueue,
-                     httpHeaders: [String: String])
+                     httpHeaders: [String: String],
+                     timeShiftBufferSize: Int = 0,
+                     segmentedDownloadPolicy: SegmentedDownloadPolicy? = nil,
+                     retriesOnError: Bool = true)
     {
         let metadataParser = MetadataParser()
         let metadataProcessor = MetadataStreamProcessor(parser: metadataParser.eraseToAnyParser())
@@ -94,7 +165,10 @@ public class RemoteAudioSource: AudioStreamSource {
                   retrier: retrierTimout,
                   url: url,
                   underlyingQueue: underlyingQueue,
-                  httpHeaders: httpHeaders)
+                  httpHeaders: httpHeaders,
+                  timeShiftBufferSize: timeShiftBufferSize,
+                  segmentedDownloadPolicy: segmentedDownloadPolicy,
+                  retriesOnError: retriesOnError)
     }
 
     convenience init(networking: NetworkingClient,
@@ -112,38 +186,61 @@ public class RemoteAudioSource: AudioStreamSource {
         netStatusService.stop()
         streamOperationQueue.isSuspended = true
         streamOperationQueue.cancelAllOperations()
-        if let streamTask = streamRequest {
-            streamTask.cancel()
-            networkingClient.remove(task: streamTask)
+        timeShiftReceiveQueue.sync {
+            if let streamTask = streamRequest {
+                streamTask.cancel()
+                networkingClient.remove(task: streamTask)
+            }
+            streamRequest = nil
         }
-        streamRequest = nil
+        isTimeShiftDeliveryScheduled.store(false)
+        resetReceiveOperations()
+        cancelMoovRequest()
+        cancelSegmentedDownload()
     }
 
     func seek(at offset: Int) {
+        if let buffer = timeShiftBuffer {
+            seekTimeShifted(buffer, at: offset)
+            return
+        }
         close()
+        isDeliverySuspended.write { $0 = false }
 
         relativePosition = 0
         seekOffset = offset
 
-        if !supportsSeek, offset != relativePosition {
+        if !supportsSeek, isSeekSupportKnown, offset != relativePosition {
             return
         }
 
         retrierTimeout.cancel()
-        metadataStreamProcessor.reset()
-        icycastHeadersProcessor.reset()
-        shouldTryParsingIcycastHeaders = false
+        timeShiftReceiveQueue.sync {
+            metadataStreamProcessor.reset()
+            icycastHeadersProcessor.reset()
+            shouldTryParsingIcycastHeaders = false
 
-        performOpen(seek: offset)
+            performOpen(seek: originalOffset(for: offset))
+        }
     }
 
     func suspend() {
+        isDeliverySuspended.write { $0 = true }
+        // the live stream keeps being received into the time shift buffer
+        guard timeShiftBuffer == nil else { return }
         streamRequest?.suspend()
+        segmentedDownload?.suspend()
         streamOperationQueue.isSuspended = true
     }
 
     func resume() {
+        isDeliverySuspended.write { $0 = false }
+        guard timeShiftBuffer == nil else {
+            scheduleTimeShiftedDelivery()
+            return
+        }
         streamRequest?.resume()
+        segmentedDownload?.resume()
         streamOperationQueue.isSuspended = false
     }
 
@@ -155,7 +252,7 @@ public class RemoteAudioSource: AudioStreamSource {
             guard connection.isConnected else { return }
             if self.waitingForNetwork {
                 self.waitingForNetwork = false
-                self.seek(at: self.position)
+                self.reconnect()
             }
         }
     }
@@ -171,6 +268,8 @@ public class RemoteAudioSource: AudioStreamSource {
             .resume()
 
         streamRequest = request
+        streamRequestOffset = seekOffset
+        isAwaitingResponse = true
         metadataStreamProcessor.delegate = self
     }
 
@@ -180,7 +279,7 @@ public class RemoteAudioSource: AudioStreamSource {
         switch event {
         case let .response(urlResponse):
             parseResponseHeader(response: urlResponse)
-            streamOperationQueue.isSuspended = false
+            stopAwaitingResponse()
         case let .stream(event):
             handleStreamEvent(event: event)
         case let .complete(event):
@@ -189,6 +288,19 @@ public class RemoteAudioSource: AudioStreamSource {
             } else {
                 addCompletionOperation { [weak self] in
                     guard let self = self else { return }
+                    // the segmented download delivers the end once the file is reassembled
+                    guard self.segmentedDownload == nil else { return }
+                    if self.timeShiftBuffer != nil {
+                        // the end is delivered once the time shifted audio is
+                        self.isLiveStreamComplete = true
+                        self.deliverTimeShiftedAudio()
+                        return
+                    }
+                    // `moov` wasn't found, the held bytes are delivered as is
+                    if let heldData = self.moovRelocator?.finish(), !heldData.isEmpty {
+                        self.delegate?.dataAvailable(source: self, data: heldData)
+                        self.relativePosition += heldData.count
+                    }
                     self.delegate?.endOfFileOccured(source: self)
                 }
             }
@@ -198,29 +310,40 @@ public class RemoteAudioSource: AudioStreamSource {
     private func handleStreamEvent(event: NetworkDataStream.StreamResult) {
         switch event {
         case let .success(value):
-            if let audioData = value.data {
+            guard let audioData = value.data else { return }
+            // time shifted audio is received as it arrives, once the audio received before it is
+            let isQueued = receiveOperations.write { operations -> Bool in
+                guard operations.pending > 0 || timeShiftBuffer == nil else { return false }
+                operations.pending += 1
+                let generation = operations.generation
                 addStreamOperation { [weak self] in
                     guard let self = self else { return }
-                    if self.shouldTryParsingIcycastHeaders {
-                        let (header, extractedAudio) = self.icycastHeadersProcessor.proccess(data: audioData)
-                        if let header = header {
-                            self.shouldTryParsingIcycastHeaders = false
-                            let parser = IcycastHeaderParser()
-                            self.parsedHeaderOutput = parser.parse(input: header)
-                            if let metadataStep = self.parsedHeaderOutput?.metadataStep {
-                                self.metadataStreamProcessor.metadataAvailable(step: metadataStep)
-                            }
-
-                            let audioCount = self.processAudio(data: extractedAudio)
-                            self.relativePosition += audioCount
-                            return
-                        }
+                    self.receive(audioData)
+                    self.receiveOperations.write { operations in
+                        guard operations.generation == generation else { return }
+                        operations.pending -= 1
                     }
-                    let audioCount = self.processAudio(data: audioData)
-                    self.relativePosition += audioCount
+                }
+                return true
+            }
+            if !isQueued {
+                timeShiftReceiveQueue.sync {
+                    receive(audioData)
                 }
             }
-        case .failure:
+        case let .failure(error):
+            guard retriesOnError else {
+                // reported once the audio received before it is, and once resumed when suspended by the player
+                addStreamOperation { [weak self] in
+                    guard let self = self else { return }
+                    self.delegate?.errorOccured(source: self, error: error)
+                }
+                // no response arrives to lift the suspension awaiting it
+                if isAwaitingResponse {
+                    stopAwaitingResponse()
+                }
+                return
+            }
             if !netStatusService.isConnected {
                 waitingForNetwork = true
                 return
@@ -230,23 +353,111 @@ public class RemoteAudioSource: AudioStreamSource {
         }
     }
 
+    /// Lifts the suspension of the stream operation queue awaiting the response, unless suspended by the player
+    private func stopAwaitingResponse() {
+        isAwaitingResponse = false
+        // time shifted streams keep being received while suspended
+        streamOperationQueue.isSuspended = timeShiftBuffer == nil && isDeliverySuspended.value
+    }
+
+    /// Processes the audio received by the stream request
+    private func receive(_ audioData: Data) {
+        if let download = segmentedDownload {
+            if !download.adopt(audioData) {
+                cancelStreamRequest()
+            }
+            return
+        }
+        streamRequestOffset += audioData.count
+        if shouldTryParsingIcycastHeaders {
+            let (header, extractedAudio) = icycastHeadersProcessor.proccess(data: audioData)
+            if let header = header {
+                shouldTryParsingIcycastHeaders = false
+                let parser = IcycastHeaderParser()
+                parsedHeaderOutput = parser.parse(input: header)
+                if let metadataStep = parsedHeaderOutput?.metadataStep {
+                    metadataStreamProcessor.metadataAvailable(step: metadataStep)
+                }
+                startTimeShiftingIfNeeded()
+
+                let audioCount = processAudio(data: extractedAudio)
+                relativePosition += audioCount
+                return
+            }
+        }
+        let audioCount = processAudio(data: audioData)
+        relativePosition += audioCount
+        startSegmentedDownloadIfNeeded()
+    }
+
     /// Processing audio data, extracting metadata if needed.
     /// - Parameter data: The audio to be processed
     /// - Returns: An `Int` value representing the amount of audio data bytes.
     private func processAudio(data: Data) -> Int {
         if self.metadataStreamProcessor.canProccessMetadata {
             let extractedAudioData = self.metadataStreamProcessor.proccessMetadata(data: data)
-            self.delegate?.dataAvailable(source: self, data: extractedAudioData)
-            return extractedAudioData.count
+            let metadata = self.pendingMetadata
+            self.pendingMetadata.removeAll()
+            return self.deliverAudio(data: extractedAudioData, metadata: metadata)
+        } else if let tagReader = self.id3TagReader, !tagReader.isComplete {
+            let audioData = tagReader.process(data)
+            if tagReader.shouldSkipWithRequest, self.supportsSeek {
+                self.skipID3Tag(tagReader)
+                return 0
+            }
+            self.reportID3Frames(tagReader)
+            return self.deliverAudio(data: audioData)
+        } else if let relocator = self.moovRelocator {
+            let relocatedData = relocator.process(data)
+            self.requestMoovIfNeeded()
+            return self.deliverAudio(data: relocatedData)
         } else {
-            self.delegate?.dataAvailable(source: self, data: data)
+            return self.deliverAudio(data: data)
+        }
+    }
+
+    /// Delivers the received audio, which the ID3 tag reader or the `moov` relocator may hold back, or appends it
+    /// to the time shift buffer it's delivered from
+    /// - Parameter metadata: The metadata within the audio, reported between the audio preceding and following it
+    /// - Returns: The amount of audio data bytes delivered
+    private func deliverAudio(data: Data, metadata: [(offset: Int, metadata: [String: String])] = []) -> Int {
+        guard !data.isEmpty || !metadata.isEmpty else { return 0 }
+        if let buffer = timeShiftBuffer {
+            let offset = buffer.range.upperBound
+            timeShiftMetadata.write { $0 += metadata.map { (offset + $0.offset, $0.metadata) } }
+            buffer.append(data)
+            pruneTimeShiftMetadata(before: buffer.range.lowerBound)
+            scheduleTimeShiftedDelivery()
             return data.count
         }
+        var start = 0
+        for item in metadata {
+            if item.offset > start {
+                let range = data.startIndex + start ..< data.startIndex + item.offset
+                delegate?.dataAvailable(source: self, data: data.subdata(in: range))
+                start = item.offset
+            }
+            delegate?.metadataReceived(data: item.metadata)
+        }
+        if start < data.count {
+            let remaining = start == 0 ? data : data.subdata(in: data.startIndex + start ..< data.endIndex)
+            delegate?.dataAvailable(source: self, data: remaining)
+        }
+        return data.count
     }
 
     private func parseResponseHeader(response: HTTPURLResponse?) {
         guard let response = response else { return }
         let httpStatusCode = response.statusCode
+        // the whole stream served to a source opened at an offset, eg. failing over to another mirror, can't be
+        // carried on from it
+        let isRangeIgnored = !isSeekSupportKnown && seekOffset > 0 && httpStatusCode == 200
+        isSeekSupportKnown = true
+        if isRangeIgnored {
+            cancelStreamRequest()
+            delegate?.errorOccured(source: self, error: NetworkError.serverError)
+            return
+        }
         let parser = HTTPHeaderParser()
         parsedHeaderOutput = parser.parse(input: response)
 
@@ -264,6 +475,21 @@ public class RemoteAudioSource: AudioStreamSource {
         if let metadataStep = parsedHeaderOutput?.metadataStep {
             metadataStreamProcessor.metadataAvailable(step: metadataStep)
         }
+
+        // the layout of MP4 files is read from their start, relocation carries on through seeks afterwards
+        if moovRelocator == nil, seekOffset == 0, httpStatusCode < 300,
+           MP4MoovRelocator.canRelocate(fileType: audioFileHint)
+        {
+            moovRelocator = MP4MoovRelocator()
+        }
+        if id3TagReader == nil, seekOffset == 0, httpStatusCode < 300, parsedHeaderOutput?.metadataStep == 0,
+           ID3TagReader.canRead(fileType: audioFileHint)
+        {
+            id3TagReader = ID3TagReader()
+        }
+        if httpStatusCode < 300 {
+            startTimeShiftingIfNeeded()
+        }
         checkHTTP(statusCode: httpStatusCode)
     }
 
@@ -290,16 +516,283 @@ public class RemoteAudioSource: AudioStreamSource {
         urlRequest.addValue("1", forHTTPHeaderField: "Icy-MetaData")
         urlRequest.addValue("identity", forHTTPHeaderField: "Accept-Encoding")
 
-        if supportsSeek && seekOffset > 0 {
+        if supportsSeek || !isSeekSupportKnown, seekOffset > 0 {
             urlRequest.addValue("bytes=\(seekOffset)-", forHTTPHeaderField: "Range")
         }
         return urlRequest
     }
 
+    // MARK: - MP4 moov Relocation
+
+    /// Requests the boxes following `mdat` once the relocator awaits `moov`, so it's read concurrently with `mdat`
+    private func requestMoovIfNeeded() {
+        guard let relocator = moovRelocator, relocator.state == .awaitingMoov else {
+            // the stream got to `moov` first
+            cancelMoovRequest()
+            return
+        }
+        guard !isMoovRequested, let tailOffset = relocator.tailOffset else { return }
+        isMoovRequested = true
+        guard supportsSeek else { return }
+
+        var urlRequest = buildUrlRequest(with: url, seekIfNeeded: 0)
+        urlRequest.setValue("bytes=\(tailOffset)-", forHTTPHeaderField: "Range")
+        moovRequest = networkingClient.stream(request: urlRequest)
+            .responseStream { [weak self] event in
+                self?.addStreamOperation { [weak self] in
+                    self?.handleMoovResponse(event: event, tailOffset: tailOffset)
+                }
+            }
+            .resume()
+    }
+
+    private func handleMoovResponse(event: NetworkDataStream.ResponseEvent, tailOffset: Int) {
+        guard let relocator = moovRelocator, relocator.state == .awaitingMoov else {
+            cancelMoovRequest()
+            return
+        }
+        switch event {
+        case let .response(urlResponse):
+            switch urlResponse?.statusCode {
+            case 206: moovRequestPosition = tailOffset
+            // the range isn't honoured, the file is read from its start
+            case 200: moovRequestPosition = 0
+            default: cancelMoovRequest()
+            }
+        case let .stream(.success(value)):
+            guard let data = value.data, let position = moovRequestPosition else { return }
+            moovRequestPosition = position + data.count
+            relativePosition += deliverAudio(data: relocator.appendTail(data, at: position))
+            if relocator.state != .awaitingMoov {
+                cancelMoovRequest()
+            }
+        case .stream(.failure), .complete:
+            // `moov` is read by the stream once it gets past `mdat`
+            cancelMoovRequest()
+        }
+    }
+
+    private func cancelMoovRequest() {
+        if let moovRequest = moovRequest {
+            moovRequest.cancel()
+            networkingClient.remove(task: moovRequest)
+        }
+        moovRequest = nil
+        moovRequestPosition = nil
+    }
+
+    // MARK: - Segmented Download
+
+    /// Downloads the rest of long files in parallel segments, taking over the stream request as the first of them
+    private func startSegmentedDownloadIfNeeded() {
+        guard let policy = segmentedDownloadPolicy, segmentedDownload == nil, canDownloadSegments, supportsSeek,
+              timeShiftBuffer == nil, moovRelocator == nil, id3TagReader?.isComplete ?? true,
+              !metadataStreamProcessor.canProccessMetadata, !shouldTryParsingIcycastHeaders,
+              let fileLength = parsedHeaderOutput?.fileLength,
+              fileLength - streamRequestOffset >= policy.minimumLength
+        else { return }
+        Logger.debug("downloading from offset %d in segments", category: .networking, args: streamRequestOffset)
+
+        let download = SegmentedDownload(networking: networkingClient,
+                                         policy: policy,
+                                         fileLength: fileLength,
+                                         offset: streamRequestOffset,
+                                         request: buildUrlRequest(with: url, seekIfNeeded: 0),
+                                         perform: { [weak self] block in self?.addStreamOperation(block) })
+        download.onData = { [weak self] data in
+            guard let self = self else { return }
+            self.relativePosition += self.processAudio(data: data)
+        }
+        download.onFailure = { [weak self] error in
+            self?.segmentedDownloadFailed(with: error)
+        }
+        download.onComplete = { [weak self] in
+            guard let self = self else { return }
+            self.delegate?.endOfFileOccured(source: self)
+        }
+        segmentedDownload = download
+        download.start()
+    }
+
+    /// Carries on with a single stream request from the position reached, as after any network failure
+    private func segmentedDownloadFailed(with error: Error) {
+        segmentedDownload = nil
+        if let networkError = error as? NetworkError, networkError == .serverError {
+            canDownloadSegments = false
+        }
+        cancelStreamRequest()
+        handleStreamEvent(event: .failure(error))
+    }
+
+    private func cancelSegmentedDownload() {
+        segmentedDownload?.cancel()
+        segmentedDownload = nil
+    }
+
+    private func cancelStreamRequest() {
+        if let streamTask = streamRequest {
+            streamTask.cancel()
+            networkingClient.remove(task: streamTask)
+        }
+        streamRequest = nil
+    }
+
+    // MARK: - ID3 Tag
+
+    /// Requests the stream past the ID3 tag rather than downloading the rest of it, eg. artwork
+    private func skipID3Tag(_ tagReader: ID3TagReader) {
+        let tagSize = tagReader.skipTag()
+        Logger.debug("skipping id3v2 tag, requesting audio from offset %d", category: .networking, args: tagSize)
+        reportID3Frames(tagReader)
+
+        cancelStreamRequest()
+        streamOperationQueue.isSuspended = true
+        streamOperationQueue.cancelAllOperations()
+        performOpen(seek: tagSize)
+    }
+
+    private func reportID3Frames(_ tagReader: ID3TagReader) {
+        guard let frames = tagReader.takeFrames() else { return }
+        delegate?.metadataReceived(data: frames)
+    }
+
+    /// Maps an offset of the delivered stream, which lacks the ID3 tag or has `moov` relocated, to the offset of the
+    /// file to read from
+    private func originalOffset(for offset: Int) -> Int {
+        if let tagReader = id3TagReader {
+            guard tagReader.isComplete else {
+                // the tag is read again from the start
+                id3TagReader = nil
+                return offset
+            }
+            return offset + tagReader.tagSize
+        }
+        guard let relocator = moovRelocator else { return offset }
+        guard relocator.state == .relocated else {
+            // the file is read again from the start, or as is
+            moovRelocator = nil
+            isMoovRequested = false
+            return offset
+        }
+        return relocator.seek(to: offset)
+    }
+
     private func retryOnError() {
         retrierTimeout.retry { [weak self] in
             guard let self = self else { return }
-            self.seek(at: self.position)
+            self.reconnect()
+        }
+    }
+
+    /// Requests the stream again from the current position, or from the live edge of time shifted streams
+    private func reconnect() {
+        guard timeShiftBuffer != nil else {
+            seek(at: position)
+            return
+        }
+        timeShiftReceiveQueue.sync {
+            if let streamTask = streamRequest {
+                streamTask.cancel()
+                networkingClient.remove(task: streamTask)
+            }
+        }
+        streamOperationQueue.isSuspended = true
+        streamOperationQueue.cancelAllOperations()
+        isTimeShiftDeliveryScheduled.store(false)
+        resetReceiveOperations()
+        isLiveStreamComplete = false
+        timeShiftReceiveQueue.sync {
+            metadataStreamProcessor.reset()
+            icycastHeadersProcessor.reset()
+            shouldTryParsingIcycastHeaders = false
+            performOpen(seek: 0)
+        }
+    }
+
+    /// Forgets the receive operations cancelled, the ones already running don't count against the stream opened next
+    private func resetReceiveOperations() {
+        receiveOperations.write { operations in
+            operations = (0, operations.generation + 1)
+        }
+    }
+
+    // MARK: - Time Shifting
+
+    /// Keeps streams without a length, such as live radio, in a time shift buffer once enabled
+    private func startTimeShiftingIfNeeded() {
+        guard timeShiftBufferSize > 0, timeShiftBuffer == nil, seekOffset == 0, length == 0 else { return }
+        do {
+            let buffer = try TimeShiftBuffer(capacity: timeShiftBufferSize)
+            timeShiftPosition.write { $0 = 0 }
+            timeShifting.write { $0 = buffer }
+        } catch {
+            Logger.error("time shift buffer failed, playing live only", category: .networking)
+        }
+    }
+
+    /// Moves the delivery within the time shift buffer, the live stream carries on being received
+    private func seekTimeShifted(_ buffer: TimeShiftBuffer, at offset: Int) {
+        let range = buffer.range
+        timeShiftPosition.write { $0 = min(max(offset, range.lowerBound), range.upperBound) }
+        isDeliverySuspended.write { $0 = false }
+        isEndOfFileDelivered = false
+        reportedTimeShiftMetadataOffset = -1
+        scheduleTimeShiftedDelivery()
+    }
+
+    /// Schedules the delivery of the time shifted audio on the stream operation queue, unless it's scheduled already
+    private func scheduleTimeShiftedDelivery() {
+        guard isTimeShiftDeliveryScheduled.compareExchange(expected: false, desired: true).exchanged else { return }
+        let operation = BlockOperation { [weak self] in
+            self?.isTimeShiftDeliveryScheduled.store(false)
+            self?.deliverTimeShiftedAudio()
+        }
+        // the audio queued to be received goes first, it's never held behind a delivery waiting for the player
+        operation.queuePriority = .low
+        streamOperationQueue.addOperation(operation)
+    }
+
+    /// Delivers the time shifted audio following the delivery position, a slice per hop on the stream operation
+    /// queue, the live stream is appended on `timeShiftReceiveQueue` meanwhile
+    private func deliverTimeShiftedAudio() {
+        guard let buffer = timeShiftBuffer, !isDeliverySuspended.value else { return }
+        let range = buffer.range
+        // audio evicted before being delivered is skipped
+        let start = max(timeShiftPosition.value, range.lowerBound)
+        reportTimeShiftMetadata(at: start)
+        guard start < range.upperBound else {
+            if isLiveStreamComplete, !isEndOfFileDelivered {
+                isEndOfFileDelivered = true
+                delegate?.endOfFileOccured(source: self)
+            }
+            return
+        }
+        var end = min(start + timeShiftReadSize, range.upperBound)
+        // slices end at metadata, it's reported before the audio following it
+        if let next = timeShiftMetadata.value.first(where: { $0.offset > start }) {
+            end = min(end, next.offset)
+        }
+        timeShiftPosition.write { $0 = end }
+        delegate?.dataAvailable(source: self, data: buffer.data(in: start ..< end))
+
+        guard end < range.upperBound else { return }
+        scheduleTimeShiftedDelivery()
+    }
+
+    /// Reports the metadata in effect at the given offset of the time shift buffer, unless it was reported last
+    private func reportTimeShiftMetadata(at offset: Int) {
+        guard let current = timeShiftMetadata.value.last(where: { $0.offset <= offset }),
+              current.offset != reportedTimeShiftMetadataOffset
+        else { return }
+        reportedTimeShiftMetadataOffset = current.offset
+        delegate?.metadataReceived(data: current.metadata)
+    }
+
+    /// Removes the metadata of evicted audio, keeping the one in effect at the start of the buffer
+    private func pruneTimeShiftMetadata(before offset: Int) {
+        timeShiftMetadata.write { metadata in
+            guard let index = metadata.lastIndex(where: { $0.offset <= offset }), index > 0 else { return }
+            metadata.removeFirst(index)
         }
     }
 
@@ -324,8 +817,9 @@ public class RemoteAudioSource: AudioStreamSource {
 }
 
 extension RemoteAudioSource: MetadataStreamSourceDelegate {
-    func didReceiveMetadata(metadata: Result<[String: String], MetadataParsingError>) {
+    func didReceiveMetadata(metadata: Result<[String: String], MetadataParsingError>, audioOffset: Int) {
         guard case let .success(data) = metadata else { return }
-        delegate?.metadataReceived(data: data)
+        // reported once the audio preceding it is delivered
+        pendingMetadata.append((audioOffset, data))
     }
 }
@@ -0,0 +1,236 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import Foundation
+
+/// Selects how long progressive files are downloaded in segments, see `SegmentedDownload`
+struct SegmentedDownloadPolicy: Equatable {
+    /// The requests downloading segments at once, the one of the playhead segment included
+    var maximumConnections: Int
+    /// The bytes of a segment
+    var segmentSize: Int = 512 * 1024
+    /// The segments downloaded ahead of the playhead segment
+    var maximumSegmentsAhead: Int
+    /// Files with fewer bytes left to download are downloaded by a single request
+    var minimumLength: Int
+
+    init(maximumConnections: Int, segmentSize: Int = 512 * 1024) {
+        self.maximumConnections = max(maximumConnections, 1)
+        self.segmentSize = max(segmentSize, 1)
+        maximumSegmentsAhead = 2 * self.maximumConnections
+        minimumLength = 4 * self.segmentSize
+    }
+}
+
+/// Downloads a file in segments of byte ranges over parallel requests, delivering them in order.
+///
+/// The segment being delivered, the playhead segment, is the first one requested and the one at high priority, the
+/// ones following it are downloaded ahead by the connections left, up to `maximumSegmentsAhead`. The first segment is
+/// taken over from the request the download starts from, see `adopt(_:)`.
+///
+/// - note: Its state is only used on the queue `perform` schedules on, the network events are scheduled there too.
+final class SegmentedDownload {
+    private final class Segment {
+        let range: Range<Int>
+        /// The bytes received and not delivered yet
+        var pending = Data()
+        var received = 0
+        var stream: NetworkDataStream?
+        /// Downloaded by the request the download started from
+        var isAdopted = false
+
+        init(range: Range<Int>) {
+            self.range = range
+        }
+
+        var isComplete: Bool {
+            received == range.count
+        }
+
+        var isDownloading: Bool {
+            !isComplete && (stream != nil || isAdopted)
+        }
+    }
+
+    /// The audio following the bytes delivered, in order
+    var onData: ((Data) -> Void)?
+    /// A segment failed, the download is cancelled
+    var onFailure: ((Error) -> Void)?
+    /// The whole file is delivered
+    var onComplete: (() -> Void)?
+
+    /// The offset of the file delivered next
+    private(set) var deliveredOffset: Int
+
+    private let networking: NetworkingClient
+    private let policy: SegmentedDownloadPolicy
+    private let fileLength: Int
+    private let request: URLRequest
+    private let perform: (@escaping () -> Void) -> Void
+
+    private var segments: [Segment] = []
+    private var nextOffset: Int
+    private var isSuspended = false
+    private var isCancelled = false
+
+    /// - parameter request: The request of the file, the range of each segment is set on it
+    /// - parameter offset: The offset of the file the request the download starts from receives next
+    /// - parameter perform: Schedules the given closure on the queue the download is used on
+    init(networking: NetworkingClient,
+         policy: SegmentedDownloadPolicy,
+         fileLength: Int,
+         offset: Int,
+         request: URLRequest,
+         perform: @escaping (@escaping () -> Void) -> Void)
+    {
+        self.networking = networking
+        self.policy = policy
+        self.fileLength = fileLength
+        self.request = request
+        self.perform = perform
+        deliveredOffset = offset
+        let first = Segment(range: offset ..< min(offset + policy.segmentSize, fileLength))
+        first.isAdopted = true
+        segments = [first]
+        nextOffset = first.range.upperBound
+    }
+
+    /// Requests the segments ahead of the playhead segment
+    func start() {
+        scheduleSegments()
+    }
+
+    /// Takes over the bytes received by the request the download started from, as the playhead segment
+    ///
+    /// - Returns: `false` once the playhead segment is complete, the request can then be cancelled
+    @discardableResult
+    func adopt(_ data: Data) -> Bool {
+        guard !isCancelled, let segment = segments.first, segment.isAdopted, !segment.isComplete else {
+            return false
+        }
+        append(data, to: segment)
+        return !isCancelled && !segment.isComplete
+    }
+
+    func suspend() {
+        isSuspended = true
+        segments.forEach { $0.stream?.suspend() }
+    }
+
+    func resume() {
+        isSuspended = false
+        segments.forEach { $0.stream?.resume() }
+        scheduleSegments()
+    }
+
+    func cancel() {
+        isCancelled = true
+        segments.forEach(cancelRequest)
+        segments.removeAll()
+    }
+
+    // MARK: Private
+
+    private func scheduleSegments() {
+        guard !isCancelled, !isSuspended else { return }
+        var downloading = segments.filter { $0.isDownloading }.count
+        while downloading < policy.maximumConnections,
+              segments.count <= policy.maximumSegmentsAhead,
+              nextOffset < fileLength
+        {
+            let segment = Segment(range: nextOffset ..< min(nextOffset + policy.segmentSize, fileLength))
+            nextOffset = segment.range.upperBound
+            segments.append(segment)
+            requestSegment(segment)
+            downloading += 1
+        }
+    }
+
+    private func requestSegment(_ segment: Segment) {
+        var urlRequest = request
+        urlRequest.setValue("bytes=\(segment.range.lowerBound)-\(segment.range.upperBound - 1)",
+                            forHTTPHeaderField: "Range")
+        let stream = networking.stream(request: urlRequest)
+            .responseStream { [weak self, weak segment] event in
+                self?.perform { [weak self] in
+                    guard let self = self, let segment = segment else { return }
+                    self.handle(event, of: segment)
+                }
+            }
+        segment.stream = stream
+        stream.task?.priority = segment === segments.first ? URLSessionTask.highPriority : URLSessionTask.lowPriority
+        stream.resume()
+    }
+
+    private func handle(_ event: NetworkDataStream.ResponseEvent, of segment: Segment) {
+        guard !isCancelled, segment.stream != nil else { return }
+        switch event {
+        case let .response(response):
+            // a range that isn't honoured can't be reassembled
+            if response?.statusCode != 206 {
+                fail(NetworkError.serverError)
+            }
+        case let .stream(.success(value)):
+            guard let data = value.data else { return }
+            append(data, to: segment)
+        case let .stream(.failure(error)):
+            fail(error)
+        case .complete:
+            guard segment.isComplete else {
+                fail(NetworkError.serverError)
+                return
+            }
+        }
+    }
+
+    private func append(_ data: Data, to segment: Segment) {
+        let count = min(data.count, segment.range.count - segment.received)
+        guard count > 0 else { return }
+        segment.pending.append(count == data.count ? data : data.prefix(count))
+        segment.received += count
+        if segment.isComplete {
+            cancelRequest(segment)
+            segment.isAdopted = false
+        }
+        if segment === segments.first {
+            deliverAvailable()
+        }
+        scheduleSegments()
+    }
+
+    /// Delivers the bytes received following the bytes delivered
+    private func deliverAvailable() {
+        while let segment = segments.first {
+            if !segment.pending.isEmpty {
+                let data = segment.pending
+                segment.pending = Data()
+                deliveredOffset += data.count
+                onData?(data)
+                // the delivery may have closed the source
+                guard !isCancelled else { return }
+            }
+            guard segment.isComplete else { break }
+            segments.removeFirst()
+            segments.first?.stream?.task?.priority = URLSessionTask.highPriority
+        }
+        if deliveredOffset == fileLength {
+            isCancelled = true
+            onComplete?()
+        }
+    }
+
+    private func cancelRequest(_ segment: Segment) {
+        guard let stream = segment.stream else { return }
+        stream.cancel()
+        networking.remove(task: stream)
+        segment.stream = nil
+    }
+
+    private func fail(_ error: Error) {
+        Logger.error("segmented download failed at offset %d", category: .networking, args: deliveredOffset)
+        cancel()
+        onFailure?(error)
+    }
+}
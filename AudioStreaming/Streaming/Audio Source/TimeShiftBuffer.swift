@@ -0,0 +1,182 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import Foundation
+
+/// A disk backed ring of the compressed audio of a live stream, so it can be paused and rewound.
+///
+/// The audio is addressed by absolute offsets, counted from the first byte appended, and once `capacity` is reached
+/// the oldest audio is evicted. The ring is a shared mapping of an unlinked file in the given directory, so its pages
+/// are written back to disk rather than held in memory, and the space is reclaimed once the buffer is released.
+///
+/// Offsets are related to time by a coarse index, marking the offset received every `indexInterval` seconds, as
+/// live audio arrives at the rate it's played.
+///
+/// - note: Appending happens on a single queue and reading on another one, or the same one, the ranges and the index
+/// can be queried from any thread. The audio overwritten by an append is evicted before it's written, so a read
+/// racing with it only returns the audio still held once copied.
+final class TimeShiftBuffer {
+    /// The offset of the audio received at the given time
+    struct Mark: Equatable {
+        let offset: Int
+        let time: TimeInterval
+    }
+
+    let capacity: Int
+    let indexInterval: TimeInterval
+
+    /// The offsets of the audio held
+    var range: Range<Int> {
+        lock.around { start ..< end }
+    }
+
+    /// The seconds of audio held, from the oldest to the live edge
+    var duration: TimeInterval {
+        lock.around { liveTime - time(at: start) }
+    }
+
+    private let bytes: UnsafeMutableRawPointer
+    private let now: () -> TimeInterval
+    private let lock = UnfairLock()
+
+    private var start = 0
+    private var end = 0
+    /// The time the last audio was received, that of the live edge
+    private var liveTime: TimeInterval = 0
+    /// The marks of the audio held, the first one at `start`
+    private var index: [Mark] = []
+
+    /// - parameter capacity: The bytes of audio held
+    /// - parameter directory: The directory of the file backing the ring
+    /// - parameter now: The time audio is received at, in seconds
+    init(capacity: Int,
+         directory: URL = FileManager.default.temporaryDirectory,
+         indexInterval: TimeInterval = 1,
+         now: @escaping () -> TimeInterval = { ProcessInfo.processInfo.systemUptime }) throws
+    {
+        guard capacity > 0 else { throw AudioSystemError.playerStartError }
+        let path = directory.appendingPathComponent("timeshift-\(UUID().uuidString)").path
+        let descriptor = open(path, O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR)
+        guard descriptor >= 0 else { throw AudioSystemError.playerStartError }
+        defer {
+            _ = Darwin.close(descriptor)
+            // the file lives on as long as it's mapped
+            unlink(path)
+        }
+        guard ftruncate(descriptor, off_t(capacity)) == 0,
+              let bytes = mmap(nil, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0),
+              bytes != MAP_FAILED
+        else {
+            throw AudioSystemError.playerStartError
+        }
+        self.bytes = bytes
+        self.capacity = capacity
+        self.indexInterval = indexInterval
+        self.now = now
+    }
+
+    deinit {
+        munmap(bytes, capacity)
+    }
+
+    /// Appends the given audio at the live edge, evicting the oldest audio once full
+    func append(_ data: Data) {
+        guard !data.isEmpty else { return }
+        let time = now()
+        // only the last `capacity` bytes of the data are kept
+        let kept = data.suffix(capacity)
+        let writeOffset = lock.around { () -> Int in
+            // the audio about to be overwritten is evicted first, readers no longer copy it
+            evict(before: min(max(end + data.count - capacity, start), end))
+            return end
+        }
+        kept.withUnsafeBytes { buffer in
+            copy(buffer, at: writeOffset + data.count - kept.count)
+        }
+
+        lock.lock(); defer { lock.unlock() }
+        end = writeOffset + data.count
+        liveTime = time
+        if index.last.map({ time - $0.time >= indexInterval }) ?? true {
+            index.append(Mark(offset: writeOffset, time: time))
+        }
+        // appending more than `capacity` at once evicts the start of the data appended too
+        evict(before: max(end - capacity, start))
+    }
+
+    /// Copies the audio in the given range, clamped to the audio held, out of the mapping
+    ///
+    /// - note: The audio is copied as it may be evicted and overwritten while it's parsed
+    func data(in range: Range<Int>) -> Data {
+        let held = self.range
+        let range = range.clamped(to: held)
+        guard !range.isEmpty else { return Data() }
+        var data = Data(count: range.count)
+        data.withUnsafeMutableBytes { buffer in
+            let first = min(range.count, capacity - range.lowerBound % capacity)
+            memcpy(buffer.baseAddress!, bytes + range.lowerBound % capacity, first)
+            if first < range.count {
+                memcpy(buffer.baseAddress! + first, bytes, range.count - first)
+            }
+        }
+        // audio evicted while copied may have been overwritten by an append
+        let evicted = min(self.range.lowerBound, range.upperBound) - range.lowerBound
+        return evicted > 0 ? data.subdata(in: evicted ..< data.count) : data
+    }
+
+    /// The offset of the audio received the given seconds before the live edge, clamped to the audio held
+    func offset(secondsBehindLive seconds: TimeInterval) -> Int {
+        lock.lock(); defer { lock.unlock() }
+        guard let first = index.first, seconds > 0 else { return end }
+        let target = liveTime - seconds
+        guard target > first.time else { return start }
+        let marks = index + [Mark(offset: end, time: liveTime)]
+        let upper = marks.firstIndex { $0.time >= target } ?? marks.count - 1
+        let (from, to) = (marks[upper - 1], marks[upper])
+        guard to.time > from.time else { return from.offset }
+        let fraction = (target - from.time) / (to.time - from.time)
+        return min(max(from.offset + Int(Double(to.offset - from.offset) * fraction), start), end)
+    }
+
+    /// The seconds the audio at the given offset was received before the live edge
+    func secondsBehindLive(at offset: Int) -> TimeInterval {
+        lock.around { max(liveTime - time(at: offset), 0) }
+    }
+
+    // MARK: Private
+
+    /// The time the audio at the given offset was received, interpolated between the marks around it
+    private func time(at offset: Int) -> TimeInterval {
+        guard let first = index.first else { return liveTime }
+        guard offset > first.offset else { return first.time }
+        guard offset < end else { return liveTime }
+        let upper = index.firstIndex { $0.offset > offset }
+        let from = index[(upper ?? index.count) - 1]
+        let to = upper.map { index[$0] } ?? Mark(offset: end, time: liveTime)
+        guard to.offset > from.offset else { return from.time }
+        return from.time + (to.time - from.time) * Double(offset - from.offset) / Double(to.offset - from.offset)
+    }
+
+    /// Drops the audio before the given offset, the first mark kept is moved to it
+    private func evict(before offset: Int) {
+        guard offset > start else { return }
+        let time = self.time(at: offset)
+        start = offset
+        let dropped = index.firstIndex { $0.offset > offset } ?? index.count
+        index.removeFirst(dropped)
+        index.insert(Mark(offset: offset, time: time), at: 0)
+    }
+
+    /// Copies the given bytes into the ring at the given offset, wrapping around its end
+    private func copy(_ buffer: UnsafeRawBufferPointer, at offset: Int) {
+        guard let base = buffer.baseAddress, !buffer.isEmpty else { return }
+        let position = offset % capacity
+        let first = min(buffer.count, capacity - position)
+        memcpy(bytes + position, base, first)
+        if first < buffer.count {
+            memcpy(bytes, base + first, buffer.count - first)
+        }
+    }
+}
@@ -0,0 +1,158 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import Foundation
+
+/// An exponentially weighted moving average of a rate, eg. bytes per second.
+///
+/// Samples are weighted by their duration, so a burst of small samples counts the same as
+/// a single sample covering the same period.
+struct ThroughputEstimator {
+    /// The time, in seconds, after which a sample contributes half of its initial weight
+    let halfLife: TimeInterval
+    /// The number of samples required before an estimate is available
+    let minimumSamples: Int
+
+    private(set) var samples: Int = 0
+    private var rate: Double = 0
+
+    init(halfLife: TimeInterval = 2.0, minimumSamples: Int = 2) {
+        self.halfLife = halfLife
+        self.minimumSamples = minimumSamples
+    }
+
+    /// The estimated rate, `nil` until enough samples are recorded
+    var estimate: Double? {
+        samples >= minimumSamples ? rate : nil
+    }
+
+    /// Records the given amount transferred over the given duration
+    mutating func record(amount: Double, duration: TimeInterval) {
+        guard duration > 0, amount >= 0 else { return }
+        let sampleRate = amount / duration
+        if samples == 0 {
+            rate = sampleRate
+        } else {
+            let alpha = 1 - pow(0.5, duration / halfLife)
+            rate = alpha * sampleRate + (1 - alpha) * rate
+        }
+        samples += 1
+    }
+
+    mutating func reset() {
+        samples = 0
+        rate = 0
+    }
+}
+
+/// Decides how many seconds of audio are required before playback starts or resumes,
+/// based on the rate audio can be supplied compared to the rate it is played back.
+///
+/// Similar to a buffer-based start in ABR, with a supply of `r` seconds of audio per second of
+/// playback the buffer drains by `1 - r` per second, so to play the next `horizon` seconds without
+/// underrunning the buffer needs at least `horizon * (1 - r)` seconds. A supply faster than realtime
+/// only requires the `minimumSeconds`.
+struct AdaptiveBufferingPolicy: Equatable {
+    /// The lower bound of the required seconds, even on a fast supply
+    var minimumSeconds: Double = 0.25
+    /// The upper bound of the required seconds
+    var maximumSeconds: Double = 5.0
+    /// The fraction of the estimated supply that is considered unreliable, eg. `0.2` means only 80% is counted on.
+    var safetyMargin: Double = 0.2
+    /// The number of seconds of playback ahead that should not underrun
+    var horizonSeconds: Double = 10.0
+
+    /// Returns the seconds of audio required before playback starts
+    ///
+    /// - parameter supplyRate: The seconds of audio supplied per second, `nil` when there is no estimate yet.
+    /// - parameter remainingSeconds: The seconds of audio left to be supplied, `nil` when unknown eg. live streams.
+    /// - parameter fallbackSeconds: The seconds required when there is no estimate yet.
+    func secondsRequired(supplyRate: Double?, remainingSeconds: Double?, fallbackSeconds: Double) -> Double {
+        guard let supplyRate = supplyRate else {
+            return fallbackSeconds
+        }
+        var horizon = horizonSeconds
+        if let remainingSeconds = remainingSeconds {
+            horizon = min(horizon, max(0, remainingSeconds))
+        }
+        let deficit = max(0, 1 - supplyRate * (1 - safetyMargin))
+        return min(maximumSeconds, max(minimumSeconds, minimumSeconds + horizon * deficit))
+    }
+}
+
+/// Measures download and decode throughput of the reading entry and provides the
+/// frames required to start and resume playback according to an `AdaptiveBufferingPolicy`.
+///
+/// - note: Thread safe, downloads are recorded on the source queue while decoding happens on
+/// the queue parsing the file stream.
+final class AdaptiveBuffering {
+    let policy: AdaptiveBufferingPolicy
+
+    private let lock = UnfairLock()
+    private var network = ThroughputEstimator()
+    private var decoder = ThroughputEstimator()
+    private var lastArrival: TimeInterval?
+
+    private let outputSampleRate: Double
+    private let clock: () -> TimeInterval
+
+    init(policy: AdaptiveBufferingPolicy,
+         outputSampleRate: Double,
+         clock: @escaping () -> TimeInterval = { ProcessInfo.processInfo.systemUptime })
+    {
+        self.policy = policy
+        self.outputSampleRate = outputSampleRate
+        self.clock = clock
+    }
+
+    /// Records the arrival of downloaded bytes, the rate is measured between consecutive arrivals.
+    func recordDownload(byteCount: Int) {
+        let now = clock()
+        lock.around {
+            if let lastArrival = lastArrival {
+                network.record(amount: Double(byteCount), duration: now - lastArrival)
+            }
+            lastArrival = now
+        }
+    }
+
+    /// Records the frames produced by the decoder and the time it took to produce them.
+    func recordDecode(frameCount: UInt32, duration: TimeInterval) {
+        guard frameCount > 0 else { return }
+        lock.around {
+            decoder.record(amount: Double(frameCount), duration: duration)
+        }
+    }
+
+    /// Marks that downloading paused for reasons other than the network, eg. the buffer is full,
+    /// so the next arrival isn't measured against the time spent waiting.
+    func suspendMeasuring() {
+        lock.around { lastArrival = nil }
+    }
+
+    /// Resets the estimates, usually when a new entry starts reading
+    func reset() {
+        lock.around {
+            network.reset()
+            decoder.reset()
+            lastArrival = nil
+        }
+    }
+
+    /// Returns the seconds of audio supplied per second of playback
+    ///
+    /// - parameter bitrate: The bitrate of the compressed audio, in bits per second.
+    func supplyRate(bitrate: Double) -> Double? {
+        guard bitrate > 0 else { return nil }
+        return lock.around {
+            guard let bytesPerSecond = network.estimate else { return nil }
+            let downloadRate = bytesPerSecond / (bitrate / 8)
+            guard let framesPerSecond = decoder.estimate, outputSampleRate > 0 else {
+                return downloadRate
+            }
+            return min(downloadRate, framesPerSecond / outputSampleRate)
+        }
+    }
+}
@@ -11,7 +11,7 @@ open class AudioPlayer {
 
     public var muted: Bool {
         get { playerContext.muted.value }
-        set { playerContext.muted.write { $0 = newValue } }
+        set { playerContext.muted.store(newValue) }
     }
 
     /// The volume of the audio
@@ -30,8 +30,8 @@ open class AudioPlayer {
     /// **NOTE:** Setting this to a value of more than `1.0` while playing a live broadcast stream would
     /// result in the audio being exhausted before it could fetch new data.
     public var rate: Float {
-        get { rateNode.rate }
-        set { rateNode.rate = newValue }
+        get { playbackRates.value.requested }
+        set { updateRate { $0.requested = newValue } }
     }
 
     /// The player's current state.
@@ -65,20 +65,64 @@ open class AudioPlayer {
     }
 
     /// The progress of the audio playback, in seconds.
+    ///
+    /// The progress heard, interpolated from the `playbackClock` without locking, it can be polled on every frame.
     public var progress: Double {
         guard playerContext.internalState != .pendingNext else { return 0 }
+        return playbackClock.position(at: ProcessInfo.processInfo.systemUptime)
+    }
+
+    /// The latest sample of the playback clock, published by the render thread and read without locking.
+    ///
+    /// Use `PlaybackClockSample.position(at:)` with the target timestamp of a `CADisplayLink` for a smooth progress.
+    public var playbackClock: PlaybackClockSample {
+        rendererContext.playbackClock.sample()
+    }
+
+    /// The seconds of a live stream kept by the time shift buffer, which it can be rewound by.
+    ///
+    /// **NOTE** This is `0.0` unless `AudioPlayerConfiguration.timeShiftBufferSize` is set and a live stream plays
+    public var timeShiftDuration: TimeInterval {
         playerContext.entriesLock.lock()
         let playingEntry = playerContext.audioPlayingEntry
         playerContext.entriesLock.unlock()
-        guard let entry = playingEntry else { return 0 }
-        entry.seekRequest.lock.lock()
-        let seekRequested = entry.seekRequest.requested
-        let seekTime = entry.seekRequest.time
-        entry.seekRequest.lock.unlock()
-        if seekRequested {
-            return seekTime
+        return playingEntry?.timeShiftBuffer?.duration ?? 0
+    }
+
+    /// The latency of the live stream being played, `nil` unless `AudioPlayerConfiguration.liveLatencyControl` is set
+    public var liveLatencyMetrics: AudioPlayerLatencyMetrics? {
+        guard let control = configuration.liveLatencyControl else { return nil }
+        let sampleRate = outputAudioFormat.sampleRate
+        let bufferedFrames = rendererContext.lock.around { rendererContext.bufferContext.frameUsedCount }
+        return AudioPlayerLatencyMetrics(latency: Double(bufferedFrames) / sampleRate,
+                                         targetLatency: control.targetLatency,
+                                         isCatchingUp: isCatchingUpLive.value,
+                                         droppedSeconds: Double(rendererContext.droppedSilentFrameCount.value) / sampleRate)
+    }
+
+    /// Records the compressed audio read from now on, and its metadata, set to `nil` to stop recording.
+    ///
+    /// **NOTE** Call `StreamRecorder.finish(completion:)` to know when the recording is complete
+    public var streamRecorder: StreamRecorder? {
+        get { recorder.value }
+        set { recorder.write { $0 = newValue } }
+    }
+
+    /// The seconds the playback of a time shifted live stream is behind its live edge
+    public var secondsBehindLive: TimeInterval {
+        playerContext.entriesLock.lock()
+        let playingEntry = playerContext.audioPlayingEntry
+        playerContext.entriesLock.unlock()
+        guard let entry = playingEntry, let buffer = entry.timeShiftBuffer else { return 0 }
+        let requestedSeconds = entry.seekRequest.lock.around {
+            entry.seekRequest.requested ? entry.seekRequest.secondsBehindLive : nil
         }
-        return entry.progress
+        if let requestedSeconds = requestedSeconds {
+            return requestedSeconds
+        }
+        // the audio delivered to the player is yet to be played
+        let bufferedFrames = rendererContext.lock.around { rendererContext.bufferContext.frameUsedCount }
+        return buffer.secondsBehindLive(at: entry.position) + Double(bufferedFrames) / outputAudioFormat.sampleRate
     }
 
     public private(set) var customAttachedNodes = [AVAudioNode]()
@@ -95,6 +139,11 @@ open class AudioPlayer {
         audioEngine.mainMixerNode
     }
 
+    /// How often the audio converters of recently played formats were reused when switching entries
+    public var converterPoolStatistics: AudioConverterPoolStatistics {
+        converterPool.statistics
+    }
+
     public var frameFiltering: FrameFiltering {
         frameFilterProcessor
     }
@@ -107,12 +156,30 @@ open class AudioPlayer {
     /// Keeps track of the player's state before being paused.
     private var stateBeforePaused: InternalState = .initial
 
+    /// The scrub session in progress, see `beginScrubbing(previews:)`
+    private var scrubSession: ScrubSession?
+    private var scrubPreviewWork: DispatchWorkItem?
+    private var resumesAfterScrubbing = false
+
     /// The underlying `AVAudioEngine` object
     private let audioEngine = AVAudioEngine()
     /// An `AVAudioUnit` object that represents the audio player
     private(set) var player = AVAudioUnit()
     /// An `AVAudioUnitTimePitch` that controls the playback rate of the audio engine
     private let rateNode = AVAudioUnitTimePitch()
+    /// The rate requested through `rate` and the one catching up with the live edge, the node plays at their product
+    private let playbackRates = Protected<(requested: Float, catchUp: Float)>((1, 1))
+
+    /// Catches up with the live edge of live streams, when `AudioPlayerConfiguration.liveLatencyControl` is set
+    private var liveLatencyController: LiveLatencyController?
+    private let liveLatencyTimer: DispatchTimerSource
+    private let isCatchingUpLive = Atomic<Bool>(false)
+
+    private let recorder = Protected<StreamRecorder?>(nil)
+
+    /// The latency of the custom attached nodes, part of the latency of the playback clock
+    private let nodesLatency = Atomic<Double>(0)
+    private var routeChangeObserver: NSObjectProtocol?
 
     /// An object representing the context of the audio render.
     /// Holds the audio buffer and in/out lists as required by the audio rendering
@@ -122,6 +189,8 @@ open class AudioPlayer {
     private let playerContext: AudioPlayerContext
 
     private let fileStreamProcessor: AudioFileStreamProcessor
+    /// Keeps the audio converters of recently played formats, see `converterPoolStatistics`
+    private let converterPool = AudioConverterPool()
     private let playerRenderProcessor: AudioPlayerRenderProcessor
     private let frameFilterProcessor: FrameFilterProcessor
 
@@ -136,21 +205,37 @@ open class AudioPlayer {
     public init(configuration: AudioPlayerConfiguration = .default) {
         self.configuration = configuration.normalizeValues()
 
-        rendererContext = AudioRendererContext(configuration: configuration, outputAudioFormat: outputAudioFormat)
+        rendererContext = AudioRendererContext(configuration: self.configuration, outputAudioFormat: outputAudioFormat)
         playerContext = AudioPlayerContext()
         entriesQueue = PlayerQueueEntries()
 
         serializationQueue = DispatchQueue(label: "streaming.core.queue", qos: .userInitiated)
         sourceQueue = DispatchQueue(label: "source.queue", qos: .userInitiated)
         audioReadSource = DispatchTimerSource(interval: .milliseconds(200), queue: sourceQueue)
+        liveLatencyTimer = DispatchTimerSource(interval: .milliseconds(500), queue: serializationQueue)
+        liveLatencyController = self.configuration.liveLatencyControl.map(LiveLatencyController.init(control:))
 
+        let rendererContext = self.rendererContext
+        let outputSampleRate = outputAudioFormat.sampleRate
         entryProvider = AudioEntryProvider(networkingClient: NetworkingClient(),
                                            underlyingQueue: sourceQueue,
-                                           outputAudioFormat: outputAudioFormat)
+                                           outputAudioFormat: outputAudioFormat,
+                                           hlsVariantSelection: self.configuration.hlsVariantSelection,
+                                           timeShiftBufferSize: self.configuration.timeShiftBufferSize,
+                                           parallelDownloadConnections: self.configuration.parallelDownloadConnections,
+                                           bufferedSeconds: {
+                                               let frames = rendererContext.lock.around {
+                                                   rendererContext.bufferContext.frameUsedCount
+                                               }
+                                               return Double(frames) / outputSampleRate
+                                           })
 
         fileStreamProcessor = AudioFileStreamProcessor(playerContext: playerContext,
                                                        rendererContext: rendererContext,
-                                                       outputAudioFormat: outputAudioFormat.basicStreamDescription)
+                                                       outputAudioFormat: outputAudioFormat.basicStreamDescription,
+                                                       fastStartCache: self.configuration.enableFastStart ? .shared : nil,
+                                                       converterPool: converterPool,
+                                                       decoderPreference: self.configuration.decoderPreference)
 
         frameFilterProcessor = FrameFilterProcessor(mixerNode: audioEngine.mainMixerNode)
 
@@ -161,12 +246,24 @@ open class AudioPlayer {
         configPlayerContext()
         configPlayerNode()
         setupEngine()
+        startLiveLatencyControlIfNeeded()
+
+        routeChangeObserver = NotificationCenter.default.addObserver(forName: AVAudioSession.routeChangeNotification,
+                                                                     object: nil,
+                                                                     queue: nil) { [weak self] _ in
+            self?.updateOutputLatency()
+        }
     }
 
     deinit {
+        if let routeChangeObserver = routeChangeObserver {
+            NotificationCenter.default.removeObserver(routeChangeObserver)
+        }
         playerContext.audioPlayingEntry?.close()
         clearQueue()
         stopReadProccessFromSource()
+        liveLatencyTimer.suspend()
+        liveLatencyTimer.removeHandler()
         rendererContext.clean()
     }
 
@@ -184,7 +281,27 @@ open class AudioPlayer {
     /// - parameter url: A `URL` specifying the audio context to be played.
     /// - parameter headers: A `Dictionary` specifying any additional headers to be pass to the network request.
     public func play(url: URL, headers: [String: String]) {
-        let audioEntry = entryProvider.provideAudioEntry(url: url, headers: headers)
+        play(entry: entryProvider.provideAudioEntry(url: url, headers: headers))
+    }
+
+    /// Starts the audio playback of a stream published by several mirrors, from the mirror delivering audio first,
+    /// failing over to the others when it fails or stalls
+    ///
+    /// - note: The URL of a `.pls` or `.m3u` playlist passed to `play(url:)` is played the same way.
+    /// - parameter mirrors: The URLs of the mirrors, in the order they are preferred.
+    /// - parameter headers: A `Dictionary` specifying any additional headers to be pass to the network requests.
+    public func play(mirrors: [URL], headers: [String: String] = [:]) {
+        play(entry: entryProvider.provideAudioEntry(mirrors: mirrors, headers: headers))
+    }
+
+    /// Starts the audio playback of audio held in memory, without copying it
+    ///
+    /// - parameter audio: An `InMemoryAudio` holding the audio to be played.
+    public func play(audio: InMemoryAudio) {
+        play(entry: entryProvider.provideAudioEntry(audio: audio))
+    }
+
+    private func play(entry audioEntry: AudioEntry) {
         audioEntry.delegate = self
 
         checkRenderWaitingAndNotifyIfNeeded()
@@ -254,6 +371,21 @@ open class AudioPlayer {
         }
     }
 
+    /// Queues audio held in memory, without copying it
+    ///
+    /// - parameter audio: An `InMemoryAudio` holding the audio to be played.
+    public func queue(audio: InMemoryAudio) {
+        serializationQueue.sync {
+            let audioEntry = entryProvider.provideAudioEntry(audio: audio)
+            audioEntry.delegate = self
+            entriesQueue.enqueue(item: audioEntry, type: .upcoming)
+        }
+        checkRenderWaitingAndNotifyIfNeeded()
+        sourceQueue.async { [weak self] in
+            self?.processSource()
+        }
+    }
+
     /// Stops the audio playback
     public func stop() {
         guard playerContext.internalState != .stopped else { return }
@@ -273,8 +405,10 @@ open class AudioPlayer {
 
             self.clearQueue()
             self.playerContext.entriesLock.lock()
-            self.playerContext.audioReadingEntry = nil
-            self.playerContext.audioPlayingEntry = nil
+            self.playerContext.updateEntries { context in
+                context.audioReadingEntry = nil
+                context.audioPlayingEntry = nil
+            }
             self.playerContext.entriesLock.unlock()
 
             self.processSource()
@@ -324,11 +458,101 @@ open class AudioPlayer {
         guard let playingEntry = playerContext.audioPlayingEntry else {
             return
         }
+        requestSeek(of: playingEntry, to: time, secondsBehindLive: nil)
+    }
+
+    /// `true` between `beginScrubbing(previews:)` and `endScrubbing()`
+    public var isScrubbing: Bool {
+        scrubSession != nil
+    }
+
+    /// Starts a scrub session, eg. while the progress slider is dragged, use it from the main thread.
+    ///
+    /// Playback pauses and its source stays connected while scrubbing, the positions of `scrub(to:)` are coalesced
+    /// and `endScrubbing()` seeks once, to the last of them. Positions within the audio decoded, the audio buffered
+    /// or the last `seekHistoryInSeconds` played, are moved to without requesting the audio again.
+    /// - Parameter previews: Plays a short preview of the audio at the position scrubbed to once it rests, when the
+    ///                       position is within the audio decoded
+    public func beginScrubbing(previews: Bool = false) {
+        guard scrubSession == nil, playerContext.audioPlayingEntry != nil else { return }
+        let state = playerContext.internalState
+        resumesAfterScrubbing = state.contains(.running) && state != .paused
+        scrubSession = ScrubSession(queue: .main, previews: previews) { [weak self] time in
+            self?.applyScrub(to: time)
+        }
+        pause()
+    }
+
+    /// Scrubs to the specified time, the progress reports it right away while the audio follows once it rests.
+    /// - Parameter time: A `Double` value specifing the time scrubbed to in seconds
+    public func scrub(to time: Double) {
+        guard let session = scrubSession else { return }
+        rendererContext.playbackClock.hold(at: time)
+        session.scrub(to: time)
+    }
+
+    /// Ends the scrub session with a single seek to the last time scrubbed to, resuming playback if it was playing
+    public func endScrubbing() {
+        guard let session = scrubSession else { return }
+        scrubSession = nil
+        scrubPreviewWork?.cancel()
+        scrubPreviewWork = nil
+        if let time = session.end() {
+            seek(to: time)
+        }
+        if resumesAfterScrubbing {
+            resume()
+        } else {
+            pause()
+        }
+    }
+
+    /// Moves to a position the scrub session rested at, when it's within the audio decoded
+    private func applyScrub(to time: Double) {
+        guard let session = scrubSession,
+              let playingEntry = playerContext.audioPlayingEntry,
+              seekWithinBuffer(of: playingEntry, to: time)
+        else {
+            return
+        }
+        guard session.previews else { return }
+        scrubPreviewWork?.cancel()
+        resume()
+        let work = DispatchWorkItem { [weak self] in
+            guard let self = self, self.scrubSession != nil else { return }
+            self.pause()
+        }
+        scrubPreviewWork = work
+        DispatchQueue.main.asyncAfter(deadline: .now() + session.previewDuration, execute: work)
+    }
+
+    /// Seeks a time shifted live stream the given seconds behind its live edge, within `timeShiftDuration`.
+    ///
+    /// Progress carries on from where it is, counting the seconds played.
+    /// - Parameter seconds: A `TimeInterval` value of the seconds behind the live edge, `0` seeks to the live edge
+    public func seekBehindLive(by seconds: TimeInterval) {
+        guard let playingEntry = playerContext.audioPlayingEntry, playingEntry.timeShiftBuffer != nil else {
+            return
+        }
+        requestSeek(of: playingEntry, to: progress, secondsBehindLive: max(seconds, 0))
+    }
+
+    /// Seeks a time shifted live stream to its live edge
+    public func seekToLiveEdge() {
+        seekBehindLive(by: 0)
+    }
+
+    private func requestSeek(of playingEntry: AudioEntry, to time: Double, secondsBehindLive: Double?) {
+        if secondsBehindLive == nil, seekWithinBuffer(of: playingEntry, to: time) {
+            return
+        }
         playingEntry.seekRequest.lock.lock()
         let alreadyRequestedToSeek = playingEntry.seekRequest.requested
         playingEntry.seekRequest.requested = true
         playingEntry.seekRequest.time = time
+        playingEntry.seekRequest.secondsBehindLive = secondsBehindLive
         playingEntry.seekRequest.lock.unlock()
+        rendererContext.playbackClock.hold(at: time)
 
         if !alreadyRequestedToSeek {
             playingEntry.seekRequest.version.write { version in
@@ -342,6 +566,33 @@ open class AudioPlayer {
         }
     }
 
+    /// Seeks within the audio decoded, the frames buffered or played kept, by moving the read index of the buffer
+    /// without requesting the audio again or resetting the decoder
+    ///
+    /// - Returns: `true` if the time sought is within the audio decoded
+    private func seekWithinBuffer(of playingEntry: AudioEntry, to time: Double) -> Bool {
+        let state = playerContext.internalState
+        guard state == .playing || state == .paused, playerContext.audioReadingEntry === playingEntry else {
+            return false
+        }
+        let seekRequested = playingEntry.seekRequest.lock.around { playingEntry.seekRequest.requested }
+        guard !seekRequested else { return false }
+
+        let framesState = playingEntry.framesState
+        let playedFrames = framesState.played.value
+        let targetFrame = Int(((time - playingEntry.seekTime) * outputAudioFormat.sampleRate).rounded())
+        let frames = targetFrame - playedFrames
+        guard rendererContext.moveReadIndex(by: frames, playedFrames: playedFrames) else {
+            return false
+        }
+        framesState.played.add(frames)
+        rendererContext.playbackClock.hold(at: time)
+        rendererContext.playbackClock.release()
+        checkRenderWaitingAndNotifyIfNeeded()
+        Logger.debug("Seeked within the buffer by %d frames", category: .generic, args: frames)
+        return true
+    }
+
     /// Attaches the given `AVAudioNode` to the engine
     /// - Note: The node will be added after the default rate node
     /// - Parameter node: An instance of `AVAudioNode`
@@ -431,10 +682,19 @@ open class AudioPlayer {
 
     /// Attaches callbacks to the `playerContext` and `renderProcessor`.
     private func configPlayerContext() {
+        playerContext.entriesChanged = { [rendererContext] playingEntry, readingEntry in
+            rendererContext.publishRenderPlan(playingEntry: playingEntry, readingEntry: readingEntry)
+            rendererContext.playbackClock.follow(playingEntry)
+        }
+
         playerContext.stateChanged = { [weak self] oldValue, newValue in
             guard let self = self else { return }
+            let changedAt = ProcessInfo.processInfo.systemUptime
             asyncOnMain {
                 self.delegate?.audioPlayerStateChanged(player: self, with: newValue, previous: oldValue)
+                if newValue == .playing {
+                    self.reportStartupTimingsIfNeeded(firstAudioAt: changedAt)
+                }
             }
         }
 
@@ -449,6 +709,12 @@ open class AudioPlayer {
             }
         }
 
+        playerRenderProcessor.metadataReached = { [weak self] entry in
+            self?.serializationQueue.async {
+                self?.reportMetadata(reachedBy: entry)
+            }
+        }
+
         fileStreamProcessor.fileStreamCallback = { [weak self] effect in
             guard let self = self else { return }
             switch effect {
@@ -468,6 +734,8 @@ open class AudioPlayer {
 
         audioEngine.connect(audioEngine.inputNode, to: rateNode, format: nil)
         audioEngine.connect(rateNode, to: audioEngine.mainMixerNode, format: nil)
+        nodesLatency.store(0)
+        updateOutputLatency()
     }
 
     private func reattachCustomNodes() {
@@ -489,6 +757,14 @@ open class AudioPlayer {
         } else {
             audioEngine.connect(rateNode, to: audioEngine.mainMixerNode, format: nil)
         }
+        nodesLatency.store(customAttachedNodes.reduce(0) { $0 + (($1 as? AVAudioUnit)?.auAudioUnit.latency ?? 0) })
+        updateOutputLatency()
+    }
+
+    /// Updates the seconds from the output of the player until it's heard, see `playbackClock`
+    private func updateOutputLatency() {
+        let latency = AVAudioSession.sharedInstance().outputLatency + rateNode.auAudioUnit.latency + nodesLatency.value
+        rendererContext.playbackClock.outputLatency.store(latency)
     }
 
     /// Starts the engine, if not already running.
@@ -547,6 +823,54 @@ open class AudioPlayer {
         audioReadSource.removeHandler()
     }
 
+    /// Starts the timer of `liveLatencyTimer`, measuring the latency of live streams every `500 ms`
+    private func startLiveLatencyControlIfNeeded() {
+        guard liveLatencyController != nil else { return }
+        liveLatencyTimer.add { [weak self] in
+            self?.updateLiveLatency()
+        }
+        liveLatencyTimer.activate()
+    }
+
+    /// Catches up with the live edge once the audio buffered exceeds the target latency, see `LiveLatencyControl`
+    private func updateLiveLatency() {
+        dispatchPrecondition(condition: .onQueue(serializationQueue))
+        guard var controller = liveLatencyController else { return }
+        playerContext.entriesLock.lock()
+        let playingEntry = playerContext.audioPlayingEntry
+        playerContext.entriesLock.unlock()
+
+        // only streams without a length are live, and only while playing
+        let isLive = playingEntry.map { $0.length == 0 } ?? false
+        let isCatchingUp: Bool
+        if isLive, playerContext.internalState == .playing {
+            let frames = rendererContext.lock.around { rendererContext.bufferContext.frameUsedCount }
+            isCatchingUp = controller.update(latency: Double(frames) / outputAudioFormat.sampleRate)
+        } else {
+            controller.reset()
+            isCatchingUp = false
+        }
+        liveLatencyController = controller
+
+        guard isCatchingUpLive.exchange(isCatchingUp) != isCatchingUp else { return }
+        Logger.debug("live latency catch up %@", category: .audioRendering, args: isCatchingUp ? "started" : "stopped")
+        switch controller.control.catchUp {
+        case let .timeStretch(rate):
+            updateRate { $0.catchUp = isCatchingUp ? rate : 1 }
+        case .droppingSilence:
+            rendererContext.dropsSilentFrames.store(isCatchingUp)
+        }
+    }
+
+    /// Updates the rates the rate node plays at the product of
+    private func updateRate(_ change: (inout (requested: Float, catchUp: Float)) -> Void) {
+        playbackRates.write { rates in
+            change(&rates)
+            rateNode.rate = rates.requested * rates.catchUp
+            rendererContext.playbackClock.rate.store(Double(rateNode.rate))
+        }
+    }
+
     /// Starts the audio player, reseting the buffers if requested
     ///
     /// - parameter resetBuffers: A `Bool` value indicating if the buffers should be reset, prior starting the player.
@@ -558,6 +882,7 @@ open class AudioPlayer {
             try startEngineIfNeeded()
             try player.auAudioUnit.allocateRenderResources()
             try player.auAudioUnit.startHardware()
+            updateOutputLatency()
         } catch {
             stopEngine(reason: .error)
             raiseUnxpected(error: .audioSystemError(.playerStartError))
@@ -628,6 +953,7 @@ open class AudioPlayer {
                     playingEntry.seekRequest.lock.lock()
                     playingEntry.seekRequest.requested = false
                     playingEntry.seekRequest.lock.unlock()
+                    rendererContext.playbackClock.release()
                 }
             }
         }
@@ -642,6 +968,7 @@ open class AudioPlayer {
     private func setCurrentReading(entry: AudioEntry?, startPlaying: Bool, shouldClearQueue: Bool) {
         guard let entry = entry else { return }
         Logger.debug("Setting current reading entry to: %@", category: .generic, args: entry.debugDescription)
+        entry.startupTimeline.mark(.requested)
         if startPlaying {
             rendererContext.fillSilenceAudioBuffer()
         }
@@ -653,12 +980,17 @@ open class AudioPlayer {
             readingEntry.close()
         }
 
+        rendererContext.adaptiveBuffering?.reset()
+
         entry.delegate = self
         entry.seek(at: 0)
         playerContext.entriesLock.lock()
         playerContext.audioReadingEntry = entry
         playerContext.entriesLock.unlock()
 
+        // the connection is in flight, create the converter from a cached format meanwhile
+        fileStreamProcessor.prepareDecoder(for: entry)
+
         if startPlaying {
             if shouldClearQueue {
                 clearQueue()
@@ -670,6 +1002,43 @@ open class AudioPlayer {
         }
     }
 
+    /// Updates the frames required to start and resume playback from the measured throughput of the reading entry
+    ///
+    /// - parameter adaptiveBuffering: The `AdaptiveBuffering` object holding the throughput estimates
+    /// - parameter readingEntry: The `AudioEntry` currently read from its source
+    private func updateRequiredFrames(using adaptiveBuffering: AdaptiveBuffering, readingEntry: AudioEntry) {
+        let supplyRate = adaptiveBuffering.supplyRate(bitrate: readingEntry.calculatedBitrate())
+        let duration = readingEntry.duration()
+        let remainingSeconds: Double? = duration > 0 ? max(0, duration - readingEntry.progress) : nil
+        let policy = adaptiveBuffering.policy
+
+        let secondsToStartPlaying = policy.secondsRequired(supplyRate: supplyRate,
+                                                           remainingSeconds: remainingSeconds,
+                                                           fallbackSeconds: configuration.secondsRequiredToStartPlaying)
+        let secondsAfterRebuffering = policy.secondsRequired(supplyRate: supplyRate,
+                                                             remainingSeconds: remainingSeconds,
+                                                             fallbackSeconds: configuration.secondsRequiredToStartPlayingAfterBufferUnderun)
+        guard rendererContext.updateRequiredFrames(secondsToStartPlaying: secondsToStartPlaying,
+                                                   secondsAfterRebuffering: secondsAfterRebuffering)
+        else {
+            return
+        }
+        playerContext.entriesLock.lock()
+        rendererContext.publishRenderPlan(playingEntry: playerContext.audioPlayingEntry,
+                                          readingEntry: playerContext.audioReadingEntry)
+        playerContext.entriesLock.unlock()
+    }
+
+    /// Reports the startup timings of the playing entry to the delegate, once per entry
+    ///
+    /// - parameter firstAudioAt: The system uptime at which the first audio was rendered
+    private func reportStartupTimingsIfNeeded(firstAudioAt: TimeInterval) {
+        guard let entry = playerContext.entriesLock.around({ playerContext.audioPlayingEntry }) else { return }
+        entry.startupTimeline.mark(.firstAudio, at: firstAudioAt)
+        guard let timings = entry.startupTimeline.takeTimings() else { return }
+        delegate?.audioPlayerDidReportStartupTimings(player: self, with: entry.id, timings: timings)
+    }
+
     private func processFinishPlaying(entry: AudioEntry?, with nextEntry: AudioEntry?) {
         let playingEntry = playerContext.entriesLock.around { playerContext.audioPlayingEntry }
         guard entry == playingEntry else { return }
@@ -766,6 +1135,7 @@ extension AudioPlayer: AudioStreamSourceDelegate {
         }
 
         if !fileStreamProcessor.isFileStreamOpen {
+            readingEntry.startupTimeline.mark(.firstByte)
             let openFileStreamStatus = fileStreamProcessor.openFileStream(with: source.audioFileHint)
             guard openFileStreamStatus == noErr else {
                 let streamError = AudioFileStreamError(status: openFileStreamStatus)
@@ -774,6 +1144,9 @@ extension AudioPlayer: AudioStreamSourceDelegate {
             }
         }
 
+        rendererContext.adaptiveBuffering?.recordDownload(byteCount: data.count)
+        recorder.value?.record(data)
+
         if fileStreamProcessor.isFileStreamOpen {
             let streamBytesStatus = fileStreamProcessor.parseFileStreamBytes(data: data)
             guard streamBytesStatus == noErr else {
@@ -786,6 +1159,8 @@ extension AudioPlayer: AudioStreamSourceDelegate {
 
             if playerContext.audioReadingEntry == nil {
                 source.close()
+            } else if let adaptiveBuffering = rendererContext.adaptiveBuffering {
+                updateRequiredFrames(using: adaptiveBuffering, readingEntry: readingEntry)
             }
         }
     }
@@ -815,9 +1190,7 @@ extension AudioPlayer: AudioStreamSourceDelegate {
             return
         }
 
-        readingEntry.lock.lock()
-        readingEntry.framesState.lastFrameQueued = readingEntry.framesState.queued
-        readingEntry.lock.unlock()
+        readingEntry.framesState.lastFrameQueued.store(readingEntry.framesState.queued.value)
 
         readingEntry.delegate = nil
         readingEntry.close()
@@ -830,9 +1203,26 @@ extension AudioPlayer: AudioStreamSourceDelegate {
     }
 
     func metadataReceived(data: [String: String]) {
+        recorder.value?.record(metadata: data)
+        // the source reports metadata once the audio preceding it is decoded, it's reported once that audio plays
+        guard let readingEntry = playerContext.audioReadingEntry else {
+            reportMetadata(data)
+            return
+        }
+        readingEntry.metadataQueue.enqueue(data, at: readingEntry.framesState.queued.value)
+    }
+
+    /// Reports the metadata of the entry reached by playback, in the order it was read
+    private func reportMetadata(reachedBy entry: AudioEntry) {
+        for metadata in entry.metadataQueue.dequeue(reachedAt: entry.framesState.played.value) {
+            reportMetadata(metadata)
+        }
+    }
+
+    private func reportMetadata(_ metadata: [String: String]) {
         asyncOnMain { [weak self] in
             guard let self = self else { return }
-            self.delegate?.audioPlayerDidReadMetadata(player: self, metadata: data)
+            self.delegate?.audioPlayerDidReadMetadata(player: self, metadata: metadata)
         }
     }
 }
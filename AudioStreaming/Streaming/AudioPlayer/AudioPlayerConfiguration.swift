@@ -17,7 +17,29 @@ public struct AudioPlayerConfiguration: Equatable {
     let gracePeriodAfterSeekInSeconds: Double
     /// Number of seconds of audio required to before playback resumes after a buffer underun
     /// - note: Must be larger that `bufferSizeInSeconds`
-    let secondsRequiredToStartPlayingAfterBufferUnderun: Int
+    let secondsRequiredToStartPlayingAfterBufferUnderun: Double
+    /// Adapts the seconds required to start and resume playback to the measured download and decode throughput.
+    /// - note: The configured seconds are used until enough throughput samples are collected.
+    let enableAdaptiveBuffering: Bool
+    /// Caches the discovered stream format per URL and host so the audio converter can be created while connecting,
+    /// and starts rendering from the first decoded packet with a short fade-in.
+    /// - note: When enabled `secondsRequiredToStartPlaying` is ignored
+    let enableFastStart: Bool
+    /// Selects the decoders used for parsing and decoding the streams, see `AudioDecoderPreference`
+    let decoderPreference: AudioDecoderPreference
+    /// Selects the variant of multi-variant HLS streams, see `HLSVariantSelection`
+    let hlsVariantSelection: HLSVariantSelection
+    /// The bytes of live streams kept on disk, so they can be paused and rewound, `0` disables time shifting
+    let timeShiftBufferSize: Int
+    /// Keeps the latency of live streams close to a target, `nil` disables it, see `LiveLatencyControl`
+    let liveLatencyControl: LiveLatencyControl?
+    /// The seconds of decoded audio kept after playing, seeking within them or the audio buffered doesn't request
+    /// the audio again, `0` disables it
+    /// - note: The decompressed buffer grows by these seconds
+    let seekHistoryInSeconds: Double
+    /// The requests downloading long progressive files in parallel byte ranges ahead of playback, when their server
+    /// accepts ranges, `1` downloads them with a single request
+    let parallelDownloadConnections: Int
 
     /// Enables the internal logs
     let enableLogs: Bool
@@ -27,6 +49,14 @@ public struct AudioPlayerConfiguration: Equatable {
                                                            secondsRequiredToStartPlaying: 1,
                                                            gracePeriodAfterSeekInSeconds: 0.5,
                                                            secondsRequiredToStartPlayingAfterBufferUnderun: 1,
+                                                           enableAdaptiveBuffering: false,
+                                                           enableFastStart: false,
+                                                           decoderPreference: .system,
+                                                           hlsVariantSelection: .adaptive,
+                                                           timeShiftBufferSize: 0,
+                                                           liveLatencyControl: nil,
+                                                           seekHistoryInSeconds: 10,
+                                                           parallelDownloadConnections: 1,
                                                            enableLogs: false)
     /// Initializes the configuration for the `AudioPlayer`
     ///
@@ -37,13 +67,29 @@ public struct AudioPlayerConfiguration: Equatable {
     /// - parameter secondsRequiredToStartPlaying: Number of seconds of audio required to before playback first starts.
     /// - parameter gracePeriodAfterSeekInSeconds: Number of seconds of audio required after seek occcurs.
     /// - parameter secondsRequiredToStartPlayingAfterBufferUnderun: Number of seconds of audio required to before playback resumes after a buffer underun
+    /// - parameter enableAdaptiveBuffering: Adapts the seconds required to start and resume playback to the measured throughput.
+    /// - parameter enableFastStart: Creates the audio converter from a cached format and starts rendering from the first decoded packet.
+    /// - parameter decoderPreference: Selects the decoders used for parsing and decoding the streams.
+    /// - parameter hlsVariantSelection: Selects the variant of multi-variant HLS streams.
+    /// - parameter timeShiftBufferSize: The bytes of live streams kept on disk so they can be paused and rewound, `0` disables it.
+    /// - parameter liveLatencyControl: Keeps the latency of live streams close to a target by catching up, `nil` disables it.
+    /// - parameter seekHistoryInSeconds: The seconds of decoded audio kept after playing so seeking back to them is instant, `0` disables it.
+    /// - parameter parallelDownloadConnections: The requests downloading long progressive files in parallel ranges, `1` disables it.
     /// - parameter enableLogs: Enables the internal logs
     ///
     public init(flushQueueOnSeek: Bool = true,
                 bufferSizeInSeconds: Double = 10,
                 secondsRequiredToStartPlaying: Double = 1,
                 gracePeriodAfterSeekInSeconds: Double = 0.5,
-                secondsRequiredToStartPlayingAfterBufferUnderun: Int = 1,
+                secondsRequiredToStartPlayingAfterBufferUnderun: Double = 1,
+                enableAdaptiveBuffering: Bool = false,
+                enableFastStart: Bool = false,
+                decoderPreference: AudioDecoderPreference = .system,
+                hlsVariantSelection: HLSVariantSelection = .adaptive,
+                timeShiftBufferSize: Int = 0,
+                liveLatencyControl: LiveLatencyControl? = nil,
+                seekHistoryInSeconds: Double = 10,
+                parallelDownloadConnections: Int = 1,
                 enableLogs: Bool = false)
     {
         self.flushQueueOnSeek = flushQueueOnSeek
@@ -51,6 +97,14 @@ public struct AudioPlayerConfiguration: Equatable {
         self.secondsRequiredToStartPlaying = secondsRequiredToStartPlaying
         self.gracePeriodAfterSeekInSeconds = gracePeriodAfterSeekInSeconds
         self.secondsRequiredToStartPlayingAfterBufferUnderun = secondsRequiredToStartPlayingAfterBufferUnderun
+        self.enableAdaptiveBuffering = enableAdaptiveBuffering
+        self.enableFastStart = enableFastStart
+        self.decoderPreference = decoderPreference
+        self.hlsVariantSelection = hlsVariantSelection
+        self.timeShiftBufferSize = timeShiftBufferSize
+        self.liveLatencyControl = liveLatencyControl
+        self.seekHistoryInSeconds = seekHistoryInSeconds
+        self.parallelDownloadConnections = parallelDownloadConnections
         self.enableLogs = enableLogs
     }
 
@@ -79,6 +133,14 @@ public struct AudioPlayerConfiguration: Equatable {
                                         secondsRequiredToStartPlaying: secondsRequiredToStartPlaying,
                                         gracePeriodAfterSeekInSeconds: gracePeriodAfterSeekInSeconds,
                                         secondsRequiredToStartPlayingAfterBufferUnderun: secondsRequiredToStartPlayingAfterBufferUnderun,
+                                        enableAdaptiveBuffering: enableAdaptiveBuffering,
+                                        enableFastStart: enableFastStart,
+                                        decoderPreference: decoderPreference,
+                                        hlsVariantSelection: hlsVariantSelection,
+                                        timeShiftBufferSize: max(timeShiftBufferSize, 0),
+                                        liveLatencyControl: liveLatencyControl,
+                                        seekHistoryInSeconds: max(seekHistoryInSeconds, 0),
+                                        parallelDownloadConnections: max(parallelDownloadConnections, 1),
                                         enableLogs: enableLogs)
     }
 }
@@ -11,42 +11,73 @@ internal final class AudioPlayerContext {
     var state = Protected<AudioPlayerState>(.ready)
     var stateChanged: ((_ oldState: AudioPlayerState, _ newState: AudioPlayerState) -> Void)?
 
-    var muted = Protected<Bool>(false)
+    let muted = Atomic<Bool>(false)
 
     var internalState: AudioPlayer.InternalState {
         playerInternalState.value
     }
 
     let entriesLock = UnfairLock()
-    var audioReadingEntry: AudioEntry?
-    var audioPlayingEntry: AudioEntry?
+    var audioReadingEntry: AudioEntry? {
+        didSet { notifyEntriesChanged() }
+    }
+
+    var audioPlayingEntry: AudioEntry? {
+        didSet { notifyEntriesChanged() }
+    }
+
+    /// Called whenever the playing or reading entry changes, usually while holding the `entriesLock`
+    var entriesChanged: ((_ playingEntry: AudioEntry?, _ readingEntry: AudioEntry?) -> Void)?
+
+    private var isUpdatingEntries = false
 
     var disposedRequested: Bool
 
     /// This is the player's internal state to use
     /// - NOTE: Do not use directly instead use the `internalState` to set and get the property
     /// or the `setInternalState(to:when:)`method
-    private var playerInternalState = Protected<AudioPlayer.InternalState>(.initial)
+    private let playerInternalState = Atomic<AudioPlayer.InternalState>(.initial)
 
     init() {
         disposedRequested = false
     }
 
+    /// Changes both the playing and reading entries, calling `entriesChanged` once with both changed
+    ///
+    /// - note: Should be called while holding the `entriesLock`
+    func updateEntries(_ update: (AudioPlayerContext) -> Void) {
+        isUpdatingEntries = true
+        update(self)
+        isUpdatingEntries = false
+        notifyEntriesChanged()
+    }
+
+    private func notifyEntriesChanged() {
+        guard !isUpdatingEntries else { return }
+        entriesChanged?(audioPlayingEntry, audioReadingEntry)
+    }
+
     /// Sets the internal state if given the `inState` will be evaluated before assignment occurs.
     /// This also convenvienlty sets the `stopReason` as well
     /// - parameter state: The new `PlayerInternalState`
     /// - parameter inState: If the `inState` expression is not nil, the internalState will be set if the evaluated expression is `true`
-    /// - NOTE: This sets the underlying `__playerInternalState` variable
+    /// - NOTE: This sets the underlying `__playerInternalState` variable, when another thread changes the state
+    /// concurrently the `inState` expression is re-evaluated against the latest value.
     internal func setInternalState(to state: AudioPlayer.InternalState,
                                    when inState: ((AudioPlayer.InternalState) -> Bool)? = nil)
     {
         let newValues = playerStateAndStopReason(for: state)
         stopReason.write { $0 = newValues.stopReason }
-        guard state != internalState else { return }
-        if let inState = inState, !inState(internalState) {
-            return
+        var currentState = internalState
+        while true {
+            guard state != currentState else { return }
+            if let inState = inState, !inState(currentState) {
+                return
+            }
+            let result = playerInternalState.compareExchange(expected: currentState, desired: state)
+            if result.exchanged { break }
+            currentState = result.original
         }
-        playerInternalState.write { $0 = state }
         let previousPlayerState = self.state.value
         if newValues.state != previousPlayerState {
             self.state.write { $0 = newValues.state }
@@ -29,6 +29,13 @@ public protocol AudioPlayerDelegate: AnyObject {
     /// Tells the delegate when cancel occurs, usually due to a stop or play (new source)
     func audioPlayerDidCancel(player: AudioPlayer, queuedItems: [AudioEntryId])
 
-    /// Tells the delegate when a metadata read occurred from the stream.
+    /// Tells the delegate when a metadata read occurred from the stream, once playback reaches the audio it precedes.
     func audioPlayerDidReadMetadata(player: AudioPlayer, metadata: [String: String])
+
+    /// Tells the delegate the time spent in each startup phase of an entry, once its first audio is rendered.
+    func audioPlayerDidReportStartupTimings(player: AudioPlayer, with entryId: AudioEntryId, timings: AudioPlayerStartupTimings)
+}
+
+public extension AudioPlayerDelegate {
+    func audioPlayerDidReportStartupTimings(player _: AudioPlayer, with _: AudioEntryId, timings _: AudioPlayerStartupTimings) {}
 }
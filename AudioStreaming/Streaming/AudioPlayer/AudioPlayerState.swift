@@ -27,6 +27,14 @@ extension AudioPlayer {
     }
 }
 
+extension AudioPlayer.InternalState: AtomicWordRepresentable {
+    init(atomicWord: Int) {
+        self.init(rawValue: atomicWord)
+    }
+
+    var atomicWord: Int { rawValue }
+}
+
 /// Helper method that returns `AudioPlayerState` and `StopReason` based on the given `InternalState`
 /// - Parameter internalState: A value of `InternalState`
 /// - Returns: A tuple of `(AudioPlayerState, AudioPlayerStopReason)`
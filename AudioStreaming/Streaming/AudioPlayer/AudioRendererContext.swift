@@ -9,7 +9,7 @@ import CoreAudio
 internal var maxFramesPerSlice: AVAudioFrameCount = 8192
 
 final class AudioRendererContext {
-    var waiting = Protected<Bool>(false)
+    let waiting = Atomic<Bool>(false)
 
     let lock = UnfairLock()
 
@@ -22,24 +22,69 @@ final class AudioRendererContext {
 
     var discontinuous: Bool = false
 
-    let framesRequiredToStartPlaying: UInt32
-    let framesRequiredAfterRebuffering: UInt32
+    /// Number of frames required before playback first starts.
+    var framesRequiredToStartPlaying: UInt32 { requiredFrames.value.toStartPlaying }
+    /// Number of frames required before playback resumes after a buffer underun.
+    var framesRequiredAfterRebuffering: UInt32 { requiredFrames.value.afterRebuffering }
     let framesRequiredForDataAfterSeekPlaying: UInt32
 
-    var waitingForDataAfterSeekFrameCount = Protected<Int32>(0)
+    /// Number of frames the gain ramps up over when playback starts from the first decoded packet, `0` when fast start is disabled
+    let fadeInFrameCount: UInt32
+
+    /// Measures throughput when adaptive buffering is enabled, otherwise `nil`
+    let adaptiveBuffering: AdaptiveBuffering?
+
+    let waitingForDataAfterSeekFrameCount = Atomic<Int>(0)
+
+    /// Set while playback of a live stream catches up by dropping silence, see `LiveLatencyControl`
+    let dropsSilentFrames = Atomic<Bool>(false)
+    /// The frames of silence dropped catching up
+    let droppedSilentFrameCount = Atomic<Int>(0)
+    /// The frames of the target latency, kept buffered while dropping silence
+    let liveLatencyTargetFrames: UInt32
+
+    /// The playback clock published by the render thread, see `AudioPlayer.playbackClock`
+    let playbackClock = PlaybackClock()
+
+    /// The entries as seen by the render thread, see `publishRenderPlan(playingEntry:readingEntry:)`
+    ///
+    /// Plans may be published from the render thread, finishing an entry, their entries are released off it.
+    let renderPlan = AtomicSnapshot<RenderPlan>(reclaimQueue: DispatchQueue(label: "render.plan.reclaim.queue",
+                                                                            qos: .utility))
 
     private let configuration: AudioPlayerConfiguration
+    private let sampleRate: Double
+    private let startsFromFirstPacket: Bool
+    private let requiredFrames: Protected<(toStartPlaying: UInt32, afterRebuffering: UInt32)>
 
     init(configuration: AudioPlayerConfiguration, outputAudioFormat: AVAudioFormat) {
         self.configuration = configuration
 
         let canonicalStream = outputAudioFormat.basicStreamDescription
 
-        framesRequiredToStartPlaying = UInt32(canonicalStream.mSampleRate) * UInt32(configuration.secondsRequiredToStartPlaying)
-        framesRequiredAfterRebuffering = UInt32(canonicalStream.mSampleRate) * UInt32(configuration.secondsRequiredToStartPlayingAfterBufferUnderun)
-        framesRequiredForDataAfterSeekPlaying = UInt32(canonicalStream.mSampleRate) * UInt32(configuration.gracePeriodAfterSeekInSeconds)
-
-        let dataByteSize = Int(canonicalStream.mSampleRate * configuration.bufferSizeInSeconds) * Int(canonicalStream.mBytesPerFrame)
+        let sampleRate = canonicalStream.mSampleRate
+        self.sampleRate = sampleRate
+        startsFromFirstPacket = configuration.enableFastStart
+        fadeInFrameCount = configuration.enableFastStart ? frames(for: 0.03, sampleRate: sampleRate) : 0
+        let framesToStartPlaying = configuration.enableFastStart
+            ? 1
+            : frames(for: configuration.secondsRequiredToStartPlaying, sampleRate: sampleRate)
+        requiredFrames = Protected((framesToStartPlaying,
+                                    frames(for: configuration.secondsRequiredToStartPlayingAfterBufferUnderun, sampleRate: sampleRate)))
+        framesRequiredForDataAfterSeekPlaying = frames(for: configuration.gracePeriodAfterSeekInSeconds, sampleRate: sampleRate)
+        liveLatencyTargetFrames = configuration.liveLatencyControl.map { frames(for: $0.targetLatency, sampleRate: sampleRate) } ?? 0
+
+        if configuration.enableAdaptiveBuffering {
+            var policy = AdaptiveBufferingPolicy()
+            // leave enough room in the buffer for decoding to continue while waiting
+            policy.maximumSeconds = min(policy.maximumSeconds, configuration.bufferSizeInSeconds / 2)
+            adaptiveBuffering = AdaptiveBuffering(policy: policy, outputSampleRate: sampleRate)
+        } else {
+            adaptiveBuffering = nil
+        }
+
+        let bufferSeconds = configuration.bufferSizeInSeconds + configuration.seekHistoryInSeconds
+        let dataByteSize = Int(canonicalStream.mSampleRate * bufferSeconds) * Int(canonicalStream.mBytesPerFrame)
         inOutAudioBufferList = allocateBufferList(dataByteSize: dataByteSize)
 
         audioBuffer = inOutAudioBufferList[0].mBuffers
@@ -47,7 +92,43 @@ final class AudioRendererContext {
         let bufferTotalFrameCount = UInt32(dataByteSize) / canonicalStream.mBytesPerFrame
 
         bufferContext = BufferContext(sizeInBytes: canonicalStream.mBytesPerFrame,
-                                      totalFrameCount: bufferTotalFrameCount)
+                                      totalFrameCount: bufferTotalFrameCount,
+                                      historyCapacity: frames(for: configuration.seekHistoryInSeconds, sampleRate: sampleRate))
+    }
+
+    /// Publishes a new `RenderPlan` for the render thread
+    ///
+    /// - parameter playingEntry: The entry currently playing
+    /// - parameter readingEntry: The entry currently read from its source
+    func publishRenderPlan(playingEntry: AudioEntry?, readingEntry: AudioEntry?) {
+        let plan = RenderPlan(playingEntry: playingEntry,
+                              readingEntry: readingEntry,
+                              framesRequiredToStartPlaying: framesRequiredToStartPlaying,
+                              framesRequiredAfterRebuffering: framesRequiredAfterRebuffering)
+        renderPlan.publish(plan)
+    }
+
+    /// Updates the frames required to start and resume playback
+    ///
+    /// Values are rounded to 50ms to avoid publishing a new `RenderPlan` on every small change of the estimates.
+    /// When fast start is enabled playback always starts from the first decoded packet.
+    ///
+    /// - parameter secondsToStartPlaying: The seconds of audio required before playback first starts.
+    /// - parameter secondsAfterRebuffering: The seconds of audio required before playback resumes after a buffer underun.
+    /// - Returns: `true` if the required frames changed, in which case a new `RenderPlan` should be published.
+    func updateRequiredFrames(secondsToStartPlaying: Double, secondsAfterRebuffering: Double) -> Bool {
+        let framesToStartPlaying = startsFromFirstPacket ? 1 : frames(for: rounded(secondsToStartPlaying), sampleRate: sampleRate)
+        let updated = (toStartPlaying: framesToStartPlaying,
+                       afterRebuffering: frames(for: rounded(secondsAfterRebuffering), sampleRate: sampleRate))
+        return requiredFrames.write { current in
+            guard current != updated else { return false }
+            current = updated
+            return true
+        }
+    }
+
+    private func rounded(_ seconds: Double) -> Double {
+        (seconds * 20).rounded() / 20
     }
 
     func fillSilenceAudioBuffer() {
@@ -61,14 +142,38 @@ final class AudioRendererContext {
         audioBuffer.mData?.deallocate()
     }
 
+    /// Moves the read index of the buffer by the given frames, when the buffer holds the frames moved to
+    ///
+    /// - parameter frames: The frames to move by, negative values return to the frames played kept as history
+    /// - parameter playedFrames: The frames played of the playing entry, the history before them belongs to the
+    ///                           previous entry
+    /// - Returns: `true` if the read index moved, otherwise the audio has to be requested again
+    func moveReadIndex(by frames: Int, playedFrames: Int) -> Bool {
+        lock.lock(); defer { lock.unlock() }
+        // the render thread may be playing and dropping the silence of a slice each while the index moves
+        let seekable = bufferContext.seekableFrames(reserving: 2 * maxFramesPerSlice)
+        guard frames >= max(seekable.lowerBound, -playedFrames), frames <= seekable.upperBound else {
+            return false
+        }
+        bufferContext.moveStart(by: frames)
+        return true
+    }
+
     /// Resets the `BufferContext`
     func resetBuffers() {
         lock.lock(); defer { lock.unlock() }
-        bufferContext.frameStartIndex = 0
-        bufferContext.frameUsedCount = 0
+        bufferContext.reset()
     }
 }
 
+/// Converts the given seconds to frames, without truncating fractional seconds
+///
+/// - parameter seconds: A `Double` value indicating the seconds
+/// - parameter sampleRate: A `Double` value indicating the sample rate of the frames
+private func frames(for seconds: Double, sampleRate: Double) -> UInt32 {
+    UInt32(max(0, (seconds * sampleRate).rounded()))
+}
+
 /// Allocates a buffer list
 ///
 /// - parameter dataByteSize: An `Int` value indicating the size that the buffer will hold
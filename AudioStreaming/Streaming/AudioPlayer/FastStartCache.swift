@@ -0,0 +1,99 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import AudioToolbox
+import Foundation
+
+/// The format of a stream as discovered by `AudioFileStream`, enough to create an `AudioConverter` before any data arrives.
+struct FastStartFormat {
+    let streamFormat: AudioStreamBasicDescription
+    let magicCookie: Data?
+}
+
+/// Caches the discovered stream formats per URL and per host, along with the codec class used for each format id.
+///
+/// When fast start is enabled the player uses a cached format to create the audio converter while the
+/// connection is being established, instead of waiting for the format discovery of `AudioFileStream`.
+/// A cached format is only a guess, the converter is recreated if the discovered format differs.
+final class FastStartCache {
+    static let shared = FastStartCache()
+
+    /// The maximum number of formats kept, the least recently stored are removed first
+    let capacity: Int
+
+    private let lock = UnfairLock()
+    private var formats: [String: FastStartFormat] = [:]
+    private var keysByAge: [String] = []
+    private var codecClasses: [AudioFormatID: AudioClassDescription?] = [:]
+
+    init(capacity: Int = 32) {
+        self.capacity = capacity
+    }
+
+    /// Returns the cached format for the given URL, falling back to a format seen on the same host with the same file extension.
+    func format(for url: URL) -> FastStartFormat? {
+        lock.around {
+            if let key = Self.urlKey(for: url), let format = formats[key] {
+                return format
+            }
+            guard let hostKey = Self.hostKey(for: url) else { return nil }
+            return formats[hostKey]
+        }
+    }
+
+    /// Stores the discovered format for the given URL
+    func store(_ format: FastStartFormat, for url: URL) {
+        lock.around {
+            for key in [Self.urlKey(for: url), Self.hostKey(for: url)].compactMap({ $0 }) {
+                if formats.updateValue(format, forKey: key) != nil {
+                    keysByAge.removeAll { $0 == key }
+                }
+                keysByAge.append(key)
+            }
+            while keysByAge.count > capacity {
+                formats[keysByAge.removeFirst()] = nil
+            }
+        }
+    }
+
+    /// Returns the codec class to use for the given format id, `lookup` is only called once per format id.
+    ///
+    /// - parameter formatId: An `AudioFormatID` value
+    /// - parameter lookup: A closure that finds the codec class, eg. by scanning for a hardware codec
+    func codecClass(for formatId: AudioFormatID, lookup: () -> AudioClassDescription?) -> AudioClassDescription? {
+        lock.lock()
+        if let cached = codecClasses[formatId] {
+            lock.unlock()
+            return cached
+        }
+        lock.unlock()
+
+        let codecClass = lookup()
+        lock.around { codecClasses[formatId] = .some(codecClass) }
+        return codecClass
+    }
+
+    func removeAll() {
+        lock.around {
+            formats.removeAll()
+            keysByAge.removeAll()
+            codecClasses.removeAll()
+        }
+    }
+
+    // MARK: Keys
+
+    private static func urlKey(for url: URL) -> String? {
+        guard var components = URLComponents(url: url, resolvingAgainstBaseURL: false) else { return nil }
+        components.query = nil
+        components.fragment = nil
+        return components.string
+    }
+
+    private static func hostKey(for url: URL) -> String? {
+        guard let host = url.host else { return nil }
+        return "\(host)|\(url.pathExtension.lowercased())"
+    }
+}
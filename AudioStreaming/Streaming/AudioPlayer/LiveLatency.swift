@@ -0,0 +1,83 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import Foundation
+
+/// Keeps the latency of live streams, the seconds of decoded audio waiting to be played, close to a target.
+///
+/// Every rebuffer adds to the audio buffered behind the live edge, once the latency exceeds the target by more than
+/// the tolerance playback catches up, until the latency is back to the target.
+public struct LiveLatencyControl: Equatable {
+    /// How playback catches up with the live edge
+    public enum CatchUp: Equatable {
+        /// Plays faster by the given rate, eg. `1.05`, through the time-stretching rate node, keeping the pitch
+        case timeStretch(rate: Float)
+        /// Drops the decoded frames of silent regions, leaving the rest of the audio untouched
+        case droppingSilence
+    }
+
+    /// The seconds of audio buffered that playback catches up to
+    public var targetLatency: TimeInterval
+    /// The seconds the latency may exceed the target by before playback catches up
+    public var tolerance: TimeInterval
+    public var catchUp: CatchUp
+
+    public init(targetLatency: TimeInterval, tolerance: TimeInterval = 1, catchUp: CatchUp = .timeStretch(rate: 1.05)) {
+        self.targetLatency = max(targetLatency, 0)
+        self.tolerance = max(tolerance, 0)
+        self.catchUp = catchUp
+    }
+}
+
+/// The latency of a live stream being played, see `AudioPlayer.liveLatencyMetrics`
+public struct AudioPlayerLatencyMetrics: Equatable {
+    /// The seconds of decoded audio waiting to be played
+    public let latency: TimeInterval
+    public let targetLatency: TimeInterval
+    /// `true` while playback catches up with the live edge
+    public let isCatchingUp: Bool
+    /// The seconds of silence dropped catching up, in total
+    public let droppedSeconds: TimeInterval
+}
+
+/// Decides when playback of a live stream catches up, with hysteresis between the target and the tolerance over it
+struct LiveLatencyController {
+    let control: LiveLatencyControl
+
+    private(set) var isCatchingUp = false
+
+    init(control: LiveLatencyControl) {
+        self.control = control
+    }
+
+    /// Updates the state with the latency measured
+    ///
+    /// - Returns: `true` when playback should catch up
+    mutating func update(latency: TimeInterval) -> Bool {
+        if isCatchingUp {
+            isCatchingUp = latency > control.targetLatency
+        } else {
+            isCatchingUp = latency > control.targetLatency + control.tolerance
+        }
+        return isCatchingUp
+    }
+
+    mutating func reset() {
+        isCatchingUp = false
+    }
+}
+
+/// The number of leading frames of the given interleaved samples whose samples are all within the threshold
+///
+/// - parameter threshold: The amplitude of silence, `0.001` is -60 dBFS
+@inline(__always)
+func leadingSilentFrameCount(_ samples: UnsafePointer<Float>, frameCount: Int, channels: Int, threshold: Float = 0.001) -> Int {
+    for frame in 0 ..< frameCount {
+        for channel in 0 ..< channels where abs(samples[frame * channels + channel]) > threshold {
+            return frame
+        }
+    }
+    return frameCount
+}
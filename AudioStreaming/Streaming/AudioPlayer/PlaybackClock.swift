@@ -0,0 +1,170 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import AVFoundation
+
+/// The playback clock as published by the render thread, see `AudioPlayer.playbackClock`
+///
+/// A sample is published every render cycle that renders the playing entry, `position(at:)` interpolates between
+/// them, giving a smooth progress that accounts for the audio yet to be heard.
+public struct PlaybackClockSample: Equatable {
+    /// The frames of the playing entry played before the render cycle, in the output sample rate
+    public let framesRendered: Int
+    /// The seconds of the playing entry at the first frame of the render cycle
+    public let position: TimeInterval
+    /// The host time the render cycle is output at, in seconds, as `CACurrentMediaTime()`
+    public let hostTime: TimeInterval
+    /// The seconds of the playing entry rendered in the render cycle
+    public let renderedDuration: TimeInterval
+    /// The seconds from the output of the render cycle until it's heard, through the nodes and the hardware
+    public let outputLatency: TimeInterval
+    public let rate: Float
+    /// `true` while the position is held, eg. seeking, the position doesn't move until playback resumes
+    public let isHeld: Bool
+
+    /// The seconds of the playing entry heard at the given host time
+    ///
+    /// - parameter hostTime: The host time, in seconds, as `CACurrentMediaTime()`
+    public func position(at hostTime: TimeInterval) -> TimeInterval {
+        guard !isHeld else { return position }
+        // the audio of the cycle is heard after the latency, it doesn't move past the audio rendered
+        let elapsed = (hostTime - self.hostTime - outputLatency) * Double(rate)
+        return max(position + min(elapsed, renderedDuration), 0)
+    }
+}
+
+/// Publishes the `PlaybackClockSample` of every render cycle from the render thread without locking.
+///
+/// The sample is a sequence lock over atomic words: the single writer, the render thread, makes the sequence odd
+/// while it writes and readers retry when the sequence was odd or moved while they read.
+///
+/// Seeking holds the clock at the time sought until the render thread renders the audio following it, an epoch
+/// tells samples taken before a seek or a change of the playing entry apart.
+final class PlaybackClock {
+    let rate = Atomic<Double>(1)
+    /// The seconds from the output of the player until it's heard
+    let outputLatency = Atomic<Double>(0)
+
+    private let sequence = Atomic<Int>(0)
+    private let framesRendered = Atomic<Int>(0)
+    private let position = Atomic<Double>(0)
+    private let hostTime = Atomic<Double>(0)
+    private let renderedDuration = Atomic<Double>(0)
+    private let sampleEpoch = Atomic<Int>(-1)
+
+    /// Odd while held, moved on to discard the samples published so far
+    private let epoch = Atomic<Int>(0)
+    private let heldPosition = Atomic<Double>(0)
+
+    /// Serializes the writers of the epoch
+    private let lock = UnfairLock()
+    private var followedEntry: ObjectIdentifier?
+
+    /// The epoch a render cycle publishes its sample with, read before reading the frames of the entry
+    @inline(__always)
+    func currentEpoch() -> Int {
+        epoch.load(ordering: .acquiring)
+    }
+
+    /// Publishes the sample of a render cycle, only called from the render thread
+    @inline(__always)
+    func publish(framesRendered frames: Int,
+                 position seconds: TimeInterval,
+                 hostTime time: TimeInterval,
+                 renderedDuration duration: TimeInterval,
+                 epoch sampledEpoch: Int)
+    {
+        sequence.add(1, ordering: .acquiringAndReleasing)
+        framesRendered.store(frames, ordering: .relaxed)
+        position.store(seconds, ordering: .relaxed)
+        hostTime.store(time, ordering: .relaxed)
+        renderedDuration.store(duration, ordering: .relaxed)
+        sampleEpoch.store(sampledEpoch, ordering: .relaxed)
+        sequence.add(1, ordering: .releasing)
+    }
+
+    /// The latest sample, or the position held until one is published for the current epoch
+    func sample() -> PlaybackClockSample {
+        let currentEpoch = epoch.load()
+        let rate = Float(self.rate.value)
+        let latency = outputLatency.value
+        if currentEpoch & 1 == 0, let published = readPublished(), published.epoch == currentEpoch {
+            return PlaybackClockSample(framesRendered: published.frames,
+                                       position: published.position,
+                                       hostTime: published.hostTime,
+                                       renderedDuration: published.duration,
+                                       outputLatency: latency,
+                                       rate: rate,
+                                       isHeld: false)
+        }
+        return PlaybackClockSample(framesRendered: 0,
+                                   position: heldPosition.value,
+                                   hostTime: 0,
+                                   renderedDuration: 0,
+                                   outputLatency: latency,
+                                   rate: rate,
+                                   isHeld: true)
+    }
+
+    /// Holds the clock at the given position, until `release()`
+    func hold(at seconds: TimeInterval) {
+        lock.around {
+            heldPosition.store(seconds)
+            let current = epoch.load()
+            if current & 1 == 0 {
+                epoch.store(current + 1)
+            }
+        }
+    }
+
+    /// Releases a held clock, the position stays held until a render cycle renders the playing entry
+    func release() {
+        lock.around {
+            let current = epoch.load()
+            if current & 1 == 1 {
+                epoch.store(current + 1)
+            }
+        }
+    }
+
+    /// Restarts the clock at the progress of the given entry once it becomes the one playing, releasing it
+    func follow(_ entry: AudioEntry?) {
+        lock.around {
+            let identifier = entry.map(ObjectIdentifier.init)
+            guard identifier != followedEntry else { return }
+            followedEntry = identifier
+            heldPosition.store(entry?.progress ?? 0)
+            epoch.store((epoch.load() | 1) + 1)
+        }
+    }
+
+    // MARK: Private
+
+    /// Reads the published sample, `nil` when the render thread kept writing it
+    private func readPublished() -> (frames: Int, position: Double, hostTime: Double, duration: Double, epoch: Int)? {
+        for _ in 0 ..< 4 {
+            let before = sequence.load()
+            guard before & 1 == 0 else { continue }
+            let published = (framesRendered.load(), position.load(), hostTime.load(), renderedDuration.load(),
+                             sampleEpoch.load())
+            if sequence.load() == before {
+                return published
+            }
+        }
+        return nil
+    }
+}
+
+/// The seconds of the given host time, in the time base of `CACurrentMediaTime()`
+@inline(__always)
+func hostTimeSeconds(_ hostTime: UInt64) -> TimeInterval {
+    Double(hostTime) * hostTimeSecondsPerTick
+}
+
+private let hostTimeSecondsPerTick: Double = {
+    var timebase = mach_timebase_info_data_t()
+    mach_timebase_info(&timebase)
+    return Double(timebase.numer) / Double(timebase.denom) / 1_000_000_000
+}()
@@ -17,6 +17,8 @@ struct AudioConvertInfo {
     let numberOfPackets: UInt32
     var audioBuffer = AudioBuffer()
     let packDescription: UnsafeMutablePointer<AudioStreamPacketDescription>?
+    /// The packets already decoded, used by backends that decode one packet at a time
+    var consumedPackets: UInt32 = 0
 }
 
 enum FileStreamProcessorEffect {
@@ -25,6 +27,9 @@ enum FileStreamProcessorEffect {
 }
 
 /// An object that handles the proccessing of AudioFileStream, its packets etc.
+///
+/// Parsing and decoding are delegated to an `AudioDecoderBackend`, chosen per stream from the file type
+/// and the `AudioDecoderPreference` of the player.
 final class AudioFileStreamProcessor {
     private let maxCompressedPacketForBitrate = 4096
 
@@ -33,64 +38,102 @@ final class AudioFileStreamProcessor {
     private let playerContext: AudioPlayerContext
     private let rendererContext: AudioRendererContext
     private let outputAudioFormat: AudioStreamBasicDescription
+    private let fastStartCache: FastStartCache?
+    private let converterPool: AudioConverterPool
+    private let decoderPreference: AudioDecoderPreference
+
+    private let audioToolboxBackend: AudioToolboxDecoderBackend
+    private lazy var mp3Backend = MP3DecoderBackend(outputFormat: outputAudioFormat)
+    private lazy var flacBackend = FLACDecoderBackend(outputFormat: outputAudioFormat)
+    private lazy var adtsBackend = ADTSDemuxerBackend(outputFormat: outputAudioFormat,
+                                                      fastStartCache: fastStartCache,
+                                                      converterPool: converterPool)
+    private lazy var oggBackend = OggDemuxerBackend(outputFormat: outputAudioFormat,
+                                                    fastStartCache: fastStartCache,
+                                                    converterPool: converterPool)
+    /// The backend of the stream currently open, or last opened
+    private(set) var backend: AudioDecoderBackend
 
-    internal var audioFileStream: AudioFileStreamID?
-    internal var audioConverter: AudioConverterRef?
     internal var discontinuous: Bool = false
-    internal var inputFormat = AudioStreamBasicDescription()
     internal var fileFormat: String = ""
+    /// The data format last reported by the backend, a different one reported later is a change of format
+    private var reportedDataFormat: AudioStreamBasicDescription?
     internal let fa4mFormat = "fa4m"
 
     var isFileStreamOpen: Bool {
-        audioFileStream != nil
+        backend.isOpen
     }
 
     init(playerContext: AudioPlayerContext,
          rendererContext: AudioRendererContext,
-         outputAudioFormat: AudioStreamBasicDescription)
+         outputAudioFormat: AudioStreamBasicDescription,
+         fastStartCache: FastStartCache? = nil,
+         converterPool: AudioConverterPool = AudioConverterPool(),
+         decoderPreference: AudioDecoderPreference = .system)
     {
         self.playerContext = playerContext
         self.rendererContext = rendererContext
         self.outputAudioFormat = outputAudioFormat
+        self.fastStartCache = fastStartCache
+        self.converterPool = converterPool
+        self.decoderPreference = decoderPreference
+        audioToolboxBackend = AudioToolboxDecoderBackend(outputFormat: outputAudioFormat,
+                                                         fastStartCache: fastStartCache,
+                                                         converterPool: converterPool)
+        backend = audioToolboxBackend
+        audioToolboxBackend.delegate = self
     }
 
-    /// Opens the `AudioFileStream`
+    /// Opens the stream on the backend for the given file type
     ///
     /// - parameter fileHint: An `AudioFileTypeID` value indicating the file type.
     ///
     /// - Returns: An `OSStatus` value indicating if an error occurred or not.
 
     func openFileStream(with fileHint: AudioFileTypeID) -> OSStatus {
-        let data = UnsafeMutableRawPointer.from(object: self)
-        return AudioFileStreamOpen(data, _propertyListenerProc, _propertyPacketsProc, fileHint, &audioFileStream)
+        backend = decoderBackend(for: fileHint)
+        backend.delegate = self
+        return backend.open(fileHint: fileHint)
     }
 
-    /// Closes the currently open `AudioFileStream` instance, if opened.
+    /// Closes the currently open stream, if opened.
     func closeFileStreamIfNeeded() {
-        guard let fileStream = audioFileStream else {
+        guard backend.isOpen else {
             Logger.debug("audio file stream not opened", category: .generic)
             return
         }
-        AudioFileStreamClose(fileStream)
-        audioFileStream = nil
+        backend.close()
     }
 
-    /// Parses the given data using `AudioFileStreamParseBytes`
+    /// Parses the given data using the backend of the open stream
     ///
     /// - parameter data: A `Data` object containing the audio data to be parsed.
     ///
     /// - Returns: An `OSStatus` value indicating if an error occurred or not.
     func parseFileStreamBytes(data: Data) -> OSStatus {
-        guard let stream = audioFileStream else { return 0 }
+        guard backend.isOpen else { return 0 }
         guard !data.isEmpty else { return 0 }
-        let flags: AudioFileStreamParseFlags = discontinuous ? .discontinuity : .init()
-        return data.withUnsafeBytes { buffer -> OSStatus in
-            AudioFileStreamParseBytes(stream, UInt32(buffer.count), buffer.baseAddress, flags)
+        return backend.parse(data: data, discontinuous: discontinuous)
+    }
+
+    /// Returns the backend that parses and decodes streams of the given file type
+    private func decoderBackend(for fileHint: AudioFileTypeID) -> AudioDecoderBackend {
+        switch fileHint {
+        case kAudioFileAAC_ADTSType:
+            return adtsBackend
+        case kAudioFileMP3Type where decoderPreference == .portable:
+            return mp3Backend
+        case kAudioFileFLACType:
+            return flacBackend
+        case oggFileType:
+            return oggBackend
+        default:
+            return audioToolboxBackend
         }
     }
 
     func processSeek() {
-        guard let stream = audioFileStream else { return }
+        guard backend.isOpen else { return }
         guard let readingEntry = playerContext.audioReadingEntry else {
             return
         }
@@ -99,6 +142,16 @@ final class AudioFileStreamProcessor {
             return
         }
 
+        let secondsBehindLive = readingEntry.seekRequest.lock.around { readingEntry.seekRequest.secondsBehindLive }
+        if let secondsBehindLive = secondsBehindLive, let timeShiftBuffer = readingEntry.timeShiftBuffer {
+            // live streams are addressed by the time their audio was received
+            readingEntry.lock.lock()
+            readingEntry.seekTime = readingEntry.seekRequest.time
+            readingEntry.lock.unlock()
+            resumeReading(of: readingEntry, at: Int64(timeShiftBuffer.offset(secondsBehindLive: secondsBehindLive)))
+            return
+        }
+
         let dataOffset = Double(readingEntry.audioStreamState.dataOffset)
         let dataLengthInBytes = Double(readingEntry.audioDataLengthBytes())
         let entryDuration = readingEntry.duration()
@@ -116,19 +169,18 @@ final class AudioFileStreamProcessor {
 
         let bitrate = readingEntry.calculatedBitrate()
         if readingEntry.processedPacketsState.count > 0, bitrate > 0 {
-            var ioFlags = AudioFileStreamSeekFlags(rawValue: 0)
-            var packetsAlignedByteOffset: Int64 = 0
             let seekPacket = Int64(floor(readingEntry.seekRequest.time / readingEntry.packetDuration))
 
-            let seekStatus = AudioFileStreamSeek(stream, seekPacket, &packetsAlignedByteOffset, &ioFlags)
-            guard seekStatus == noErr else {
-                let streamError = AudioFileStreamError(status: seekStatus)
+            let seekResult = backend.seek(toPacket: seekPacket, time: readingEntry.seekRequest.time)
+            guard seekResult.status == noErr else {
+                let streamError = AudioFileStreamError(status: seekResult.status)
                 Logger.error("seek failed %@", category: .generic, args: streamError.debugDescription)
                 return
             }
 
             let dataOffset = Int64(readingEntry.audioStreamState.dataOffset)
-            if !ioFlags.contains(.offsetIsEstimated) {
+            if !seekResult.isEstimated {
+                let packetsAlignedByteOffset = seekResult.byteOffset
                 seekByteOffset = packetsAlignedByteOffset + dataOffset
                 let delta = Double((seekByteOffset - dataOffset) - packetsAlignedByteOffset) / bitrate * 8
 
@@ -138,206 +190,146 @@ final class AudioFileStreamProcessor {
             }
         }
 
-        if let converted = audioConverter {
-            AudioConverterReset(converted)
-        }
+        resumeReading(of: readingEntry, at: seekByteOffset)
+    }
+
+    /// Restarts decoding the given entry from the given byte offset, dropping the buffered audio
+    private func resumeReading(of readingEntry: AudioEntry, at seekByteOffset: Int64) {
+        backend.resetDecoder(resumingAt: UInt64(max(seekByteOffset, 0)))
 
         readingEntry.reset()
         readingEntry.seek(at: Int(seekByteOffset))
-        rendererContext.waitingForDataAfterSeekFrameCount.write { $0 = 0 }
+        rendererContext.waitingForDataAfterSeekFrameCount.store(0)
         playerContext.setInternalState(to: .waitingForDataAfterSeek)
         rendererContext.resetBuffers()
     }
 
-    /// Creates an `AudioConverter` instance to be used for converting the remote audio data to the canonical audio format
+    /// Prepares the decoder of the current backend for the discovered format of the stream
     ///
     /// - parameter fromFormat: An `AudioStreamBasicDescription` indicating the format of the remote audio
-    /// - parameter toFormat: An `AudioStreamBasicDescription` indicating the local format in which the fromFormat will be converted to.
-    func createAudioConverter(from fromFormat: AudioStreamBasicDescription, to toFormat: AudioStreamBasicDescription) {
-        var inputFormat = fromFormat
-        if let converter = audioConverter {
-            if memcmp(&inputFormat, &self.inputFormat, MemoryLayout<AudioStreamBasicDescription>.size) == 0 {
-                AudioConverterReset(converter)
-                return
-            }
-        }
-        disposeAudioConverter()
-
-        var classDesc = AudioClassDescription()
-        var outputFormat = toFormat
-        if getHardwareCodecClassDescripition(formatId: inputFormat.mFormatID, classDesc: &classDesc) {
-            AudioConverterNewSpecific(&inputFormat, &outputFormat, 1, &classDesc, &audioConverter)
-        }
+    func prepareDecoder(from fromFormat: AudioStreamBasicDescription) {
+        prepareDecoder(from: fromFormat, magicCookie: backend.streamMagicCookie(), usingCachedFormat: false)
+    }
 
-        if audioConverter == nil {
-            let audioConverterStatus = AudioConverterNew(&inputFormat, &outputFormat, &audioConverter)
-            guard audioConverterStatus == noErr else {
-                let audioConverterError = AudioConverterError(osstatus: audioConverterStatus)
-                fileStreamCallback?(.raiseError(.audioSystemError(.converterError(audioConverterError))))
-                return
-            }
-        }
-        self.inputFormat = inputFormat
-
-        // magic cookie info
-        let fileHint = playerContext.audioReadingEntry?.audioFileHint
-        let isProperFormat = fileHint != kAudioFileAAC_ADTSType && fileHint != kAudioFileM4AType && fileHint != kAudioFileMPEG4Type
-        if let fileStream = audioFileStream, isProperFormat {
-            var cookieSize: UInt32 = 0
-            guard AudioFileStreamGetPropertyInfo(fileStream, kAudioFileStreamProperty_MagicCookieData, &cookieSize, nil) == noErr else {
-                return
-            }
-            var cookie: [UInt8] = Array(repeating: 0, count: Int(cookieSize))
-            guard AudioFileStreamGetProperty(fileStream, kAudioFileStreamProperty_MagicCookieData, &cookieSize, &cookie) == noErr else {
-                return
-            }
-            guard let converter = audioConverter else {
-                fileStreamCallback?(.raiseError(.audioSystemError(.fileStreamError(.unknownError))))
-                 return
-            }
-            guard AudioConverterSetProperty(converter, kAudioConverterDecompressionMagicCookie, cookieSize, cookie) == noErr else {
-                fileStreamCallback?(.raiseError(.audioSystemError(.fileStreamError(.unknownError))))
-                return
-            }
-        }
+    /// Prepares the decoder from the cached format of the given entry, if any, so the decoder is ready
+    /// by the time the first packets arrive.
+    ///
+    /// - parameter entry: The `AudioEntry` that is about to be read
+    func prepareDecoder(for entry: AudioEntry) {
+        guard let fastStartCache = fastStartCache, let url = URL(string: entry.id.id) else { return }
+        guard let format = fastStartCache.format(for: url) else { return }
+        backend = decoderBackend(for: entry.audioFileHint)
+        backend.delegate = self
+        prepareDecoder(from: format.streamFormat, magicCookie: format.magicCookie, usingCachedFormat: true)
     }
 
-    /// Disposes the `AudioConverter` instance, if any.
-    private func disposeAudioConverter() {
-        guard let converter = audioConverter else { return }
-        AudioConverterDispose(converter)
-        audioConverter = nil
+    private func prepareDecoder(from fromFormat: AudioStreamBasicDescription, magicCookie: Data?, usingCachedFormat: Bool) {
+        let started = ProcessInfo.processInfo.systemUptime
+        backend.prepareDecoder(for: fromFormat, magicCookie: magicCookie)
+        playerContext.audioReadingEntry?.startupTimeline
+            .recordConverterSetup(duration: ProcessInfo.processInfo.systemUptime - started,
+                                  usedCachedFormat: usingCachedFormat)
     }
 
-    /// Parses any relevant properties as received by the opened `AudioFileStream`
+    /// Processes the properties discovered by the backend of the open stream
     ///
-    /// - parameter fileStream: An instance of `AudioFileStreamID` that is used to get information from.
-    /// - parameter propertyId: A value of `AudioFileStreamPropertyID` indicating the file stream property.
-    /// - parameter flags: A value of `UnsafeMutablePointer<AudioFileStreamPropertyFlags>`
-
-    func propertyListenerProc(fileStream: AudioFileStreamID,
-                              propertyId: AudioFileStreamPropertyID,
-                              flags _: UnsafeMutablePointer<AudioFileStreamPropertyFlags>)
-    {
-        switch propertyId {
-        case kAudioFileStreamProperty_DataOffset:
-            processDataOffset(fileStream: fileStream)
-        case kAudioFileStreamProperty_FileFormat:
-            processFileFormat(fileStream: fileStream)
-        case kAudioFileStreamProperty_DataFormat:
-            processDataFormat(fileStream: fileStream)
-        case kAudioFileStreamProperty_AudioDataByteCount:
-            processDataByteCount(fileStream: fileStream)
-        case kAudioFileStreamProperty_AudioDataPacketCount:
-            proccessAudioDataPacketCount(fileStream: fileStream)
-        case kAudioFileStreamProperty_ReadyToProducePackets:
+    /// - parameter property: A value of `AudioStreamProperty`
+    func processProperty(_ property: AudioStreamProperty) {
+        switch property {
+        case let .dataOffset(offset):
+            processDataOffset(offset)
+        case let .fileFormat(fileFormat):
+            self.fileFormat = fileFormat
+        case let .dataFormat(format, packetSizeUpperBound):
+            processDataFormat(format, packetSizeUpperBound: packetSizeUpperBound)
+        case let .audioDataByteCount(byteCount):
+            playerContext.audioReadingEntry?.audioStreamState.dataByteCount = byteCount
+        case let .audioDataPacketCount(packetCount):
+            playerContext.audioReadingEntry?.audioStreamState.dataPacketOffset = packetCount
+        case let .bitRate(bitRate):
+            playerContext.audioReadingEntry?.audioStreamState.bitRate = bitRate
+        case let .readyToProducePackets(packetCount):
             // check converter for discontious stream
-            processReadyToProducePackets(fileStream: fileStream)
-        case kAudioFileStreamProperty_FormatList:
-            processFormatList(fileStream: fileStream)
-        default: break
+            processReadyToProducePackets(packetCount: packetCount)
+        case let .formatList(list):
+            processFormatList(list)
         }
     }
 
-    // MARK: AudioFileStream properties Proccessing
+    // MARK: Stream properties Proccessing
 
-    private func processDataOffset(fileStream: AudioFileStreamID) {
-        var offset: UInt64 = 0
-        fileStreamGetProperty(value: &offset, fileStream: fileStream, propertyId: kAudioFileStreamProperty_DataOffset)
+    private func processDataOffset(_ offset: UInt64) {
         playerContext.audioReadingEntry?.audioStreamState.processedDataFormat = true
         playerContext.audioReadingEntry?.audioStreamState.dataOffset = offset
     }
 
-    private func processReadyToProducePackets(fileStream: AudioFileStreamID) {
-        var packetCount: UInt64 = 0
-        var packetCountSize = UInt32(MemoryLayout.size(ofValue: packetCount))
-        AudioFileStreamGetProperty(fileStream, kAudioFileStreamProperty_AudioDataPacketCount, &packetCountSize, &packetCount)
+    private func processReadyToProducePackets(packetCount: UInt64) {
         playerContext.audioPlayingEntry?.audioStreamState.dataPacketCount = Double(packetCount)
         if playerContext.audioPlayingEntry?.audioStreamFormat.mFormatID != kAudioFormatLinearPCM {
             discontinuous = true
         }
     }
 
-    private func processFileFormat(fileStream: AudioFileStreamID) {
-        var fileFormat: [UInt8] = Array(repeating: 0, count: 4)
-        var size = UInt32(4)
-        AudioFileStreamGetProperty(fileStream, kAudioFileStreamProperty_FileFormat, &size, &fileFormat)
-        if let stringFileFormat = String(data: Data(fileFormat), encoding: .utf8) {
-            self.fileFormat = stringFileFormat
-        }
-    }
-
-    private func processDataFormat(fileStream: AudioFileStreamID) {
-        var audioStreamFormat = AudioStreamBasicDescription()
+    private func processDataFormat(_ audioStreamFormat: AudioStreamBasicDescription, packetSizeUpperBound: UInt32) {
         guard let entry = playerContext.audioReadingEntry else { return }
         if !entry.audioStreamState.processedDataFormat {
-            fileStreamGetProperty(value: &audioStreamFormat, fileStream: fileStream, propertyId: kAudioFileStreamProperty_DataFormat)
-
+            reportedDataFormat = audioStreamFormat
             if entry.audioStreamFormat.mFormatID == 0 {
                 entry.audioStreamFormat = audioStreamFormat
             }
 
-            var packetBufferSize: UInt32 = 0
-            var status = fileStreamGetProperty(value: &packetBufferSize,
-                                               fileStream: fileStream,
-                                               propertyId: kAudioFileStreamProperty_PacketSizeUpperBound)
-            if status != 0 || packetBufferSize == 0 {
-                status = fileStreamGetProperty(value: &packetBufferSize,
-                                               fileStream: fileStream,
-                                               propertyId: kAudioFileStreamProperty_MaximumPacketSize)
-                if status != 0 || packetBufferSize == 0 {
-                    packetBufferSize = 2048 // default value
-                }
-            }
             entry.lock.around {
-                entry.processedPacketsState.bufferSize = packetBufferSize
+                entry.processedPacketsState.bufferSize = packetSizeUpperBound
             }
 
+            entry.startupTimeline.mark(.formatDiscovered)
             if fileFormat != fa4mFormat {
-                createAudioConverter(from: entry.audioStreamFormat, to: outputAudioFormat)
+                prepareDecoder(from: entry.audioStreamFormat)
+                storeFastStartFormat(for: entry)
             }
+        } else if let reported = reportedDataFormat, !isSameFormat(audioStreamFormat, reported) {
+            // the format changed mid-stream, eg. switching HLS variants, the packets before the change are already
+            // decoded so the decoder is swapped at the packet boundary, taking a pooled converter when there is one
+            Logger.debug("stream format changed, preparing the decoder for %.0fHz", category: .audioRendering,
+                         args: audioStreamFormat.mSampleRate)
+            reportedDataFormat = audioStreamFormat
+            entry.audioStreamFormat = audioStreamFormat
+            prepareDecoder(from: audioStreamFormat)
         }
     }
 
-    private func processDataByteCount(fileStream: AudioFileStreamID) {
-        guard let entry = playerContext.audioReadingEntry else { return }
-        var audioDataByteCount: UInt64 = 0
-        fileStreamGetProperty(value: &audioDataByteCount, fileStream: fileStream, propertyId: kAudioFileStreamProperty_AudioDataByteCount)
-        entry.audioStreamState.dataByteCount = audioDataByteCount
-    }
-
-    private func proccessAudioDataPacketCount(fileStream: AudioFileStreamID) {
-        guard let entry = playerContext.audioReadingEntry else { return }
-        var audioDataPacketCount: UInt64 = 0
-        fileStreamGetProperty(value: &audioDataPacketCount, fileStream: fileStream, propertyId: kAudioFileStreamProperty_AudioDataPacketCount)
-        entry.audioStreamState.dataPacketOffset = audioDataPacketCount
+    private func isSameFormat(_ lhs: AudioStreamBasicDescription, _ rhs: AudioStreamBasicDescription) -> Bool {
+        lhs.mFormatID == rhs.mFormatID
+            && lhs.mFormatFlags == rhs.mFormatFlags
+            && lhs.mSampleRate == rhs.mSampleRate
+            && lhs.mChannelsPerFrame == rhs.mChannelsPerFrame
+            && lhs.mFramesPerPacket == rhs.mFramesPerPacket
     }
 
-    private func processFormatList(fileStream: AudioFileStreamID) {
-        let info = fileStreamGetPropertyInfo(fileStream: fileStream, propertyId: kAudioFileStreamProperty_FormatList)
-        guard info.status == noErr else { return }
-        var list: [AudioFormatListItem] = Array(repeating: AudioFormatListItem(), count: Int(info.size))
-        var size = UInt32(info.size)
-        AudioFileStreamGetProperty(fileStream, kAudioFileStreamProperty_FormatList, &size, &list)
-        let step = MemoryLayout<AudioFormatListItem>.size
-        var i = 0
-        while i * step < size {
-            let asbd = list[i].mASBD
-            let formatId = asbd.mFormatID
+    private func processFormatList(_ list: [AudioFormatListItem]) {
+        for item in list {
+            let formatId = item.mASBD.mFormatID
             if formatId == kAudioFormatMPEG4AAC_HE || formatId == kAudioFormatMPEG4AAC_HE_V2 {
-                playerContext.audioReadingEntry?.audioStreamFormat = asbd
+                playerContext.audioReadingEntry?.audioStreamFormat = item.mASBD
                 break
             }
-            i += step
         }
 
         if fileFormat == fa4mFormat {
-            if let inputStreamFormat = playerContext.audioReadingEntry?.audioStreamFormat {
-                createAudioConverter(from: inputStreamFormat, to: outputAudioFormat)
+            if let entry = playerContext.audioReadingEntry {
+                prepareDecoder(from: entry.audioStreamFormat)
+                storeFastStartFormat(for: entry)
             }
         }
     }
 
+    /// Caches the discovered format of the entry to be used the next time the same URL or host is played
+    private func storeFastStartFormat(for entry: AudioEntry) {
+        guard let fastStartCache = fastStartCache else { return }
+        guard let format = backend.decoderFormat, let url = URL(string: entry.id.id) else { return }
+        fastStartCache.store(format, for: url)
+    }
+
     // MARK: Packets Proc
 
     func propertyPacketsProc(inNumberBytes: UInt32,
@@ -358,7 +350,7 @@ final class AudioFileStreamProcessor {
             return
         }
 
-        guard let converter = audioConverter else {
+        guard backend.decoderFormat != nil else {
             Logger.error("Couldn't find audio converter", category: .audioRendering)
             return
         }
@@ -382,8 +374,9 @@ final class AudioFileStreamProcessor {
         packetProccess: while status == noErr {
             rendererContext.lock.lock()
             let bufferContext = rendererContext.bufferContext
-            var used = bufferContext.frameUsedCount
-            var start = bufferContext.frameStartIndex
+            // the frames kept as history aren't overwritten until they're pushed out of it
+            var used = bufferContext.occupiedFrameCount
+            var start = bufferContext.occupiedStartIndex
             var end = bufferContext.end
 
             var framesLeftInBuffer = bufferContext.totalFrameCount - used
@@ -393,9 +386,9 @@ final class AudioFileStreamProcessor {
                 while true {
                     rendererContext.lock.lock()
                     let bufferContext = rendererContext.bufferContext
-                    used = bufferContext.frameUsedCount
-                    start = bufferContext.frameStartIndex
-                    end = (bufferContext.frameStartIndex + bufferContext.frameUsedCount) % bufferContext.totalFrameCount
+                    used = bufferContext.occupiedFrameCount
+                    start = bufferContext.occupiedStartIndex
+                    end = bufferContext.end
                     framesLeftInBuffer = bufferContext.totalFrameCount - used
                     rendererContext.lock.unlock()
                     if framesLeftInBuffer > 0 {
@@ -419,9 +412,10 @@ final class AudioFileStreamProcessor {
                         return
                     }
 
-                    rendererContext.waiting.write { $0 = true }
+                    rendererContext.adaptiveBuffering?.suspendMeasuring()
+                    rendererContext.waiting.store(true)
                     rendererContext.packetsSemaphore.wait()
-                    rendererContext.waiting.write { $0 = false }
+                    rendererContext.waiting.store(false)
                 }
             }
 
@@ -437,12 +431,9 @@ final class AudioFileStreamProcessor {
                                        dataOffset: offset,
                                        framesToDecode: framesToDecode)
 
-                status = AudioConverterFillComplexBuffer(converter,
-                                                         _converterCallback,
-                                                         &convertInfo,
-                                                         &framesToDecode,
-                                                         localBufferList.unsafeMutablePointer,
-                                                         nil)
+                status = fillComplexBuffer(convertInfo: &convertInfo,
+                                           framesToDecode: &framesToDecode,
+                                           bufferList: localBufferList)
 
                 framesAdded = framesToDecode
 
@@ -463,12 +454,9 @@ final class AudioFileStreamProcessor {
                                        dataOffset: 0,
                                        framesToDecode: framesToDecode)
 
-                status = AudioConverterFillComplexBuffer(converter,
-                                                         _converterCallback,
-                                                         &convertInfo,
-                                                         &framesToDecode,
-                                                         localBufferList.unsafeMutablePointer,
-                                                         nil)
+                status = fillComplexBuffer(convertInfo: &convertInfo,
+                                           framesToDecode: &framesToDecode,
+                                           bufferList: localBufferList)
 
                 framesAdded += framesToDecode
 
@@ -491,12 +479,9 @@ final class AudioFileStreamProcessor {
                                        dataOffset: offset,
                                        framesToDecode: framesToDecode)
 
-                status = AudioConverterFillComplexBuffer(converter,
-                                                         _converterCallback,
-                                                         &convertInfo,
-                                                         &framesToDecode,
-                                                         localBufferList.unsafeMutablePointer,
-                                                         nil)
+                status = fillComplexBuffer(convertInfo: &convertInfo,
+                                           framesToDecode: &framesToDecode,
+                                           bufferList: localBufferList)
 
                 framesAdded = framesToDecode
                 if status == AudioConvertStatus.done.rawValue {
@@ -513,6 +498,27 @@ final class AudioFileStreamProcessor {
         }
     }
 
+    /// Decodes packets into the given buffer list, recording the decode throughput when adaptive buffering is enabled
+    ///
+    /// - parameter convertInfo: The `AudioConvertInfo` holding the packets to decode
+    /// - parameter framesToDecode: On input the frames the buffer list can hold, on output the frames decoded
+    /// - parameter bufferList: An `UnsafeMutableAudioBufferListPointer` object representing the buffer to be filled
+    /// - Returns: An `OSStatus` value as returned by `AudioDecoderBackend.decode(_:frameCount:into:)`
+    @inline(__always)
+    private func fillComplexBuffer(convertInfo: inout AudioConvertInfo,
+                                   framesToDecode: inout UInt32,
+                                   bufferList: UnsafeMutableAudioBufferListPointer) -> OSStatus
+    {
+        guard let adaptiveBuffering = rendererContext.adaptiveBuffering else {
+            return backend.decode(&convertInfo, frameCount: &framesToDecode, into: bufferList)
+        }
+        let started = ProcessInfo.processInfo.systemUptime
+        let status = backend.decode(&convertInfo, frameCount: &framesToDecode, into: bufferList)
+        adaptiveBuffering.recordDecode(frameCount: framesToDecode,
+                                       duration: ProcessInfo.processInfo.systemUptime - started)
+        return status
+    }
+
     /// Fills the `AudioBuffer` with data as required
     ///
     /// - parameter list: An `UnsafeMutableAudioBufferListPointer` object representing the buffer list be filled with data
@@ -539,9 +545,11 @@ final class AudioFileStreamProcessor {
         rendererContext.bufferContext.frameUsedCount += framesCount
         rendererContext.lock.unlock()
 
-        playerContext.audioReadingEntry?.lock.lock()
-        playerContext.audioReadingEntry?.framesState.queued += Int(framesCount)
-        playerContext.audioReadingEntry?.lock.unlock()
+        guard let readingEntry = playerContext.audioReadingEntry else { return }
+        let queued = readingEntry.framesState.queued.add(Int(framesCount))
+        if queued > 0, queued == Int(framesCount) {
+            readingEntry.startupTimeline.mark(.firstFramesDecoded)
+        }
     }
 
     @inline(__always)
@@ -565,82 +573,21 @@ final class AudioFileStreamProcessor {
     }
 }
 
-// MARK: - AudioFileStream proc method
-
-private func _propertyListenerProc(clientData: UnsafeMutableRawPointer,
-                                   fileStream: AudioFileStreamID,
-                                   propertyId: AudioFileStreamPropertyID,
-                                   flags: UnsafeMutablePointer<AudioFileStreamPropertyFlags>)
-{
-    let processor = clientData.to(type: AudioFileStreamProcessor.self)
-    processor.propertyListenerProc(fileStream: fileStream,
-                                   propertyId: propertyId,
-                                   flags: flags)
-}
-
-private func _propertyPacketsProc(clientData: UnsafeMutableRawPointer,
-                                  inNumberBytes: UInt32,
-                                  inNumberPackets: UInt32,
-                                  inInputData: UnsafeRawPointer,
-                                  inPacketDescriptions: UnsafeMutablePointer<AudioStreamPacketDescription>?)
-{
-    let processor = clientData.to(type: AudioFileStreamProcessor.self)
-    processor.propertyPacketsProc(inNumberBytes: inNumberBytes,
-                                  inNumberPackets: inNumberPackets,
-                                  inInputData: inInputData,
-                                  inPacketDescriptions: inPacketDescriptions)
-}
-
-// MARK: - AudioConverterFillComplexBuffer callback method
-
-private func _converterCallback(inAudioConverter _: AudioConverterRef,
-                                ioNumberDataPackets: UnsafeMutablePointer<UInt32>,
-                                ioData: UnsafeMutablePointer<AudioBufferList>,
-                                outDataPacketDescription: UnsafeMutablePointer<UnsafeMutablePointer<AudioStreamPacketDescription>?>?,
-                                inUserData: UnsafeMutableRawPointer?) -> OSStatus
-{
-    guard let convertInfo = inUserData?.assumingMemoryBound(to: AudioConvertInfo.self) else { return 0 }
+// MARK: - AudioDecoderBackendDelegate
 
-    // we need to tell the converter to stop converting after it should stop converting
-    if convertInfo.pointee.done {
-        ioNumberDataPackets.pointee = 0
-        return AudioConvertStatus.done.rawValue
+extension AudioFileStreamProcessor: AudioDecoderBackendDelegate {
+    func decoderBackend(_: AudioDecoderBackend, didDiscover property: AudioStreamProperty) {
+        processProperty(property)
     }
-    // calculate the input buffer
-    ioData.pointee.mNumberBuffers = 1
-    ioData.pointee.mBuffers = convertInfo.pointee.audioBuffer
 
-    // output the packet descriptions
-    if outDataPacketDescription != nil {
-        outDataPacketDescription?.pointee = convertInfo.pointee.packDescription
+    func decoderBackend(_: AudioDecoderBackend, didParse packets: AudioPackets) {
+        propertyPacketsProc(inNumberBytes: packets.byteCount,
+                            inNumberPackets: packets.count,
+                            inInputData: packets.data,
+                            inPacketDescriptions: packets.descriptions)
     }
 
-    ioNumberDataPackets.pointee = convertInfo.pointee.numberOfPackets
-    convertInfo.pointee.done = true
-
-    return AudioConvertStatus.proccessed.rawValue
-}
-
-// MARK: HardwareCodedClass method
-
-private func getHardwareCodecClassDescripition(formatId: UInt32, classDesc: UnsafeMutablePointer<AudioClassDescription>) -> Bool {
-    #if os(iOS)
-        var size: UInt32 = 0
-        let formatIdSize = UInt32(MemoryLayout.size(ofValue: formatId))
-        var id = formatId
-        if AudioFormatGetPropertyInfo(kAudioFormatProperty_Decoders, formatIdSize, &id, &size) != noErr {
-            return false
-        }
-        let count = Int(size) / MemoryLayout<AudioClassDescription>.size
-        var encoderDescriptions = Array(repeating: AudioClassDescription(), count: count)
-        if AudioFormatGetProperty(kAudioFormatProperty_Decoders, formatIdSize, &id, &size, &encoderDescriptions) != noErr {
-            return false
-        }
-
-        for item in encoderDescriptions where item.mManufacturer == kAppleHardwareAudioCodecManufacturer {
-            classDesc.pointee = item
-            return true
-        }
-    #endif
-    return false
+    func decoderBackend(_: AudioDecoderBackend, didFailWith error: AudioPlayerError) {
+        fileStreamCallback?(.raiseError(error))
+    }
 }
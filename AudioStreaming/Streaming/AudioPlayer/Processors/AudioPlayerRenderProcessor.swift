@@ -14,10 +14,21 @@ final class AudioPlayerRenderProcessor: NSObject {
     /// A block that notifies if the audio entry has finished playing
     var audioFinishedPlaying: ((_ entry: AudioEntry?) -> Void)?
 
+    /// A block that notifies that playback reached metadata queued on the entry
+    var metadataReached: ((_ entry: AudioEntry) -> Void)?
+
     private let playerContext: AudioPlayerContext
     private let rendererContext: AudioRendererContext
     private let outputAudioFormat: AudioStreamBasicDescription
 
+    /// The position in the fade-in ramp, only accessed from the render thread
+    private var fadeInPosition: UInt32 = .max
+
+    /// The seek time and frames played of the playing entry when the render cycle first rendered it, and the frames
+    /// rendered since, only accessed from the render thread
+    private var cycleStart: (seekTime: Double, frame: Int)?
+    private var cycleFrames = 0
+
     init(playerContext: AudioPlayerContext,
          rendererContext: AudioRendererContext,
          outputAudioFormat: AudioStreamBasicDescription)
@@ -49,15 +60,25 @@ final class AudioPlayerRenderProcessor: NSObject {
     /// - parameter inNumberFrames: An `AVAudioFrameCount` provided by the `AudioEngine` instance
     /// - returns An optional `UnsafePointer` of `AudioBufferList`
     func inRender(inNumberFrames: AVAudioFrameCount) -> UnsafePointer<AudioBufferList>? {
-        playerContext.entriesLock.lock()
-        let playingEntry = playerContext.audioPlayingEntry
-        let readingEntry = playerContext.audioReadingEntry
-        playerContext.entriesLock.unlock()
+        rendererContext.renderPlan.read { plan in
+            render(plan: plan, inNumberFrames: inNumberFrames)
+        }
+    }
+
+    /// Renders the frames using the given `RenderPlan`, no entry locks are taken
+    /// the entries are read from the plan and the frame counters are updated atomically.
+    private func render(plan: RenderPlan?, inNumberFrames: AVAudioFrameCount) -> UnsafePointer<AudioBufferList>? {
+        let playingEntry = plan?.playingEntry
         let isMuted = playerContext.muted.value
         let state = playerContext.internalState
 
+        if rendererContext.dropsSilentFrames.value, state == .playing,
+           let playingEntry = playingEntry, plan?.isReadingPlayingEntry == true
+        {
+            dropSilentFrames(of: playingEntry, keeping: max(inNumberFrames, rendererContext.liveLatencyTargetFrames))
+        }
+
         rendererContext.lock.lock()
-        var waitForBuffer = false
         let audioBuffer = rendererContext.audioBuffer
         var bufferList = rendererContext.inOutAudioBufferList[0]
         let bufferContext = rendererContext.bufferContext
@@ -65,43 +86,45 @@ final class AudioPlayerRenderProcessor: NSObject {
         let used = bufferContext.frameUsedCount
         let start = bufferContext.frameStartIndex
         let end = bufferContext.end
-        let signal = rendererContext.waiting.value && used < bufferContext.totalFrameCount / 2
+        let readIndexMoves = bufferContext.readIndexMoves
+        rendererContext.lock.unlock()
+        let signal = rendererContext.waiting.value && used < bufferContext.queueCapacity / 2
 
-        if let playingEntry = playingEntry {
-            playingEntry.lock.lock()
+        var waitForBuffer = false
+        if let plan = plan, let playingEntry = playingEntry {
             let framesState = playingEntry.framesState
-            playingEntry.lock.unlock()
+            let queued = framesState.queued.value
+            let lastFrameQueued = framesState.lastFrameQueued.value
             if state == .waitingForData {
-                var requiredFramesToStart = rendererContext.framesRequiredToStartPlaying
-                if framesState.lastFrameQueued >= 0 {
-                    requiredFramesToStart = min(requiredFramesToStart, UInt32(playingEntry.framesState.lastFrameQueued))
+                var requiredFramesToStart = plan.framesRequiredToStartPlaying
+                if lastFrameQueued >= 0 {
+                    requiredFramesToStart = min(requiredFramesToStart, UInt32(lastFrameQueued))
                 }
-                if let readingEntry = readingEntry, readingEntry === playingEntry,
-                   framesState.queued < requiredFramesToStart
-                {
+                if plan.isReadingPlayingEntry, queued < requiredFramesToStart {
                     waitForBuffer = true
                 }
             } else if state == .rebuffering {
-                var requiredFramesToStart = rendererContext.framesRequiredAfterRebuffering
-                if framesState.lastFrameQueued >= 0 {
-                    requiredFramesToStart = min(requiredFramesToStart, UInt32(framesState.lastFrameQueued - framesState.queued))
+                var requiredFramesToStart = plan.framesRequiredAfterRebuffering
+                if lastFrameQueued >= 0 {
+                    requiredFramesToStart = min(requiredFramesToStart, UInt32(lastFrameQueued - queued))
                 }
                 if used < requiredFramesToStart {
                     waitForBuffer = true
                 }
             } else if state == .waitingForDataAfterSeek {
                 var requiredFramesToStart: Int = 1024
-                if framesState.lastFrameQueued >= 0 {
-                    requiredFramesToStart = min(requiredFramesToStart, framesState.lastFrameQueued - framesState.queued)
+                if lastFrameQueued >= 0 {
+                    requiredFramesToStart = min(requiredFramesToStart, lastFrameQueued - queued)
                 }
                 if used < requiredFramesToStart {
                     waitForBuffer = true
                 }
             }
         }
-        rendererContext.lock.unlock()
 
         var totalFramesCopied: UInt32 = 0
+        // the frames copied aren't played when the read index moved meanwhile, the frames moved to play next instead
+        var isConsumed = true
         if used > 0 && !waitForBuffer && state.contains(.running) && state != .paused {
             if end > start {
                 let framesToCopy = min(inNumberFrames, used)
@@ -122,8 +145,7 @@ final class AudioPlayerRenderProcessor: NSObject {
                 totalFramesCopied = framesToCopy
 
                 rendererContext.lock.lock()
-                bufferContext.frameStartIndex = (bufferContext.frameStartIndex + totalFramesCopied) % bufferContext.totalFrameCount
-                bufferContext.frameUsedCount -= totalFramesCopied
+                isConsumed = bufferContext.consume(totalFramesCopied, readAt: readIndexMoves)
                 rendererContext.lock.unlock()
 
             } else {
@@ -166,10 +188,15 @@ final class AudioPlayerRenderProcessor: NSObject {
                 totalFramesCopied = frameToCopy + moreFramesToCopy
 
                 rendererContext.lock.lock()
-                bufferContext.frameStartIndex = (bufferContext.frameStartIndex + totalFramesCopied) % bufferContext.totalFrameCount
-                bufferContext.frameUsedCount -= totalFramesCopied
+                isConsumed = bufferContext.consume(totalFramesCopied, readAt: readIndexMoves)
                 rendererContext.lock.unlock()
             }
+            if state == .waitingForData, rendererContext.fadeInFrameCount > 0 {
+                fadeInPosition = 0
+            }
+            if fadeInPosition < rendererContext.fadeInFrameCount {
+                applyFadeIn(to: bufferList.mBuffers, frameCount: totalFramesCopied, isMuted: isMuted)
+            }
             if playerContext.internalState != .playing {
                 playerContext.setInternalState(to: .playing, when: { state -> Bool in
                     state.contains(.running) && state != .paused
@@ -191,17 +218,17 @@ final class AudioPlayerRenderProcessor: NSObject {
                 }
             } else if state == .waitingForDataAfterSeek {
                 if totalFramesCopied == 0 {
-                    rendererContext.waitingForDataAfterSeekFrameCount.write { $0 += Int32(inNumberFrames - totalFramesCopied) }
-                    if rendererContext.waitingForDataAfterSeekFrameCount.value > rendererContext.framesRequiredForDataAfterSeekPlaying {
+                    let framesWaited = rendererContext.waitingForDataAfterSeekFrameCount.add(Int(inNumberFrames - totalFramesCopied))
+                    if framesWaited > rendererContext.framesRequiredForDataAfterSeekPlaying {
                         if playerContext.internalState != .playing {
                             playerContext.setInternalState(to: .playing) { state -> Bool in
                                 state.contains(.running) && state != .playing
                             }
                         }
-                        rendererContext.waitingForDataAfterSeekFrameCount.write { $0 = 0 }
+                        rendererContext.waitingForDataAfterSeekFrameCount.store(0)
                     }
                 } else {
-                    rendererContext.waitingForDataAfterSeekFrameCount.write { $0 = 0 }
+                    rendererContext.waitingForDataAfterSeekFrameCount.store(0)
                 }
             }
         }
@@ -209,56 +236,54 @@ final class AudioPlayerRenderProcessor: NSObject {
         guard let currentPlayingEntry = playingEntry else {
             return nil
         }
-        currentPlayingEntry.lock.lock()
-
-        var extraFramesPlayedNotAssigned: Int = 0
-        var framesPlayedForCurrent = Int(totalFramesCopied)
+        let framesState = currentPlayingEntry.framesState
 
-        if currentPlayingEntry.framesState.lastFrameQueued >= 0 {
-            let playedFrames = currentPlayingEntry.framesState.lastFrameQueued - currentPlayingEntry.framesState.played
+        var framesPlayedForCurrent = isConsumed ? Int(totalFramesCopied) : 0
+        let lastFrameQueued = framesState.lastFrameQueued.value
+        if lastFrameQueued >= 0 {
+            let playedFrames = lastFrameQueued - framesState.played.value
             framesPlayedForCurrent = min(playedFrames, framesPlayedForCurrent)
         }
 
-        currentPlayingEntry.framesState.played += Int(framesPlayedForCurrent)
-        extraFramesPlayedNotAssigned = Int(totalFramesCopied) - framesPlayedForCurrent
+        let framesPlayed = framesState.played.add(framesPlayedForCurrent)
+        if cycleStart == nil {
+            cycleStart = (currentPlayingEntry.seekTime, framesPlayed - framesPlayedForCurrent)
+        }
+        cycleFrames += framesPlayedForCurrent
+        if currentPlayingEntry.metadataQueue.claim(playedFrame: framesPlayed) {
+            metadataReached?(currentPlayingEntry)
+        }
+        var extraFramesPlayedNotAssigned = isConsumed ? Int(totalFramesCopied) - framesPlayedForCurrent : 0
 
-        let lastFramePlayed = currentPlayingEntry.framesState.played == currentPlayingEntry.framesState.lastFrameQueued
+        let lastFramePlayed = framesPlayed == lastFrameQueued
 
-        currentPlayingEntry.lock.unlock()
         if signal || lastFramePlayed {
-            playerContext.entriesLock.lock()
-            let entry = playerContext.audioPlayingEntry
-            playerContext.entriesLock.unlock()
+            let entry = rendererContext.renderPlan.latest()?.playingEntry
             if lastFramePlayed, playingEntry === entry {
                 audioFinishedPlaying?(playingEntry)
 
                 while extraFramesPlayedNotAssigned > 0 {
-                    playerContext.entriesLock.lock()
-                    let newEntry = playerContext.audioPlayingEntry
-                    playerContext.entriesLock.unlock()
-                    if let newEntry = newEntry {
-                        var framesPlayedForCurrent = extraFramesPlayedNotAssigned
-
-                        newEntry.lock.lock()
-                        let framesState = newEntry.framesState
-                        if newEntry.framesState.lastFrameQueued > 0 {
-                            framesPlayedForCurrent = min(framesState.lastFrameQueued - framesState.played, framesPlayedForCurrent)
-                        }
-
-                        newEntry.framesState.played += framesPlayedForCurrent
-
-                        if framesState.played == framesState.lastFrameQueued {
-                            newEntry.lock.unlock()
-                            audioFinishedPlaying?(newEntry)
-                        } else {
-                            newEntry.lock.unlock()
-                        }
+                    guard let newEntry = rendererContext.renderPlan.latest()?.playingEntry else {
+                        break
+                    }
+                    let newFramesState = newEntry.framesState
+                    var framesPlayedForCurrent = extraFramesPlayedNotAssigned
 
-                        extraFramesPlayedNotAssigned -= framesPlayedForCurrent
+                    let lastFrameQueued = newFramesState.lastFrameQueued.value
+                    if lastFrameQueued > 0 {
+                        framesPlayedForCurrent = min(lastFrameQueued - newFramesState.played.value, framesPlayedForCurrent)
+                    }
+                    guard framesPlayedForCurrent > 0 else { break }
 
-                    } else {
-                        break
+                    let framesPlayed = newFramesState.played.add(framesPlayedForCurrent)
+                    if newEntry.metadataQueue.claim(playedFrame: framesPlayed) {
+                        metadataReached?(newEntry)
+                    }
+                    if framesPlayed == lastFrameQueued {
+                        audioFinishedPlaying?(newEntry)
                     }
+
+                    extraFramesPlayedNotAssigned -= framesPlayedForCurrent
                 }
             }
             if rendererContext.waiting.value {
@@ -312,13 +337,92 @@ final class AudioPlayerRenderProcessor: NSObject {
     }
 
     func renderProvider(flags: UnsafeMutablePointer<AudioUnitRenderActionFlags>,
-                        timeStamp _: UnsafePointer<AudioTimeStamp>,
+                        timeStamp: UnsafePointer<AudioTimeStamp>,
                         inNumberFrames: AUAudioFrameCount,
                         inputBusNumber: Int,
                         inputData: UnsafeMutablePointer<AudioBufferList>) -> AUAudioUnitStatus
     {
         guard inputBusNumber == 0 else { return noErr }
-        return render(inNumberFrames: inNumberFrames, ioData: inputData, flags: flags)
+        let clock = rendererContext.playbackClock
+        // read before the frames of the entry, samples of a seek requested meanwhile are discarded
+        let epoch = clock.currentEpoch()
+        cycleStart = nil
+        cycleFrames = 0
+        let status = render(inNumberFrames: inNumberFrames, ioData: inputData, flags: flags)
+
+        // the rate node may render the cycle from frames it pulled earlier, the last sample carries on then
+        if let start = cycleStart {
+            let sampleRate = outputAudioFormat.mSampleRate
+            let hostTime = timeStamp.pointee.mFlags.contains(.hostTimeValid)
+                ? timeStamp.pointee.mHostTime
+                : mach_absolute_time()
+            clock.publish(framesRendered: start.frame,
+                          position: start.seekTime + Double(start.frame) / sampleRate,
+                          hostTime: hostTimeSeconds(hostTime),
+                          renderedDuration: Double(cycleFrames) / sampleRate,
+                          epoch: epoch)
+        }
+        return status
+    }
+
+    /// Ramps up the gain of the given frames, continuing from the current `fadeInPosition`
+    ///
+    /// - parameter buffer: An `AudioBuffer` holding interleaved float samples in the output format
+    /// - parameter frameCount: The number of frames in the buffer
+    /// - parameter isMuted: When `true` the samples are left untouched but the ramp still advances
+    @inline(__always)
+    private func applyFadeIn(to buffer: AudioBuffer, frameCount: UInt32, isMuted: Bool) {
+        let fadeInFrameCount = rendererContext.fadeInFrameCount
+        let frames = min(frameCount, fadeInFrameCount - fadeInPosition)
+        defer { fadeInPosition += frames }
+        guard !isMuted, let mData = buffer.mData else { return }
+
+        let channels = Int(outputAudioFormat.mChannelsPerFrame)
+        let samples = mData.assumingMemoryBound(to: Float.self)
+        for frame in 0 ..< Int(frames) {
+            let gain = Float(fadeInPosition + UInt32(frame) + 1) / Float(fadeInFrameCount)
+            for channel in 0 ..< channels {
+                samples[frame * channels + channel] *= gain
+            }
+        }
+    }
+
+    /// Drops the silent frames leading the buffer, catching up with the live edge of the given entry
+    ///
+    /// A few milliseconds of each silence are kept so the audio around it isn't joined abruptly, and only silences
+    /// long enough to be pauses are shortened.
+    ///
+    /// - parameter keptFrames: The frames left buffered at least
+    private func dropSilentFrames(of entry: AudioEntry, keeping keptFrames: UInt32) {
+        // the entry has ended, its last frames are accounted for
+        guard entry.framesState.lastFrameQueued.value < 0 else { return }
+
+        rendererContext.lock.lock()
+        let bufferContext = rendererContext.bufferContext
+        let start = bufferContext.frameStartIndex
+        let used = bufferContext.frameUsedCount
+        let readIndexMoves = bufferContext.readIndexMoves
+        let mData = rendererContext.audioBuffer.mData
+        rendererContext.lock.unlock()
+        guard used > keptFrames, let buffer = mData else { return }
+
+        let sampleRate = outputAudioFormat.mSampleRate
+        let keptSilence = Int(sampleRate * 0.005)
+        let candidates = min(used - keptFrames, bufferContext.totalFrameCount - start, maxFramesPerSlice)
+        let samples = (buffer + Int(start * bufferContext.sizeInBytes)).assumingMemoryBound(to: Float.self)
+        let silentFrames = leadingSilentFrameCount(samples,
+                                                   frameCount: Int(candidates),
+                                                   channels: Int(outputAudioFormat.mChannelsPerFrame))
+        guard silentFrames >= Int(sampleRate * 0.02) else { return }
+        let droppedFrames = UInt32(silentFrames - keptSilence)
+
+        rendererContext.lock.lock()
+        let isConsumed = bufferContext.consume(droppedFrames, readAt: readIndexMoves)
+        rendererContext.lock.unlock()
+        guard isConsumed else { return }
+
+        entry.framesState.played.add(Int(droppedFrames))
+        rendererContext.droppedSilentFrameCount.add(Int(droppedFrames))
     }
 
     @inline(__always)
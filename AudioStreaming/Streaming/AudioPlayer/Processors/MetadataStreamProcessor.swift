@@ -6,7 +6,9 @@
 import AVFoundation
 
 protocol MetadataStreamSourceDelegate: AnyObject {
-    func didReceiveMetadata(metadata: Result<[String: String], MetadataParsingError>)
+    /// Reports the metadata parsed by `proccessMetadata(data:)`
+    /// - parameter audioOffset: The bytes of the audio returned by `proccessMetadata(data:)` preceding the metadata
+    func didReceiveMetadata(metadata: Result<[String: String], MetadataParsingError>, audioOffset: Int)
 }
 
 protocol MetadataStreamSource {
@@ -95,7 +97,7 @@ final class MetadataStreamProcessor: MetadataStreamSource {
                     if metadata.count == metadataLength {
                         // we have extracted the metadata, so we can parse
                         let processedMetadata = parser.parse(input: metadata)
-                        delegate?.didReceiveMetadata(metadata: processedMetadata)
+                        delegate?.didReceiveMetadata(metadata: processedMetadata, audioOffset: audioData.count)
 
                         metadata.count = 0
                         metadataLength = 0
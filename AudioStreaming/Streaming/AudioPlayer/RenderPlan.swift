@@ -0,0 +1,34 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import Foundation
+
+/// An immutable snapshot of what the render thread needs to know about the entries,
+/// published via `AudioRendererContext.renderPlan` whenever the playing or reading entry changes.
+///
+/// The frame counters are not part of the plan, the render thread reads and reports
+/// them through the atomic counters of `EntryFramesState`.
+final class RenderPlan {
+    /// The entry currently playing, if any
+    let playingEntry: AudioEntry?
+    /// `true` when the playing entry is also the one being read from the source
+    let isReadingPlayingEntry: Bool
+
+    /// Number of frames required before playback first starts.
+    let framesRequiredToStartPlaying: UInt32
+    /// Number of frames required before playback resumes after a buffer underun.
+    let framesRequiredAfterRebuffering: UInt32
+
+    init(playingEntry: AudioEntry?,
+         readingEntry: AudioEntry?,
+         framesRequiredToStartPlaying: UInt32,
+         framesRequiredAfterRebuffering: UInt32)
+    {
+        self.playingEntry = playingEntry
+        isReadingPlayingEntry = playingEntry != nil && readingEntry === playingEntry
+        self.framesRequiredToStartPlaying = framesRequiredToStartPlaying
+        self.framesRequiredAfterRebuffering = framesRequiredAfterRebuffering
+    }
+}
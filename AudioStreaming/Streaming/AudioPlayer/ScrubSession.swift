@@ -0,0 +1,79 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import Foundation
+
+/// Coalesces the positions of a scrub session, see `AudioPlayer.beginScrubbing(previews:)`
+///
+/// Only the latest position is applied, once scrubbing rests for `debounceInterval` or at least every
+/// `maximumInterval` while it keeps moving. Used on a single queue, the one positions are applied on.
+final class ScrubSession {
+    /// Plays a short preview of the audio at the positions applied
+    let previews: Bool
+    /// The seconds of audio a preview plays
+    let previewDuration: TimeInterval
+
+    /// The latest position scrubbed to, `nil` until scrubbed
+    private(set) var position: Double?
+
+    private let queue: DispatchQueue
+    private let debounceInterval: TimeInterval
+    private let maximumInterval: TimeInterval
+    private let apply: (Double) -> Void
+
+    private var pendingWork: DispatchWorkItem?
+    private var pendingSince: DispatchTime?
+    private var appliedPosition: Double?
+
+    init(queue: DispatchQueue,
+         previews: Bool,
+         debounceInterval: TimeInterval = 0.08,
+         maximumInterval: TimeInterval = 0.25,
+         previewDuration: TimeInterval = 0.15,
+         apply: @escaping (Double) -> Void)
+    {
+        self.queue = queue
+        self.previews = previews
+        self.debounceInterval = debounceInterval
+        self.maximumInterval = max(maximumInterval, debounceInterval)
+        self.previewDuration = previewDuration
+        self.apply = apply
+    }
+
+    /// Schedules the given position to be applied, replacing the one pending
+    func scrub(to position: Double) {
+        self.position = position
+        pendingWork?.cancel()
+
+        let now = DispatchTime.now()
+        let since = pendingSince ?? now
+        pendingSince = since
+        let work = DispatchWorkItem { [weak self] in
+            self?.applyPending()
+        }
+        pendingWork = work
+        queue.asyncAfter(deadline: min(now + debounceInterval, since + maximumInterval), execute: work)
+    }
+
+    /// Ends the session without applying the position pending
+    ///
+    /// - Returns: The latest position scrubbed to, the one to seek to, `nil` when not scrubbed
+    func end() -> Double? {
+        pendingWork?.cancel()
+        pendingWork = nil
+        pendingSince = nil
+        return position
+    }
+
+    // MARK: Private
+
+    private func applyPending() {
+        pendingWork = nil
+        pendingSince = nil
+        guard let position = position, position != appliedPosition else { return }
+        appliedPosition = position
+        apply(position)
+    }
+}
@@ -0,0 +1,86 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import Foundation
+
+/// The time spent in each phase from requesting an entry until its first audio is rendered, in seconds.
+public struct AudioPlayerStartupTimings: Equatable {
+    /// From requesting the entry until its first bytes arrive
+    public let connection: TimeInterval
+    /// From the first bytes until the stream format is discovered
+    public let formatDiscovery: TimeInterval
+    /// Time spent creating the audio converter, this might overlap with the connection when a cached format was used
+    public let converterSetup: TimeInterval
+    /// From the stream format discovery until the first frames are decoded
+    public let firstDecode: TimeInterval
+    /// From the first decoded frames until they are rendered
+    public let firstRender: TimeInterval
+    /// From requesting the entry until its first audio is rendered
+    public let timeToFirstAudio: TimeInterval
+    /// `true` when the audio converter was created from a cached stream format
+    public let usedCachedFormat: Bool
+}
+
+/// Records the startup phases of an entry, only the first mark of each phase is kept.
+///
+/// - note: Thread safe, phases are marked from the source queue as well as the render thread.
+final class StartupTimeline {
+    enum Phase: Int, CaseIterable {
+        case requested
+        case firstByte
+        case formatDiscovered
+        case firstFramesDecoded
+        case firstAudio
+    }
+
+    private let lock = UnfairLock()
+    private var marks: [Phase: TimeInterval] = [:]
+    private var converterSetup: TimeInterval = 0
+    private var usedCachedFormat = false
+    private var reported = false
+
+    func mark(_ phase: Phase, at time: TimeInterval = ProcessInfo.processInfo.systemUptime) {
+        lock.around {
+            if marks[phase] == nil {
+                marks[phase] = time
+            }
+        }
+    }
+
+    func isMarked(_ phase: Phase) -> Bool {
+        lock.around { marks[phase] != nil }
+    }
+
+    /// Records the time spent creating an audio converter, the last one created is the one in use
+    func recordConverterSetup(duration: TimeInterval, usedCachedFormat: Bool) {
+        lock.around {
+            converterSetup += duration
+            self.usedCachedFormat = usedCachedFormat
+        }
+    }
+
+    /// Returns the timings once all phases are marked, only the first call after that returns a value.
+    func takeTimings() -> AudioPlayerStartupTimings? {
+        lock.around {
+            guard !reported,
+                  let requested = marks[.requested],
+                  let firstByte = marks[.firstByte],
+                  let formatDiscovered = marks[.formatDiscovered],
+                  let firstFramesDecoded = marks[.firstFramesDecoded],
+                  let firstAudio = marks[.firstAudio]
+            else {
+                return nil
+            }
+            reported = true
+            return AudioPlayerStartupTimings(connection: max(0, firstByte - requested),
+                                             formatDiscovery: max(0, formatDiscovered - firstByte),
+                                             converterSetup: converterSetup,
+                                             firstDecode: max(0, firstFramesDecoded - formatDiscovered),
+                                             firstRender: max(0, firstAudio - firstFramesDecoded),
+                                             timeToFirstAudio: max(0, firstAudio - requested),
+                                             usedCachedFormat: usedCachedFormat)
+        }
+    }
+}
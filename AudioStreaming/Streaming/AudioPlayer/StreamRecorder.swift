@@ -0,0 +1,215 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import Foundation
+
+/// Records the compressed audio played, as received and without the ICY metadata, to a file without re-encoding it.
+///
+/// Set it to `AudioPlayer.streamRecorder` to start recording. The audio is written in batches on a background queue
+/// so the parsing of the stream never waits on the disk. Audio arriving while more than `maximumPendingBytes` wait to
+/// be written is dropped, and counted by `droppedBytes`.
+///
+/// Metadata can be recorded to a sidecar file, one JSON object per line, holding the offset in the recording and the
+/// seconds since recording started it was received at, eg. `{"offset":40960,"time":2.5,"metadata":{"StreamTitle":"…"}}`
+public final class StreamRecorder {
+    /// The file the audio is recorded to
+    public let url: URL
+    /// The file the metadata is recorded to, if any
+    public let metadataURL: URL?
+
+    /// The bytes of audio written to the file
+    public var writtenBytes: Int {
+        state.value.writtenBytes
+    }
+
+    /// The bytes of audio dropped as the disk fell behind
+    public var droppedBytes: Int {
+        state.value.droppedBytes
+    }
+
+    private struct State {
+        /// The audio batched until `batchSize` bytes are pending
+        var batch: [Data] = []
+        var batchBytes = 0
+        /// The bytes batched or being written
+        var pendingBytes = 0
+        /// The bytes of audio recorded, the offset of the next one in the file
+        var recordedBytes = 0
+        var writtenBytes = 0
+        var droppedBytes = 0
+        var isClosed = false
+    }
+
+    private let batchSize: Int
+    private let maximumPendingBytes: Int
+    private let sink: FileSink
+    private let state = Protected(State())
+    private let startTime = ProcessInfo.processInfo.systemUptime
+
+    /// Creates the files to record to, replacing existing ones
+    ///
+    /// - parameter url: The file the audio is recorded to
+    /// - parameter metadataURL: The sidecar file the metadata is recorded to, `nil` records no metadata
+    /// - parameter batchSize: The bytes of audio written at once
+    /// - parameter maximumPendingBytes: The bytes of audio waiting to be written, over which audio is dropped
+    public init(url: URL,
+                metadataURL: URL? = nil,
+                batchSize: Int = 64 * 1024,
+                maximumPendingBytes: Int = 4 * 1024 * 1024) throws
+    {
+        self.url = url
+        self.metadataURL = metadataURL
+        self.batchSize = max(batchSize, 1)
+        self.maximumPendingBytes = max(maximumPendingBytes, batchSize)
+        sink = try FileSink(url: url, metadataURL: metadataURL)
+    }
+
+    deinit {
+        let batch = state.write { state -> [Data] in
+            state.isClosed = true
+            return state.batch
+        }
+        let sink = self.sink
+        sink.queue.async {
+            _ = sink.write(batch)
+            sink.close()
+        }
+    }
+
+    /// Writes the audio batched and closes the files, no audio is recorded afterwards
+    ///
+    /// - parameter completion: Called on the main queue once the files are closed
+    public func finish(completion: (() -> Void)? = nil) {
+        let batch = state.write { state -> [Data]? in
+            guard !state.isClosed else { return nil }
+            state.isClosed = true
+            let batch = state.batch
+            state.batch = []
+            state.batchBytes = 0
+            return batch
+        }
+        sink.queue.async { [sink] in
+            if let batch = batch {
+                self.written(sink.write(batch), of: batch)
+                sink.close()
+            }
+            if let completion = completion {
+                asyncOnMain(completion)
+            }
+        }
+    }
+
+    // MARK: Internal
+
+    /// Records the given audio, or drops it when the disk falls behind
+    func record(_ data: Data) {
+        guard !data.isEmpty else { return }
+        let maximumPendingBytes = self.maximumPendingBytes
+        let batchSize = self.batchSize
+        let (batch, dropped) = state.write { state -> ([Data]?, Bool) in
+            guard !state.isClosed else { return (nil, false) }
+            guard state.pendingBytes + data.count <= maximumPendingBytes else {
+                state.droppedBytes += data.count
+                return (nil, true)
+            }
+            state.batch.append(data)
+            state.batchBytes += data.count
+            state.pendingBytes += data.count
+            state.recordedBytes += data.count
+            guard state.batchBytes >= batchSize else { return (nil, false) }
+            let batch = state.batch
+            state.batch = []
+            state.batchBytes = 0
+            return (batch, false)
+        }
+        if dropped {
+            Logger.error("stream recorder fell behind, dropped %d bytes", category: .generic, args: data.count)
+        }
+        guard let audio = batch else { return }
+        sink.queue.async { [sink] in
+            self.written(sink.write(audio), of: audio)
+        }
+    }
+
+    /// Records the given metadata at the offset of the audio recorded so far
+    func record(metadata: [String: String]) {
+        guard metadataURL != nil else { return }
+        let offset = state.read { state -> Int? in state.isClosed ? nil : state.recordedBytes }
+        guard let recordedOffset = offset else { return }
+        let time = ProcessInfo.processInfo.systemUptime - startTime
+        sink.queue.async { [sink] in
+            let line: [String: Any] = ["offset": recordedOffset, "time": time, "metadata": metadata]
+            guard var data = try? JSONSerialization.data(withJSONObject: line, options: [.sortedKeys]) else { return }
+            data.append(0x0A)
+            sink.writeMetadata(data)
+        }
+    }
+
+    // MARK: Private
+
+    private func written(_ count: Int, of batch: [Data]) {
+        let total = batch.reduce(0) { $0 + $1.count }
+        state.write { state in
+            state.pendingBytes -= total
+            state.writtenBytes += count
+            state.droppedBytes += total - count
+        }
+    }
+}
+
+/// The files of a `StreamRecorder`, written on its serial queue
+private final class FileSink {
+    let queue = DispatchQueue(label: "stream.recorder.queue", qos: .utility)
+    private var audioDescriptor: Int32
+    private var metadataDescriptor: Int32
+
+    init(url: URL, metadataURL: URL?) throws {
+        audioDescriptor = open(url.path, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR)
+        guard audioDescriptor >= 0 else { throw AudioSystemError.playerStartError }
+        metadataDescriptor = -1
+        if let metadataURL = metadataURL {
+            metadataDescriptor = open(metadataURL.path, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR)
+            guard metadataDescriptor >= 0 else {
+                _ = Darwin.close(audioDescriptor)
+                throw AudioSystemError.playerStartError
+            }
+        }
+    }
+
+    /// Writes the given audio, returning the bytes written
+    func write(_ batch: [Data]) -> Int {
+        batch.reduce(0) { $0 + write($1, to: audioDescriptor) }
+    }
+
+    func writeMetadata(_ data: Data) {
+        _ = write(data, to: metadataDescriptor)
+    }
+
+    func close() {
+        for descriptor in [audioDescriptor, metadataDescriptor] where descriptor >= 0 {
+            _ = Darwin.close(descriptor)
+        }
+        audioDescriptor = -1
+        metadataDescriptor = -1
+    }
+
+    private func write(_ data: Data, to descriptor: Int32) -> Int {
+        guard descriptor >= 0 else { return 0 }
+        return data.withUnsafeBytes { buffer -> Int in
+            guard let base = buffer.baseAddress else { return 0 }
+            var offset = 0
+            while offset < buffer.count {
+                let count = Darwin.write(descriptor, base + offset, buffer.count - offset)
+                if count < 0, errno == EINTR { continue }
+                guard count > 0 else {
+                    Logger.error("stream recorder write failed %d", category: .generic, args: errno)
+                    break
+                }
+                offset += count
+            }
+            return offset
+        }
+    }
+}
@@ -0,0 +1,385 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import AVFoundation
+#if SWIFT_PACKAGE
+    import AudioStreamingMP3
+#endif
+
+/// Demuxes ADTS streams, eg. Shoutcast AAC+ radio, into raw AAC packets which are decoded by `AudioConverter`.
+///
+/// The packet descriptions point into the received bytes, only a frame split between two chunks is copied.
+/// The first frames are probed for the SBR extension of HE-AAC, which isn't signalled by the ADTS header,
+/// so the decoder can be created for the right format before the first packet.
+/// Frames of another format following each other are a change of format, eg. switching HLS variants, which is
+/// reported as a new data format once the packets before it are parsed.
+final class ADTSDemuxerBackend: AudioDecoderBackend {
+    weak var delegate: AudioDecoderBackendDelegate?
+
+    /// The frames checked for SBR before the format is reported
+    private let probeFrameCount = 4
+    /// Bytes kept while searching for the first frames, a stream without frames in this many bytes is not ADTS
+    private let maxProbeSize = 64 * 1024
+    private let bitRateReportInterval = 64
+
+    /// Decodes the packets, its own stream is never opened
+    private let decoder: AudioToolboxDecoderBackend
+
+    private(set) var isOpen = false
+    /// Bytes received but not yet parsed into frames
+    private var pendingBytes: [UInt8] = []
+    /// The offset in the stream of the first pending byte
+    private var pendingOffset: UInt64 = 0
+    /// The header of the last frame in sync, `nil` while searching for a frame
+    private var syncedHeader: ADTSHeader?
+    /// The header of the first frame, frames found after losing sync must match it
+    private var streamHeader: ADTSHeader?
+
+    private(set) var frameIndex: MPEGFrameIndex?
+
+    var decoderFormat: FastStartFormat? {
+        decoder.decoderFormat
+    }
+
+    init(outputFormat: AudioStreamBasicDescription,
+         fastStartCache: FastStartCache? = nil,
+         converterPool: AudioConverterPool = AudioConverterPool())
+    {
+        decoder = AudioToolboxDecoderBackend(outputFormat: outputFormat,
+                                             fastStartCache: fastStartCache,
+                                             converterPool: converterPool)
+        decoder.delegate = self
+    }
+
+    // MARK: Parsing
+
+    func open(fileHint _: AudioFileTypeID) -> OSStatus {
+        close()
+        isOpen = true
+        return noErr
+    }
+
+    func close() {
+        isOpen = false
+        pendingBytes.removeAll()
+        pendingOffset = 0
+        syncedHeader = nil
+        streamHeader = nil
+        frameIndex = nil
+    }
+
+    func parse(data: Data, discontinuous: Bool) -> OSStatus {
+        guard isOpen, !data.isEmpty else { return noErr }
+        if discontinuous {
+            syncedHeader = nil
+        }
+        data.withUnsafeBytes { buffer in
+            guard let bytes = buffer.baseAddress?.assumingMemoryBound(to: UInt8.self) else { return }
+            parse(bytes: bytes, count: buffer.count)
+        }
+        return noErr
+    }
+
+    private func parse(bytes: UnsafePointer<UInt8>, count: Int) {
+        guard streamHeader != nil else {
+            // the first frames are copied until the format is known
+            pendingBytes.append(contentsOf: UnsafeBufferPointer(start: bytes, count: count))
+            guard probeFormat() else { return }
+            let consumed = scanPendingBytes(upTo: pendingBytes.count)
+            guard isOpen else { return }
+            pendingBytes.removeFirst(consumed)
+            pendingOffset += UInt64(consumed)
+            return
+        }
+
+        var start = 0
+        if !pendingBytes.isEmpty {
+            // completes the frame split between the chunks, copying no more than a frame and the header after it
+            let carried = pendingBytes.count
+            let copied = min(count, ADTSHeader.maxFrameLength + ADTSHeader.minimumSize)
+            pendingBytes.append(contentsOf: UnsafeBufferPointer(start: bytes, count: copied))
+            let consumed = scanPendingBytes(upTo: carried)
+            guard isOpen else { return }
+            guard consumed >= carried else {
+                // the chunk was smaller than the split frame
+                pendingBytes.removeFirst(consumed)
+                pendingOffset += UInt64(consumed)
+                pendingBytes.append(contentsOf: UnsafeBufferPointer(start: bytes + copied, count: count - copied))
+                return
+            }
+            start = consumed - carried
+            pendingBytes.removeAll(keepingCapacity: true)
+            pendingOffset += UInt64(consumed)
+        }
+
+        let consumed = scanFrames(in: bytes + start, count: count - start, streamOffset: pendingOffset, upTo: count - start)
+        guard isOpen else { return }
+        pendingOffset += UInt64(consumed)
+        pendingBytes.append(contentsOf: UnsafeBufferPointer(start: bytes + start + consumed, count: count - start - consumed))
+    }
+
+    private func scanPendingBytes(upTo limit: Int) -> Int {
+        let bytes = pendingBytes
+        return bytes.withUnsafeBufferPointer { buffer -> Int in
+            guard let baseAddress = buffer.baseAddress else { return 0 }
+            return scanFrames(in: baseAddress, count: buffer.count, streamOffset: pendingOffset, upTo: limit)
+        }
+    }
+
+    /// Finds the complete frames starting before `limit` and reports their packets
+    ///
+    /// - Returns: The number of bytes that were either parsed into frames or skipped while searching for one.
+    private func scanFrames(in bytes: UnsafePointer<UInt8>, count: Int, streamOffset: UInt64, upTo limit: Int) -> Int {
+        var descriptions: [AudioStreamPacketDescription] = []
+        var offset = 0
+        scan: while offset < limit, offset + ADTSHeader.minimumSize <= count {
+            guard let header = ADTSHeader(bytes: bytes + offset) else {
+                offset = resync(in: bytes, count: count, after: offset, streamOffset: streamOffset)
+                continue
+            }
+            if !belongsToStream(header) {
+                switch streamChange(in: bytes, count: count, from: offset, header: header) {
+                case .pending where syncedHeader != nil:
+                    // right after a frame in sync, more bytes are needed to tell a change of format from a corrupt frame
+                    break scan
+                case .none, .pending:
+                    offset = resync(in: bytes, count: count, after: offset, streamOffset: streamOffset)
+                    continue scan
+                case let .started(sbrFrames):
+                    // the packets of the previous format are decoded before the decoder is prepared for the new one
+                    report(descriptions, in: bytes)
+                    descriptions.removeAll()
+                    changeFormat(header: header, hasSBR: sbrFrames * 2 >= probeFrameCount, offset: streamOffset + UInt64(offset))
+                }
+            }
+            let nextOffset = offset + header.frameLength
+            if nextOffset + ADTSHeader.minimumSize <= count {
+                guard isFollowedByFrame(bytes + nextOffset, header: header) else {
+                    offset = resync(in: bytes, count: count, after: offset, streamOffset: streamOffset)
+                    continue
+                }
+            } else if syncedHeader == nil || nextOffset > count {
+                break
+            }
+            syncedHeader = header
+
+            if header.rawDataBlockCount == 1 {
+                descriptions.append(AudioStreamPacketDescription(mStartOffset: Int64(offset + header.headerSize),
+                                                                 mVariableFramesInPacket: 0,
+                                                                 mDataByteSize: UInt32(header.frameLength - header.headerSize)))
+                indexFrame(header: header, offset: streamOffset + UInt64(offset))
+            } else {
+                Logger.debug("skipping an adts frame of %d raw data blocks", category: .audioRendering, args: header.rawDataBlockCount)
+            }
+            offset = nextOffset
+        }
+
+        report(descriptions, in: bytes)
+        return offset
+    }
+
+    private func report(_ descriptions: [AudioStreamPacketDescription], in bytes: UnsafePointer<UInt8>) {
+        guard let last = descriptions.last else { return }
+        var descriptions = descriptions
+        descriptions.withUnsafeMutableBufferPointer { descriptionsBuffer in
+            let packets = AudioPackets(data: UnsafeRawPointer(bytes),
+                                       byteCount: UInt32(last.mStartOffset) + last.mDataByteSize,
+                                       count: UInt32(descriptionsBuffer.count),
+                                       descriptions: descriptionsBuffer.baseAddress)
+            delegate?.decoderBackend(self, didParse: packets)
+        }
+    }
+
+    /// Drops the sync and finds the next sync word after the given offset.
+    /// ADTS shares the 12 bits sync word of MPEG audio, the candidates of `as_mp3_find_sync` are checked by `ADTSHeader`.
+    ///
+    /// - Returns: The offset of the next sync word, a trailing `0xFF` is kept as it may start a sync word
+    private func resync(in bytes: UnsafePointer<UInt8>, count: Int, after offset: Int, streamOffset: UInt64) -> Int {
+        if syncedHeader != nil {
+            Logger.debug("adts stream lost sync at offset %d", category: .audioRendering, args: Int(streamOffset) + offset)
+            syncedHeader = nil
+        }
+        let start = offset + 1
+        let next = start + as_mp3_find_sync(bytes + start, count - start)
+        if next == count, count > start, bytes[count - 1] == 0xFF {
+            return count - 1
+        }
+        return next
+    }
+
+    private func belongsToStream(_ header: ADTSHeader) -> Bool {
+        guard let reference = syncedHeader ?? streamHeader else { return true }
+        return reference.isSameStream(as: header)
+    }
+
+    /// Checks the bytes following a frame, which are either the next frame of the stream or, once in sync, a tag at the
+    /// end of the file or a frame of another format, checked as a change of format
+    private func isFollowedByFrame(_ next: UnsafePointer<UInt8>, header: ADTSHeader) -> Bool {
+        if let nextHeader = ADTSHeader(bytes: next) {
+            return header.isSameStream(as: nextHeader) || syncedHeader != nil
+        }
+        guard syncedHeader != nil else { return false }
+        let tag = String(decoding: UnsafeBufferPointer(start: next, count: 4), as: UTF8.self)
+        return tag.hasPrefix("TAG") || tag == "APET"
+    }
+
+    private func indexFrame(header: ADTSHeader, offset: UInt64) {
+        let bitrate = Double(header.frameLength) * 8 * header.sampleRate / 1024 / 1000
+        guard frameIndex?.append(offset: offset, size: UInt16(header.frameLength), bitrate: UInt16(min(bitrate, Double(UInt16.max)))) == true,
+              let index = frameIndex, index.count % bitRateReportInterval == 0
+        else { return }
+        delegate?.decoderBackend(self, didDiscover: .bitRate(index.averageBitRate))
+    }
+
+    // MARK: Format
+
+    /// Searches the pending bytes for the first frames of the stream and reports its properties
+    ///
+    /// - Returns: `true` once the properties are reported
+    private func probeFormat() -> Bool {
+        let probe = pendingBytes.withUnsafeBufferPointer { buffer -> (offset: Int, header: ADTSHeader, sbrFrames: Int)? in
+            guard let bytes = buffer.baseAddress else { return nil }
+            var offset = 0
+            while offset + ADTSHeader.minimumSize <= buffer.count {
+                if let header = ADTSHeader(bytes: bytes + offset),
+                   let sbrFrames = probeFrames(in: bytes, count: buffer.count, from: offset, header: header)
+                {
+                    return (offset, header, sbrFrames)
+                }
+                offset += 1 + as_mp3_find_sync(bytes + offset + 1, buffer.count - offset - 1)
+            }
+            return nil
+        }
+        guard let (offset, header, sbrFrames) = probe else {
+            if pendingBytes.count > maxProbeSize {
+                let dropped = pendingBytes.count - maxProbeSize / 2
+                pendingBytes.removeFirst(dropped)
+                pendingOffset += UInt64(dropped)
+            }
+            return false
+        }
+        streamHeader = header
+        discoverFormat(header: header, hasSBR: sbrFrames * 2 >= probeFrameCount, dataOffset: pendingOffset + UInt64(offset))
+        return true
+    }
+
+    /// Checks the frames following each other from the given offset
+    ///
+    /// - Returns: The number of probed frames carrying SBR, or `nil` when `probeFrameCount` consecutive frames are not available
+    private func probeFrames(in bytes: UnsafePointer<UInt8>, count: Int, from start: Int, header first: ADTSHeader) -> Int? {
+        guard case let .started(sbrFrames) = streamChange(in: bytes, count: count, from: start, header: first) else {
+            return nil
+        }
+        return sbrFrames
+    }
+
+    private enum StreamChange {
+        /// The frames don't follow each other
+        case none
+        /// More bytes are needed to check `probeFrameCount` frames
+        case pending
+        /// `probeFrameCount` frames follow each other, some of them carrying SBR
+        case started(sbrFrames: Int)
+    }
+
+    /// Checks whether `probeFrameCount` frames of the stream of the given header follow each other from the given offset
+    private func streamChange(in bytes: UnsafePointer<UInt8>, count: Int, from start: Int, header first: ADTSHeader) -> StreamChange {
+        var offset = start
+        var sbrFrames = 0
+        for _ in 0 ..< probeFrameCount {
+            guard offset + ADTSHeader.minimumSize <= count else { return .pending }
+            guard let header = ADTSHeader(bytes: bytes + offset), header.isSameStream(as: first) else { return .none }
+            guard offset + header.frameLength <= count else { return .pending }
+            if header.rawDataBlockCount == 1,
+               ADTSHeader.containsSBR(in: bytes + offset + header.headerSize, count: header.frameLength - header.headerSize)
+            {
+                sbrFrames += 1
+            }
+            offset += header.frameLength
+        }
+        return .started(sbrFrames: sbrFrames)
+    }
+
+    private func changeFormat(header: ADTSHeader, hasSBR: Bool, offset: UInt64) {
+        Logger.debug("adts stream changed format at offset %d", category: .audioRendering, args: Int(offset))
+        streamHeader = header
+        syncedHeader = nil
+        delegate?.decoderBackend(self, didDiscover: .dataFormat(streamFormat(header: header, hasSBR: hasSBR),
+                                                                packetSizeUpperBound: UInt32(ADTSHeader.maxFrameLength)))
+    }
+
+    private func streamFormat(header: ADTSHeader, hasSBR: Bool) -> AudioStreamBasicDescription {
+        var format = AudioStreamBasicDescription()
+        format.mFormatID = kAudioFormatMPEG4AAC
+        format.mFormatFlags = UInt32(header.objectType)
+        format.mSampleRate = header.sampleRate
+        format.mFramesPerPacket = 1024
+        format.mChannelsPerFrame = header.channels
+        // SBR doubles the sample rate of the core, it is only used with cores up to 24kHz
+        if hasSBR, header.sampleRate <= 24000 {
+            // parametric stereo is signalled inside the SBR data and only applies to mono,
+            // a mono stream decoded as HE-AAC v2 is stereo either way
+            format.mFormatID = header.channels == 1 ? kAudioFormatMPEG4AAC_HE_V2 : kAudioFormatMPEG4AAC_HE
+            format.mFormatFlags = 0
+            format.mSampleRate = header.sampleRate * 2
+            format.mFramesPerPacket = 2048
+            format.mChannelsPerFrame = header.channels == 1 ? 2 : header.channels
+        }
+        return format
+    }
+
+    private func discoverFormat(header: ADTSHeader, hasSBR: Bool, dataOffset: UInt64) {
+        let format = streamFormat(header: header, hasSBR: hasSBR)
+        frameIndex = MPEGFrameIndex(dataOffset: dataOffset, samplesPerFrame: 1024, sampleRate: header.sampleRate)
+
+        // same byte order as the file format reported by `AudioFileStream`
+        let fileFormat = withUnsafeBytes(of: kAudioFileAAC_ADTSType) { String(decoding: $0, as: UTF8.self) }
+        delegate?.decoderBackend(self, didDiscover: .fileFormat(fileFormat))
+        delegate?.decoderBackend(self, didDiscover: .dataFormat(format, packetSizeUpperBound: UInt32(ADTSHeader.maxFrameLength)))
+        delegate?.decoderBackend(self, didDiscover: .dataOffset(dataOffset))
+        delegate?.decoderBackend(self, didDiscover: .readyToProducePackets(packetCount: 0))
+    }
+
+    func seek(toPacket packet: Int64, time _: TimeInterval) -> AudioDecoderSeekResult {
+        guard let byteOffset = frameIndex?.byteOffset(ofPacket: Int(packet)) else {
+            return .estimated
+        }
+        return AudioDecoderSeekResult(status: noErr, byteOffset: Int64(byteOffset), isEstimated: false)
+    }
+
+    func streamMagicCookie() -> Data? {
+        nil
+    }
+
+    // MARK: Decoding
+
+    func prepareDecoder(for format: AudioStreamBasicDescription, magicCookie: Data?) {
+        decoder.prepareDecoder(for: format, magicCookie: magicCookie)
+    }
+
+    func decode(_ convertInfo: inout AudioConvertInfo,
+                frameCount: inout UInt32,
+                into bufferList: UnsafeMutableAudioBufferListPointer) -> OSStatus
+    {
+        decoder.decode(&convertInfo, frameCount: &frameCount, into: bufferList)
+    }
+
+    func resetDecoder(resumingAt byteOffset: UInt64) {
+        decoder.resetDecoder(resumingAt: byteOffset)
+        pendingBytes.removeAll()
+        pendingOffset = byteOffset
+        syncedHeader = nil
+    }
+}
+
+extension ADTSDemuxerBackend: AudioDecoderBackendDelegate {
+    func decoderBackend(_: AudioDecoderBackend, didDiscover _: AudioStreamProperty) {}
+
+    func decoderBackend(_: AudioDecoderBackend, didParse _: AudioPackets) {}
+
+    func decoderBackend(_: AudioDecoderBackend, didFailWith error: AudioPlayerError) {
+        delegate?.decoderBackend(self, didFailWith: error)
+    }
+}
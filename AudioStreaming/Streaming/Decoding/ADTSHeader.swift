@@ -0,0 +1,120 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import Foundation
+
+/// The header of an ADTS frame, which wraps a raw AAC frame
+struct ADTSHeader: Equatable {
+    static let sampleRates: [Double] = [96000, 88200, 64000, 48000, 44100, 32000, 24000, 22050, 16000, 12000, 11025, 8000, 7350]
+    /// The largest frame the 13 bits frame length can describe
+    static let maxFrameLength = 8191
+    /// The bytes needed to parse a header
+    static let minimumSize = 7
+
+    /// The MPEG-4 audio object type, eg. 2 for AAC LC
+    let objectType: UInt8
+    let sampleRateIndex: UInt8
+    /// The channel configuration, zero when the channels are described in the raw data
+    let channelConfiguration: UInt8
+    let hasCRC: Bool
+    /// The length of the whole frame, including the header
+    let frameLength: Int
+    let rawDataBlockCount: Int
+
+    var sampleRate: Double {
+        ADTSHeader.sampleRates[Int(sampleRateIndex)]
+    }
+
+    var channels: UInt32 {
+        switch channelConfiguration {
+        case 0:
+            return 2
+        case 7:
+            return 8
+        default:
+            return UInt32(channelConfiguration)
+        }
+    }
+
+    var headerSize: Int {
+        hasCRC ? 9 : 7
+    }
+
+    /// Parses an ADTS header from at least `ADTSHeader.minimumSize` bytes
+    init?(bytes: UnsafePointer<UInt8>) {
+        // 12 bits sync word followed by the 2 bits layer which is always zero
+        guard bytes[0] == 0xFF, bytes[1] & 0xF6 == 0xF0 else { return nil }
+        let sampleRateIndex = (bytes[2] >> 2) & 0x0F
+        guard Int(sampleRateIndex) < ADTSHeader.sampleRates.count else { return nil }
+
+        hasCRC = bytes[1] & 0x01 == 0
+        objectType = (bytes[2] >> 6) + 1
+        self.sampleRateIndex = sampleRateIndex
+        channelConfiguration = ((bytes[2] & 0x01) << 2) | (bytes[3] >> 6)
+        frameLength = Int(bytes[3] & 0x03) << 11 | Int(bytes[4]) << 3 | Int(bytes[5]) >> 5
+        rawDataBlockCount = Int(bytes[6] & 0x03) + 1
+        guard frameLength > headerSize else { return nil }
+    }
+
+    /// `true` when both headers describe frames of the same stream
+    func isSameStream(as other: ADTSHeader) -> Bool {
+        objectType == other.objectType
+            && sampleRateIndex == other.sampleRateIndex
+            && channelConfiguration == other.channelConfiguration
+    }
+}
+
+// MARK: SBR detection
+
+extension ADTSHeader {
+    private static let fillElementId: UInt32 = 6
+    private static let endElementId: UInt32 = 7
+    private static let sbrExtensionTypes: Set<UInt32> = [13, 14]
+
+    /// Checks if a raw data block carries spectral band replication, the extension of HE-AAC.
+    ///
+    /// HE-AAC signalled implicitly looks like AAC LC in the header, its SBR data is placed in a fill element
+    /// just before the end element of the block. As the elements before it can't be skipped without decoding them,
+    /// the fill element is searched backwards from the end of the block, trying every padding and payload size
+    /// for a consistent fill element holding SBR data.
+    ///
+    /// - parameter block: The raw data block, without the ADTS header
+    /// - parameter count: The number of bytes in the block
+    static func containsSBR(in block: UnsafePointer<UInt8>, count: Int) -> Bool {
+        let totalBits = count * 8
+        for padding in 0 ..< 8 {
+            let endPosition = totalBits - padding - 3
+            guard endPosition >= 0 else { break }
+            guard bits(block, at: endPosition, count: 3) == endElementId else { continue }
+
+            // the payload size is 4 bits, or 15 followed by 8 bits holding the size minus 14
+            for payloadSize in 1 ... 269 {
+                let headerBits = payloadSize < 15 ? 7 : 15
+                let start = endPosition - payloadSize * 8 - headerBits
+                guard start >= 0 else { break }
+                guard bits(block, at: start, count: 3) == fillElementId else { continue }
+                let size = bits(block, at: start + 3, count: 4)
+                if payloadSize < 15 {
+                    guard size == UInt32(payloadSize) else { continue }
+                } else {
+                    guard size == 15, bits(block, at: start + 7, count: 8) == UInt32(payloadSize - 14) else { continue }
+                }
+                if sbrExtensionTypes.contains(bits(block, at: start + headerBits, count: 4)) {
+                    return true
+                }
+            }
+        }
+        return false
+    }
+
+    /// Reads up to 32 bits, most significant first
+    private static func bits(_ bytes: UnsafePointer<UInt8>, at position: Int, count: Int) -> UInt32 {
+        var value: UInt32 = 0
+        for bit in position ..< position + count {
+            value = value << 1 | UInt32((bytes[bit >> 3] >> (7 - UInt8(bit & 7))) & 1)
+        }
+        return value
+    }
+}
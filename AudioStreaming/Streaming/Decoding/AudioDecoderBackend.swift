@@ -0,0 +1,121 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import AudioToolbox
+import Foundation
+
+/// Selects the decoders used by the `AudioPlayer`
+public enum AudioDecoderPreference: Equatable {
+    /// Uses `AudioConverter` for every stream, streams are parsed by `AudioFileStream` except ADTS and Ogg which are demuxed natively
+    case system
+    /// Uses the portable decoders for the formats they support, MP3 for now, and the system ones for everything else.
+    /// The portable decoders don't depend on AudioToolbox, they behave the same on every platform.
+    ///
+    /// FLAC streams are always parsed and decoded by the portable FLAC decoder, regardless of the preference,
+    /// as are the Vorbis streams of Ogg files, Ogg Opus is decoded by `AudioConverter`.
+    case portable
+}
+
+/// The properties discovered by an `AudioDecoderBackend` while parsing a stream
+enum AudioStreamProperty {
+    case fileFormat(String)
+    /// The format of the audio packets along with the size of the largest packet
+    case dataFormat(AudioStreamBasicDescription, packetSizeUpperBound: UInt32)
+    case formatList([AudioFormatListItem])
+    /// The offset in bytes of the first audio packet
+    case dataOffset(UInt64)
+    case audioDataByteCount(UInt64)
+    case audioDataPacketCount(UInt64)
+    /// The average bitrate of the stream in bits per second, reported again as the estimate improves
+    case bitRate(Double)
+    /// The stream is ready to produce packets, the packet count is zero when unknown
+    case readyToProducePackets(packetCount: UInt64)
+}
+
+/// Packets parsed from a stream, the pointers are only valid for the duration of the delegate call
+struct AudioPackets {
+    let data: UnsafeRawPointer
+    let byteCount: UInt32
+    let count: UInt32
+    let descriptions: UnsafeMutablePointer<AudioStreamPacketDescription>?
+}
+
+/// The byte offset of a packet as found by an `AudioDecoderBackend`
+struct AudioDecoderSeekResult {
+    let status: OSStatus
+    /// The offset relative to the `dataOffset` of the stream
+    let byteOffset: Int64
+    /// `true` when the backend doesn't know the exact offset of the packet
+    let isEstimated: Bool
+
+    static let estimated = AudioDecoderSeekResult(status: noErr, byteOffset: 0, isEstimated: true)
+}
+
+protocol AudioDecoderBackendDelegate: AnyObject {
+    func decoderBackend(_ backend: AudioDecoderBackend, didDiscover property: AudioStreamProperty)
+    func decoderBackend(_ backend: AudioDecoderBackend, didParse packets: AudioPackets)
+    func decoderBackend(_ backend: AudioDecoderBackend, didFailWith error: AudioPlayerError)
+}
+
+/// Parses the bytes of a stream into packets and decodes them to the output format of the player.
+///
+/// Properties and packets are reported to the delegate synchronously, while parsing.
+/// Decoding follows the semantics of `AudioConverterFillComplexBuffer`, a backend consumes the packets of an
+/// `AudioConvertInfo` until either the output is full or the packets are exhausted.
+protocol AudioDecoderBackend: AnyObject {
+    var delegate: AudioDecoderBackendDelegate? { get set }
+
+    /// `true` while the stream is open for parsing
+    var isOpen: Bool { get }
+
+    /// The input format and magic cookie the decoder was prepared for, `nil` when there is no decoder
+    var decoderFormat: FastStartFormat? { get }
+
+    /// Opens the stream for parsing
+    ///
+    /// - parameter fileHint: An `AudioFileTypeID` value indicating the file type.
+    /// - Returns: An `OSStatus` value indicating if an error occurred or not.
+    func open(fileHint: AudioFileTypeID) -> OSStatus
+
+    /// Parses the given bytes, reporting any discovered properties and packets to the delegate
+    ///
+    /// - parameter data: The next bytes of the stream
+    /// - parameter discontinuous: `true` when the bytes don't follow the previously parsed ones
+    /// - Returns: An `OSStatus` value indicating if an error occurred or not.
+    func parse(data: Data, discontinuous: Bool) -> OSStatus
+
+    /// Finds the byte offset of the given packet
+    ///
+    /// - parameter packet: The packet containing the seek time
+    /// - parameter time: The seek time in seconds, a backend that knows the exact sample positions of its packets
+    ///                   can use it to start decoding at the exact sample instead of the start of the packet.
+    func seek(toPacket packet: Int64, time: TimeInterval) -> AudioDecoderSeekResult
+
+    /// Closes the stream, the decoder is kept so it can be reused by the next stream
+    func close()
+
+    /// The magic cookie of the open stream, if any
+    func streamMagicCookie() -> Data?
+
+    /// Prepares the decoder for packets of the given format, the current decoder is reused when the format is unchanged.
+    /// Failures are reported to the delegate.
+    func prepareDecoder(for format: AudioStreamBasicDescription, magicCookie: Data?)
+
+    /// Decodes packets into the given buffer list
+    ///
+    /// - parameter convertInfo: The packets to decode and the progress of decoding them
+    /// - parameter frameCount: On input the frames the buffer list can hold, on output the frames decoded
+    /// - parameter bufferList: An `UnsafeMutableAudioBufferListPointer` in the output format of the player
+    /// - Returns: `AudioConvertStatus.done` once the packets are exhausted, `AudioConvertStatus.proccessed` when the
+    ///            output is full, any other value is an error.
+    func decode(_ convertInfo: inout AudioConvertInfo,
+                frameCount: inout UInt32,
+                into bufferList: UnsafeMutableAudioBufferListPointer) -> OSStatus
+
+    /// Drops any state carried between packets, eg. after a seek
+    ///
+    /// - parameter byteOffset: The offset in the stream of the next bytes to be parsed
+    func resetDecoder(resumingAt byteOffset: UInt64)
+}
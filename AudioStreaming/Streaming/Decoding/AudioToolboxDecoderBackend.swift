@@ -0,0 +1,375 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import AVFoundation
+
+/// Parses streams with `AudioFileStream` and decodes them with `AudioConverter`
+final class AudioToolboxDecoderBackend: AudioDecoderBackend {
+    weak var delegate: AudioDecoderBackendDelegate?
+
+    private let outputFormat: AudioStreamBasicDescription
+    private let fastStartCache: FastStartCache?
+    private let converterPool: AudioConverterPool
+
+    private var audioFileStream: AudioFileStreamID?
+    private var fileHint: AudioFileTypeID?
+    private var audioConverter: AudioConverterRef?
+    private var inputFormat = AudioStreamBasicDescription()
+    /// The magic cookie set on the current `audioConverter`, if any
+    private var magicCookie: Data?
+
+    var isOpen: Bool {
+        audioFileStream != nil
+    }
+
+    var decoderFormat: FastStartFormat? {
+        guard audioConverter != nil else { return nil }
+        return FastStartFormat(streamFormat: inputFormat, magicCookie: magicCookie)
+    }
+
+    init(outputFormat: AudioStreamBasicDescription,
+         fastStartCache: FastStartCache? = nil,
+         converterPool: AudioConverterPool = AudioConverterPool())
+    {
+        self.outputFormat = outputFormat
+        self.fastStartCache = fastStartCache
+        self.converterPool = converterPool
+    }
+
+    deinit {
+        close()
+        disposeAudioConverter()
+    }
+
+    // MARK: Parsing
+
+    func open(fileHint: AudioFileTypeID) -> OSStatus {
+        self.fileHint = fileHint
+        let data = UnsafeMutableRawPointer.from(object: self)
+        return AudioFileStreamOpen(data, _propertyListenerProc, _propertyPacketsProc, fileHint, &audioFileStream)
+    }
+
+    func close() {
+        guard let fileStream = audioFileStream else { return }
+        AudioFileStreamClose(fileStream)
+        audioFileStream = nil
+    }
+
+    func parse(data: Data, discontinuous: Bool) -> OSStatus {
+        guard let stream = audioFileStream else { return 0 }
+        guard !data.isEmpty else { return 0 }
+        let flags: AudioFileStreamParseFlags = discontinuous ? .discontinuity : .init()
+        return data.withUnsafeBytes { buffer -> OSStatus in
+            AudioFileStreamParseBytes(stream, UInt32(buffer.count), buffer.baseAddress, flags)
+        }
+    }
+
+    func seek(toPacket packet: Int64, time _: TimeInterval) -> AudioDecoderSeekResult {
+        guard let stream = audioFileStream else { return .estimated }
+        var ioFlags = AudioFileStreamSeekFlags(rawValue: 0)
+        var packetsAlignedByteOffset: Int64 = 0
+        let status = AudioFileStreamSeek(stream, packet, &packetsAlignedByteOffset, &ioFlags)
+        return AudioDecoderSeekResult(status: status,
+                                      byteOffset: packetsAlignedByteOffset,
+                                      isEstimated: ioFlags.contains(.offsetIsEstimated))
+    }
+
+    /// The magic cookie is not read for ADTS and MPEG4 files
+    func streamMagicCookie() -> Data? {
+        guard let fileStream = audioFileStream else { return nil }
+        guard fileHint != kAudioFileAAC_ADTSType, fileHint != kAudioFileM4AType, fileHint != kAudioFileMPEG4Type else {
+            return nil
+        }
+        var cookieSize: UInt32 = 0
+        guard AudioFileStreamGetPropertyInfo(fileStream, kAudioFileStreamProperty_MagicCookieData, &cookieSize, nil) == noErr else {
+            return nil
+        }
+        var cookie: [UInt8] = Array(repeating: 0, count: Int(cookieSize))
+        guard AudioFileStreamGetProperty(fileStream, kAudioFileStreamProperty_MagicCookieData, &cookieSize, &cookie) == noErr else {
+            return nil
+        }
+        return Data(cookie.prefix(Int(cookieSize)))
+    }
+
+    // MARK: Decoding
+
+    func prepareDecoder(for format: AudioStreamBasicDescription, magicCookie: Data?) {
+        var inputFormat = format
+        if let converter = audioConverter {
+            if memcmp(&inputFormat, &self.inputFormat, MemoryLayout<AudioStreamBasicDescription>.size) == 0 {
+                AudioConverterReset(converter)
+                if let magicCookie = magicCookie, magicCookie != self.magicCookie {
+                    setMagicCookie(magicCookie, on: converter)
+                }
+                return
+            }
+        }
+        recycleAudioConverter()
+
+        if let converter = converterPool.take(for: AudioConverterKey(format: inputFormat, magicCookie: magicCookie)) {
+            audioConverter = converter
+            self.inputFormat = inputFormat
+            self.magicCookie = magicCookie
+            Logger.debug("Reusing pooled audio converter, hit rate %.2f",
+                         category: .audioRendering,
+                         args: converterPool.statistics.hitRate)
+            return
+        }
+
+        var outputFormat = self.outputFormat
+        if var classDesc = codecClassDescription(for: inputFormat.mFormatID) {
+            AudioConverterNewSpecific(&inputFormat, &outputFormat, 1, &classDesc, &audioConverter)
+        }
+
+        if audioConverter == nil {
+            let audioConverterStatus = AudioConverterNew(&inputFormat, &outputFormat, &audioConverter)
+            guard audioConverterStatus == noErr else {
+                let audioConverterError = AudioConverterError(osstatus: audioConverterStatus)
+                delegate?.decoderBackend(self, didFailWith: .audioSystemError(.converterError(audioConverterError)))
+                return
+            }
+        }
+        self.inputFormat = inputFormat
+        self.magicCookie = nil
+
+        if let magicCookie = magicCookie {
+            guard let converter = audioConverter else {
+                delegate?.decoderBackend(self, didFailWith: .audioSystemError(.fileStreamError(.unknownError)))
+                return
+            }
+            setMagicCookie(magicCookie, on: converter)
+        }
+    }
+
+    func decode(_ convertInfo: inout AudioConvertInfo,
+                frameCount: inout UInt32,
+                into bufferList: UnsafeMutableAudioBufferListPointer) -> OSStatus
+    {
+        guard let converter = audioConverter else {
+            return kAudioConverterErr_InvalidInputSize
+        }
+        return AudioConverterFillComplexBuffer(converter,
+                                               _converterCallback,
+                                               &convertInfo,
+                                               &frameCount,
+                                               bufferList.unsafeMutablePointer,
+                                               nil)
+    }
+
+    func resetDecoder(resumingAt _: UInt64) {
+        if let converter = audioConverter {
+            AudioConverterReset(converter)
+        }
+    }
+
+    /// Returns the codec class to be used for the given format, preferring a hardware codec.
+    /// The hardware codec scan is cached per format id when fast start is enabled.
+    private func codecClassDescription(for formatId: AudioFormatID) -> AudioClassDescription? {
+        let lookup = { () -> AudioClassDescription? in
+            var classDesc = AudioClassDescription()
+            return getHardwareCodecClassDescripition(formatId: formatId, classDesc: &classDesc) ? classDesc : nil
+        }
+        guard let fastStartCache = fastStartCache else {
+            return lookup()
+        }
+        return fastStartCache.codecClass(for: formatId, lookup: lookup)
+    }
+
+    private func setMagicCookie(_ magicCookie: Data, on converter: AudioConverterRef) {
+        let status = magicCookie.withUnsafeBytes { buffer -> OSStatus in
+            guard let baseAddress = buffer.baseAddress else { return noErr }
+            return AudioConverterSetProperty(converter, kAudioConverterDecompressionMagicCookie, UInt32(buffer.count), baseAddress)
+        }
+        guard status == noErr else {
+            delegate?.decoderBackend(self, didFailWith: .audioSystemError(.fileStreamError(.unknownError)))
+            return
+        }
+        self.magicCookie = magicCookie
+    }
+
+    /// Puts the `AudioConverter` instance, if any, back in the pool to be reused by an entry of the same format.
+    private func recycleAudioConverter() {
+        guard let converter = audioConverter else { return }
+        converterPool.recycle(converter, for: AudioConverterKey(format: inputFormat, magicCookie: magicCookie))
+        audioConverter = nil
+        magicCookie = nil
+    }
+
+    /// Disposes the `AudioConverter` instance, if any.
+    private func disposeAudioConverter() {
+        guard let converter = audioConverter else { return }
+        AudioConverterDispose(converter)
+        audioConverter = nil
+        magicCookie = nil
+    }
+
+    // MARK: AudioFileStream properties
+
+    /// Translates the properties received by the opened `AudioFileStream`
+    ///
+    /// - parameter fileStream: An instance of `AudioFileStreamID` that is used to get information from.
+    /// - parameter propertyId: A value of `AudioFileStreamPropertyID` indicating the file stream property.
+    fileprivate func propertyListenerProc(fileStream: AudioFileStreamID, propertyId: AudioFileStreamPropertyID) {
+        let property: AudioStreamProperty?
+        switch propertyId {
+        case kAudioFileStreamProperty_DataOffset:
+            var offset: UInt64 = 0
+            fileStreamGetProperty(value: &offset, fileStream: fileStream, propertyId: kAudioFileStreamProperty_DataOffset)
+            property = .dataOffset(offset)
+        case kAudioFileStreamProperty_FileFormat:
+            property = fileFormat(fileStream: fileStream).map { .fileFormat($0) }
+        case kAudioFileStreamProperty_DataFormat:
+            property = dataFormat(fileStream: fileStream)
+        case kAudioFileStreamProperty_AudioDataByteCount:
+            var audioDataByteCount: UInt64 = 0
+            fileStreamGetProperty(value: &audioDataByteCount, fileStream: fileStream, propertyId: kAudioFileStreamProperty_AudioDataByteCount)
+            property = .audioDataByteCount(audioDataByteCount)
+        case kAudioFileStreamProperty_AudioDataPacketCount:
+            var audioDataPacketCount: UInt64 = 0
+            fileStreamGetProperty(value: &audioDataPacketCount, fileStream: fileStream, propertyId: kAudioFileStreamProperty_AudioDataPacketCount)
+            property = .audioDataPacketCount(audioDataPacketCount)
+        case kAudioFileStreamProperty_ReadyToProducePackets:
+            var packetCount: UInt64 = 0
+            var packetCountSize = UInt32(MemoryLayout.size(ofValue: packetCount))
+            AudioFileStreamGetProperty(fileStream, kAudioFileStreamProperty_AudioDataPacketCount, &packetCountSize, &packetCount)
+            property = .readyToProducePackets(packetCount: packetCount)
+        case kAudioFileStreamProperty_FormatList:
+            property = formatList(fileStream: fileStream).map { .formatList($0) }
+        default:
+            property = nil
+        }
+        if let property = property {
+            delegate?.decoderBackend(self, didDiscover: property)
+        }
+    }
+
+    private func fileFormat(fileStream: AudioFileStreamID) -> String? {
+        var fileFormat: [UInt8] = Array(repeating: 0, count: 4)
+        var size = UInt32(4)
+        AudioFileStreamGetProperty(fileStream, kAudioFileStreamProperty_FileFormat, &size, &fileFormat)
+        return String(data: Data(fileFormat), encoding: .utf8)
+    }
+
+    private func dataFormat(fileStream: AudioFileStreamID) -> AudioStreamProperty {
+        var audioStreamFormat = AudioStreamBasicDescription()
+        fileStreamGetProperty(value: &audioStreamFormat, fileStream: fileStream, propertyId: kAudioFileStreamProperty_DataFormat)
+
+        var packetBufferSize: UInt32 = 0
+        var status = fileStreamGetProperty(value: &packetBufferSize,
+                                           fileStream: fileStream,
+                                           propertyId: kAudioFileStreamProperty_PacketSizeUpperBound)
+        if status != 0 || packetBufferSize == 0 {
+            status = fileStreamGetProperty(value: &packetBufferSize,
+                                           fileStream: fileStream,
+                                           propertyId: kAudioFileStreamProperty_MaximumPacketSize)
+            if status != 0 || packetBufferSize == 0 {
+                packetBufferSize = 2048 // default value
+            }
+        }
+        return .dataFormat(audioStreamFormat, packetSizeUpperBound: packetBufferSize)
+    }
+
+    private func formatList(fileStream: AudioFileStreamID) -> [AudioFormatListItem]? {
+        let info = fileStreamGetPropertyInfo(fileStream: fileStream, propertyId: kAudioFileStreamProperty_FormatList)
+        guard info.status == noErr else { return nil }
+        let count = Int(info.size) / MemoryLayout<AudioFormatListItem>.size
+        var list: [AudioFormatListItem] = Array(repeating: AudioFormatListItem(), count: count)
+        var size = info.size
+        guard AudioFileStreamGetProperty(fileStream, kAudioFileStreamProperty_FormatList, &size, &list) == noErr else {
+            return nil
+        }
+        return Array(list.prefix(Int(size) / MemoryLayout<AudioFormatListItem>.size))
+    }
+
+    fileprivate func propertyPacketsProc(inNumberBytes: UInt32,
+                                         inNumberPackets: UInt32,
+                                         inInputData: UnsafeRawPointer,
+                                         inPacketDescriptions: UnsafeMutablePointer<AudioStreamPacketDescription>?)
+    {
+        let packets = AudioPackets(data: inInputData,
+                                   byteCount: inNumberBytes,
+                                   count: inNumberPackets,
+                                   descriptions: inPacketDescriptions)
+        delegate?.decoderBackend(self, didParse: packets)
+    }
+}
+
+// MARK: - AudioFileStream proc method
+
+private func _propertyListenerProc(clientData: UnsafeMutableRawPointer,
+                                   fileStream: AudioFileStreamID,
+                                   propertyId: AudioFileStreamPropertyID,
+                                   flags _: UnsafeMutablePointer<AudioFileStreamPropertyFlags>)
+{
+    let backend = clientData.to(type: AudioToolboxDecoderBackend.self)
+    backend.propertyListenerProc(fileStream: fileStream, propertyId: propertyId)
+}
+
+private func _propertyPacketsProc(clientData: UnsafeMutableRawPointer,
+                                  inNumberBytes: UInt32,
+                                  inNumberPackets: UInt32,
+                                  inInputData: UnsafeRawPointer,
+                                  inPacketDescriptions: UnsafeMutablePointer<AudioStreamPacketDescription>?)
+{
+    let backend = clientData.to(type: AudioToolboxDecoderBackend.self)
+    backend.propertyPacketsProc(inNumberBytes: inNumberBytes,
+                                inNumberPackets: inNumberPackets,
+                                inInputData: inInputData,
+                                inPacketDescriptions: inPacketDescriptions)
+}
+
+// MARK: - AudioConverterFillComplexBuffer callback method
+
+private func _converterCallback(inAudioConverter _: AudioConverterRef,
+                                ioNumberDataPackets: UnsafeMutablePointer<UInt32>,
+                                ioData: UnsafeMutablePointer<AudioBufferList>,
+                                outDataPacketDescription: UnsafeMutablePointer<UnsafeMutablePointer<AudioStreamPacketDescription>?>?,
+                                inUserData: UnsafeMutableRawPointer?) -> OSStatus
+{
+    guard let convertInfo = inUserData?.assumingMemoryBound(to: AudioConvertInfo.self) else { return 0 }
+
+    // we need to tell the converter to stop converting after it should stop converting
+    if convertInfo.pointee.done {
+        ioNumberDataPackets.pointee = 0
+        return AudioConvertStatus.done.rawValue
+    }
+    // calculate the input buffer
+    ioData.pointee.mNumberBuffers = 1
+    ioData.pointee.mBuffers = convertInfo.pointee.audioBuffer
+
+    // output the packet descriptions
+    if outDataPacketDescription != nil {
+        outDataPacketDescription?.pointee = convertInfo.pointee.packDescription
+    }
+
+    ioNumberDataPackets.pointee = convertInfo.pointee.numberOfPackets
+    convertInfo.pointee.done = true
+
+    return AudioConvertStatus.proccessed.rawValue
+}
+
+// MARK: HardwareCodedClass method
+
+private func getHardwareCodecClassDescripition(formatId: UInt32, classDesc: UnsafeMutablePointer<AudioClassDescription>) -> Bool {
+    #if os(iOS)
+        var size: UInt32 = 0
+        let formatIdSize = UInt32(MemoryLayout.size(ofValue: formatId))
+        var id = formatId
+        if AudioFormatGetPropertyInfo(kAudioFormatProperty_Decoders, formatIdSize, &id, &size) != noErr {
+            return false
+        }
+        let count = Int(size) / MemoryLayout<AudioClassDescription>.size
+        var encoderDescriptions = Array(repeating: AudioClassDescription(), count: count)
+        if AudioFormatGetProperty(kAudioFormatProperty_Decoders, formatIdSize, &id, &size, &encoderDescriptions) != noErr {
+            return false
+        }
+
+        for item in encoderDescriptions where item.mManufacturer == kAppleHardwareAudioCodecManufacturer {
+            classDesc.pointee = item
+            return true
+        }
+    #endif
+    return false
+}
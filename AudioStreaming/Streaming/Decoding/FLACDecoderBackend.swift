@@ -0,0 +1,563 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import AudioToolbox
+import Foundation
+#if SWIFT_PACKAGE
+    import AudioStreamingFLAC
+#endif
+
+/// Parses and decodes FLAC streams with the portable decoder of `AudioStreamingFLAC`.
+///
+/// The STREAMINFO and SEEKTABLE metadata blocks are parsed up front, other metadata blocks are skipped without buffering them.
+/// FLAC frames don't carry their size, a frame ends where the next frame of the stream starts, which is the next sync code
+/// followed by a valid header numbered right after the frame, with a valid CRC-16 over the frame in between.
+/// The last frame is sized by decoding it, so it is only parsed when STREAMINFO knows the length of the stream.
+/// Every frame header carries the number of its first sample, seeking starts at the closest known frame and the samples
+/// before the seek time are dropped while decoding so playback resumes at the exact sample.
+/// Decoded frames are resampled to the output format, which must be interleaved 32 bit float stereo.
+final class FLACDecoderBackend: AudioDecoderBackend {
+    private enum ParsingStage {
+        /// Waiting for the `fLaC` signature
+        case signature
+        /// Parsing the metadata blocks
+        case metadata
+        /// Parsing the audio frames
+        case frames
+    }
+
+    private static let signature: [UInt8] = Array("fLaC".utf8)
+    private static let metadataHeaderSize = 4
+    private static let streamInfoType: UInt8 = 0
+    private static let seekTableType: UInt8 = 3
+
+    weak var delegate: AudioDecoderBackendDelegate?
+
+    private let outputFormat: AudioStreamBasicDescription
+
+    private(set) var isOpen = false
+    private var stage = ParsingStage.signature
+    /// Bytes received but not yet parsed
+    private var pendingBytes: [UInt8] = []
+    /// The offset in the stream of the first pending byte
+    private var pendingOffset: UInt64 = 0
+    /// The bytes of a metadata block left to skip, large blocks like pictures are skipped as they arrive
+    private var metadataBytesToSkip = 0
+    /// `true` once the last metadata block is reached
+    private var isLastMetadataBlock = false
+
+    private var streamInfo: as_flac_stream_info?
+    private var streamInfoBytes: Data?
+    private var dataOffset: UInt64 = 0
+    /// The number of the sample following the last frame in sync, `nil` while searching for a frame
+    private var expectedSample: UInt64?
+    /// Where the search for the end of the first pending frame resumes, relative to the frame
+    private var frameEndSearchOffset = 0
+    /// Decodes the last frame of the stream to find its size, as no frame follows it
+    private var sizingDecoder: OpaquePointer?
+
+    private(set) var seekTable = SampleSeekTable()
+    private var parsedByteCount: UInt64 = 0
+    private var parsedSampleCount: UInt64 = 0
+    private var parsedFrameCount = 0
+    private let bitRateReportInterval = 64
+
+    private var decoder: OpaquePointer?
+    private var inputFormat: AudioStreamBasicDescription?
+    /// The STREAMINFO the decoder was prepared with
+    private var decoderStreamInfo: Data?
+    private var frameSamples: [Float] = []
+    private var resampler: PCMResampler?
+    /// Decoded samples in the output format not yet delivered
+    private var decodedSamples: [Float] = []
+    private var decodedOffset = 0
+    /// The sample a seek asked for, the samples before it are dropped once decoding resumes
+    private var seekTargetSample: UInt64?
+
+    var decoderFormat: FastStartFormat? {
+        guard decoder != nil, let inputFormat = inputFormat else { return nil }
+        return FastStartFormat(streamFormat: inputFormat, magicCookie: decoderStreamInfo)
+    }
+
+    init(outputFormat: AudioStreamBasicDescription) {
+        self.outputFormat = outputFormat
+    }
+
+    deinit {
+        if let decoder = decoder {
+            as_flac_decoder_destroy(decoder)
+        }
+        if let sizingDecoder = sizingDecoder {
+            as_flac_decoder_destroy(sizingDecoder)
+        }
+    }
+
+    // MARK: Parsing
+
+    func open(fileHint _: AudioFileTypeID) -> OSStatus {
+        close()
+        isOpen = true
+        return noErr
+    }
+
+    func close() {
+        isOpen = false
+        stage = .signature
+        pendingBytes.removeAll()
+        pendingOffset = 0
+        metadataBytesToSkip = 0
+        isLastMetadataBlock = false
+        streamInfo = nil
+        streamInfoBytes = nil
+        dataOffset = 0
+        expectedSample = nil
+        frameEndSearchOffset = 0
+        seekTable = SampleSeekTable()
+        parsedByteCount = 0
+        parsedSampleCount = 0
+        parsedFrameCount = 0
+        seekTargetSample = nil
+        if let sizingDecoder = sizingDecoder {
+            as_flac_decoder_destroy(sizingDecoder)
+            self.sizingDecoder = nil
+        }
+    }
+
+    func parse(data: Data, discontinuous: Bool) -> OSStatus {
+        guard isOpen, !data.isEmpty else { return noErr }
+        if discontinuous {
+            expectedSample = nil
+            frameEndSearchOffset = 0
+        }
+        pendingBytes.append(contentsOf: data)
+
+        let bytes = pendingBytes
+        var status = noErr
+        var descriptions: [AudioStreamPacketDescription] = []
+        let consumed = bytes.withUnsafeBufferPointer { buffer -> Int in
+            guard let baseAddress = buffer.baseAddress else { return 0 }
+            var consumed = 0
+            if stage != .frames {
+                let result = parseMetadata(in: baseAddress, count: buffer.count)
+                status = result.status
+                consumed = result.consumed
+                guard status == noErr, stage == .frames else { return consumed }
+            }
+            consumed = scanFrames(in: baseAddress, count: buffer.count, from: consumed, descriptions: &descriptions)
+            if let last = descriptions.last {
+                descriptions.withUnsafeMutableBufferPointer { descriptionsBuffer in
+                    let packets = AudioPackets(data: UnsafeRawPointer(baseAddress),
+                                               byteCount: UInt32(last.mStartOffset) + last.mDataByteSize,
+                                               count: UInt32(descriptionsBuffer.count),
+                                               descriptions: descriptionsBuffer.baseAddress)
+                    delegate?.decoderBackend(self, didParse: packets)
+                }
+            }
+            return consumed
+        }
+        guard isOpen else { return noErr }
+        pendingBytes.removeFirst(min(consumed, pendingBytes.count))
+        pendingOffset += UInt64(consumed)
+        return status
+    }
+
+    /// Parses the signature and the metadata blocks, reporting the format of the stream once the last block is parsed
+    ///
+    /// - Returns: The number of bytes parsed or skipped, along with the status of parsing
+    private func parseMetadata(in bytes: UnsafePointer<UInt8>, count: Int) -> (consumed: Int, status: OSStatus) {
+        var offset = 0
+        if stage == .signature {
+            guard count >= FLACDecoderBackend.signature.count else { return (0, noErr) }
+            guard (0 ..< FLACDecoderBackend.signature.count).allSatisfy({ bytes[$0] == FLACDecoderBackend.signature[$0] }) else {
+                return (0, kAudioFileStreamError_InvalidFile)
+            }
+            offset = FLACDecoderBackend.signature.count
+            stage = .metadata
+        }
+
+        while stage == .metadata {
+            if metadataBytesToSkip > 0 {
+                let skipped = min(metadataBytesToSkip, count - offset)
+                metadataBytesToSkip -= skipped
+                offset += skipped
+                guard metadataBytesToSkip == 0 else { break }
+            }
+            if isLastMetadataBlock {
+                guard let streamInfo = streamInfo else {
+                    return (offset, kAudioFileStreamError_InvalidFile)
+                }
+                dataOffset = pendingOffset + UInt64(offset)
+                stage = .frames
+                discoverFormat(streamInfo: streamInfo)
+                break
+            }
+
+            guard offset + FLACDecoderBackend.metadataHeaderSize <= count else { break }
+            let type = bytes[offset] & 0x7F
+            let size = Int(bytes[offset + 1]) << 16 | Int(bytes[offset + 2]) << 8 | Int(bytes[offset + 3])
+            let body = offset + FLACDecoderBackend.metadataHeaderSize
+            if type == FLACDecoderBackend.streamInfoType || type == FLACDecoderBackend.seekTableType {
+                // the blocks that are parsed are small, wait for the whole block
+                guard body + size <= count else { break }
+                if type == FLACDecoderBackend.streamInfoType {
+                    var info = as_flac_stream_info()
+                    guard size >= Int(AS_FLAC_STREAM_INFO_SIZE), as_flac_parse_stream_info(bytes + body, &info) else {
+                        return (offset, kAudioFileStreamError_UnsupportedDataFormat)
+                    }
+                    streamInfo = info
+                    streamInfoBytes = Data(bytes: bytes + body, count: Int(AS_FLAC_STREAM_INFO_SIZE))
+                } else {
+                    seekTable.addPoints(fromSeekTable: bytes + body, count: size)
+                }
+            } else {
+                metadataBytesToSkip = size
+            }
+            isLastMetadataBlock = bytes[offset] & 0x80 != 0
+            offset = type == FLACDecoderBackend.streamInfoType || type == FLACDecoderBackend.seekTableType ? body + size : body
+        }
+        return (offset, noErr)
+    }
+
+    /// Reports the properties of the stream from its STREAMINFO
+    private func discoverFormat(streamInfo: as_flac_stream_info) {
+        var format = AudioStreamBasicDescription()
+        format.mSampleRate = Float64(streamInfo.sample_rate)
+        format.mFormatID = kAudioFormatFLAC
+        format.mFormatFlags = FLACDecoderBackend.formatFlags(bitsPerSample: streamInfo.bits_per_sample)
+        format.mFramesPerPacket = streamInfo.max_block_size
+        format.mChannelsPerFrame = UInt32(streamInfo.channels)
+
+        // same byte order as the file format reported by `AudioFileStream`
+        let fileFormat = withUnsafeBytes(of: kAudioFileFLACType) { String(decoding: $0, as: UTF8.self) }
+        delegate?.decoderBackend(self, didDiscover: .fileFormat(fileFormat))
+        delegate?.decoderBackend(self, didDiscover: .dataFormat(format, packetSizeUpperBound: maximumFrameSize(of: streamInfo)))
+        delegate?.decoderBackend(self, didDiscover: .dataOffset(dataOffset))
+        var packetCount: UInt64 = 0
+        if streamInfo.total_samples > 0, streamInfo.min_block_size == streamInfo.max_block_size {
+            let blockSize = UInt64(streamInfo.max_block_size)
+            packetCount = (streamInfo.total_samples + blockSize - 1) / blockSize
+            delegate?.decoderBackend(self, didDiscover: .audioDataPacketCount(packetCount))
+        }
+        delegate?.decoderBackend(self, didDiscover: .readyToProducePackets(packetCount: packetCount))
+    }
+
+    /// The largest frame of the stream, estimated from the block size when STREAMINFO doesn't know it
+    private func maximumFrameSize(of streamInfo: as_flac_stream_info) -> UInt32 {
+        if streamInfo.max_frame_size > 0 {
+            return streamInfo.max_frame_size
+        }
+        // a verbatim frame, with room for the side channel bit and the headers of the frame and its subframes
+        let bits = UInt32(streamInfo.max_block_size) * UInt32(streamInfo.channels) * (UInt32(streamInfo.bits_per_sample) + 1)
+        return bits / 8 + UInt32(AS_FLAC_MAX_FRAME_HEADER_SIZE) + UInt32(streamInfo.channels) * 4 + 2
+    }
+
+    static func formatFlags(bitsPerSample: UInt8) -> AudioFormatFlags {
+        switch bitsPerSample {
+        case ...16:
+            return kAppleLosslessFormatFlag_16BitSourceData
+        case ...20:
+            return kAppleLosslessFormatFlag_20BitSourceData
+        case ...24:
+            return kAppleLosslessFormatFlag_24BitSourceData
+        default:
+            return kAppleLosslessFormatFlag_32BitSourceData
+        }
+    }
+
+    /// Finds the complete frames in the given bytes, starting at `start`
+    ///
+    /// - Returns: The offset of the first byte that was neither parsed into a frame nor skipped while searching for one.
+    private func scanFrames(in bytes: UnsafePointer<UInt8>,
+                            count: Int,
+                            from start: Int,
+                            descriptions: inout [AudioStreamPacketDescription]) -> Int
+    {
+        guard let streamInfo = streamInfo else { return start }
+        var info = streamInfo
+        let maximumFrameSize = Int(self.maximumFrameSize(of: streamInfo))
+        let headerSize = Int(AS_FLAC_MAX_FRAME_HEADER_SIZE)
+        var offset = start
+        while offset < count {
+            var header = as_flac_frame_header()
+            guard as_flac_parse_frame_header(bytes + offset, count - offset, &info, &header),
+                  expectedSample == nil || header.first_sample == expectedSample
+            else {
+                if count - offset < headerSize, bytes[offset] == 0xFF {
+                    // the header may still be incomplete
+                    break
+                }
+                offset = resync(in: bytes, count: count, after: offset)
+                continue
+            }
+
+            let nextSample = header.first_sample + UInt64(header.block_size)
+            let frameSize: Int
+            if info.total_samples > 0, nextSample >= info.total_samples {
+                guard let size = lastFrameSize(bytes + offset, count: count - offset, info: &info) else { break }
+                frameSize = size
+            } else {
+                guard let size = frameSize(bytes + offset,
+                                           count: count - offset,
+                                           nextSample: nextSample,
+                                           maximumSize: maximumFrameSize,
+                                           info: &info)
+                else { break }
+                frameSize = size
+            }
+            guard frameSize > 0 else {
+                offset = resync(in: bytes, count: count, after: offset)
+                continue
+            }
+
+            expectedSample = nextSample
+            frameEndSearchOffset = 0
+            descriptions.append(AudioStreamPacketDescription(mStartOffset: Int64(offset),
+                                                             mVariableFramesInPacket: 0,
+                                                             mDataByteSize: UInt32(frameSize)))
+            indexFrame(header: header, offset: pendingOffset + UInt64(offset), size: frameSize)
+            offset += frameSize
+        }
+        return offset
+    }
+
+    /// Finds the end of a frame, which is the start of the frame following it
+    ///
+    /// - Returns: The size of the frame, zero when it is not a frame of the stream, or `nil` when more bytes are needed
+    private func frameSize(_ frame: UnsafePointer<UInt8>,
+                           count: Int,
+                           nextSample: UInt64,
+                           maximumSize: Int,
+                           info: inout as_flac_stream_info) -> Int?
+    {
+        let headerSize = Int(AS_FLAC_MAX_FRAME_HEADER_SIZE)
+        var candidate = max(frameEndSearchOffset, Int(info.min_frame_size), 1)
+        while candidate < count {
+            candidate += as_flac_find_sync(frame + candidate, count - candidate)
+            guard candidate < count else { break }
+            guard candidate <= maximumSize else { return 0 }
+            guard candidate + headerSize <= count else {
+                frameEndSearchOffset = candidate
+                return nil
+            }
+            var next = as_flac_frame_header()
+            if as_flac_parse_frame_header(frame + candidate, count - candidate, &info, &next),
+               next.first_sample == nextSample,
+               as_flac_check_frame_crc(frame, candidate)
+            {
+                return candidate
+            }
+            candidate += 1
+        }
+        // a trailing 0xFF may start the next sync code
+        frameEndSearchOffset = max(count - 1, 1)
+        return count - 1 > maximumSize ? 0 : nil
+    }
+
+    /// The size of the last frame of the stream, found by decoding it
+    ///
+    /// - Returns: The size of the frame, zero when it is not a frame of the stream, or `nil` when more bytes are needed
+    private func lastFrameSize(_ frame: UnsafePointer<UInt8>, count: Int, info: inout as_flac_stream_info) -> Int? {
+        if sizingDecoder == nil {
+            sizingDecoder = as_flac_decoder_create(&info)
+        }
+        guard let sizingDecoder = sizingDecoder else { return 0 }
+        prepareFrameSamples(for: info)
+        var size = 0
+        let result = frameSamples.withUnsafeMutableBufferPointer { buffer in
+            as_flac_decode_frame(sizingDecoder, frame, count, buffer.baseAddress, nil, &size)
+        }
+        if result > 0 {
+            return size
+        }
+        return result == 0 ? nil : 0
+    }
+
+    /// Drops the sync and finds the next sync code after the given offset
+    ///
+    /// - Returns: The offset of the next sync code, a trailing `0xFF` is kept as it may start a sync code
+    private func resync(in bytes: UnsafePointer<UInt8>, count: Int, after offset: Int) -> Int {
+        if expectedSample != nil {
+            Logger.debug("flac stream lost sync at offset %d", category: .audioRendering, args: Int(pendingOffset) + offset)
+            expectedSample = nil
+        }
+        frameEndSearchOffset = 0
+        let start = offset + 1
+        let next = start + as_flac_find_sync(bytes + start, count - start)
+        if next == count, count > start, bytes[count - 1] == 0xFF {
+            return count - 1
+        }
+        return next
+    }
+
+    /// Adds the frame to the seek table, reporting the average bitrate of the parsed frames every `bitRateReportInterval` frames
+    private func indexFrame(header: as_flac_frame_header, offset: UInt64, size: Int) {
+        seekTable.insert(SampleSeekTable.Point(sample: header.first_sample, offset: offset - dataOffset))
+        parsedByteCount += UInt64(size)
+        parsedSampleCount += UInt64(header.block_size)
+        parsedFrameCount += 1
+        guard parsedFrameCount % bitRateReportInterval == 0, let streamInfo = streamInfo else { return }
+        let duration = Double(parsedSampleCount) / Double(streamInfo.sample_rate)
+        delegate?.decoderBackend(self, didDiscover: .bitRate(Double(parsedByteCount) * 8 / duration))
+    }
+
+    func seek(toPacket _: Int64, time: TimeInterval) -> AudioDecoderSeekResult {
+        guard let streamInfo = streamInfo else { return .estimated }
+        let targetSample = UInt64(max(time, 0) * Double(streamInfo.sample_rate))
+        seekTargetSample = targetSample
+        guard let point = seekTable.point(atOrBefore: targetSample) else {
+            return .estimated
+        }
+        return AudioDecoderSeekResult(status: noErr, byteOffset: Int64(point.offset), isEstimated: false)
+    }
+
+    /// The body of the STREAMINFO metadata block
+    func streamMagicCookie() -> Data? {
+        streamInfoBytes
+    }
+
+    // MARK: Decoding
+
+    func prepareDecoder(for format: AudioStreamBasicDescription, magicCookie: Data?) {
+        var info = as_flac_stream_info()
+        if let magicCookie = magicCookie, magicCookie.count >= Int(AS_FLAC_STREAM_INFO_SIZE) {
+            _ = magicCookie.withUnsafeBytes { buffer in
+                as_flac_parse_stream_info(buffer.bindMemory(to: UInt8.self).baseAddress!, &info)
+            }
+        } else {
+            info.min_block_size = 16
+            info.max_block_size = format.mFramesPerPacket
+            info.sample_rate = UInt32(format.mSampleRate)
+            info.channels = UInt8(format.mChannelsPerFrame)
+            info.bits_per_sample = FLACDecoderBackend.bitsPerSample(formatFlags: format.mFormatFlags)
+        }
+        if let decoder = decoder {
+            as_flac_decoder_destroy(decoder)
+        }
+        decoder = as_flac_decoder_create(&info)
+        guard decoder != nil else {
+            delegate?.decoderBackend(self, didFailWith: .codecError)
+            return
+        }
+        inputFormat = format
+        decoderStreamInfo = magicCookie
+        prepareFrameSamples(for: info)
+        resampler = PCMResampler(inputSampleRate: format.mSampleRate, outputSampleRate: outputFormat.mSampleRate)
+        decodedSamples.removeAll(keepingCapacity: true)
+        decodedOffset = 0
+    }
+
+    static func bitsPerSample(formatFlags: AudioFormatFlags) -> UInt8 {
+        switch formatFlags {
+        case kAppleLosslessFormatFlag_20BitSourceData:
+            return 20
+        case kAppleLosslessFormatFlag_24BitSourceData:
+            return 24
+        case kAppleLosslessFormatFlag_32BitSourceData:
+            return 32
+        default:
+            return 16
+        }
+    }
+
+    private func prepareFrameSamples(for info: as_flac_stream_info) {
+        let count = Int(info.max_block_size) * Int(info.channels)
+        if frameSamples.count < count {
+            frameSamples = [Float](repeating: 0, count: count)
+        }
+    }
+
+    func decode(_ convertInfo: inout AudioConvertInfo,
+                frameCount: inout UInt32,
+                into bufferList: UnsafeMutableAudioBufferListPointer) -> OSStatus
+    {
+        guard let decoder = decoder, let data = bufferList[0].mData else {
+            return kAudio_ParamError
+        }
+        let output = data.assumingMemoryBound(to: Float.self)
+        let channels = Int(outputFormat.mChannelsPerFrame)
+        let capacity = Int(frameCount)
+        var written = 0
+
+        while written < capacity {
+            let available = (decodedSamples.count - decodedOffset) / channels
+            if available > 0 {
+                let frames = min(available, capacity - written)
+                decodedSamples.withUnsafeBufferPointer { samples in
+                    guard let source = samples.baseAddress else { return }
+                    (output + written * channels).assign(from: source + decodedOffset, count: frames * channels)
+                }
+                decodedOffset += frames * channels
+                written += frames
+                continue
+            }
+            decodedSamples.removeAll(keepingCapacity: true)
+            decodedOffset = 0
+            guard decodeNextPacket(&convertInfo, decoder: decoder) else {
+                frameCount = UInt32(written)
+                return AudioConvertStatus.done.rawValue
+            }
+        }
+        frameCount = UInt32(written)
+        return AudioConvertStatus.proccessed.rawValue
+    }
+
+    /// Decodes the next packet of the `AudioConvertInfo` into `decodedSamples`, dropping the samples before a seek target
+    ///
+    /// - Returns: `false` once every packet has been decoded
+    private func decodeNextPacket(_ convertInfo: inout AudioConvertInfo, decoder: OpaquePointer) -> Bool {
+        guard !convertInfo.done,
+              convertInfo.consumedPackets < convertInfo.numberOfPackets,
+              let data = convertInfo.audioBuffer.mData
+        else {
+            convertInfo.done = true
+            return false
+        }
+        let description = convertInfo.packDescription?[Int(convertInfo.consumedPackets)]
+            ?? AudioStreamPacketDescription(mStartOffset: 0,
+                                            mVariableFramesInPacket: 0,
+                                            mDataByteSize: convertInfo.audioBuffer.mDataByteSize)
+        convertInfo.consumedPackets += 1
+
+        let frame = data.advanced(by: Int(description.mStartOffset)).assumingMemoryBound(to: UInt8.self)
+        var header = as_flac_frame_header()
+        let samples = frameSamples.withUnsafeMutableBufferPointer { buffer in
+            as_flac_decode_frame(decoder, frame, Int(description.mDataByteSize), buffer.baseAddress, &header, nil)
+        }
+        guard samples > 0 else {
+            Logger.debug("skipping an invalid flac frame", category: .audioRendering)
+            return true
+        }
+
+        var skippedFrames = 0
+        if let target = seekTargetSample {
+            let nextSample = header.first_sample + UInt64(samples)
+            guard nextSample > target else { return true }
+            if target > header.first_sample {
+                skippedFrames = Int(target - header.first_sample)
+            }
+            seekTargetSample = nil
+        }
+        let channels = Int(header.channels)
+        frameSamples.withUnsafeBufferPointer { buffer in
+            guard let baseAddress = buffer.baseAddress else { return }
+            resampler?.process(input: baseAddress + skippedFrames * channels,
+                               frameCount: Int(samples) - skippedFrames,
+                               channels: channels,
+                               output: &decodedSamples)
+        }
+        return true
+    }
+
+    /// Keeps the seek target, the frames parsed after the reset are decoded from the frame preceding it
+    func resetDecoder(resumingAt byteOffset: UInt64) {
+        resampler?.reset()
+        decodedSamples.removeAll(keepingCapacity: true)
+        decodedOffset = 0
+        pendingBytes.removeAll()
+        pendingOffset = byteOffset
+        expectedSample = nil
+        frameEndSearchOffset = 0
+    }
+}
@@ -0,0 +1,368 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import AudioToolbox
+import Foundation
+#if SWIFT_PACKAGE
+    import AudioStreamingMP3
+#endif
+
+/// Parses and decodes MPEG Layer III streams with the portable decoder of `AudioStreamingMP3`.
+///
+/// Frames are found by their sync word, a frame is only trusted when the header that follows it belongs to the same stream.
+/// Once the sync is lost, eg. by a reconnect at an arbitrary offset, the parser searches for the next sync word and only
+/// accepts headers matching the version, sample rate and channels of the stream.
+/// The parsed frames are indexed, the index provides exact seek offsets and the average bitrate of the stream.
+/// Decoded frames are resampled to the output format, which must be interleaved 32 bit float stereo.
+final class MP3DecoderBackend: AudioDecoderBackend {
+    weak var delegate: AudioDecoderBackendDelegate?
+
+    private let outputFormat: AudioStreamBasicDescription
+
+    private(set) var isOpen = false
+    /// Bytes received but not yet parsed into frames
+    private var pendingBytes: [UInt8] = []
+    /// The offset in the stream of the first pending byte
+    private var pendingOffset: UInt64 = 0
+    /// The header of the last frame in sync, `nil` while searching for a frame
+    private var syncedHeader: as_mp3_frame_header?
+    /// The header of the first frame, frames found after losing sync must match it
+    private var streamHeader: as_mp3_frame_header?
+    private var discoveredFormat = false
+    /// `true` when the stream reported its bitrate in a Xing or Info frame
+    private var hasReportedBitRate = false
+    private let bitRateReportInterval = 64
+
+    private(set) var frameIndex: MPEGFrameIndex?
+
+    private var decoder: OpaquePointer?
+    private var inputFormat: AudioStreamBasicDescription?
+    private var frameSamples = [Float](repeating: 0, count: Int(AS_MP3_MAX_SAMPLES_PER_FRAME) * 2)
+    private var resampler: PCMResampler?
+    /// Decoded samples in the output format not yet delivered
+    private var decodedSamples: [Float] = []
+    private var decodedOffset = 0
+
+    var decoderFormat: FastStartFormat? {
+        guard decoder != nil, let inputFormat = inputFormat else { return nil }
+        return FastStartFormat(streamFormat: inputFormat, magicCookie: nil)
+    }
+
+    init(outputFormat: AudioStreamBasicDescription) {
+        self.outputFormat = outputFormat
+    }
+
+    deinit {
+        if let decoder = decoder {
+            as_mp3_decoder_destroy(decoder)
+        }
+    }
+
+    // MARK: Parsing
+
+    func open(fileHint _: AudioFileTypeID) -> OSStatus {
+        close()
+        isOpen = true
+        return noErr
+    }
+
+    func close() {
+        isOpen = false
+        pendingBytes.removeAll()
+        pendingOffset = 0
+        syncedHeader = nil
+        streamHeader = nil
+        discoveredFormat = false
+        hasReportedBitRate = false
+        frameIndex = nil
+    }
+
+    func parse(data: Data, discontinuous: Bool) -> OSStatus {
+        guard isOpen, !data.isEmpty else { return noErr }
+        if discontinuous {
+            syncedHeader = nil
+        }
+        pendingBytes.append(contentsOf: data)
+
+        let bytes = pendingBytes
+        var descriptions: [AudioStreamPacketDescription] = []
+        let consumed = bytes.withUnsafeBufferPointer { buffer -> Int in
+            guard let baseAddress = buffer.baseAddress else { return 0 }
+            let consumed = scanFrames(in: baseAddress, count: buffer.count, descriptions: &descriptions)
+            if let last = descriptions.last {
+                descriptions.withUnsafeMutableBufferPointer { descriptionsBuffer in
+                    let packets = AudioPackets(data: UnsafeRawPointer(baseAddress),
+                                               byteCount: UInt32(last.mStartOffset) + last.mDataByteSize,
+                                               count: UInt32(descriptionsBuffer.count),
+                                               descriptions: descriptionsBuffer.baseAddress)
+                    delegate?.decoderBackend(self, didParse: packets)
+                }
+            }
+            return consumed
+        }
+        guard isOpen else { return noErr }
+        pendingBytes.removeFirst(min(consumed, pendingBytes.count))
+        pendingOffset += UInt64(consumed)
+        return noErr
+    }
+
+    /// Finds the complete frames in the given bytes
+    ///
+    /// - Returns: The number of bytes that were either parsed into frames or skipped while searching for one.
+    private func scanFrames(in bytes: UnsafePointer<UInt8>, count: Int, descriptions: inout [AudioStreamPacketDescription]) -> Int {
+        var offset = 0
+        while offset + 4 <= count {
+            var header = as_mp3_frame_header()
+            guard as_mp3_parse_header(bytes + offset, &header), belongsToStream(header) else {
+                offset = resync(in: bytes, count: count, after: offset)
+                continue
+            }
+            let frameSize = Int(header.frame_size)
+            let nextOffset = offset + frameSize
+            if nextOffset + 4 <= count {
+                guard isFollowedByFrame(bytes + nextOffset, header: header) else {
+                    offset = resync(in: bytes, count: count, after: offset)
+                    continue
+                }
+            } else if syncedHeader == nil || nextOffset > count {
+                // wait for the next header, a frame in sync is trusted without it so the last frame is not held back
+                break
+            }
+            syncedHeader = header
+
+            if !discoveredFormat {
+                discoveredFormat = true
+                streamHeader = header
+                let isInfoFrame = discoverFormat(header: header, frame: bytes + offset, frameOffset: offset)
+                if isInfoFrame {
+                    offset = nextOffset
+                    continue
+                }
+            }
+            descriptions.append(AudioStreamPacketDescription(mStartOffset: Int64(offset),
+                                                             mVariableFramesInPacket: 0,
+                                                             mDataByteSize: UInt32(frameSize)))
+            indexFrame(header: header, offset: pendingOffset + UInt64(offset))
+            offset = nextOffset
+        }
+        return offset
+    }
+
+    /// Drops the sync and finds the next sync word after the given offset
+    ///
+    /// - Returns: The offset of the next sync word, a trailing `0xFF` is kept as it may start a sync word
+    private func resync(in bytes: UnsafePointer<UInt8>, count: Int, after offset: Int) -> Int {
+        if syncedHeader != nil {
+            Logger.debug("mp3 stream lost sync at offset %d", category: .audioRendering, args: Int(pendingOffset) + offset)
+            syncedHeader = nil
+        }
+        let start = offset + 1
+        let next = start + as_mp3_find_sync(bytes + start, count - start)
+        if next == count, count > start, bytes[count - 1] == 0xFF {
+            return count - 1
+        }
+        return next
+    }
+
+    private func belongsToStream(_ header: as_mp3_frame_header) -> Bool {
+        guard let reference = syncedHeader ?? streamHeader else { return true }
+        return isSameStream(reference, header)
+    }
+
+    /// Checks the bytes following a frame, which are either the next frame of the stream or, once in sync, a tag at the end of the file
+    private func isFollowedByFrame(_ next: UnsafePointer<UInt8>, header: as_mp3_frame_header) -> Bool {
+        var nextHeader = as_mp3_frame_header()
+        if as_mp3_parse_header(next, &nextHeader) {
+            return isSameStream(header, nextHeader)
+        }
+        guard syncedHeader != nil else { return false }
+        let tag = String(decoding: UnsafeBufferPointer(start: next, count: 4), as: UTF8.self)
+        return tag.hasPrefix("TAG") || tag == "APET" || tag == "LYRI"
+    }
+
+    private func isSameStream(_ lhs: as_mp3_frame_header, _ rhs: as_mp3_frame_header) -> Bool {
+        lhs.version == rhs.version && lhs.sample_rate == rhs.sample_rate && lhs.channels == rhs.channels
+    }
+
+    /// Indexes the frame, reporting the average bitrate of the index every `bitRateReportInterval` frames
+    /// unless the stream reported it
+    private func indexFrame(header: as_mp3_frame_header, offset: UInt64) {
+        guard frameIndex?.append(offset: offset, size: header.frame_size, bitrate: header.bitrate) == true,
+              let index = frameIndex, !hasReportedBitRate, index.count % bitRateReportInterval == 0
+        else { return }
+        delegate?.decoderBackend(self, didDiscover: .bitRate(index.averageBitRate))
+    }
+
+    /// Reports the properties of the stream from its first frame
+    ///
+    /// - Returns: `true` when the frame is a Xing or Info frame, which holds no audio
+    private func discoverFormat(header: as_mp3_frame_header, frame: UnsafePointer<UInt8>, frameOffset: Int) -> Bool {
+        var format = AudioStreamBasicDescription()
+        format.mSampleRate = Float64(header.sample_rate)
+        format.mFormatID = kAudioFormatMPEGLayer3
+        format.mFramesPerPacket = UInt32(header.samples_per_frame)
+        format.mChannelsPerFrame = UInt32(header.channels)
+
+        let info = infoFrame(header: header, frame: frame)
+        let dataOffset = pendingOffset + UInt64(frameOffset) + (info != nil ? UInt64(header.frame_size) : 0)
+        frameIndex = MPEGFrameIndex(dataOffset: dataOffset,
+                                    samplesPerFrame: UInt32(header.samples_per_frame),
+                                    sampleRate: Double(header.sample_rate))
+
+        // same byte order as the file format reported by `AudioFileStream`
+        let fileFormat = withUnsafeBytes(of: kAudioFileMP3Type) { String(decoding: $0, as: UTF8.self) }
+        delegate?.decoderBackend(self, didDiscover: .fileFormat(fileFormat))
+        delegate?.decoderBackend(self, didDiscover: .dataFormat(format, packetSizeUpperBound: UInt32(AS_MP3_MAX_FRAME_SIZE)))
+        delegate?.decoderBackend(self, didDiscover: .dataOffset(dataOffset))
+        if let frames = info?.frames {
+            delegate?.decoderBackend(self, didDiscover: .audioDataPacketCount(UInt64(frames)))
+        }
+        if let byteCount = info?.bytes, byteCount > UInt32(header.frame_size) {
+            let audioByteCount = UInt64(byteCount - UInt32(header.frame_size))
+            delegate?.decoderBackend(self, didDiscover: .audioDataByteCount(audioByteCount))
+            if let frames = info?.frames, frames > 0 {
+                let duration = Double(frames) * Double(header.samples_per_frame) / Double(header.sample_rate)
+                hasReportedBitRate = true
+                delegate?.decoderBackend(self, didDiscover: .bitRate(Double(audioByteCount) * 8 / duration))
+            }
+        }
+        delegate?.decoderBackend(self, didDiscover: .readyToProducePackets(packetCount: UInt64(info?.frames ?? 0)))
+        return info != nil
+    }
+
+    /// Reads the frame and byte counts of a Xing or Info frame, as written by most encoders in the first frame
+    private func infoFrame(header: as_mp3_frame_header, frame: UnsafePointer<UInt8>) -> (frames: UInt32?, bytes: UInt32?)? {
+        let tagOffset = 4 + Int(header.side_info_size)
+        guard tagOffset + 8 <= Int(header.frame_size) else { return nil }
+        let tag = String(decoding: UnsafeBufferPointer(start: frame + tagOffset, count: 4), as: UTF8.self)
+        guard tag == "Xing" || tag == "Info" else { return nil }
+
+        func bigEndianValue(at offset: Int) -> UInt32? {
+            guard offset + 4 <= Int(header.frame_size) else { return nil }
+            return (0 ..< 4).reduce(UInt32(0)) { $0 << 8 | UInt32(frame[offset + $1]) }
+        }
+        let flags = bigEndianValue(at: tagOffset + 4) ?? 0
+        var cursor = tagOffset + 8
+        var frames: UInt32?
+        if flags & 0x1 != 0 {
+            frames = bigEndianValue(at: cursor)
+            cursor += 4
+        }
+        let bytes = flags & 0x2 != 0 ? bigEndianValue(at: cursor) : nil
+        return (frames, bytes)
+    }
+
+    func seek(toPacket packet: Int64, time _: TimeInterval) -> AudioDecoderSeekResult {
+        guard let byteOffset = frameIndex?.byteOffset(ofPacket: Int(packet)) else {
+            return .estimated
+        }
+        return AudioDecoderSeekResult(status: noErr, byteOffset: Int64(byteOffset), isEstimated: false)
+    }
+
+    func streamMagicCookie() -> Data? {
+        nil
+    }
+
+    // MARK: Decoding
+
+    func prepareDecoder(for format: AudioStreamBasicDescription, magicCookie _: Data?) {
+        if decoder == nil {
+            decoder = as_mp3_decoder_create()
+        }
+        guard let decoder = decoder else {
+            delegate?.decoderBackend(self, didFailWith: .codecError)
+            return
+        }
+        as_mp3_decoder_reset(decoder)
+        inputFormat = format
+        resampler = PCMResampler(inputSampleRate: format.mSampleRate, outputSampleRate: outputFormat.mSampleRate)
+        decodedSamples.removeAll(keepingCapacity: true)
+        decodedOffset = 0
+    }
+
+    func decode(_ convertInfo: inout AudioConvertInfo,
+                frameCount: inout UInt32,
+                into bufferList: UnsafeMutableAudioBufferListPointer) -> OSStatus
+    {
+        guard let decoder = decoder, let data = bufferList[0].mData else {
+            return kAudio_ParamError
+        }
+        let output = data.assumingMemoryBound(to: Float.self)
+        let channels = Int(outputFormat.mChannelsPerFrame)
+        let capacity = Int(frameCount)
+        var written = 0
+
+        while written < capacity {
+            let available = (decodedSamples.count - decodedOffset) / channels
+            if available > 0 {
+                let frames = min(available, capacity - written)
+                decodedSamples.withUnsafeBufferPointer { samples in
+                    guard let source = samples.baseAddress else { return }
+                    (output + written * channels).assign(from: source + decodedOffset, count: frames * channels)
+                }
+                decodedOffset += frames * channels
+                written += frames
+                continue
+            }
+            decodedSamples.removeAll(keepingCapacity: true)
+            decodedOffset = 0
+            guard decodeNextPacket(&convertInfo, decoder: decoder) else {
+                frameCount = UInt32(written)
+                return AudioConvertStatus.done.rawValue
+            }
+        }
+        frameCount = UInt32(written)
+        return AudioConvertStatus.proccessed.rawValue
+    }
+
+    /// Decodes the next packet of the `AudioConvertInfo` into `decodedSamples`
+    ///
+    /// - Returns: `false` once every packet has been decoded
+    private func decodeNextPacket(_ convertInfo: inout AudioConvertInfo, decoder: OpaquePointer) -> Bool {
+        guard !convertInfo.done,
+              convertInfo.consumedPackets < convertInfo.numberOfPackets,
+              let data = convertInfo.audioBuffer.mData
+        else {
+            convertInfo.done = true
+            return false
+        }
+        let description = convertInfo.packDescription?[Int(convertInfo.consumedPackets)]
+            ?? AudioStreamPacketDescription(mStartOffset: 0,
+                                            mVariableFramesInPacket: 0,
+                                            mDataByteSize: convertInfo.audioBuffer.mDataByteSize)
+        convertInfo.consumedPackets += 1
+
+        let frame = data.advanced(by: Int(description.mStartOffset)).assumingMemoryBound(to: UInt8.self)
+        var header = as_mp3_frame_header()
+        let samples = frameSamples.withUnsafeMutableBufferPointer { buffer in
+            as_mp3_decode_frame(decoder, frame, Int(description.mDataByteSize), buffer.baseAddress, &header)
+        }
+        guard samples > 0 else {
+            Logger.debug("skipping an invalid mp3 frame", category: .audioRendering)
+            return true
+        }
+
+        if resampler?.inputSampleRate != Double(header.sample_rate) {
+            resampler = PCMResampler(inputSampleRate: Double(header.sample_rate), outputSampleRate: outputFormat.mSampleRate)
+        }
+        frameSamples.withUnsafeBufferPointer { buffer in
+            guard let baseAddress = buffer.baseAddress else { return }
+            resampler?.process(input: baseAddress, frameCount: Int(samples), channels: Int(header.channels), output: &decodedSamples)
+        }
+        return true
+    }
+
+    func resetDecoder(resumingAt byteOffset: UInt64) {
+        if let decoder = decoder {
+            as_mp3_decoder_reset(decoder)
+        }
+        resampler?.reset()
+        decodedSamples.removeAll(keepingCapacity: true)
+        decodedOffset = 0
+        pendingBytes.removeAll()
+        pendingOffset = byteOffset
+        syncedHeader = nil
+    }
+}
@@ -0,0 +1,68 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import Foundation
+
+/// The positions of the MPEG audio frames parsed so far.
+///
+/// Only the frames following each other from the start of the audio data are indexed, so the index of a frame
+/// is its packet number. Frames parsed after a seek past the end of the index are not indexed, indexing
+/// continues once the stream reaches the end of the index again, eg. after seeking back.
+struct MPEGFrameIndex {
+    struct Frame: Equatable {
+        /// The offset of the frame in the stream
+        let offset: UInt64
+        let size: UInt16
+        /// The bitrate of the frame in kbps
+        let bitrate: UInt16
+    }
+
+    /// The offset of the first frame
+    let dataOffset: UInt64
+    let samplesPerFrame: UInt32
+    let sampleRate: Double
+
+    private(set) var frames: [Frame] = []
+    private var byteCount: UInt64 = 0
+
+    /// The offset following the last indexed frame, where the next indexed frame is expected
+    var endOffset: UInt64 {
+        dataOffset + byteCount
+    }
+
+    var count: Int {
+        frames.count
+    }
+
+    init(dataOffset: UInt64, samplesPerFrame: UInt32, sampleRate: Double) {
+        self.dataOffset = dataOffset
+        self.samplesPerFrame = samplesPerFrame
+        self.sampleRate = sampleRate
+    }
+
+    /// Indexes a frame if it follows the last indexed one
+    ///
+    /// - Returns: `true` if the frame was indexed
+    @discardableResult
+    mutating func append(offset: UInt64, size: UInt16, bitrate: UInt16) -> Bool {
+        guard offset == endOffset else { return false }
+        frames.append(Frame(offset: offset, size: size, bitrate: bitrate))
+        byteCount += UInt64(size)
+        return true
+    }
+
+    /// The offset of the given packet relative to `dataOffset`, `nil` when the packet is not indexed yet
+    func byteOffset(ofPacket packet: Int) -> UInt64? {
+        guard packet >= 0, packet < frames.count else { return nil }
+        return frames[packet].offset - dataOffset
+    }
+
+    /// The average bitrate of the indexed frames in bits per second, zero when empty
+    var averageBitRate: Double {
+        guard !frames.isEmpty, sampleRate > 0 else { return 0 }
+        let duration = Double(frames.count) * Double(samplesPerFrame) / sampleRate
+        return Double(byteCount) * 8 / duration
+    }
+}
@@ -0,0 +1,813 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import AVFoundation
+#if SWIFT_PACKAGE
+    import AudioStreamingVorbis
+#endif
+
+/// Demuxes Ogg streams and decodes their Opus or Vorbis packets.
+///
+/// Vorbis is decoded by the portable decoder of `AudioStreamingVorbis` and resampled to the output format,
+/// Opus is decoded by `AudioConverter`. Packets spanning pages are reassembled and the packets of the pages parsed from
+/// a chunk are reported together.
+///
+/// Chained streams, eg. radio starting a new logical stream for every track, are followed without reconnecting,
+/// the packets of the ending stream are reported before the decoder is prepared for the headers of the next one.
+/// Every page carries the granule position of its last packet, the number of the sample following it. The granule
+/// positions trim the pre-skip of Opus and the padding of the last page of a stream, and the pages of the first stream
+/// are indexed by them so seeking starts at the closest page before the seek time, less the preroll of the codec,
+/// and the samples before the seek time are dropped while decoding.
+final class OggDemuxerBackend: AudioDecoderBackend {
+    enum Codec {
+        case opus
+        case vorbis
+    }
+
+    /// There is no AudioToolbox format for Vorbis, which is decoded natively, `vorb`
+    static let vorbisFormatID: AudioFormatID = 0x766F_7262
+    /// Opus granule positions always count samples at 48kHz
+    static let opusSampleRate = 48000
+    /// The decoded audio Opus needs to converge after a seek, 80ms
+    private static let opusPreroll: Int64 = 3840
+    private static let opusHeadSignature: [UInt8] = Array("OpusHead".utf8)
+    private static let opusTagsSignature: [UInt8] = Array("OpusTags".utf8)
+
+    weak var delegate: AudioDecoderBackendDelegate?
+
+    private let outputFormat: AudioStreamBasicDescription
+    private let bitRateReportInterval = 64
+
+    /// Decodes Opus packets, its own stream is never opened
+    private let opusDecoder: AudioToolboxDecoderBackend
+
+    private(set) var isOpen = false
+    /// Bytes received but not yet parsed into pages
+    private var pendingBytes: [UInt8] = []
+    /// The offset in the stream of the first pending byte
+    private var pendingOffset: UInt64 = 0
+    /// `true` while the pages follow each other, a lost sync is only logged once
+    private var isSynced = false
+
+    /// The serial number of the logical stream being parsed, `nil` until the first page of a supported stream
+    private var serialNumber: UInt32?
+    /// The codec of the logical stream being parsed
+    private(set) var codec: Codec?
+    /// The header packets of the logical stream being parsed
+    private var headers: [Data] = []
+    private var headersComplete = false
+    private var nextSequenceNumber: UInt32?
+    /// The start of a packet continued on the next page
+    private var partialPacket: [UInt8] = []
+    private var opusChannels: UInt32 = 0
+    /// The samples Opus decodes before the start of the stream
+    private var preSkip: Int64 = 0
+    private var vorbisInfo = as_vorbis_info()
+    /// The block size of the previous Vorbis packet, a packet decodes the overlap of its block with the previous one
+    private var previousBlockSize = 0
+    /// The magic cookie of the logical stream being parsed
+    private var streamCookie: Data?
+
+    /// The serial number of the stream the format was discovered from, only its pages are indexed
+    private var firstSerialNumber: UInt32?
+    private var dataOffset: UInt64 = 0
+    private(set) var seekTable = SampleSeekTable()
+    private var indexedPageCount = 0
+
+    /// The granule position following the last reported packet, `nil` until the first page completing a packet
+    private var granulePosition: Int64?
+    /// The granule position playback starts at, the samples decoded before it are dropped
+    private var startGranulePosition: Int64?
+    /// The granule position a seek asked for, it becomes the start once the decoder is reset
+    private var seekGranulePosition: Int64?
+
+    /// Packets parsed but not yet reported, copied as they may span pages
+    private var packetBytes: [UInt8] = []
+    private var packetDescriptions: [AudioStreamPacketDescription] = []
+    /// The samples of the packets completed on the page being parsed
+    private var pageDuration: Int64 = 0
+    private var pagePacketCount = 0
+
+    private var inputFormat: AudioStreamBasicDescription?
+    private var magicCookie: Data?
+    /// Shared by parsing, for the block sizes of the packets, and decoding, which both happen while parsing
+    private var vorbisDecoder: OpaquePointer?
+    /// The cookie the Vorbis decoder was created from
+    private var vorbisCookie: Data?
+    private var packetSamples: [Float] = []
+    private var stereoSamples: [Float] = []
+    private var resampler: PCMResampler?
+    /// Decoded samples in the output format not yet delivered
+    private var decodedSamples: [Float] = []
+    private var decodedOffset = 0
+    /// The frames to drop from the start of the next decoded packets, in stream samples for Vorbis and output frames for Opus
+    private var leadingFramesToDrop = 0
+    /// The frames to drop from the end of the packets being decoded, in the same units as `leadingFramesToDrop`
+    private var trailingFramesToDrop = 0
+
+    var decoderFormat: FastStartFormat? {
+        guard let inputFormat = inputFormat else { return nil }
+        let isPrepared = inputFormat.mFormatID == OggDemuxerBackend.vorbisFormatID
+            ? vorbisDecoder != nil
+            : opusDecoder.decoderFormat != nil
+        return isPrepared ? FastStartFormat(streamFormat: inputFormat, magicCookie: magicCookie) : nil
+    }
+
+    init(outputFormat: AudioStreamBasicDescription,
+         fastStartCache: FastStartCache? = nil,
+         converterPool: AudioConverterPool = AudioConverterPool())
+    {
+        self.outputFormat = outputFormat
+        opusDecoder = AudioToolboxDecoderBackend(outputFormat: outputFormat,
+                                                 fastStartCache: fastStartCache,
+                                                 converterPool: converterPool)
+        opusDecoder.delegate = self
+    }
+
+    deinit {
+        if let vorbisDecoder = vorbisDecoder {
+            as_vorbis_decoder_destroy(vorbisDecoder)
+        }
+    }
+
+    // MARK: Parsing
+
+    func open(fileHint _: AudioFileTypeID) -> OSStatus {
+        close()
+        isOpen = true
+        return noErr
+    }
+
+    func close() {
+        isOpen = false
+        pendingBytes.removeAll()
+        pendingOffset = 0
+        isSynced = false
+        resetLogicalStream()
+        serialNumber = nil
+        codec = nil
+        firstSerialNumber = nil
+        dataOffset = 0
+        seekTable = SampleSeekTable()
+        indexedPageCount = 0
+        startGranulePosition = nil
+        seekGranulePosition = nil
+        packetBytes.removeAll()
+        packetDescriptions.removeAll()
+        pageDuration = 0
+        pagePacketCount = 0
+    }
+
+    func parse(data: Data, discontinuous _: Bool) -> OSStatus {
+        guard isOpen, !data.isEmpty else { return noErr }
+        // pages are numbered, a gap is found by the sequence numbers instead
+        pendingBytes.append(contentsOf: data)
+
+        let bytes = pendingBytes
+        var status = noErr
+        let consumed = bytes.withUnsafeBufferPointer { buffer -> Int in
+            guard let baseAddress = buffer.baseAddress else { return 0 }
+            let result = scanPages(in: baseAddress, count: buffer.count)
+            status = result.status
+            return result.consumed
+        }
+        guard isOpen else { return noErr }
+        flushPackets()
+        guard isOpen else { return noErr }
+        pendingBytes.removeFirst(min(consumed, pendingBytes.count))
+        pendingOffset += UInt64(consumed)
+        return status
+    }
+
+    /// Finds the complete pages with a valid checksum and parses their packets
+    ///
+    /// - Returns: The number of bytes that were either parsed into pages or skipped while searching for one,
+    ///            along with the status of parsing
+    private func scanPages(in bytes: UnsafePointer<UInt8>, count: Int) -> (consumed: Int, status: OSStatus) {
+        var offset = 0
+        while offset + OggPage.minimumHeaderSize <= count {
+            let pageBytes = bytes + offset
+            guard OggPage.hasCapturePattern(pageBytes) else {
+                offset = resync(in: bytes, count: count, after: offset)
+                continue
+            }
+            guard offset + OggPage.headerSize(of: pageBytes) <= count else { break }
+            guard let page = OggPage(bytes: pageBytes) else {
+                offset = resync(in: bytes, count: count, after: offset)
+                continue
+            }
+            guard offset + page.size <= count else { break }
+            guard OggPage.hasValidChecksum(pageBytes, size: page.size) else {
+                offset = resync(in: bytes, count: count, after: offset)
+                continue
+            }
+            isSynced = true
+            let status = process(page: page, bytes: pageBytes, streamOffset: pendingOffset + UInt64(offset))
+            guard status == noErr else { return (offset, status) }
+            guard isOpen else { break }
+            offset += page.size
+        }
+        return (offset, noErr)
+    }
+
+    /// Drops the sync and finds the next capture pattern after the given offset
+    ///
+    /// - Returns: The offset of the next capture pattern, the trailing bytes are kept as they may start one
+    private func resync(in bytes: UnsafePointer<UInt8>, count: Int, after offset: Int) -> Int {
+        if isSynced {
+            Logger.debug("ogg stream lost sync at offset %d", category: .audioRendering, args: Int(pendingOffset) + offset)
+            isSynced = false
+        }
+        var next = offset + 1
+        while next + 4 <= count {
+            if OggPage.hasCapturePattern(bytes + next) {
+                return next
+            }
+            next += 1
+        }
+        return max(offset + 1, count - 3)
+    }
+
+    private func process(page: OggPage, bytes: UnsafePointer<UInt8>, streamOffset: UInt64) -> OSStatus {
+        if page.isFirst, page.serialNumber != serialNumber {
+            if let codec = OggDemuxerBackend.codec(ofFirstPacket: bytes + page.headerSize, count: page.bodySize) {
+                beginLogicalStream(serialNumber: page.serialNumber, codec: codec)
+            } else {
+                Logger.debug("skipping an ogg stream of an unsupported codec", category: .audioRendering)
+            }
+        }
+        guard page.serialNumber == serialNumber else {
+            // the first pages of every stream of a file come first, a stream with none supported can't be played
+            let isUnsupported = firstSerialNumber == nil && serialNumber == nil && !page.isFirst
+            return isUnsupported ? kAudioFileStreamError_UnsupportedDataFormat : noErr
+        }
+
+        if let expected = nextSequenceNumber, page.sequenceNumber != expected {
+            Logger.debug("ogg stream skipped from page %d to %d",
+                         category: .audioRendering,
+                         args: Int(expected), Int(page.sequenceNumber))
+            partialPacket.removeAll(keepingCapacity: true)
+        }
+        nextSequenceNumber = page.sequenceNumber &+ 1
+        if !page.isContinued, !partialPacket.isEmpty {
+            // the packet never completed
+            partialPacket.removeAll(keepingCapacity: true)
+        }
+
+        let endOffset = streamOffset + UInt64(page.size)
+        // the page continues a packet whose start wasn't parsed, eg. after a seek
+        var skipsPacket = page.isContinued && partialPacket.isEmpty
+        var packetStart = page.headerSize
+        var position = page.headerSize
+        for segmentSize in OggPage.segmentSizes(of: bytes) {
+            position += Int(segmentSize)
+            guard segmentSize < 255 else { continue }
+            var status = noErr
+            if skipsPacket {
+                skipsPacket = false
+            } else if partialPacket.isEmpty {
+                status = handlePacket(bytes + packetStart, count: position - packetStart, endOffset: endOffset)
+            } else {
+                partialPacket.append(contentsOf: UnsafeBufferPointer(start: bytes + packetStart, count: position - packetStart))
+                let packet = partialPacket
+                partialPacket.removeAll(keepingCapacity: true)
+                status = packet.withUnsafeBufferPointer { buffer in
+                    handlePacket(buffer.baseAddress!, count: buffer.count, endOffset: endOffset)
+                }
+            }
+            guard status == noErr, isOpen else { return status }
+            packetStart = position
+        }
+        if packetStart < position, !skipsPacket {
+            partialPacket.append(contentsOf: UnsafeBufferPointer(start: bytes + packetStart, count: position - packetStart))
+        }
+        completePage(page, endOffset: endOffset)
+        return noErr
+    }
+
+    /// The codec of a logical stream from its identification header
+    static func codec(ofFirstPacket packet: UnsafePointer<UInt8>, count: Int) -> Codec? {
+        if hasSignature(opusHeadSignature, packet: packet, count: count) {
+            return .opus
+        }
+        if as_vorbis_is_header(packet, count, 1) {
+            return .vorbis
+        }
+        return nil
+    }
+
+    private static func hasSignature(_ signature: [UInt8], packet: UnsafePointer<UInt8>, count: Int) -> Bool {
+        count >= signature.count && signature.indices.allSatisfy { packet[$0] == signature[$0] }
+    }
+
+    /// Starts parsing a new logical stream, the packets of the previous one are reported first
+    private func beginLogicalStream(serialNumber: UInt32, codec: Codec) {
+        flushPackets()
+        resetLogicalStream()
+        self.serialNumber = serialNumber
+        self.codec = codec
+    }
+
+    private func resetLogicalStream() {
+        headers.removeAll()
+        headersComplete = false
+        nextSequenceNumber = nil
+        partialPacket.removeAll()
+        previousBlockSize = 0
+        granulePosition = nil
+        streamCookie = nil
+    }
+
+    private func handlePacket(_ packet: UnsafePointer<UInt8>, count: Int, endOffset: UInt64) -> OSStatus {
+        guard headersComplete else {
+            return handleHeader(packet, count: count, endOffset: endOffset)
+        }
+        appendAudioPacket(packet, count: count)
+        return noErr
+    }
+
+    // MARK: Headers
+
+    private func handleHeader(_ packet: UnsafePointer<UInt8>, count: Int, endOffset: UInt64) -> OSStatus {
+        guard let codec = codec else { return noErr }
+        let index = headers.count
+        switch codec {
+        case .opus:
+            if index == 0 {
+                // version 0.x, with mapping family 0 which is mono or stereo
+                guard count >= 19, packet[8] & 0xF0 == 0, (1 ... 2).contains(packet[9]), packet[18] == 0 else {
+                    return abandonLogicalStream()
+                }
+                opusChannels = UInt32(packet[9])
+                preSkip = Int64(packet[10]) | Int64(packet[11]) << 8
+            } else if !OggDemuxerBackend.hasSignature(OggDemuxerBackend.opusTagsSignature, packet: packet, count: count) {
+                return abandonLogicalStream()
+            }
+        case .vorbis:
+            guard as_vorbis_is_header(packet, count, UInt8(2 * index + 1)) else {
+                return abandonLogicalStream()
+            }
+            if index == 0, !as_vorbis_parse_identification(packet, count, &vorbisInfo) {
+                return abandonLogicalStream()
+            }
+        }
+        // the comments aren't needed, they may carry large pictures
+        headers.append(index == 1 ? Data() : Data(bytes: packet, count: count))
+        guard headers.count == (codec == .opus ? 2 : 3) else { return noErr }
+        return completeHeaders(endOffset: endOffset)
+    }
+
+    /// Stops parsing a logical stream whose headers are invalid or unsupported
+    ///
+    /// - Returns: An error when no stream was parsed before
+    private func abandonLogicalStream() -> OSStatus {
+        Logger.error("skipping an ogg stream with invalid or unsupported headers", category: .audioRendering)
+        resetLogicalStream()
+        serialNumber = nil
+        codec = nil
+        return firstSerialNumber == nil ? kAudioFileStreamError_UnsupportedDataFormat : noErr
+    }
+
+    /// Prepares for the audio packets of the logical stream, reporting the format of the first stream
+    /// and preparing the decoder for a chained one
+    private func completeHeaders(endOffset: UInt64) -> OSStatus {
+        guard let codec = codec else { return noErr }
+        var format = AudioStreamBasicDescription()
+        let cookie: Data
+        switch codec {
+        case .opus:
+            format.mFormatID = kAudioFormatOpus
+            format.mSampleRate = Float64(OggDemuxerBackend.opusSampleRate)
+            format.mFramesPerPacket = 960
+            format.mChannelsPerFrame = opusChannels
+            cookie = headers[0]
+        case .vorbis:
+            format.mFormatID = OggDemuxerBackend.vorbisFormatID
+            format.mSampleRate = Float64(vorbisInfo.sample_rate)
+            format.mFramesPerPacket = UInt32(vorbisInfo.block_sizes.1) / 2
+            format.mChannelsPerFrame = UInt32(vorbisInfo.channels)
+            cookie = OggDemuxerBackend.vorbisCookie(identification: headers[0], setup: headers[2])
+            guard createVorbisDecoder(cookie: cookie) else {
+                return abandonLogicalStream()
+            }
+        }
+        headersComplete = true
+        streamCookie = cookie
+        startGranulePosition = codec == .opus ? preSkip : 0
+
+        if firstSerialNumber == nil {
+            firstSerialNumber = serialNumber
+            dataOffset = endOffset
+            seekTable.insert(SampleSeekTable.Point(sample: 0, offset: 0))
+            discoverFormat(format)
+        } else {
+            Logger.debug("ogg stream chained to a new logical stream", category: .audioRendering)
+            prepareDecoder(for: format, magicCookie: cookie)
+        }
+        return noErr
+    }
+
+    private func discoverFormat(_ format: AudioStreamBasicDescription) {
+        // same byte order as the file format reported by `AudioFileStream`
+        let fileFormat = withUnsafeBytes(of: oggFileType) { String(decoding: $0, as: UTF8.self) }
+        delegate?.decoderBackend(self, didDiscover: .fileFormat(fileFormat))
+        delegate?.decoderBackend(self, didDiscover: .dataFormat(format, packetSizeUpperBound: UInt32(OggPage.maxSize)))
+        delegate?.decoderBackend(self, didDiscover: .dataOffset(dataOffset))
+        if codec == .vorbis, vorbisInfo.nominal_bitrate > 0 {
+            delegate?.decoderBackend(self, didDiscover: .bitRate(Double(vorbisInfo.nominal_bitrate)))
+        }
+        delegate?.decoderBackend(self, didDiscover: .readyToProducePackets(packetCount: 0))
+    }
+
+    /// The identification and setup headers, each preceded by its size as a 32 bit big endian value
+    static func vorbisCookie(identification: Data, setup: Data) -> Data {
+        var cookie = Data()
+        for header in [identification, setup] {
+            let size = UInt32(header.count)
+            cookie.append(contentsOf: [UInt8(size >> 24), UInt8(size >> 16 & 0xFF), UInt8(size >> 8 & 0xFF), UInt8(size & 0xFF)])
+            cookie.append(header)
+        }
+        return cookie
+    }
+
+    static func vorbisHeaders(fromCookie cookie: Data) -> (identification: Data, setup: Data)? {
+        let bytes = [UInt8](cookie)
+        var offset = 0
+        var headers: [Data] = []
+        while headers.count < 2, offset + 4 <= bytes.count {
+            let size = bytes[offset ..< offset + 4].reduce(0) { $0 << 8 | Int($1) }
+            offset += 4
+            guard offset + size <= bytes.count else { return nil }
+            headers.append(Data(bytes[offset ..< offset + size]))
+            offset += size
+        }
+        return headers.count == 2 ? (headers[0], headers[1]) : nil
+    }
+
+    // MARK: Packets
+
+    private func appendAudioPacket(_ packet: UnsafePointer<UInt8>, count: Int) {
+        guard count > 0, let codec = codec else { return }
+        let duration: Int64
+        switch codec {
+        case .opus:
+            guard let samples = OggDemuxerBackend.opusPacketDuration(packet, count: count) else { return }
+            duration = Int64(samples)
+        case .vorbis:
+            guard let decoder = vorbisDecoder else { return }
+            let blockSize = Int(as_vorbis_packet_block_size(decoder, packet, count))
+            guard blockSize > 0 else { return }
+            duration = previousBlockSize > 0 ? Int64(previousBlockSize / 4 + blockSize / 4) : 0
+            previousBlockSize = blockSize
+        }
+        packetDescriptions.append(AudioStreamPacketDescription(mStartOffset: Int64(packetBytes.count),
+                                                               mVariableFramesInPacket: 0,
+                                                               mDataByteSize: UInt32(count)))
+        packetBytes.append(contentsOf: UnsafeBufferPointer(start: packet, count: count))
+        pageDuration += duration
+        pagePacketCount += 1
+    }
+
+    /// The samples of an Opus packet at 48kHz from its TOC byte, `nil` for a malformed packet
+    static func opusPacketDuration(_ packet: UnsafePointer<UInt8>, count: Int) -> Int? {
+        guard count > 0 else { return nil }
+        let toc = packet[0]
+        let configuration = Int(toc >> 3)
+        let frameSize: Int
+        switch configuration {
+        case ..<12:
+            // SILK, 10 to 60ms
+            frameSize = [480, 960, 1920, 2880][configuration & 0x03]
+        case ..<16:
+            // hybrid, 10 or 20ms
+            frameSize = [480, 960][configuration & 0x01]
+        default:
+            // CELT, 2.5 to 20ms
+            frameSize = [120, 240, 480, 960][configuration & 0x03]
+        }
+        let frameCount: Int
+        switch toc & 0x03 {
+        case 0:
+            frameCount = 1
+        case 1, 2:
+            frameCount = 2
+        default:
+            guard count > 1 else { return nil }
+            frameCount = Int(packet[1] & 0x3F)
+        }
+        let duration = frameSize * frameCount
+        // a packet lasts at most 120ms
+        return frameCount > 0 && duration <= 5760 ? duration : nil
+    }
+
+    /// Trims the packets of the page from their granule position and indexes the page
+    private func completePage(_ page: OggPage, endOffset: UInt64) {
+        defer {
+            pageDuration = 0
+            pagePacketCount = 0
+        }
+        guard headersComplete, page.granulePosition >= 0 else { return }
+        let end = page.granulePosition
+        if let start = startGranulePosition, pagePacketCount > 0 {
+            // the first packets since the start of the stream or a seek, the samples before the start are dropped
+            let samplesBeforeStart = start - (end - pageDuration)
+            if samplesBeforeStart > 0 {
+                leadingFramesToDrop = decodedFrames(fromSamples: samplesBeforeStart)
+            }
+            startGranulePosition = nil
+        } else if let position = granulePosition, page.isLast, position + pageDuration > end {
+            // the last page of a stream ends before the end of its last packet
+            trailingFramesToDrop = decodedFrames(fromSamples: position + pageDuration - end)
+        }
+        granulePosition = end
+        if page.isLast {
+            flushPackets()
+        }
+        if page.serialNumber == firstSerialNumber {
+            indexPage(granulePosition: end, endOffset: endOffset)
+        }
+    }
+
+    /// Converts stream samples to the frames the decoder trims, output frames for Opus which is trimmed after `AudioConverter`
+    private func decodedFrames(fromSamples samples: Int64) -> Int {
+        guard inputFormat?.mFormatID == kAudioFormatOpus else { return Int(samples) }
+        return Int((Double(samples) * outputFormat.mSampleRate / Double(OggDemuxerBackend.opusSampleRate)).rounded())
+    }
+
+    /// Adds the page to the seek table, reporting the average bitrate of the stream every `bitRateReportInterval` pages
+    private func indexPage(granulePosition: Int64, endOffset: UInt64) {
+        guard endOffset > dataOffset, let codec = codec else { return }
+        seekTable.insert(SampleSeekTable.Point(sample: UInt64(granulePosition), offset: endOffset - dataOffset))
+        indexedPageCount += 1
+        guard indexedPageCount % bitRateReportInterval == 0 else { return }
+        let samples = granulePosition - (codec == .opus ? preSkip : 0)
+        guard samples > 0 else { return }
+        let sampleRate = codec == .opus ? Double(OggDemuxerBackend.opusSampleRate) : Double(vorbisInfo.sample_rate)
+        let duration = Double(samples) / sampleRate
+        delegate?.decoderBackend(self, didDiscover: .bitRate(Double(endOffset - dataOffset) * 8 / duration))
+    }
+
+    /// Reports the parsed packets
+    private func flushPackets() {
+        guard !packetDescriptions.isEmpty else { return }
+        let bytes = packetBytes
+        var descriptions = packetDescriptions
+        packetBytes.removeAll(keepingCapacity: true)
+        packetDescriptions.removeAll(keepingCapacity: true)
+        bytes.withUnsafeBytes { buffer in
+            descriptions.withUnsafeMutableBufferPointer { descriptionsBuffer in
+                let packets = AudioPackets(data: buffer.baseAddress!,
+                                           byteCount: UInt32(buffer.count),
+                                           count: UInt32(descriptionsBuffer.count),
+                                           descriptions: descriptionsBuffer.baseAddress)
+                delegate?.decoderBackend(self, didParse: packets)
+            }
+        }
+    }
+
+    /// Seeks within the first logical stream, a chained stream has no index
+    func seek(toPacket _: Int64, time: TimeInterval) -> AudioDecoderSeekResult {
+        guard headersComplete, let codec = codec, serialNumber == firstSerialNumber else { return .estimated }
+        let target: Int64
+        let preroll: Int64
+        switch codec {
+        case .opus:
+            target = Int64(max(time, 0) * Double(OggDemuxerBackend.opusSampleRate)) + preSkip
+            preroll = OggDemuxerBackend.opusPreroll
+        case .vorbis:
+            target = Int64(max(time, 0) * Double(vorbisInfo.sample_rate))
+            preroll = Int64(vorbisInfo.block_sizes.1)
+        }
+        seekGranulePosition = target
+        guard let point = seekTable.point(atOrBefore: UInt64(max(target - preroll, 0))) else {
+            return .estimated
+        }
+        return AudioDecoderSeekResult(status: noErr, byteOffset: Int64(point.offset), isEstimated: false)
+    }
+
+    /// The `OpusHead` header for Opus, the identification and setup headers for Vorbis
+    func streamMagicCookie() -> Data? {
+        streamCookie
+    }
+
+    // MARK: Decoding
+
+    func prepareDecoder(for format: AudioStreamBasicDescription, magicCookie: Data?) {
+        switch format.mFormatID {
+        case kAudioFormatOpus:
+            // the channels of a mapping family 0 stream are all `AudioConverter` needs
+            opusDecoder.prepareDecoder(for: format, magicCookie: nil)
+            guard opusDecoder.decoderFormat != nil else { return }
+        case OggDemuxerBackend.vorbisFormatID:
+            guard let magicCookie = magicCookie, createVorbisDecoder(cookie: magicCookie), let decoder = vorbisDecoder else {
+                delegate?.decoderBackend(self, didFailWith: .codecError)
+                return
+            }
+            as_vorbis_decoder_reset(decoder)
+            resampler = PCMResampler(inputSampleRate: format.mSampleRate, outputSampleRate: outputFormat.mSampleRate)
+        default:
+            delegate?.decoderBackend(self, didFailWith: .codecError)
+            return
+        }
+        inputFormat = format
+        self.magicCookie = magicCookie
+        decodedSamples.removeAll(keepingCapacity: true)
+        decodedOffset = 0
+        leadingFramesToDrop = 0
+        trailingFramesToDrop = 0
+    }
+
+    /// Creates the Vorbis decoder for the headers of the cookie, the current decoder is kept when they are unchanged
+    private func createVorbisDecoder(cookie: Data) -> Bool {
+        if vorbisDecoder != nil, vorbisCookie == cookie {
+            return true
+        }
+        guard let headers = OggDemuxerBackend.vorbisHeaders(fromCookie: cookie) else { return false }
+        let created = headers.identification.withUnsafeBytes { identification in
+            headers.setup.withUnsafeBytes { setup in
+                as_vorbis_decoder_create(identification.bindMemory(to: UInt8.self).baseAddress,
+                                         identification.count,
+                                         setup.bindMemory(to: UInt8.self).baseAddress,
+                                         setup.count)
+            }
+        }
+        guard let decoder = created else { return false }
+        if let vorbisDecoder = vorbisDecoder {
+            as_vorbis_decoder_destroy(vorbisDecoder)
+        }
+        vorbisDecoder = decoder
+        vorbisCookie = cookie
+        let info = as_vorbis_decoder_info(decoder).pointee
+        let count = Int(info.block_sizes.1) / 2 * Int(info.channels)
+        if packetSamples.count < count {
+            packetSamples = [Float](repeating: 0, count: count)
+        }
+        return true
+    }
+
+    func decode(_ convertInfo: inout AudioConvertInfo,
+                frameCount: inout UInt32,
+                into bufferList: UnsafeMutableAudioBufferListPointer) -> OSStatus
+    {
+        guard let inputFormat = inputFormat else {
+            return kAudio_ParamError
+        }
+        if inputFormat.mFormatID == kAudioFormatOpus {
+            return decodeOpus(&convertInfo, frameCount: &frameCount, into: bufferList)
+        }
+        return decodeVorbis(&convertInfo, frameCount: &frameCount, into: bufferList)
+    }
+
+    /// Decodes with `AudioConverter`, trimming its output
+    private func decodeOpus(_ convertInfo: inout AudioConvertInfo,
+                            frameCount: inout UInt32,
+                            into bufferList: UnsafeMutableAudioBufferListPointer) -> OSStatus
+    {
+        let status = opusDecoder.decode(&convertInfo, frameCount: &frameCount, into: bufferList)
+        var frames = Int(frameCount)
+        if leadingFramesToDrop > 0, frames > 0, let data = bufferList[0].mData {
+            let dropped = min(leadingFramesToDrop, frames)
+            let bytesPerFrame = Int(outputFormat.mBytesPerFrame)
+            memmove(data, data + dropped * bytesPerFrame, (frames - dropped) * bytesPerFrame)
+            frames -= dropped
+            leadingFramesToDrop -= dropped
+        }
+        if status == AudioConvertStatus.done.rawValue, trailingFramesToDrop > 0 {
+            frames -= min(trailingFramesToDrop, frames)
+            trailingFramesToDrop = 0
+        }
+        frameCount = UInt32(frames)
+        return status
+    }
+
+    private func decodeVorbis(_ convertInfo: inout AudioConvertInfo,
+                              frameCount: inout UInt32,
+                              into bufferList: UnsafeMutableAudioBufferListPointer) -> OSStatus
+    {
+        guard let decoder = vorbisDecoder, let data = bufferList[0].mData else {
+            return kAudio_ParamError
+        }
+        let output = data.assumingMemoryBound(to: Float.self)
+        let channels = Int(outputFormat.mChannelsPerFrame)
+        let capacity = Int(frameCount)
+        var written = 0
+
+        while written < capacity {
+            let available = (decodedSamples.count - decodedOffset) / channels
+            if available > 0 {
+                let frames = min(available, capacity - written)
+                decodedSamples.withUnsafeBufferPointer { samples in
+                    guard let source = samples.baseAddress else { return }
+                    (output + written * channels).assign(from: source + decodedOffset, count: frames * channels)
+                }
+                decodedOffset += frames * channels
+                written += frames
+                continue
+            }
+            decodedSamples.removeAll(keepingCapacity: true)
+            decodedOffset = 0
+            guard decodeNextVorbisPacket(&convertInfo, decoder: decoder) else {
+                frameCount = UInt32(written)
+                return AudioConvertStatus.done.rawValue
+            }
+        }
+        frameCount = UInt32(written)
+        return AudioConvertStatus.proccessed.rawValue
+    }
+
+    /// Decodes the next packet of the `AudioConvertInfo` into `decodedSamples`, dropping the trimmed samples
+    ///
+    /// - Returns: `false` once every packet has been decoded
+    private func decodeNextVorbisPacket(_ convertInfo: inout AudioConvertInfo, decoder: OpaquePointer) -> Bool {
+        guard !convertInfo.done,
+              convertInfo.consumedPackets < convertInfo.numberOfPackets,
+              let data = convertInfo.audioBuffer.mData
+        else {
+            convertInfo.done = true
+            return false
+        }
+        let description = convertInfo.packDescription?[Int(convertInfo.consumedPackets)]
+            ?? AudioStreamPacketDescription(mStartOffset: 0,
+                                            mVariableFramesInPacket: 0,
+                                            mDataByteSize: convertInfo.audioBuffer.mDataByteSize)
+        convertInfo.consumedPackets += 1
+        let isLastPacket = convertInfo.consumedPackets == convertInfo.numberOfPackets
+
+        let packet = data.advanced(by: Int(description.mStartOffset)).assumingMemoryBound(to: UInt8.self)
+        let samples = packetSamples.withUnsafeMutableBufferPointer { buffer in
+            as_vorbis_decode_packet(decoder, packet, Int(description.mDataByteSize), buffer.baseAddress)
+        }
+        guard samples >= 0 else {
+            Logger.debug("skipping an invalid vorbis packet", category: .audioRendering)
+            return true
+        }
+
+        let skippedFrames = min(leadingFramesToDrop, Int(samples))
+        leadingFramesToDrop -= skippedFrames
+        var frames = Int(samples) - skippedFrames
+        if isLastPacket, trailingFramesToDrop > 0 {
+            frames -= min(trailingFramesToDrop, frames)
+            trailingFramesToDrop = 0
+        }
+        guard frames > 0 else { return true }
+
+        let channels = Int(as_vorbis_decoder_info(decoder).pointee.channels)
+        packetSamples.withUnsafeBufferPointer { buffer in
+            guard let baseAddress = buffer.baseAddress else { return }
+            let first = baseAddress + skippedFrames * channels
+            guard channels > 2 else {
+                resampler?.process(input: first, frameCount: frames, channels: channels, output: &decodedSamples)
+                return
+            }
+            // Vorbis orders the channels front left, center, front right, except for 4 channels which are quadraphonic
+            let right = channels == 4 ? 1 : 2
+            stereoSamples.removeAll(keepingCapacity: true)
+            for frame in 0 ..< frames {
+                stereoSamples.append(first[frame * channels])
+                stereoSamples.append(first[frame * channels + right])
+            }
+            stereoSamples.withUnsafeBufferPointer { stereo in
+                resampler?.process(input: stereo.baseAddress!, frameCount: frames, channels: 2, output: &decodedSamples)
+            }
+        }
+        return true
+    }
+
+    /// Keeps the seek target, the samples decoded before it are dropped once the pages following the reset are parsed
+    func resetDecoder(resumingAt byteOffset: UInt64) {
+        opusDecoder.resetDecoder(resumingAt: byteOffset)
+        if let vorbisDecoder = vorbisDecoder {
+            as_vorbis_decoder_reset(vorbisDecoder)
+        }
+        resampler?.reset()
+        decodedSamples.removeAll(keepingCapacity: true)
+        decodedOffset = 0
+        leadingFramesToDrop = 0
+        trailingFramesToDrop = 0
+        pendingBytes.removeAll()
+        pendingOffset = byteOffset
+        isSynced = false
+        nextSequenceNumber = nil
+        partialPacket.removeAll()
+        packetBytes.removeAll(keepingCapacity: true)
+        packetDescriptions.removeAll(keepingCapacity: true)
+        pageDuration = 0
+        pagePacketCount = 0
+        previousBlockSize = 0
+        granulePosition = nil
+        startGranulePosition = seekGranulePosition
+        seekGranulePosition = nil
+    }
+}
+
+extension OggDemuxerBackend: AudioDecoderBackendDelegate {
+    func decoderBackend(_: AudioDecoderBackend, didDiscover _: AudioStreamProperty) {}
+
+    func decoderBackend(_: AudioDecoderBackend, didParse _: AudioPackets) {}
+
+    func decoderBackend(_: AudioDecoderBackend, didFailWith error: AudioPlayerError) {
+        delegate?.decoderBackend(self, didFailWith: error)
+    }
+}
@@ -0,0 +1,90 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import Foundation
+
+/// The header of an Ogg page, the unit of the container carrying Opus and Vorbis.
+///
+/// A page carries the packets of one logical stream split into segments of up to 255 bytes, described by the
+/// segment table following the header. A segment shorter than 255 bytes ends a packet, a packet whose last segment
+/// ends the page continues on the next page of the stream.
+struct OggPage: Equatable {
+    /// The bytes needed to read the size of the header
+    static let minimumHeaderSize = 27
+    /// The largest page, a segment table of 255 segments of 255 bytes
+    static let maxSize = minimumHeaderSize + 255 + 255 * 255
+
+    /// `true` when the first packet of the page continues the last packet of the previous page
+    let isContinued: Bool
+    /// `true` for the first page of a logical stream
+    let isFirst: Bool
+    /// `true` for the last page of a logical stream
+    let isLast: Bool
+    /// The position of the sample following the last packet completed on the page, `-1` when no packet ends on the page
+    let granulePosition: Int64
+    let serialNumber: UInt32
+    let sequenceNumber: UInt32
+    /// The size of the header and the segment table
+    let headerSize: Int
+    let bodySize: Int
+
+    var size: Int {
+        headerSize + bodySize
+    }
+
+    /// Checks for the `OggS` capture pattern, `OggPage.minimumHeaderSize` bytes must be available
+    static func hasCapturePattern(_ bytes: UnsafePointer<UInt8>) -> Bool {
+        bytes[0] == 0x4F && bytes[1] == 0x67 && bytes[2] == 0x67 && bytes[3] == 0x53
+    }
+
+    /// The size of the header and the segment table, `OggPage.minimumHeaderSize` bytes must be available
+    static func headerSize(of bytes: UnsafePointer<UInt8>) -> Int {
+        minimumHeaderSize + Int(bytes[26])
+    }
+
+    /// Parses a page header, the header and its segment table must be available
+    init?(bytes: UnsafePointer<UInt8>) {
+        guard OggPage.hasCapturePattern(bytes), bytes[4] == 0 else { return nil }
+        func littleEndianValue(at offset: Int, count: Int) -> UInt64 {
+            (0 ..< count).reversed().reduce(UInt64(0)) { $0 << 8 | UInt64(bytes[offset + $1]) }
+        }
+        isContinued = bytes[5] & 0x01 != 0
+        isFirst = bytes[5] & 0x02 != 0
+        isLast = bytes[5] & 0x04 != 0
+        granulePosition = Int64(bitPattern: littleEndianValue(at: 6, count: 8))
+        serialNumber = UInt32(littleEndianValue(at: 14, count: 4))
+        sequenceNumber = UInt32(littleEndianValue(at: 18, count: 4))
+        headerSize = OggPage.headerSize(of: bytes)
+        bodySize = (0 ..< Int(bytes[26])).reduce(0) { $0 + Int(bytes[OggPage.minimumHeaderSize + $1]) }
+    }
+
+    /// The sizes of the segments of the page, the header and its segment table must be available
+    static func segmentSizes(of bytes: UnsafePointer<UInt8>) -> UnsafeBufferPointer<UInt8> {
+        UnsafeBufferPointer(start: bytes + minimumHeaderSize, count: Int(bytes[26]))
+    }
+
+    // MARK: Checksum
+
+    private static let crcTable: [UInt32] = (0 ..< 256).map { index -> UInt32 in
+        var crc = UInt32(index) << 24
+        for _ in 0 ..< 8 {
+            crc = crc & 0x8000_0000 != 0 ? (crc << 1) ^ 0x04C1_1DB7 : crc << 1
+        }
+        return crc
+    }
+
+    /// Checks the CRC-32 of a whole page, computed with the checksum field of the header set to zero
+    static func hasValidChecksum(_ bytes: UnsafePointer<UInt8>, size: Int) -> Bool {
+        let checksum = UInt32(bytes[22]) | UInt32(bytes[23]) << 8 | UInt32(bytes[24]) << 16 | UInt32(bytes[25]) << 24
+        return crcTable.withUnsafeBufferPointer { table -> Bool in
+            var crc: UInt32 = 0
+            for index in 0 ..< size {
+                let byte = index >= 22 && index < 26 ? 0 : bytes[index]
+                crc = (crc << 8) ^ table[Int((crc >> 24) ^ UInt32(byte))]
+            }
+            return crc == checksum
+        }
+    }
+}
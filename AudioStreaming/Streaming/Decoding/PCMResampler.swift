@@ -0,0 +1,81 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import Foundation
+
+/// Converts interleaved 32 bit float samples of any channel count and sample rate to interleaved stereo at the output sample rate.
+///
+/// Mono is copied to both channels, streams of more than two channels keep the first two.
+/// Resampling interpolates linearly between neighbouring frames, carrying the position across calls
+/// so consecutive blocks are resampled as one continuous signal.
+struct PCMResampler {
+    let inputSampleRate: Double
+    let outputSampleRate: Double
+
+    /// The distance in input frames between two output frames
+    private let step: Double
+    /// The position of the next output frame, relative to the first frame of the next input block.
+    /// A value in `-1..<0` interpolates between the last frame of the previous block and the first of the next one.
+    private var position: Double = 0
+    private var previousFrame: (left: Float, right: Float) = (0, 0)
+
+    init(inputSampleRate: Double, outputSampleRate: Double) {
+        self.inputSampleRate = inputSampleRate
+        self.outputSampleRate = outputSampleRate
+        step = inputSampleRate / outputSampleRate
+    }
+
+    /// The maximum number of output frames produced for the given number of input frames
+    func maximumOutputFrames(for inputFrames: Int) -> Int {
+        Int((Double(inputFrames) / step).rounded(.up)) + 1
+    }
+
+    /// Resamples a block of input frames, appending the output frames to `output`
+    ///
+    /// - parameter input: Interleaved samples
+    /// - parameter frameCount: The number of frames in `input`
+    /// - parameter channels: The number of channels in `input`
+    /// - parameter output: Receives interleaved stereo samples
+    mutating func process(input: UnsafePointer<Float>, frameCount: Int, channels: Int, output: inout [Float]) {
+        guard frameCount > 0, channels > 0 else { return }
+        let rightChannel = channels > 1 ? 1 : 0
+
+        if inputSampleRate == outputSampleRate {
+            output.reserveCapacity(output.count + frameCount * 2)
+            for frame in 0 ..< frameCount {
+                output.append(input[frame * channels])
+                output.append(input[frame * channels + rightChannel])
+            }
+            return
+        }
+
+        output.reserveCapacity(output.count + maximumOutputFrames(for: frameCount) * 2)
+        let lastFrame = Double(frameCount - 1)
+        while position < lastFrame {
+            let index = Int(position.rounded(.down))
+            let fraction = Float(position - Double(index))
+            let current: (left: Float, right: Float)
+            if index < 0 {
+                current = previousFrame
+            } else {
+                current = (input[index * channels], input[index * channels + rightChannel])
+            }
+            let next = index + 1
+            let left = input[next * channels]
+            let right = input[next * channels + rightChannel]
+            output.append(current.left + (left - current.left) * fraction)
+            output.append(current.right + (right - current.right) * fraction)
+            position += step
+        }
+        position -= Double(frameCount)
+        let last = frameCount - 1
+        previousFrame = (input[last * channels], input[last * channels + rightChannel])
+    }
+
+    mutating func reset() {
+        position = 0
+        previousFrame = (0, 0)
+    }
+}
@@ -0,0 +1,79 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import Foundation
+
+/// The known sample positions of a stream whose packets carry their position, eg. FLAC frames or Ogg pages,
+/// from the seek table of the stream and from the packets parsed so far.
+///
+/// Unlike MPEG audio, a packet parsed anywhere in the stream is an exact seek point, the points are kept sorted by sample.
+struct SampleSeekTable {
+    struct Point: Equatable {
+        /// The number of the first sample decoded from the offset
+        let sample: UInt64
+        /// The offset relative to the first audio packet of the stream
+        let offset: UInt64
+    }
+
+    /// The sample number a FLAC SEEKTABLE uses for placeholder points
+    static let placeholderSample = UInt64.max
+    /// The size of a point in a FLAC SEEKTABLE metadata block
+    static let pointSize = 18
+
+    private(set) var points: [Point] = []
+
+    var count: Int {
+        points.count
+    }
+
+    /// Adds the points of a FLAC SEEKTABLE metadata block
+    ///
+    /// - parameter bytes: The body of the metadata block
+    /// - parameter count: The size of the body
+    mutating func addPoints(fromSeekTable bytes: UnsafePointer<UInt8>, count: Int) {
+        func bigEndianValue(at offset: Int) -> UInt64 {
+            (0 ..< 8).reduce(UInt64(0)) { $0 << 8 | UInt64(bytes[offset + $1]) }
+        }
+        for start in stride(from: 0, through: count - SampleSeekTable.pointSize, by: SampleSeekTable.pointSize) {
+            let sample = bigEndianValue(at: start)
+            guard sample != SampleSeekTable.placeholderSample else { continue }
+            insert(Point(sample: sample, offset: bigEndianValue(at: start + 8)))
+        }
+    }
+
+    /// Inserts a point, keeping the points sorted
+    mutating func insert(_ point: Point) {
+        // frames are mostly parsed in order, so most points are appended
+        if let last = points.last, last.sample < point.sample {
+            points.append(point)
+            return
+        }
+        let index = firstIndex(withSampleAbove: point.sample)
+        if index > 0, points[index - 1].sample == point.sample {
+            return
+        }
+        points.insert(point, at: index)
+    }
+
+    /// The last point at or before the given sample, `nil` when there is none
+    func point(atOrBefore sample: UInt64) -> Point? {
+        let index = firstIndex(withSampleAbove: sample)
+        return index > 0 ? points[index - 1] : nil
+    }
+
+    private func firstIndex(withSampleAbove sample: UInt64) -> Int {
+        var low = 0
+        var high = points.count
+        while low < high {
+            let middle = (low + high) / 2
+            if points[middle].sample <= sample {
+                low = middle + 1
+            } else {
+                high = middle
+            }
+        }
+        return low
+    }
+}
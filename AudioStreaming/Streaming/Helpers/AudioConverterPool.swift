@@ -0,0 +1,116 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import AudioToolbox
+import Foundation
+
+/// How often converters were reused from an `AudioConverterPool`
+public struct AudioConverterPoolStatistics: Equatable {
+    /// Number of times a pooled converter was reused
+    public internal(set) var hits: Int = 0
+    /// Number of times a new converter had to be created
+    public internal(set) var misses: Int = 0
+    /// Number of pooled converters disposed to make room for others
+    public internal(set) var evictions: Int = 0
+
+    /// The fraction of lookups that reused a pooled converter, `0` when there were no lookups
+    public var hitRate: Double {
+        let lookups = hits + misses
+        return lookups > 0 ? Double(hits) / Double(lookups) : 0
+    }
+}
+
+/// Identifies the converters that can be reused for a stream, by the input format and magic cookie.
+/// The output format is the same for all converters of a player.
+struct AudioConverterKey: Hashable {
+    let sampleRate: Float64
+    let formatId: AudioFormatID
+    let formatFlags: AudioFormatFlags
+    let bytesPerPacket: UInt32
+    let framesPerPacket: UInt32
+    let bytesPerFrame: UInt32
+    let channelsPerFrame: UInt32
+    let bitsPerChannel: UInt32
+    let magicCookie: Data?
+
+    init(format: AudioStreamBasicDescription, magicCookie: Data?) {
+        sampleRate = format.mSampleRate
+        formatId = format.mFormatID
+        formatFlags = format.mFormatFlags
+        bytesPerPacket = format.mBytesPerPacket
+        framesPerPacket = format.mFramesPerPacket
+        bytesPerFrame = format.mBytesPerFrame
+        channelsPerFrame = format.mChannelsPerFrame
+        bitsPerChannel = format.mBitsPerChannel
+        self.magicCookie = magicCookie
+    }
+}
+
+/// A small least recently used pool of `AudioConverterRef`.
+///
+/// Converters no longer in use are put back in the pool instead of being disposed, so switching between
+/// entries of a few different formats doesn't create a new converter on every change.
+/// A converter taken from the pool is reset before it is returned.
+final class AudioConverterPool {
+    /// The maximum number of idle converters kept
+    let capacity: Int
+
+    var statistics: AudioConverterPoolStatistics {
+        lock.around { _statistics }
+    }
+
+    private let lock = UnfairLock()
+    /// Ordered from least to most recently used
+    private var idle: [(key: AudioConverterKey, converter: AudioConverterRef)] = []
+    private var _statistics = AudioConverterPoolStatistics()
+
+    init(capacity: Int = 4) {
+        self.capacity = capacity
+    }
+
+    deinit {
+        idle.forEach { AudioConverterDispose($0.converter) }
+    }
+
+    /// Removes and returns an idle converter for the given key, after resetting it.
+    ///
+    /// - Returns: An `AudioConverterRef` or `nil` if there was none in the pool, which counts as a miss.
+    func take(for key: AudioConverterKey) -> AudioConverterRef? {
+        let converter: AudioConverterRef? = lock.around {
+            guard let index = idle.lastIndex(where: { $0.key == key }) else {
+                _statistics.misses += 1
+                return nil
+            }
+            _statistics.hits += 1
+            return idle.remove(at: index).converter
+        }
+        if let converter = converter {
+            AudioConverterReset(converter)
+        }
+        return converter
+    }
+
+    /// Puts a converter that is no longer in use back in the pool, disposing the least recently used if the pool is full.
+    func recycle(_ converter: AudioConverterRef, for key: AudioConverterKey) {
+        let evicted: [AudioConverterRef] = lock.around {
+            idle.append((key, converter))
+            guard idle.count > capacity else { return [] }
+            let overflow = idle.count - capacity
+            _statistics.evictions += overflow
+            defer { idle.removeFirst(overflow) }
+            return idle.prefix(overflow).map { $0.converter }
+        }
+        evicted.forEach { AudioConverterDispose($0) }
+    }
+
+    /// Disposes all idle converters
+    func removeAll() {
+        let converters: [AudioConverterRef] = lock.around {
+            defer { idle.removeAll() }
+            return idle.map { $0.converter }
+        }
+        converters.forEach { AudioConverterDispose($0) }
+    }
+}
@@ -6,6 +6,9 @@
 import AudioToolbox
 import Foundation
 
+/// AudioToolbox has no file type for Ogg, whose streams are demuxed natively, `OggS` is the capture pattern of its pages
+let oggFileType: AudioFileTypeID = 0x4F67_6753
+
 /// mapping from mime types to `AudioFileTypeID`
 internal let fileTypesFromMimeType: [String: AudioFileTypeID] =
     [
@@ -33,6 +36,12 @@ internal let fileTypesFromMimeType: [String: AudioFileTypeID] =
         "video/3gpp": kAudioFile3GPType,
         "audio/3gp2": kAudioFile3GP2Type,
         "video/3gp2": kAudioFile3GP2Type,
+        "audio/flac": kAudioFileFLACType,
+        "audio/x-flac": kAudioFileFLACType,
+        "application/ogg": oggFileType,
+        "audio/ogg": oggFileType,
+        "audio/opus": oggFileType,
+        "audio/vorbis": oggFileType,
     ]
 
 /// Method that converts mime type to AudioFileTypeID
@@ -57,6 +66,9 @@ internal let fileTypesFromFileExtension: [String: AudioFileTypeID] =
         "ac3": kAudioFileAC3Type,
         "3gp": kAudioFile3GPType,
         "flac": kAudioFileFLACType,
+        "ogg": oggFileType,
+        "oga": oggFileType,
+        "opus": oggFileType,
     ]
 
 func audioFileType(fileExtension: String) -> AudioFileTypeID {
@@ -8,21 +8,84 @@ import Foundation
 final class BufferContext {
     let sizeInBytes: UInt32
     let totalFrameCount: UInt32
+    /// The frames already played kept before `frameStartIndex`, so seeking back to them doesn't decode them again
+    let historyCapacity: UInt32
 
     var frameStartIndex: UInt32 = 0
     var frameUsedCount: UInt32 = 0
+    /// The frames played kept right before `frameStartIndex`, up to `historyCapacity`
+    var historyFrameCount: UInt32 = 0
+    /// Counts the moves of the read index other than playing, seeking within the buffer or resetting it
+    private(set) var readIndexMoves: UInt32 = 0
 
     var end: UInt32 {
         (frameStartIndex + frameUsedCount) % totalFrameCount
     }
 
-    init(sizeInBytes: UInt32, totalFrameCount: UInt32) {
+    /// The frames that can be queued once the history is full
+    var queueCapacity: UInt32 {
+        totalFrameCount - historyCapacity
+    }
+
+    /// The frames queued and kept as history, the rest of the buffer is free for decoding
+    var occupiedFrameCount: UInt32 {
+        frameUsedCount + historyFrameCount
+    }
+
+    /// The index of the oldest frame kept as history
+    var occupiedStartIndex: UInt32 {
+        (frameStartIndex + totalFrameCount - historyFrameCount) % totalFrameCount
+    }
+
+    init(sizeInBytes: UInt32, totalFrameCount: UInt32, historyCapacity: UInt32 = 0) {
         self.sizeInBytes = sizeInBytes
         self.totalFrameCount = totalFrameCount
+        self.historyCapacity = min(historyCapacity, totalFrameCount / 2)
+    }
+
+    /// Moves past the given frames once played, keeping them as history
+    func consume(_ frames: UInt32) {
+        frameStartIndex = (frameStartIndex + frames) % totalFrameCount
+        frameUsedCount -= frames
+        historyFrameCount = min(historyFrameCount + frames, historyCapacity)
+    }
+
+    /// Moves past the given frames once played, unless the read index moved since they were read
+    ///
+    /// - parameter moves: The `readIndexMoves` when the frames were read
+    /// - Returns: `true` if the frames were consumed, otherwise they precede the frames moved to, which are kept
+    func consume(_ frames: UInt32, readAt moves: UInt32) -> Bool {
+        guard moves == readIndexMoves else { return false }
+        consume(frames)
+        return true
+    }
+
+    /// The frames the read index can move by, back into the history or forward within the frames queued
+    ///
+    /// - parameter reservedFrames: The queued frames that must remain, the render thread may be reading them
+    func seekableFrames(reserving reservedFrames: UInt32) -> ClosedRange<Int> {
+        -Int(historyFrameCount) ... max(Int(frameUsedCount) - Int(reservedFrames), 0)
+    }
+
+    /// Moves the read index by the given frames, negative values return to frames played
+    ///
+    /// - note: The frames must be within `seekableFrames(reserving:)`
+    func moveStart(by frames: Int) {
+        readIndexMoves &+= 1
+        if frames >= 0 {
+            consume(UInt32(frames))
+        } else {
+            let count = UInt32(-frames)
+            frameStartIndex = (frameStartIndex + totalFrameCount - count) % totalFrameCount
+            frameUsedCount += count
+            historyFrameCount -= count
+        }
     }
 
     func reset() {
+        readIndexMoves &+= 1
         frameStartIndex = 0
         frameUsedCount = 0
+        historyFrameCount = 0
     }
 }
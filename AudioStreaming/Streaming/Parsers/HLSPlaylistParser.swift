@@ -0,0 +1,163 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import Foundation
+
+/// Parses master and media playlists of HTTP Live Streaming, resolving their URIs against the URL of the playlist.
+///
+/// Only the tags needed for audio playback are parsed, other tags are ignored.
+struct HLSPlaylistParser: Parser {
+    typealias Input = String
+    typealias Output = Result<HLSPlaylist, HLSError>
+
+    /// The URL of the playlist, relative URIs are resolved against it
+    let url: URL
+
+    func parse(input: String) -> Result<HLSPlaylist, HLSError> {
+        let lines = input.components(separatedBy: .newlines)
+            .map { $0.trimmingCharacters(in: .whitespaces) }
+            .filter { !$0.isEmpty }
+        guard lines.first?.hasPrefix("#EXTM3U") == true else {
+            return .failure(.invalidPlaylist)
+        }
+        if lines.contains(where: { $0.hasPrefix("#EXT-X-STREAM-INF:") }) {
+            return parseMasterPlaylist(lines: lines)
+        }
+        return parseMediaPlaylist(lines: lines)
+    }
+
+    private func parseMasterPlaylist(lines: [String]) -> Result<HLSPlaylist, HLSError> {
+        var variants: [HLSVariant] = []
+        var attributes: [String: String]?
+        for line in lines {
+            if let value = HLSPlaylistParser.value(of: "#EXT-X-STREAM-INF:", in: line) {
+                attributes = HLSPlaylistParser.attributes(value)
+            } else if !line.hasPrefix("#"), let streamAttributes = attributes {
+                attributes = nil
+                guard let variantURL = resolve(line), let bandwidth = streamAttributes["BANDWIDTH"].flatMap(Int.init) else {
+                    continue
+                }
+                let codecs = streamAttributes["CODECS"]?
+                    .components(separatedBy: ",")
+                    .map { $0.trimmingCharacters(in: .whitespaces) } ?? []
+                variants.append(HLSVariant(url: variantURL,
+                                           bandwidth: bandwidth,
+                                           averageBandwidth: streamAttributes["AVERAGE-BANDWIDTH"].flatMap(Int.init),
+                                           codecs: codecs))
+            }
+        }
+        guard !variants.isEmpty else { return .failure(.emptyPlaylist) }
+        return .success(.master(HLSMasterPlaylist(variants: variants)))
+    }
+
+    private func parseMediaPlaylist(lines: [String]) -> Result<HLSPlaylist, HLSError> {
+        var targetDuration: TimeInterval = 0
+        var mediaSequence = 0
+        var isEndList = false
+        var segments: [HLSMediaSegment] = []
+
+        var segmentDuration: TimeInterval?
+        var byteRange: (length: Int, offset: Int?)?
+        var initializationSection: HLSInitializationSection?
+        /// Where the next byte range of each resource starts when its offset is omitted
+        var nextByteRangeOffsets: [URL: Int] = [:]
+
+        for line in lines {
+            if let value = HLSPlaylistParser.value(of: "#EXT-X-TARGETDURATION:", in: line) {
+                targetDuration = TimeInterval(value) ?? 0
+            } else if let value = HLSPlaylistParser.value(of: "#EXT-X-MEDIA-SEQUENCE:", in: line) {
+                mediaSequence = Int(value) ?? 0
+            } else if let value = HLSPlaylistParser.value(of: "#EXTINF:", in: line) {
+                segmentDuration = TimeInterval(value.components(separatedBy: ",")[0]) ?? 0
+            } else if let value = HLSPlaylistParser.value(of: "#EXT-X-BYTERANGE:", in: line) {
+                byteRange = HLSPlaylistParser.byteRange(value)
+            } else if let value = HLSPlaylistParser.value(of: "#EXT-X-MAP:", in: line) {
+                let attributes = HLSPlaylistParser.attributes(value)
+                guard let uri = attributes["URI"], let mapURL = resolve(uri) else { continue }
+                let range = attributes["BYTERANGE"].flatMap(HLSPlaylistParser.byteRange).map { range -> Range<Int> in
+                    let offset = range.offset ?? 0
+                    return offset ..< offset + range.length
+                }
+                initializationSection = HLSInitializationSection(url: mapURL, byteRange: range)
+            } else if let value = HLSPlaylistParser.value(of: "#EXT-X-KEY:", in: line) {
+                if HLSPlaylistParser.attributes(value)["METHOD"] != "NONE" {
+                    return .failure(.encryptedSegments)
+                }
+            } else if line.hasPrefix("#EXT-X-ENDLIST") {
+                isEndList = true
+            } else if !line.hasPrefix("#"), let duration = segmentDuration, let segmentURL = resolve(line) {
+                var range: Range<Int>?
+                if let byteRange = byteRange {
+                    let offset = byteRange.offset ?? nextByteRangeOffsets[segmentURL] ?? 0
+                    range = offset ..< offset + byteRange.length
+                    nextByteRangeOffsets[segmentURL] = range?.upperBound
+                }
+                segments.append(HLSMediaSegment(url: segmentURL,
+                                                duration: duration,
+                                                sequenceNumber: mediaSequence + segments.count,
+                                                byteRange: range,
+                                                initializationSection: initializationSection))
+                segmentDuration = nil
+                byteRange = nil
+            }
+        }
+        if lines.contains(where: { $0 == "#EXT-X-PLAYLIST-TYPE:VOD" }) {
+            isEndList = true
+        }
+        guard !segments.isEmpty || !isEndList else { return .failure(.emptyPlaylist) }
+        return .success(.media(HLSMediaPlaylist(targetDuration: targetDuration,
+                                                mediaSequence: mediaSequence,
+                                                segments: segments,
+                                                isEndList: isEndList)))
+    }
+
+    private func resolve(_ uri: String) -> URL? {
+        URL(string: uri, relativeTo: url)?.absoluteURL
+    }
+
+    private static func value(of tag: String, in line: String) -> String? {
+        guard line.hasPrefix(tag) else { return nil }
+        return String(line.dropFirst(tag.count))
+    }
+
+    /// Parses `<length>[@<offset>]`
+    private static func byteRange(_ value: String) -> (length: Int, offset: Int?)? {
+        let components = value.components(separatedBy: "@")
+        guard let length = Int(components[0]) else { return nil }
+        return (length, components.count > 1 ? Int(components[1]) : nil)
+    }
+
+    /// Parses an attribute list, eg. `BANDWIDTH=64000,CODECS="mp4a.40.2"`, where quoted values may contain commas
+    static func attributes(_ list: String) -> [String: String] {
+        var attributes: [String: String] = [:]
+        var name = ""
+        var value = ""
+        var isReadingValue = false
+        var isQuoted = false
+        for character in list {
+            switch character {
+            case "=" where !isReadingValue:
+                isReadingValue = true
+            case "\"" where isReadingValue:
+                isQuoted.toggle()
+            case "," where !isQuoted:
+                attributes[name.trimmingCharacters(in: .whitespaces)] = value
+                name = ""
+                value = ""
+                isReadingValue = false
+            default:
+                if isReadingValue {
+                    value.append(character)
+                } else {
+                    name.append(character)
+                }
+            }
+        }
+        if !name.isEmpty {
+            attributes[name.trimmingCharacters(in: .whitespaces)] = value
+        }
+        return attributes
+    }
+}
@@ -0,0 +1,57 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import Foundation
+
+enum StreamPlaylistError: Error, Equatable {
+    /// The playlist lists no stream URLs
+    case emptyPlaylist
+}
+
+/// Parses the mirrors of a stream listed by a `.pls` or `.m3u` playlist, resolving them against the URL of the
+/// playlist, in the order listed without duplicates.
+struct StreamPlaylistParser: Parser {
+    typealias Input = String
+    typealias Output = Result<[URL], StreamPlaylistError>
+
+    /// The URL of the playlist, relative URLs are resolved against it
+    let url: URL
+
+    func parse(input: String) -> Result<[URL], StreamPlaylistError> {
+        let lines = input.components(separatedBy: .newlines)
+            .map { $0.trimmingCharacters(in: .whitespaces) }
+            .filter { !$0.isEmpty }
+        let isPLS = lines.contains { $0.lowercased() == "[playlist]" || StreamPlaylistParser.plsEntry($0) != nil }
+        let entries = isPLS ? plsEntries(lines) : lines.filter { !$0.hasPrefix("#") }
+
+        var mirrors: [URL] = []
+        for entry in entries {
+            guard let mirror = resolve(entry), !mirrors.contains(mirror) else { continue }
+            mirrors.append(mirror)
+        }
+        return mirrors.isEmpty ? .failure(.emptyPlaylist) : .success(mirrors)
+    }
+
+    /// The `FileN=` entries of a `.pls` playlist, ordered by their number
+    private func plsEntries(_ lines: [String]) -> [String] {
+        lines.compactMap(StreamPlaylistParser.plsEntry)
+            .sorted { $0.number < $1.number }
+            .map { $0.value }
+    }
+
+    private static func plsEntry(_ line: String) -> (number: Int, value: String)? {
+        guard let separator = line.firstIndex(of: "=") else { return nil }
+        let key = line[..<separator].lowercased()
+        guard key.hasPrefix("file"), let number = Int(key.dropFirst(4)) else { return nil }
+        return (number, line[line.index(after: separator)...].trimmingCharacters(in: .whitespaces))
+    }
+
+    private func resolve(_ entry: String) -> URL? {
+        guard let resolved = URL(string: entry, relativeTo: url)?.absoluteURL,
+              let scheme = resolved.scheme?.lowercased(), ["http", "https"].contains(scheme)
+        else { return nil }
+        return resolved
+    }
+}
@@ -0,0 +1,8 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+// The atomic operations are all `static inline` in the header,
+// this file exists so the package manager can build the C target.
+#include "AudioStreamingAtomics.h"
@@ -0,0 +1,74 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+#ifndef AudioStreamingAtomics_h
+#define AudioStreamingAtomics_h
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/// Thin wrappers around the C11 `<stdatomic.h>` operations for word-sized values.
+/// Swift can't call the generic C11 macros directly, these are used by `Atomic<Value>`.
+
+typedef enum {
+    as_memory_order_relaxed = 0,
+    as_memory_order_acquire = 1,
+    as_memory_order_release = 2,
+    as_memory_order_acq_rel = 3,
+    as_memory_order_seq_cst = 4
+} as_memory_order;
+
+static inline memory_order as_c11_memory_order(as_memory_order order) {
+    switch (order) {
+        case as_memory_order_relaxed: return memory_order_relaxed;
+        case as_memory_order_acquire: return memory_order_acquire;
+        case as_memory_order_release: return memory_order_release;
+        case as_memory_order_acq_rel: return memory_order_acq_rel;
+        case as_memory_order_seq_cst: return memory_order_seq_cst;
+    }
+    return memory_order_seq_cst;
+}
+
+/// The failure ordering of a compare-exchange can't contain a release
+static inline memory_order as_c11_failure_memory_order(as_memory_order order) {
+    switch (order) {
+        case as_memory_order_relaxed: return memory_order_relaxed;
+        case as_memory_order_acquire: return memory_order_acquire;
+        case as_memory_order_release: return memory_order_relaxed;
+        case as_memory_order_acq_rel: return memory_order_acquire;
+        case as_memory_order_seq_cst: return memory_order_seq_cst;
+    }
+    return memory_order_seq_cst;
+}
+
+static inline intptr_t as_atomic_word_load(intptr_t *object, as_memory_order order) {
+    return atomic_load_explicit((_Atomic(intptr_t) *)object, as_c11_memory_order(order));
+}
+
+static inline void as_atomic_word_store(intptr_t *object, intptr_t desired, as_memory_order order) {
+    atomic_store_explicit((_Atomic(intptr_t) *)object, desired, as_c11_memory_order(order));
+}
+
+static inline intptr_t as_atomic_word_exchange(intptr_t *object, intptr_t desired, as_memory_order order) {
+    return atomic_exchange_explicit((_Atomic(intptr_t) *)object, desired, as_c11_memory_order(order));
+}
+
+static inline bool as_atomic_word_compare_exchange(intptr_t *object,
+                                                   intptr_t *expected,
+                                                   intptr_t desired,
+                                                   as_memory_order order) {
+    return atomic_compare_exchange_strong_explicit((_Atomic(intptr_t) *)object,
+                                                   expected,
+                                                   desired,
+                                                   as_c11_memory_order(order),
+                                                   as_c11_failure_memory_order(order));
+}
+
+static inline intptr_t as_atomic_word_fetch_add(intptr_t *object, intptr_t operand, as_memory_order order) {
+    return atomic_fetch_add_explicit((_Atomic(intptr_t) *)object, operand, as_c11_memory_order(order));
+}
+
+#endif /* AudioStreamingAtomics_h */
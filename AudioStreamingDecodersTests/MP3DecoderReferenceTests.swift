@@ -0,0 +1,119 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import AudioStreamingMP3
+import Foundation
+import XCTest
+
+/// Decodes MP3 fixtures with the portable decoder and compares them against reference decodes, without
+/// AudioToolbox, so the decoder is checked on Linux too.
+///
+/// The references are the decodes of ffmpeg as 16 bit PCM, the Xing or Info frame excluded.
+final class MP3DecoderReferenceTests: XCTestCase {
+    /// A sine at every MPEG-1, MPEG-2 and MPEG-2.5 sample rate, and a joint stereo stream
+    private let fixtures = [
+        "sine-440hz-8000-mono", "sine-440hz-11025-mono", "sine-440hz-12000-mono",
+        "sine-440hz-16000-mono", "sine-440hz-22050-mono", "sine-440hz-24000-mono",
+        "sine-440hz-32000-mono", "sine-440hz-44100-mono", "sine-440hz-48000-mono",
+        "sine-1khz-44100-joint-stereo",
+    ]
+
+    func test_Decoded_Samples_Match_The_Reference_At_Every_Sample_Rate() throws {
+        for name in fixtures {
+            let decoded = try decode(fixture(name, withExtension: "mp3"))
+            let reference = try referenceSamples(name)
+
+            XCTAssertEqual(decoded.count, reference.count, name)
+            // the references are rounded to 16 bits
+            let difference = zip(decoded, reference).map { abs($0 - $1) }.max() ?? .infinity
+            XCTAssertLessThanOrEqual(difference, 1 / 32768, name)
+        }
+    }
+
+    func test_Frame_Following_A_Reset_Decodes_To_Silence() throws {
+        let data = try fixture("sine-440hz-44100-mono", withExtension: "mp3")
+        let decoded = try decode(data, resettingAfter: 10)
+        let reference = try referenceSamples("sine-440hz-44100-mono")
+        let frame = 1152
+
+        XCTAssertEqual(decoded.count, reference.count)
+        let beforeReset = zip(decoded.prefix(10 * frame), reference).map { abs($0 - $1) }.max() ?? .infinity
+        XCTAssertLessThanOrEqual(beforeReset, 1 / 32768)
+        // its main data begins in the frames before the reset
+        XCTAssertEqual(decoded[10 * frame ..< 11 * frame].map(abs).max(), 0)
+    }
+
+    // MARK: Helpers
+
+    /// Decodes the frames of the given stream, skipping its ID3v2 tag and Xing or Info frame
+    ///
+    /// - parameter resettingAfter: The number of frames after which the decoder is reset, if any
+    private func decode(_ data: Data, resettingAfter resetFrame: Int? = nil) throws -> [Float] {
+        let decoder = try XCTUnwrap(as_mp3_decoder_create())
+        defer { as_mp3_decoder_destroy(decoder) }
+
+        let bytes = [UInt8](data)
+        var samples: [Float] = []
+        var pcm = [Float](repeating: 0, count: Int(AS_MP3_MAX_SAMPLES_PER_FRAME) * 2)
+        var offset = id3TagSize(bytes)
+        var decodedFrames = 0
+        var isFirstFrame = true
+
+        bytes.withUnsafeBufferPointer { buffer in
+            guard let base = buffer.baseAddress else { return }
+            while offset + 4 <= buffer.count {
+                offset += as_mp3_find_sync(base + offset, buffer.count - offset)
+                guard offset + 4 <= buffer.count else { break }
+                var header = as_mp3_frame_header()
+                guard as_mp3_parse_header(base + offset, &header), offset + Int(header.frame_size) <= buffer.count else {
+                    offset += 1
+                    continue
+                }
+                defer { offset += Int(header.frame_size) }
+                if isFirstFrame {
+                    isFirstFrame = false
+                    if isInfoFrame(base + offset, header: header) { continue }
+                }
+                if decodedFrames == resetFrame {
+                    as_mp3_decoder_reset(decoder)
+                }
+                let count = pcm.withUnsafeMutableBufferPointer { output in
+                    as_mp3_decode_frame(decoder, base + offset, buffer.count - offset, output.baseAddress, &header)
+                }
+                guard count >= 0 else { continue }
+                samples.append(contentsOf: pcm.prefix(Int(count) * Int(header.channels)))
+                decodedFrames += 1
+            }
+        }
+        return samples
+    }
+
+    private func isInfoFrame(_ frame: UnsafePointer<UInt8>, header: as_mp3_frame_header) -> Bool {
+        let offset = 4 + (header.has_crc ? 2 : 0) + Int(header.side_info_size)
+        guard offset + 4 <= Int(header.frame_size) else { return false }
+        let tag = String(decoding: UnsafeBufferPointer(start: frame + offset, count: 4), as: UTF8.self)
+        return tag == "Xing" || tag == "Info"
+    }
+
+    private func id3TagSize(_ bytes: [UInt8]) -> Int {
+        guard bytes.count >= 10, bytes[0] == 0x49, bytes[1] == 0x44, bytes[2] == 0x33 else { return 0 }
+        let size = bytes[6 ..< 10].reduce(0) { $0 << 7 | Int($1 & 0x7F) }
+        return 10 + size
+    }
+
+    /// The reference decode, interleaved 16 bit little endian samples
+    private func referenceSamples(_ name: String) throws -> [Float] {
+        let data = try fixture(name, withExtension: "s16")
+        return stride(from: 0, to: data.count - 1, by: 2).map { index in
+            let sample = Int16(bitPattern: UInt16(data[index]) | UInt16(data[index + 1]) << 8)
+            return Float(sample) / 32768
+        }
+    }
+
+    private func fixture(_ name: String, withExtension ext: String) throws -> Data {
+        let url = try XCTUnwrap(Bundle.module.url(forResource: name, withExtension: ext, subdirectory: "Fixtures"))
+        return try Data(contentsOf: url)
+    }
+}
@@ -0,0 +1,529 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+#include "AudioStreamingFLAC.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define AS_FLAC_MAX_CHANNELS 8
+#define AS_FLAC_MAX_LPC_ORDER 32
+#define AS_FLAC_MAX_BITS_PER_SAMPLE 24
+
+struct as_flac_decoder {
+    as_flac_stream_info info;
+    int32_t *channels[AS_FLAC_MAX_CHANNELS];
+};
+
+// MARK: - Bit reader
+
+typedef struct {
+    const uint8_t *data;
+    size_t size;
+    /// The position in bits
+    size_t position;
+    bool overrun;
+} bit_reader;
+
+/// Loads the 64 bits starting at the current position, zero filled past the end
+static inline uint64_t peek_window(const bit_reader *reader) {
+    size_t byte = reader->position >> 3;
+    size_t available = reader->size - byte;
+    uint64_t window = 0;
+    if (available >= 8) {
+        const uint8_t *bytes = reader->data + byte;
+        window = (uint64_t)bytes[0] << 56 | (uint64_t)bytes[1] << 48 | (uint64_t)bytes[2] << 40 | (uint64_t)bytes[3] << 32 |
+                 (uint64_t)bytes[4] << 24 | (uint64_t)bytes[5] << 16 | (uint64_t)bytes[6] << 8 | (uint64_t)bytes[7];
+    } else {
+        for (size_t i = 0; i < available; i++) {
+            window |= (uint64_t)reader->data[byte + i] << (56 - 8 * i);
+        }
+    }
+    return window << (reader->position & 7);
+}
+
+static inline size_t remaining_bits(const bit_reader *reader) {
+    return reader->size * 8 - reader->position;
+}
+
+/// Reads up to 32 bits
+static inline uint32_t read_bits(bit_reader *reader, unsigned count) {
+    if (count == 0) {
+        return 0;
+    }
+    if (count > remaining_bits(reader)) {
+        reader->overrun = true;
+        reader->position = reader->size * 8;
+        return 0;
+    }
+    uint32_t value = (uint32_t)(peek_window(reader) >> (64 - count));
+    reader->position += count;
+    return value;
+}
+
+static inline int32_t read_signed_bits(bit_reader *reader, unsigned count) {
+    if (count == 0) {
+        return 0;
+    }
+    uint32_t value = read_bits(reader, count);
+    uint32_t sign = 1u << (count - 1);
+    return (int32_t)((value ^ sign) - sign);
+}
+
+/// Reads the number of zero bits before the next set bit
+static inline uint32_t read_unary(bit_reader *reader) {
+    uint32_t count = 0;
+    for (;;) {
+        size_t remaining = remaining_bits(reader);
+        if (remaining == 0) {
+            reader->overrun = true;
+            return 0;
+        }
+        size_t valid = 64 - (reader->position & 7);
+        if (valid > remaining) {
+            valid = remaining;
+        }
+        uint64_t window = peek_window(reader);
+        if (window != 0) {
+            unsigned zeros = (unsigned)__builtin_clzll(window);
+            if (zeros < valid) {
+                reader->position += zeros + 1;
+                return count + zeros;
+            }
+        }
+        count += (uint32_t)valid;
+        reader->position += valid;
+    }
+}
+
+static inline void align_to_byte(bit_reader *reader) {
+    reader->position = (reader->position + 7) & ~(size_t)7;
+    if (reader->position > reader->size * 8) {
+        reader->overrun = true;
+        reader->position = reader->size * 8;
+    }
+}
+
+// MARK: - CRC
+
+static uint8_t crc8(const uint8_t *bytes, size_t count) {
+    uint8_t crc = 0;
+    for (size_t i = 0; i < count; i++) {
+        crc ^= bytes[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (uint8_t)((crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1);
+        }
+    }
+    return crc;
+}
+
+static uint16_t crc16_table[256];
+static bool crc16_table_ready = false;
+
+static void prepare_crc16_table(void) {
+    if (crc16_table_ready) {
+        return;
+    }
+    for (int i = 0; i < 256; i++) {
+        uint16_t crc = (uint16_t)(i << 8);
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (uint16_t)((crc & 0x8000) ? (crc << 1) ^ 0x8005 : crc << 1);
+        }
+        crc16_table[i] = crc;
+    }
+    crc16_table_ready = true;
+}
+
+bool as_flac_check_frame_crc(const uint8_t *frame, size_t size) {
+    if (size < 2) {
+        return false;
+    }
+    prepare_crc16_table();
+    uint16_t crc = 0;
+    for (size_t i = 0; i < size - 2; i++) {
+        crc = (uint16_t)(crc << 8) ^ crc16_table[(crc >> 8) ^ frame[i]];
+    }
+    return crc == ((uint16_t)frame[size - 2] << 8 | frame[size - 1]);
+}
+
+// MARK: - Headers
+
+bool as_flac_parse_stream_info(const uint8_t *bytes, as_flac_stream_info *info) {
+    info->min_block_size = (uint32_t)bytes[0] << 8 | bytes[1];
+    info->max_block_size = (uint32_t)bytes[2] << 8 | bytes[3];
+    info->min_frame_size = (uint32_t)bytes[4] << 16 | (uint32_t)bytes[5] << 8 | bytes[6];
+    info->max_frame_size = (uint32_t)bytes[7] << 16 | (uint32_t)bytes[8] << 8 | bytes[9];
+    info->sample_rate = (uint32_t)bytes[10] << 12 | (uint32_t)bytes[11] << 4 | bytes[12] >> 4;
+    info->channels = (uint8_t)(((bytes[12] >> 1) & 0x07) + 1);
+    info->bits_per_sample = (uint8_t)((((bytes[12] & 0x01) << 4) | bytes[13] >> 4) + 1);
+    info->total_samples = (uint64_t)(bytes[13] & 0x0F) << 32 | (uint64_t)bytes[14] << 24 | (uint64_t)bytes[15] << 16 |
+                          (uint64_t)bytes[16] << 8 | bytes[17];
+    return info->max_block_size >= 16 && info->min_block_size <= info->max_block_size && info->sample_rate > 0 &&
+           info->bits_per_sample >= 4 && info->bits_per_sample <= AS_FLAC_MAX_BITS_PER_SAMPLE;
+}
+
+static const uint32_t header_sample_rates[12] = {0, 88200, 176400, 192000, 8000, 16000, 22050, 24000, 32000, 44100, 48000, 96000};
+static const uint8_t header_bits_per_sample[8] = {0, 8, 12, 0, 16, 20, 24, 32};
+
+bool as_flac_parse_frame_header(const uint8_t *bytes, size_t count, const as_flac_stream_info *info, as_flac_frame_header *header) {
+    if (count < 6 || bytes[0] != 0xFF || (bytes[1] & 0xFE) != 0xF8) {
+        return false;
+    }
+    header->variable_block_size = bytes[1] & 0x01;
+    unsigned block_size_code = bytes[2] >> 4;
+    unsigned sample_rate_code = bytes[2] & 0x0F;
+    unsigned channel_assignment = bytes[3] >> 4;
+    unsigned sample_size_code = (bytes[3] >> 1) & 0x07;
+    if (block_size_code == 0 || sample_rate_code == 15 || channel_assignment > 10 || sample_size_code == 3 || (bytes[3] & 0x01)) {
+        return false;
+    }
+
+    // the frame or sample number, coded like UTF-8 with up to 7 bytes
+    size_t position = 4;
+    uint8_t lead = bytes[position++];
+    uint64_t number;
+    unsigned extra;
+    if (lead < 0x80) {
+        number = lead;
+        extra = 0;
+    } else if (lead >= 0xC0 && lead < 0xE0) {
+        number = lead & 0x1F;
+        extra = 1;
+    } else if (lead >= 0xE0 && lead < 0xF0) {
+        number = lead & 0x0F;
+        extra = 2;
+    } else if (lead >= 0xF0 && lead < 0xF8) {
+        number = lead & 0x07;
+        extra = 3;
+    } else if (lead >= 0xF8 && lead < 0xFC) {
+        number = lead & 0x03;
+        extra = 4;
+    } else if (lead >= 0xFC && lead < 0xFE) {
+        number = lead & 0x01;
+        extra = 5;
+    } else if (lead == 0xFE) {
+        number = 0;
+        extra = 6;
+    } else {
+        return false;
+    }
+    if (position + extra > count) {
+        return false;
+    }
+    for (unsigned i = 0; i < extra; i++) {
+        uint8_t byte = bytes[position++];
+        if ((byte & 0xC0) != 0x80) {
+            return false;
+        }
+        number = number << 6 | (byte & 0x3F);
+    }
+
+    uint32_t block_size;
+    if (block_size_code == 1) {
+        block_size = 192;
+    } else if (block_size_code <= 5) {
+        block_size = 576u << (block_size_code - 2);
+    } else if (block_size_code == 6) {
+        if (position + 1 > count) {
+            return false;
+        }
+        block_size = (uint32_t)bytes[position++] + 1;
+    } else if (block_size_code == 7) {
+        if (position + 2 > count) {
+            return false;
+        }
+        block_size = ((uint32_t)bytes[position] << 8 | bytes[position + 1]) + 1;
+        position += 2;
+    } else {
+        block_size = 256u << (block_size_code - 8);
+    }
+
+    uint32_t sample_rate;
+    if (sample_rate_code == 0) {
+        sample_rate = info->sample_rate;
+    } else if (sample_rate_code < 12) {
+        sample_rate = header_sample_rates[sample_rate_code];
+    } else {
+        size_t size = sample_rate_code == 12 ? 1 : 2;
+        if (position + size > count) {
+            return false;
+        }
+        uint32_t value = size == 1 ? bytes[position] : ((uint32_t)bytes[position] << 8 | bytes[position + 1]);
+        position += size;
+        sample_rate = sample_rate_code == 12 ? value * 1000 : (sample_rate_code == 13 ? value : value * 10);
+    }
+
+    if (position + 1 > count || crc8(bytes, position) != bytes[position]) {
+        return false;
+    }
+    position += 1;
+
+    header->block_size = block_size;
+    header->sample_rate = sample_rate;
+    header->channel_assignment = (uint8_t)channel_assignment;
+    header->channels = (uint8_t)(channel_assignment < 8 ? channel_assignment + 1 : 2);
+    header->bits_per_sample = sample_size_code == 0 ? info->bits_per_sample : header_bits_per_sample[sample_size_code];
+    header->header_size = (uint8_t)position;
+    if (header->variable_block_size) {
+        header->first_sample = number;
+    } else {
+        header->first_sample = number * info->max_block_size;
+    }
+    return header->channels == info->channels && header->sample_rate == info->sample_rate &&
+           header->bits_per_sample == info->bits_per_sample && block_size <= info->max_block_size;
+}
+
+// MARK: - Subframes
+
+/// Decodes the Rice coded residual of a subframe into `residual`
+static bool read_residual(bit_reader *reader, uint32_t block_size, unsigned order, int32_t *residual) {
+    unsigned method = read_bits(reader, 2);
+    if (method > 1) {
+        return false;
+    }
+    unsigned parameter_bits = method == 0 ? 4 : 5;
+    unsigned escape = method == 0 ? 15 : 31;
+    unsigned partition_order = read_bits(reader, 4);
+    uint32_t partitions = 1u << partition_order;
+    if ((block_size & (partitions - 1)) != 0 || (block_size >> partition_order) < order) {
+        return false;
+    }
+
+    uint32_t sample = 0;
+    for (uint32_t partition = 0; partition < partitions; partition++) {
+        uint32_t count = block_size >> partition_order;
+        if (partition == 0) {
+            count -= order;
+        }
+        unsigned parameter = read_bits(reader, parameter_bits);
+        if (parameter == escape) {
+            unsigned bits = read_bits(reader, 5);
+            for (uint32_t i = 0; i < count; i++) {
+                residual[sample++] = read_signed_bits(reader, bits);
+            }
+        } else {
+            for (uint32_t i = 0; i < count; i++) {
+                uint32_t value = read_unary(reader) << parameter;
+                value |= read_bits(reader, parameter);
+                residual[sample++] = (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+            }
+        }
+        if (reader->overrun) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool decode_fixed(bit_reader *reader, uint32_t block_size, unsigned order, unsigned bits, int32_t *samples) {
+    if (order > 4 || order > block_size) {
+        return false;
+    }
+    for (unsigned i = 0; i < order; i++) {
+        samples[i] = read_signed_bits(reader, bits);
+    }
+    if (!read_residual(reader, block_size, order, samples + order)) {
+        return false;
+    }
+    // the residual is stored in place and replaced by the prediction
+    for (uint32_t i = order; i < block_size; i++) {
+        int64_t prediction;
+        switch (order) {
+        case 0:
+            prediction = 0;
+            break;
+        case 1:
+            prediction = samples[i - 1];
+            break;
+        case 2:
+            prediction = 2 * (int64_t)samples[i - 1] - samples[i - 2];
+            break;
+        case 3:
+            prediction = 3 * ((int64_t)samples[i - 1] - samples[i - 2]) + samples[i - 3];
+            break;
+        default:
+            prediction = 4 * ((int64_t)samples[i - 1] + samples[i - 3]) - 6 * (int64_t)samples[i - 2] - samples[i - 4];
+            break;
+        }
+        samples[i] = (int32_t)(prediction + samples[i]);
+    }
+    return true;
+}
+
+static bool decode_lpc(bit_reader *reader, uint32_t block_size, unsigned order, unsigned bits, int32_t *samples) {
+    if (order > block_size) {
+        return false;
+    }
+    for (unsigned i = 0; i < order; i++) {
+        samples[i] = read_signed_bits(reader, bits);
+    }
+    unsigned precision = read_bits(reader, 4) + 1;
+    if (precision == 16) {
+        return false;
+    }
+    int shift = read_signed_bits(reader, 5);
+    if (shift < 0) {
+        return false;
+    }
+    int32_t coefficients[AS_FLAC_MAX_LPC_ORDER];
+    for (unsigned i = 0; i < order; i++) {
+        coefficients[i] = read_signed_bits(reader, precision);
+    }
+    if (!read_residual(reader, block_size, order, samples + order)) {
+        return false;
+    }
+    for (uint32_t i = order; i < block_size; i++) {
+        int64_t sum = 0;
+        for (unsigned j = 0; j < order; j++) {
+            sum += (int64_t)coefficients[j] * samples[i - 1 - j];
+        }
+        samples[i] = (int32_t)(samples[i] + (sum >> shift));
+    }
+    return true;
+}
+
+static bool decode_subframe(bit_reader *reader, uint32_t block_size, unsigned bits, int32_t *samples) {
+    if (read_bits(reader, 1) != 0) {
+        return false;
+    }
+    unsigned type = read_bits(reader, 6);
+    unsigned wasted_bits = 0;
+    if (read_bits(reader, 1)) {
+        wasted_bits = read_unary(reader) + 1;
+        if (wasted_bits >= bits) {
+            return false;
+        }
+        bits -= wasted_bits;
+    }
+
+    bool decoded;
+    if (type == 0) {
+        int32_t value = read_signed_bits(reader, bits);
+        for (uint32_t i = 0; i < block_size; i++) {
+            samples[i] = value;
+        }
+        decoded = true;
+    } else if (type == 1) {
+        for (uint32_t i = 0; i < block_size; i++) {
+            samples[i] = read_signed_bits(reader, bits);
+        }
+        decoded = true;
+    } else if (type >= 8 && type <= 12) {
+        decoded = decode_fixed(reader, block_size, type - 8, bits, samples);
+    } else if (type >= 32) {
+        decoded = decode_lpc(reader, block_size, type - 31, bits, samples);
+    } else {
+        decoded = false;
+    }
+    if (!decoded || reader->overrun) {
+        return false;
+    }
+    if (wasted_bits > 0) {
+        for (uint32_t i = 0; i < block_size; i++) {
+            samples[i] = (int32_t)((uint32_t)samples[i] << wasted_bits);
+        }
+    }
+    return true;
+}
+
+// MARK: - Decoder
+
+as_flac_decoder *as_flac_decoder_create(const as_flac_stream_info *info) {
+    if (info->channels == 0 || info->channels > AS_FLAC_MAX_CHANNELS || info->max_block_size == 0 ||
+        info->bits_per_sample > AS_FLAC_MAX_BITS_PER_SAMPLE) {
+        return NULL;
+    }
+    as_flac_decoder *decoder = calloc(1, sizeof(as_flac_decoder));
+    if (decoder == NULL) {
+        return NULL;
+    }
+    decoder->info = *info;
+    for (unsigned channel = 0; channel < info->channels; channel++) {
+        decoder->channels[channel] = calloc(info->max_block_size, sizeof(int32_t));
+        if (decoder->channels[channel] == NULL) {
+            as_flac_decoder_destroy(decoder);
+            return NULL;
+        }
+    }
+    prepare_crc16_table();
+    return decoder;
+}
+
+void as_flac_decoder_destroy(as_flac_decoder *decoder) {
+    if (decoder == NULL) {
+        return;
+    }
+    for (unsigned channel = 0; channel < AS_FLAC_MAX_CHANNELS; channel++) {
+        free(decoder->channels[channel]);
+    }
+    free(decoder);
+}
+
+int as_flac_decode_frame(as_flac_decoder *decoder,
+                         const uint8_t *frame,
+                         size_t size,
+                         float *pcm,
+                         as_flac_frame_header *header_out,
+                         size_t *consumed) {
+    as_flac_frame_header header;
+    if (!as_flac_parse_frame_header(frame, size, &decoder->info, &header)) {
+        return size < AS_FLAC_MAX_FRAME_HEADER_SIZE ? 0 : -1;
+    }
+    if (header_out != NULL) {
+        *header_out = header;
+    }
+
+    bit_reader reader = {frame, size, (size_t)header.header_size * 8, false};
+    for (unsigned channel = 0; channel < header.channels; channel++) {
+        unsigned bits = header.bits_per_sample;
+        // the side channel needs an extra bit
+        if ((header.channel_assignment == 8 && channel == 1) || (header.channel_assignment == 9 && channel == 0) ||
+            (header.channel_assignment == 10 && channel == 1)) {
+            bits += 1;
+        }
+        if (!decode_subframe(&reader, header.block_size, bits, decoder->channels[channel])) {
+            return reader.overrun ? 0 : -1;
+        }
+    }
+    align_to_byte(&reader);
+    size_t frame_size = reader.position / 8 + 2;
+    if (reader.overrun || frame_size > size) {
+        return 0;
+    }
+    if (!as_flac_check_frame_crc(frame, frame_size)) {
+        return -1;
+    }
+
+    int32_t *left = decoder->channels[0];
+    int32_t *right = decoder->channels[1];
+    switch (header.channel_assignment) {
+    case 8:
+        for (uint32_t i = 0; i < header.block_size; i++) {
+            right[i] = left[i] - right[i];
+        }
+        break;
+    case 9:
+        for (uint32_t i = 0; i < header.block_size; i++) {
+            left[i] += right[i];
+        }
+        break;
+    case 10:
+        for (uint32_t i = 0; i < header.block_size; i++) {
+            int32_t side = right[i];
+            int32_t mid = (int32_t)((uint32_t)left[i] << 1) | (side & 1);
+            left[i] = (mid + side) >> 1;
+            right[i] = (mid - side) >> 1;
+        }
+        break;
+    default:
+        break;
+    }
+
+    as_flac_int_to_float((const int32_t *const *)decoder->channels, header.channels, header.block_size, header.bits_per_sample, pcm);
+    if (consumed != NULL) {
+        *consumed = frame_size;
+    }
+    return (int)header.block_size;
+}
@@ -0,0 +1,56 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+#include "AudioStreamingFLAC.h"
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+static inline bool is_sync(const uint8_t *bytes) {
+    return bytes[0] == 0xFF && (bytes[1] & 0xFE) == 0xF8;
+}
+
+size_t as_flac_find_sync(const uint8_t *bytes, size_t count) {
+    size_t offset = 0;
+    if (count < 2) {
+        return count;
+    }
+    // compares 16 candidate positions at once, each needs the byte that follows it so the last block ends a byte early
+#if defined(__aarch64__)
+    const uint8x16_t ff = vdupq_n_u8(0xFF);
+    const uint8x16_t fe = vdupq_n_u8(0xFE);
+    const uint8x16_t f8 = vdupq_n_u8(0xF8);
+    for (; offset + 17 <= count; offset += 16) {
+        uint8x16_t first = vld1q_u8(bytes + offset);
+        uint8x16_t second = vld1q_u8(bytes + offset + 1);
+        uint8x16_t matches = vandq_u8(vceqq_u8(first, ff), vceqq_u8(vandq_u8(second, fe), f8));
+        if (vmaxvq_u8(matches) != 0) {
+            break;
+        }
+    }
+#elif defined(__SSE2__)
+    const __m128i ff = _mm_set1_epi8((char)0xFF);
+    const __m128i fe = _mm_set1_epi8((char)0xFE);
+    const __m128i f8 = _mm_set1_epi8((char)0xF8);
+    for (; offset + 17 <= count; offset += 16) {
+        __m128i first = _mm_loadu_si128((const __m128i *)(bytes + offset));
+        __m128i second = _mm_loadu_si128((const __m128i *)(bytes + offset + 1));
+        __m128i matches = _mm_and_si128(_mm_cmpeq_epi8(first, ff), _mm_cmpeq_epi8(_mm_and_si128(second, fe), f8));
+        int mask = _mm_movemask_epi8(matches);
+        if (mask != 0) {
+            return offset + (size_t)__builtin_ctz((unsigned int)mask);
+        }
+    }
+#endif
+    for (; offset + 1 < count; offset++) {
+        if (is_sync(bytes + offset)) {
+            return offset;
+        }
+    }
+    return count;
+}
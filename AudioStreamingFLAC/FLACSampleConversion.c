@@ -0,0 +1,70 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+#include "AudioStreamingFLAC.h"
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+void as_flac_int_to_float(const int32_t *const *channels, unsigned channel_count, size_t frames, unsigned bits_per_sample, float *output) {
+    const float scale = 1.0f / (float)(1u << (bits_per_sample - 1));
+    size_t frame = 0;
+    if (channel_count == 1) {
+        const int32_t *mono = channels[0];
+#if defined(__aarch64__)
+        const float32x4_t scales = vdupq_n_f32(scale);
+        for (; frame + 4 <= frames; frame += 4) {
+            vst1q_f32(output + frame, vmulq_f32(vcvtq_f32_s32(vld1q_s32(mono + frame)), scales));
+        }
+#elif defined(__SSE2__)
+        const __m128 scales = _mm_set1_ps(scale);
+        for (; frame + 4 <= frames; frame += 4) {
+            __m128 samples = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i *)(mono + frame)));
+            _mm_storeu_ps(output + frame, _mm_mul_ps(samples, scales));
+        }
+#endif
+        for (; frame < frames; frame++) {
+            output[frame] = (float)mono[frame] * scale;
+        }
+        return;
+    }
+
+    if (channel_count == 2) {
+        const int32_t *left = channels[0];
+        const int32_t *right = channels[1];
+        // the common stereo case converts and interleaves 4 frames at once
+#if defined(__aarch64__)
+        const float32x4_t scales = vdupq_n_f32(scale);
+        for (; frame + 4 <= frames; frame += 4) {
+            float32x4x2_t samples;
+            samples.val[0] = vmulq_f32(vcvtq_f32_s32(vld1q_s32(left + frame)), scales);
+            samples.val[1] = vmulq_f32(vcvtq_f32_s32(vld1q_s32(right + frame)), scales);
+            vst2q_f32(output + frame * 2, samples);
+        }
+#elif defined(__SSE2__)
+        const __m128 scales = _mm_set1_ps(scale);
+        for (; frame + 4 <= frames; frame += 4) {
+            __m128 l = _mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i *)(left + frame))), scales);
+            __m128 r = _mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i *)(right + frame))), scales);
+            _mm_storeu_ps(output + frame * 2, _mm_unpacklo_ps(l, r));
+            _mm_storeu_ps(output + frame * 2 + 4, _mm_unpackhi_ps(l, r));
+        }
+#endif
+        for (; frame < frames; frame++) {
+            output[frame * 2] = (float)left[frame] * scale;
+            output[frame * 2 + 1] = (float)right[frame] * scale;
+        }
+        return;
+    }
+
+    for (; frame < frames; frame++) {
+        for (unsigned channel = 0; channel < channel_count; channel++) {
+            output[frame * channel_count + channel] = (float)channels[channel][frame] * scale;
+        }
+    }
+}
@@ -0,0 +1,108 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+#ifndef AudioStreamingFLAC_h
+#define AudioStreamingFLAC_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/// A portable FLAC frame parser and decoder, written in plain C so it builds and runs on any platform.
+/// Decodes one frame at a time into interleaved 32 bit float samples, streams of up to 24 bits per sample are supported.
+
+/// The size of the STREAMINFO metadata block, without its 4 bytes header
+#define AS_FLAC_STREAM_INFO_SIZE 34
+/// The largest frame header, including the CRC-8
+#define AS_FLAC_MAX_FRAME_HEADER_SIZE 16
+
+typedef struct {
+    uint32_t min_block_size;
+    uint32_t max_block_size;
+    /// The smallest frame in bytes, zero when unknown
+    uint32_t min_frame_size;
+    /// The largest frame in bytes, zero when unknown
+    uint32_t max_frame_size;
+    uint32_t sample_rate;
+    uint8_t channels;
+    uint8_t bits_per_sample;
+    /// The samples per channel of the whole stream, zero when unknown
+    uint64_t total_samples;
+} as_flac_stream_info;
+
+typedef struct {
+    bool variable_block_size;
+    uint32_t block_size;
+    uint32_t sample_rate;
+    uint8_t channels;
+    /// 0 to 7 for independent channels, 8 left/side, 9 side/right and 10 mid/side
+    uint8_t channel_assignment;
+    uint8_t bits_per_sample;
+    /// The number of the first sample of the frame
+    uint64_t first_sample;
+    /// The size of the header in bytes, including the CRC-8
+    uint8_t header_size;
+} as_flac_frame_header;
+
+/// Parses the body of a STREAMINFO metadata block
+///
+/// - parameter bytes: `AS_FLAC_STREAM_INFO_SIZE` bytes
+/// - Returns: `true` when the stream info describes a stream the decoder supports
+bool as_flac_parse_stream_info(const uint8_t *bytes, as_flac_stream_info *info);
+
+/// Parses and validates a frame header, including its CRC-8
+///
+/// - parameter bytes: The bytes starting with the frame sync code
+/// - parameter count: The number of bytes available, a header is at most `AS_FLAC_MAX_FRAME_HEADER_SIZE` bytes
+/// - parameter info: The stream info, which provides the values a header may leave out
+/// - Returns: `true` when the bytes start with a valid header of the stream
+bool as_flac_parse_frame_header(const uint8_t *bytes, size_t count, const as_flac_stream_info *info, as_flac_frame_header *header);
+
+/// Checks the CRC-16 that ends every frame
+///
+/// - parameter frame: The bytes of the whole frame
+/// - parameter size: The size of the frame, including its CRC-16
+bool as_flac_check_frame_crc(const uint8_t *frame, size_t size);
+
+/// Finds the next frame sync code using vector instructions where available.
+///
+/// - Returns: The offset of the first sync code, or `count` if there is none.
+///            A sync code is not necessarily a valid header, the caller still parses it with `as_flac_parse_frame_header`.
+size_t as_flac_find_sync(const uint8_t *bytes, size_t count);
+
+/// Converts planar integer samples to interleaved floats in `[-1, 1)`, using vector instructions where available
+///
+/// - parameter channels: The samples of each channel
+/// - parameter channel_count: The number of channels
+/// - parameter frames: The number of samples per channel
+/// - parameter bits_per_sample: The resolution of the samples
+/// - parameter output: Receives `frames * channel_count` samples
+void as_flac_int_to_float(const int32_t *const *channels, unsigned channel_count, size_t frames, unsigned bits_per_sample, float *output);
+
+typedef struct as_flac_decoder as_flac_decoder;
+
+/// Creates a decoder for the given stream, returns `NULL` if the stream is not supported or the memory couldn't be allocated
+as_flac_decoder *as_flac_decoder_create(const as_flac_stream_info *info);
+
+void as_flac_decoder_destroy(as_flac_decoder *decoder);
+
+/// Decodes a single frame
+///
+/// - parameter decoder: The decoder
+/// - parameter frame: The bytes starting with the frame header
+/// - parameter size: The number of bytes available
+/// - parameter pcm: Receives `block_size * channels` interleaved samples, at most `max_block_size * channels` of the stream info
+/// - parameter header: Receives the header of the frame, can be `NULL`
+/// - parameter consumed: Receives the size of the frame, including its CRC-16, can be `NULL`
+/// - Returns: The number of samples per channel written, `0` when `size` doesn't hold the whole frame,
+///            or `-1` if the frame is invalid.
+int as_flac_decode_frame(as_flac_decoder *decoder,
+                         const uint8_t *frame,
+                         size_t size,
+                         float *pcm,
+                         as_flac_frame_header *header,
+                         size_t *consumed);
+
+#endif /* AudioStreamingFLAC_h */
@@ -0,0 +1,975 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+#include "AudioStreamingMP3.h"
+#include "MP3Tables.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+#ifndef M_SQRT1_2
+#define M_SQRT1_2 0.70710678118654752440
+#endif
+
+/// The main data of a frame can start up to 511 bytes before the frame, in the bit reservoir
+#define AS_MP3_MAX_MAIN_DATA_BEGIN 511
+#define AS_MP3_RESERVOIR_CAPACITY (AS_MP3_MAX_MAIN_DATA_BEGIN + AS_MP3_MAX_FRAME_SIZE)
+#define AS_MP3_GRANULE_SIZE 576
+/// The largest value of a big values pair is 15 plus 13 linbits
+#define AS_MP3_POW43_TABLE_SIZE 8207
+
+static const uint16_t bitrates[2][15] = {
+    {0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320},
+    {0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160},
+};
+
+static const uint32_t sample_rates[3] = {44100, 48000, 32000};
+
+/// The scalefactor lengths of MPEG-1 for each `scalefac_compress`
+static const uint8_t slen_table[2][16] = {
+    {0, 0, 0, 0, 3, 1, 1, 1, 2, 2, 2, 3, 3, 3, 4, 4},
+    {0, 1, 2, 3, 0, 1, 2, 3, 1, 2, 3, 1, 2, 3, 2, 3},
+};
+
+/// The number of scalefactor bands of each partition of MPEG-2, for long, short and mixed blocks
+static const uint8_t lsf_band_counts[6][3][4] = {
+    {{6, 5, 5, 5}, {9, 9, 9, 9}, {6, 9, 9, 9}},
+    {{6, 5, 7, 3}, {9, 9, 12, 6}, {6, 9, 12, 6}},
+    {{11, 10, 0, 0}, {18, 18, 0, 0}, {15, 18, 0, 0}},
+    {{7, 7, 7, 0}, {12, 12, 12, 0}, {6, 15, 12, 0}},
+    {{6, 6, 6, 3}, {12, 9, 9, 6}, {6, 12, 9, 6}},
+    {{8, 8, 5, 0}, {15, 12, 9, 0}, {6, 18, 9, 0}},
+};
+
+static const uint8_t pretab[22] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 3, 3, 3, 2, 0};
+
+static const float alias_coefficients[8] = {-0.6f, -0.535f, -0.33f, -0.185f, -0.095f, -0.041f, -0.0142f, -0.0037f};
+
+typedef struct {
+    uint16_t part2_3_length;
+    uint16_t big_values;
+    uint16_t global_gain;
+    uint16_t scalefac_compress;
+    uint8_t window_switching;
+    uint8_t block_type;
+    uint8_t mixed_block;
+    uint8_t table_select[3];
+    uint8_t subblock_gain[3];
+    uint8_t region0_count;
+    uint8_t region1_count;
+    uint8_t preflag;
+    uint8_t scalefac_scale;
+    uint8_t count1_table;
+} granule_info;
+
+typedef struct {
+    uint16_t main_data_begin;
+    uint8_t scfsi[2][4];
+    granule_info granules[2][2];
+} side_info;
+
+typedef struct {
+    const uint8_t *data;
+    size_t size;
+    /// In bits
+    size_t position;
+} bit_reader;
+
+typedef struct {
+    uint8_t long_bands[22];
+    uint8_t short_bands[13][3];
+    /// The illegal intensity positions of MPEG-2, the largest value of each band
+    uint8_t long_max[22];
+    uint8_t short_max[13];
+} scalefactors;
+
+struct as_mp3_decoder {
+    uint8_t reservoir[AS_MP3_RESERVOIR_CAPACITY];
+    size_t reservoir_size;
+
+    scalefactors scalefactors[2];
+    int32_t values[2][AS_MP3_GRANULE_SIZE];
+    /// The index after the last value decoded from the bitstream, every value after it is zero
+    int nonzero_end[2];
+    float xr[2][AS_MP3_GRANULE_SIZE];
+    float overlap[2][32][18];
+    float subband_samples[2][18][32];
+
+    float synthesis_buffer[2][1024];
+    int synthesis_offset[2];
+
+    float pow43[AS_MP3_POW43_TABLE_SIZE];
+    float imdct_long[36][18];
+    float imdct_short[12][6];
+    /// The long block windows for the block types 0, 1 and 3, and the short window
+    float windows[4][36];
+    float antialias_cs[8];
+    float antialias_ca[8];
+    float synthesis_matrix[64][32];
+    float synthesis_window[512];
+};
+
+// MARK: Header
+
+bool as_mp3_parse_header(const uint8_t *bytes, as_mp3_frame_header *header) {
+    if (bytes[0] != 0xFF || (bytes[1] & 0xE0) != 0xE0) {
+        return false;
+    }
+    int version_bits = (bytes[1] >> 3) & 3;
+    int layer_bits = (bytes[1] >> 1) & 3;
+    int bitrate_index = bytes[2] >> 4;
+    int sample_rate_index = (bytes[2] >> 2) & 3;
+    if (version_bits == 1 || layer_bits != 1 || bitrate_index == 0 || bitrate_index == 15 || sample_rate_index == 3) {
+        return false;
+    }
+    if ((bytes[3] & 3) == 2) {
+        // reserved emphasis
+        return false;
+    }
+
+    as_mp3_version version = version_bits == 3 ? as_mp3_version_1 : (version_bits == 2 ? as_mp3_version_2 : as_mp3_version_2_5);
+    header->version = version;
+    header->has_crc = (bytes[1] & 1) == 0;
+    header->padding = (bytes[2] >> 1) & 1;
+    header->channel_mode = (as_mp3_channel_mode)(bytes[3] >> 6);
+    header->mode_extension = (bytes[3] >> 4) & 3;
+    header->channels = header->channel_mode == as_mp3_channel_mode_mono ? 1 : 2;
+    header->bitrate = bitrates[version == as_mp3_version_1 ? 0 : 1][bitrate_index];
+    header->sample_rate = sample_rates[sample_rate_index] >> version;
+    header->samples_per_frame = version == as_mp3_version_1 ? 1152 : 576;
+    header->frame_size = (uint16_t)((header->samples_per_frame / 8) * header->bitrate * 1000 / header->sample_rate + header->padding);
+    if (version == as_mp3_version_1) {
+        header->side_info_size = header->channels == 1 ? 17 : 32;
+    } else {
+        header->side_info_size = header->channels == 1 ? 9 : 17;
+    }
+    return true;
+}
+
+/// The index of the sample rate in the band tables
+static int band_table_index(const as_mp3_frame_header *header) {
+    uint32_t sample_rate = header->sample_rate << header->version;
+    int index = sample_rate == 44100 ? 0 : (sample_rate == 48000 ? 1 : 2);
+    return (int)header->version * 3 + index;
+}
+
+// MARK: Bit reader
+
+static inline unsigned read_bit(bit_reader *reader) {
+    size_t position = reader->position++;
+    if ((position >> 3) >= reader->size) {
+        return 0;
+    }
+    return (reader->data[position >> 3] >> (7 - (position & 7))) & 1;
+}
+
+static inline unsigned read_bits(bit_reader *reader, int count) {
+    unsigned value = 0;
+    for (int i = 0; i < count; i++) {
+        value = (value << 1) | read_bit(reader);
+    }
+    return value;
+}
+
+// MARK: Decoder
+
+as_mp3_decoder *as_mp3_decoder_create(void) {
+    as_mp3_decoder *decoder = calloc(1, sizeof(as_mp3_decoder));
+    if (decoder == NULL) {
+        return NULL;
+    }
+
+    for (int i = 0; i < AS_MP3_POW43_TABLE_SIZE; i++) {
+        decoder->pow43[i] = (float)pow((double)i, 4.0 / 3.0);
+    }
+
+    for (int i = 0; i < 36; i++) {
+        for (int k = 0; k < 18; k++) {
+            decoder->imdct_long[i][k] = (float)cos(M_PI / 72.0 * (2 * i + 1 + 18) * (2 * k + 1));
+        }
+    }
+    for (int i = 0; i < 12; i++) {
+        for (int k = 0; k < 6; k++) {
+            decoder->imdct_short[i][k] = (float)cos(M_PI / 24.0 * (2 * i + 1 + 6) * (2 * k + 1));
+        }
+    }
+
+    for (int i = 0; i < 36; i++) {
+        decoder->windows[0][i] = (float)sin(M_PI / 36.0 * (i + 0.5));
+    }
+    for (int i = 0; i < 18; i++) {
+        decoder->windows[1][i] = decoder->windows[0][i];
+        decoder->windows[3][i + 18] = decoder->windows[0][i + 18];
+    }
+    for (int i = 18; i < 24; i++) {
+        decoder->windows[1][i] = 1.0f;
+    }
+    for (int i = 24; i < 30; i++) {
+        decoder->windows[1][i] = (float)sin(M_PI / 12.0 * (i - 18 + 0.5));
+    }
+    for (int i = 6; i < 12; i++) {
+        decoder->windows[3][i] = (float)sin(M_PI / 12.0 * (i - 6 + 0.5));
+    }
+    for (int i = 12; i < 18; i++) {
+        decoder->windows[3][i] = 1.0f;
+    }
+    for (int i = 0; i < 12; i++) {
+        decoder->windows[2][i] = (float)sin(M_PI / 12.0 * (i + 0.5));
+    }
+
+    for (int i = 0; i < 8; i++) {
+        double c = alias_coefficients[i];
+        decoder->antialias_cs[i] = (float)(1.0 / sqrt(1.0 + c * c));
+        decoder->antialias_ca[i] = (float)(c / sqrt(1.0 + c * c));
+    }
+
+    for (int i = 0; i < 64; i++) {
+        for (int k = 0; k < 32; k++) {
+            decoder->synthesis_matrix[i][k] = (float)cos((16 + i) * (2 * k + 1) * M_PI / 64.0);
+        }
+    }
+    // the second half of the window mirrors the first one, negated outside the 64 sample boundaries
+    for (int i = 0; i < 257; i++) {
+        float value = as_mp3_synthesis_window[i] / 65536.0f;
+        decoder->synthesis_window[i] = value;
+        if (i != 0) {
+            decoder->synthesis_window[512 - i] = (i & 63) != 0 ? -value : value;
+        }
+    }
+
+    return decoder;
+}
+
+void as_mp3_decoder_destroy(as_mp3_decoder *decoder) {
+    free(decoder);
+}
+
+void as_mp3_decoder_reset(as_mp3_decoder *decoder) {
+    decoder->reservoir_size = 0;
+    memset(decoder->overlap, 0, sizeof(decoder->overlap));
+    memset(decoder->synthesis_buffer, 0, sizeof(decoder->synthesis_buffer));
+    decoder->synthesis_offset[0] = 0;
+    decoder->synthesis_offset[1] = 0;
+}
+
+// MARK: Side information
+
+static bool read_side_info(bit_reader *reader, const as_mp3_frame_header *header, side_info *info) {
+    bool lsf = header->version != as_mp3_version_1;
+    int channels = header->channels;
+    int granules = lsf ? 1 : 2;
+
+    info->main_data_begin = (uint16_t)read_bits(reader, lsf ? 8 : 9);
+    read_bits(reader, lsf ? channels : (channels == 1 ? 5 : 3));
+    if (!lsf) {
+        for (int ch = 0; ch < channels; ch++) {
+            for (int band = 0; band < 4; band++) {
+                info->scfsi[ch][band] = (uint8_t)read_bit(reader);
+            }
+        }
+    }
+
+    for (int gr = 0; gr < granules; gr++) {
+        for (int ch = 0; ch < channels; ch++) {
+            granule_info *granule = &info->granules[gr][ch];
+            granule->part2_3_length = (uint16_t)read_bits(reader, 12);
+            granule->big_values = (uint16_t)read_bits(reader, 9);
+            if (granule->big_values > 288) {
+                return false;
+            }
+            granule->global_gain = (uint16_t)read_bits(reader, 8);
+            granule->scalefac_compress = (uint16_t)read_bits(reader, lsf ? 9 : 4);
+            granule->window_switching = (uint8_t)read_bit(reader);
+            if (granule->window_switching) {
+                granule->block_type = (uint8_t)read_bits(reader, 2);
+                if (granule->block_type == 0) {
+                    return false;
+                }
+                granule->mixed_block = (uint8_t)read_bit(reader);
+                granule->table_select[0] = (uint8_t)read_bits(reader, 5);
+                granule->table_select[1] = (uint8_t)read_bits(reader, 5);
+                granule->table_select[2] = 0;
+                for (int window = 0; window < 3; window++) {
+                    granule->subblock_gain[window] = (uint8_t)read_bits(reader, 3);
+                }
+                granule->region0_count = granule->block_type == 2 && !granule->mixed_block ? 8 : 7;
+                granule->region1_count = 36;
+            } else {
+                granule->block_type = 0;
+                granule->mixed_block = 0;
+                for (int region = 0; region < 3; region++) {
+                    granule->table_select[region] = (uint8_t)read_bits(reader, 5);
+                }
+                memset(granule->subblock_gain, 0, sizeof(granule->subblock_gain));
+                granule->region0_count = (uint8_t)read_bits(reader, 4);
+                granule->region1_count = (uint8_t)read_bits(reader, 3);
+            }
+            granule->preflag = lsf ? 0 : (uint8_t)read_bit(reader);
+            granule->scalefac_scale = (uint8_t)read_bit(reader);
+            granule->count1_table = (uint8_t)read_bit(reader);
+        }
+    }
+    return true;
+}
+
+static inline bool is_short_block(const granule_info *granule) {
+    return granule->window_switching && granule->block_type == 2;
+}
+
+// MARK: Scalefactors
+
+static void read_scalefactors(bit_reader *reader,
+                              const granule_info *granule,
+                              const uint8_t *scfsi,
+                              int gr,
+                              scalefactors *factors)
+{
+    int slen1 = slen_table[0][granule->scalefac_compress];
+    int slen2 = slen_table[1][granule->scalefac_compress];
+
+    if (is_short_block(granule)) {
+        int sfb = 0;
+        if (granule->mixed_block) {
+            for (; sfb < 8; sfb++) {
+                factors->long_bands[sfb] = (uint8_t)read_bits(reader, slen1);
+            }
+            sfb = 3;
+        }
+        for (; sfb < 12; sfb++) {
+            int length = sfb < 6 ? slen1 : slen2;
+            for (int window = 0; window < 3; window++) {
+                factors->short_bands[sfb][window] = (uint8_t)read_bits(reader, length);
+            }
+        }
+        memset(factors->short_bands[12], 0, 3);
+        return;
+    }
+
+    static const int groups[5] = {0, 6, 11, 16, 21};
+    for (int group = 0; group < 4; group++) {
+        if (gr == 1 && scfsi[group]) {
+            continue;
+        }
+        int length = group < 2 ? slen1 : slen2;
+        for (int sfb = groups[group]; sfb < groups[group + 1]; sfb++) {
+            factors->long_bands[sfb] = (uint8_t)read_bits(reader, length);
+        }
+    }
+    factors->long_bands[21] = 0;
+}
+
+static void read_lsf_scalefactors(bit_reader *reader,
+                                  granule_info *granule,
+                                  bool intensity_right_channel,
+                                  scalefactors *factors)
+{
+    int compress = granule->scalefac_compress;
+    int slen[4] = {0, 0, 0, 0};
+    int table;
+
+    if (intensity_right_channel) {
+        compress >>= 1;
+        if (compress < 180) {
+            slen[0] = compress / 36;
+            slen[1] = (compress % 36) / 6;
+            slen[2] = (compress % 36) % 6;
+            table = 3;
+        } else if (compress < 244) {
+            compress -= 180;
+            slen[0] = (compress % 64) >> 4;
+            slen[1] = (compress % 16) >> 2;
+            slen[2] = compress % 4;
+            table = 4;
+        } else {
+            compress -= 244;
+            slen[0] = compress / 3;
+            slen[1] = compress % 3;
+            table = 5;
+        }
+        granule->preflag = 0;
+    } else if (compress < 400) {
+        slen[0] = (compress >> 4) / 5;
+        slen[1] = (compress >> 4) % 5;
+        slen[2] = (compress % 16) >> 2;
+        slen[3] = compress % 4;
+        granule->preflag = 0;
+        table = 0;
+    } else if (compress < 500) {
+        compress -= 400;
+        slen[0] = (compress >> 2) / 5;
+        slen[1] = (compress >> 2) % 5;
+        slen[2] = compress % 4;
+        granule->preflag = 0;
+        table = 1;
+    } else {
+        compress -= 500;
+        slen[0] = compress / 3;
+        slen[1] = compress % 3;
+        granule->preflag = 1;
+        table = 2;
+    }
+
+    int block = is_short_block(granule) ? (granule->mixed_block ? 2 : 1) : 0;
+    uint8_t values[39] = {0};
+    uint8_t maximums[39] = {0};
+    int count = 0;
+    for (int partition = 0; partition < 4; partition++) {
+        for (int i = 0; i < lsf_band_counts[table][block][partition]; i++) {
+            values[count] = (uint8_t)read_bits(reader, slen[partition]);
+            maximums[count] = (uint8_t)((1 << slen[partition]) - 1);
+            count++;
+        }
+    }
+
+    memset(factors->long_bands, 0, sizeof(factors->long_bands));
+    memset(factors->short_bands, 0, sizeof(factors->short_bands));
+    memset(factors->long_max, 0, sizeof(factors->long_max));
+    memset(factors->short_max, 0, sizeof(factors->short_max));
+    if (block == 0) {
+        for (int sfb = 0; sfb < count && sfb < 21; sfb++) {
+            factors->long_bands[sfb] = values[sfb];
+            factors->long_max[sfb] = maximums[sfb];
+        }
+        factors->long_max[21] = factors->long_max[20];
+        return;
+    }
+    int index = 0;
+    int sfb = 0;
+    if (block == 2) {
+        for (; index < 6; index++) {
+            factors->long_bands[index] = values[index];
+            factors->long_max[index] = maximums[index];
+        }
+        sfb = 3;
+    }
+    for (; index + 2 < count && sfb < 12; sfb++) {
+        for (int window = 0; window < 3; window++) {
+            factors->short_bands[sfb][window] = values[index++];
+        }
+        factors->short_max[sfb] = maximums[index - 1];
+    }
+    factors->short_max[12] = factors->short_max[11];
+}
+
+// MARK: Huffman decoding
+
+static inline int huffman_decode(bit_reader *reader, int root) {
+    int node = root;
+    for (;;) {
+        int16_t child = as_mp3_huffman_nodes[node][read_bit(reader)];
+        if (child < 0) {
+            return -child - 1;
+        }
+        node = child;
+    }
+}
+
+static int read_huffman(bit_reader *reader,
+                        const granule_info *granule,
+                        size_t part2_3_end,
+                        int band_index,
+                        int32_t *values)
+{
+    const uint8_t *long_widths = as_mp3_long_band_widths[band_index];
+    int big_values_end = granule->big_values * 2;
+    int region1_start;
+    int region2_start;
+    if (granule->window_switching) {
+        if (granule->block_type == 2) {
+            region1_start = 3 * (as_mp3_short_band_widths[band_index][0] * 3);
+        } else {
+            region1_start = 0;
+            for (int sfb = 0; sfb < 8; sfb++) {
+                region1_start += long_widths[sfb];
+            }
+        }
+        region2_start = AS_MP3_GRANULE_SIZE;
+    } else {
+        region1_start = 0;
+        region2_start = 0;
+        int region1_band = granule->region0_count + 1;
+        int region2_band = granule->region0_count + granule->region1_count + 2;
+        for (int sfb = 0; sfb < 22; sfb++) {
+            if (sfb < region1_band) {
+                region1_start += long_widths[sfb];
+            }
+            if (sfb < region2_band) {
+                region2_start += long_widths[sfb];
+            }
+        }
+    }
+
+    int index = 0;
+    for (; index < big_values_end; index += 2) {
+        int region = index < region1_start ? 0 : (index < region2_start ? 1 : 2);
+        as_mp3_huffman_table table = as_mp3_big_values_tables[granule->table_select[region]];
+        if (table.root < 0) {
+            values[index] = 0;
+            values[index + 1] = 0;
+            continue;
+        }
+        int symbol = huffman_decode(reader, table.root);
+        int32_t x = symbol >> 4;
+        int32_t y = symbol & 15;
+        if (table.linbits && x == 15) {
+            x += (int32_t)read_bits(reader, table.linbits);
+        }
+        if (x && read_bit(reader)) {
+            x = -x;
+        }
+        if (table.linbits && y == 15) {
+            y += (int32_t)read_bits(reader, table.linbits);
+        }
+        if (y && read_bit(reader)) {
+            y = -y;
+        }
+        values[index] = x;
+        values[index + 1] = y;
+    }
+
+    while (index + 4 <= AS_MP3_GRANULE_SIZE && reader->position < part2_3_end) {
+        int symbol = granule->count1_table
+            ? (int)(15 - read_bits(reader, 4))
+            : huffman_decode(reader, as_mp3_count1_table_a);
+        int32_t quad[4];
+        for (int i = 0; i < 4; i++) {
+            quad[i] = (symbol >> (3 - i)) & 1;
+            if (quad[i] && read_bit(reader)) {
+                quad[i] = -1;
+            }
+        }
+        if (reader->position > part2_3_end) {
+            // the last quad overran the granule, it is padding
+            break;
+        }
+        memcpy(values + index, quad, sizeof(quad));
+        index += 4;
+    }
+
+    int nonzero_end = index;
+    for (; index < AS_MP3_GRANULE_SIZE; index++) {
+        values[index] = 0;
+    }
+    return nonzero_end;
+}
+
+// MARK: Requantization
+
+static inline float requantized(const as_mp3_decoder *decoder, int32_t value, float gain) {
+    if (value == 0) {
+        return 0.0f;
+    }
+    int magnitude = value < 0 ? -value : value;
+    if (magnitude >= AS_MP3_POW43_TABLE_SIZE) {
+        magnitude = AS_MP3_POW43_TABLE_SIZE - 1;
+    }
+    float result = decoder->pow43[magnitude] * gain;
+    return value < 0 ? -result : result;
+}
+
+static void requantize(as_mp3_decoder *decoder,
+                       const granule_info *granule,
+                       const scalefactors *factors,
+                       int band_index,
+                       const int32_t *values,
+                       int nonzero_end,
+                       float *xr)
+{
+    const uint8_t *long_widths = as_mp3_long_band_widths[band_index];
+    const uint8_t *short_widths = as_mp3_short_band_widths[band_index];
+    double global = 0.25 * ((int)granule->global_gain - 210);
+    double shift = granule->scalefac_scale ? 1.0 : 0.5;
+    int index = 0;
+    int sfb = 0;
+
+    if (!is_short_block(granule) || granule->mixed_block) {
+        int long_bands = is_short_block(granule) ? (band_index < 3 ? 8 : 6) : 22;
+        for (; sfb < long_bands && index < nonzero_end; sfb++) {
+            int scalefactor = factors->long_bands[sfb] + (granule->preflag ? pretab[sfb] : 0);
+            float gain = (float)exp2(global - shift * scalefactor);
+            for (int i = 0; i < long_widths[sfb]; i++, index++) {
+                xr[index] = requantized(decoder, values[index], gain);
+            }
+        }
+        sfb = 3;
+    }
+    if (is_short_block(granule)) {
+        for (; sfb < 13 && index < nonzero_end; sfb++) {
+            for (int window = 0; window < 3; window++) {
+                double exponent = global - 2.0 * granule->subblock_gain[window] - shift * factors->short_bands[sfb][window];
+                float gain = (float)exp2(exponent);
+                for (int i = 0; i < short_widths[sfb]; i++, index++) {
+                    xr[index] = requantized(decoder, values[index], gain);
+                }
+            }
+        }
+    }
+    for (; index < AS_MP3_GRANULE_SIZE; index++) {
+        xr[index] = 0.0f;
+    }
+}
+
+// MARK: Stereo
+
+static void mid_side_stereo(float *left, float *right, int start, int end) {
+    const float scale = (float)M_SQRT1_2;
+    for (int i = start; i < end; i++) {
+        float mid = left[i];
+        float side = right[i];
+        left[i] = (mid + side) * scale;
+        right[i] = (mid - side) * scale;
+    }
+}
+
+/// Computes the intensity stereo gains of a band, returns `false` for an illegal position
+static bool intensity_gains(const as_mp3_frame_header *header,
+                            const granule_info *right_granule,
+                            int position,
+                            int maximum,
+                            float *left_gain,
+                            float *right_gain)
+{
+    if (header->version == as_mp3_version_1) {
+        if (position >= 7) {
+            return false;
+        }
+        double ratio = tan(position * M_PI / 12.0);
+        *left_gain = (float)(ratio / (1.0 + ratio));
+        *right_gain = (float)(1.0 / (1.0 + ratio));
+        return true;
+    }
+    if (position == maximum) {
+        return false;
+    }
+    double base = (right_granule->scalefac_compress & 1) ? M_SQRT1_2 : 0.840896415253714543;
+    if (position == 0) {
+        *left_gain = 1.0f;
+        *right_gain = 1.0f;
+    } else if (position & 1) {
+        *left_gain = (float)pow(base, (position + 1) / 2);
+        *right_gain = 1.0f;
+    } else {
+        *left_gain = 1.0f;
+        *right_gain = (float)pow(base, position / 2);
+    }
+    return true;
+}
+
+/// Applies intensity or mid side stereo to a band, `position` is negative for bands under the intensity bound
+static void stereo_band(const as_mp3_frame_header *header,
+                        const granule_info *right_granule,
+                        float *left,
+                        float *right,
+                        int start,
+                        int width,
+                        int position,
+                        int maximum,
+                        bool mid_side)
+{
+    float left_gain;
+    float right_gain;
+    if (position >= 0 && intensity_gains(header, right_granule, position, maximum, &left_gain, &right_gain)) {
+        for (int i = start; i < start + width; i++) {
+            float value = left[i];
+            left[i] = value * left_gain;
+            right[i] = value * right_gain;
+        }
+    } else if (mid_side) {
+        mid_side_stereo(left, right, start, start + width);
+    }
+}
+
+static void intensity_stereo(const as_mp3_frame_header *header,
+                             const granule_info *right_granule,
+                             const scalefactors *factors,
+                             int band_index,
+                             float *left,
+                             float *right,
+                             bool mid_side)
+{
+    const uint8_t *long_widths = as_mp3_long_band_widths[band_index];
+    const uint8_t *short_widths = as_mp3_short_band_widths[band_index];
+    bool lsf = header->version != as_mp3_version_1;
+
+    if (!is_short_block(right_granule)) {
+        int last = AS_MP3_GRANULE_SIZE - 1;
+        while (last >= 0 && right[last] == 0.0f) {
+            last--;
+        }
+        int start = 0;
+        for (int sfb = 0; sfb < 22; sfb++) {
+            int width = long_widths[sfb];
+            int factor = sfb < 21 ? sfb : 20;
+            int position = start > last ? factors->long_bands[factor] : -1;
+            int maximum = lsf ? factors->long_max[factor] : 7;
+            stereo_band(header, right_granule, left, right, start, width, position, maximum, mid_side);
+            start += width;
+        }
+        return;
+    }
+
+    int long_bands = right_granule->mixed_block ? (band_index < 3 ? 8 : 6) : 0;
+    int short_start = 0;
+    for (int sfb = 0; sfb < long_bands; sfb++) {
+        short_start += long_widths[sfb];
+    }
+    int first_short_band = right_granule->mixed_block ? 3 : 0;
+
+    // the last non zero band of each window of the right channel
+    int last_band[3] = {-1, -1, -1};
+    int start = short_start;
+    for (int sfb = first_short_band; sfb < 13; sfb++) {
+        for (int window = 0; window < 3; window++) {
+            for (int i = 0; i < short_widths[sfb]; i++) {
+                if (right[start + i] != 0.0f) {
+                    last_band[window] = sfb;
+                    break;
+                }
+            }
+            start += short_widths[sfb];
+        }
+    }
+
+    if (long_bands > 0) {
+        bool short_part_is_zero = last_band[0] < 0 && last_band[1] < 0 && last_band[2] < 0;
+        int last = short_start - 1;
+        while (last >= 0 && right[last] == 0.0f) {
+            last--;
+        }
+        int band_start = 0;
+        for (int sfb = 0; sfb < long_bands; sfb++) {
+            int width = long_widths[sfb];
+            int position = short_part_is_zero && band_start > last ? factors->long_bands[sfb] : -1;
+            int maximum = lsf ? factors->long_max[sfb] : 7;
+            stereo_band(header, right_granule, left, right, band_start, width, position, maximum, mid_side);
+            band_start += width;
+        }
+    }
+
+    start = short_start;
+    for (int sfb = first_short_band; sfb < 13; sfb++) {
+        int factor = sfb < 12 ? sfb : 11;
+        for (int window = 0; window < 3; window++) {
+            int position = sfb > last_band[window] ? factors->short_bands[factor][window] : -1;
+            int maximum = lsf ? factors->short_max[factor] : 7;
+            stereo_band(header, right_granule, left, right, start, short_widths[sfb], position, maximum, mid_side);
+            start += short_widths[sfb];
+        }
+    }
+}
+
+// MARK: Reordering, antialiasing and hybrid synthesis
+
+/// Interleaves the windows of short blocks, so that each subband holds its 6 frequency lines as window triplets
+static void reorder(const granule_info *granule, int band_index, float *xr) {
+    const uint8_t *long_widths = as_mp3_long_band_widths[band_index];
+    const uint8_t *short_widths = as_mp3_short_band_widths[band_index];
+    float reordered[AS_MP3_GRANULE_SIZE];
+    int start = 0;
+    int sfb = 0;
+    if (granule->mixed_block) {
+        int long_bands = band_index < 3 ? 8 : 6;
+        for (int band = 0; band < long_bands; band++) {
+            start += long_widths[band];
+        }
+        sfb = 3;
+    }
+    int first = start;
+    for (; sfb < 13; sfb++) {
+        int width = short_widths[sfb];
+        for (int window = 0; window < 3; window++) {
+            for (int i = 0; i < width; i++) {
+                reordered[start + 3 * i + window] = xr[start + window * width + i];
+            }
+        }
+        start += 3 * width;
+    }
+    memcpy(xr + first, reordered + first, sizeof(float) * (size_t)(AS_MP3_GRANULE_SIZE - first));
+}
+
+static void antialias(const as_mp3_decoder *decoder, const granule_info *granule, float *xr) {
+    int subbands = 32;
+    if (is_short_block(granule)) {
+        if (!granule->mixed_block) {
+            return;
+        }
+        subbands = 2;
+    }
+    for (int sb = 1; sb < subbands; sb++) {
+        float *boundary = xr + 18 * sb;
+        for (int i = 0; i < 8; i++) {
+            float lower = boundary[-1 - i];
+            float upper = boundary[i];
+            boundary[-1 - i] = lower * decoder->antialias_cs[i] - upper * decoder->antialias_ca[i];
+            boundary[i] = upper * decoder->antialias_cs[i] + lower * decoder->antialias_ca[i];
+        }
+    }
+}
+
+static void hybrid_synthesis(as_mp3_decoder *decoder, const granule_info *granule, int ch, const float *xr) {
+    for (int sb = 0; sb < 32; sb++) {
+        const float *input = xr + 18 * sb;
+        float output[36];
+        bool short_window = is_short_block(granule) && !(granule->mixed_block && sb < 2);
+
+        if (short_window) {
+            memset(output, 0, sizeof(output));
+            for (int window = 0; window < 3; window++) {
+                for (int i = 0; i < 12; i++) {
+                    float sum = 0.0f;
+                    for (int k = 0; k < 6; k++) {
+                        sum += input[3 * k + window] * decoder->imdct_short[i][k];
+                    }
+                    output[6 + 6 * window + i] += sum * decoder->windows[2][i];
+                }
+            }
+        } else {
+            const float *window = decoder->windows[is_short_block(granule) ? 0 : granule->block_type];
+            for (int i = 0; i < 36; i++) {
+                float sum = 0.0f;
+                for (int k = 0; k < 18; k++) {
+                    sum += input[k] * decoder->imdct_long[i][k];
+                }
+                output[i] = sum * window[i];
+            }
+        }
+
+        float *overlap = decoder->overlap[ch][sb];
+        for (int i = 0; i < 18; i++) {
+            float sample = output[i] + overlap[i];
+            overlap[i] = output[i + 18];
+            // frequency inversion of the odd subbands
+            if ((sb & 1) && (i & 1)) {
+                sample = -sample;
+            }
+            decoder->subband_samples[ch][i][sb] = sample;
+        }
+    }
+}
+
+// MARK: Polyphase synthesis
+
+static void polyphase_synthesis(as_mp3_decoder *decoder, int ch, const float *subbands, float *pcm, int stride) {
+    float *buffer = decoder->synthesis_buffer[ch];
+    int offset = (decoder->synthesis_offset[ch] - 64) & 1023;
+    decoder->synthesis_offset[ch] = offset;
+
+    for (int i = 0; i < 64; i++) {
+        float sum = 0.0f;
+        const float *row = decoder->synthesis_matrix[i];
+        for (int k = 0; k < 32; k++) {
+            sum += row[k] * subbands[k];
+        }
+        buffer[(offset + i) & 1023] = sum;
+    }
+
+    const float *window = decoder->synthesis_window;
+    for (int j = 0; j < 32; j++) {
+        float sum = 0.0f;
+        for (int m = 0; m < 8; m++) {
+            sum += buffer[(offset + 128 * m + j) & 1023] * window[64 * m + j];
+            sum += buffer[(offset + 128 * m + 96 + j) & 1023] * window[64 * m + 32 + j];
+        }
+        pcm[j * stride] = sum;
+    }
+}
+
+// MARK: Frame decoding
+
+int as_mp3_decode_frame(as_mp3_decoder *decoder,
+                        const uint8_t *frame,
+                        size_t size,
+                        float *pcm,
+                        as_mp3_frame_header *header_out)
+{
+    as_mp3_frame_header header;
+    if (size < 4 || !as_mp3_parse_header(frame, &header) || size < header.frame_size) {
+        return -1;
+    }
+    if (header_out != NULL) {
+        *header_out = header;
+    }
+
+    size_t side_info_start = 4 + (header.has_crc ? 2 : 0);
+    size_t main_data_start = side_info_start + header.side_info_size;
+    if (main_data_start > header.frame_size) {
+        return -1;
+    }
+
+    side_info info;
+    memset(&info, 0, sizeof(info));
+    bit_reader side_reader = {frame + side_info_start, header.side_info_size, 0};
+    if (!read_side_info(&side_reader, &header, &info)) {
+        return -1;
+    }
+
+    // append the main data of this frame to the bit reservoir
+    size_t main_data_size = header.frame_size - main_data_start;
+    if (decoder->reservoir_size > AS_MP3_MAX_MAIN_DATA_BEGIN) {
+        size_t keep = AS_MP3_MAX_MAIN_DATA_BEGIN;
+        memmove(decoder->reservoir, decoder->reservoir + decoder->reservoir_size - keep, keep);
+        decoder->reservoir_size = keep;
+    }
+    bool has_main_data = info.main_data_begin <= decoder->reservoir_size;
+    size_t main_data_begin = decoder->reservoir_size - (has_main_data ? info.main_data_begin : 0);
+    memcpy(decoder->reservoir + decoder->reservoir_size, frame + main_data_start, main_data_size);
+    decoder->reservoir_size += main_data_size;
+
+    bit_reader reader = {decoder->reservoir, decoder->reservoir_size, main_data_begin * 8};
+    int channels = header.channels;
+    int granules = header.version == as_mp3_version_1 ? 2 : 1;
+    int band_index = band_table_index(&header);
+    bool mid_side = header.channel_mode == as_mp3_channel_mode_joint_stereo && (header.mode_extension & 2);
+    bool intensity = header.channel_mode == as_mp3_channel_mode_joint_stereo && (header.mode_extension & 1);
+
+    for (int gr = 0; gr < granules; gr++) {
+        for (int ch = 0; ch < channels; ch++) {
+            granule_info *granule = &info.granules[gr][ch];
+            if (!has_main_data) {
+                memset(decoder->xr[ch], 0, sizeof(decoder->xr[ch]));
+                continue;
+            }
+            size_t part2_start = reader.position;
+            if (header.version == as_mp3_version_1) {
+                read_scalefactors(&reader, granule, info.scfsi[ch], gr, &decoder->scalefactors[ch]);
+            } else {
+                read_lsf_scalefactors(&reader, granule, intensity && ch == 1, &decoder->scalefactors[ch]);
+            }
+            size_t part2_3_end = part2_start + granule->part2_3_length;
+            decoder->nonzero_end[ch] = read_huffman(&reader, granule, part2_3_end, band_index, decoder->values[ch]);
+            reader.position = part2_3_end;
+            requantize(decoder, granule, &decoder->scalefactors[ch], band_index,
+                       decoder->values[ch], decoder->nonzero_end[ch], decoder->xr[ch]);
+        }
+
+        if (channels == 2 && has_main_data) {
+            if (intensity) {
+                intensity_stereo(&header, &info.granules[gr][1], &decoder->scalefactors[1], band_index,
+                                 decoder->xr[0], decoder->xr[1], mid_side);
+            } else if (mid_side) {
+                mid_side_stereo(decoder->xr[0], decoder->xr[1], 0, AS_MP3_GRANULE_SIZE);
+            }
+        }
+
+        for (int ch = 0; ch < channels; ch++) {
+            granule_info *granule = &info.granules[gr][ch];
+            if (has_main_data && is_short_block(granule)) {
+                reorder(granule, band_index, decoder->xr[ch]);
+            }
+            antialias(decoder, granule, decoder->xr[ch]);
+            hybrid_synthesis(decoder, granule, ch, decoder->xr[ch]);
+            for (int slot = 0; slot < 18; slot++) {
+                float *output = pcm + (size_t)(gr * AS_MP3_GRANULE_SIZE + slot * 32) * (size_t)channels + (size_t)ch;
+                polyphase_synthesis(decoder, ch, decoder->subband_samples[ch][slot], output, channels);
+            }
+        }
+    }
+
+    return header.samples_per_frame;
+}
@@ -0,0 +1,245 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+#include "MP3Tables.h"
+
+/// The Huffman code trees of the big values tables and the count1 table A, as defined in ISO/IEC 11172-3 Annex B.
+/// A positive child is the index of the next node, a negative child is a leaf holding `-(symbol + 1)`,
+/// where the symbol of a big values table is `(x << 4) | y` and the symbol of a count1 table is `vwxy`.
+const int16_t as_mp3_huffman_nodes[AS_MP3_HUFFMAN_NODE_COUNT][2] = {
+    {1, -1}, {2, -17}, {-18, -2}, {4, -1}, {5, 10}, {6, -18}, {7, 9}, {8, -19},
+    {-35, -3}, {-34, -33}, {-2, -17}, {12, 18}, {13, -18}, {14, -17}, {15, 17}, {16, -19},
+    {-35, -3}, {-34, -33}, {-2, -1}, {20, -1}, {21, 33}, {22, -18}, {23, 30}, {24, 27},
+    {25, -50}, {26, -51}, {-52, -36}, {28, 29}, {-20, -4}, {-49, -35}, {31, 32}, {-19, -34},
+    {-3, -33}, {-2, -17}, {35, 47}, {36, 45}, {37, 43}, {38, 42}, {39, 41}, {40, -36},
+    {-52, -4}, {-51, -49}, {-20, -50}, {44, -19}, {-35, -3}, {46, -2}, {-34, -33}, {-18, 48},
+    {-17, -1}, {50, -1}, {51, 83}, {52, 80}, {53, 72}, {54, 68}, {55, 63}, {56, 61},
+    {57, 60}, {58, 59}, {-86, -70}, {-85, -84}, {-54, -69}, {62, -22}, {-38, -83}, {64, 66},
+    {-82, 65}, {-6, -53}, {-81, 67}, {-68, -52}, {69, 71}, {70, -21}, {-37, -67}, {-66, -65},
+    {73, 78}, {74, 77}, {75, 76}, {-5, -36}, {-51, -4}, {-20, -50}, {79, -19}, {-49, -35},
+    {81, -18}, {-34, 82}, {-3, -33}, {-2, -17}, {85, 117}, {86, -18}, {87, 116}, {88, 110},
+    {89, 104}, {90, 99}, {91, 97}, {92, 95}, {93, -84}, {94, -70}, {-86, -85}, {96, -38},
+    {-54, -69}, {98, -22}, {-83, -6}, {100, 102}, {-82, 101}, {-53, -68}, {103, -37}, {-81, -52},
+    {105, 107}, {106, -66}, {-67, -21}, {108, 109}, {-5, -65}, {-36, -51}, {111, 115}, {112, -35},
+    {113, 114}, {-20, -50}, {-4, -49}, {-3, -33}, {-19, -34}, {118, -1}, {-2, -17}, {120, 151},
+    {121, 147}, {122, 142}, {123, 137}, {124, 133}, {125, 130}, {126, 128}, {127, -54}, {-86, -70},
+    {-84, 129}, {-85, -6}, {131, 132}, {-69, -38}, {-83, -22}, {134, 135}, {-82, -53}, {-68, 136},
+    {-81, -5}, {138, 141}, {139, 140}, {-37, -67}, {-52, -65}, {-21, -66}, {143, 145}, {144, -20},
+    {-36, -51}, {-50, 146}, {-4, -49}, {148, 150}, {149, -19}, {-35, -3}, {-34, -33}, {152, 153},
+    {-18, -2}, {-17, -1}, {155, -1}, {156, 216}, {157, 212}, {158, 199}, {159, 186}, {160, 177},
+    {161, 171}, {162, 168}, {163, 166}, {164, 165}, {-120, -104}, {-119, -88}, {167, -72}, {-118, -103},
+    {169, 170}, {-117, -87}, {-102, -56}, {172, 176}, {173, 174}, {-116, -71}, {175, -100}, {-86, -85},
+    {-40, -115}, {178, 183}, {179, 181}, {180, -113}, {-101, -8}, {-99, 182}, {-70, -54}, {184, -24},
+    {-7, 185}, {-84, -69}, {187, 195}, {188, 190}, {-114, 189}, {-55, -39}, {191, 193}, {192, -22},
+    {-38, -83}, {-82, 194}, {-53, -68}, {196, 197}, {-23, -98}, {-97, 198}, {-6, -81}, {200, 209},
+    {201, 206}, {202, 205}, {203, 204}, {-37, -67}, {-52, -5}, {-21, -66}, {207, 208}, {-65, -36},
+    {-51, -4}, {210, 211}, {-20, -50}, {-49, -35}, {213, -18}, {214, 215}, {-19, -34}, {-3, -33},
+    {-2, -17}, {218, 278}, {219, 275}, {220, 264}, {221, 250}, {222, 243}, {223, 236}, {224, 232},
+    {225, 228}, {226, 227}, {-120, -104}, {-119, -118}, {229, 230}, {-103, -72}, {-117, 231}, {-88, -86},
+    {233, 235}, {234, -56}, {-87, -102}, {-116, -71}, {237, 241}, {238, -40}, {239, 240}, {-70, -85},
+    {-54, -84}, {-115, 242}, {-101, -8}, {244, 246}, {-114, 245}, {-24, -113}, {247, 248}, {-55, -100},
+    {-97, 249}, {-69, -38}, {251, 257}, {252, 255}, {253, -99}, {254, -22}, {-83, -6}, {256, -23},
+    {-39, -7}, {258, 260}, {-98, 259}, {-82, -53}, {261, 263}, {-81, 262}, {-68, -52}, {-37, -67},
+    {265, 272}, {266, 271}, {267, 270}, {268, 269}, {-21, -66}, {-5, -65}, {-36, -51}, {-20, -50},
+    {273, -34}, {274, -35}, {-4, -49}, {276, -18}, {-19, 277}, {-3, -33}, {279, -1}, {-2, -17},
+    {281, 338}, {282, 331}, {283, 319}, {284, 306}, {285, 298}, {286, 294}, {287, 291}, {288, 290},
+    {289, -119}, {-120, -104}, {-88, -118}, {292, 293}, {-103, -72}, {-117, -102}, {295, 296}, {-87, -56},
+    {297, -40}, {-116, -86}, {299, 302}, {300, 301}, {-115, -71}, {-101, -24}, {303, 305}, {-114, 304},
+    {-8, -113}, {-55, -100}, {307, 313}, {308, 312}, {309, 310}, {-70, -85}, {-69, 311}, {-7, -6},
+    {-39, -99}, {314, 316}, {-98, 315}, {-23, -97}, {317, 318}, {-54, -84}, {-38, -83}, {320, 328},
+    {321, 324}, {322, 323}, {-22, -82}, {-53, -68}, {325, 327}, {326, -37}, {-81, -5}, {-67, -21},
+    {329, 330}, {-52, -66}, {-36, -51}, {332, 337}, {333, 336}, {334, -20}, {335, -49}, {-65, -4},
+    {-50, -35}, {-19, -34}, {339, 342}, {340, -18}, {341, -1}, {-3, -33}, {-2, -17}, {344, -1},
+    {345, 596}, {346, 583}, {347, 549}, {348, 514}, {349, 481}, {350, 452}, {351, 427}, {352, 409},
+    {353, 394}, {354, 380}, {355, 372}, {356, 366}, {357, 363}, {358, 362}, {359, -256}, {360, -238},
+    {361, -254}, {-255, -253}, {-240, -224}, {364, 365}, {-239, -208}, {-223, -192}, {367, 371}, {368, 369},
+    {-252, -207}, {-221, 370}, {-176, -234}, {-237, -222}, {373, 377}, {374, 376}, {375, -191}, {-251, -206},
+    {-236, -160}, {378, 379}, {-250, -235}, {-190, -220}, {381, 389}, {382, 386}, {383, 384}, {-144, -249},
+    {-205, 385}, {-175, -159}, {387, -248}, {-143, 388}, {-128, -127}, {390, 392}, {-219, 391}, {-174, -189},
+    {393, -112}, {-204, -247}, {395, 402}, {396, 399}, {397, 398}, {-233, -96}, {-158, -218}, {400, 401},
+    {-246, -232}, {-173, -188}, {403, 407}, {404, 405}, {-80, -245}, {406, -244}, {-203, -231}, {-64, 408},
+    {-142, -217}, {410, 420}, {411, 415}, {412, 413}, {-48, -243}, {414, -16}, {-111, -157}, {416, 418},
+    {417, -172}, {-202, -95}, {419, -79}, {-126, -216}, {421, 426}, {422, 424}, {423, -63}, {-201, -215},
+    {-186, 425}, {-156, -171}, {-32, -242}, {428, 439}, {429, 435}, {430, 432}, {-241, 431}, {-187, -230},
+    {433, 434}, {-229, -141}, {-110, -228}, {436, 438}, {-227, 437}, {-47, -15}, {-31, -226}, {440, 447},
+    {441, 444}, {442, 443}, {-225, -94}, {-214, -125}, {445, 446}, {-200, -78}, {-140, -185}, {448, 451},
+    {449, 450}, {-213, -155}, {-170, -109}, {-199, -62}, {453, 471}, {454, 464}, {455, 459}, {456, 458},
+    {457, -46}, {-212, -124}, {-211, -30}, {460, 462}, {-184, 461}, {-93, -198}, {463, -196}, {-154, -123},
+    {465, 468}, {466, -210}, {467, -76}, {-168, -152}, {469, 470}, {-14, -209}, {-139, -169}, {472, 477},
+    {473, 476}, {474, 475}, {-77, -197}, {-108, -183}, {-61, -45}, {478, 479}, {-195, -92}, {480, -29},
+    {-182, -138}, {482, 503}, {483, 494}, {484, 489}, {485, 487}, {-194, 486}, {-153, -13}, {-193, 488},
+    {-181, -107}, {490, 492}, {491, -60}, {-167, -122}, {-180, 493}, {-137, -91}, {495, 500}, {496, 498},
+    {-44, 497}, {-166, -106}, {-165, 499}, {-121, -136}, {501, -179}, {-149, 502}, {-120, -119}, {504, 509},
+    {505, 506}, {-28, -178}, {507, 508}, {-12, -177}, {-151, -75}, {510, 513}, {511, 512}, {-59, -164},
+    {-90, -150}, {-43, -163}, {515, 538}, {516, 527}, {517, 521}, {518, 519}, {-27, -162}, {520, -161},
+    {-11, -105}, {522, 524}, {523, -148}, {-135, -74}, {525, 526}, {-58, -89}, {-134, -104}, {528, 532},
+    {529, 530}, {-42, -147}, {531, -57}, {-88, -118}, {533, 535}, {-132, 534}, {-103, -72}, {536, 537},
+    {-117, -87}, {-102, -116}, {539, 544}, {540, 541}, {-26, -146}, {542, 543}, {-10, -145}, {-73, -133},
+    {545, 548}, {546, -41}, {-115, 547}, {-71, -101}, {-131, -25}, {550, 570}, {551, 564}, {552, 557},
+    {553, 555}, {554, -24}, {-56, -40}, {-114, 556}, {-86, -8}, {558, 561}, {559, 560}, {-113, -55},
+    {-100, -70}, {562, 563}, {-85, -39}, {-99, -54}, {565, 567}, {-130, 566}, {-9, -129}, {568, 569},
+    {-23, -98}, {-7, -97}, {571, 577}, {572, 576}, {573, 575}, {574, -38}, {-84, -69}, {-83, -6},
+    {-22, -82}, {578, 581}, {579, 580}, {-53, -68}, {-81, -37}, {582, -21}, {-67, -52}, {584, 593},
+    {585, 590}, {586, 588}, {-66, 587}, {-5, -65}, {589, -20}, {-36, -51}, {591, 592}, {-50, -4},
+    {-49, -35}, {594, 595}, {-19, -34}, {-3, -33}, {597, -17}, {-18, -2}, {599, 846}, {600, 822},
+    {601, 778}, {602, 733}, {603, 694}, {604, 661}, {605, 643}, {606, 627}, {607, 620}, {608, 614},
+    {609, 612}, {610, 611}, {-256, -240}, {-255, -224}, {-239, 613}, {-254, -208}, {615, 618}, {616, 617},
+    {-253, -223}, {-238, -192}, {-252, 619}, {-207, -237}, {621, 624}, {622, 623}, {-222, -176}, {-251, -191},
+    {625, 626}, {-236, -206}, {-221, -160}, {628, 635}, {629, 632}, {630, 631}, {-250, -235}, {-190, -220},
+    {633, 634}, {-144, -249}, {-205, -159}, {636, 639}, {637, 638}, {-234, -128}, {-248, -174}, {640, 641},
+    {-219, -189}, {-112, 642}, {-175, -16}, {644, 653}, {645, 650}, {646, 647}, {-204, -247}, {648, 649},
+    {-143, -233}, {-96, -158}, {651, 652}, {-246, -127}, {-232, -173}, {654, 658}, {655, 656}, {-203, -188},
+    {657, -80}, {-218, -142}, {659, 660}, {-245, -64}, {-244, -217}, {662, 678}, {663, 671}, {664, 668},
+    {665, 666}, {-231, -48}, {-243, 667}, {-111, -241}, {669, 670}, {-32, -242}, {-157, -202}, {672, 675},
+    {673, 674}, {-95, -172}, {-187, -230}, {676, 677}, {-126, -216}, {-79, -229}, {679, 686}, {680, 683},
+    {681, 682}, {-141, -201}, {-63, -110}, {684, 685}, {-215, -228}, {-156, -186}, {687, 690}, {688, 689},
+    {-47, -171}, {-227, -31}, {691, 693}, {-226, 692}, {-15, -225}, {-94, -214}, {695, 717}, {696, 708},
+    {697, 703}, {698, 701}, {699, 700}, {-125, -200}, {-78, -140}, {-213, 702}, {-185, -155}, {704, 707},
+    {705, 706}, {-170, -109}, {-199, -62}, {-212, -211}, {709, 713}, {710, 712}, {711, -30}, {-46, -14},
+    {-124, -184}, {714, 716}, {-210, 715}, {-93, -209}, {-198, -139}, {718, 726}, {719, 722}, {720, 721},
+    {-169, -77}, {-197, -108}, {723, 725}, {-183, 724}, {-154, -13}, {-61, -196}, {727, 731}, {728, 729},
+    {-123, -168}, {-167, 730}, {-193, -12}, {-195, 732}, {-45, -92}, {734, 761}, {735, 749}, {736, 743},
+    {737, 740}, {738, 739}, {-182, -29}, {-138, -153}, {741, 742}, {-194, -76}, {-181, -107}, {744, 746},
+    {745, -180}, {-60, -122}, {747, 748}, {-152, -137}, {-44, -91}, {750, 755}, {751, 753}, {-179, 752},
+    {-166, -28}, {-178, 754}, {-177, -106}, {756, 759}, {757, 758}, {-151, -75}, {-165, -121}, {760, -164},
+    {-136, -59}, {762, 770}, {763, 766}, {764, 765}, {-90, -150}, {-43, -163}, {767, 768}, {-27, -162},
+    {769, -105}, {-11, -161}, {771, 774}, {772, 773}, {-135, -74}, {-149, -58}, {775, 777}, {-148, 776},
+    {-120, -10}, {-89, -134}, {779, 805}, {780, 794}, {781, 787}, {782, 785}, {783, 784}, {-42, -104},
+    {-119, -147}, {-146, 786}, {-26, -145}, {788, 791}, {789, 790}, {-73, -133}, {-88, -118}, {792, 793},
+    {-57, -132}, {-103, -72}, {795, 798}, {796, 797}, {-41, -131}, {-25, -130}, {799, 802}, {800, 801},
+    {-117, -9}, {-129, -87}, {803, 804}, {-102, -56}, {-116, -71}, {806, 814}, {807, 810}, {808, 809},
+    {-40, -115}, {-101, -24}, {811, 812}, {-86, -114}, {813, -55}, {-8, -113}, {815, 818}, {816, 817},
+    {-100, -70}, {-85, -39}, {819, 820}, {-99, -23}, {821, -54}, {-7, -97}, {823, 839}, {824, 833},
+    {825, 829}, {826, 828}, {-98, 827}, {-84, -69}, {-38, -83}, {830, 831}, {-22, -82}, {832, -53},
+    {-6, -81}, {834, 837}, {835, 836}, {-68, -37}, {-67, -52}, {-66, 838}, {-21, -5}, {840, 844},
+    {841, 842}, {-36, -51}, {843, -20}, {-65, -4}, {845, -35}, {-50, -49}, {847, 851}, {848, -18},
+    {849, 850}, {-19, -34}, {-3, -33}, {852, -1}, {-2, -17}, {854, -1}, {855, 1106}, {856, 1086},
+    {857, 1018}, {858, 909}, {859, 877}, {860, 873}, {861, 868}, {862, 865}, {863, 864}, {-240, -255},
+    {-224, -254}, {866, 867}, {-208, -253}, {-192, -252}, {869, 871}, {-176, 870}, {-251, -160}, {872, -144},
+    {-250, -249}, {874, -256}, {875, 876}, {-128, -248}, {-112, -247}, {878, 882}, {879, 881}, {880, -80},
+    {-96, -246}, {-245, -244}, {883, -243}, {-241, 884}, {-64, 885}, {886, 900}, {887, 896}, {888, 894},
+    {889, 892}, {890, -223}, {-207, 891}, {-237, -222}, {-234, 893}, {-235, -218}, {-239, 895}, {-238, -236},
+    {897, 898}, {-191, -206}, {899, -175}, {-221, -220}, {901, 906}, {902, 904}, {-205, 903}, {-174, -219},
+    {905, -203}, {-127, -173}, {907, -190}, {908, -95}, {-202, -126}, {910, 956}, {911, 913}, {912, -32},
+    {-48, -16}, {-242, 914}, {915, 939}, {916, 928}, {917, 923}, {918, 920}, {-159, 919}, {-189, -204},
+    {921, 922}, {-143, -233}, {-158, -232}, {924, 927}, {925, 926}, {-188, -142}, {-217, -111}, {-231, -157},
+    {929, 935}, {930, 933}, {931, 932}, {-172, -187}, {-230, -216}, {-79, 934}, {-229, -141}, {936, 937},
+    {-201, -63}, {-110, 938}, {-215, -156}, {940, 949}, {941, 946}, {942, 944}, {943, -226}, {-186, -171},
+    {-213, 945}, {-185, -170}, {947, -228}, {-124, 948}, {-184, -209}, {950, 953}, {951, 952}, {-15, -225},
+    {-94, -214}, {954, 955}, {-125, -200}, {-78, -140}, {957, 994}, {958, 980}, {959, 972}, {960, 966},
+    {961, 964}, {962, 963}, {-155, -109}, {-199, -62}, {965, -14}, {-93, -198}, {967, 970}, {968, 969},
+    {-139, -169}, {-154, -77}, {971, -61}, {-183, -123}, {973, 978}, {974, 976}, {975, -29}, {-92, -138},
+    {-193, 977}, {-153, -122}, {-227, 979}, {-47, -31}, {981, 988}, {982, 985}, {983, 984}, {-212, -46},
+    {-211, -210}, {986, -30}, {-60, 987}, {-152, -137}, {989, 992}, {990, 991}, {-197, -108}, {-196, -168},
+    {-45, 993}, {-195, -182}, {995, 1006}, {996, 1002}, {997, 1000}, {998, 999}, {-194, -13}, {-76, -181},
+    {1001, -180}, {-107, -167}, {1003, 1005}, {1004, -44}, {-91, -166}, {-179, -28}, {1007, 1013}, {1008, 1010},
+    {-178, 1009}, {-12, -177}, {1011, 1012}, {-106, -151}, {-75, -165}, {1014, 1016}, {1015, -164}, {-121, -136},
+    {1017, -43}, {-59, -90}, {1019, 1067}, {1020, 1048}, {1021, 1037}, {1022, 1031}, {1023, 1028}, {1024, 1026},
+    {1025, -162}, {-150, -105}, {1027, -149}, {-135, -120}, {1029, -163}, {1030, -104}, {-74, -88}, {1032, 1034},
+    {-27, 1033}, {-11, -161}, {1035, 1036}, {-58, -148}, {-89, -134}, {1038, 1042}, {1039, 1040}, {-42, -147},
+    {1041, -26}, {-119, -10}, {1043, 1045}, {-146, 1044}, {-145, -73}, {1046, 1047}, {-133, -118}, {-57, -132},
+    {1049, 1059}, {1050, 1055}, {1051, 1053}, {1052, -131}, {-103, -41}, {1054, -25}, {-72, -117}, {1056, 1057},
+    {-130, -129}, {1058, -56}, {-9, -87}, {1060, 1064}, {1061, 1063}, {-116, 1062}, {-102, -71}, {-40, -115},
+    {1065, -24}, {1066, -8}, {-101, -86}, {1068, 1079}, {1069, 1075}, {1070, 1072}, {-114, 1071}, {-113, -55},
+    {1073, 1074}, {-100, -70}, {-85, -39}, {1076, 1077}, {-99, -23}, {-98, 1078}, {-7, -97}, {1080, 1084},
+    {1081, 1083}, {-84, 1082}, {-54, -69}, {-38, -83}, {-82, 1085}, {-22, -6}, {1087, 1103}, {1088, 1099},
+    {1089, 1095}, {1090, 1093}, {1091, 1092}, {-53, -68}, {-81, -37}, {1094, -21}, {-67, -52}, {1096, 1098},
+    {-66, 1097}, {-5, -65}, {-36, -51}, {1100, 1101}, {-20, -50}, {1102, -35}, {-4, -49}, {1104, 1105},
+    {-19, -34}, {-3, -33}, {1107, -17}, {-18, -2}, {1109, 1334}, {1110, 1168}, {1111, 1132}, {1112, 1124},
+    {1113, 1120}, {1114, 1117}, {1115, 1116}, {-240, -255}, {-224, -254}, {1118, 1119}, {-208, -253}, {-192, -252},
+    {1121, 1123}, {-251, 1122}, {-176, -160}, {-250, -249}, {1125, 1129}, {1126, 1128}, {1127, -248}, {-144, -128},
+    {-112, -247}, {1130, 1131}, {-96, -246}, {-80, -245}, {1133, -256}, {1134, 1137}, {1135, 1136}, {-64, -244},
+    {-48, -243}, {1138, 1140}, {-242, 1139}, {-32, -241}, {1141, 1153}, {1142, 1146}, {-16, 1143}, {1144, 1145},
+    {-239, -223}, {-238, -207}, {1147, 1150}, {1148, 1149}, {-237, -222}, {-191, -236}, {1151, 1152}, {-206, -221},
+    {-175, -235}, {1154, 1161}, {1155, 1158}, {1156, 1157}, {-190, -220}, {-205, -159}, {1159, 1160}, {-234, -174},
+    {-219, -189}, {1162, 1165}, {1163, 1164}, {-204, -143}, {-233, -158}, {1166, 1167}, {-218, -127}, {-232, -173},
+    {1169, 1286}, {1170, 1241}, {1171, 1209}, {1172, 1194}, {1173, 1185}, {1174, 1181}, {1175, 1178}, {1176, 1177},
+    {-203, -188}, {-142, -217}, {1179, -231}, {1180, -14}, {-15, -225}, {1182, 1184}, {1183, -202}, {-111, -157},
+    {-95, -187}, {1186, 1190}, {1187, 1189}, {-230, 1188}, {-172, -126}, {-216, -229}, {1191, 1192}, {-141, -201},
+    {1193, -63}, {-79, -47}, {1195, 1202}, {1196, 1199}, {1197, 1198}, {-110, -215}, {-228, -156}, {1200, 1201},
+    {-186, -171}, {-227, -31}, {1203, 1206}, {1204, 1205}, {-226, -94}, {-214, -125}, {1207, 1208}, {-200, -78},
+    {-140, -185}, {1210, 1225}, {1211, 1218}, {1212, 1215}, {1213, 1214}, {-213, -155}, {-170, -109}, {1216, 1217},
+    {-199, -62}, {-212, -46}, {1219, 1222}, {1220, 1221}, {-211, -30}, {-124, -184}, {1223, 1224}, {-210, -93},
+    {-198, -139}, {1226, 1234}, {1227, 1230}, {1228, 1229}, {-169, -154}, {-77, -197}, {1231, 1232}, {-108, -183},
+    {1233, -61}, {-209, -13}, {1235, 1238}, {1236, 1237}, {-196, -123}, {-168, -45}, {1239, 1240}, {-195, -92},
+    {-182, -29}, {1242, 1270}, {1243, 1260}, {1244, 1253}, {1245, 1248}, {1246, 1247}, {-138, -153}, {-194, -76},
+    {1249, 1251}, {1250, -60}, {-193, -12}, {1252, -27}, {-177, -11}, {1254, 1256}, {-181, 1255}, {-107, -167},
+    {1257, 1258}, {-122, -152}, {1259, -145}, {-161, -10}, {1261, 1265}, {1262, 1263}, {-180, -137}, {1264, -179},
+    {-44, -91}, {1266, 1269}, {1267, 1268}, {-166, -28}, {-178, -106}, {-151, -165}, {1271, 1279}, {1272, 1276},
+    {1273, 1275}, {1274, -136}, {-75, -121}, {-59, -164}, {1277, 1278}, {-90, -150}, {-43, -163}, {1280, 1283},
+    {1281, 1282}, {-162, -105}, {-135, -120}, {1284, 1285}, {-74, -149}, {-58, -148}, {1287, 1318}, {1288, 1303},
+    {1289, 1296}, {1290, 1293}, {1291, 1292}, {-89, -134}, {-42, -104}, {1294, 1295}, {-119, -147}, {-26, -146},
+    {1297, 1300}, {1298, 1299}, {-73, -133}, {-88, -118}, {1301, 1302}, {-57, -132}, {-103, -41}, {1304, 1312},
+    {1305, 1308}, {1306, 1307}, {-131, -25}, {-72, -117}, {1309, 1311}, {-130, 1310}, {-9, -129}, {-87, -102},
+    {1313, 1316}, {1314, -116}, {-24, 1315}, {-8, -113}, {1317, -115}, {-56, -40}, {1319, 1326}, {1320, 1323},
+    {1321, 1322}, {-71, -101}, {-86, -114}, {1324, 1325}, {-55, -100}, {-70, -85}, {1327, 1330}, {1328, 1329},
+    {-39, -99}, {-23, -98}, {1331, 1333}, {1332, -54}, {-7, -97}, {-84, -69}, {1335, 1360}, {1336, 1354},
+    {1337, 1348}, {1338, 1345}, {1339, 1343}, {1340, 1341}, {-38, -83}, {-22, 1342}, {-6, -81}, {-82, 1344},
+    {-53, -68}, {1346, 1347}, {-37, -67}, {-52, -21}, {1349, 1353}, {1350, 1352}, {-66, 1351}, {-5, -65},
+    {-36, -51}, {-20, -50}, {1355, 1358}, {1356, -19}, {1357, -35}, {-4, -49}, {-34, 1359}, {-3, -33},
+    {1361, 1362}, {-18, -2}, {-17, -1}, {1364, -1}, {1367, 1365}, {1366, 1370}, {-3, -2}, {1371, 1368},
+    {1369, 1374}, {-7, -4}, {-5, -9}, {1375, 1372}, {1373, -10}, {-8, -6}, {-11, -13}, {1376, 1377},
+    {-12, -16}, {-14, -15},
+};
+
+const as_mp3_huffman_table as_mp3_big_values_tables[32] = {
+    {-1, 0}, {0, 0}, {3, 0}, {11, 0}, {-1, 0}, {19, 0}, {34, 0}, {49, 0},
+    {84, 0}, {119, 0}, {154, 0}, {217, 0}, {280, 0}, {343, 0}, {-1, 0}, {598, 0},
+    {853, 1}, {853, 2}, {853, 3}, {853, 4}, {853, 6}, {853, 8}, {853, 10}, {853, 13},
+    {1108, 4}, {1108, 5}, {1108, 6}, {1108, 7}, {1108, 8}, {1108, 9}, {1108, 11}, {1108, 13},
+};
+
+const int16_t as_mp3_count1_table_a = 1363;
+
+/// Ordered as 44100, 48000, 32000, 22050, 24000, 16000, 11025, 12000 and 8000 Hz
+const uint8_t as_mp3_long_band_widths[9][22] = {
+    {4, 4, 4, 4, 4, 4, 6, 6, 8, 8, 10, 12, 16, 20, 24, 28, 34, 42, 50, 54, 76, 158},
+    {4, 4, 4, 4, 4, 4, 6, 6, 6, 8, 10, 12, 16, 18, 22, 28, 34, 40, 46, 54, 54, 192},
+    {4, 4, 4, 4, 4, 4, 6, 6, 8, 10, 12, 16, 20, 24, 30, 38, 46, 56, 68, 84, 102, 26},
+    {6, 6, 6, 6, 6, 6, 8, 10, 12, 14, 16, 20, 24, 28, 32, 38, 46, 52, 60, 68, 58, 54},
+    {6, 6, 6, 6, 6, 6, 8, 10, 12, 14, 16, 18, 22, 26, 32, 38, 46, 54, 62, 70, 76, 36},
+    {6, 6, 6, 6, 6, 6, 8, 10, 12, 14, 16, 20, 24, 28, 32, 38, 46, 52, 60, 68, 58, 54},
+    {6, 6, 6, 6, 6, 6, 8, 10, 12, 14, 16, 20, 24, 28, 32, 38, 46, 52, 60, 68, 58, 54},
+    {6, 6, 6, 6, 6, 6, 8, 10, 12, 14, 16, 20, 24, 28, 32, 38, 46, 52, 60, 68, 58, 54},
+    {12, 12, 12, 12, 12, 12, 16, 20, 24, 28, 32, 40, 48, 56, 64, 76, 90, 2, 2, 2, 2, 2},
+};
+
+const uint8_t as_mp3_short_band_widths[9][13] = {
+    {4, 4, 4, 4, 6, 8, 10, 12, 14, 18, 22, 30, 56},
+    {4, 4, 4, 4, 6, 6, 10, 12, 14, 16, 20, 26, 66},
+    {4, 4, 4, 4, 6, 8, 12, 16, 20, 26, 34, 42, 12},
+    {4, 4, 4, 6, 6, 8, 10, 14, 18, 26, 32, 42, 18},
+    {4, 4, 4, 6, 8, 10, 12, 14, 18, 24, 32, 44, 12},
+    {4, 4, 4, 6, 8, 10, 12, 14, 18, 24, 30, 40, 18},
+    {4, 4, 4, 6, 8, 10, 12, 14, 18, 24, 30, 40, 18},
+    {4, 4, 4, 6, 8, 10, 12, 14, 18, 24, 30, 40, 18},
+    {8, 8, 8, 12, 16, 20, 24, 28, 36, 2, 2, 2, 26},
+};
+
+/// The first half of the synthesis window of ISO/IEC 11172-3 Table 3-B.3, scaled by 65536
+const int32_t as_mp3_synthesis_window[257] = {
+    0, -1, -1, -1, -1, -1, -1, -2, -2, -2, -2, -3,
+    -3, -4, -4, -5, -5, -6, -7, -7, -8, -9, -10, -11,
+    -13, -14, -16, -17, -19, -21, -24, -26, -29, -31, -35, -38,
+    -41, -45, -49, -53, -58, -63, -68, -73, -79, -85, -91, -97,
+    -104, -111, -117, -125, -132, -139, -147, -154, -161, -169, -176, -183,
+    -190, -196, -202, -208, 213, 218, 222, 225, 227, 228, 228, 227,
+    224, 221, 215, 208, 200, 189, 177, 163, 146, 127, 106, 83,
+    57, 29, -2, -36, -72, -111, -153, -197, -244, -294, -347, -401,
+    -459, -519, -581, -645, -711, -779, -848, -919, -991, -1064, -1137, -1210,
+    -1283, -1356, -1428, -1498, -1567, -1634, -1698, -1759, -1817, -1870, -1919, -1962,
+    -2001, -2032, -2057, -2075, -2085, -2087, -2080, -2063, 2037, 2000, 1952, 1893,
+    1822, 1739, 1644, 1535, 1414, 1280, 1131, 970, 794, 605, 402, 185,
+    -45, -288, -545, -814, -1095, -1388, -1692, -2006, -2330, -2663, -3004, -3351,
+    -3705, -4063, -4425, -4788, -5153, -5517, -5879, -6237, -6589, -6935, -7271, -7597,
+    -7910, -8209, -8491, -8755, -8998, -9219, -9416, -9585, -9727, -9838, -9916, -9959,
+    -9966, -9935, -9863, -9750, -9592, -9389, -9139, -8840, -8492, -8092, -7640, -7134,
+    6574, 5959, 5288, 4561, 3776, 2935, 2037, 1082, 70, -998, -2122, -3300,
+    -4533, -5818, -7154, -8540, -9975, -11455, -12980, -14548, -16155, -17799, -19478, -21189,
+    -22929, -24694, -26482, -28289, -30112, -31947, -33791, -35640, -37489, -39336, -41176, -43006,
+    -44821, -46617, -48390, -50137, -51853, -53534, -55178, -56778, -58333, -59838, -61289, -62684,
+    -64019, -65290, -66494, -67629, -68692, -69679, -70590, -71420, -72169, -72835, -73415, -73908,
+    -74313, -74630, -74856, -74992, 75038,
+};
@@ -0,0 +1,27 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+#ifndef MP3Tables_h
+#define MP3Tables_h
+
+#include <stdint.h>
+
+#define AS_MP3_HUFFMAN_NODE_COUNT 1378
+
+typedef struct {
+    /// The index of the root node in `as_mp3_huffman_nodes`, `-1` for the tables that code no values
+    int16_t root;
+    /// The number of extra bits of values escaped by 15
+    uint8_t linbits;
+} as_mp3_huffman_table;
+
+extern const int16_t as_mp3_huffman_nodes[AS_MP3_HUFFMAN_NODE_COUNT][2];
+extern const as_mp3_huffman_table as_mp3_big_values_tables[32];
+extern const int16_t as_mp3_count1_table_a;
+extern const uint8_t as_mp3_long_band_widths[9][22];
+extern const uint8_t as_mp3_short_band_widths[9][13];
+extern const int32_t as_mp3_synthesis_window[257];
+
+#endif /* MP3Tables_h */
@@ -0,0 +1,94 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+#ifndef AudioStreamingMP3_h
+#define AudioStreamingMP3_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/// A portable MPEG-1, MPEG-2 and MPEG-2.5 Layer III decoder, written in plain C so it builds and runs
+/// on any platform, it doesn't depend on AudioToolbox.
+/// Decodes one frame at a time into interleaved 32 bit float samples.
+
+/// The largest Layer III frame, 320kbps at 32kHz with padding
+#define AS_MP3_MAX_FRAME_SIZE 1441
+/// The number of samples per channel of an MPEG-1 frame, MPEG-2 and MPEG-2.5 frames hold half of it
+#define AS_MP3_MAX_SAMPLES_PER_FRAME 1152
+
+typedef enum {
+    as_mp3_version_1 = 0,
+    as_mp3_version_2 = 1,
+    as_mp3_version_2_5 = 2
+} as_mp3_version;
+
+typedef enum {
+    as_mp3_channel_mode_stereo = 0,
+    as_mp3_channel_mode_joint_stereo = 1,
+    as_mp3_channel_mode_dual_channel = 2,
+    as_mp3_channel_mode_mono = 3
+} as_mp3_channel_mode;
+
+typedef struct {
+    as_mp3_version version;
+    as_mp3_channel_mode channel_mode;
+    uint8_t mode_extension;
+    bool has_crc;
+    bool padding;
+    /// The bitrate in kbps
+    uint16_t bitrate;
+    uint32_t sample_rate;
+    uint8_t channels;
+    /// The size in bytes of the whole frame, including the header
+    uint16_t frame_size;
+    uint16_t samples_per_frame;
+    /// The size in bytes of the side information that follows the header and the optional CRC
+    uint8_t side_info_size;
+} as_mp3_frame_header;
+
+/// Parses a Layer III frame header.
+///
+/// - parameter bytes: At least 4 bytes
+/// - parameter header: Filled in when the header is valid
+/// - Returns: `true` when the bytes are a valid Layer III header, free format bitrates are not supported.
+bool as_mp3_parse_header(const uint8_t *bytes, as_mp3_frame_header *header);
+
+/// Finds the next frame sync word, 11 set bits, using vector instructions where available.
+///
+/// - parameter bytes: The bytes to search
+/// - parameter count: The number of bytes
+/// - Returns: The offset of the first sync word, or `count` if there is none.
+///            A sync word is not necessarily a valid header, the caller still parses it with `as_mp3_parse_header`.
+size_t as_mp3_find_sync(const uint8_t *bytes, size_t count);
+
+typedef struct as_mp3_decoder as_mp3_decoder;
+
+/// Creates a decoder, returns `NULL` if the memory couldn't be allocated
+as_mp3_decoder *as_mp3_decoder_create(void);
+
+void as_mp3_decoder_destroy(as_mp3_decoder *decoder);
+
+/// Clears the bit reservoir and the filter state, to be called on a discontinuity such as a seek.
+void as_mp3_decoder_reset(as_mp3_decoder *decoder);
+
+/// Decodes a single frame.
+///
+/// A frame whose main data starts in frames that weren't decoded, as happens after a reset,
+/// decodes to silence, so every frame produces `samples_per_frame` samples per channel.
+///
+/// - parameter decoder: The decoder
+/// - parameter frame: The bytes of the whole frame, starting with its header
+/// - parameter size: The number of bytes available, at least the frame size
+/// - parameter pcm: Receives `samples_per_frame * channels` interleaved samples, at most `AS_MP3_MAX_SAMPLES_PER_FRAME * 2`
+/// - parameter header: Receives the header of the frame, can be `NULL`
+/// - Returns: The number of samples per channel written, or `-1` if the frame is not a valid Layer III frame.
+int as_mp3_decode_frame(as_mp3_decoder *decoder,
+                        const uint8_t *frame,
+                        size_t size,
+                        float *pcm,
+                        as_mp3_frame_header *header);
+
+#endif /* AudioStreamingMP3_h */
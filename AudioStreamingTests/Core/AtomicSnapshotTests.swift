@@ -0,0 +1,128 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import XCTest
+
+@testable import AudioStreaming
+
+class AtomicSnapshotTests: XCTestCase {
+    private final class Snapshot {
+        let value: Int
+        init(value: Int) { self.value = value }
+    }
+
+    func testReaderSeesTheLatestPublishedValue() {
+        let snapshot = AtomicSnapshot<Snapshot>()
+
+        XCTAssertNil(snapshot.read { $0 })
+
+        snapshot.publish(Snapshot(value: 1))
+        XCTAssertEqual(snapshot.read { $0?.value }, 1)
+
+        snapshot.publish(Snapshot(value: 2))
+        XCTAssertEqual(snapshot.read { $0?.value }, 2)
+
+        snapshot.publish(nil)
+        XCTAssertNil(snapshot.read { $0 })
+    }
+
+    func testReplacedValueIsReleasedWhenReaderIsOutside() {
+        let snapshot = AtomicSnapshot<Snapshot>()
+        weak var weakFirst: Snapshot?
+        autoreleasepool {
+            let first = Snapshot(value: 1)
+            weakFirst = first
+            snapshot.publish(first)
+        }
+        XCTAssertNotNil(weakFirst)
+
+        snapshot.publish(Snapshot(value: 2))
+        XCTAssertNil(weakFirst)
+    }
+
+    func testReplacedValueIsKeptAliveWhileReaderIsInside() {
+        let snapshot = AtomicSnapshot<Snapshot>()
+        weak var weakFirst: Snapshot?
+        autoreleasepool {
+            let first = Snapshot(value: 1)
+            weakFirst = first
+            snapshot.publish(first)
+        }
+
+        snapshot.read { current in
+            XCTAssertEqual(current?.value, 1)
+            snapshot.publish(Snapshot(value: 2))
+            // the reader might still be using the first value
+            XCTAssertNotNil(weakFirst)
+            XCTAssertEqual(snapshot.latest()?.value, 2)
+        }
+
+        snapshot.collect()
+        XCTAssertNil(weakFirst)
+    }
+
+    func testReplacedValueIsReleasedOnTheReclaimQueue() {
+        let reclaimQueue = DispatchQueue(label: "reclaim.queue")
+        let snapshot = AtomicSnapshot<Snapshot>(reclaimQueue: reclaimQueue)
+        weak var weakFirst: Snapshot?
+        autoreleasepool {
+            let first = Snapshot(value: 1)
+            weakFirst = first
+            snapshot.publish(first)
+        }
+
+        reclaimQueue.suspend()
+        snapshot.publish(Snapshot(value: 2))
+        // the release waits for the reclaim queue, it doesn't run on the publishing thread
+        XCTAssertNotNil(weakFirst)
+
+        reclaimQueue.resume()
+        reclaimQueue.sync {}
+        XCTAssertNil(weakFirst)
+    }
+
+    func testValueReplacedWhileReaderIsInsideIsCollectedWithoutAnotherPublish() {
+        let reclaimQueue = DispatchQueue(label: "reclaim.queue")
+        let snapshot = AtomicSnapshot<Snapshot>(reclaimQueue: reclaimQueue)
+        weak var weakFirst: Snapshot?
+        autoreleasepool {
+            let first = Snapshot(value: 1)
+            weakFirst = first
+            snapshot.publish(first)
+        }
+
+        snapshot.read { _ in
+            snapshot.publish(nil)
+        }
+        XCTAssertNotNil(weakFirst)
+
+        // eg. the last plan published when the player stops
+        let released = expectation(for: NSPredicate { _, _ in weakFirst == nil }, evaluatedWith: nil)
+        wait(for: [released], timeout: 1)
+    }
+
+    func testConcurrentPublishingAndReading() {
+        let snapshot = AtomicSnapshot<Snapshot>(Snapshot(value: 0))
+        let publisher = DispatchQueue(label: "publisher")
+        let expectation = self.expectation(description: "published all values")
+
+        publisher.async {
+            for i in 1 ... 10000 {
+                snapshot.publish(Snapshot(value: i))
+            }
+            expectation.fulfill()
+        }
+
+        var lastValue = 0
+        for _ in 0 ..< 10000 {
+            let value = snapshot.read { $0?.value ?? 0 }
+            XCTAssertGreaterThanOrEqual(value, lastValue)
+            lastValue = value
+        }
+
+        waitForExpectations(timeout: 5)
+        XCTAssertEqual(snapshot.read { $0?.value }, 10000)
+    }
+}
@@ -0,0 +1,67 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import XCTest
+
+@testable import AudioStreaming
+
+class AtomicTests: XCTestCase {
+    func testAtomicValuesAreAccessedSafely() {
+        measure {
+            let atomic = Atomic<Int>(0)
+
+            DispatchQueue.concurrentPerform(iterations: 1_000_000) { _ in
+                _ = atomic.value
+                atomic.add(1)
+            }
+
+            XCTAssertEqual(atomic.value, 1_000_000)
+        }
+    }
+
+    func testCompareExchangeOnlySucceedsForExpectedValue() {
+        let atomic = Atomic<Int>(1)
+
+        let failed = atomic.compareExchange(expected: 0, desired: 2)
+        XCTAssertFalse(failed.exchanged)
+        XCTAssertEqual(failed.original, 1)
+        XCTAssertEqual(atomic.value, 1)
+
+        let succeeded = atomic.compareExchange(expected: 1, desired: 2)
+        XCTAssertTrue(succeeded.exchanged)
+        XCTAssertEqual(succeeded.original, 1)
+        XCTAssertEqual(atomic.value, 2)
+
+        XCTAssertEqual(atomic.exchange(3), 2)
+        XCTAssertEqual(atomic.load(ordering: .relaxed), 3)
+    }
+
+    // MARK: Performance
+
+    func testAtomicFlagReadPerformance() {
+        let atomic = Atomic<Bool>(false)
+        measure {
+            DispatchQueue.concurrentPerform(iterations: 1_000_000) { i in
+                if i % 1000 == 0 {
+                    atomic.store(!atomic.value)
+                }
+                _ = atomic.value
+            }
+        }
+    }
+
+    /// The lock based equivalent of `testAtomicFlagReadPerformance`
+    func testProtectedFlagReadPerformance() {
+        let protected = Protected<Bool>(false)
+        measure {
+            DispatchQueue.concurrentPerform(iterations: 1_000_000) { i in
+                if i % 1000 == 0 {
+                    protected.write { $0.toggle() }
+                }
+                _ = protected.value
+            }
+        }
+    }
+}
@@ -0,0 +1,89 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import AVFoundation
+import XCTest
+
+@testable import AudioStreaming
+
+class AudioConverterPoolTests: XCTestCase {
+    private let outputFormat = AVAudioFormat(commonFormat: .pcmFormatFloat32, sampleRate: 44100, channels: 2, interleaved: true)!
+
+    private func inputFormat(sampleRate: Double) -> AudioStreamBasicDescription {
+        AVAudioFormat(commonFormat: .pcmFormatInt16, sampleRate: sampleRate, channels: 2, interleaved: true)!.basicStreamDescription
+    }
+
+    private func makeConverter(from format: AudioStreamBasicDescription) -> AudioConverterRef {
+        var inputFormat = format
+        var outputFormat = self.outputFormat.basicStreamDescription
+        var converter: AudioConverterRef?
+        XCTAssertEqual(AudioConverterNew(&inputFormat, &outputFormat, &converter), noErr)
+        return converter!
+    }
+
+    func testRecycledConverterIsReusedForSameFormatAndCookie() {
+        let pool = AudioConverterPool(capacity: 2)
+        let format = inputFormat(sampleRate: 44100)
+        let key = AudioConverterKey(format: format, magicCookie: nil)
+
+        XCTAssertNil(pool.take(for: key))
+
+        let converter = makeConverter(from: format)
+        pool.recycle(converter, for: key)
+
+        XCTAssertNil(pool.take(for: AudioConverterKey(format: format, magicCookie: Data([0x01]))))
+        XCTAssertNil(pool.take(for: AudioConverterKey(format: inputFormat(sampleRate: 48000), magicCookie: nil)))
+        XCTAssertEqual(pool.take(for: key), converter)
+        // a taken converter is no longer in the pool
+        XCTAssertNil(pool.take(for: key))
+
+        XCTAssertEqual(pool.statistics.hits, 1)
+        XCTAssertEqual(pool.statistics.misses, 4)
+        XCTAssertEqual(pool.statistics.hitRate, 0.2, accuracy: 0.0001)
+
+        AudioConverterDispose(converter)
+    }
+
+    func testAlternatingFormatsHitThePool() {
+        let pool = AudioConverterPool(capacity: 2)
+        let formats = [inputFormat(sampleRate: 44100), inputFormat(sampleRate: 48000)]
+
+        var inUse: (key: AudioConverterKey, converter: AudioConverterRef)?
+        for index in 0 ..< 10 {
+            let key = AudioConverterKey(format: formats[index % 2], magicCookie: nil)
+            if let current = inUse {
+                pool.recycle(current.converter, for: current.key)
+            }
+            let converter = pool.take(for: key) ?? makeConverter(from: formats[index % 2])
+            inUse = (key, converter)
+        }
+
+        XCTAssertEqual(pool.statistics.misses, 2)
+        XCTAssertEqual(pool.statistics.hits, 8)
+        XCTAssertEqual(pool.statistics.evictions, 0)
+
+        if let current = inUse {
+            AudioConverterDispose(current.converter)
+        }
+    }
+
+    func testLeastRecentlyUsedConverterIsEvicted() {
+        let pool = AudioConverterPool(capacity: 2)
+        let keys = [22050.0, 44100.0, 48000.0].map { sampleRate -> (AudioConverterKey, AudioConverterRef) in
+            let format = inputFormat(sampleRate: sampleRate)
+            return (AudioConverterKey(format: format, magicCookie: nil), makeConverter(from: format))
+        }
+        keys.forEach { pool.recycle($0.1, for: $0.0) }
+
+        XCTAssertEqual(pool.statistics.evictions, 1)
+        XCTAssertNil(pool.take(for: keys[0].0))
+        let newest = pool.take(for: keys[2].0)
+        XCTAssertEqual(newest, keys[2].1)
+
+        newest.map { AudioConverterDispose($0) }
+        pool.removeAll()
+        XCTAssertNil(pool.take(for: keys[1].0))
+    }
+}
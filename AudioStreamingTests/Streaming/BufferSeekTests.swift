@@ -0,0 +1,202 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import AVFoundation
+import XCTest
+
+@testable import AudioStreaming
+
+class BufferSeekTests: XCTestCase {
+    private let format = AVAudioFormat(commonFormat: .pcmFormatFloat32, sampleRate: 44100.0, channels: 2, interleaved: true)!
+
+    // MARK: Buffer context
+
+    func test_Played_Frames_Are_Kept_As_History_Up_To_Capacity() {
+        let bufferContext = BufferContext(sizeInBytes: 8, totalFrameCount: 1000, historyCapacity: 300)
+        bufferContext.frameUsedCount = 600
+
+        bufferContext.consume(200)
+        XCTAssertEqual(bufferContext.frameStartIndex, 200)
+        XCTAssertEqual(bufferContext.frameUsedCount, 400)
+        XCTAssertEqual(bufferContext.historyFrameCount, 200)
+        XCTAssertEqual(bufferContext.occupiedStartIndex, 0)
+
+        bufferContext.consume(200)
+        XCTAssertEqual(bufferContext.historyFrameCount, 300)
+        XCTAssertEqual(bufferContext.occupiedStartIndex, 100)
+        XCTAssertEqual(bufferContext.occupiedFrameCount, 500)
+        XCTAssertEqual(bufferContext.queueCapacity, 700)
+    }
+
+    func test_History_Wraps_Around_The_Buffer() {
+        let bufferContext = BufferContext(sizeInBytes: 8, totalFrameCount: 1000, historyCapacity: 300)
+        bufferContext.frameStartIndex = 900
+        bufferContext.frameUsedCount = 500
+
+        bufferContext.consume(250)
+        XCTAssertEqual(bufferContext.frameStartIndex, 150)
+        XCTAssertEqual(bufferContext.occupiedStartIndex, 900)
+
+        bufferContext.moveStart(by: -200)
+        XCTAssertEqual(bufferContext.frameStartIndex, 950)
+        XCTAssertEqual(bufferContext.frameUsedCount, 450)
+        XCTAssertEqual(bufferContext.historyFrameCount, 50)
+        XCTAssertEqual(bufferContext.end, 400)
+    }
+
+    func test_Seekable_Frames_Span_The_History_And_The_Frames_Queued() {
+        let bufferContext = BufferContext(sizeInBytes: 8, totalFrameCount: 1000, historyCapacity: 300)
+        bufferContext.frameUsedCount = 600
+        bufferContext.consume(250)
+
+        XCTAssertEqual(bufferContext.seekableFrames(reserving: 50), -250 ... 300)
+        XCTAssertEqual(bufferContext.seekableFrames(reserving: 500), -250 ... 0)
+    }
+
+    func test_Reset_Removes_History() {
+        let bufferContext = BufferContext(sizeInBytes: 8, totalFrameCount: 1000, historyCapacity: 300)
+        bufferContext.frameUsedCount = 600
+        bufferContext.consume(250)
+
+        bufferContext.reset()
+
+        XCTAssertEqual(bufferContext.historyFrameCount, 0)
+        XCTAssertEqual(bufferContext.seekableFrames(reserving: 0), 0 ... 0)
+    }
+
+    func test_Frames_Read_Before_The_Read_Index_Moved_Are_Not_Consumed() {
+        let bufferContext = BufferContext(sizeInBytes: 8, totalFrameCount: 1000, historyCapacity: 300)
+        bufferContext.frameUsedCount = 600
+        let moves = bufferContext.readIndexMoves
+
+        // the render thread copies a slice, meanwhile the read index moves
+        bufferContext.moveStart(by: 200)
+        XCTAssertFalse(bufferContext.consume(100, readAt: moves))
+        XCTAssertEqual(bufferContext.frameStartIndex, 200)
+        XCTAssertEqual(bufferContext.frameUsedCount, 400)
+
+        XCTAssertTrue(bufferContext.consume(100, readAt: bufferContext.readIndexMoves))
+        XCTAssertEqual(bufferContext.frameStartIndex, 300)
+    }
+
+    // MARK: Renderer context
+
+    func test_Buffer_Holds_The_Seconds_Buffered_And_The_History() {
+        let rendererContext = makeRendererContext(seekHistoryInSeconds: 5)
+        defer { rendererContext.clean() }
+
+        let bufferContext = rendererContext.bufferContext
+        XCTAssertEqual(bufferContext.totalFrameCount, 44100 * 15)
+        XCTAssertEqual(bufferContext.historyCapacity, 44100 * 5)
+        XCTAssertEqual(bufferContext.queueCapacity, 44100 * 10)
+    }
+
+    func test_Seeking_Back_Within_The_History_Moves_The_Read_Index() {
+        let rendererContext = makeRendererContext(seekHistoryInSeconds: 10)
+        defer { rendererContext.clean() }
+        let bufferContext = rendererContext.bufferContext
+        play(seconds: 8, of: 20, in: bufferContext)
+
+        XCTAssertTrue(rendererContext.moveReadIndex(by: -44100 * 5, playedFrames: 44100 * 8))
+        XCTAssertEqual(bufferContext.frameStartIndex, 44100 * 3)
+        XCTAssertEqual(bufferContext.frameUsedCount, 44100 * 17)
+        XCTAssertEqual(bufferContext.historyFrameCount, 44100 * 3)
+        XCTAssertEqual(bufferContext.occupiedFrameCount, 44100 * 20)
+    }
+
+    func test_Seeking_Forward_Within_The_Frames_Queued_Keeps_Them_As_History() {
+        let rendererContext = makeRendererContext(seekHistoryInSeconds: 10)
+        defer { rendererContext.clean() }
+        let bufferContext = rendererContext.bufferContext
+        play(seconds: 2, of: 10, in: bufferContext)
+
+        XCTAssertTrue(rendererContext.moveReadIndex(by: 44100 * 5, playedFrames: 44100 * 2))
+        XCTAssertEqual(bufferContext.frameStartIndex, 44100 * 7)
+        XCTAssertEqual(bufferContext.frameUsedCount, 44100 * 3)
+        XCTAssertEqual(bufferContext.historyFrameCount, 44100 * 7)
+
+        // and back again
+        XCTAssertTrue(rendererContext.moveReadIndex(by: -44100 * 5, playedFrames: 44100 * 7))
+        XCTAssertEqual(bufferContext.frameStartIndex, 44100 * 2)
+    }
+
+    func test_Seeking_Outside_The_Buffer_Leaves_The_Read_Index() {
+        let rendererContext = makeRendererContext(seekHistoryInSeconds: 10)
+        defer { rendererContext.clean() }
+        let bufferContext = rendererContext.bufferContext
+        play(seconds: 4, of: 10, in: bufferContext)
+
+        // before the history
+        XCTAssertFalse(rendererContext.moveReadIndex(by: -44100 * 5, playedFrames: 44100 * 4))
+        // past the frames queued
+        XCTAssertFalse(rendererContext.moveReadIndex(by: 44100 * 7, playedFrames: 44100 * 4))
+        // into the frames the render thread may be reading
+        XCTAssertFalse(rendererContext.moveReadIndex(by: 44100 * 6 - Int(maxFramesPerSlice), playedFrames: 44100 * 4))
+
+        XCTAssertEqual(bufferContext.frameStartIndex, 44100 * 4)
+        XCTAssertEqual(bufferContext.frameUsedCount, 44100 * 6)
+        XCTAssertEqual(bufferContext.historyFrameCount, 44100 * 4)
+    }
+
+    func test_Seeking_Back_Doesnt_Return_To_The_Previous_Entry() {
+        let rendererContext = makeRendererContext(seekHistoryInSeconds: 10)
+        defer { rendererContext.clean() }
+        play(seconds: 8, of: 10, in: rendererContext.bufferContext)
+
+        // the entry started playing a second ago, the rest of the history is of the previous entry
+        XCTAssertFalse(rendererContext.moveReadIndex(by: -44100 * 2, playedFrames: 44100))
+        XCTAssertTrue(rendererContext.moveReadIndex(by: -44100, playedFrames: 44100))
+    }
+
+    func test_Seeking_Without_History_Only_Moves_Forward() {
+        let rendererContext = makeRendererContext(seekHistoryInSeconds: 0)
+        defer { rendererContext.clean() }
+        let bufferContext = rendererContext.bufferContext
+        play(seconds: 2, of: 8, in: bufferContext)
+
+        XCTAssertEqual(bufferContext.historyFrameCount, 0)
+        XCTAssertFalse(rendererContext.moveReadIndex(by: -1, playedFrames: 44100 * 2))
+        XCTAssertTrue(rendererContext.moveReadIndex(by: 44100 * 3, playedFrames: 44100 * 2))
+        XCTAssertEqual(bufferContext.frameUsedCount, 44100 * 3)
+    }
+
+    func test_Seeking_Back_While_A_Slice_Is_Copied_Plays_From_The_Frame_Seeked_To() {
+        let rendererContext = makeRendererContext(seekHistoryInSeconds: 10)
+        defer { rendererContext.clean() }
+        let bufferContext = rendererContext.bufferContext
+        play(seconds: 8, of: 20, in: bufferContext)
+        let moves = bufferContext.readIndexMoves
+
+        XCTAssertTrue(rendererContext.moveReadIndex(by: -44100 * 5, playedFrames: 44100 * 8))
+        XCTAssertFalse(bufferContext.consume(maxFramesPerSlice, readAt: moves))
+        XCTAssertEqual(bufferContext.frameStartIndex, 44100 * 3)
+        XCTAssertEqual(bufferContext.frameUsedCount, 44100 * 17)
+    }
+
+    func test_Resetting_Buffers_Removes_History() {
+        let rendererContext = makeRendererContext(seekHistoryInSeconds: 10)
+        defer { rendererContext.clean() }
+        play(seconds: 4, of: 10, in: rendererContext.bufferContext)
+
+        rendererContext.resetBuffers()
+
+        XCTAssertFalse(rendererContext.moveReadIndex(by: -44100, playedFrames: 44100 * 4))
+    }
+
+    // MARK: Helpers
+
+    private func makeRendererContext(seekHistoryInSeconds: Double) -> AudioRendererContext {
+        let configuration = AudioPlayerConfiguration(seekHistoryInSeconds: seekHistoryInSeconds).normalizeValues()
+        return AudioRendererContext(configuration: configuration, outputAudioFormat: format)
+    }
+
+    /// Queues the seconds of audio given and plays some of them
+    private func play(seconds: UInt32, of queuedSeconds: UInt32, in bufferContext: BufferContext) {
+        bufferContext.frameUsedCount = 44100 * queuedSeconds
+        for _ in 0 ..< seconds {
+            bufferContext.consume(44100)
+        }
+    }
+}
@@ -0,0 +1,159 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import AVFoundation
+import XCTest
+
+@testable import AudioStreaming
+
+class AdaptiveBufferingTests: XCTestCase {
+    private let traceNames = ["broadband", "dsl", "congested-cellular", "fluctuating-cellular"]
+    private let bitrates: [Double] = [128, 192, 320]
+
+    func testRendererContextThresholdsKeepSubSecondPrecision() {
+        let configuration = AudioPlayerConfiguration(secondsRequiredToStartPlaying: 0.25,
+                                                     gracePeriodAfterSeekInSeconds: 0.5,
+                                                     secondsRequiredToStartPlayingAfterBufferUnderun: 1.5)
+        let format = AVAudioFormat(commonFormat: .pcmFormatFloat32, sampleRate: 44100.0, channels: 2, interleaved: true)!
+        let rendererContext = AudioRendererContext(configuration: configuration, outputAudioFormat: format)
+        defer { rendererContext.clean() }
+
+        XCTAssertEqual(rendererContext.framesRequiredToStartPlaying, 11025)
+        XCTAssertEqual(rendererContext.framesRequiredAfterRebuffering, 66150)
+        XCTAssertEqual(rendererContext.framesRequiredForDataAfterSeekPlaying, 22050)
+        XCTAssertNil(rendererContext.adaptiveBuffering)
+
+        XCTAssertTrue(rendererContext.updateRequiredFrames(secondsToStartPlaying: 0.5, secondsAfterRebuffering: 1.5))
+        XCTAssertEqual(rendererContext.framesRequiredToStartPlaying, 22050)
+        XCTAssertFalse(rendererContext.updateRequiredFrames(secondsToStartPlaying: 0.51, secondsAfterRebuffering: 1.5))
+    }
+
+    func testThroughputEstimatorRequiresMinimumSamples() {
+        var estimator = ThroughputEstimator(halfLife: 2, minimumSamples: 2)
+        XCTAssertNil(estimator.estimate)
+
+        estimator.record(amount: 1000, duration: 1)
+        XCTAssertNil(estimator.estimate)
+
+        estimator.record(amount: 1000, duration: 1)
+        XCTAssertEqual(estimator.estimate ?? 0, 1000, accuracy: 0.001)
+
+        estimator.record(amount: 1000, duration: 0)
+        XCTAssertEqual(estimator.samples, 2)
+
+        estimator.reset()
+        XCTAssertNil(estimator.estimate)
+    }
+
+    func testThroughputEstimatorWeightsSamplesByDuration() {
+        var estimator = ThroughputEstimator(halfLife: 2, minimumSamples: 1)
+        estimator.record(amount: 1000, duration: 1)
+        // a sample lasting one half-life moves the estimate halfway
+        estimator.record(amount: 6000, duration: 2)
+        XCTAssertEqual(estimator.estimate ?? 0, 2000, accuracy: 0.001)
+    }
+
+    func testPolicyRequiresMoreAudioOnSlowerSupply() {
+        let policy = AdaptiveBufferingPolicy()
+
+        XCTAssertEqual(policy.secondsRequired(supplyRate: nil, remainingSeconds: nil, fallbackSeconds: 1), 1)
+        XCTAssertEqual(policy.secondsRequired(supplyRate: 4, remainingSeconds: nil, fallbackSeconds: 1), policy.minimumSeconds)
+        XCTAssertEqual(policy.secondsRequired(supplyRate: 0.1, remainingSeconds: nil, fallbackSeconds: 1), policy.maximumSeconds)
+
+        let slow = policy.secondsRequired(supplyRate: 0.9, remainingSeconds: nil, fallbackSeconds: 1)
+        let slower = policy.secondsRequired(supplyRate: 0.8, remainingSeconds: nil, fallbackSeconds: 1)
+        XCTAssertGreaterThan(slow, policy.minimumSeconds)
+        XCTAssertGreaterThan(slower, slow)
+
+        // close to the end only the remaining audio needs to be covered
+        let nearTheEnd = policy.secondsRequired(supplyRate: 0.8, remainingSeconds: 1, fallbackSeconds: 1)
+        XCTAssertLessThan(nearTheEnd, slower)
+    }
+
+    func testSupplyRateIsLimitedByTheSlowestOfDownloadAndDecode() {
+        var now: TimeInterval = 0
+        let adaptiveBuffering = AdaptiveBuffering(policy: AdaptiveBufferingPolicy(),
+                                                  outputSampleRate: 44100,
+                                                  clock: { now })
+        let bitrate: Double = 128_000
+
+        XCTAssertNil(adaptiveBuffering.supplyRate(bitrate: bitrate))
+
+        // 32KB per second is twice the 16KB per second of a 128kbps stream
+        for _ in 0 ..< 3 {
+            adaptiveBuffering.recordDownload(byteCount: 32000)
+            now += 1
+        }
+        XCTAssertEqual(adaptiveBuffering.supplyRate(bitrate: bitrate) ?? 0, 2, accuracy: 0.001)
+
+        adaptiveBuffering.recordDecode(frameCount: 44100, duration: 1)
+        adaptiveBuffering.recordDecode(frameCount: 44100, duration: 1)
+        XCTAssertEqual(adaptiveBuffering.supplyRate(bitrate: bitrate) ?? 0, 1, accuracy: 0.001)
+
+        // time spent while the buffer is full is not counted as download time
+        adaptiveBuffering.suspendMeasuring()
+        now += 60
+        adaptiveBuffering.recordDownload(byteCount: 32000)
+        XCTAssertEqual(adaptiveBuffering.supplyRate(bitrate: bitrate) ?? 0, 1, accuracy: 0.001)
+
+        adaptiveBuffering.reset()
+        XCTAssertNil(adaptiveBuffering.supplyRate(bitrate: bitrate))
+    }
+
+    // MARK: Simulation
+
+    func testAdaptivePolicyScoresBetterAcrossTraces() throws {
+        let simulator = BufferingPolicySimulator()
+        var staticScore: Double = 0
+        var adaptiveScore: Double = 0
+        for trace in try loadTraces() {
+            for bitrate in bitrates {
+                staticScore += simulator.simulate(trace: trace, bitrate: bitrate, duration: 180,
+                                                  policy: BufferingPolicySimulator.staticPolicy()).score
+                adaptiveScore += simulator.simulate(trace: trace, bitrate: bitrate, duration: 180,
+                                                    policy: BufferingPolicySimulator.adaptivePolicy()).score
+            }
+        }
+        XCTAssertLessThan(adaptiveScore, staticScore)
+    }
+
+    func testAdaptivePolicyStallsLessOnCongestedNetwork() throws {
+        let simulator = BufferingPolicySimulator()
+        let trace = try XCTUnwrap(BandwidthTrace(name: "congested-cellular", bundle: bundle))
+
+        let staticResult = simulator.simulate(trace: trace, bitrate: 192, duration: 180,
+                                              policy: BufferingPolicySimulator.staticPolicy())
+        let adaptiveResult = simulator.simulate(trace: trace, bitrate: 192, duration: 180,
+                                                policy: BufferingPolicySimulator.adaptivePolicy())
+
+        XCTAssertLessThan(adaptiveResult.stalls, staticResult.stalls)
+        XCTAssertLessThan(adaptiveResult.score, staticResult.score)
+    }
+
+    func testAdaptivePolicyDoesNotDelayStartOnFastNetworks() throws {
+        let simulator = BufferingPolicySimulator()
+        for name in ["broadband", "dsl"] {
+            let trace = try XCTUnwrap(BandwidthTrace(name: name, bundle: bundle))
+            for bitrate in bitrates {
+                let staticResult = simulator.simulate(trace: trace, bitrate: bitrate, duration: 180,
+                                                      policy: BufferingPolicySimulator.staticPolicy())
+                let adaptiveResult = simulator.simulate(trace: trace, bitrate: bitrate, duration: 180,
+                                                        policy: BufferingPolicySimulator.adaptivePolicy())
+                XCTAssertLessThanOrEqual(adaptiveResult.timeToFirstAudio, staticResult.timeToFirstAudio + 0.01)
+                XCTAssertEqual(adaptiveResult.stalls, 0)
+            }
+        }
+    }
+
+    // MARK: Helpers
+
+    private var bundle: Bundle {
+        Bundle(for: AdaptiveBufferingTests.self)
+    }
+
+    private func loadTraces() throws -> [BandwidthTrace] {
+        try traceNames.map { try XCTUnwrap(BandwidthTrace(name: $0, bundle: bundle)) }
+    }
+}
@@ -0,0 +1,164 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import Foundation
+
+@testable import AudioStreaming
+
+/// A bandwidth trace, a list of periods with a constant bandwidth.
+///
+/// Traces are stored as csv files with one `duration_seconds,kbps` period per line, lines starting with `#` are ignored.
+struct BandwidthTrace {
+    let name: String
+    let periods: [(duration: Double, kbps: Double)]
+
+    init(name: String, periods: [(duration: Double, kbps: Double)]) {
+        self.name = name
+        self.periods = periods
+    }
+
+    init?(name: String, bundle: Bundle) {
+        guard let url = bundle.url(forResource: name, withExtension: "csv"),
+              let contents = try? String(contentsOf: url)
+        else {
+            return nil
+        }
+        let periods: [(duration: Double, kbps: Double)] = contents
+            .split(whereSeparator: \.isNewline)
+            .filter { !$0.hasPrefix("#") }
+            .compactMap { line in
+                let values = line.split(separator: ",").compactMap { Double($0.trimmingCharacters(in: .whitespaces)) }
+                guard values.count == 2 else { return nil }
+                return (values[0], values[1])
+            }
+        guard !periods.isEmpty else { return nil }
+        self.init(name: name, periods: periods)
+    }
+}
+
+/// Replays a `BandwidthTrace` against a start/rebuffer policy and measures the time to first audio and the stalls.
+///
+/// The model follows the player, bytes arrive in chunks as they would from the network, playback starts once
+/// the buffered seconds reach the required seconds and stops when the buffer runs dry. The trace loops when
+/// it is shorter than the simulated stream.
+///
+/// Throughput is measured by the player's `AdaptiveBuffering` on the simulated clock, measuring is suspended
+/// while the buffer is full as the player does while waiting for room in its buffer.
+struct BufferingPolicySimulator {
+    struct Result {
+        let timeToFirstAudio: Double
+        let stalls: Int
+        let stallDuration: Double
+
+        /// Lower is better, a stall costs more than waiting a bit longer before starting
+        var score: Double {
+            timeToFirstAudio + 4 * stallDuration + 2 * Double(stalls)
+        }
+    }
+
+    /// Returns the seconds of audio required to start, given the supply rate estimate and the remaining seconds
+    typealias Policy = (_ supplyRate: Double?, _ remainingSeconds: Double) -> Double
+
+    var timeStep: Double = 0.01
+    var chunkSize: Double = 4096
+    var connectionLatency: Double = 0.3
+    var bufferSizeInSeconds: Double = 10
+    var timeLimit: Double = 900
+
+    /// The policy used by the player when adaptive buffering is disabled
+    static func staticPolicy(secondsToStart: Double = 1, secondsAfterRebuffering: Double = 1) -> (Bool) -> Policy {
+        return { hasStarted in
+            { _, _ in hasStarted ? secondsAfterRebuffering : secondsToStart }
+        }
+    }
+
+    /// The policy used by the player when adaptive buffering is enabled
+    static func adaptivePolicy(_ policy: AdaptiveBufferingPolicy = AdaptiveBufferingPolicy(),
+                               fallbackSeconds: Double = 1) -> (Bool) -> Policy
+    {
+        return { _ in
+            { supplyRate, remainingSeconds in
+                policy.secondsRequired(supplyRate: supplyRate,
+                                       remainingSeconds: remainingSeconds,
+                                       fallbackSeconds: fallbackSeconds)
+            }
+        }
+    }
+
+    /// Simulates the playback of a stream
+    ///
+    /// - parameter trace: The `BandwidthTrace` to replay
+    /// - parameter bitrate: The bitrate of the stream in kbps
+    /// - parameter duration: The duration of the stream in seconds
+    /// - parameter policy: A closure returning the policy to use, given whether playback has started before
+    func simulate(trace: BandwidthTrace, bitrate: Double, duration: Double, policy: (Bool) -> Policy) -> Result {
+        let bytesPerAudioSecond = bitrate * 1000 / 8
+        let totalBytes = duration * bytesPerAudioSecond
+
+        var time: Double = 0
+        let measuring = AdaptiveBuffering(policy: AdaptiveBufferingPolicy(), outputSampleRate: 0, clock: { time })
+        var played: Double = 0
+        var downloaded: Double = 0
+        var pendingBytes: Double = 0
+
+        var periodIndex = 0
+        var periodLeft = trace.periods[0].duration
+
+        var playing = false
+        var timeToFirstAudio: Double?
+        var stalls = 0
+        var stallDuration: Double = 0
+
+        while played < duration, time < timeLimit {
+            let kbps = trace.periods[periodIndex].kbps
+            periodLeft -= timeStep
+            if periodLeft <= 0 {
+                periodIndex = (periodIndex + 1) % trace.periods.count
+                periodLeft = trace.periods[periodIndex].duration
+            }
+
+            let bufferIsFull = downloaded / bytesPerAudioSecond - played >= bufferSizeInSeconds
+            if bufferIsFull {
+                measuring.suspendMeasuring()
+            } else if time >= connectionLatency, downloaded < totalBytes {
+                let received = min(kbps * 1000 / 8 * timeStep, totalBytes - downloaded)
+                downloaded += received
+                pendingBytes += received
+                while pendingBytes >= chunkSize {
+                    pendingBytes -= chunkSize
+                    measuring.recordDownload(byteCount: Int(chunkSize))
+                }
+            }
+
+            let downloadedSeconds = downloaded / bytesPerAudioSecond
+            let isComplete = downloaded >= totalBytes
+            let buffered = downloadedSeconds - played
+
+            if !playing {
+                let supplyRate = measuring.supplyRate(bitrate: bitrate * 1000)
+                let required = policy(timeToFirstAudio != nil)(supplyRate, duration - played)
+                if buffered >= required || (isComplete && buffered > 0) {
+                    playing = true
+                    if timeToFirstAudio == nil {
+                        timeToFirstAudio = time
+                    }
+                }
+            } else {
+                played += timeStep
+                if downloadedSeconds - played <= 0, !isComplete {
+                    playing = false
+                    stalls += 1
+                }
+            }
+
+            if !playing, timeToFirstAudio != nil, played < duration {
+                stallDuration += timeStep
+            }
+            time += timeStep
+        }
+
+        return Result(timeToFirstAudio: timeToFirstAudio ?? time, stalls: stalls, stallDuration: stallDuration)
+    }
+}
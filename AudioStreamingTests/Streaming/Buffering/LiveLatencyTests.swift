@@ -0,0 +1,77 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import AVFoundation
+import XCTest
+
+@testable import AudioStreaming
+
+class LiveLatencyTests: XCTestCase {
+    func testControllerCatchesUpOverToleranceUntilTarget() {
+        var controller = LiveLatencyController(control: LiveLatencyControl(targetLatency: 2, tolerance: 1))
+
+        XCTAssertFalse(controller.update(latency: 2.5))
+        XCTAssertFalse(controller.update(latency: 3))
+        XCTAssertTrue(controller.update(latency: 3.1))
+        // carries on within the tolerance
+        XCTAssertTrue(controller.update(latency: 2.5))
+        XCTAssertFalse(controller.update(latency: 2))
+        XCTAssertFalse(controller.update(latency: 2.9))
+
+        XCTAssertTrue(controller.update(latency: 4))
+        controller.reset()
+        XCTAssertFalse(controller.isCatchingUp)
+    }
+
+    func testTimeStretchKeepsLatencyBoundedAcrossRebuffers() {
+        let control = LiveLatencyControl(targetLatency: 2, tolerance: 1, catchUp: .timeStretch(rate: 1.05))
+        var controller = LiveLatencyController(control: control)
+        let tick = 0.5
+        var latency = 2.0
+        var maximumAfterCatchUp = 0.0
+
+        for step in 0 ..< 1200 {
+            // a rebuffer every 100 seconds adds 4 seconds of latency
+            if step % 200 == 0 {
+                latency += 4
+            }
+            let rate = controller.update(latency: latency) ? 1.05 : 1
+            latency += tick - tick * rate
+            if step % 200 > 160 {
+                maximumAfterCatchUp = max(maximumAfterCatchUp, latency)
+            }
+        }
+
+        XCTAssertLessThanOrEqual(maximumAfterCatchUp, control.targetLatency + control.tolerance)
+        XCTAssertGreaterThan(latency, control.targetLatency - tick * 0.05)
+    }
+
+    func testCountsLeadingSilentFrames() {
+        let silence: [Float] = [0, 0, 0.0005, -0.0005]
+        let audio: [Float] = [0.2, -0.2]
+        let samples = silence + silence + audio + silence
+
+        samples.withUnsafeBufferPointer { buffer in
+            XCTAssertEqual(leadingSilentFrameCount(buffer.baseAddress!, frameCount: 7, channels: 2), 4)
+            XCTAssertEqual(leadingSilentFrameCount(buffer.baseAddress!, frameCount: 3, channels: 2), 3)
+            XCTAssertEqual(leadingSilentFrameCount(buffer.baseAddress! + 8, frameCount: 3, channels: 2), 0)
+        }
+        // a single loud channel ends the silence
+        [0, 0, 0, 0.5].withUnsafeBufferPointer { buffer in
+            XCTAssertEqual(leadingSilentFrameCount(buffer.baseAddress!, frameCount: 2, channels: 2), 1)
+        }
+    }
+
+    func testRendererContextKeepsTargetLatencyFrames() {
+        let configuration = AudioPlayerConfiguration(liveLatencyControl: LiveLatencyControl(targetLatency: 1.5,
+                                                                                            catchUp: .droppingSilence))
+        let format = AVAudioFormat(commonFormat: .pcmFormatFloat32, sampleRate: 44100.0, channels: 2, interleaved: true)!
+        let rendererContext = AudioRendererContext(configuration: configuration, outputAudioFormat: format)
+        defer { rendererContext.clean() }
+
+        XCTAssertEqual(rendererContext.liveLatencyTargetFrames, 66150)
+        XCTAssertFalse(rendererContext.dropsSilentFrames.value)
+    }
+}
@@ -0,0 +1,312 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import AVFoundation
+import XCTest
+
+@testable import AudioStreaming
+
+class ADTSDemuxerBackendTests: XCTestCase {
+    private let outputFormat = AudioStreamBasicDescription(mSampleRate: 44100,
+                                                           mFormatID: kAudioFormatLinearPCM,
+                                                           mFormatFlags: kAudioFormatFlagsNativeFloatPacked,
+                                                           mBytesPerPacket: 8,
+                                                           mFramesPerPacket: 1,
+                                                           mBytesPerFrame: 8,
+                                                           mChannelsPerFrame: 2,
+                                                           mBitsPerChannel: 32,
+                                                           mReserved: 0)
+
+    func test_Demuxer_Reports_Format_And_Raw_Packets() throws {
+        let data = try fixture()
+        let spy = DecoderBackendDelegateSpy()
+        let backend = ADTSDemuxerBackend(outputFormat: outputFormat)
+        backend.delegate = spy
+
+        XCTAssertEqual(backend.open(fileHint: kAudioFileAAC_ADTSType), noErr)
+        XCTAssertEqual(backend.parse(data: data, discontinuous: false), noErr)
+
+        XCTAssertEqual(spy.fileFormat, "stda")
+        XCTAssertEqual(spy.dataFormat?.mFormatID, kAudioFormatMPEG4AAC)
+        XCTAssertEqual(spy.dataFormat?.mFormatFlags, UInt32(MPEG4ObjectID.AAC_LC.rawValue))
+        XCTAssertEqual(spy.dataFormat?.mSampleRate, 44100)
+        XCTAssertEqual(spy.dataFormat?.mChannelsPerFrame, 2)
+        XCTAssertEqual(spy.dataFormat?.mFramesPerPacket, 1024)
+        XCTAssertEqual(spy.dataOffset, 0)
+
+        let offsets = frameOffsets(in: data)
+        XCTAssertEqual(spy.parsedPackets, offsets.count)
+        // the packets are the raw frames, without the 7 bytes header
+        let descriptions = spy.packets.flatMap(\.descriptions)
+        XCTAssertEqual(descriptions.first?.mStartOffset, 7)
+        XCTAssertEqual(descriptions.map { $0.mStartOffset - 7 }, offsets.map(Int64.init))
+        XCTAssertEqual(backend.frameIndex?.count, offsets.count)
+        XCTAssertEqual(backend.frameIndex?.endOffset, UInt64(data.count))
+    }
+
+    func test_Demuxer_Points_Packets_Into_Received_Bytes() throws {
+        let data = try fixture()
+        let spy = DecoderBackendDelegateSpy()
+        let backend = ADTSDemuxerBackend(outputFormat: outputFormat)
+        backend.delegate = spy
+        _ = backend.open(fileHint: kAudioFileAAC_ADTSType)
+        _ = backend.parse(data: data.subdata(in: 0 ..< 2000), discontinuous: false)
+
+        let chunk = data.subdata(in: 2000 ..< data.count)
+        let reportedBefore = spy.packets.count
+        _ = backend.parse(data: chunk, discontinuous: false)
+
+        // the frame split between the chunks is reported from a copy, the rest from the chunk itself
+        XCTAssertEqual(spy.packets.count, reportedBefore + 2)
+        let address = try XCTUnwrap(spy.packets.last?.address)
+        chunk.withUnsafeBytes { buffer in
+            guard let baseAddress = buffer.baseAddress else { return XCTFail("empty chunk") }
+            XCTAssertTrue(address >= baseAddress && address < baseAddress + buffer.count)
+        }
+    }
+
+    func test_Demuxer_Parses_The_Same_Packets_From_Any_Chunking() throws {
+        let data = try fixture()
+        let reference = DecoderBackendDelegateSpy()
+        let referenceBackend = ADTSDemuxerBackend(outputFormat: outputFormat)
+        referenceBackend.delegate = reference
+        _ = referenceBackend.open(fileHint: kAudioFileAAC_ADTSType)
+        _ = referenceBackend.parse(data: data, discontinuous: false)
+
+        for chunkSize in [1, 7, 139, 500, 4096] {
+            let spy = DecoderBackendDelegateSpy()
+            let backend = ADTSDemuxerBackend(outputFormat: outputFormat)
+            backend.delegate = spy
+            _ = backend.open(fileHint: kAudioFileAAC_ADTSType)
+            var offset = 0
+            while offset < data.count {
+                _ = backend.parse(data: data.subdata(in: offset ..< min(offset + chunkSize, data.count)), discontinuous: false)
+                offset += chunkSize
+            }
+            XCTAssertEqual(packetPayloads(of: spy), packetPayloads(of: reference), "chunks of \(chunkSize) bytes")
+            XCTAssertEqual(backend.frameIndex?.count, referenceBackend.frameIndex?.count)
+        }
+    }
+
+    func test_Demuxer_Resyncs_After_Corrupt_Header() throws {
+        var data = try fixture()
+        let offsets = frameOffsets(in: data)
+        data[offsets[50]] = 0
+
+        let spy = DecoderBackendDelegateSpy()
+        let backend = ADTSDemuxerBackend(outputFormat: outputFormat)
+        backend.delegate = spy
+        _ = backend.open(fileHint: kAudioFileAAC_ADTSType)
+        _ = backend.parse(data: data, discontinuous: false)
+
+        // the corrupt frame is lost along with the one before it, which isn't followed by a valid header
+        XCTAssertEqual(spy.parsedPackets, offsets.count - 2)
+        XCTAssertEqual(backend.frameIndex?.count, 49)
+
+        let seek = backend.seek(toPacket: 20, time: 0)
+        XCTAssertFalse(seek.isEstimated)
+        XCTAssertEqual(seek.byteOffset, Int64(offsets[20]))
+        XCTAssertTrue(backend.seek(toPacket: 60, time: 0).isEstimated)
+    }
+
+    func test_Demuxer_Detects_HE_AAC_From_SBR_Extension() {
+        let spy = DecoderBackendDelegateSpy()
+        let backend = ADTSDemuxerBackend(outputFormat: outputFormat)
+        backend.delegate = spy
+        _ = backend.open(fileHint: kAudioFileAAC_ADTSType)
+        _ = backend.parse(data: adtsStream(channels: 2, extensionType: 13), discontinuous: false)
+
+        XCTAssertEqual(spy.dataFormat?.mFormatID, kAudioFormatMPEG4AAC_HE)
+        XCTAssertEqual(spy.dataFormat?.mSampleRate, 44100)
+        XCTAssertEqual(spy.dataFormat?.mFramesPerPacket, 2048)
+        XCTAssertEqual(spy.dataFormat?.mChannelsPerFrame, 2)
+        XCTAssertEqual(spy.parsedPackets, 6)
+    }
+
+    func test_Demuxer_Detects_HE_AAC_v2_For_Mono_Streams_With_SBR() {
+        let spy = DecoderBackendDelegateSpy()
+        let backend = ADTSDemuxerBackend(outputFormat: outputFormat)
+        backend.delegate = spy
+        _ = backend.open(fileHint: kAudioFileAAC_ADTSType)
+        _ = backend.parse(data: adtsStream(channels: 1, extensionType: 13), discontinuous: false)
+
+        XCTAssertEqual(spy.dataFormat?.mFormatID, kAudioFormatMPEG4AAC_HE_V2)
+        XCTAssertEqual(spy.dataFormat?.mSampleRate, 44100)
+        XCTAssertEqual(spy.dataFormat?.mChannelsPerFrame, 2)
+    }
+
+    func test_Demuxer_Reports_AAC_LC_Without_SBR_Extension() {
+        let spy = DecoderBackendDelegateSpy()
+        let backend = ADTSDemuxerBackend(outputFormat: outputFormat)
+        backend.delegate = spy
+        _ = backend.open(fileHint: kAudioFileAAC_ADTSType)
+        // a fill element of fill data
+        _ = backend.parse(data: adtsStream(channels: 2, extensionType: 1), discontinuous: false)
+
+        XCTAssertEqual(spy.dataFormat?.mFormatID, kAudioFormatMPEG4AAC)
+        XCTAssertEqual(spy.dataFormat?.mSampleRate, 22050)
+        XCTAssertEqual(spy.dataFormat?.mFramesPerPacket, 1024)
+    }
+
+    func test_Demuxer_Reports_Change_Of_Format_Mid_Stream() throws {
+        let first = try fixture()
+        // eg. switching HLS variants, 44.1kHz frames followed by 22.05kHz frames
+        let data = first + adtsStream(channels: 2, extensionType: 1)
+
+        for chunkSize in [data.count, 500] {
+            let spy = DecoderBackendDelegateSpy()
+            let backend = ADTSDemuxerBackend(outputFormat: outputFormat)
+            backend.delegate = spy
+            _ = backend.open(fileHint: kAudioFileAAC_ADTSType)
+            var offset = 0
+            while offset < data.count {
+                _ = backend.parse(data: data.subdata(in: offset ..< min(offset + chunkSize, data.count)), discontinuous: false)
+                offset += chunkSize
+            }
+
+            XCTAssertEqual(spy.dataFormat?.mSampleRate, 22050, "chunks of \(chunkSize) bytes")
+            XCTAssertEqual(spy.parsedPackets, frameOffsets(in: first).count + 6, "chunks of \(chunkSize) bytes")
+        }
+    }
+
+    func test_SBR_Detection_Checks_The_Fill_Element_Before_The_End() {
+        for payloadSize in [9, 20, 60, 200] {
+            let sbr = rawDataBlock(extensionType: 13, payloadSize: payloadSize, seed: 1)
+            let fill = rawDataBlock(extensionType: 1, payloadSize: payloadSize, seed: 1)
+            XCTAssertTrue(sbr.withUnsafeBufferPointer { ADTSHeader.containsSBR(in: $0.baseAddress!, count: $0.count) })
+            XCTAssertFalse(fill.withUnsafeBufferPointer { ADTSHeader.containsSBR(in: $0.baseAddress!, count: $0.count) })
+        }
+    }
+
+    // MARK: Benchmarks
+
+    func test_Performance_ADTSDemuxer() throws {
+        let data = try fixture()
+        measure {
+            for _ in 0 ..< 20 {
+                let backend = ADTSDemuxerBackend(outputFormat: outputFormat)
+                _ = backend.open(fileHint: kAudioFileAAC_ADTSType)
+                var offset = 0
+                while offset < data.count {
+                    _ = backend.parse(data: data.subdata(in: offset ..< min(offset + 2048, data.count)), discontinuous: false)
+                    offset += 2048
+                }
+            }
+        }
+    }
+
+    func test_Performance_AudioFileStream() throws {
+        let data = try fixture()
+        measure {
+            for _ in 0 ..< 20 {
+                let backend = AudioToolboxDecoderBackend(outputFormat: outputFormat)
+                _ = backend.open(fileHint: kAudioFileAAC_ADTSType)
+                var offset = 0
+                while offset < data.count {
+                    _ = backend.parse(data: data.subdata(in: offset ..< min(offset + 2048, data.count)), discontinuous: false)
+                    offset += 2048
+                }
+                backend.close()
+            }
+        }
+    }
+
+    // MARK: Helpers
+
+    private func fixture() throws -> Data {
+        let bundle = Bundle(for: ADTSDemuxerBackendTests.self)
+        let url = bundle.url(forResource: "sine-1khz-44100-stereo", withExtension: "aac")!
+        return try Data(contentsOf: url)
+    }
+
+    private func frameOffsets(in data: Data) -> [Int] {
+        data.withUnsafeBytes { buffer -> [Int] in
+            let bytes = buffer.bindMemory(to: UInt8.self).baseAddress!
+            var offsets: [Int] = []
+            var offset = 0
+            while offset + ADTSHeader.minimumSize <= buffer.count, let header = ADTSHeader(bytes: bytes + offset) {
+                offsets.append(offset)
+                offset += header.frameLength
+            }
+            return offsets
+        }
+    }
+
+    private func packetPayloads(of spy: DecoderBackendDelegateSpy) -> [Data] {
+        spy.packets.flatMap { packets in
+            packets.descriptions.map { description in
+                let start = Int(description.mStartOffset)
+                return packets.data.subdata(in: start ..< start + Int(description.mDataByteSize))
+            }
+        }
+    }
+
+    /// Six frames of 22.05kHz AAC, each ending with a fill element of the given extension type
+    private func adtsStream(channels: UInt8, extensionType: UInt32) -> Data {
+        var stream = Data()
+        for seed in 1 ... 6 {
+            let block = rawDataBlock(extensionType: extensionType, payloadSize: 40, seed: UInt32(seed))
+            let length = block.count + 7
+            // AAC LC at 22.05kHz, no CRC
+            stream.append(contentsOf: [0xFF, 0xF1,
+                                       UInt8(1 << 6 | 7 << 2 | Int(channels >> 2)),
+                                       UInt8(Int(channels & 3) << 6 | length >> 11),
+                                       UInt8((length >> 3) & 0xFF),
+                                       UInt8((length & 7) << 5 | 0x1F),
+                                       0xFC])
+            stream.append(contentsOf: block)
+        }
+        return stream
+    }
+
+    /// A raw data block of arbitrary elements followed by a fill element and the end element
+    private func rawDataBlock(extensionType: UInt32, payloadSize: Int, seed: UInt32) -> [UInt8] {
+        var writer = BitWriter(seed: seed)
+        writer.writeNoise(bits: 173)
+        writer.write(6, bits: 3)
+        if payloadSize < 15 {
+            writer.write(UInt32(payloadSize), bits: 4)
+        } else {
+            writer.write(15, bits: 4)
+            writer.write(UInt32(payloadSize - 14), bits: 8)
+        }
+        writer.write(extensionType, bits: 4)
+        writer.writeNoise(bits: payloadSize * 8 - 4)
+        writer.write(7, bits: 3)
+        return writer.bytes
+    }
+}
+
+/// Writes bits most significant first, the noise comes from a linear congruential generator so it is the same on every run
+private struct BitWriter {
+    private(set) var bytes: [UInt8] = []
+    private var bitCount = 0
+    private var state: UInt32
+
+    init(seed: UInt32) {
+        state = seed
+    }
+
+    mutating func write(_ value: UInt32, bits: Int) {
+        for bit in (0 ..< bits).reversed() {
+            append(bit: UInt8((value >> UInt32(bit)) & 1))
+        }
+    }
+
+    mutating func writeNoise(bits: Int) {
+        for _ in 0 ..< bits {
+            state = state &* 1_103_515_245 &+ 12345
+            append(bit: UInt8((state >> 16) & 1))
+        }
+    }
+
+    private mutating func append(bit: UInt8) {
+        if bitCount % 8 == 0 {
+            bytes.append(0)
+        }
+        bytes[bytes.count - 1] |= bit << (7 - UInt8(bitCount % 8))
+        bitCount += 1
+    }
+}
@@ -0,0 +1,250 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import AVFoundation
+import XCTest
+
+@testable import AudioStreaming
+
+class FLACDecoderBackendTests: XCTestCase {
+    private let outputFormat = AudioStreamBasicDescription(mSampleRate: 44100,
+                                                           mFormatID: kAudioFormatLinearPCM,
+                                                           mFormatFlags: kAudioFormatFlagsNativeFloatPacked,
+                                                           mBytesPerPacket: 8,
+                                                           mFramesPerPacket: 1,
+                                                           mBytesPerFrame: 8,
+                                                           mChannelsPerFrame: 2,
+                                                           mBitsPerChannel: 32,
+                                                           mReserved: 0)
+
+    // the fixture is one second of 16 bit stereo in 10 frames of 4608 samples, the last one holding 2628.
+    // Its metadata is STREAMINFO, a SEEKTABLE with points at frames 0, 4 and 8 plus a placeholder,
+    // a VORBIS_COMMENT and PADDING, the first frame starts at byte 204.
+    private let dataOffset: UInt64 = 204
+
+    func test_Backend_Discovers_Properties_From_StreamInfo() throws {
+        let spy = DecoderBackendDelegateSpy()
+        let backend = FLACDecoderBackend(outputFormat: outputFormat)
+        backend.delegate = spy
+
+        XCTAssertEqual(backend.open(fileHint: kAudioFileFLACType), noErr)
+        XCTAssertEqual(backend.parse(data: try fixture("sine-1khz-44100-stereo"), discontinuous: false), noErr)
+
+        XCTAssertEqual(spy.fileFormat, "calf")
+        XCTAssertEqual(spy.dataFormat?.mFormatID, kAudioFormatFLAC)
+        XCTAssertEqual(spy.dataFormat?.mFormatFlags, kAppleLosslessFormatFlag_16BitSourceData)
+        XCTAssertEqual(spy.dataFormat?.mSampleRate, 44100)
+        XCTAssertEqual(spy.dataFormat?.mChannelsPerFrame, 2)
+        XCTAssertEqual(spy.dataFormat?.mFramesPerPacket, 4608)
+        XCTAssertEqual(spy.dataOffset, dataOffset)
+        XCTAssertEqual(spy.packetCount, 10)
+        XCTAssertEqual(spy.readyPacketCount, 10)
+        XCTAssertEqual(spy.parsedPackets, 10)
+        XCTAssertEqual(backend.streamMagicCookie()?.count, 34)
+    }
+
+    func test_Backend_Parses_Frames_Split_Across_Chunks() throws {
+        let data = try fixture("sine-1khz-44100-stereo")
+        for chunkSize in [1, 100, 1000] {
+            let spy = DecoderBackendDelegateSpy()
+            let backend = FLACDecoderBackend(outputFormat: outputFormat)
+            backend.delegate = spy
+            _ = backend.open(fileHint: kAudioFileFLACType)
+
+            var offset = 0
+            while offset < data.count {
+                let chunk = data.subdata(in: offset ..< min(offset + chunkSize, data.count))
+                XCTAssertEqual(backend.parse(data: chunk, discontinuous: false), noErr)
+                offset += chunkSize
+            }
+
+            XCTAssertEqual(spy.dataOffset, dataOffset, "chunk size \(chunkSize)")
+            XCTAssertEqual(spy.parsedPackets, 10, "chunk size \(chunkSize)")
+            let byteCount = spy.packets.flatMap(\.descriptions).map { Int($0.mDataByteSize) }.reduce(0, +)
+            XCTAssertEqual(byteCount, data.count - Int(dataOffset), "chunk size \(chunkSize)")
+        }
+    }
+
+    func test_Backend_Resyncs_After_Garbage() throws {
+        let data = try fixture("sine-1khz-44100-stereo")
+        let spy = DecoderBackendDelegateSpy()
+        let backend = FLACDecoderBackend(outputFormat: outputFormat)
+        backend.delegate = spy
+        _ = backend.open(fileHint: kAudioFileFLACType)
+        _ = backend.parse(data: data.subdata(in: 0 ..< Int(dataOffset)), discontinuous: false)
+
+        // a false sync code followed by the stream starting in the middle of the first frame
+        var garbage = Data([0xFF, 0xF8, 0x69, 0x08, 0x00, 0x12, 0x34])
+        garbage.append(data.subdata(in: Int(dataOffset) + 100 ..< data.count))
+        XCTAssertEqual(backend.parse(data: garbage, discontinuous: false), noErr)
+
+        XCTAssertEqual(spy.parsedPackets, 9)
+    }
+
+    func test_Backend_Seeks_With_SeekTable_Before_Frames_Are_Parsed() throws {
+        let backend = FLACDecoderBackend(outputFormat: outputFormat)
+        _ = backend.open(fileHint: kAudioFileFLACType)
+        _ = backend.parse(data: try fixture("sine-1khz-44100-stereo").subdata(in: 0 ..< Int(dataOffset)), discontinuous: false)
+
+        // the placeholder point is ignored
+        XCTAssertEqual(backend.seekTable.count, 3)
+
+        // sample 22050 is in frame 4, which starts at sample 18432
+        let seek = backend.seek(toPacket: 4, time: 0.5)
+        XCTAssertEqual(seek.status, noErr)
+        XCTAssertFalse(seek.isEstimated)
+        XCTAssertEqual(seek.byteOffset, 5360)
+
+        // sample 41895 is in frame 9, the closest point is frame 8
+        XCTAssertEqual(backend.seek(toPacket: 9, time: 0.95).byteOffset, 10692)
+    }
+
+    func test_Backend_Adds_Parsed_Frames_To_SeekTable() throws {
+        let spy = DecoderBackendDelegateSpy()
+        let backend = FLACDecoderBackend(outputFormat: outputFormat)
+        backend.delegate = spy
+        _ = backend.open(fileHint: kAudioFileFLACType)
+        _ = backend.parse(data: try fixture("sine-1khz-44100-stereo"), discontinuous: false)
+
+        XCTAssertEqual(backend.seekTable.count, 10)
+        let seek = backend.seek(toPacket: 9, time: 0.95)
+        XCTAssertFalse(seek.isEstimated)
+        XCTAssertEqual(seek.byteOffset, spy.packets[0].descriptions[9].mStartOffset - Int64(dataOffset))
+    }
+
+    func test_Backend_Rejects_Streams_Without_Signature() {
+        let backend = FLACDecoderBackend(outputFormat: outputFormat)
+        _ = backend.open(fileHint: kAudioFileFLACType)
+
+        XCTAssertEqual(backend.parse(data: Data("RIFF0000WAVE".utf8), discontinuous: false), kAudioFileStreamError_InvalidFile)
+    }
+
+    func test_Backend_Decodes_Stream_To_Output_Format() throws {
+        let spy = DecoderBackendDelegateSpy()
+        let backend = FLACDecoderBackend(outputFormat: outputFormat)
+        backend.delegate = spy
+        _ = backend.open(fileHint: kAudioFileFLACType)
+        _ = backend.parse(data: try fixture("sine-1khz-44100-stereo"), discontinuous: false)
+
+        let samples = decode(spy: spy, backend: backend, magicCookie: backend.streamMagicCookie())
+
+        // lossless, every sample of the stream is decoded
+        XCTAssertEqual(samples.count / 2, 44100)
+        XCTAssertEqual(rms(samples), 0.0625, accuracy: 0.001)
+        XCTAssertEqual(frequency(of: samples, sampleRate: 44100), 1000, accuracy: 10)
+        XCTAssertTrue(spy.errors.isEmpty)
+    }
+
+    func test_Backend_Decodes_With_Format_Only() throws {
+        let spy = DecoderBackendDelegateSpy()
+        let backend = FLACDecoderBackend(outputFormat: outputFormat)
+        backend.delegate = spy
+        _ = backend.open(fileHint: kAudioFileFLACType)
+        _ = backend.parse(data: try fixture("sine-1khz-44100-stereo"), discontinuous: false)
+
+        // a cached format may come without the STREAMINFO
+        let withStreamInfo = decode(spy: spy, backend: backend, magicCookie: backend.streamMagicCookie())
+        let withFormatOnly = decode(spy: spy, backend: backend, magicCookie: nil)
+
+        XCTAssertEqual(withFormatOnly, withStreamInfo)
+    }
+
+    func test_Backend_Resumes_At_Exact_Sample_After_Seeking() throws {
+        let data = try fixture("sine-1khz-44100-stereo")
+        let spy = DecoderBackendDelegateSpy()
+        let backend = FLACDecoderBackend(outputFormat: outputFormat)
+        backend.delegate = spy
+        _ = backend.open(fileHint: kAudioFileFLACType)
+        _ = backend.parse(data: data, discontinuous: false)
+        let allSamples = decode(spy: spy, backend: backend, magicCookie: backend.streamMagicCookie())
+
+        let seek = backend.seek(toPacket: 4, time: 0.5)
+        let offset = Int(dataOffset) + Int(seek.byteOffset)
+        backend.resetDecoder(resumingAt: UInt64(offset))
+        spy.packets.removeAll()
+        _ = backend.parse(data: data.subdata(in: offset ..< data.count), discontinuous: false)
+        XCTAssertEqual(spy.parsedPackets, 6)
+
+        // the samples of frame 4 before sample 22050 are dropped
+        let samples = decode(spy: spy, backend: backend, magicCookie: backend.streamMagicCookie())
+        XCTAssertEqual(samples.count / 2, 22050)
+        XCTAssertEqual(samples, Array(allSamples[22050 * 2 ..< allSamples.count]))
+    }
+
+    func test_SeekTable_Keeps_Points_Sorted() {
+        var table = SampleSeekTable()
+        table.insert(SampleSeekTable.Point(sample: 4608, offset: 1000))
+        table.insert(SampleSeekTable.Point(sample: 0, offset: 0))
+        table.insert(SampleSeekTable.Point(sample: 13824, offset: 3000))
+        table.insert(SampleSeekTable.Point(sample: 9216, offset: 2000))
+        table.insert(SampleSeekTable.Point(sample: 4608, offset: 1000))
+
+        XCTAssertEqual(table.points.map(\.sample), [0, 4608, 9216, 13824])
+        XCTAssertEqual(table.point(atOrBefore: 9215)?.offset, 1000)
+        XCTAssertEqual(table.point(atOrBefore: 9216)?.offset, 2000)
+        XCTAssertEqual(table.point(atOrBefore: 100_000)?.offset, 3000)
+        XCTAssertNil(SampleSeekTable().point(atOrBefore: 0))
+    }
+
+    // MARK: Helpers
+
+    private func fixture(_ name: String) throws -> Data {
+        let bundle = Bundle(for: FLACDecoderBackendTests.self)
+        let url = bundle.url(forResource: name, withExtension: "flac")!
+        return try Data(contentsOf: url)
+    }
+
+    /// Decodes the packets received by the spy, in chunks of 1024 frames as the player does
+    private func decode(spy: DecoderBackendDelegateSpy, backend: FLACDecoderBackend, magicCookie: Data?) -> [Float] {
+        guard let format = spy.dataFormat else { return [] }
+        backend.prepareDecoder(for: format, magicCookie: magicCookie)
+
+        let bufferList = AudioBufferList.allocate(maximumBuffers: 1)
+        defer { free(bufferList.unsafeMutablePointer) }
+        var output = [Float](repeating: 0, count: 1024 * 2)
+        var samples: [Float] = []
+
+        for packets in spy.packets {
+            var data = packets.data
+            var descriptions = packets.descriptions
+            data.withUnsafeMutableBytes { bytes in
+                descriptions.withUnsafeMutableBufferPointer { descriptionsBuffer in
+                    var convertInfo = AudioConvertInfo(done: false,
+                                                       numberOfPackets: UInt32(packets.count),
+                                                       packDescription: descriptionsBuffer.baseAddress)
+                    convertInfo.audioBuffer.mData = bytes.baseAddress
+                    convertInfo.audioBuffer.mDataByteSize = UInt32(bytes.count)
+                    var status: OSStatus = 0
+                    repeat {
+                        var frameCount: UInt32 = 1024
+                        output.withUnsafeMutableBytes { outputBytes in
+                            bufferList[0] = AudioBuffer(mNumberChannels: 2,
+                                                        mDataByteSize: UInt32(outputBytes.count),
+                                                        mData: outputBytes.baseAddress)
+                            status = backend.decode(&convertInfo, frameCount: &frameCount, into: bufferList)
+                        }
+                        samples.append(contentsOf: output[0 ..< Int(frameCount) * 2])
+                    } while status == AudioConvertStatus.proccessed.rawValue
+                }
+            }
+        }
+        return samples
+    }
+
+    private func rms(_ samples: [Float]) -> Double {
+        let sum = samples.reduce(Double(0)) { $0 + Double($1) * Double($1) }
+        return (sum / Double(samples.count)).squareRoot()
+    }
+
+    /// Estimates the frequency of the left channel by counting zero crossings
+    private func frequency(of samples: [Float], sampleRate: Double) -> Double {
+        let left = stride(from: 0, to: samples.count, by: 2).map { samples[$0] }
+        var crossings = 0
+        for index in 1 ..< left.count where (left[index - 1] < 0) != (left[index] < 0) {
+            crossings += 1
+        }
+        return Double(crossings) / 2 / (Double(left.count) / sampleRate)
+    }
+}
@@ -0,0 +1,315 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import AVFoundation
+import XCTest
+
+@testable import AudioStreaming
+
+class MP3DecoderBackendTests: XCTestCase {
+    private let outputFormat = AudioStreamBasicDescription(mSampleRate: 44100,
+                                                           mFormatID: kAudioFormatLinearPCM,
+                                                           mFormatFlags: kAudioFormatFlagsNativeFloatPacked,
+                                                           mBytesPerPacket: 8,
+                                                           mFramesPerPacket: 1,
+                                                           mBytesPerFrame: 8,
+                                                           mChannelsPerFrame: 2,
+                                                           mBitsPerChannel: 32,
+                                                           mReserved: 0)
+
+    func test_Backend_Discovers_Properties_And_Skips_Info_Frame() throws {
+        let spy = DecoderBackendDelegateSpy()
+        let backend = MP3DecoderBackend(outputFormat: outputFormat)
+        backend.delegate = spy
+
+        XCTAssertEqual(backend.open(fileHint: kAudioFileMP3Type), noErr)
+        XCTAssertEqual(backend.parse(data: try fixture("sine-1khz-44100-stereo"), discontinuous: false), noErr)
+
+        XCTAssertEqual(spy.fileFormat, "3GPM")
+        XCTAssertEqual(spy.dataFormat?.mFormatID, kAudioFormatMPEGLayer3)
+        XCTAssertEqual(spy.dataFormat?.mSampleRate, 44100)
+        XCTAssertEqual(spy.dataFormat?.mChannelsPerFrame, 2)
+        XCTAssertEqual(spy.dataFormat?.mFramesPerPacket, 1152)
+        // the Info frame of the first 417 bytes holds no audio
+        XCTAssertEqual(spy.dataOffset, 417)
+        XCTAssertEqual(spy.packetCount, 40)
+        XCTAssertEqual(spy.readyPacketCount, 40)
+        XCTAssertEqual(spy.parsedPackets, 40)
+    }
+
+    func test_Backend_Parses_Frames_Split_Across_Chunks() throws {
+        let data = try fixture("sine-1khz-44100-stereo")
+        let spy = DecoderBackendDelegateSpy()
+        let backend = MP3DecoderBackend(outputFormat: outputFormat)
+        backend.delegate = spy
+        _ = backend.open(fileHint: kAudioFileMP3Type)
+
+        var offset = 0
+        while offset < data.count {
+            let chunk = data.subdata(in: offset ..< min(offset + 100, data.count))
+            XCTAssertEqual(backend.parse(data: chunk, discontinuous: false), noErr)
+            offset += 100
+        }
+
+        XCTAssertEqual(spy.dataOffset, 417)
+        XCTAssertEqual(spy.parsedPackets, 40)
+        // frames are reported as soon as the chunk completing them arrives
+        XCTAssertGreaterThan(spy.packets.count, 30)
+    }
+
+    func test_Backend_Resyncs_After_Garbage() throws {
+        let data = try fixture("sine-1khz-44100-stereo")
+        let spy = DecoderBackendDelegateSpy()
+        let backend = MP3DecoderBackend(outputFormat: outputFormat)
+        backend.delegate = spy
+        _ = backend.open(fileHint: kAudioFileMP3Type)
+
+        // a false sync word followed by the stream starting in the middle of a frame
+        var garbage = Data([0xFF, 0xFB, 0x90, 0x00, 0x12, 0x34])
+        garbage.append(data.subdata(in: 1000 ..< data.count))
+        XCTAssertEqual(backend.parse(data: garbage, discontinuous: false), noErr)
+
+        XCTAssertNil(spy.packetCount)
+        // the frames after the one cut at byte 1000
+        XCTAssertEqual(spy.parsedPackets, 38)
+    }
+
+    func test_Backend_Indexes_Frames_For_Exact_Seeking() throws {
+        let spy = DecoderBackendDelegateSpy()
+        let backend = MP3DecoderBackend(outputFormat: outputFormat)
+        backend.delegate = spy
+        _ = backend.open(fileHint: kAudioFileMP3Type)
+        _ = backend.parse(data: try fixture("sine-1khz-44100-stereo"), discontinuous: false)
+
+        XCTAssertEqual(backend.frameIndex?.count, 40)
+        XCTAssertEqual(backend.frameIndex?.endOffset, 17135)
+        XCTAssertEqual(backend.frameIndex?.frames.first, MPEGFrameIndex.Frame(offset: 417, size: 417, bitrate: 128))
+        // the Info frame reports the byte and frame counts of the stream
+        XCTAssertEqual(spy.bitRates.count, 1)
+        XCTAssertEqual(spy.bitRates.first ?? 0, 128_000, accuracy: 500)
+
+        let seek = backend.seek(toPacket: 10, time: 0)
+        XCTAssertEqual(seek.status, noErr)
+        XCTAssertFalse(seek.isEstimated)
+        XCTAssertEqual(seek.byteOffset, 4179)
+        XCTAssertEqual(seek.byteOffset, spy.packets[0].descriptions[10].mStartOffset - 417)
+
+        XCTAssertTrue(backend.seek(toPacket: 40, time: 0).isEstimated)
+    }
+
+    func test_Backend_Continues_Indexing_After_Seeking_Back() throws {
+        let data = try fixture("sine-1khz-44100-stereo")
+        let spy = DecoderBackendDelegateSpy()
+        let backend = MP3DecoderBackend(outputFormat: outputFormat)
+        backend.delegate = spy
+        _ = backend.open(fileHint: kAudioFileMP3Type)
+        _ = backend.parse(data: data.subdata(in: 0 ..< 5000), discontinuous: false)
+        XCTAssertEqual(backend.frameIndex?.count, 10)
+
+        // seek back to packet 5
+        let offset = backend.seek(toPacket: 5, time: 0).byteOffset + 417
+        backend.resetDecoder(resumingAt: UInt64(offset))
+        _ = backend.parse(data: data.subdata(in: Int(offset) ..< data.count), discontinuous: false)
+
+        XCTAssertEqual(backend.frameIndex?.count, 40)
+        XCTAssertEqual(backend.frameIndex?.endOffset, 17135)
+    }
+
+    func test_Backend_Resyncs_After_Reconnecting_At_Arbitrary_Offset() throws {
+        let data = try fixture("sine-1khz-44100-stereo")
+        let spy = DecoderBackendDelegateSpy()
+        let backend = MP3DecoderBackend(outputFormat: outputFormat)
+        backend.delegate = spy
+        _ = backend.open(fileHint: kAudioFileMP3Type)
+
+        _ = backend.parse(data: data.subdata(in: 0 ..< 5000), discontinuous: false)
+        XCTAssertEqual(spy.parsedPackets, 10)
+        // the stream continues from a later offset without notice, the frame cut by the gap is dropped
+        _ = backend.parse(data: data.subdata(in: 9000 ..< data.count), discontinuous: false)
+
+        XCTAssertEqual(spy.parsedPackets, 10 + 19)
+        // frames after the gap are at unknown packet numbers
+        XCTAssertEqual(backend.frameIndex?.count, 10)
+    }
+
+    func test_Frame_Index_Only_Appends_Consecutive_Frames() {
+        var index = MPEGFrameIndex(dataOffset: 100, samplesPerFrame: 1152, sampleRate: 44100)
+        XCTAssertEqual(index.averageBitRate, 0)
+
+        XCTAssertTrue(index.append(offset: 100, size: 417, bitrate: 128))
+        XCTAssertFalse(index.append(offset: 600, size: 418, bitrate: 128))
+        XCTAssertTrue(index.append(offset: 517, size: 418, bitrate: 128))
+
+        XCTAssertEqual(index.count, 2)
+        XCTAssertEqual(index.endOffset, 935)
+        XCTAssertEqual(index.byteOffset(ofPacket: 1), 417)
+        XCTAssertNil(index.byteOffset(ofPacket: 2))
+        XCTAssertEqual(index.averageBitRate, 835.0 * 8 / (2.0 * 1152 / 44100), accuracy: 1)
+    }
+
+    func test_Backend_Decodes_Stereo_Stream_To_Output_Format() throws {
+        let spy = DecoderBackendDelegateSpy()
+        let backend = MP3DecoderBackend(outputFormat: outputFormat)
+        backend.delegate = spy
+        _ = backend.open(fileHint: kAudioFileMP3Type)
+        _ = backend.parse(data: try fixture("sine-1khz-44100-stereo"), discontinuous: false)
+
+        let samples = decode(spy: spy, backend: backend)
+
+        XCTAssertEqual(samples.count / 2, 40 * 1152)
+        // skip the encoder delay and measure the sine
+        let steady = Array(samples[8192 ..< 40960])
+        XCTAssertEqual(rms(steady), 0.0594, accuracy: 0.005)
+        XCTAssertEqual(frequency(of: steady, sampleRate: 44100), 1000, accuracy: 10)
+    }
+
+    func test_Backend_Resamples_Mono_Stream_To_Output_Format() throws {
+        let spy = DecoderBackendDelegateSpy()
+        let backend = MP3DecoderBackend(outputFormat: outputFormat)
+        backend.delegate = spy
+        _ = backend.open(fileHint: kAudioFileMP3Type)
+        _ = backend.parse(data: try fixture("sine-440hz-22050-mono"), discontinuous: false)
+
+        XCTAssertEqual(spy.dataFormat?.mSampleRate, 22050)
+        XCTAssertEqual(spy.dataFormat?.mChannelsPerFrame, 1)
+        XCTAssertEqual(spy.packetCount, 41)
+
+        let samples = decode(spy: spy, backend: backend)
+
+        XCTAssertEqual(Double(samples.count / 2), Double(41 * 576 * 2), accuracy: 2)
+        let steady = Array(samples[8192 ..< 40960])
+        // mono is copied to both channels
+        XCTAssertEqual(steady[1000], steady[1001])
+        XCTAssertEqual(frequency(of: steady, sampleRate: 44100), 440, accuracy: 10)
+    }
+
+    func test_Resampler_Keeps_Rate_And_Continuity_Across_Blocks() {
+        var resampler = PCMResampler(inputSampleRate: 22050, outputSampleRate: 44100)
+        let ramp = (0 ..< 200).map(Float.init)
+        var output: [Float] = []
+        ramp.withUnsafeBufferPointer { buffer in
+            resampler.process(input: buffer.baseAddress!, frameCount: 100, channels: 1, output: &output)
+            resampler.process(input: buffer.baseAddress! + 100, frameCount: 100, channels: 1, output: &output)
+        }
+
+        let left = stride(from: 0, to: output.count, by: 2).map { output[$0] }
+        XCTAssertEqual(left.count, 398)
+        for (index, value) in left.enumerated() {
+            XCTAssertEqual(value, Float(index) / 2, accuracy: 0.0001)
+        }
+    }
+
+    // MARK: Helpers
+
+    private func fixture(_ name: String) throws -> Data {
+        let bundle = Bundle(for: MP3DecoderBackendTests.self)
+        let url = bundle.url(forResource: name, withExtension: "mp3")!
+        return try Data(contentsOf: url)
+    }
+
+    /// Decodes the packets received by the spy, in chunks of 1024 frames as the player does
+    private func decode(spy: DecoderBackendDelegateSpy, backend: MP3DecoderBackend) -> [Float] {
+        guard let format = spy.dataFormat else { return [] }
+        backend.prepareDecoder(for: format, magicCookie: nil)
+
+        let bufferList = AudioBufferList.allocate(maximumBuffers: 1)
+        defer { free(bufferList.unsafeMutablePointer) }
+        var output = [Float](repeating: 0, count: 1024 * 2)
+        var samples: [Float] = []
+
+        for packets in spy.packets {
+            var data = packets.data
+            var descriptions = packets.descriptions
+            data.withUnsafeMutableBytes { bytes in
+                descriptions.withUnsafeMutableBufferPointer { descriptionsBuffer in
+                    var convertInfo = AudioConvertInfo(done: false,
+                                                       numberOfPackets: UInt32(packets.count),
+                                                       packDescription: descriptionsBuffer.baseAddress)
+                    convertInfo.audioBuffer.mData = bytes.baseAddress
+                    convertInfo.audioBuffer.mDataByteSize = UInt32(bytes.count)
+                    var status: OSStatus = 0
+                    repeat {
+                        var frameCount: UInt32 = 1024
+                        output.withUnsafeMutableBytes { outputBytes in
+                            bufferList[0] = AudioBuffer(mNumberChannels: 2,
+                                                        mDataByteSize: UInt32(outputBytes.count),
+                                                        mData: outputBytes.baseAddress)
+                            status = backend.decode(&convertInfo, frameCount: &frameCount, into: bufferList)
+                        }
+                        samples.append(contentsOf: output[0 ..< Int(frameCount) * 2])
+                    } while status == AudioConvertStatus.proccessed.rawValue
+                }
+            }
+        }
+        return samples
+    }
+
+    private func rms(_ samples: [Float]) -> Double {
+        let sum = samples.reduce(Double(0)) { $0 + Double($1) * Double($1) }
+        return (sum / Double(samples.count)).squareRoot()
+    }
+
+    /// Estimates the frequency of the left channel by counting zero crossings
+    private func frequency(of samples: [Float], sampleRate: Double) -> Double {
+        let left = stride(from: 0, to: samples.count, by: 2).map { samples[$0] }
+        var crossings = 0
+        for index in 1 ..< left.count where (left[index - 1] < 0) != (left[index] < 0) {
+            crossings += 1
+        }
+        return Double(crossings) / 2 / (Double(left.count) / sampleRate)
+    }
+}
+
+final class DecoderBackendDelegateSpy: AudioDecoderBackendDelegate {
+    struct ParsedPackets {
+        /// The address of the packets as reported, only valid during the delegate call
+        let address: UnsafeRawPointer
+        let data: Data
+        let count: Int
+        let descriptions: [AudioStreamPacketDescription]
+    }
+
+    var fileFormat: String?
+    var dataFormat: AudioStreamBasicDescription?
+    var dataOffset: UInt64?
+    var packetCount: UInt64?
+    var readyPacketCount: UInt64?
+    var bitRates: [Double] = []
+    var packets: [ParsedPackets] = []
+    var errors: [AudioPlayerError] = []
+
+    var parsedPackets: Int {
+        packets.map(\.count).reduce(0, +)
+    }
+
+    func decoderBackend(_: AudioDecoderBackend, didDiscover property: AudioStreamProperty) {
+        switch property {
+        case let .fileFormat(format):
+            fileFormat = format
+        case let .dataFormat(format, _):
+            dataFormat = format
+        case let .dataOffset(offset):
+            dataOffset = offset
+        case let .audioDataPacketCount(count):
+            packetCount = count
+        case let .readyToProducePackets(count):
+            readyPacketCount = count
+        case let .bitRate(rate):
+            bitRates.append(rate)
+        case .formatList, .audioDataByteCount:
+            break
+        }
+    }
+
+    func decoderBackend(_: AudioDecoderBackend, didParse packets: AudioPackets) {
+        let data = Data(bytes: packets.data, count: Int(packets.byteCount))
+        let descriptions = (0 ..< Int(packets.count)).map { packets.descriptions![$0] }
+        self.packets.append(ParsedPackets(address: packets.data, data: data, count: Int(packets.count), descriptions: descriptions))
+    }
+
+    func decoderBackend(_: AudioDecoderBackend, didFailWith error: AudioPlayerError) {
+        errors.append(error)
+    }
+}
@@ -0,0 +1,293 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import AVFoundation
+import XCTest
+
+@testable import AudioStreaming
+
+class OggDemuxerBackendTests: XCTestCase {
+    private let outputFormat = AudioStreamBasicDescription(mSampleRate: 44100,
+                                                           mFormatID: kAudioFormatLinearPCM,
+                                                           mFormatFlags: kAudioFormatFlagsNativeFloatPacked,
+                                                           mBytesPerPacket: 8,
+                                                           mFramesPerPacket: 1,
+                                                           mBytesPerFrame: 8,
+                                                           mChannelsPerFrame: 2,
+                                                           mBitsPerChannel: 32,
+                                                           mReserved: 0)
+
+    // the Vorbis fixture is one second of stereo with block sizes of 256 and 2048, in 45 audio packets on 9 pages
+    // of about 100ms, the headers end at byte 3912
+    private let dataOffset: UInt64 = 3912
+
+    func test_Backend_Discovers_Vorbis_Properties_From_Headers() throws {
+        let spy = DecoderBackendDelegateSpy()
+        let backend = OggDemuxerBackend(outputFormat: outputFormat)
+        backend.delegate = spy
+
+        XCTAssertEqual(backend.open(fileHint: oggFileType), noErr)
+        XCTAssertEqual(backend.parse(data: try fixture("sine-1khz-44100-stereo.ogg"), discontinuous: false), noErr)
+
+        XCTAssertEqual(backend.codec, .vorbis)
+        XCTAssertEqual(spy.fileFormat, "SggO")
+        XCTAssertEqual(spy.dataFormat?.mFormatID, OggDemuxerBackend.vorbisFormatID)
+        XCTAssertEqual(spy.dataFormat?.mSampleRate, 44100)
+        XCTAssertEqual(spy.dataFormat?.mChannelsPerFrame, 2)
+        XCTAssertEqual(spy.dataFormat?.mFramesPerPacket, 1024)
+        XCTAssertEqual(spy.dataOffset, dataOffset)
+        XCTAssertEqual(spy.readyPacketCount, 0)
+        XCTAssertEqual(spy.bitRates.first, 64000)
+        XCTAssertEqual(spy.parsedPackets, 45)
+        // the identification and setup headers, each preceded by its size
+        XCTAssertEqual(backend.streamMagicCookie()?.count, 4 + 30 + 4 + 3763)
+    }
+
+    func test_Backend_Reassembles_Pages_Split_Across_Chunks() throws {
+        let data = try fixture("sine-1khz-44100-stereo.ogg")
+        for chunkSize in [1, 100, 1000] {
+            let spy = DecoderBackendDelegateSpy()
+            let backend = OggDemuxerBackend(outputFormat: outputFormat)
+            backend.delegate = spy
+            _ = backend.open(fileHint: oggFileType)
+
+            var offset = 0
+            while offset < data.count {
+                let chunk = data.subdata(in: offset ..< min(offset + chunkSize, data.count))
+                XCTAssertEqual(backend.parse(data: chunk, discontinuous: false), noErr)
+                offset += chunkSize
+            }
+
+            XCTAssertEqual(spy.dataOffset, dataOffset, "chunk size \(chunkSize)")
+            XCTAssertEqual(spy.parsedPackets, 45, "chunk size \(chunkSize)")
+        }
+    }
+
+    func test_Backend_Resyncs_After_Garbage() throws {
+        let data = try fixture("sine-1khz-44100-stereo.ogg")
+        let spy = DecoderBackendDelegateSpy()
+        let backend = OggDemuxerBackend(outputFormat: outputFormat)
+        backend.delegate = spy
+        _ = backend.open(fileHint: oggFileType)
+        _ = backend.parse(data: data.subdata(in: 0 ..< Int(dataOffset)), discontinuous: false)
+
+        // a false capture pattern followed by the stream starting in the middle of the first audio page
+        var garbage = Data("OggS".utf8)
+        garbage.append(Data(repeating: 0xFF, count: 30))
+        garbage.append(data.subdata(in: Int(dataOffset) + 100 ..< data.count))
+        XCTAssertEqual(backend.parse(data: garbage, discontinuous: false), noErr)
+
+        // the 6 packets of the first audio page are lost
+        XCTAssertEqual(spy.parsedPackets, 39)
+    }
+
+    func test_Backend_Rejects_Streams_Without_Supported_Codec() {
+        let backend = OggDemuxerBackend(outputFormat: outputFormat)
+        _ = backend.open(fileHint: oggFileType)
+
+        // a page following the first page of an unknown stream
+        var page = [UInt8](repeating: 0, count: 28)
+        page.replaceSubrange(0 ..< 4, with: Array("OggS".utf8))
+        page[18] = 1
+        page[26] = 1
+        page[27] = 0
+        let checksum = crc(page)
+        page.replaceSubrange(22 ..< 26, with: [UInt8(checksum & 0xFF), UInt8(checksum >> 8 & 0xFF),
+                                               UInt8(checksum >> 16 & 0xFF), UInt8(checksum >> 24)])
+
+        XCTAssertEqual(backend.parse(data: Data(page), discontinuous: false), kAudioFileStreamError_UnsupportedDataFormat)
+    }
+
+    func test_Backend_Decodes_Vorbis_To_Output_Format() throws {
+        let decoder = DecodingDelegate()
+        let backend = OggDemuxerBackend(outputFormat: outputFormat)
+        backend.delegate = decoder
+        _ = backend.open(fileHint: oggFileType)
+        _ = backend.parse(data: try fixture("sine-1khz-44100-stereo.ogg"), discontinuous: false)
+
+        // the granule positions trim the stream to exactly one second
+        XCTAssertEqual(decoder.samples.count / 2, 44100)
+        XCTAssertEqual(frequency(of: decoder.samples, sampleRate: 44100), 1000, accuracy: 10)
+        // the level of the reference decode of the fixture by ffmpeg, its encoder wrote it at -39dBFS RMS
+        XCTAssertEqual(rms(decoder.samples), 0.0111, accuracy: 0.0005)
+        XCTAssertTrue(decoder.spy.errors.isEmpty)
+    }
+
+    func test_Backend_Follows_Chained_Streams() throws {
+        let decoder = DecodingDelegate()
+        let backend = OggDemuxerBackend(outputFormat: outputFormat)
+        backend.delegate = decoder
+        _ = backend.open(fileHint: oggFileType)
+
+        // two streams of half a second, 440Hz then 880Hz, in chunks that don't align with the pages
+        let data = try fixture("chained-440hz-880hz-44100-stereo.ogg")
+        var offset = 0
+        while offset < data.count {
+            XCTAssertEqual(backend.parse(data: data.subdata(in: offset ..< min(offset + 1000, data.count)), discontinuous: false), noErr)
+            offset += 1000
+        }
+
+        XCTAssertEqual(decoder.spy.dataOffset, dataOffset)
+        XCTAssertEqual(decoder.spy.parsedPackets, 46)
+        XCTAssertEqual(decoder.samples.count / 2, 44100)
+        XCTAssertEqual(frequency(of: Array(decoder.samples[0 ..< 44100]), sampleRate: 44100), 440, accuracy: 10)
+        XCTAssertEqual(frequency(of: Array(decoder.samples[44100 ..< 88200]), sampleRate: 44100), 880, accuracy: 10)
+        XCTAssertTrue(decoder.spy.errors.isEmpty)
+    }
+
+    func test_Backend_Seeks_With_Granule_Positions() throws {
+        let backend = OggDemuxerBackend(outputFormat: outputFormat)
+        _ = backend.open(fileHint: oggFileType)
+        _ = backend.parse(data: try fixture("sine-1khz-44100-stereo.ogg"), discontinuous: false)
+
+        // a point at the start plus the 9 audio pages
+        XCTAssertEqual(backend.seekTable.count, 10)
+
+        // sample 22050 less the preroll of 2048 samples, the page ending at 14912 is the closest
+        let seek = backend.seek(toPacket: 21, time: 0.5)
+        XCTAssertEqual(seek.status, noErr)
+        XCTAssertFalse(seek.isEstimated)
+        XCTAssertEqual(seek.byteOffset, 829)
+
+        XCTAssertEqual(backend.seek(toPacket: 0, time: 0).byteOffset, 0)
+    }
+
+    func test_Backend_Resumes_At_Exact_Sample_After_Seeking() throws {
+        let data = try fixture("sine-1khz-44100-stereo.ogg")
+        let decoder = DecodingDelegate()
+        let backend = OggDemuxerBackend(outputFormat: outputFormat)
+        backend.delegate = decoder
+        _ = backend.open(fileHint: oggFileType)
+        _ = backend.parse(data: data, discontinuous: false)
+        let allSamples = decoder.samples
+
+        for time in [0.25, 0.5, 0.95] {
+            let seek = backend.seek(toPacket: 0, time: time)
+            let offset = Int(dataOffset) + Int(seek.byteOffset)
+            backend.resetDecoder(resumingAt: UInt64(offset))
+            decoder.samples.removeAll()
+            _ = backend.parse(data: data.subdata(in: offset ..< data.count), discontinuous: false)
+
+            // the samples decoded before the seek time are dropped
+            let sample = Int(time * 44100)
+            XCTAssertEqual(decoder.samples.count / 2, 44100 - sample, "time \(time)")
+            XCTAssertEqual(decoder.samples, Array(allSamples[sample * 2 ..< allSamples.count]), "time \(time)")
+        }
+    }
+
+    func test_Backend_Parses_Opus_Packets() throws {
+        let spy = DecoderBackendDelegateSpy()
+        let backend = OggDemuxerBackend(outputFormat: outputFormat)
+        backend.delegate = spy
+        _ = backend.open(fileHint: oggFileType)
+        _ = backend.parse(data: try fixture("sine-1khz-48000-stereo.opus"), discontinuous: false)
+
+        // one second of 20ms packets with a pre-skip of 312 samples
+        XCTAssertEqual(backend.codec, .opus)
+        XCTAssertEqual(spy.dataFormat?.mFormatID, kAudioFormatOpus)
+        XCTAssertEqual(spy.dataFormat?.mSampleRate, 48000)
+        XCTAssertEqual(spy.dataFormat?.mChannelsPerFrame, 2)
+        XCTAssertEqual(spy.dataOffset, 121)
+        XCTAssertEqual(spy.parsedPackets, 51)
+        XCTAssertEqual(backend.streamMagicCookie()?.count, 19)
+
+        // sample 24000 after the pre-skip, less the preroll of 3840 samples
+        let seek = backend.seek(toPacket: 25, time: 0.5)
+        XCTAssertFalse(seek.isEstimated)
+        XCTAssertEqual(seek.byteOffset, 1297)
+    }
+
+    func test_Opus_Packet_Duration_From_TOC() {
+        func duration(_ bytes: [UInt8]) -> Int? {
+            bytes.withUnsafeBufferPointer { OggDemuxerBackend.opusPacketDuration($0.baseAddress!, count: $0.count) }
+        }
+        // CELT 20ms, one frame
+        XCTAssertEqual(duration([31 << 3]), 960)
+        // SILK 60ms, two frames
+        XCTAssertEqual(duration([3 << 3 | 1]), 5760)
+        // hybrid 10ms, three frames signalled by code 3
+        XCTAssertEqual(duration([12 << 3 | 3, 3]), 1440)
+        // code 3 without its frame count
+        XCTAssertNil(duration([12 << 3 | 3]))
+        // longer than 120ms
+        XCTAssertNil(duration([3 << 3 | 3, 3]))
+    }
+
+    // MARK: Helpers
+
+    private func fixture(_ name: String) throws -> Data {
+        let bundle = Bundle(for: OggDemuxerBackendTests.self)
+        let url = bundle.url(forResource: (name as NSString).deletingPathExtension,
+                             withExtension: (name as NSString).pathExtension)!
+        return try Data(contentsOf: url)
+    }
+
+    /// The CRC-32 of an Ogg page
+    private func crc(_ bytes: [UInt8]) -> UInt32 {
+        var crc: UInt32 = 0
+        for byte in bytes {
+            crc ^= UInt32(byte) << 24
+            for _ in 0 ..< 8 {
+                crc = crc & 0x8000_0000 != 0 ? (crc << 1) ^ 0x04C1_1DB7 : crc << 1
+            }
+        }
+        return crc
+    }
+
+    private func rms(_ samples: [Float]) -> Double {
+        let sum = samples.reduce(Double(0)) { $0 + Double($1) * Double($1) }
+        return (sum / Double(samples.count)).squareRoot()
+    }
+
+    /// Estimates the frequency of the left channel by counting zero crossings
+    private func frequency(of samples: [Float], sampleRate: Double) -> Double {
+        let left = stride(from: 0, to: samples.count, by: 2).map { samples[$0] }
+        var crossings = 0
+        for index in 1 ..< left.count where (left[index - 1] < 0) != (left[index] < 0) {
+            crossings += 1
+        }
+        return Double(crossings) / 2 / (Double(left.count) / sampleRate)
+    }
+}
+
+/// Decodes the packets while they are parsed as the player does, in chunks of 1024 frames,
+/// so the decoder follows the format changes of chained streams
+private final class DecodingDelegate: AudioDecoderBackendDelegate {
+    let spy = DecoderBackendDelegateSpy()
+    var samples: [Float] = []
+
+    func decoderBackend(_ backend: AudioDecoderBackend, didDiscover property: AudioStreamProperty) {
+        spy.decoderBackend(backend, didDiscover: property)
+        if case let .dataFormat(format, _) = property {
+            backend.prepareDecoder(for: format, magicCookie: backend.streamMagicCookie())
+        }
+    }
+
+    func decoderBackend(_ backend: AudioDecoderBackend, didParse packets: AudioPackets) {
+        spy.decoderBackend(backend, didParse: packets)
+        let bufferList = AudioBufferList.allocate(maximumBuffers: 1)
+        defer { free(bufferList.unsafeMutablePointer) }
+        var output = [Float](repeating: 0, count: 1024 * 2)
+
+        var convertInfo = AudioConvertInfo(done: false, numberOfPackets: packets.count, packDescription: packets.descriptions)
+        convertInfo.audioBuffer.mData = UnsafeMutableRawPointer(mutating: packets.data)
+        convertInfo.audioBuffer.mDataByteSize = packets.byteCount
+        var status: OSStatus = 0
+        repeat {
+            var frameCount: UInt32 = 1024
+            output.withUnsafeMutableBytes { outputBytes in
+                bufferList[0] = AudioBuffer(mNumberChannels: 2,
+                                            mDataByteSize: UInt32(outputBytes.count),
+                                            mData: outputBytes.baseAddress)
+                status = backend.decode(&convertInfo, frameCount: &frameCount, into: bufferList)
+            }
+            samples.append(contentsOf: output[0 ..< Int(frameCount) * 2])
+        } while status == AudioConvertStatus.proccessed.rawValue
+    }
+
+    func decoderBackend(_ backend: AudioDecoderBackend, didFailWith error: AudioPlayerError) {
+        spy.decoderBackend(backend, didFailWith: error)
+    }
+}
@@ -0,0 +1,174 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import XCTest
+
+@testable import AudioStreaming
+
+class EntryMetadataQueueTests: XCTestCase {
+    private let queue = DispatchQueue(label: "entry.metadata.queue.tests")
+
+    override func setUp() {
+        super.setUp()
+        StaticFileURLProtocol.reset()
+    }
+
+    override func tearDown() {
+        StaticFileURLProtocol.reset()
+        super.tearDown()
+    }
+
+    // MARK: Queue
+
+    func test_Metadata_Is_Claimed_Once_Playback_Reaches_It() {
+        let metadataQueue = EntryMetadataQueue()
+        metadataQueue.enqueue(["StreamTitle": "First"], at: 0)
+        metadataQueue.enqueue(["StreamTitle": "Second"], at: 44100)
+
+        XCTAssertTrue(metadataQueue.claim(playedFrame: 0))
+        // claimed until dequeued
+        XCTAssertFalse(metadataQueue.claim(playedFrame: 512))
+        XCTAssertEqual(metadataQueue.dequeue(reachedAt: 512), [["StreamTitle": "First"]])
+        XCTAssertEqual(metadataQueue.nextFrame.value, 44100)
+
+        XCTAssertFalse(metadataQueue.claim(playedFrame: 44099))
+        XCTAssertTrue(metadataQueue.claim(playedFrame: 44100))
+        XCTAssertEqual(metadataQueue.dequeue(reachedAt: 44100), [["StreamTitle": "Second"]])
+        XCTAssertTrue(metadataQueue.isEmpty)
+        XCTAssertEqual(metadataQueue.nextFrame.value, .max)
+    }
+
+    func test_Metadata_Reached_Together_Is_Dequeued_In_Order() {
+        let metadataQueue = EntryMetadataQueue()
+        metadataQueue.enqueue(["StreamTitle": "First"], at: 100)
+        metadataQueue.enqueue(["StreamTitle": "Second"], at: 200)
+        metadataQueue.enqueue(["StreamTitle": "Third"], at: 300)
+
+        XCTAssertEqual(metadataQueue.dequeue(reachedAt: 250), [["StreamTitle": "First"], ["StreamTitle": "Second"]])
+        XCTAssertEqual(metadataQueue.nextFrame.value, 300)
+    }
+
+    func test_Oldest_Metadata_Is_Dropped_Over_Capacity() {
+        let metadataQueue = EntryMetadataQueue(capacity: 2)
+        metadataQueue.enqueue(["StreamTitle": "First"], at: 100)
+        metadataQueue.enqueue(["StreamTitle": "Second"], at: 200)
+        metadataQueue.enqueue(["StreamTitle": "Third"], at: 300)
+
+        XCTAssertEqual(metadataQueue.nextFrame.value, 200)
+        XCTAssertEqual(metadataQueue.dequeue(reachedAt: 300), [["StreamTitle": "Second"], ["StreamTitle": "Third"]])
+    }
+
+    func test_Reset_Removes_Metadata() {
+        let metadataQueue = EntryMetadataQueue()
+        metadataQueue.enqueue(["StreamTitle": "First"], at: 100)
+
+        metadataQueue.reset()
+
+        XCTAssertTrue(metadataQueue.isEmpty)
+        XCTAssertFalse(metadataQueue.claim(playedFrame: 1000))
+    }
+
+    func test_Metadata_Is_Reported_Within_A_Render_Cycle_Of_Its_Frame() {
+        let metadataQueue = EntryMetadataQueue()
+        let frames = [0, 1000, 44100, 44101, 100_000]
+        for frame in frames {
+            metadataQueue.enqueue(["frame": "\(frame)"], at: frame)
+        }
+
+        var reportedFrames: [Int: Int] = [:]
+        for played in stride(from: 0, through: 110_000, by: 512) where metadataQueue.claim(playedFrame: played) {
+            for metadata in metadataQueue.dequeue(reachedAt: played) {
+                reportedFrames[Int(metadata["frame"]!)!] = played
+            }
+        }
+
+        XCTAssertEqual(reportedFrames.keys.sorted(), frames)
+        for (frame, played) in reportedFrames {
+            XCTAssertGreaterThanOrEqual(played, frame)
+            XCTAssertLessThan(played - frame, 512)
+        }
+    }
+
+    // MARK: Remote source
+
+    func test_Icy_Metadata_Is_Reported_At_Its_Offset_In_The_Audio() throws {
+        let audio = try fixture()
+        StaticFileURLProtocol.serve("radio.mp3", data: [icyStream(audio, step: 4000)], live: true,
+                                    headers: ["icy-metaint": "4000"])
+
+        let (_, spy) = play("radio.mp3", timeShiftBufferSize: 0)
+
+        XCTAssertNil(spy.error)
+        XCTAssertEqual(spy.data, audio)
+        XCTAssertEqual(spy.metadataOffsets, [4000, 8000, 12000, 16000])
+        XCTAssertEqual(spy.metadata.map { $0["StreamTitle"] }, ["4000", "8000", "12000", "16000"])
+    }
+
+    func test_Time_Shifted_Icy_Metadata_Is_Reported_At_Its_Offset_After_Seeking() throws {
+        let audio = try fixture()
+        StaticFileURLProtocol.serve("radio.mp3", data: [icyStream(audio, step: 4000)], live: true,
+                                    headers: ["icy-metaint": "4000"])
+
+        let (source, spy) = play("radio.mp3", timeShiftBufferSize: 1024 * 1024)
+
+        XCTAssertEqual(spy.data, audio)
+        XCTAssertEqual(spy.metadataOffsets, [4000, 8000, 12000, 16000])
+
+        // the metadata in effect at the position sought to is reported first
+        spy.data = Data()
+        spy.metadata = []
+        spy.metadataOffsets = []
+        spy.ended = expectation(description: "ended after seek")
+        queue.sync {
+            source.seek(at: 8100)
+        }
+        wait(for: [spy.ended], timeout: 5)
+
+        XCTAssertEqual(spy.data, audio.suffix(from: 8100))
+        XCTAssertEqual(spy.metadataOffsets, [0, 3900, 7900])
+        XCTAssertEqual(spy.metadata.map { $0["StreamTitle"] }, ["8000", "12000", "16000"])
+    }
+
+    // MARK: Helpers
+
+    /// Interleaves the audio with a metadata block every `step` bytes, titled after the offset of the audio it follows
+    private func icyStream(_ audio: Data, step: Int) -> Data {
+        var stream = Data()
+        for offset in stride(from: 0, to: audio.count, by: step) {
+            let end = min(offset + step, audio.count)
+            stream.append(audio.subdata(in: offset ..< end))
+            guard end - offset == step else { break }
+            let text = Data("StreamTitle='\(end)';".utf8)
+            let blocks = (text.count + 15) / 16
+            stream.append(UInt8(blocks))
+            stream.append(text)
+            stream.append(Data(count: blocks * 16 - text.count))
+        }
+        return stream
+    }
+
+    private func play(_ name: String, timeShiftBufferSize: Int) -> (RemoteAudioSource, SourceDelegateSpy) {
+        let configuration = URLSessionConfiguration.ephemeral
+        configuration.protocolClasses = [StaticFileURLProtocol.self]
+        let source = RemoteAudioSource(networking: NetworkingClient(configuration: configuration),
+                                       url: URL(string: "https://\(StaticFileURLProtocol.host)/\(name)")!,
+                                       underlyingQueue: queue,
+                                       httpHeaders: [:],
+                                       timeShiftBufferSize: timeShiftBufferSize)
+        let spy = SourceDelegateSpy(ended: expectation(description: "ended"))
+        queue.sync {
+            source.delegate = spy
+            source.seek(at: 0)
+        }
+        wait(for: [spy.ended], timeout: 5)
+        return (source, spy)
+    }
+
+    private func fixture() throws -> Data {
+        let bundle = Bundle(for: EntryMetadataQueueTests.self)
+        let url = try XCTUnwrap(bundle.url(forResource: "sine-1khz-44100-stereo", withExtension: "mp3"))
+        return try Data(contentsOf: url)
+    }
+}
@@ -0,0 +1,95 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import AudioToolbox
+import XCTest
+
+@testable import AudioStreaming
+
+class FastStartCacheTests: XCTestCase {
+    private func format(sampleRate: Double, formatId: AudioFormatID = kAudioFormatMPEGLayer3) -> FastStartFormat {
+        var streamFormat = AudioStreamBasicDescription()
+        streamFormat.mSampleRate = sampleRate
+        streamFormat.mFormatID = formatId
+        streamFormat.mFramesPerPacket = 1152
+        streamFormat.mChannelsPerFrame = 2
+        return FastStartFormat(streamFormat: streamFormat, magicCookie: Data([0x01, 0x02]))
+    }
+
+    func testFormatIsCachedPerURLIgnoringQuery() {
+        let cache = FastStartCache()
+        let url = URL(string: "https://radio.example.com/stream.mp3?token=1")!
+        cache.store(format(sampleRate: 44100), for: url)
+
+        let cached = cache.format(for: URL(string: "https://radio.example.com/stream.mp3?token=2")!)
+        XCTAssertEqual(cached?.streamFormat.mSampleRate, 44100)
+        XCTAssertEqual(cached?.magicCookie, Data([0x01, 0x02]))
+    }
+
+    func testFormatFallsBackToSameHostAndExtension() {
+        let cache = FastStartCache()
+        cache.store(format(sampleRate: 48000), for: URL(string: "https://cdn.example.com/a/track1.mp3")!)
+
+        XCTAssertEqual(cache.format(for: URL(string: "https://cdn.example.com/b/track2.mp3")!)?.streamFormat.mSampleRate, 48000)
+        XCTAssertNil(cache.format(for: URL(string: "https://cdn.example.com/b/track2.aac")!))
+        XCTAssertNil(cache.format(for: URL(string: "https://other.example.com/b/track2.mp3")!))
+    }
+
+    func testLeastRecentlyStoredFormatsAreRemoved() {
+        let cache = FastStartCache(capacity: 2)
+        let first = URL(fileURLWithPath: "/tmp/first.mp3")
+        let second = URL(fileURLWithPath: "/tmp/second.mp3")
+        let third = URL(fileURLWithPath: "/tmp/third.mp3")
+
+        cache.store(format(sampleRate: 22050), for: first)
+        cache.store(format(sampleRate: 44100), for: second)
+        cache.store(format(sampleRate: 48000), for: third)
+
+        XCTAssertNil(cache.format(for: first))
+        XCTAssertEqual(cache.format(for: second)?.streamFormat.mSampleRate, 44100)
+        XCTAssertEqual(cache.format(for: third)?.streamFormat.mSampleRate, 48000)
+    }
+
+    func testCodecClassLookupHappensOncePerFormat() {
+        let cache = FastStartCache()
+        var lookups = 0
+        let lookup = { () -> AudioClassDescription? in
+            lookups += 1
+            return nil
+        }
+
+        XCTAssertNil(cache.codecClass(for: kAudioFormatMPEG4AAC, lookup: lookup))
+        XCTAssertNil(cache.codecClass(for: kAudioFormatMPEG4AAC, lookup: lookup))
+        XCTAssertEqual(lookups, 1)
+
+        _ = cache.codecClass(for: kAudioFormatMPEGLayer3, lookup: lookup)
+        XCTAssertEqual(lookups, 2)
+    }
+
+    func testStartupTimelineReportsPhasesOnce() {
+        let timeline = StartupTimeline()
+        timeline.mark(.requested, at: 10)
+        timeline.mark(.firstByte, at: 10.2)
+        timeline.mark(.formatDiscovered, at: 10.25)
+        timeline.recordConverterSetup(duration: 0.01, usedCachedFormat: true)
+        timeline.mark(.firstFramesDecoded, at: 10.3)
+        XCTAssertNil(timeline.takeTimings())
+
+        timeline.mark(.firstAudio, at: 10.35)
+        // later marks of the same phase are ignored
+        timeline.mark(.firstByte, at: 20)
+
+        let timings = timeline.takeTimings()
+        XCTAssertEqual(timings?.connection ?? 0, 0.2, accuracy: 0.0001)
+        XCTAssertEqual(timings?.formatDiscovery ?? 0, 0.05, accuracy: 0.0001)
+        XCTAssertEqual(timings?.converterSetup ?? 0, 0.01, accuracy: 0.0001)
+        XCTAssertEqual(timings?.firstDecode ?? 0, 0.05, accuracy: 0.0001)
+        XCTAssertEqual(timings?.firstRender ?? 0, 0.05, accuracy: 0.0001)
+        XCTAssertEqual(timings?.timeToFirstAudio ?? 0, 0.35, accuracy: 0.0001)
+        XCTAssertEqual(timings?.usedCachedFormat, true)
+
+        XCTAssertNil(timeline.takeTimings())
+    }
+}
@@ -0,0 +1,232 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import AudioToolbox
+import XCTest
+
+@testable import AudioStreaming
+
+class HLSAudioSourceTests: XCTestCase {
+    private let queue = DispatchQueue(label: "hls.audio.source.tests")
+    private var networkingClient: NetworkingClient!
+
+    override func setUp() {
+        super.setUp()
+        let configuration = URLSessionConfiguration.ephemeral
+        configuration.protocolClasses = [StaticFileURLProtocol.self]
+        networkingClient = NetworkingClient(configuration: configuration)
+        StaticFileURLProtocol.reset()
+    }
+
+    override func tearDown() {
+        StaticFileURLProtocol.reset()
+        super.tearDown()
+    }
+
+    func test_Plays_Transport_Stream_Segments() throws {
+        let (source, spy) = play("ts.m3u8")
+
+        XCTAssertNil(spy.error)
+        XCTAssertEqual(spy.data, try fixture("sine-32k-44100-stereo.aac"))
+        queue.sync {
+            XCTAssertEqual(source.audioFileHint, kAudioFileAAC_ADTSType)
+            XCTAssertEqual(source.position, 12928)
+            XCTAssertEqual(Double(source.length), 12928, accuracy: 1)
+        }
+    }
+
+    func test_Plays_Fragmented_MP4_Segments() throws {
+        let (_, spy) = play("fmp4.m3u8")
+
+        XCTAssertNil(spy.error)
+        XCTAssertEqual(spy.data, try fixture("sine-32k-44100-stereo.aac"))
+    }
+
+    func test_Requests_Byte_Ranges_Of_Segments() throws {
+        let (_, spy) = play("ts-byterange.m3u8")
+
+        XCTAssertNil(spy.error)
+        XCTAssertEqual(spy.data, try fixture("sine-32k-44100-stereo.aac"))
+        XCTAssertEqual(StaticFileURLProtocol.requestedRanges("ts-single-file.ts"),
+                       ["bytes=0-5263", "bytes=5264-10527", "bytes=10528-15979", "bytes=15980-16731"])
+    }
+
+    func test_Plays_First_Variant_Of_Master_Playlist() throws {
+        StaticFileURLProtocol.serve("master.m3u8", bodies: ["""
+        #EXTM3U
+        #EXT-X-STREAM-INF:BANDWIDTH=32000,CODECS="mp4a.40.2"
+        ts.m3u8
+        #EXT-X-STREAM-INF:BANDWIDTH=32000,CODECS="mp4a.40.2"
+        fmp4.m3u8
+        """])
+
+        let (_, spy) = play("master.m3u8")
+
+        XCTAssertNil(spy.error)
+        XCTAssertEqual(spy.data, try fixture("sine-32k-44100-stereo.aac"))
+        XCTAssertEqual(StaticFileURLProtocol.requestCount("fmp4.m3u8"), 0)
+    }
+
+    func test_Switches_Variants_At_Segment_Boundaries() throws {
+        serveMasterPlaylist()
+
+        let (_, spy) = play("master.m3u8", variantPolicy: AlternatingVariantPolicy())
+
+        // the variants carry the same audio, switching yields the same stream
+        XCTAssertNil(spy.error)
+        XCTAssertEqual(spy.data, try fixture("sine-32k-44100-stereo.aac"))
+        // playback starts with fmp4 and alternates on every segment, each playlist being loaded once
+        XCTAssertEqual(StaticFileURLProtocol.requestCount("ts.m3u8"), 1)
+        XCTAssertEqual(StaticFileURLProtocol.requestCount("fmp4.m3u8"), 1)
+        XCTAssertEqual(StaticFileURLProtocol.requestCount("fmp4-0.m4s"), 1)
+        XCTAssertEqual(StaticFileURLProtocol.requestCount("ts-0.ts"), 0)
+        XCTAssertEqual(StaticFileURLProtocol.requestCount("ts-1.ts"), 1)
+        XCTAssertEqual(StaticFileURLProtocol.requestCount("fmp4-1.m4s"), 0)
+    }
+
+    func test_Plays_Highest_Variant_When_Selected() throws {
+        serveMasterPlaylist()
+
+        let (_, spy) = play("master.m3u8", variantPolicy: HLSVariantSelection.highestBandwidth.makePolicy())
+
+        XCTAssertNil(spy.error)
+        XCTAssertEqual(spy.data, try fixture("sine-32k-44100-stereo.aac"))
+        XCTAssertEqual(StaticFileURLProtocol.requestCount("ts.m3u8"), 0)
+        XCTAssertEqual(StaticFileURLProtocol.requestCount("fmp4-3.m4s"), 1)
+    }
+
+    func test_Reloads_Live_Playlist_Until_It_Ends() throws {
+        let header = "#EXTM3U\n#EXT-X-TARGETDURATION:1\n#EXT-X-MEDIA-SEQUENCE:0\n"
+        let segments = [
+            "#EXTINF:1.021678,\nts-0.ts\n",
+            "#EXTINF:0.998456,\nts-1.ts\n",
+            "#EXTINF:0.998467,\nts-2.ts\n",
+            "#EXTINF:0.023222,\nts-3.ts\n",
+        ]
+        StaticFileURLProtocol.serve("live.m3u8", bodies: [
+            header + segments[0 ..< 2].joined(),
+            header + segments[0 ..< 3].joined(),
+            header + segments.joined() + "#EXT-X-ENDLIST\n",
+        ])
+
+        let (source, spy) = play("live.m3u8", timeout: 10)
+
+        XCTAssertNil(spy.error)
+        XCTAssertEqual(spy.data, try fixture("sine-32k-44100-stereo.aac"))
+        XCTAssertEqual(StaticFileURLProtocol.requestCount("live.m3u8"), 3)
+        queue.sync {
+            XCTAssertEqual(source.audioFileHint, kAudioFileAAC_ADTSType)
+        }
+    }
+
+    func test_Seeks_Within_Delivered_Segments() throws {
+        let (source, spy) = play("ts.m3u8")
+        let expected = try fixture("sine-32k-44100-stereo.aac")
+        XCTAssertEqual(spy.data, expected)
+
+        let ended = expectation(description: "end of file")
+        queue.sync {
+            spy.data = Data()
+            spy.ended = ended
+            source.seek(at: 6000)
+        }
+        wait(for: [ended], timeout: 5)
+
+        XCTAssertNil(spy.error)
+        XCTAssertEqual(spy.data, expected.dropFirst(6000))
+    }
+
+    func test_Reports_Missing_Segments() {
+        StaticFileURLProtocol.serve("missing.m3u8", bodies: ["""
+        #EXTM3U
+        #EXT-X-TARGETDURATION:1
+        #EXTINF:1,
+        does-not-exist.ts
+        #EXT-X-ENDLIST
+        """])
+
+        let (_, spy) = play("missing.m3u8")
+
+        XCTAssertNotNil(spy.error)
+        XCTAssertEqual(StaticFileURLProtocol.requestCount("does-not-exist.ts"), 3)
+    }
+
+    func test_Transport_Stream_Demuxer_Is_Incremental() throws {
+        let segment = try fixture("ts-0.ts")
+        let whole = MPEGTSDemuxer()
+        whole.startSegment()
+        let expected = whole.demux(segment)
+
+        let chunked = MPEGTSDemuxer()
+        chunked.startSegment()
+        var output = Data()
+        for offset in stride(from: 0, to: segment.count, by: 7) {
+            output.append(chunked.demux(segment.subdata(in: offset ..< min(offset + 7, segment.count))))
+        }
+
+        XCTAssertEqual(chunked.fileType, kAudioFileAAC_ADTSType)
+        XCTAssertEqual(output, expected)
+        XCTAssertEqual(output.prefix(2), Data([0xFF, 0xF1]))
+    }
+
+    func test_Packed_Audio_Demuxer_Drops_ID3_Tag() {
+        let demuxer = PackedAudioDemuxer(fileType: kAudioFileAAC_ADTSType)
+        let tag: [UInt8] = [0x49, 0x44, 0x33, 4, 0, 0, 0, 0, 0, 3, 1, 2, 3]
+        let audio: [UInt8] = [0xFF, 0xF1, 0x50, 0x80]
+
+        demuxer.startSegment()
+        var output = demuxer.demux(Data(tag.prefix(4)))
+        output.append(demuxer.demux(Data(tag.dropFirst(4) + audio)))
+
+        XCTAssertEqual(output, Data(audio))
+    }
+
+    // MARK: Helpers
+
+    private func play(_ name: String,
+                      timeout: TimeInterval = 5,
+                      variantPolicy: HLSVariantSelectionPolicy = HLSVariantSelection.adaptive.makePolicy())
+        -> (HLSAudioSource, SourceDelegateSpy)
+    {
+        let url = URL(string: "https://\(StaticFileURLProtocol.host)/\(name)")!
+        let source = HLSAudioSource(networking: networkingClient,
+                                    url: url,
+                                    underlyingQueue: queue,
+                                    httpHeaders: [:],
+                                    variantPolicy: variantPolicy)
+        let spy = SourceDelegateSpy(ended: expectation(description: "end of file"))
+        queue.sync {
+            source.delegate = spy
+            source.seek(at: 0)
+        }
+        wait(for: [spy.ended], timeout: timeout)
+        return (source, spy)
+    }
+
+    /// Serves a master playlist of a transport stream variant followed by a higher fragmented MP4 variant
+    private func serveMasterPlaylist() {
+        StaticFileURLProtocol.serve("master.m3u8", bodies: ["""
+        #EXTM3U
+        #EXT-X-STREAM-INF:BANDWIDTH=32000,CODECS="mp4a.40.2"
+        ts.m3u8
+        #EXT-X-STREAM-INF:BANDWIDTH=64000,CODECS="mp4a.40.2"
+        fmp4.m3u8
+        """])
+    }
+
+    private func fixture(_ name: String) throws -> Data {
+        let bundle = Bundle(for: HLSAudioSourceTests.self)
+        let url = bundle.url(forResource: (name as NSString).deletingPathExtension,
+                             withExtension: (name as NSString).pathExtension)!
+        return try Data(contentsOf: url)
+    }
+}
+
+/// Switches to the other variant on every selection
+private struct AlternatingVariantPolicy: HLSVariantSelectionPolicy {
+    func variantIndex(for context: HLSVariantSelectionContext) -> Int {
+        1 - context.currentIndex
+    }
+}
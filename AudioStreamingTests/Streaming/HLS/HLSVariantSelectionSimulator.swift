@@ -0,0 +1,146 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import Foundation
+
+@testable import AudioStreaming
+
+/// Replays a `BandwidthTrace` against a `HLSVariantSelectionPolicy` and measures the stalls and the selected bitrates.
+///
+/// The model follows `HLSAudioSource` with a single segment downloaded at a time, a variant is selected before each
+/// segment, bytes arrive in chunks as they would from the network and are measured by a `HLSThroughputMeter`.
+/// Playback starts once a second is buffered, downloads pause while the buffer is full. The trace loops when it is
+/// shorter than the simulated stream.
+struct HLSVariantSelectionSimulator {
+    struct Result {
+        let stalls: Int
+        let stallDuration: Double
+        /// The average bitrate of the downloaded segments in kbps
+        let averageBitrate: Double
+        let switches: Int
+    }
+
+    /// The bitrates of the variants in kbps
+    var ladder: [Double] = [48, 96, 160, 320]
+    var segmentDuration: Double = 4
+    var duration: Double = 300
+    var bufferSizeInSeconds: Double = 20
+    var secondsRequiredToStartPlaying: Double = 1
+    var timeStep: Double = 0.01
+    var chunkSize: Double = 4096
+    var connectionLatency: Double = 0.1
+    var timeLimit: Double = 2000
+
+    private var variants: [HLSVariant] {
+        ladder.enumerated().map { index, kbps in
+            HLSVariant(url: URL(string: "https://example.com/\(index).m3u8")!,
+                       bandwidth: Int(kbps * 1000),
+                       averageBandwidth: nil,
+                       codecs: [])
+        }
+    }
+
+    func simulate(trace: BandwidthTrace, policy: HLSVariantSelectionPolicy) -> Result {
+        let variants = self.variants
+        let segmentCount = Int(duration / segmentDuration)
+        var time: Double = 0
+        let meter = HLSThroughputMeter(clock: { time })
+
+        var played: Double = 0
+        var buffered: Double = 0
+        var segmentIndex = 0
+        var variantIndex = 0
+        // the bytes left of the segment being downloaded
+        var remainingBytes: Double?
+        var latencyLeft: Double = 0
+        var pendingBytes: Double = 0
+
+        var periodIndex = 0
+        var periodLeft = trace.periods[0].duration
+
+        var playing = false
+        var hasStarted = false
+        var stalls = 0
+        var stallDuration: Double = 0
+        var bitrates: Double = 0
+        var switches = 0
+
+        while played < duration, time < timeLimit {
+            let kbps = trace.periods[periodIndex].kbps
+            periodLeft -= timeStep
+            if periodLeft <= 0 {
+                periodIndex = (periodIndex + 1) % trace.periods.count
+                periodLeft = trace.periods[periodIndex].duration
+            }
+
+            if remainingBytes == nil, segmentIndex < segmentCount, buffered < bufferSizeInSeconds {
+                let context = HLSVariantSelectionContext(variants: variants,
+                                                         currentIndex: variantIndex,
+                                                         throughput: meter.estimate,
+                                                         bufferedSeconds: buffered)
+                let selected = policy.variantIndex(for: context)
+                if selected != variantIndex {
+                    switches += 1
+                }
+                variantIndex = selected
+                remainingBytes = ladder[variantIndex] * 1000 / 8 * segmentDuration
+                bitrates += ladder[variantIndex]
+                segmentIndex += 1
+                latencyLeft = connectionLatency
+                meter.downloadStarted()
+            }
+
+            if let remaining = remainingBytes {
+                if latencyLeft > 0 {
+                    latencyLeft -= timeStep
+                } else {
+                    let received = min(kbps * 1000 / 8 * timeStep, remaining)
+                    pendingBytes += received
+                    while pendingBytes >= chunkSize {
+                        pendingBytes -= chunkSize
+                        meter.record(byteCount: Int(chunkSize))
+                    }
+                    if remaining - received <= 0 {
+                        if pendingBytes > 0 {
+                            meter.record(byteCount: Int(pendingBytes))
+                        }
+                        meter.downloadEnded()
+                        pendingBytes = 0
+                        remainingBytes = nil
+                        buffered += segmentDuration
+                    } else {
+                        remainingBytes = remaining - received
+                    }
+                }
+            }
+
+            let isComplete = segmentIndex >= segmentCount && remainingBytes == nil
+            if !playing {
+                if buffered >= secondsRequiredToStartPlaying || (isComplete && buffered > 0) {
+                    playing = true
+                    hasStarted = true
+                }
+            } else {
+                played += timeStep
+                buffered -= timeStep
+                if buffered <= 0, !isComplete {
+                    buffered = 0
+                    playing = false
+                    stalls += 1
+                }
+            }
+
+            if !playing, hasStarted, played < duration {
+                stallDuration += timeStep
+            }
+            time += timeStep
+        }
+
+        return Result(stalls: stalls,
+                      stallDuration: stallDuration,
+                      averageBitrate: bitrates / Double(max(segmentIndex, 1)),
+                      switches: switches)
+    }
+}
@@ -0,0 +1,168 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import XCTest
+
+@testable import AudioStreaming
+
+class HLSVariantSelectionTests: XCTestCase {
+    private let bundle = Bundle(for: HLSVariantSelectionTests.self)
+    private let traceNames = ["broadband", "dsl", "congested-cellular", "fluctuating-cellular"]
+    private let variants = [48000, 96000, 160_000, 320_000].map {
+        HLSVariant(url: URL(string: "https://example.com/\($0).m3u8")!,
+                   bandwidth: $0,
+                   averageBandwidth: nil,
+                   codecs: [])
+    }
+
+    // MARK: Policy
+
+    func test_Adaptive_Policy_Keeps_Variant_Without_Throughput() {
+        let policy = ThroughputBufferSelectionPolicy()
+
+        XCTAssertEqual(policy.variantIndex(for: context(current: 2, throughput: nil, buffered: 0)), 2)
+    }
+
+    func test_Adaptive_Policy_Switches_Up_One_Variant_With_Enough_Buffer() {
+        let policy = ThroughputBufferSelectionPolicy()
+
+        XCTAssertEqual(policy.variantIndex(for: context(current: 0, throughput: 1_000_000, buffered: 10)), 1)
+        XCTAssertEqual(policy.variantIndex(for: context(current: 0, throughput: 1_000_000, buffered: 6)), 0)
+        XCTAssertEqual(policy.variantIndex(for: context(current: 3, throughput: 1_000_000, buffered: 10)), 3)
+    }
+
+    func test_Adaptive_Policy_Switches_Down_When_Throughput_Drops() {
+        let policy = ThroughputBufferSelectionPolicy()
+
+        // 320 kbps exceeds the throughput, 96 kbps is the highest within 80% of it
+        XCTAssertEqual(policy.variantIndex(for: context(current: 3, throughput: 150_000, buffered: 10)), 1)
+        // 160 kbps fits in the throughput but not in 80% of it, the variant is kept
+        XCTAssertEqual(policy.variantIndex(for: context(current: 2, throughput: 170_000, buffered: 10)), 2)
+    }
+
+    func test_Adaptive_Policy_Never_Switches_Up_On_Low_Buffer() {
+        let policy = ThroughputBufferSelectionPolicy()
+
+        XCTAssertEqual(policy.variantIndex(for: context(current: 1, throughput: 1_000_000, buffered: 2)), 1)
+        XCTAssertEqual(policy.variantIndex(for: context(current: 3, throughput: 130_000, buffered: 2)), 1)
+    }
+
+    func test_Policy_Selects_On_Average_Bandwidth_When_Known() {
+        let policy = ThroughputBufferSelectionPolicy()
+        let variants = [
+            HLSVariant(url: URL(string: "https://example.com/low.m3u8")!,
+                       bandwidth: 64000, averageBandwidth: nil, codecs: []),
+            HLSVariant(url: URL(string: "https://example.com/high.m3u8")!,
+                       bandwidth: 256_000, averageBandwidth: 128_000, codecs: []),
+        ]
+        let context = HLSVariantSelectionContext(variants: variants,
+                                                 currentIndex: 0,
+                                                 throughput: 200_000,
+                                                 bufferedSeconds: 10)
+
+        XCTAssertEqual(policy.variantIndex(for: context), 1)
+    }
+
+    func test_Fixed_Policies_Select_Lowest_And_Highest_Variant() {
+        let context = self.context(current: 1, throughput: nil, buffered: 0)
+
+        XCTAssertEqual(HLSVariantSelection.lowestBandwidth.makePolicy().variantIndex(for: context), 0)
+        XCTAssertEqual(HLSVariantSelection.highestBandwidth.makePolicy().variantIndex(for: context), 3)
+    }
+
+    // MARK: Throughput meter
+
+    func test_Throughput_Meter_Measures_Bits_Per_Second() {
+        var time: TimeInterval = 0
+        let meter = HLSThroughputMeter(clock: { time })
+
+        meter.downloadStarted()
+        for _ in 0 ..< 4 {
+            time += 0.5
+            meter.record(byteCount: 10000)
+        }
+
+        XCTAssertEqual(try XCTUnwrap(meter.estimate), 160_000, accuracy: 1)
+    }
+
+    func test_Throughput_Meter_Ignores_Time_Without_Downloads() {
+        var time: TimeInterval = 0
+        let meter = HLSThroughputMeter(clock: { time })
+
+        meter.downloadStarted()
+        time += 1
+        meter.record(byteCount: 10000)
+        meter.downloadEnded()
+        // the buffer is full for a while
+        time += 30
+        meter.downloadStarted()
+        time += 1
+        meter.record(byteCount: 10000)
+
+        XCTAssertEqual(try XCTUnwrap(meter.estimate), 80000, accuracy: 1)
+    }
+
+    func test_Throughput_Meter_Adds_Up_Overlapping_Downloads() {
+        var time: TimeInterval = 0
+        let meter = HLSThroughputMeter(clock: { time })
+
+        meter.downloadStarted()
+        meter.downloadStarted()
+        for _ in 0 ..< 4 {
+            time += 0.25
+            meter.record(byteCount: 5000)
+            time += 0.25
+            meter.record(byteCount: 5000)
+        }
+
+        XCTAssertEqual(try XCTUnwrap(meter.estimate), 160_000, accuracy: 1)
+    }
+
+    // MARK: Simulation
+
+    func test_Adaptive_Policy_Does_Not_Stall_On_Any_Trace() throws {
+        let simulator = HLSVariantSelectionSimulator()
+        for name in traceNames {
+            let trace = try XCTUnwrap(BandwidthTrace(name: name, bundle: bundle))
+            let result = simulator.simulate(trace: trace, policy: ThroughputBufferSelectionPolicy())
+
+            XCTAssertEqual(result.stalls, 0, name)
+            // switching back and forth on every segment would be audible as changes of quality
+            XCTAssertLessThanOrEqual(result.switches, 6, name)
+        }
+    }
+
+    func test_Adaptive_Policy_Avoids_Rebuffering_On_Congested_Network() throws {
+        let simulator = HLSVariantSelectionSimulator()
+        let trace = try XCTUnwrap(BandwidthTrace(name: "congested-cellular", bundle: bundle))
+
+        let highest = simulator.simulate(trace: trace, policy: HLSVariantSelection.highestBandwidth.makePolicy())
+        let adaptive = simulator.simulate(trace: trace, policy: ThroughputBufferSelectionPolicy())
+
+        XCTAssertGreaterThan(highest.stalls, 0)
+        XCTAssertEqual(adaptive.stalls, 0)
+        // better than settling for the lowest variant
+        XCTAssertGreaterThan(adaptive.averageBitrate, 48)
+    }
+
+    func test_Adaptive_Policy_Plays_Highest_Variant_On_Fast_Networks() throws {
+        let simulator = HLSVariantSelectionSimulator()
+        for name in ["broadband", "dsl"] {
+            let trace = try XCTUnwrap(BandwidthTrace(name: name, bundle: bundle))
+            let result = simulator.simulate(trace: trace, policy: ThroughputBufferSelectionPolicy())
+
+            XCTAssertGreaterThanOrEqual(result.averageBitrate, 0.9 * 320, name)
+        }
+    }
+
+    // MARK: Helpers
+
+    private func context(current: Int, throughput: Double?, buffered: TimeInterval) -> HLSVariantSelectionContext {
+        HLSVariantSelectionContext(variants: variants,
+                                   currentIndex: current,
+                                   throughput: throughput,
+                                   bufferedSeconds: buffered)
+    }
+}
@@ -0,0 +1,211 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import AudioToolbox
+import XCTest
+
+@testable import AudioStreaming
+
+class ID3TagReaderTests: XCTestCase {
+    private let queue = DispatchQueue(label: "id3.tag.reader.tests")
+    private let audio = Data([0xFF, 0xFB, 0x90, 0x00]) + Data(repeating: 0x55, count: 412)
+
+    override func setUp() {
+        super.setUp()
+        StaticFileURLProtocol.reset()
+    }
+
+    override func tearDown() {
+        StaticFileURLProtocol.reset()
+        super.tearDown()
+    }
+
+    // MARK: Reader
+
+    func test_Drops_Tag_And_Reads_Text_Frames() {
+        let tag = self.tag(version: 3, frames: [
+            frame("TIT2", text: "Episode 12", encoding: 0),
+            frame("TPE1", body: Data([1]) + "Podcast Host".data(using: .utf16)!),
+            frame("COMM", body: Data(repeating: 0x20, count: 40)),
+            frame("TALB", text: "Season 2", encoding: 3),
+        ], padding: 64)
+        let reader = ID3TagReader()
+
+        var output = Data()
+        for byte in tag + audio {
+            output.append(reader.process(Data([byte])))
+        }
+
+        XCTAssertEqual(output, audio)
+        XCTAssertTrue(reader.isComplete)
+        XCTAssertEqual(reader.tagSize, tag.count)
+        XCTAssertEqual(reader.takeFrames(), ["TIT2": "Episode 12", "TPE1": "Podcast Host", "TALB": "Season 2"])
+        XCTAssertNil(reader.takeFrames())
+    }
+
+    func test_Reads_Syncsafe_Frame_Sizes_Of_Version_4() {
+        let title = String(repeating: "a", count: 200)
+        let tag = self.tag(version: 4, frames: [frame("TIT2", text: title, encoding: 3, version: 4)])
+        let reader = ID3TagReader()
+
+        XCTAssertEqual(reader.process(tag + audio), audio)
+        XCTAssertEqual(reader.takeFrames(), ["TIT2": title])
+    }
+
+    func test_Passes_Through_Streams_Without_Tag() {
+        let reader = ID3TagReader()
+
+        XCTAssertTrue(reader.process(audio.prefix(4)).isEmpty)
+        XCTAssertEqual(reader.process(audio.suffix(from: 4)), audio)
+        XCTAssertTrue(reader.isComplete)
+        XCTAssertEqual(reader.tagSize, 0)
+        XCTAssertNil(reader.takeFrames())
+    }
+
+    func test_Suggests_Skipping_Large_Artwork_With_Request() {
+        let tag = self.tag(version: 3, frames: [
+            frame("TIT2", text: "Episode 12", encoding: 0),
+            frame("APIC", body: Data(repeating: 0xAB, count: 200_000)),
+        ])
+        let reader = ID3TagReader()
+
+        XCTAssertTrue(reader.process(tag.prefix(1000)).isEmpty)
+        XCTAssertTrue(reader.shouldSkipWithRequest)
+        // frames may follow the artwork until it's skipped
+        XCTAssertNil(reader.takeFrames())
+
+        XCTAssertEqual(reader.skipTag(), tag.count)
+        XCTAssertEqual(reader.takeFrames(), ["TIT2": "Episode 12"])
+        XCTAssertEqual(reader.process(audio), audio)
+    }
+
+    func test_Streams_Past_Small_Artwork() {
+        let tag = self.tag(version: 3, frames: [
+            frame("APIC", body: Data(repeating: 0xAB, count: 20000)),
+            frame("TIT2", text: "Episode 12", encoding: 0),
+        ])
+        let reader = ID3TagReader()
+
+        var output = Data()
+        for offset in stride(from: 0, to: tag.count, by: 1000) {
+            output.append(reader.process(tag.subdata(in: offset ..< min(offset + 1000, tag.count))))
+            XCTAssertFalse(reader.shouldSkipWithRequest)
+        }
+        output.append(reader.process(audio))
+
+        XCTAssertEqual(output, audio)
+        XCTAssertEqual(reader.takeFrames(), ["TIT2": "Episode 12"])
+    }
+
+    func test_Tag_Size_Includes_Footer() {
+        var header = Data("ID3".utf8) + Data([4, 0, 0x10]) + syncsafe(1000)
+        XCTAssertEqual(ID3TagReader.tagSize(header: header), 1020)
+        header[5] = 0
+        XCTAssertEqual(ID3TagReader.tagSize(header: header), 1010)
+        XCTAssertEqual(ID3TagReader.tagSize(header: audio), 0)
+    }
+
+    // MARK: Remote source
+
+    func test_Remote_Source_Requests_Audio_Past_Artwork() throws {
+        let tag = self.tag(version: 3, frames: [
+            frame("TIT2", text: "Episode 12", encoding: 0),
+            frame("APIC", body: Data(repeating: 0xAB, count: 200_000)),
+        ])
+        let file = tag + (try fixture("sine-1khz-44100-stereo.mp3"))
+        StaticFileURLProtocol.serve("episode.mp3", data: [file])
+
+        let (source, spy) = play("episode.mp3")
+
+        XCTAssertNil(spy.error)
+        XCTAssertEqual(spy.data, file.suffix(from: tag.count))
+        XCTAssertEqual(spy.metadata, [["TIT2": "Episode 12"]])
+        XCTAssertEqual(StaticFileURLProtocol.requestedRanges("episode.mp3"), ["bytes=\(tag.count)-"])
+        queue.sync {
+            XCTAssertEqual(source.length, file.count - tag.count)
+            XCTAssertEqual(source.position, file.count - tag.count)
+        }
+
+        // offsets are those of the audio following the tag
+        spy.data = Data()
+        spy.ended = expectation(description: "ended after seek")
+        queue.sync {
+            source.seek(at: 1000)
+        }
+        wait(for: [spy.ended], timeout: 5)
+        XCTAssertEqual(spy.data, file.suffix(from: tag.count + 1000))
+        XCTAssertEqual(StaticFileURLProtocol.requestedRanges("episode.mp3").last, "bytes=\(tag.count + 1000)-")
+    }
+
+    func test_Remote_Source_Streams_Past_Small_Tag() throws {
+        let tag = self.tag(version: 4, frames: [frame("TIT2", text: "Episode 12", encoding: 3, version: 4)])
+        let file = tag + (try fixture("sine-1khz-44100-stereo.mp3"))
+        StaticFileURLProtocol.serve("episode.mp3", data: [file])
+
+        let (_, spy) = play("episode.mp3")
+
+        XCTAssertEqual(spy.data, file.suffix(from: tag.count))
+        XCTAssertEqual(spy.metadata, [["TIT2": "Episode 12"]])
+        XCTAssertEqual(StaticFileURLProtocol.requestCount("episode.mp3"), 1)
+    }
+
+    func test_Remote_Source_Without_Length_Has_No_Length_Past_Its_Tag() throws {
+        let tag = self.tag(version: 3, frames: [frame("TIT2", text: "Live", encoding: 0)])
+        let file = tag + (try fixture("sine-1khz-44100-stereo.mp3"))
+        // served without a Content-Length
+        StaticFileURLProtocol.serve("episode.mp3", data: [file], live: true)
+
+        let (source, spy) = play("episode.mp3")
+
+        XCTAssertEqual(spy.data, file.suffix(from: tag.count))
+        XCTAssertEqual(spy.metadata, [["TIT2": "Live"]])
+        queue.sync {
+            XCTAssertEqual(source.length, 0)
+        }
+    }
+
+    // MARK: Helpers
+
+    private func play(_ name: String) -> (RemoteAudioSource, SourceDelegateSpy) {
+        let configuration = URLSessionConfiguration.ephemeral
+        configuration.protocolClasses = [StaticFileURLProtocol.self]
+        let source = RemoteAudioSource(networking: NetworkingClient(configuration: configuration),
+                                       url: URL(string: "https://\(StaticFileURLProtocol.host)/\(name)")!,
+                                       underlyingQueue: queue)
+        let spy = SourceDelegateSpy(ended: expectation(description: "ended"))
+        queue.sync {
+            source.delegate = spy
+            source.seek(at: 0)
+        }
+        wait(for: [spy.ended], timeout: 5)
+        return (source, spy)
+    }
+
+    private func tag(version: UInt8, frames: [Data], padding: Int = 0) -> Data {
+        let body = frames.reduce(Data(), +) + Data(count: padding)
+        return Data("ID3".utf8) + Data([version, 0, 0]) + syncsafe(body.count) + body
+    }
+
+    private func frame(_ identifier: String, text: String, encoding: UInt8, version: UInt8 = 3) -> Data {
+        let encoded = encoding == 0 ? text.data(using: .isoLatin1)! : Data(text.utf8)
+        return frame(identifier, body: Data([encoding]) + encoded + Data([0]), version: version)
+    }
+
+    private func frame(_ identifier: String, body: Data, version: UInt8 = 3) -> Data {
+        let size = version == 4 ? syncsafe(body.count) : Data((0 ..< 4).reversed().map { UInt8(body.count >> ($0 * 8) & 0xFF) })
+        return Data(identifier.utf8) + size + Data([0, 0]) + body
+    }
+
+    private func syncsafe(_ value: Int) -> Data {
+        Data((0 ..< 4).reversed().map { UInt8(value >> ($0 * 7) & 0x7F) })
+    }
+
+    private func fixture(_ name: String) throws -> Data {
+        let bundle = Bundle(for: ID3TagReaderTests.self)
+        let url = bundle.url(forResource: (name as NSString).deletingPathExtension,
+                             withExtension: (name as NSString).pathExtension)!
+        return try Data(contentsOf: url)
+    }
+}
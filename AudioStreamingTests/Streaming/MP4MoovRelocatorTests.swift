@@ -0,0 +1,289 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import AudioToolbox
+import XCTest
+
+@testable import AudioStreaming
+
+class MP4MoovRelocatorTests: XCTestCase {
+    private let queue = DispatchQueue(label: "mp4.moov.relocator.tests")
+    private let outputFormat = AudioStreamBasicDescription(mSampleRate: 44100,
+                                                           mFormatID: kAudioFormatLinearPCM,
+                                                           mFormatFlags: kAudioFormatFlagsNativeFloatPacked,
+                                                           mBytesPerPacket: 8,
+                                                           mFramesPerPacket: 1,
+                                                           mBytesPerFrame: 8,
+                                                           mChannelsPerFrame: 2,
+                                                           mBitsPerChannel: 32,
+                                                           mReserved: 0)
+
+    // the fixture is laid out as ftyp, free, mdat at 36 and moov at 12006
+    private let mdatOffset = 36
+    private let moovOffset = 12006
+    private let moovSize = 1286
+
+    override func setUp() {
+        super.setUp()
+        StaticFileURLProtocol.reset()
+    }
+
+    override func tearDown() {
+        StaticFileURLProtocol.reset()
+        super.tearDown()
+    }
+
+    // MARK: Relocator
+
+    func test_Relocates_Moov_In_Front_Of_Mdat() throws {
+        let file = try fixture("moov-at-end.m4a")
+        let relocator = MP4MoovRelocator()
+
+        var output = relocator.process(file.prefix(4000))
+        XCTAssertEqual(relocator.state, .awaitingMoov)
+        XCTAssertEqual(relocator.tailOffset, moovOffset)
+        XCTAssertTrue(output.isEmpty)
+
+        output.append(relocator.appendTail(file.suffix(from: moovOffset), at: moovOffset))
+        XCTAssertEqual(relocator.state, .relocated)
+        output.append(relocator.process(file.subdata(in: 4000 ..< file.count)))
+
+        XCTAssertEqual(boxTypes(in: output), ["ftyp", "free", "moov", "mdat"])
+        XCTAssertEqual(output.count, file.count)
+        XCTAssertEqual(relocator.relocatedLength, file.count)
+        XCTAssertEqual(output.subdata(in: mdatOffset + moovSize ..< output.count),
+                       file.subdata(in: mdatOffset ..< moovOffset))
+    }
+
+    func test_Relocated_Chunk_Offsets_Point_To_The_Same_Samples() throws {
+        let file = try fixture("moov-at-end.m4a")
+        let output = relocate(file, chunkSize: 7)
+
+        let original = chunkOffsets(in: file)
+        let relocated = chunkOffsets(in: output)
+        XCTAssertEqual(relocated.count, original.count)
+        XCTAssertFalse(original.isEmpty)
+        for (originalOffset, relocatedOffset) in zip(original, relocated) {
+            XCTAssertEqual(relocatedOffset, originalOffset + moovSize)
+            XCTAssertEqual(output.subdata(in: relocatedOffset ..< relocatedOffset + 16),
+                           file.subdata(in: originalOffset ..< originalOffset + 16))
+        }
+    }
+
+    func test_Relocates_Moov_Read_By_The_Stream() throws {
+        let file = try fixture("moov-at-end.m4a")
+        let relocator = MP4MoovRelocator()
+
+        // the tail isn't requested, the stream gets to moov by itself
+        var output = Data()
+        for offset in stride(from: 0, to: file.count, by: 1000) {
+            output.append(relocator.process(file.subdata(in: offset ..< min(offset + 1000, file.count))))
+        }
+
+        XCTAssertEqual(relocator.state, .relocated)
+        XCTAssertEqual(output, relocate(file, chunkSize: file.count))
+    }
+
+    func test_Seeks_Within_Relocated_Stream() throws {
+        let file = try fixture("moov-at-end.m4a")
+        let relocated = relocate(file, chunkSize: 1000)
+        let relocator = MP4MoovRelocator()
+        _ = relocator.process(file)
+
+        // within the relocated moov, the header is delivered before mdat
+        XCTAssertEqual(relocator.seek(to: 100), mdatOffset)
+        XCTAssertEqual(relocator.process(file.suffix(from: mdatOffset)), relocated.suffix(from: 100))
+        // within mdat
+        XCTAssertEqual(relocator.seek(to: 5000), 5000 - moovSize)
+        XCTAssertEqual(relocator.process(file.suffix(from: 5000 - moovSize)), relocated.suffix(from: 5000))
+    }
+
+    func test_Passes_Through_Files_With_Moov_In_Front() throws {
+        let file = try fixture("moov-at-start.m4a")
+        let relocator = MP4MoovRelocator()
+
+        var output = Data()
+        for offset in stride(from: 0, to: file.count, by: 10) {
+            output.append(relocator.process(file.subdata(in: offset ..< min(offset + 10, file.count))))
+        }
+
+        XCTAssertEqual(relocator.state, .passthrough)
+        XCTAssertEqual(output, file)
+    }
+
+    func test_Passes_Through_Files_Not_Laid_Out_As_Boxes() throws {
+        let relocator = MP4MoovRelocator()
+        let data = Data(repeating: 0xFF, count: 64)
+
+        XCTAssertEqual(relocator.process(data), data)
+        XCTAssertEqual(relocator.state, .passthrough)
+    }
+
+    func test_Delivers_Held_Bytes_When_Moov_Is_Missing() throws {
+        let file = try fixture("moov-at-end.m4a")
+        let relocator = MP4MoovRelocator()
+        let truncated = file.prefix(moovOffset)
+
+        XCTAssertTrue(relocator.process(truncated).isEmpty)
+        XCTAssertEqual(relocator.finish(), truncated)
+        XCTAssertEqual(relocator.state, .passthrough)
+    }
+
+    func test_Passes_Through_Mdat_With_A_Size_Past_Int_Max() {
+        for size: UInt64 in [0x8000_0000_0000_0010, 0x7FFF_FFFF_FFFF_FFF0, 12] {
+            let relocator = MP4MoovRelocator()
+            var file = box("ftyp", Data("M4A \0\0\0\0".utf8))
+            file.append(largeBoxHeader("mdat", size: size))
+            file.append(Data(repeating: 0, count: 64))
+
+            XCTAssertEqual(relocator.process(file), file)
+            XCTAssertEqual(relocator.state, .passthrough)
+        }
+    }
+
+    func test_Chunk_Offsets_Past_Int_Max_Are_Not_Shifted() {
+        var entries = Data([0, 0, 0, 0, 0, 0, 0, 1])
+        entries.append(bigEndian(UInt64(Int.max)))
+        let moov = box("moov", box("trak", box("co64", entries)))
+        XCTAssertNil(MP4MoovRelocator.shiftingChunkOffsets(of: moov, by: 100))
+
+        var malformed = largeBoxHeader("trak", size: 0xFFFF_FFFF_FFFF_FFF0)
+        malformed.append(Data(repeating: 0, count: 16))
+        XCTAssertNil(MP4MoovRelocator.shiftingChunkOffsets(of: box("moov", malformed), by: 100))
+    }
+
+    func test_Relocated_Stream_Is_Parsed_By_AudioFileStream() throws {
+        let relocated = relocate(try fixture("moov-at-end.m4a"), chunkSize: 1000)
+        let spy = DecoderBackendDelegateSpy()
+        let backend = AudioToolboxDecoderBackend(outputFormat: outputFormat)
+        backend.delegate = spy
+        XCTAssertEqual(backend.open(fileHint: kAudioFileM4AType), noErr)
+
+        for offset in stride(from: 0, to: relocated.count, by: 1000) {
+            let chunk = relocated.subdata(in: offset ..< min(offset + 1000, relocated.count))
+            XCTAssertEqual(backend.parse(data: chunk, discontinuous: false), noErr)
+        }
+        backend.close()
+
+        XCTAssertEqual(spy.dataOffset, UInt64(mdatOffset + moovSize + 8))
+        XCTAssertEqual(spy.parsedPackets, 131)
+        XCTAssertTrue(spy.errors.isEmpty)
+    }
+
+    // MARK: Remote source
+
+    func test_Remote_Source_Requests_The_Tail_For_Moov() throws {
+        let file = try fixture("moov-at-end.m4a")
+        let (source, spy) = play("moov-at-end.m4a")
+
+        XCTAssertNil(spy.error)
+        XCTAssertEqual(spy.data, relocate(file, chunkSize: file.count))
+        XCTAssertEqual(StaticFileURLProtocol.requestedRanges("moov-at-end.m4a"), ["bytes=\(moovOffset)-"])
+        queue.sync {
+            XCTAssertEqual(source.position, file.count)
+            XCTAssertEqual(source.length, file.count)
+        }
+    }
+
+    func test_Remote_Source_Seeks_Within_Relocated_Stream() throws {
+        let file = try fixture("moov-at-end.m4a")
+        let relocated = relocate(file, chunkSize: file.count)
+        let (source, spy) = play("moov-at-end.m4a")
+
+        spy.data = Data()
+        spy.ended = expectation(description: "ended after seek")
+        queue.sync {
+            source.seek(at: 100)
+        }
+        wait(for: [spy.ended], timeout: 5)
+
+        XCTAssertEqual(spy.data, relocated.suffix(from: 100))
+        XCTAssertEqual(StaticFileURLProtocol.requestedRanges("moov-at-end.m4a").last, "bytes=\(mdatOffset)-")
+    }
+
+    func test_Remote_Source_Passes_Through_Files_With_Moov_In_Front() throws {
+        let (_, spy) = play("moov-at-start.m4a")
+
+        XCTAssertNil(spy.error)
+        XCTAssertEqual(spy.data, try fixture("moov-at-start.m4a"))
+        XCTAssertTrue(StaticFileURLProtocol.requestedRanges("moov-at-start.m4a").isEmpty)
+    }
+
+    // MARK: Helpers
+
+    private func play(_ name: String) -> (RemoteAudioSource, SourceDelegateSpy) {
+        let configuration = URLSessionConfiguration.ephemeral
+        configuration.protocolClasses = [StaticFileURLProtocol.self]
+        let source = RemoteAudioSource(networking: NetworkingClient(configuration: configuration),
+                                       url: URL(string: "https://\(StaticFileURLProtocol.host)/\(name)")!,
+                                       underlyingQueue: queue)
+        let spy = SourceDelegateSpy(ended: expectation(description: "ended"))
+        queue.sync {
+            source.delegate = spy
+            source.seek(at: 0)
+        }
+        wait(for: [spy.ended], timeout: 5)
+        return (source, spy)
+    }
+
+    private func relocate(_ file: Data, chunkSize: Int) -> Data {
+        let relocator = MP4MoovRelocator()
+        var output = Data()
+        for offset in stride(from: 0, to: file.count, by: chunkSize) {
+            output.append(relocator.process(file.subdata(in: offset ..< min(offset + chunkSize, file.count))))
+            if relocator.state == .awaitingMoov, let tailOffset = relocator.tailOffset {
+                output.append(relocator.appendTail(file.suffix(from: tailOffset), at: tailOffset))
+            }
+        }
+        return output
+    }
+
+    private func fixture(_ name: String) throws -> Data {
+        let bundle = Bundle(for: MP4MoovRelocatorTests.self)
+        let url = bundle.url(forResource: (name as NSString).deletingPathExtension,
+                             withExtension: (name as NSString).pathExtension)!
+        return try Data(contentsOf: url)
+    }
+
+    private func box(_ type: String, _ payload: Data) -> Data {
+        var data = bigEndian(UInt32(8 + payload.count))
+        data.append(Data(type.utf8))
+        data.append(payload)
+        return data
+    }
+
+    /// The header of a box with a 64 bit size
+    private func largeBoxHeader(_ type: String, size: UInt64) -> Data {
+        var data = bigEndian(UInt32(1))
+        data.append(Data(type.utf8))
+        data.append(bigEndian(size))
+        return data
+    }
+
+    private func bigEndian<Value: FixedWidthInteger>(_ value: Value) -> Data {
+        withUnsafeBytes(of: value.bigEndian) { Data($0) }
+    }
+
+    private func readUInt32(_ data: Data, at offset: Int) -> Int {
+        data.subdata(in: offset ..< offset + 4).reduce(0) { $0 << 8 | Int($1) }
+    }
+
+    private func boxTypes(in data: Data) -> [String] {
+        var types: [String] = []
+        var offset = 0
+        while offset + 8 <= data.count {
+            types.append(String(decoding: data.subdata(in: offset + 4 ..< offset + 8), as: UTF8.self))
+            offset += readUInt32(data, at: offset)
+        }
+        return types
+    }
+
+    /// The entries of the first `stco` box
+    private func chunkOffsets(in data: Data) -> [Int] {
+        guard let range = data.range(of: Data("stco".utf8)) else { return [] }
+        let count = readUInt32(data, at: range.upperBound + 4)
+        return (0 ..< count).map { readUInt32(data, at: range.upperBound + 8 + $0 * 4) }
+    }
+}
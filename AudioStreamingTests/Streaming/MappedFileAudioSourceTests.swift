@@ -0,0 +1,202 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import AudioToolbox
+import XCTest
+
+@testable import AudioStreaming
+
+class MappedFileAudioSourceTests: XCTestCase {
+    private let queue = DispatchQueue(label: "mapped.file.audio.source.tests")
+
+    func test_Delivers_File_In_Read_Size_Slices() throws {
+        let url = try fixtureURL()
+        let source = MappedFileAudioSource(url: url, underlyingQueue: queue, readSize: 4096)
+        let spy = ChunkSpy(ended: expectation(description: "ended"))
+
+        queue.sync {
+            source.delegate = spy
+            source.seek(at: 0)
+        }
+        wait(for: [spy.ended], timeout: 5)
+
+        XCTAssertEqual(spy.data, try Data(contentsOf: url))
+        XCTAssertEqual(spy.chunks.dropLast().map(\.count), Array(repeating: 4096, count: spy.chunks.count - 1))
+        queue.sync {
+            XCTAssertEqual(source.position, spy.data.count)
+            XCTAssertEqual(source.length, spy.data.count)
+            XCTAssertEqual(source.audioFileHint, kAudioFileMP3Type)
+        }
+    }
+
+    func test_Slices_Are_Not_Copied() throws {
+        let source = MappedFileAudioSource(url: try fixtureURL(), underlyingQueue: queue, readSize: 4096)
+        let spy = ChunkSpy(ended: expectation(description: "ended"))
+
+        queue.sync {
+            source.delegate = spy
+            source.seek(at: 0)
+        }
+        wait(for: [spy.ended], timeout: 5)
+
+        // consecutive slices are consecutive bytes of the mapping
+        let addresses = spy.chunks.map { chunk in chunk.withUnsafeBytes { Int(bitPattern: $0.baseAddress) } }
+        for (index, address) in addresses.enumerated().dropFirst() {
+            XCTAssertEqual(address, addresses[index - 1] + 4096)
+        }
+    }
+
+    func test_Seeks_To_Offset_And_Aligns_Following_Slices() throws {
+        let url = try fixtureURL()
+        let source = MappedFileAudioSource(url: url, underlyingQueue: queue, readSize: 4096)
+        let spy = ChunkSpy(ended: expectation(description: "ended"))
+
+        queue.sync {
+            source.delegate = spy
+            source.seek(at: 5000)
+        }
+        wait(for: [spy.ended], timeout: 5)
+
+        XCTAssertEqual(spy.data, try Data(contentsOf: url).suffix(from: 5000))
+        XCTAssertEqual(spy.chunks.first?.count, 8192 - 5000)
+    }
+
+    func test_Suspended_Source_Delivers_Nothing_Until_Resumed() throws {
+        let url = try fixtureURL()
+        let source = MappedFileAudioSource(url: url, underlyingQueue: queue, readSize: 4096)
+        let spy = ChunkSpy(ended: expectation(description: "ended"))
+
+        queue.sync {
+            source.delegate = spy
+            source.seek(at: 0)
+            source.suspend()
+        }
+        queue.sync {}
+        XCTAssertTrue(spy.data.isEmpty)
+
+        queue.sync {
+            source.resume()
+        }
+        wait(for: [spy.ended], timeout: 5)
+        XCTAssertEqual(spy.data, try Data(contentsOf: url))
+    }
+
+    func test_Delivered_Data_Outlives_Source() throws {
+        let url = try fixtureURL()
+        var source: MappedFileAudioSource? = MappedFileAudioSource(url: url, underlyingQueue: queue)
+        let spy = ChunkSpy(ended: expectation(description: "ended"))
+
+        queue.sync {
+            source?.delegate = spy
+            source?.seek(at: 0)
+        }
+        wait(for: [spy.ended], timeout: 5)
+        queue.sync {
+            source?.close()
+            source = nil
+        }
+
+        // the mapping is kept by the slices
+        XCTAssertEqual(spy.data, try Data(contentsOf: url))
+    }
+
+    func test_Can_Only_Map_Non_Empty_Regular_Files() throws {
+        let empty = FileManager.default.temporaryDirectory.appendingPathComponent("empty.mp3")
+        try Data().write(to: empty)
+        defer { try? FileManager.default.removeItem(at: empty) }
+
+        XCTAssertTrue(MappedFileAudioSource.canMap(url: try fixtureURL()))
+        XCTAssertFalse(MappedFileAudioSource.canMap(url: empty))
+        XCTAssertFalse(MappedFileAudioSource.canMap(url: FileManager.default.temporaryDirectory))
+        XCTAssertFalse(MappedFileAudioSource.canMap(url: URL(string: "https://example.com/file.mp3")!))
+    }
+
+    // MARK: Benchmarks
+
+    func test_Performance_FileAudioSource() throws {
+        let url = try largeFile()
+        defer { try? FileManager.default.removeItem(at: url) }
+        measure {
+            read(FileAudioSource(url: url, underlyingQueue: queue))
+        }
+    }
+
+    func test_Performance_MappedFileAudioSource() throws {
+        let url = try largeFile()
+        defer { try? FileManager.default.removeItem(at: url) }
+        measure {
+            read(MappedFileAudioSource(url: url, underlyingQueue: queue))
+        }
+    }
+
+    // MARK: Helpers
+
+    /// Reads the whole source, touching every cache line as a parser would
+    private func read(_ source: CoreAudioStreamSource) {
+        let spy = ChunkSpy(ended: expectation(description: "ended"), keepsChunks: false)
+        queue.sync {
+            source.delegate = spy
+            source.seek(at: 0)
+        }
+        wait(for: [spy.ended], timeout: 30)
+        queue.sync {
+            source.close()
+        }
+    }
+
+    private func largeFile() throws -> URL {
+        let url = FileManager.default.temporaryDirectory.appendingPathComponent("mapped-benchmark.mp3")
+        let fixture = try Data(contentsOf: fixtureURL())
+        var data = Data(capacity: 32 * 1024 * 1024)
+        while data.count < 32 * 1024 * 1024 {
+            data.append(fixture)
+        }
+        try data.write(to: url)
+        return url
+    }
+
+    private func fixtureURL() throws -> URL {
+        let bundle = Bundle(for: MappedFileAudioSourceTests.self)
+        return try XCTUnwrap(bundle.url(forResource: "sine-1khz-44100-stereo", withExtension: "mp3"))
+    }
+}
+
+/// Keeps the chunks delivered by a source, as delivered
+final class ChunkSpy: AudioStreamSourceDelegate {
+    var chunks: [Data] = []
+    var checksum = 0
+    let ended: XCTestExpectation
+    private let keepsChunks: Bool
+
+    var data: Data {
+        chunks.reduce(into: Data()) { $0.append($1) }
+    }
+
+    init(ended: XCTestExpectation, keepsChunks: Bool = true) {
+        self.ended = ended
+        self.keepsChunks = keepsChunks
+    }
+
+    func dataAvailable(source _: CoreAudioStreamSource, data: Data) {
+        data.withUnsafeBytes { buffer in
+            for index in stride(from: 0, to: buffer.count, by: 64) {
+                checksum &+= Int(buffer[index])
+            }
+        }
+        if keepsChunks {
+            chunks.append(data)
+        }
+    }
+
+    func errorOccured(source _: CoreAudioStreamSource, error _: Error) {
+        ended.fulfill()
+    }
+
+    func endOfFileOccured(source _: CoreAudioStreamSource) {
+        ended.fulfill()
+    }
+
+    func metadataReceived(data _: [String: String]) {}
+}
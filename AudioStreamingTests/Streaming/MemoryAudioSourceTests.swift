@@ -0,0 +1,149 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import AVFoundation
+import XCTest
+
+@testable import AudioStreaming
+
+class MemoryAudioSourceTests: XCTestCase {
+    private let queue = DispatchQueue(label: "memory.audio.source.tests")
+
+    func test_Delivers_Data_With_File_Type() throws {
+        let data = try fixture()
+        let source = MemoryAudioSource(audio: InMemoryAudio(data: data, fileType: kAudioFileMP3Type),
+                                       underlyingQueue: queue)
+        let spy = ChunkSpy(ended: expectation(description: "ended"))
+
+        queue.sync {
+            source.delegate = spy
+            source.seek(at: 0)
+        }
+        wait(for: [spy.ended], timeout: 5)
+
+        XCTAssertEqual(spy.data, data)
+        queue.sync {
+            XCTAssertEqual(source.audioFileHint, kAudioFileMP3Type)
+            XCTAssertEqual(source.position, data.count)
+            XCTAssertEqual(source.length, data.count)
+        }
+    }
+
+    func test_Delivers_Caller_Memory_Without_Copying() throws {
+        let data = try fixture()
+        let buffer = UnsafeMutableRawBufferPointer.allocate(byteCount: data.count, alignment: 16)
+        buffer.copyBytes(from: data)
+        var isDeallocated = false
+        var source: MemoryAudioSource? = {
+            let audio = InMemoryAudio(bytes: UnsafeRawBufferPointer(buffer), fileType: kAudioFileMP3Type) { bytes in
+                XCTAssertEqual(bytes.baseAddress, UnsafeRawPointer(buffer.baseAddress))
+                buffer.deallocate()
+                isDeallocated = true
+            }
+            return MemoryAudioSource(bytes: audio.makeBytes,
+                                     fileHint: audio.fileType,
+                                     underlyingQueue: queue,
+                                     readSize: 4096)
+        }()
+        var spy: ChunkSpy? = ChunkSpy(ended: expectation(description: "ended"))
+
+        queue.sync {
+            source?.delegate = spy
+            source?.seek(at: 0)
+        }
+        wait(for: [spy!.ended], timeout: 5)
+
+        let addresses = spy!.chunks.map { chunk in chunk.withUnsafeBytes { $0.baseAddress } }
+        XCTAssertEqual(addresses.first, UnsafeRawPointer(buffer.baseAddress))
+        XCTAssertEqual(addresses.last, UnsafeRawPointer(buffer.baseAddress! + (spy!.chunks.count - 1) * 4096))
+        XCTAssertEqual(spy!.data, data)
+
+        // the memory is released with the last slice, once the audio and the source are too
+        queue.sync {
+            source = nil
+        }
+        XCTAssertFalse(isDeallocated)
+        spy = nil
+        XCTAssertTrue(isDeallocated)
+    }
+
+    func test_Seeks_Instantly_Within_Memory() throws {
+        let data = try fixture()
+        let source = MemoryAudioSource(bytes: { SharedBytes(data: data) },
+                                       fileHint: kAudioFileMP3Type,
+                                       underlyingQueue: queue,
+                                       readSize: 4096)
+        let spy = ChunkSpy(ended: expectation(description: "ended"))
+
+        queue.sync {
+            source.delegate = spy
+            source.seek(at: 10000)
+        }
+        wait(for: [spy.ended], timeout: 5)
+
+        XCTAssertEqual(spy.data, data.suffix(from: 10000))
+        XCTAssertEqual(spy.chunks.first?.count, 12288 - 10000)
+    }
+
+    func test_Closing_From_Delegate_Stops_Delivery() throws {
+        let data = try fixture()
+        let source = MemoryAudioSource(bytes: { SharedBytes(data: data) },
+                                       fileHint: kAudioFileMP3Type,
+                                       underlyingQueue: queue,
+                                       readSize: 4096)
+        let spy = ClosingSpy()
+
+        queue.sync {
+            source.delegate = spy
+            source.seek(at: 0)
+        }
+        // lets a read scheduled after closing run, if any
+        queue.sync {}
+        queue.sync {}
+
+        XCTAssertEqual(spy.chunkCount, 1)
+        XCTAssertFalse(spy.hasEnded)
+    }
+
+    func test_Provider_Plays_In_Memory_Audio() throws {
+        let provider = AudioEntryProvider(networkingClient: NetworkingClient(),
+                                          underlyingQueue: queue,
+                                          outputAudioFormat: AVAudioFormat(standardFormatWithSampleRate: 44100,
+                                                                           channels: 2)!)
+        let entry = provider.provideAudioEntry(audio: InMemoryAudio(data: try fixture(),
+                                                                   fileType: kAudioFileMP3Type,
+                                                                   id: "chime"))
+
+        XCTAssertEqual(entry.id, AudioEntryId(id: "chime"))
+        XCTAssertEqual(entry.audioFileHint, kAudioFileMP3Type)
+    }
+
+    // MARK: Helpers
+
+    private func fixture() throws -> Data {
+        let bundle = Bundle(for: MemoryAudioSourceTests.self)
+        let url = try XCTUnwrap(bundle.url(forResource: "sine-1khz-44100-stereo", withExtension: "mp3"))
+        return try Data(contentsOf: url)
+    }
+}
+
+/// Closes the source on the first chunk
+private final class ClosingSpy: AudioStreamSourceDelegate {
+    var chunkCount = 0
+    var hasEnded = false
+
+    func dataAvailable(source: CoreAudioStreamSource, data _: Data) {
+        chunkCount += 1
+        source.close()
+    }
+
+    func errorOccured(source _: CoreAudioStreamSource, error _: Error) {}
+
+    func endOfFileOccured(source _: CoreAudioStreamSource) {
+        hasEnded = true
+    }
+
+    func metadataReceived(data _: [String: String]) {}
+}
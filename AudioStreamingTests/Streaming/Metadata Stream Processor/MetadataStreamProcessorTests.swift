@@ -128,11 +128,57 @@ class MetadataStreamProcessorTests: XCTestCase {
         XCTAssertFalse(metadataDelegateSpy.receivedMetadata.called)
         XCTAssertNil(metadataDelegateSpy.receivedMetadata.result)
     }
+
+    func test_Processor_Reports_Audio_Offset_Of_Metadata() throws {
+        let bundle = Bundle(for: MetadataStreamProcessorTests.self)
+        let url = bundle.url(forResource: "raw-stream-audio-normal-metadata", withExtension: nil)!
+
+        let data = try Data(contentsOf: url)
+
+        let parser = MetadataParser()
+        let processor = MetadataStreamProcessor(parser: parser.eraseToAnyParser())
+        processor.delegate = metadataDelegateSpy
+        processor.metadataAvailable(step: 16000)
+
+        let audio = processor.proccessMetadata(data: data)
+
+        // the metadata follows the first 16000 bytes of audio
+        XCTAssertEqual(metadataDelegateSpy.audioOffsets, [16000])
+        // every 16000 bytes a length byte, one of them followed by 32 bytes of metadata
+        XCTAssertEqual(audio.count, data.count - 7 - 32)
+    }
+
+    func test_Processor_Reports_Audio_Offset_Of_Metadata_Within_Chunk() throws {
+        let bundle = Bundle(for: MetadataStreamProcessorTests.self)
+        let url = bundle.url(forResource: "raw-stream-audio-normal-metadata", withExtension: nil)!
+
+        let data = try Data(contentsOf: url)
+
+        let parser = MetadataParser()
+        let processor = MetadataStreamProcessor(parser: parser.eraseToAnyParser())
+        processor.delegate = metadataDelegateSpy
+        processor.metadataAvailable(step: 16000)
+
+        // the offset reported is within the audio returned for the chunk holding the end of the metadata
+        var audioCount = 0
+        var metadataOffsets: [Int] = []
+        for offset in stride(from: 0, to: data.count, by: 3000) {
+            let chunk = data.subdata(in: offset ..< min(offset + 3000, data.count))
+            let reported = metadataDelegateSpy.audioOffsets.count
+            let audio = processor.proccessMetadata(data: chunk)
+            metadataOffsets += metadataDelegateSpy.audioOffsets[reported...].map { audioCount + $0 }
+            audioCount += audio.count
+        }
+
+        XCTAssertEqual(metadataOffsets, [16000])
+    }
 }
 
 class MetadataDelegateSpy: MetadataStreamSourceDelegate {
     var receivedMetadata: (called: Bool, result: Result<[String: String], MetadataParsingError>?) = (false, nil)
-    func didReceiveMetadata(metadata: Result<[String: String], MetadataParsingError>) {
+    var audioOffsets: [Int] = []
+    func didReceiveMetadata(metadata: Result<[String: String], MetadataParsingError>, audioOffset: Int) {
         receivedMetadata = (true, metadata)
+        audioOffsets.append(audioOffset)
     }
 }
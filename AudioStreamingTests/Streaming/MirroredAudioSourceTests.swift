@@ -0,0 +1,192 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import XCTest
+
+@testable import AudioStreaming
+
+class MirroredAudioSourceTests: XCTestCase {
+    private let queue = DispatchQueue(label: "mirrored.audio.source.tests")
+    private let file = Data((0 ..< 50000).map { UInt8(truncatingIfNeeded: $0 &* 13) })
+
+    override func setUp() {
+        super.setUp()
+        StaticFileURLProtocol.reset()
+    }
+
+    override func tearDown() {
+        StaticFileURLProtocol.reset()
+        super.tearDown()
+    }
+
+    func test_Mirrors_Listed_By_A_Playlist_Are_Played() {
+        StaticFileURLProtocol.serve("listen.pls", bodies: ["[playlist]\nFile1=first.mp3\nFile2=second.mp3\n"])
+        StaticFileURLProtocol.serve("first.mp3", data: [file])
+        StaticFileURLProtocol.serve("second.mp3", data: [file])
+
+        let (source, spy) = play(playlist: "listen.pls", mirrors: [], connectionAttemptDelay: 5)
+
+        XCTAssertNil(spy.error)
+        XCTAssertEqual(spy.data, file)
+        XCTAssertEqual(source.length, file.count)
+        // the first mirror delivered audio before the second one was connected
+        XCTAssertEqual(StaticFileURLProtocol.requestCount("first.mp3"), 1)
+        XCTAssertEqual(StaticFileURLProtocol.requestCount("second.mp3"), 0)
+    }
+
+    func test_Mirror_Failing_To_Connect_Is_Replaced_Right_Away() {
+        StaticFileURLProtocol.serve("second.mp3", data: [file])
+
+        let (_, spy) = play(playlist: nil, mirrors: ["missing.mp3", "second.mp3"], connectionAttemptDelay: 5)
+
+        XCTAssertNil(spy.error)
+        XCTAssertEqual(spy.data, file)
+        XCTAssertEqual(StaticFileURLProtocol.requestCount("missing.mp3"), 1)
+    }
+
+    func test_Unreachable_Mirror_Is_Replaced_Right_Away() {
+        StaticFileURLProtocol.serve("second.mp3", data: [file])
+        StaticFileURLProtocol.fail("first.mp3", with: .cannotConnectToHost)
+
+        let (_, spy) = play(playlist: nil, mirrors: ["first.mp3", "second.mp3"], connectionAttemptDelay: 5)
+
+        XCTAssertNil(spy.error)
+        XCTAssertEqual(spy.data, file)
+        // reported rather than retried by the mirror's source
+        XCTAssertEqual(StaticFileURLProtocol.requestCount("first.mp3"), 1)
+    }
+
+    func test_Mirror_Is_Found_Past_Two_Unreachable_Ones() {
+        StaticFileURLProtocol.serve("third.mp3", data: [file])
+        StaticFileURLProtocol.fail("first.mp3", with: .cannotConnectToHost)
+        StaticFileURLProtocol.fail("second.mp3", with: .timedOut)
+
+        let (_, spy) = play(playlist: nil, mirrors: ["first.mp3", "second.mp3", "third.mp3"], connectionAttemptDelay: 0)
+
+        XCTAssertNil(spy.error)
+        XCTAssertEqual(spy.data, file)
+        XCTAssertEqual(StaticFileURLProtocol.requestCount("first.mp3"), 1)
+        XCTAssertEqual(StaticFileURLProtocol.requestCount("second.mp3"), 1)
+    }
+
+    func test_Mirror_Failing_Mid_Stream_Fails_Over_Without_Waiting_For_A_Stall() {
+        StaticFileURLProtocol.serve("first.mp3", data: [file])
+        StaticFileURLProtocol.fail("first.mp3", with: .networkConnectionLost, after: 20000)
+        StaticFileURLProtocol.serve("second.mp3", data: [file])
+
+        // the stall timeout outlasts the wait for the end
+        let (_, spy) = play(playlist: nil, mirrors: ["first.mp3", "second.mp3"], connectionAttemptDelay: 5)
+
+        XCTAssertNil(spy.error)
+        XCTAssertEqual(spy.data, file)
+        XCTAssertEqual(StaticFileURLProtocol.requestCount("first.mp3"), 1)
+        XCTAssertEqual(StaticFileURLProtocol.requestedRanges("second.mp3"), ["bytes=20000-"])
+    }
+
+    func test_Paused_Mirror_Failing_Fails_Over_Once_Resumed() {
+        StaticFileURLProtocol.serve("first.mp3", data: [file])
+        StaticFileURLProtocol.fail("first.mp3", with: .networkConnectionLost, after: 20000)
+        StaticFileURLProtocol.serve("second.mp3", data: [file])
+        let source = makeSource(playlist: nil, mirrors: ["first.mp3", "second.mp3"], connectionAttemptDelay: 5)
+        let paused = expectation(description: "nothing reported while paused")
+        paused.isInverted = true
+        let spy = SourceDelegateSpy(ended: paused)
+
+        queue.sync {
+            source.delegate = spy
+            source.seek(at: 0)
+            source.suspend()
+        }
+        wait(for: [paused], timeout: 1)
+        queue.sync {
+            XCTAssertTrue(spy.data.isEmpty)
+        }
+        XCTAssertEqual(StaticFileURLProtocol.requestCount("second.mp3"), 0)
+
+        spy.ended = expectation(description: "ended once resumed")
+        queue.sync {
+            source.resume()
+        }
+        wait(for: [spy.ended], timeout: 5)
+        queue.sync {}
+        XCTAssertNil(spy.error)
+        XCTAssertEqual(spy.data, file)
+    }
+
+    func test_Unreachable_Mirrors_Report_Their_Error() {
+        StaticFileURLProtocol.fail("first.mp3", with: .cannotConnectToHost)
+        StaticFileURLProtocol.fail("second.mp3", with: .cannotConnectToHost)
+
+        let (_, spy) = play(playlist: nil, mirrors: ["first.mp3", "second.mp3"], connectionAttemptDelay: 5)
+
+        XCTAssertEqual((spy.error as? URLError)?.code, .cannotConnectToHost)
+        XCTAssertTrue(spy.data.isEmpty)
+    }
+
+    func test_Live_Stream_Dropped_By_Its_Mirror_Fails_Over_To_The_Next() {
+        let first = file.prefix(20000)
+        let second = file.suffix(from: 20000)
+        StaticFileURLProtocol.serve("first.mp3", data: [first], live: true)
+        StaticFileURLProtocol.serve("second.mp3", data: [second], live: true)
+
+        let (_, spy) = play(playlist: nil, mirrors: ["first.mp3", "second.mp3"], connectionAttemptDelay: 5)
+
+        XCTAssertEqual(spy.data, file)
+        XCTAssertEqual(StaticFileURLProtocol.requestCount("first.mp3"), 1)
+        XCTAssertEqual(StaticFileURLProtocol.requestCount("second.mp3"), 1)
+        // both mirrors dropped the stream right away
+        XCTAssertNotNil(spy.error)
+    }
+
+    func test_Error_Is_Reported_Once_Every_Mirror_Failed() {
+        let (_, spy) = play(playlist: nil, mirrors: ["missing.mp3", "gone.mp3"], connectionAttemptDelay: 5)
+
+        XCTAssertEqual(spy.error as? NetworkError, .serverError)
+        XCTAssertTrue(spy.data.isEmpty)
+    }
+
+    // MARK: Helpers
+
+    private func play(playlist: String?,
+                      mirrors: [String],
+                      connectionAttemptDelay: TimeInterval) -> (MirroredAudioSource, SourceDelegateSpy)
+    {
+        let source = makeSource(playlist: playlist, mirrors: mirrors, connectionAttemptDelay: connectionAttemptDelay)
+        let spy = SourceDelegateSpy(ended: expectation(description: "ended"))
+        queue.sync {
+            source.delegate = spy
+            source.seek(at: 0)
+        }
+        wait(for: [spy.ended], timeout: 5)
+        queue.sync {}
+        return (source, spy)
+    }
+
+    private func makeSource(playlist: String?,
+                            mirrors: [String],
+                            connectionAttemptDelay: TimeInterval) -> MirroredAudioSource
+    {
+        let configuration = URLSessionConfiguration.ephemeral
+        configuration.protocolClasses = [StaticFileURLProtocol.self]
+        let networking = NetworkingClient(configuration: configuration)
+        return MirroredAudioSource(networking: networking,
+                                   playlistURL: playlist.map(url),
+                                   mirrors: mirrors.map(url),
+                                   underlyingQueue: queue,
+                                   httpHeaders: [:],
+                                   connectionAttemptDelay: connectionAttemptDelay,
+                                   makeSource: { [queue] mirror in
+                                       RemoteAudioSource(networking: networking,
+                                                         url: mirror,
+                                                         underlyingQueue: queue,
+                                                         httpHeaders: [:],
+                                                         retriesOnError: false)
+                                   })
+    }
+
+    private func url(_ name: String) -> URL {
+        URL(string: "https://\(StaticFileURLProtocol.host)/\(name)")!
+    }
+}
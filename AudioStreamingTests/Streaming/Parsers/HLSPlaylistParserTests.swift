@@ -0,0 +1,133 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import XCTest
+
+@testable import AudioStreaming
+
+class HLSPlaylistParserTests: XCTestCase {
+    private let playlistURL = URL(string: "https://example.com/audio/playlist.m3u8")!
+
+    func test_Rejects_Input_Without_Header() {
+        let parser = HLSPlaylistParser(url: playlistURL)
+
+        XCTAssertEqual(parser.parse(input: "#EXTINF:10,\nsegment.ts"), .failure(.invalidPlaylist))
+    }
+
+    func test_Parses_Master_Playlist_Variants() {
+        let parser = HLSPlaylistParser(url: playlistURL)
+        let input = """
+        #EXTM3U
+        #EXT-X-STREAM-INF:BANDWIDTH=64000,AVERAGE-BANDWIDTH=60000,CODECS="mp4a.40.5, mp4a.40.2"
+        low/playlist.m3u8
+        #EXT-X-STREAM-INF:BANDWIDTH=128000,CODECS="mp4a.40.2"
+        https://cdn.example.com/high.m3u8
+        """
+
+        guard case let .success(.master(master)) = parser.parse(input: input) else {
+            return XCTFail("expected a master playlist")
+        }
+
+        XCTAssertEqual(master.variants, [
+            HLSVariant(url: URL(string: "https://example.com/audio/low/playlist.m3u8")!,
+                       bandwidth: 64000,
+                       averageBandwidth: 60000,
+                       codecs: ["mp4a.40.5", "mp4a.40.2"]),
+            HLSVariant(url: URL(string: "https://cdn.example.com/high.m3u8")!,
+                       bandwidth: 128_000,
+                       averageBandwidth: nil,
+                       codecs: ["mp4a.40.2"]),
+        ])
+    }
+
+    func test_Parses_Live_Media_Playlist() {
+        let parser = HLSPlaylistParser(url: playlistURL)
+        let input = """
+        #EXTM3U
+        #EXT-X-TARGETDURATION:6
+        #EXT-X-MEDIA-SEQUENCE:120
+        #EXT-X-KEY:METHOD=NONE
+        #EXTINF:6.0,
+        segment120.ts
+        #EXTINF:5.5,title
+        segment121.ts
+        """
+
+        guard case let .success(.media(playlist)) = parser.parse(input: input) else {
+            return XCTFail("expected a media playlist")
+        }
+
+        XCTAssertEqual(playlist.targetDuration, 6)
+        XCTAssertEqual(playlist.mediaSequence, 120)
+        XCTAssertFalse(playlist.isEndList)
+        XCTAssertEqual(playlist.duration, 11.5)
+        XCTAssertEqual(playlist.segments.map(\.sequenceNumber), [120, 121])
+        XCTAssertEqual(playlist.segments.map(\.url.absoluteString), [
+            "https://example.com/audio/segment120.ts",
+            "https://example.com/audio/segment121.ts",
+        ])
+    }
+
+    func test_Parses_Byte_Ranges_And_Initialization_Section() {
+        let parser = HLSPlaylistParser(url: playlistURL)
+        let input = """
+        #EXTM3U
+        #EXT-X-TARGETDURATION:2
+        #EXT-X-MAP:URI="audio.mp4",BYTERANGE="700@0"
+        #EXTINF:2,
+        #EXT-X-BYTERANGE:1000@700
+        audio.mp4
+        #EXTINF:2,
+        #EXT-X-BYTERANGE:1200
+        audio.mp4
+        #EXT-X-ENDLIST
+        """
+
+        guard case let .success(.media(playlist)) = parser.parse(input: input) else {
+            return XCTFail("expected a media playlist")
+        }
+
+        let section = HLSInitializationSection(url: URL(string: "https://example.com/audio/audio.mp4")!,
+                                               byteRange: 0 ..< 700)
+        XCTAssertTrue(playlist.isEndList)
+        XCTAssertEqual(playlist.segments.map(\.byteRange), [700 ..< 1700, 1700 ..< 2900])
+        XCTAssertEqual(playlist.segments.map(\.initializationSection), [section, section])
+    }
+
+    func test_On_Demand_Playlist_Type_Ends_The_List() {
+        let parser = HLSPlaylistParser(url: playlistURL)
+        let input = """
+        #EXTM3U
+        #EXT-X-PLAYLIST-TYPE:VOD
+        #EXT-X-TARGETDURATION:1
+        #EXTINF:1,
+        segment.aac
+        """
+
+        guard case let .success(.media(playlist)) = parser.parse(input: input) else {
+            return XCTFail("expected a media playlist")
+        }
+        XCTAssertTrue(playlist.isEndList)
+    }
+
+    func test_Rejects_Encrypted_And_Empty_Playlists() {
+        let parser = HLSPlaylistParser(url: playlistURL)
+        let encrypted = """
+        #EXTM3U
+        #EXT-X-KEY:METHOD=AES-128,URI="https://example.com/key"
+        #EXTINF:1,
+        segment.ts
+        """
+
+        XCTAssertEqual(parser.parse(input: encrypted), .failure(.encryptedSegments))
+        XCTAssertEqual(parser.parse(input: "#EXTM3U\n#EXT-X-ENDLIST"), .failure(.emptyPlaylist))
+    }
+
+    func test_Attribute_Lists_With_Quoted_Commas() {
+        let attributes = HLSPlaylistParser.attributes(#"BANDWIDTH=1,CODECS="a,b",URI="x.m3u8""#)
+
+        XCTAssertEqual(attributes, ["BANDWIDTH": "1", "CODECS": "a,b", "URI": "x.m3u8"])
+    }
+}
@@ -0,0 +1,68 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import XCTest
+
+@testable import AudioStreaming
+
+class StreamPlaylistParserTests: XCTestCase {
+    private let playlistURL = URL(string: "https://example.com/radio/listen.pls")!
+
+    func test_Parses_PLS_Entries_In_Their_Order() {
+        let parser = StreamPlaylistParser(url: playlistURL)
+        let input = """
+        [playlist]
+        NumberOfEntries=3
+        File2=https://b.example.com/stream
+        Title2=Mirror B
+        File1=https://a.example.com/stream
+        Title1=Mirror A
+        File3=c/stream
+        Length1=-1
+        Version=2
+        """
+
+        XCTAssertEqual(parser.parse(input: input), .success([
+            URL(string: "https://a.example.com/stream")!,
+            URL(string: "https://b.example.com/stream")!,
+            URL(string: "https://example.com/radio/c/stream")!,
+        ]))
+    }
+
+    func test_Parses_M3U_Entries_Skipping_Comments() {
+        let parser = StreamPlaylistParser(url: playlistURL)
+        let input = """
+        #EXTM3U
+        #EXTINF:-1,Mirror A
+        https://a.example.com/stream
+
+        #EXTINF:-1,Mirror B
+        /b/stream\r
+        """
+
+        XCTAssertEqual(parser.parse(input: input), .success([
+            URL(string: "https://a.example.com/stream")!,
+            URL(string: "https://example.com/b/stream")!,
+        ]))
+    }
+
+    func test_Skips_Duplicates_And_Unsupported_Schemes() {
+        let parser = StreamPlaylistParser(url: playlistURL)
+        let input = """
+        https://a.example.com/stream
+        rtsp://a.example.com/stream
+        https://a.example.com/stream
+        """
+
+        XCTAssertEqual(parser.parse(input: input), .success([URL(string: "https://a.example.com/stream")!]))
+    }
+
+    func test_Rejects_Playlist_Without_Entries() {
+        let parser = StreamPlaylistParser(url: playlistURL)
+
+        XCTAssertEqual(parser.parse(input: "[playlist]\nNumberOfEntries=0"), .failure(.emptyPlaylist))
+        XCTAssertEqual(parser.parse(input: "#EXTM3U\n"), .failure(.emptyPlaylist))
+    }
+}
@@ -0,0 +1,128 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import XCTest
+
+@testable import AudioStreaming
+
+class PlaybackClockTests: XCTestCase {
+    func test_Clock_Is_Held_At_Zero_Until_A_Sample_Is_Published() {
+        let clock = PlaybackClock()
+
+        let sample = clock.sample()
+
+        XCTAssertTrue(sample.isHeld)
+        XCTAssertEqual(sample.position(at: 100), 0)
+    }
+
+    func test_Position_Is_Interpolated_From_The_Latest_Sample() {
+        let clock = PlaybackClock()
+        clock.outputLatency.store(0.1)
+        clock.publish(framesRendered: 44100, position: 1, hostTime: 10, renderedDuration: 0.5, epoch: clock.currentEpoch())
+
+        let sample = clock.sample()
+
+        XCTAssertFalse(sample.isHeld)
+        XCTAssertEqual(sample.framesRendered, 44100)
+        // the first frame of the cycle is heard after the latency
+        XCTAssertEqual(sample.position(at: 10.1), 1, accuracy: 0.0001)
+        XCTAssertEqual(sample.position(at: 10.35), 1.25, accuracy: 0.0001)
+        // audio rendered before the cycle is still being heard
+        XCTAssertEqual(sample.position(at: 10.05), 0.95, accuracy: 0.0001)
+        // it doesn't move past the audio rendered
+        XCTAssertEqual(sample.position(at: 20), 1.5, accuracy: 0.0001)
+    }
+
+    func test_Position_Moves_At_The_Rate() {
+        let clock = PlaybackClock()
+        clock.rate.store(2)
+        clock.publish(framesRendered: 0, position: 1, hostTime: 10, renderedDuration: 1, epoch: clock.currentEpoch())
+
+        XCTAssertEqual(clock.sample().position(at: 10.25), 1.5, accuracy: 0.0001)
+    }
+
+    func test_Consecutive_Samples_Give_A_Continuous_Position() {
+        let clock = PlaybackClock()
+        clock.outputLatency.store(0.02)
+        let cycle = 512.0 / 44100
+        clock.publish(framesRendered: 0, position: 0, hostTime: 5, renderedDuration: cycle, epoch: clock.currentEpoch())
+        let first = clock.sample()
+        clock.publish(framesRendered: 512, position: cycle, hostTime: 5 + cycle, renderedDuration: cycle,
+                      epoch: clock.currentEpoch())
+        let second = clock.sample()
+
+        let time = 5 + cycle + 0.01
+        XCTAssertEqual(first.position(at: time), second.position(at: time), accuracy: 0.000001)
+    }
+
+    func test_Seeking_Holds_The_Clock_Until_The_Audio_Sought_Renders() {
+        let clock = PlaybackClock()
+        let epoch = clock.currentEpoch()
+        clock.publish(framesRendered: 0, position: 5, hostTime: 10, renderedDuration: 0.01, epoch: epoch)
+
+        clock.hold(at: 30)
+        XCTAssertEqual(clock.sample().position(at: 10), 30)
+        // a cycle that started before the seek doesn't move the clock
+        clock.publish(framesRendered: 512, position: 5.01, hostTime: 10.01, renderedDuration: 0.01, epoch: epoch)
+        XCTAssertTrue(clock.sample().isHeld)
+
+        clock.release()
+        XCTAssertTrue(clock.sample().isHeld)
+        XCTAssertEqual(clock.sample().position(at: 11), 30)
+
+        clock.publish(framesRendered: 0, position: 30, hostTime: 11, renderedDuration: 0.01,
+                      epoch: clock.currentEpoch())
+        XCTAssertFalse(clock.sample().isHeld)
+        XCTAssertEqual(clock.sample().position(at: 11.005), 30.005, accuracy: 0.0001)
+    }
+
+    func test_Following_The_Same_Entry_Keeps_The_Clock() {
+        let clock = PlaybackClock()
+        clock.publish(framesRendered: 0, position: 5, hostTime: 10, renderedDuration: 1, epoch: clock.currentEpoch())
+        clock.hold(at: 8)
+
+        // no entry is followed to start with
+        clock.follow(nil)
+        XCTAssertEqual(clock.sample().position(at: 10), 8)
+    }
+
+    func test_Samples_Are_Read_Whole_While_Published() {
+        let clock = PlaybackClock()
+        let epoch = clock.currentEpoch()
+        let isPublishing = Atomic<Bool>(true)
+        let published = expectation(description: "published")
+
+        DispatchQueue.global(qos: .userInteractive).async {
+            for frame in 1 ... 200_000 {
+                let seconds = Double(frame) / 44100
+                clock.publish(framesRendered: frame, position: seconds, hostTime: seconds, renderedDuration: seconds,
+                              epoch: epoch)
+            }
+            isPublishing.store(false)
+            published.fulfill()
+        }
+
+        while isPublishing.value {
+            let sample = clock.sample()
+            guard !sample.isHeld else { continue }
+            let seconds = Double(sample.framesRendered) / 44100
+            XCTAssertEqual(sample.position, seconds)
+            XCTAssertEqual(sample.hostTime, seconds)
+            XCTAssertEqual(sample.renderedDuration, seconds)
+        }
+        wait(for: [published], timeout: 10)
+        XCTAssertEqual(clock.sample().framesRendered, 200_000)
+    }
+
+    func test_Atomic_Doubles_Keep_Their_Bit_Pattern() {
+        let value = Atomic<Double>(-0.0)
+        XCTAssertEqual(value.value.sign, .minus)
+        for number in [1.5, -3.25, .greatestFiniteMagnitude, .leastNonzeroMagnitude, .infinity] {
+            value.store(number)
+            XCTAssertEqual(value.value, number)
+        }
+        XCTAssertTrue(Atomic<Double>(.nan).value.isNaN)
+    }
+}
@@ -0,0 +1,99 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import XCTest
+
+@testable import AudioStreaming
+
+class ScrubSessionTests: XCTestCase {
+    private let queue = DispatchQueue(label: "scrub.session.tests")
+
+    func test_Positions_Are_Coalesced_Into_The_Latest() {
+        let applied = Protected<[Double]>([])
+        let session = ScrubSession(queue: queue, previews: false, debounceInterval: 0.05, maximumInterval: 5) { position in
+            applied.write { $0.append(position) }
+        }
+
+        queue.sync {
+            for position in stride(from: 0.0, through: 30, by: 0.5) {
+                session.scrub(to: position)
+            }
+        }
+        wait(seconds: 0.3)
+
+        XCTAssertEqual(applied.value, [30])
+    }
+
+    func test_Positions_Are_Applied_While_Scrubbing_Keeps_Moving() {
+        let applied = Protected<[Double]>([])
+        let session = ScrubSession(queue: queue, previews: false, debounceInterval: 0.1, maximumInterval: 0.15) { position in
+            applied.write { $0.append(position) }
+        }
+
+        // a new position every 20ms for a second never rests for the debounce interval
+        for step in 0 ..< 50 {
+            queue.sync {
+                session.scrub(to: Double(step))
+            }
+            Thread.sleep(forTimeInterval: 0.02)
+        }
+        wait(seconds: 0.3)
+
+        let positions = applied.value
+        XCTAssertGreaterThanOrEqual(positions.count, 3)
+        XCTAssertLessThan(positions.count, 50)
+        XCTAssertEqual(positions.last, 49)
+        XCTAssertEqual(positions, positions.sorted())
+    }
+
+    func test_Ending_Returns_The_Latest_Position_Without_Applying_It() {
+        let applied = Protected<[Double]>([])
+        let session = ScrubSession(queue: queue, previews: true, debounceInterval: 0.05) { position in
+            applied.write { $0.append(position) }
+        }
+
+        let position = queue.sync { () -> Double? in
+            session.scrub(to: 12)
+            session.scrub(to: 42)
+            return session.end()
+        }
+        wait(seconds: 0.2)
+
+        XCTAssertEqual(position, 42)
+        XCTAssertTrue(applied.value.isEmpty)
+    }
+
+    func test_Ending_Without_Scrubbing_Has_No_Position() {
+        let session = ScrubSession(queue: queue, previews: false) { _ in }
+
+        XCTAssertNil(queue.sync { session.end() })
+    }
+
+    func test_A_Position_Is_Applied_Once() {
+        let applied = Protected<[Double]>([])
+        let session = ScrubSession(queue: queue, previews: false, debounceInterval: 0.02) { position in
+            applied.write { $0.append(position) }
+        }
+
+        queue.sync { session.scrub(to: 10) }
+        wait(seconds: 0.1)
+        queue.sync { session.scrub(to: 10) }
+        wait(seconds: 0.1)
+        queue.sync { session.scrub(to: 20) }
+        wait(seconds: 0.1)
+
+        XCTAssertEqual(applied.value, [10, 20])
+    }
+
+    // MARK: Helpers
+
+    private func wait(seconds: TimeInterval) {
+        let waited = expectation(description: "waited")
+        queue.asyncAfter(deadline: .now() + seconds) {
+            waited.fulfill()
+        }
+        wait(for: [waited], timeout: seconds + 5)
+    }
+}
@@ -0,0 +1,154 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import XCTest
+
+@testable import AudioStreaming
+
+class SegmentedDownloadTests: XCTestCase {
+    private let queue = DispatchQueue(label: "segmented.download.tests")
+    private let file = Data((0 ..< 300_000).map { UInt8(truncatingIfNeeded: $0 &* 7 &+ $0 >> 9) })
+
+    override func setUp() {
+        super.setUp()
+        StaticFileURLProtocol.reset()
+        StaticFileURLProtocol.serve("long.wav", data: [file])
+    }
+
+    override func tearDown() {
+        StaticFileURLProtocol.reset()
+        super.tearDown()
+    }
+
+    // MARK: Download
+
+    func test_Segments_Are_Reassembled_In_Order() throws {
+        let download = makeDownload(policy: SegmentedDownloadPolicy(maximumConnections: 3, segmentSize: 40000))
+        var delivered = Data()
+        let completed = expectation(description: "completed")
+        download.onData = { delivered.append($0) }
+        download.onComplete = { completed.fulfill() }
+
+        queue.sync {
+            download.start()
+            // the request the download started from receives the playhead segment
+            XCTAssertTrue(download.adopt(file.subdata(in: 0 ..< 25000)))
+            XCTAssertFalse(download.adopt(file.subdata(in: 25000 ..< 50000)))
+        }
+        wait(for: [completed], timeout: 5)
+
+        XCTAssertEqual(delivered, file)
+        let ranges = StaticFileURLProtocol.requestedRanges("long.wav")
+        XCTAssertEqual(Set(ranges), Set(stride(from: 40000, to: 300_000, by: 40000).map {
+            "bytes=\($0)-\(min($0 + 40000, 300_000) - 1)"
+        }))
+    }
+
+    func test_Requests_Are_Capped_By_The_Connections() {
+        // the events are never performed, so no segment completes
+        let download = makeDownload(policy: SegmentedDownloadPolicy(maximumConnections: 3, segmentSize: 40000),
+                                    perform: { _ in })
+
+        download.start()
+        waitForRequests()
+
+        // the playhead segment is downloaded by the request the download started from
+        XCTAssertEqual(StaticFileURLProtocol.requestCount("long.wav"), 2)
+    }
+
+    func test_Segments_Ahead_Are_Capped() {
+        var policy = SegmentedDownloadPolicy(maximumConnections: 10, segmentSize: 10000)
+        policy.maximumSegmentsAhead = 3
+        let download = makeDownload(policy: policy, perform: { _ in })
+
+        download.start()
+        waitForRequests()
+
+        XCTAssertEqual(StaticFileURLProtocol.requestedRanges("long.wav").sorted(),
+                       ["bytes=10000-19999", "bytes=20000-29999", "bytes=30000-39999"])
+    }
+
+    func test_Ranges_That_Arent_Honoured_Fail_The_Download() {
+        // live streams are served whole, ignoring ranges
+        StaticFileURLProtocol.serve("long.wav", data: [file], live: true)
+        let download = makeDownload(policy: SegmentedDownloadPolicy(maximumConnections: 2, segmentSize: 40000))
+        var delivered = Data()
+        let failed = expectation(description: "failed")
+        download.onData = { delivered.append($0) }
+        download.onFailure = { error in
+            XCTAssertEqual(error as? NetworkError, .serverError)
+            failed.fulfill()
+        }
+
+        queue.sync {
+            download.start()
+        }
+        wait(for: [failed], timeout: 5)
+
+        queue.sync {
+            XCTAssertFalse(download.adopt(file.subdata(in: 0 ..< 40000)))
+        }
+        XCTAssertTrue(delivered.isEmpty)
+    }
+
+    // MARK: Remote source
+
+    func test_Long_File_Is_Delivered_Whole_By_The_Source() {
+        let spy = play("long.wav", policy: SegmentedDownloadPolicy(maximumConnections: 4, segmentSize: 20000))
+
+        XCTAssertNil(spy.error)
+        XCTAssertEqual(spy.data, file)
+    }
+
+    func test_Files_Without_Ranges_Are_Downloaded_By_A_Single_Request() {
+        StaticFileURLProtocol.serve("long.wav", data: [file], headers: ["Accept-Ranges": "none"])
+
+        let spy = play("long.wav", policy: SegmentedDownloadPolicy(maximumConnections: 4, segmentSize: 20000))
+
+        XCTAssertEqual(spy.data, file)
+        XCTAssertEqual(StaticFileURLProtocol.requestCount("long.wav"), 1)
+    }
+
+    // MARK: Helpers
+
+    private func makeDownload(policy: SegmentedDownloadPolicy,
+                              perform: ((@escaping () -> Void) -> Void)? = nil) -> SegmentedDownload
+    {
+        let configuration = URLSessionConfiguration.ephemeral
+        configuration.protocolClasses = [StaticFileURLProtocol.self]
+        let queue = self.queue
+        return SegmentedDownload(networking: NetworkingClient(configuration: configuration),
+                                 policy: policy,
+                                 fileLength: file.count,
+                                 offset: 0,
+                                 request: URLRequest(url: URL(string: "https://\(StaticFileURLProtocol.host)/long.wav")!),
+                                 perform: perform ?? { block in queue.async(execute: block) })
+    }
+
+    private func play(_ name: String, policy: SegmentedDownloadPolicy) -> SourceDelegateSpy {
+        let configuration = URLSessionConfiguration.ephemeral
+        configuration.protocolClasses = [StaticFileURLProtocol.self]
+        let source = RemoteAudioSource(networking: NetworkingClient(configuration: configuration),
+                                       url: URL(string: "https://\(StaticFileURLProtocol.host)/\(name)")!,
+                                       underlyingQueue: queue,
+                                       httpHeaders: [:],
+                                       segmentedDownloadPolicy: policy)
+        let spy = SourceDelegateSpy(ended: expectation(description: "ended"))
+        queue.sync {
+            source.delegate = spy
+            source.seek(at: 0)
+        }
+        wait(for: [spy.ended], timeout: 5)
+        return spy
+    }
+
+    private func waitForRequests() {
+        let waited = expectation(description: "requested")
+        DispatchQueue.global().asyncAfter(deadline: .now() + 0.3) {
+            waited.fulfill()
+        }
+        wait(for: [waited], timeout: 5)
+    }
+}
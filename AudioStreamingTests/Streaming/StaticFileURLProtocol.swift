@@ -0,0 +1,205 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import Foundation
+import XCTest
+
+@testable import AudioStreaming
+
+/// Serves the fixtures of the test bundle for requests to `StaticFileURLProtocol.host`, honouring `Range` headers,
+/// standing in for a static file server. Fixtures are sent in small chunks, as a network would.
+final class StaticFileURLProtocol: URLProtocol {
+    static let host = "hls.test"
+    private static let chunkSize = 1000
+    private static let contentTypes = ["m4a": "audio/x-m4a", "mp3": "audio/mpeg"]
+
+    private static let lock = NSLock()
+    /// Bodies served instead of fixtures, in turn, the last one is served for the following requests
+    private static var bodies: [String: [Data]] = [:]
+    /// Files served as live streams, without a length and ignoring `Range` headers
+    private static var liveNames: Set<String> = []
+    /// The headers added to the responses of each file
+    private static var extraHeaders: [String: [String: String]] = [:]
+    /// The transport error failing the requests of each file, once the given bytes of the body are sent, before the
+    /// response for `0`
+    private static var failures: [String: (code: URLError.Code, offset: Int)] = [:]
+    /// The `Range` header of the requests of each file, empty for whole file requests
+    private static var requests: [String: [String]] = [:]
+
+    static func serve(_ name: String, bodies: [String]) {
+        serve(name, data: bodies.map { Data($0.utf8) })
+    }
+
+    static func serve(_ name: String, data: [Data], live: Bool = false, headers: [String: String] = [:]) {
+        lock.lock(); defer { lock.unlock() }
+        bodies[name] = data
+        if live {
+            liveNames.insert(name)
+        }
+        extraHeaders[name] = headers
+    }
+
+    /// Fails the requests of the given file with a transport error, once the given bytes of its body are sent
+    static func fail(_ name: String, with code: URLError.Code, after offset: Int = 0) {
+        lock.lock(); defer { lock.unlock() }
+        failures[name] = (code, offset)
+    }
+
+    static func requestCount(_ name: String) -> Int {
+        lock.lock(); defer { lock.unlock() }
+        return requests[name]?.count ?? 0
+    }
+
+    static func requestedRanges(_ name: String) -> [String] {
+        lock.lock(); defer { lock.unlock() }
+        return (requests[name] ?? []).filter { !$0.isEmpty }
+    }
+
+    static func reset() {
+        lock.lock(); defer { lock.unlock() }
+        bodies.removeAll()
+        liveNames.removeAll()
+        extraHeaders.removeAll()
+        failures.removeAll()
+        requests.removeAll()
+    }
+
+    override class func canInit(with request: URLRequest) -> Bool {
+        request.url?.host == host
+    }
+
+    override class func canonicalRequest(for request: URLRequest) -> URLRequest {
+        request
+    }
+
+    override func startLoading() {
+        guard let url = request.url else { return }
+        let name = url.lastPathComponent
+        let rangeHeader = request.value(forHTTPHeaderField: "Range")
+        let failure = StaticFileURLProtocol.failure(for: name)
+        if let failure = failure, failure.offset == 0 {
+            StaticFileURLProtocol.record(name, range: rangeHeader)
+            client?.urlProtocol(self, didFailWithError: URLError(failure.code))
+            return
+        }
+        guard let data = StaticFileURLProtocol.body(for: name, range: rangeHeader) else {
+            let response = HTTPURLResponse(url: url, statusCode: 404, httpVersion: "HTTP/1.1", headerFields: nil)!
+            client?.urlProtocol(self, didReceive: response, cacheStoragePolicy: .notAllowed)
+            client?.urlProtocolDidFinishLoading(self)
+            return
+        }
+        let isLive = StaticFileURLProtocol.isLive(name)
+        let range = isLive ? nil : StaticFileURLProtocol.range(from: rangeHeader, length: data.count)
+        let body = data.subdata(in: range ?? 0 ..< data.count)
+        var headers = ["Content-Type": StaticFileURLProtocol.contentTypes[url.pathExtension] ?? "application/octet-stream"]
+        if isLive {
+            headers["Cache-Control"] = "no-cache"
+            headers["icy-name"] = "Test Radio"
+        } else {
+            headers["Content-Length"] = "\(body.count)"
+            headers["Accept-Ranges"] = "bytes"
+        }
+        headers.merge(StaticFileURLProtocol.headers(for: name)) { _, extra in extra }
+        if let range = range {
+            headers["Content-Range"] = "bytes \(range.lowerBound)-\(range.upperBound - 1)/\(data.count)"
+        }
+        let response = HTTPURLResponse(url: url,
+                                       statusCode: range == nil ? 200 : 206,
+                                       httpVersion: "HTTP/1.1",
+                                       headerFields: headers)!
+        client?.urlProtocol(self, didReceive: response, cacheStoragePolicy: .notAllowed)
+        let sent = min(failure?.offset ?? body.count, body.count)
+        for offset in stride(from: 0, to: sent, by: StaticFileURLProtocol.chunkSize) {
+            let end = min(offset + StaticFileURLProtocol.chunkSize, sent)
+            client?.urlProtocol(self, didLoad: body.subdata(in: offset ..< end))
+        }
+        if let failure = failure {
+            client?.urlProtocol(self, didFailWithError: URLError(failure.code))
+            return
+        }
+        client?.urlProtocolDidFinishLoading(self)
+    }
+
+    override func stopLoading() {}
+
+    private static func record(_ name: String, range: String?) {
+        lock.lock(); defer { lock.unlock() }
+        requests[name, default: []].append(range ?? "")
+    }
+
+    private static func failure(for name: String) -> (code: URLError.Code, offset: Int)? {
+        lock.lock(); defer { lock.unlock() }
+        return failures[name]
+    }
+
+    private static func body(for name: String, range: String?) -> Data? {
+        record(name, range: range)
+        lock.lock(); defer { lock.unlock() }
+
+        if var served = bodies[name], let body = served.first {
+            if served.count > 1 {
+                served.removeFirst()
+                bodies[name] = served
+            }
+            return body
+        }
+        let bundle = Bundle(for: StaticFileURLProtocol.self)
+        guard let url = bundle.url(forResource: (name as NSString).deletingPathExtension,
+                                   withExtension: (name as NSString).pathExtension)
+        else { return nil }
+        return try? Data(contentsOf: url)
+    }
+
+    private static func headers(for name: String) -> [String: String] {
+        lock.lock(); defer { lock.unlock() }
+        return extraHeaders[name] ?? [:]
+    }
+
+    private static func isLive(_ name: String) -> Bool {
+        lock.lock(); defer { lock.unlock() }
+        return liveNames.contains(name)
+    }
+
+    /// The range of a `bytes=lower-upper` or open ended `bytes=lower-` header
+    private static func range(from header: String?, length: Int) -> Range<Int>? {
+        guard let bounds = header?.replacingOccurrences(of: "bytes=", with: "").components(separatedBy: "-"),
+              bounds.count == 2, let lower = Int(bounds[0])
+        else { return nil }
+        let upper = Int(bounds[1]).map { min($0 + 1, length) } ?? length
+        return min(lower, upper) ..< upper
+    }
+}
+
+/// Collects the data delivered by an `AudioStreamSource`
+final class SourceDelegateSpy: AudioStreamSourceDelegate {
+    var data = Data()
+    var metadata: [[String: String]] = []
+    /// The bytes of data delivered before each metadata
+    var metadataOffsets: [Int] = []
+    var error: Error?
+    var ended: XCTestExpectation
+
+    init(ended: XCTestExpectation) {
+        self.ended = ended
+    }
+
+    func dataAvailable(source _: CoreAudioStreamSource, data: Data) {
+        self.data.append(data)
+    }
+
+    func errorOccured(source _: CoreAudioStreamSource, error: Error) {
+        self.error = error
+        ended.fulfill()
+    }
+
+    func endOfFileOccured(source _: CoreAudioStreamSource) {
+        ended.fulfill()
+    }
+
+    func metadataReceived(data: [String: String]) {
+        metadata.append(data)
+        metadataOffsets.append(self.data.count)
+    }
+}
@@ -0,0 +1,97 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import XCTest
+
+@testable import AudioStreaming
+
+class StreamRecorderTests: XCTestCase {
+    private var directory: URL!
+
+    override func setUpWithError() throws {
+        try super.setUpWithError()
+        directory = FileManager.default.temporaryDirectory.appendingPathComponent("stream-recorder-\(UUID().uuidString)")
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+    }
+
+    override func tearDownWithError() throws {
+        try FileManager.default.removeItem(at: directory)
+        try super.tearDownWithError()
+    }
+
+    func test_Records_Audio_As_Received() throws {
+        let recorder = try StreamRecorder(url: directory.appendingPathComponent("radio.mp3"), batchSize: 4096)
+        let audio = Data((0 ..< 50000).map { UInt8(truncatingIfNeeded: $0 * 31) })
+
+        for offset in stride(from: 0, to: audio.count, by: 1000) {
+            recorder.record(audio.subdata(in: offset ..< min(offset + 1000, audio.count)))
+        }
+        finish(recorder)
+
+        XCTAssertEqual(try Data(contentsOf: recorder.url), audio)
+        XCTAssertEqual(recorder.writtenBytes, audio.count)
+        XCTAssertEqual(recorder.droppedBytes, 0)
+    }
+
+    func test_Records_Metadata_At_Audio_Offsets() throws {
+        let recorder = try StreamRecorder(url: directory.appendingPathComponent("radio.mp3"),
+                                          metadataURL: directory.appendingPathComponent("radio.jsonl"))
+
+        recorder.record(metadata: ["StreamTitle": "First"])
+        recorder.record(Data(count: 3000))
+        recorder.record(metadata: ["StreamTitle": "Second"])
+        finish(recorder)
+
+        let lines = try String(contentsOf: try XCTUnwrap(recorder.metadataURL)).split(separator: "\n")
+        let entries = try lines.map { line in
+            try XCTUnwrap(JSONSerialization.jsonObject(with: Data(line.utf8)) as? [String: Any])
+        }
+        XCTAssertEqual(entries.map { $0["offset"] as? Int }, [0, 3000])
+        XCTAssertEqual(entries.map { ($0["metadata"] as? [String: String])?["StreamTitle"] }, ["First", "Second"])
+        XCTAssertNotNil(entries.first?["time"] as? Double)
+    }
+
+    func test_Drops_Audio_Once_Pending_Bytes_Exceed_Maximum() throws {
+        // nothing is written until a batch is complete, so the pending bytes only grow
+        let recorder = try StreamRecorder(url: directory.appendingPathComponent("radio.mp3"),
+                                          batchSize: 10000,
+                                          maximumPendingBytes: 10000)
+
+        recorder.record(Data(repeating: 1, count: 6000))
+        recorder.record(Data(repeating: 2, count: 6000))
+        recorder.record(Data(repeating: 3, count: 4000))
+        finish(recorder)
+
+        XCTAssertEqual(recorder.droppedBytes, 6000)
+        XCTAssertEqual(try Data(contentsOf: recorder.url),
+                       Data(repeating: 1, count: 6000) + Data(repeating: 3, count: 4000))
+    }
+
+    func test_Nothing_Is_Recorded_Once_Finished() throws {
+        let recorder = try StreamRecorder(url: directory.appendingPathComponent("radio.mp3"))
+
+        recorder.record(Data(count: 100))
+        finish(recorder)
+        recorder.record(Data(count: 100))
+        finish(recorder)
+
+        XCTAssertEqual(try Data(contentsOf: recorder.url).count, 100)
+    }
+
+    func test_Fails_For_Unwritable_Location() {
+        let url = directory.appendingPathComponent("missing/radio.mp3")
+        XCTAssertThrowsError(try StreamRecorder(url: url))
+    }
+
+    // MARK: Helpers
+
+    private func finish(_ recorder: StreamRecorder) {
+        let finished = expectation(description: "finished")
+        recorder.finish {
+            finished.fulfill()
+        }
+        wait(for: [finished], timeout: 5)
+    }
+}
@@ -0,0 +1,256 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+import XCTest
+
+@testable import AudioStreaming
+
+class TimeShiftBufferTests: XCTestCase {
+    private let queue = DispatchQueue(label: "time.shift.buffer.tests")
+    private var time: TimeInterval = 0
+
+    override func setUp() {
+        super.setUp()
+        time = 0
+        StaticFileURLProtocol.reset()
+    }
+
+    override func tearDown() {
+        StaticFileURLProtocol.reset()
+        super.tearDown()
+    }
+
+    // MARK: Buffer
+
+    func test_Reads_Audio_Across_The_End_Of_The_Ring() throws {
+        let buffer = try makeBuffer(capacity: 100)
+        let audio = bytes(count: 120)
+
+        buffer.append(audio.prefix(60))
+        buffer.append(audio.suffix(from: 60))
+
+        XCTAssertEqual(buffer.range, 20 ..< 120)
+        XCTAssertEqual(buffer.data(in: 20 ..< 120), audio.suffix(from: 20))
+        XCTAssertEqual(buffer.data(in: 90 ..< 110), audio.subdata(in: 90 ..< 110))
+        // evicted audio isn't read
+        XCTAssertEqual(buffer.data(in: 0 ..< 30), audio.subdata(in: 20 ..< 30))
+    }
+
+    func test_Keeps_The_Last_Capacity_Bytes_Of_Large_Appends() throws {
+        let buffer = try makeBuffer(capacity: 100)
+        let audio = bytes(count: 250)
+
+        buffer.append(audio)
+
+        XCTAssertEqual(buffer.range, 150 ..< 250)
+        XCTAssertEqual(buffer.data(in: buffer.range), audio.suffix(100))
+    }
+
+    func test_Maps_Seconds_Behind_Live_To_Offsets() throws {
+        let buffer = try makeBuffer(capacity: 10000)
+        appendSeconds(10, of: 100, to: buffer)
+
+        XCTAssertEqual(buffer.duration, 9)
+        XCTAssertEqual(buffer.offset(secondsBehindLive: 0), 1000)
+        XCTAssertEqual(buffer.offset(secondsBehindLive: 3), 600)
+        XCTAssertEqual(buffer.offset(secondsBehindLive: 2.5), 650)
+        XCTAssertEqual(buffer.offset(secondsBehindLive: 60), 0)
+        XCTAssertEqual(buffer.secondsBehindLive(at: 650), 2.5, accuracy: 0.001)
+        XCTAssertEqual(buffer.secondsBehindLive(at: 1000), 0)
+    }
+
+    func test_Evicts_Oldest_Audio_And_Its_Time() throws {
+        let buffer = try makeBuffer(capacity: 500)
+        appendSeconds(10, of: 100, to: buffer)
+
+        XCTAssertEqual(buffer.range, 500 ..< 1000)
+        XCTAssertEqual(buffer.duration, 4)
+        XCTAssertEqual(buffer.offset(secondsBehindLive: 60), 500)
+        XCTAssertEqual(buffer.offset(secondsBehindLive: 2), 700)
+    }
+
+    // MARK: Remote source
+
+    func test_Live_Stream_Is_Delivered_From_Time_Shift_Buffer() throws {
+        let audio = try fixture()
+        StaticFileURLProtocol.serve("radio.mp3", data: [audio], live: true)
+
+        let (source, spy) = play("radio.mp3", timeShiftBufferSize: 1024 * 1024)
+
+        XCTAssertNil(spy.error)
+        XCTAssertEqual(spy.data, audio)
+        queue.sync {
+            XCTAssertEqual(source.timeShiftBuffer?.range, 0 ..< audio.count)
+            XCTAssertEqual(source.position, audio.count)
+            XCTAssertEqual(source.length, 0)
+        }
+
+        // seeking rewinds within the buffer rather than requesting the stream again
+        spy.data = Data()
+        spy.ended = expectation(description: "ended after seek")
+        queue.sync {
+            source.seek(at: 1000)
+        }
+        wait(for: [spy.ended], timeout: 5)
+        XCTAssertEqual(spy.data, audio.suffix(from: 1000))
+        XCTAssertEqual(StaticFileURLProtocol.requestCount("radio.mp3"), 1)
+    }
+
+    func test_Suspended_Live_Stream_Delivers_Nothing_Until_Resumed() throws {
+        let audio = try fixture()
+        StaticFileURLProtocol.serve("radio.mp3", data: [audio], live: true)
+        let (source, spy) = play("radio.mp3", timeShiftBufferSize: 1024 * 1024)
+
+        spy.data = Data()
+        spy.ended = expectation(description: "ended after resume")
+        queue.sync {
+            source.seek(at: 0)
+            source.suspend()
+        }
+        queue.sync {}
+        XCTAssertTrue(spy.data.isEmpty)
+
+        source.resume()
+        wait(for: [spy.ended], timeout: 5)
+        XCTAssertEqual(spy.data, audio)
+    }
+
+    func test_Live_Stream_Larger_Than_Buffer_Keeps_Its_End() throws {
+        let audio = try fixture()
+        StaticFileURLProtocol.serve("radio.mp3", data: [audio], live: true)
+
+        let (source, spy) = play("radio.mp3", timeShiftBufferSize: 4096)
+
+        XCTAssertEqual(spy.data, audio)
+        queue.sync {
+            XCTAssertEqual(source.timeShiftBuffer?.range, audio.count - 4096 ..< audio.count)
+        }
+    }
+
+    func test_Live_Stream_Is_Kept_While_The_Player_Is_Paused_With_A_Full_Buffer() throws {
+        let audio = try fixture()
+        StaticFileURLProtocol.serve("radio.mp3", data: [audio], live: true)
+        let source = makeSource("radio.mp3", timeShiftBufferSize: 4096)
+        // the player blocks the delivery until it has room for more audio
+        let player = PausedPlayerSpy()
+        queue.sync {
+            source.delegate = player
+            source.seek(at: 0)
+        }
+        XCTAssertEqual(player.delivered.wait(timeout: .now() + 5), .success)
+
+        let kept = expectation(for: NSPredicate { _, _ in
+            source.timeShiftBuffer?.range.upperBound == audio.count
+        }, evaluatedWith: nil)
+        wait(for: [kept], timeout: 5)
+        XCTAssertEqual(source.timeShiftBuffer?.range, audio.count - 4096 ..< audio.count)
+        player.resume()
+    }
+
+    func test_Reads_Racing_Appends_Return_Kept_Audio_Only() throws {
+        let buffer = try makeBuffer(capacity: 1000)
+        let audio = bytes(count: 100 * 1000)
+        let appending = DispatchQueue(label: "time.shift.buffer.tests.appending")
+        appending.async {
+            for offset in stride(from: 0, to: audio.count, by: 100) {
+                buffer.append(audio.subdata(in: offset ..< offset + 100))
+            }
+        }
+
+        var reads = 0
+        while buffer.range.upperBound < audio.count {
+            let range = buffer.range
+            let data = buffer.data(in: range)
+            // the audio evicted meanwhile is trimmed rather than read overwritten
+            let start = range.upperBound - data.count
+            XCTAssertEqual(data, audio.subdata(in: start ..< range.upperBound))
+            reads += 1
+        }
+        appending.sync {}
+        XCTAssertGreaterThan(reads, 0)
+    }
+
+    func test_Files_Are_Not_Time_Shifted() throws {
+        let audio = try fixture()
+        StaticFileURLProtocol.serve("episode.mp3", data: [audio])
+
+        let (source, spy) = play("episode.mp3", timeShiftBufferSize: 1024 * 1024)
+
+        XCTAssertEqual(spy.data, audio)
+        queue.sync {
+            XCTAssertNil(source.timeShiftBuffer)
+        }
+    }
+
+    // MARK: Helpers
+
+    private func makeBuffer(capacity: Int) throws -> TimeShiftBuffer {
+        try TimeShiftBuffer(capacity: capacity, now: { [unowned self] in self.time })
+    }
+
+    /// Appends the given bytes a second, starting at the current time
+    private func appendSeconds(_ seconds: Int, of count: Int, to buffer: TimeShiftBuffer) {
+        for _ in 0 ..< seconds {
+            buffer.append(bytes(count: count))
+            time += 1
+        }
+        time -= 1
+    }
+
+    private func bytes(count: Int) -> Data {
+        Data((0 ..< count).map { UInt8(truncatingIfNeeded: $0 * 7) })
+    }
+
+    private func play(_ name: String, timeShiftBufferSize: Int) -> (RemoteAudioSource, SourceDelegateSpy) {
+        let source = makeSource(name, timeShiftBufferSize: timeShiftBufferSize)
+        let spy = SourceDelegateSpy(ended: expectation(description: "ended"))
+        queue.sync {
+            source.delegate = spy
+            source.seek(at: 0)
+        }
+        wait(for: [spy.ended], timeout: 5)
+        return (source, spy)
+    }
+
+    private func makeSource(_ name: String, timeShiftBufferSize: Int) -> RemoteAudioSource {
+        let configuration = URLSessionConfiguration.ephemeral
+        configuration.protocolClasses = [StaticFileURLProtocol.self]
+        return RemoteAudioSource(networking: NetworkingClient(configuration: configuration),
+                                 url: URL(string: "https://\(StaticFileURLProtocol.host)/\(name)")!,
+                                 underlyingQueue: queue,
+                                 httpHeaders: [:],
+                                 timeShiftBufferSize: timeShiftBufferSize)
+    }
+
+    private func fixture() throws -> Data {
+        let bundle = Bundle(for: TimeShiftBufferTests.self)
+        let url = try XCTUnwrap(bundle.url(forResource: "sine-1khz-44100-stereo", withExtension: "mp3"))
+        return try Data(contentsOf: url)
+    }
+}
+
+/// Stands in for a paused player with a full buffer, the first delivery waits until it's resumed
+private final class PausedPlayerSpy: AudioStreamSourceDelegate {
+    let delivered = DispatchSemaphore(value: 0)
+    private let resumed = DispatchSemaphore(value: 0)
+    private var isWaiting = true
+
+    func resume() {
+        resumed.signal()
+    }
+
+    func dataAvailable(source _: CoreAudioStreamSource, data _: Data) {
+        guard isWaiting else { return }
+        isWaiting = false
+        delivered.signal()
+        resumed.wait()
+    }
+
+    func errorOccured(source _: CoreAudioStreamSource, error _: Error) {}
+
+    func endOfFileOccured(source _: CoreAudioStreamSource) {}
+
+    func metadataReceived(data _: [String: String]) {}
+}
@@ -0,0 +1,1199 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+#include "AudioStreamingVorbis.h"
+#include "VorbisMDCT.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define AS_VORBIS_MAX_CHANNELS 8
+#define AS_VORBIS_FAST_BITS 10
+#define AS_VORBIS_FLOOR1_MAX_VALUES 65
+
+// MARK: - Bit reader
+
+/// Vorbis packs values starting from the least significant bit of each byte
+typedef struct {
+    const uint8_t *data;
+    size_t size;
+    /// The position in bits
+    size_t position;
+    bool end_of_packet;
+} bit_reader;
+
+static inline size_t remaining_bits(const bit_reader *reader) {
+    return reader->size * 8 - reader->position;
+}
+
+/// Loads the 32 bits starting at the current position, zero filled past the end
+static inline uint32_t peek_bits(const bit_reader *reader) {
+    size_t byte = reader->position >> 3;
+    uint64_t window = 0;
+    for (size_t i = 0; i < 5 && byte + i < reader->size; i++) {
+        window |= (uint64_t)reader->data[byte + i] << (8 * i);
+    }
+    return (uint32_t)(window >> (reader->position & 7));
+}
+
+/// Reads up to 32 bits
+static inline uint32_t read_bits(bit_reader *reader, unsigned count) {
+    if (count == 0) {
+        return 0;
+    }
+    if (count > remaining_bits(reader)) {
+        reader->end_of_packet = true;
+        reader->position = reader->size * 8;
+        return 0;
+    }
+    uint32_t value = peek_bits(reader);
+    if (count < 32) {
+        value &= (1u << count) - 1;
+    }
+    reader->position += count;
+    return value;
+}
+
+static inline bool read_flag(bit_reader *reader) {
+    return read_bits(reader, 1) != 0;
+}
+
+/// The number of bits needed to store the value
+static inline unsigned ilog(uint32_t value) {
+    return value == 0 ? 0 : 32 - (unsigned)__builtin_clz(value);
+}
+
+static float unpack_float(uint32_t value) {
+    double mantissa = value & 0x1FFFFF;
+    int exponent = (int)((value >> 21) & 0x3FF);
+    if (value & 0x80000000u) {
+        mantissa = -mantissa;
+    }
+    return (float)ldexp(mantissa, exponent - 788);
+}
+
+// MARK: - Setup structures
+
+typedef struct {
+    uint32_t dimensions;
+    uint32_t entries;
+    uint8_t *lengths;
+    /// The codewords in reading order, by entry
+    uint32_t *codewords;
+    /// Entries of the codewords up to `AS_VORBIS_FAST_BITS` long, indexed by the next bits of the packet
+    int32_t fast[1 << AS_VORBIS_FAST_BITS];
+    /// The codewords with the first bit as the most significant, ascending, for the longer codewords
+    uint32_t sorted_count;
+    uint32_t *sorted_codewords;
+    uint32_t *sorted_entries;
+    /// The value vectors by entry, `NULL` when the codebook has no lookup
+    float *vectors;
+} codebook;
+
+typedef struct {
+    uint8_t partitions;
+    uint8_t partition_class[32];
+    uint8_t class_dimensions[16];
+    uint8_t class_subclasses[16];
+    uint8_t class_masterbook[16];
+    int16_t subclass_books[16][8];
+    uint8_t multiplier;
+    uint8_t values;
+    uint16_t x[AS_VORBIS_FLOOR1_MAX_VALUES];
+    /// The value indices in ascending order of x
+    uint8_t sorted[AS_VORBIS_FLOOR1_MAX_VALUES];
+    uint8_t low_neighbor[AS_VORBIS_FLOOR1_MAX_VALUES];
+    uint8_t high_neighbor[AS_VORBIS_FLOOR1_MAX_VALUES];
+} floor1;
+
+typedef struct {
+    uint16_t type;
+    uint32_t begin;
+    uint32_t end;
+    uint32_t partition_size;
+    uint8_t classifications;
+    uint8_t classbook;
+    int16_t books[64][8];
+} residue;
+
+typedef struct {
+    uint8_t submaps;
+    uint16_t coupling_steps;
+    uint8_t *magnitudes;
+    uint8_t *angles;
+    uint8_t mux[AS_VORBIS_MAX_CHANNELS];
+    uint8_t submap_floor[16];
+    uint8_t submap_residue[16];
+} mapping;
+
+typedef struct {
+    bool block_flag;
+    uint8_t mapping;
+} mode;
+
+struct as_vorbis_decoder {
+    as_vorbis_info info;
+
+    unsigned codebook_count;
+    codebook *codebooks;
+    unsigned floor_count;
+    floor1 *floors;
+    unsigned residue_count;
+    residue *residues;
+    unsigned mapping_count;
+    mapping *mappings;
+    unsigned mode_count;
+    mode modes[64];
+    unsigned mode_bits;
+
+    /// The rising slope of the short and long windows
+    float *slopes[2];
+    as_vorbis_mdct mdct[2];
+
+    /// The spectrum, and then the block, of each channel
+    float *spectrum[AS_VORBIS_MAX_CHANNELS];
+    float *block[AS_VORBIS_MAX_CHANNELS];
+    /// The second half of the previous block, to overlap with the next one
+    float *previous[AS_VORBIS_MAX_CHANNELS];
+    unsigned previous_size;
+
+    float *interleaved_residue;
+    uint8_t *classifications;
+    size_t classifications_per_channel;
+    float floor_table[256];
+};
+
+// MARK: - Headers
+
+static const uint8_t vorbis_signature[6] = {'v', 'o', 'r', 'b', 'i', 's'};
+
+bool as_vorbis_is_header(const uint8_t *packet, size_t size, uint8_t type) {
+    return size >= 7 && packet[0] == type && memcmp(packet + 1, vorbis_signature, 6) == 0;
+}
+
+bool as_vorbis_parse_identification(const uint8_t *packet, size_t size, as_vorbis_info *info) {
+    if (size < 30 || !as_vorbis_is_header(packet, size, 1)) {
+        return false;
+    }
+    const uint8_t *bytes = packet + 7;
+    uint32_t version = (uint32_t)bytes[0] | (uint32_t)bytes[1] << 8 | (uint32_t)bytes[2] << 16 | (uint32_t)bytes[3] << 24;
+    info->channels = bytes[4];
+    info->sample_rate = (uint32_t)bytes[5] | (uint32_t)bytes[6] << 8 | (uint32_t)bytes[7] << 16 | (uint32_t)bytes[8] << 24;
+    info->nominal_bitrate = (int32_t)((uint32_t)bytes[13] | (uint32_t)bytes[14] << 8 | (uint32_t)bytes[15] << 16 | (uint32_t)bytes[16] << 24);
+    if (info->nominal_bitrate < 0) {
+        info->nominal_bitrate = 0;
+    }
+    unsigned short_exponent = bytes[21] & 0x0F;
+    unsigned long_exponent = bytes[21] >> 4;
+    info->block_sizes[0] = (uint16_t)(1u << short_exponent);
+    info->block_sizes[1] = (uint16_t)(1u << long_exponent);
+    return version == 0 && info->channels > 0 && info->sample_rate > 0 && short_exponent >= 6 && long_exponent <= 13 &&
+           short_exponent <= long_exponent && (bytes[22] & 0x01);
+}
+
+// MARK: - Codebooks
+
+static uint32_t reverse_bits(uint32_t value) {
+    value = ((value & 0xAAAAAAAAu) >> 1) | ((value & 0x55555555u) << 1);
+    value = ((value & 0xCCCCCCCCu) >> 2) | ((value & 0x33333333u) << 2);
+    value = ((value & 0xF0F0F0F0u) >> 4) | ((value & 0x0F0F0F0Fu) << 4);
+    value = ((value & 0xFF00FF00u) >> 8) | ((value & 0x00FF00FFu) << 8);
+    return (value >> 16) | (value << 16);
+}
+
+/// The number of values per dimension of a lookup type 1 codebook, the largest value whose power of the dimensions fits the entries
+static uint32_t lookup1_values(uint32_t entries, uint32_t dimensions) {
+    uint32_t values = (uint32_t)floor(pow((double)entries, 1.0 / dimensions));
+    for (;;) {
+        double next = pow((double)(values + 1), (double)dimensions);
+        if (next <= entries) {
+            values++;
+        } else if (pow((double)values, (double)dimensions) > entries) {
+            values--;
+        } else {
+            return values;
+        }
+    }
+}
+
+static int compare_tagged_codewords(const void *lhs, const void *rhs) {
+    uint64_t a = *(const uint64_t *)lhs;
+    uint64_t b = *(const uint64_t *)rhs;
+    return a < b ? -1 : a > b;
+}
+
+/// Assigns the codewords in entry order, each taking the lowest value still available for its length
+static bool build_codewords(codebook *book) {
+    uint32_t available[33] = {0};
+    uint32_t used = 0;
+    for (uint32_t entry = 0; entry < book->entries; entry++) {
+        unsigned length = book->lengths[entry];
+        if (length == 0) {
+            continue;
+        }
+        uint32_t codeword;
+        if (used == 0) {
+            codeword = 0;
+            for (unsigned i = 1; i <= length; i++) {
+                available[i] = 1u << (32 - i);
+            }
+        } else {
+            unsigned z = length;
+            while (z > 0 && available[z] == 0) {
+                z--;
+            }
+            if (z == 0) {
+                return false;
+            }
+            codeword = available[z];
+            available[z] = 0;
+            for (unsigned y = length; y > z; y--) {
+                available[y] = codeword + (1u << (32 - y));
+            }
+        }
+        book->codewords[entry] = reverse_bits(codeword);
+        used++;
+    }
+
+    for (int i = 0; i < (1 << AS_VORBIS_FAST_BITS); i++) {
+        book->fast[i] = -1;
+    }
+    if (used == 1) {
+        // a single entry decodes from any bits
+        for (uint32_t entry = 0; entry < book->entries; entry++) {
+            if (book->lengths[entry] != 0) {
+                for (int i = 0; i < (1 << AS_VORBIS_FAST_BITS); i++) {
+                    book->fast[i] = (int32_t)entry;
+                }
+            }
+        }
+        return true;
+    }
+
+    uint32_t long_count = 0;
+    for (uint32_t entry = 0; entry < book->entries; entry++) {
+        unsigned length = book->lengths[entry];
+        if (length == 0) {
+            continue;
+        }
+        if (length <= AS_VORBIS_FAST_BITS) {
+            for (uint32_t i = book->codewords[entry]; i < (1u << AS_VORBIS_FAST_BITS); i += 1u << length) {
+                book->fast[i] = (int32_t)entry;
+            }
+        } else {
+            long_count++;
+        }
+    }
+    if (long_count == 0) {
+        return true;
+    }
+
+    // the longer codewords are found with a binary search, tagged with their entry to sort them together
+    uint64_t *tagged = malloc(sizeof(uint64_t) * long_count);
+    book->sorted_codewords = malloc(sizeof(uint32_t) * long_count);
+    book->sorted_entries = malloc(sizeof(uint32_t) * long_count);
+    if (!tagged || !book->sorted_codewords || !book->sorted_entries) {
+        free(tagged);
+        return false;
+    }
+    uint32_t index = 0;
+    for (uint32_t entry = 0; entry < book->entries; entry++) {
+        if (book->lengths[entry] > AS_VORBIS_FAST_BITS) {
+            tagged[index++] = (uint64_t)reverse_bits(book->codewords[entry]) << 32 | entry;
+        }
+    }
+    qsort(tagged, long_count, sizeof(uint64_t), compare_tagged_codewords);
+    for (uint32_t i = 0; i < long_count; i++) {
+        book->sorted_codewords[i] = (uint32_t)(tagged[i] >> 32);
+        book->sorted_entries[i] = (uint32_t)tagged[i];
+    }
+    book->sorted_count = long_count;
+    free(tagged);
+    return true;
+}
+
+static bool parse_codebook(bit_reader *reader, codebook *book) {
+    if (read_bits(reader, 24) != 0x564342) {
+        return false;
+    }
+    book->dimensions = read_bits(reader, 16);
+    book->entries = read_bits(reader, 24);
+    if (book->dimensions == 0 || book->entries == 0) {
+        return false;
+    }
+    book->lengths = calloc(book->entries, 1);
+    book->codewords = calloc(book->entries, sizeof(uint32_t));
+    if (!book->lengths || !book->codewords) {
+        return false;
+    }
+
+    if (!read_flag(reader)) {
+        bool sparse = read_flag(reader);
+        for (uint32_t entry = 0; entry < book->entries; entry++) {
+            if (!sparse || read_flag(reader)) {
+                book->lengths[entry] = (uint8_t)(read_bits(reader, 5) + 1);
+            }
+        }
+    } else {
+        // ordered lengths, runs of entries of increasing lengths
+        uint32_t entry = 0;
+        unsigned length = read_bits(reader, 5) + 1;
+        while (entry < book->entries) {
+            uint32_t count = read_bits(reader, ilog(book->entries - entry));
+            if (length > 32 || count > book->entries - entry || reader->end_of_packet) {
+                return false;
+            }
+            memset(book->lengths + entry, (int)length, count);
+            entry += count;
+            length++;
+        }
+    }
+    if (reader->end_of_packet) {
+        return false;
+    }
+
+    unsigned lookup = read_bits(reader, 4);
+    if (lookup == 1 || lookup == 2) {
+        float minimum = unpack_float(read_bits(reader, 32));
+        float delta = unpack_float(read_bits(reader, 32));
+        unsigned value_bits = read_bits(reader, 4) + 1;
+        bool sequence = read_flag(reader);
+        uint64_t vector_count = (uint64_t)book->entries * book->dimensions;
+        if (vector_count > (1u << 22)) {
+            return false;
+        }
+        uint32_t count = lookup == 1 ? lookup1_values(book->entries, book->dimensions) : (uint32_t)vector_count;
+        uint32_t *multiplicands = malloc(sizeof(uint32_t) * (count > 0 ? count : 1));
+        book->vectors = malloc(sizeof(float) * vector_count);
+        if (!multiplicands || !book->vectors) {
+            free(multiplicands);
+            return false;
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            multiplicands[i] = read_bits(reader, value_bits);
+        }
+        if (reader->end_of_packet || count == 0) {
+            free(multiplicands);
+            return false;
+        }
+        for (uint32_t entry = 0; entry < book->entries; entry++) {
+            float last = 0;
+            uint64_t divisor = 1;
+            for (uint32_t i = 0; i < book->dimensions; i++) {
+                uint32_t offset = lookup == 1 ? (uint32_t)((entry / divisor) % count) : entry * book->dimensions + i;
+                float value = (float)multiplicands[offset] * delta + minimum + last;
+                book->vectors[entry * book->dimensions + i] = value;
+                if (sequence) {
+                    last = value;
+                }
+                if (divisor <= UINT32_MAX) {
+                    divisor *= count;
+                }
+            }
+        }
+        free(multiplicands);
+    } else if (lookup != 0) {
+        return false;
+    }
+    return build_codewords(book);
+}
+
+static void free_codebook(codebook *book) {
+    free(book->lengths);
+    free(book->codewords);
+    free(book->sorted_codewords);
+    free(book->sorted_entries);
+    free(book->vectors);
+}
+
+/// Decodes the next entry of the codebook
+///
+/// - Returns: The entry, or `-1` at the end of the packet or for an invalid codeword
+static inline int32_t decode_entry(bit_reader *reader, const codebook *book) {
+    uint32_t bits = peek_bits(reader);
+    int32_t entry = book->fast[bits & ((1u << AS_VORBIS_FAST_BITS) - 1)];
+    if (entry < 0) {
+        if (book->sorted_count == 0) {
+            reader->end_of_packet = true;
+            return -1;
+        }
+        uint32_t key = reverse_bits(bits);
+        uint32_t low = 0;
+        uint32_t high = book->sorted_count;
+        while (high - low > 1) {
+            uint32_t middle = (low + high) / 2;
+            if (book->sorted_codewords[middle] <= key) {
+                low = middle;
+            } else {
+                high = middle;
+            }
+        }
+        uint32_t candidate = book->sorted_entries[low];
+        uint32_t codeword = book->sorted_codewords[low];
+        unsigned length = book->lengths[candidate];
+        if (codeword > key || (length < 32 && ((key ^ codeword) >> (32 - length)) != 0)) {
+            reader->end_of_packet = true;
+            return -1;
+        }
+        entry = (int32_t)candidate;
+    }
+    unsigned length = book->lengths[entry];
+    if (length > remaining_bits(reader)) {
+        reader->end_of_packet = true;
+        reader->position = reader->size * 8;
+        return -1;
+    }
+    reader->position += length;
+    return entry;
+}
+
+// MARK: - Floors, residues, mappings and modes
+
+static bool parse_floor(bit_reader *reader, floor1 *floor, unsigned codebook_count) {
+    if (read_bits(reader, 16) != 1) {
+        // floor type 0 is obsolete and not produced by any current encoder
+        return false;
+    }
+    floor->partitions = (uint8_t)read_bits(reader, 5);
+    int max_class = -1;
+    for (unsigned i = 0; i < floor->partitions; i++) {
+        floor->partition_class[i] = (uint8_t)read_bits(reader, 4);
+        if (floor->partition_class[i] > max_class) {
+            max_class = floor->partition_class[i];
+        }
+    }
+    for (int i = 0; i <= max_class; i++) {
+        floor->class_dimensions[i] = (uint8_t)(read_bits(reader, 3) + 1);
+        floor->class_subclasses[i] = (uint8_t)read_bits(reader, 2);
+        if (floor->class_subclasses[i]) {
+            floor->class_masterbook[i] = (uint8_t)read_bits(reader, 8);
+            if (floor->class_masterbook[i] >= codebook_count) {
+                return false;
+            }
+        }
+        for (int j = 0; j < (1 << floor->class_subclasses[i]); j++) {
+            floor->subclass_books[i][j] = (int16_t)((int)read_bits(reader, 8) - 1);
+            if (floor->subclass_books[i][j] >= (int)codebook_count) {
+                return false;
+            }
+        }
+    }
+    floor->multiplier = (uint8_t)(read_bits(reader, 2) + 1);
+    unsigned range_bits = read_bits(reader, 4);
+    floor->x[0] = 0;
+    floor->x[1] = (uint16_t)(1u << range_bits);
+    floor->values = 2;
+    for (unsigned i = 0; i < floor->partitions; i++) {
+        unsigned dimensions = floor->class_dimensions[floor->partition_class[i]];
+        for (unsigned j = 0; j < dimensions; j++) {
+            if (floor->values >= AS_VORBIS_FLOOR1_MAX_VALUES) {
+                return false;
+            }
+            floor->x[floor->values++] = (uint16_t)read_bits(reader, range_bits);
+        }
+    }
+    if (reader->end_of_packet) {
+        return false;
+    }
+
+    for (unsigned i = 0; i < floor->values; i++) {
+        floor->sorted[i] = (uint8_t)i;
+    }
+    for (unsigned i = 1; i < floor->values; i++) {
+        uint8_t value = floor->sorted[i];
+        unsigned j = i;
+        while (j > 0 && floor->x[floor->sorted[j - 1]] > floor->x[value]) {
+            floor->sorted[j] = floor->sorted[j - 1];
+            j--;
+        }
+        floor->sorted[j] = value;
+    }
+    for (unsigned i = 1; i < floor->values; i++) {
+        if (floor->x[floor->sorted[i]] == floor->x[floor->sorted[i - 1]]) {
+            return false;
+        }
+    }
+    for (unsigned i = 2; i < floor->values; i++) {
+        int low = -1;
+        int high = -1;
+        for (unsigned j = 0; j < i; j++) {
+            if (floor->x[j] < floor->x[i] && (low < 0 || floor->x[j] > floor->x[low])) {
+                low = (int)j;
+            }
+            if (floor->x[j] > floor->x[i] && (high < 0 || floor->x[j] < floor->x[high])) {
+                high = (int)j;
+            }
+        }
+        floor->low_neighbor[i] = (uint8_t)low;
+        floor->high_neighbor[i] = (uint8_t)high;
+    }
+    return true;
+}
+
+static bool parse_residue(bit_reader *reader, residue *residue, const codebook *codebooks, unsigned codebook_count) {
+    residue->type = (uint16_t)read_bits(reader, 16);
+    if (residue->type > 2) {
+        return false;
+    }
+    residue->begin = read_bits(reader, 24);
+    residue->end = read_bits(reader, 24);
+    residue->partition_size = read_bits(reader, 24) + 1;
+    residue->classifications = (uint8_t)(read_bits(reader, 6) + 1);
+    residue->classbook = (uint8_t)read_bits(reader, 8);
+    if (residue->classbook >= codebook_count) {
+        return false;
+    }
+    uint8_t cascade[64];
+    for (unsigned i = 0; i < residue->classifications; i++) {
+        unsigned low = read_bits(reader, 3);
+        unsigned high = read_flag(reader) ? read_bits(reader, 5) : 0;
+        cascade[i] = (uint8_t)(high << 3 | low);
+    }
+    for (unsigned i = 0; i < residue->classifications; i++) {
+        for (unsigned pass = 0; pass < 8; pass++) {
+            residue->books[i][pass] = -1;
+            if (cascade[i] & (1u << pass)) {
+                unsigned book = read_bits(reader, 8);
+                if (book >= codebook_count || codebooks[book].vectors == NULL) {
+                    return false;
+                }
+                residue->books[i][pass] = (int16_t)book;
+            }
+        }
+    }
+    return !reader->end_of_packet;
+}
+
+static bool parse_mapping(bit_reader *reader, mapping *mapping, unsigned channels, unsigned floor_count, unsigned residue_count) {
+    if (read_bits(reader, 16) != 0) {
+        return false;
+    }
+    mapping->submaps = read_flag(reader) ? (uint8_t)(read_bits(reader, 4) + 1) : 1;
+    if (read_flag(reader)) {
+        mapping->coupling_steps = (uint16_t)(read_bits(reader, 8) + 1);
+        mapping->magnitudes = malloc(mapping->coupling_steps);
+        mapping->angles = malloc(mapping->coupling_steps);
+        if (!mapping->magnitudes || !mapping->angles) {
+            return false;
+        }
+        unsigned bits = ilog(channels - 1);
+        for (unsigned i = 0; i < mapping->coupling_steps; i++) {
+            mapping->magnitudes[i] = (uint8_t)read_bits(reader, bits);
+            mapping->angles[i] = (uint8_t)read_bits(reader, bits);
+            if (mapping->magnitudes[i] == mapping->angles[i] || mapping->magnitudes[i] >= channels || mapping->angles[i] >= channels) {
+                return false;
+            }
+        }
+    }
+    if (read_bits(reader, 2) != 0) {
+        return false;
+    }
+    for (unsigned i = 0; i < channels; i++) {
+        mapping->mux[i] = mapping->submaps > 1 ? (uint8_t)read_bits(reader, 4) : 0;
+        if (mapping->mux[i] >= mapping->submaps) {
+            return false;
+        }
+    }
+    for (unsigned i = 0; i < mapping->submaps; i++) {
+        read_bits(reader, 8);
+        mapping->submap_floor[i] = (uint8_t)read_bits(reader, 8);
+        mapping->submap_residue[i] = (uint8_t)read_bits(reader, 8);
+        if (mapping->submap_floor[i] >= floor_count || mapping->submap_residue[i] >= residue_count) {
+            return false;
+        }
+    }
+    return !reader->end_of_packet;
+}
+
+static bool parse_setup(as_vorbis_decoder *decoder, bit_reader *reader) {
+    reader->position = 7 * 8;
+
+    decoder->codebook_count = read_bits(reader, 8) + 1;
+    decoder->codebooks = calloc(decoder->codebook_count, sizeof(codebook));
+    if (!decoder->codebooks) {
+        return false;
+    }
+    for (unsigned i = 0; i < decoder->codebook_count; i++) {
+        if (!parse_codebook(reader, &decoder->codebooks[i])) {
+            return false;
+        }
+    }
+
+    // time domain transforms are placeholders, always zero
+    unsigned time_count = read_bits(reader, 6) + 1;
+    for (unsigned i = 0; i < time_count; i++) {
+        if (read_bits(reader, 16) != 0) {
+            return false;
+        }
+    }
+
+    decoder->floor_count = read_bits(reader, 6) + 1;
+    decoder->floors = calloc(decoder->floor_count, sizeof(floor1));
+    if (!decoder->floors) {
+        return false;
+    }
+    for (unsigned i = 0; i < decoder->floor_count; i++) {
+        if (!parse_floor(reader, &decoder->floors[i], decoder->codebook_count)) {
+            return false;
+        }
+    }
+
+    decoder->residue_count = read_bits(reader, 6) + 1;
+    decoder->residues = calloc(decoder->residue_count, sizeof(residue));
+    if (!decoder->residues) {
+        return false;
+    }
+    for (unsigned i = 0; i < decoder->residue_count; i++) {
+        if (!parse_residue(reader, &decoder->residues[i], decoder->codebooks, decoder->codebook_count)) {
+            return false;
+        }
+    }
+
+    decoder->mapping_count = read_bits(reader, 6) + 1;
+    decoder->mappings = calloc(decoder->mapping_count, sizeof(mapping));
+    if (!decoder->mappings) {
+        return false;
+    }
+    for (unsigned i = 0; i < decoder->mapping_count; i++) {
+        if (!parse_mapping(reader, &decoder->mappings[i], decoder->info.channels, decoder->floor_count, decoder->residue_count)) {
+            return false;
+        }
+    }
+
+    decoder->mode_count = read_bits(reader, 6) + 1;
+    for (unsigned i = 0; i < decoder->mode_count; i++) {
+        decoder->modes[i].block_flag = read_flag(reader);
+        unsigned window_type = read_bits(reader, 16);
+        unsigned transform_type = read_bits(reader, 16);
+        decoder->modes[i].mapping = (uint8_t)read_bits(reader, 8);
+        if (window_type != 0 || transform_type != 0 || decoder->modes[i].mapping >= decoder->mapping_count) {
+            return false;
+        }
+    }
+    decoder->mode_bits = ilog(decoder->mode_count - 1);
+    return read_flag(reader) && !reader->end_of_packet;
+}
+
+// MARK: - Decoder
+
+as_vorbis_decoder *as_vorbis_decoder_create(const uint8_t *identification,
+                                            size_t identification_size,
+                                            const uint8_t *setup,
+                                            size_t setup_size) {
+    as_vorbis_info info;
+    if (!as_vorbis_parse_identification(identification, identification_size, &info) || info.channels > AS_VORBIS_MAX_CHANNELS ||
+        !as_vorbis_is_header(setup, setup_size, 5)) {
+        return NULL;
+    }
+    as_vorbis_decoder *decoder = calloc(1, sizeof(as_vorbis_decoder));
+    if (!decoder) {
+        return NULL;
+    }
+    decoder->info = info;
+    bit_reader reader = {setup, setup_size, 0, false};
+    if (!parse_setup(decoder, &reader)) {
+        as_vorbis_decoder_destroy(decoder);
+        return NULL;
+    }
+
+    const unsigned long_size = info.block_sizes[1];
+    for (int i = 0; i < 2; i++) {
+        unsigned half = info.block_sizes[i] / 2;
+        decoder->slopes[i] = malloc(sizeof(float) * half);
+        if (!decoder->slopes[i] || !as_vorbis_mdct_init(&decoder->mdct[i], info.block_sizes[i])) {
+            as_vorbis_decoder_destroy(decoder);
+            return NULL;
+        }
+        for (unsigned j = 0; j < half; j++) {
+            double x = sin((j + 0.5) / half * M_PI / 2);
+            decoder->slopes[i][j] = (float)sin(M_PI / 2 * x * x);
+        }
+    }
+    for (unsigned channel = 0; channel < info.channels; channel++) {
+        decoder->spectrum[channel] = malloc(sizeof(float) * long_size / 2);
+        decoder->block[channel] = malloc(sizeof(float) * long_size);
+        decoder->previous[channel] = malloc(sizeof(float) * long_size / 2);
+        if (!decoder->spectrum[channel] || !decoder->block[channel] || !decoder->previous[channel]) {
+            as_vorbis_decoder_destroy(decoder);
+            return NULL;
+        }
+    }
+
+    // room for the classifications of the most partitions any residue reads
+    size_t classifications = 0;
+    for (unsigned i = 0; i < decoder->residue_count; i++) {
+        const residue *residue = &decoder->residues[i];
+        size_t size = residue->type == 2 ? (size_t)long_size / 2 * info.channels : long_size / 2;
+        size_t partitions = size / residue->partition_size + decoder->codebooks[residue->classbook].dimensions;
+        if (partitions > classifications) {
+            classifications = partitions;
+        }
+    }
+    decoder->classifications_per_channel = classifications;
+    decoder->classifications = malloc(classifications * info.channels);
+    decoder->interleaved_residue = malloc(sizeof(float) * long_size / 2 * info.channels);
+    if (!decoder->classifications || !decoder->interleaved_residue) {
+        as_vorbis_decoder_destroy(decoder);
+        return NULL;
+    }
+
+    // the floor amplitudes are a 0.5 dB scale over 255 steps
+    for (int i = 0; i < 256; i++) {
+        decoder->floor_table[i] = (float)pow(1.0649863, i - 255);
+    }
+    return decoder;
+}
+
+void as_vorbis_decoder_destroy(as_vorbis_decoder *decoder) {
+    if (!decoder) {
+        return;
+    }
+    if (decoder->codebooks) {
+        for (unsigned i = 0; i < decoder->codebook_count; i++) {
+            free_codebook(&decoder->codebooks[i]);
+        }
+    }
+    if (decoder->mappings) {
+        for (unsigned i = 0; i < decoder->mapping_count; i++) {
+            free(decoder->mappings[i].magnitudes);
+            free(decoder->mappings[i].angles);
+        }
+    }
+    free(decoder->codebooks);
+    free(decoder->floors);
+    free(decoder->residues);
+    free(decoder->mappings);
+    for (int i = 0; i < 2; i++) {
+        free(decoder->slopes[i]);
+        as_vorbis_mdct_free(&decoder->mdct[i]);
+    }
+    for (unsigned channel = 0; channel < AS_VORBIS_MAX_CHANNELS; channel++) {
+        free(decoder->spectrum[channel]);
+        free(decoder->block[channel]);
+        free(decoder->previous[channel]);
+    }
+    free(decoder->classifications);
+    free(decoder->interleaved_residue);
+    free(decoder);
+}
+
+const as_vorbis_info *as_vorbis_decoder_info(const as_vorbis_decoder *decoder) {
+    return &decoder->info;
+}
+
+void as_vorbis_decoder_reset(as_vorbis_decoder *decoder) {
+    decoder->previous_size = 0;
+}
+
+unsigned as_vorbis_packet_block_size(const as_vorbis_decoder *decoder, const uint8_t *packet, size_t size) {
+    bit_reader reader = {packet, size, 0, false};
+    if (size == 0 || read_flag(&reader)) {
+        return 0;
+    }
+    unsigned mode = read_bits(&reader, decoder->mode_bits);
+    if (reader.end_of_packet || mode >= decoder->mode_count) {
+        return 0;
+    }
+    return decoder->info.block_sizes[decoder->modes[mode].block_flag];
+}
+
+// MARK: - Floor decoding
+
+/// Decodes the floor values of a channel
+///
+/// - Returns: `false` when the floor is unused, the channel is then silent
+static bool decode_floor(bit_reader *reader, const floor1 *floor, const codebook *codebooks, int *values) {
+    static const int ranges[4] = {256, 128, 86, 64};
+    if (!read_flag(reader)) {
+        return false;
+    }
+    unsigned bits = ilog((uint32_t)ranges[floor->multiplier - 1] - 1);
+    values[0] = (int)read_bits(reader, bits);
+    values[1] = (int)read_bits(reader, bits);
+    unsigned offset = 2;
+    for (unsigned i = 0; i < floor->partitions; i++) {
+        unsigned class = floor->partition_class[i];
+        unsigned dimensions = floor->class_dimensions[class];
+        unsigned subclass_bits = floor->class_subclasses[class];
+        unsigned subclass_mask = (1u << subclass_bits) - 1;
+        int32_t selector = 0;
+        if (subclass_bits) {
+            selector = decode_entry(reader, &codebooks[floor->class_masterbook[class]]);
+            if (selector < 0) {
+                return false;
+            }
+        }
+        for (unsigned j = 0; j < dimensions; j++) {
+            int book = floor->subclass_books[class][selector & subclass_mask];
+            selector >>= subclass_bits;
+            if (book >= 0) {
+                int32_t value = decode_entry(reader, &codebooks[book]);
+                if (value < 0) {
+                    return false;
+                }
+                values[offset + j] = value;
+            } else {
+                values[offset + j] = 0;
+            }
+        }
+        offset += dimensions;
+    }
+    return !reader->end_of_packet;
+}
+
+static inline int render_point(int x0, int y0, int x1, int y1, int x) {
+    int dy = y1 - y0;
+    int adx = x1 - x0;
+    int offset = abs(dy) * (x - x0) / adx;
+    return dy < 0 ? y0 - offset : y0 + offset;
+}
+
+static inline float floor_amplitude(const float *table, int y) {
+    return table[y < 0 ? 0 : (y > 255 ? 255 : y)];
+}
+
+static void render_line(int x0, int y0, int x1, int y1, float *curve, int count, const float *table) {
+    int dy = y1 - y0;
+    int adx = x1 - x0;
+    int ady = abs(dy);
+    int base = dy / adx;
+    int step = dy < 0 ? base - 1 : base + 1;
+    int y = y0;
+    int error = 0;
+    ady -= abs(base) * adx;
+    if (x0 < count) {
+        curve[x0] = floor_amplitude(table, y);
+    }
+    int end = x1 < count ? x1 : count;
+    for (int x = x0 + 1; x < end; x++) {
+        error += ady;
+        if (error >= adx) {
+            error -= adx;
+            y += step;
+        } else {
+            y += base;
+        }
+        curve[x] = floor_amplitude(table, y);
+    }
+}
+
+/// Turns the decoded floor values into the curve of the spectrum
+static void synthesize_floor(const floor1 *floor, const int *values, const float *table, float *curve, int count) {
+    static const int ranges[4] = {256, 128, 86, 64};
+    const int range = ranges[floor->multiplier - 1];
+    int final[AS_VORBIS_FLOOR1_MAX_VALUES];
+    bool used[AS_VORBIS_FLOOR1_MAX_VALUES];
+    final[0] = values[0];
+    final[1] = values[1];
+    used[0] = used[1] = true;
+    for (unsigned i = 2; i < floor->values; i++) {
+        unsigned low = floor->low_neighbor[i];
+        unsigned high = floor->high_neighbor[i];
+        int predicted = render_point(floor->x[low], final[low], floor->x[high], final[high], floor->x[i]);
+        int value = values[i];
+        int high_room = range - predicted;
+        int low_room = predicted;
+        int room = (high_room < low_room ? high_room : low_room) * 2;
+        if (value != 0) {
+            used[low] = used[high] = used[i] = true;
+            if (value >= room) {
+                final[i] = high_room > low_room ? value - low_room + predicted : predicted - value + high_room - 1;
+            } else if (value & 1) {
+                final[i] = predicted - (value + 1) / 2;
+            } else {
+                final[i] = predicted + value / 2;
+            }
+        } else {
+            used[i] = false;
+            final[i] = predicted;
+        }
+    }
+
+    int lx = 0;
+    int ly = final[floor->sorted[0]] * floor->multiplier;
+    for (unsigned i = 1; i < floor->values; i++) {
+        unsigned index = floor->sorted[i];
+        if (used[index]) {
+            int hx = floor->x[index];
+            int hy = final[index] * floor->multiplier;
+            render_line(lx, ly, hx, hy, curve, count, table);
+            lx = hx;
+            ly = hy;
+        }
+    }
+    for (int x = lx; x < count; x++) {
+        curve[x] = floor_amplitude(table, ly);
+    }
+}
+
+// MARK: - Residue decoding
+
+/// Decodes the partitions of the vectors, format 0 interleaves the values of a codeword across the partition, format 1 places them in order
+///
+/// - Returns: `false` at the end of the packet, the remaining values then stay zero
+static bool decode_partitions(as_vorbis_decoder *decoder,
+                              bit_reader *reader,
+                              const residue *residue,
+                              float *const *vectors,
+                              const bool *skip,
+                              unsigned count,
+                              uint32_t size,
+                              int format) {
+    const codebook *classbook = &decoder->codebooks[residue->classbook];
+    const unsigned classwords = classbook->dimensions;
+    const uint32_t begin = residue->begin < size ? residue->begin : size;
+    const uint32_t end = residue->end < size ? residue->end : size;
+    if (end <= begin) {
+        return true;
+    }
+    const uint32_t partition_size = residue->partition_size;
+    const uint32_t partitions = (end - begin) / partition_size;
+    const size_t stride = decoder->classifications_per_channel;
+    uint8_t *classifications = decoder->classifications;
+
+    for (unsigned pass = 0; pass < 8; pass++) {
+        uint32_t partition = 0;
+        while (partition < partitions) {
+            if (pass == 0) {
+                for (unsigned channel = 0; channel < count; channel++) {
+                    if (skip[channel]) {
+                        continue;
+                    }
+                    int32_t value = decode_entry(reader, classbook);
+                    if (value < 0) {
+                        return false;
+                    }
+                    for (int i = (int)classwords - 1; i >= 0; i--) {
+                        if (partition + (uint32_t)i < stride) {
+                            classifications[channel * stride + partition + (uint32_t)i] = (uint8_t)(value % residue->classifications);
+                        }
+                        value /= residue->classifications;
+                    }
+                }
+            }
+            for (unsigned word = 0; word < classwords && partition < partitions; word++, partition++) {
+                for (unsigned channel = 0; channel < count; channel++) {
+                    if (skip[channel]) {
+                        continue;
+                    }
+                    int book_index = residue->books[classifications[channel * stride + partition]][pass];
+                    if (book_index < 0) {
+                        continue;
+                    }
+                    const codebook *book = &decoder->codebooks[book_index];
+                    const unsigned dimensions = book->dimensions;
+                    float *vector = vectors[channel] + begin + partition * partition_size;
+                    if (format == 0) {
+                        uint32_t step = partition_size / dimensions;
+                        for (uint32_t i = 0; i < step; i++) {
+                            int32_t entry = decode_entry(reader, book);
+                            if (entry < 0) {
+                                return false;
+                            }
+                            const float *values = book->vectors + (size_t)entry * dimensions;
+                            for (unsigned j = 0; j < dimensions; j++) {
+                                vector[i + j * step] += values[j];
+                            }
+                        }
+                    } else {
+                        uint32_t i = 0;
+                        while (i < partition_size) {
+                            int32_t entry = decode_entry(reader, book);
+                            if (entry < 0) {
+                                return false;
+                            }
+                            const float *values = book->vectors + (size_t)entry * dimensions;
+                            for (unsigned j = 0; j < dimensions && i < partition_size; j++, i++) {
+                                vector[i] += values[j];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+static void decode_residue(as_vorbis_decoder *decoder,
+                           bit_reader *reader,
+                           const residue *residue,
+                           float *const *vectors,
+                           const bool *skip,
+                           unsigned count,
+                           uint32_t size) {
+    if (residue->type != 2) {
+        decode_partitions(decoder, reader, residue, vectors, skip, count, size, residue->type == 0 ? 0 : 1);
+        return;
+    }
+
+    // type 2 decodes the channels interleaved into a single vector
+    bool decode = false;
+    for (unsigned channel = 0; channel < count; channel++) {
+        decode = decode || !skip[channel];
+    }
+    if (!decode) {
+        return;
+    }
+    float *interleaved = decoder->interleaved_residue;
+    const uint32_t total = size * count;
+    memset(interleaved, 0, sizeof(float) * total);
+    const bool no_skip = false;
+    decode_partitions(decoder, reader, residue, &interleaved, &no_skip, 1, total, 1);
+    for (unsigned channel = 0; channel < count; channel++) {
+        float *vector = vectors[channel];
+        for (uint32_t i = 0; i < size; i++) {
+            vector[i] = interleaved[i * count + channel];
+        }
+    }
+}
+
+// MARK: - Packets
+
+int as_vorbis_decode_packet(as_vorbis_decoder *decoder, const uint8_t *packet, size_t size, float *pcm) {
+    if (size == 0) {
+        return 0;
+    }
+    bit_reader reader = {packet, size, 0, false};
+    if (read_flag(&reader)) {
+        return -1;
+    }
+    unsigned mode_number = read_bits(&reader, decoder->mode_bits);
+    if (reader.end_of_packet || mode_number >= decoder->mode_count) {
+        return -1;
+    }
+    const mode *mode = &decoder->modes[mode_number];
+    const bool long_block = mode->block_flag;
+    bool previous_long = false;
+    bool next_long = false;
+    if (long_block) {
+        previous_long = read_flag(&reader);
+        next_long = read_flag(&reader);
+        if (reader.end_of_packet) {
+            return -1;
+        }
+    }
+    const unsigned n = decoder->info.block_sizes[long_block];
+    const unsigned half = n / 2;
+    const unsigned channels = decoder->info.channels;
+    const mapping *mapping = &decoder->mappings[mode->mapping];
+
+    // the floor curves are kept in the blocks until the spectrum is complete
+    bool floor_used[AS_VORBIS_MAX_CHANNELS];
+    bool skip[AS_VORBIS_MAX_CHANNELS];
+    for (unsigned channel = 0; channel < channels; channel++) {
+        const floor1 *floor = &decoder->floors[mapping->submap_floor[mapping->mux[channel]]];
+        int values[AS_VORBIS_FLOOR1_MAX_VALUES];
+        floor_used[channel] = decode_floor(&reader, floor, decoder->codebooks, values);
+        if (floor_used[channel]) {
+            synthesize_floor(floor, values, decoder->floor_table, decoder->block[channel], (int)half);
+        }
+        skip[channel] = !floor_used[channel];
+        memset(decoder->spectrum[channel], 0, sizeof(float) * half);
+    }
+    // coupled channels are decoded when either of them is used
+    for (unsigned i = 0; i < mapping->coupling_steps; i++) {
+        unsigned magnitude = mapping->magnitudes[i];
+        unsigned angle = mapping->angles[i];
+        if (!skip[magnitude] || !skip[angle]) {
+            skip[magnitude] = skip[angle] = false;
+        }
+    }
+
+    for (unsigned submap = 0; submap < mapping->submaps; submap++) {
+        float *vectors[AS_VORBIS_MAX_CHANNELS];
+        bool submap_skip[AS_VORBIS_MAX_CHANNELS];
+        unsigned count = 0;
+        for (unsigned channel = 0; channel < channels; channel++) {
+            if (mapping->mux[channel] == submap) {
+                vectors[count] = decoder->spectrum[channel];
+                submap_skip[count] = skip[channel];
+                count++;
+            }
+        }
+        const residue *residue = &decoder->residues[mapping->submap_residue[submap]];
+        decode_residue(decoder, &reader, residue, vectors, submap_skip, count, half);
+    }
+
+    for (int i = (int)mapping->coupling_steps - 1; i >= 0; i--) {
+        float *magnitudes = decoder->spectrum[mapping->magnitudes[i]];
+        float *angles = decoder->spectrum[mapping->angles[i]];
+        for (unsigned j = 0; j < half; j++) {
+            float magnitude = magnitudes[j];
+            float angle = angles[j];
+            if (magnitude > 0) {
+                if (angle > 0) {
+                    angles[j] = magnitude - angle;
+                } else {
+                    angles[j] = magnitude;
+                    magnitudes[j] = magnitude + angle;
+                }
+            } else {
+                if (angle > 0) {
+                    angles[j] = magnitude + angle;
+                } else {
+                    angles[j] = magnitude;
+                    magnitudes[j] = magnitude - angle;
+                }
+            }
+        }
+    }
+
+    const unsigned left = long_block && previous_long ? n : decoder->info.block_sizes[0];
+    const unsigned right = long_block && next_long ? n : decoder->info.block_sizes[0];
+    const float *left_slope = decoder->slopes[long_block && previous_long];
+    const float *right_slope = decoder->slopes[long_block && next_long];
+    const unsigned left_start = n / 4 - left / 4;
+    const unsigned right_start = n / 4 * 3 - right / 4;
+    for (unsigned channel = 0; channel < channels; channel++) {
+        float *spectrum = decoder->spectrum[channel];
+        float *block = decoder->block[channel];
+        if (!floor_used[channel]) {
+            memset(block, 0, sizeof(float) * n);
+            continue;
+        }
+        for (unsigned i = 0; i < half; i++) {
+            spectrum[i] *= block[i];
+        }
+        as_vorbis_imdct(&decoder->mdct[long_block], spectrum, block);
+        memset(block, 0, sizeof(float) * left_start);
+        for (unsigned i = 0; i < left / 2; i++) {
+            block[left_start + i] *= left_slope[i];
+        }
+        for (unsigned i = 0; i < right / 2; i++) {
+            block[right_start + i] *= right_slope[right / 2 - 1 - i];
+        }
+        memset(block + right_start + right / 2, 0, sizeof(float) * (n - right_start - right / 2));
+    }
+
+    // the samples from the centre of the previous block to the centre of this one are complete
+    int frames = 0;
+    const unsigned previous_size = decoder->previous_size;
+    if (previous_size) {
+        frames = (int)(previous_size / 4 + n / 4);
+        const int offset = (int)(n / 4) - (int)(previous_size / 4);
+        for (unsigned channel = 0; channel < channels; channel++) {
+            const float *previous = decoder->previous[channel];
+            const float *block = decoder->block[channel];
+            for (int k = 0; k < frames; k++) {
+                float sample = (unsigned)k < previous_size / 2 ? previous[k] : 0;
+                if (k + offset >= 0) {
+                    sample += block[k + offset];
+                }
+                pcm[(size_t)k * channels + channel] = sample;
+            }
+        }
+    }
+    for (unsigned channel = 0; channel < channels; channel++) {
+        memcpy(decoder->previous[channel], decoder->block[channel] + half, sizeof(float) * half);
+    }
+    decoder->previous_size = n;
+    return frames;
+}
@@ -0,0 +1,130 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+#include "VorbisMDCT.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+bool as_vorbis_mdct_init(as_vorbis_mdct *mdct, unsigned size) {
+    unsigned half = size / 2;
+    unsigned quarter = size / 4;
+    mdct->size = size;
+    mdct->rotation = malloc(sizeof(float) * 4 * quarter);
+    mdct->twiddle = malloc(sizeof(float) * quarter);
+    mdct->bit_reverse = malloc(sizeof(unsigned) * quarter);
+    mdct->scratch = malloc(sizeof(float) * half);
+    if (!mdct->rotation || !mdct->twiddle || !mdct->bit_reverse || !mdct->scratch) {
+        as_vorbis_mdct_free(mdct);
+        return false;
+    }
+
+    // pre rotation by exp(-iπn/M) and post rotation by exp(-iπ(k + 1/4)/M), M being half the block size
+    for (unsigned i = 0; i < quarter; i++) {
+        double pre = -M_PI * i / half;
+        double post = -M_PI * (i + 0.25) / half;
+        mdct->rotation[4 * i] = (float)cos(pre);
+        mdct->rotation[4 * i + 1] = (float)sin(pre);
+        mdct->rotation[4 * i + 2] = (float)cos(post);
+        mdct->rotation[4 * i + 3] = (float)sin(post);
+    }
+    for (unsigned i = 0; i < quarter / 2; i++) {
+        double angle = -2.0 * M_PI * i / quarter;
+        mdct->twiddle[2 * i] = (float)cos(angle);
+        mdct->twiddle[2 * i + 1] = (float)sin(angle);
+    }
+    unsigned bits = 0;
+    while ((1u << bits) < quarter) {
+        bits++;
+    }
+    for (unsigned i = 0; i < quarter; i++) {
+        unsigned reversed = 0;
+        for (unsigned bit = 0; bit < bits; bit++) {
+            reversed |= ((i >> bit) & 1) << (bits - 1 - bit);
+        }
+        mdct->bit_reverse[i] = reversed;
+    }
+    return true;
+}
+
+void as_vorbis_mdct_free(as_vorbis_mdct *mdct) {
+    free(mdct->rotation);
+    free(mdct->twiddle);
+    free(mdct->bit_reverse);
+    free(mdct->scratch);
+    mdct->rotation = NULL;
+    mdct->twiddle = NULL;
+    mdct->bit_reverse = NULL;
+    mdct->scratch = NULL;
+}
+
+/// An in place radix 2 forward FFT of the bit reversed values
+static void fft(const as_vorbis_mdct *mdct, float *values, unsigned count) {
+    for (unsigned span = 1; span < count; span <<= 1) {
+        unsigned stride = count / (span * 2);
+        for (unsigned start = 0; start < count; start += span * 2) {
+            for (unsigned i = 0; i < span; i++) {
+                float wr = mdct->twiddle[2 * i * stride];
+                float wi = mdct->twiddle[2 * i * stride + 1];
+                float *a = values + 2 * (start + i);
+                float *b = values + 2 * (start + i + span);
+                float br = b[0] * wr - b[1] * wi;
+                float bi = b[0] * wi + b[1] * wr;
+                b[0] = a[0] - br;
+                b[1] = a[1] - bi;
+                a[0] += br;
+                a[1] += bi;
+            }
+        }
+    }
+}
+
+void as_vorbis_imdct(const as_vorbis_mdct *mdct, const float *input, float *output) {
+    const unsigned half = mdct->size / 2;
+    const unsigned quarter = mdct->size / 4;
+    float *values = mdct->scratch;
+
+    // the DCT-IV of the coefficients, pairing the even values with the reversed odd ones
+    for (unsigned n = 0; n < quarter; n++) {
+        float re = input[2 * n];
+        float im = input[half - 1 - 2 * n];
+        float cr = mdct->rotation[4 * n];
+        float ci = mdct->rotation[4 * n + 1];
+        unsigned target = mdct->bit_reverse[n];
+        values[2 * target] = re * cr - im * ci;
+        values[2 * target + 1] = re * ci + im * cr;
+    }
+    fft(mdct, values, quarter);
+
+    // unfold the DCT-IV into the block, u[2k] = Re(c[k]) and u[M - 1 - 2k] = -Im(c[k])
+    const unsigned three_quarters = half + quarter;
+    for (unsigned k = 0; k < quarter; k++) {
+        float re = values[2 * k];
+        float im = values[2 * k + 1];
+        float cr = mdct->rotation[4 * k + 2];
+        float ci = mdct->rotation[4 * k + 3];
+        float even = re * cr - im * ci;
+        float odd = -(re * ci + im * cr);
+        unsigned positions[2] = {2 * k, half - 1 - 2 * k};
+        float samples[2] = {even, odd};
+        for (int j = 0; j < 2; j++) {
+            unsigned u = positions[j];
+            float sample = samples[j];
+            if (u >= quarter) {
+                output[u - quarter] = sample;
+            }
+            if (u < half) {
+                output[three_quarters - 1 - u] = -sample;
+            }
+            if (u < quarter) {
+                output[u + three_quarters] = -sample;
+            }
+        }
+    }
+}
@@ -0,0 +1,29 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+#ifndef VorbisMDCT_h
+#define VorbisMDCT_h
+
+#include <stdbool.h>
+
+/// The inverse MDCT of one block size, computed as a DCT-IV through a complex FFT of a quarter of the block size
+typedef struct {
+    unsigned size;
+    /// The pre and post rotation, interleaved complex values
+    float *rotation;
+    /// The FFT twiddle factors, interleaved complex values
+    float *twiddle;
+    unsigned *bit_reverse;
+    float *scratch;
+} as_vorbis_mdct;
+
+bool as_vorbis_mdct_init(as_vorbis_mdct *mdct, unsigned size);
+
+void as_vorbis_mdct_free(as_vorbis_mdct *mdct);
+
+/// Transforms `size / 2` coefficients into `size` samples
+void as_vorbis_imdct(const as_vorbis_mdct *mdct, const float *input, float *output);
+
+#endif /* VorbisMDCT_h */
@@ -0,0 +1,69 @@
+//
+//  Created by Dimitrios C on 16/10/2026.
+//  Copyright © 2026 Decimal. All rights reserved.
+//
+
+#ifndef AudioStreamingVorbis_h
+#define AudioStreamingVorbis_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/// A portable Vorbis I decoder, written in plain C so it builds and runs on any platform.
+/// Decodes one packet at a time into interleaved 32 bit float samples, streams using floor type 1 are supported,
+/// which covers every stream produced by libvorbis.
+
+typedef struct {
+    uint32_t sample_rate;
+    uint8_t channels;
+    /// The short and long block sizes
+    uint16_t block_sizes[2];
+    /// The nominal bitrate in bits per second, zero when not set
+    int32_t nominal_bitrate;
+} as_vorbis_info;
+
+/// Parses an identification header packet
+///
+/// - Returns: `true` when the packet is a valid identification header
+bool as_vorbis_parse_identification(const uint8_t *packet, size_t size, as_vorbis_info *info);
+
+/// Checks if the packet is a header packet of the given type, 1 identification, 3 comment and 5 setup
+bool as_vorbis_is_header(const uint8_t *packet, size_t size, uint8_t type);
+
+typedef struct as_vorbis_decoder as_vorbis_decoder;
+
+/// Creates a decoder from the identification and setup headers of a stream
+///
+/// - Returns: The decoder, or `NULL` if the headers are invalid, use an unsupported feature, or the memory couldn't be allocated
+as_vorbis_decoder *as_vorbis_decoder_create(const uint8_t *identification,
+                                            size_t identification_size,
+                                            const uint8_t *setup,
+                                            size_t setup_size);
+
+void as_vorbis_decoder_destroy(as_vorbis_decoder *decoder);
+
+/// The stream info of the decoder
+const as_vorbis_info *as_vorbis_decoder_info(const as_vorbis_decoder *decoder);
+
+/// Drops the overlap carried between packets, eg. after a seek
+void as_vorbis_decoder_reset(as_vorbis_decoder *decoder);
+
+/// The size of the block an audio packet decodes, without decoding it
+///
+/// - Returns: The block size, or `0` if the packet is not an audio packet of the stream
+unsigned as_vorbis_packet_block_size(const as_vorbis_decoder *decoder, const uint8_t *packet, size_t size);
+
+/// Decodes an audio packet
+///
+/// The samples returned by a packet are the overlap of its block with the block of the previous packet,
+/// the first packet after creating or resetting the decoder returns no samples.
+///
+/// - parameter decoder: The decoder
+/// - parameter packet: The bytes of the packet
+/// - parameter size: The size of the packet
+/// - parameter pcm: Receives interleaved samples, at most `block_sizes[1] / 2 * channels`
+/// - Returns: The number of samples per channel written, or `-1` if the packet is invalid.
+int as_vorbis_decode_packet(as_vorbis_decoder *decoder, const uint8_t *packet, size_t size, float *pcm);
+
+#endif /* AudioStreamingVorbis_h */
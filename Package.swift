@@ -2,22 +2,61 @@
 
 import PackageDescription
 
+/// The decoders are plain C and build on any platform, the player needs AVFoundation.
+var products: [Product] = [
+    .library(
+        name: "AudioStreamingDecoders",
+        targets: ["AudioStreamingMP3", "AudioStreamingFLAC", "AudioStreamingVorbis"]
+    ),
+]
+
+var targets: [Target] = [
+    .target(
+        name: "AudioStreamingAtomics",
+        path: "AudioStreamingAtomics"
+    ),
+    .target(
+        name: "AudioStreamingMP3",
+        path: "AudioStreamingMP3"
+    ),
+    .target(
+        name: "AudioStreamingFLAC",
+        path: "AudioStreamingFLAC"
+    ),
+    .target(
+        name: "AudioStreamingVorbis",
+        path: "AudioStreamingVorbis"
+    ),
+    .testTarget(
+        name: "AudioStreamingDecodersTests",
+        dependencies: ["AudioStreamingMP3"],
+        path: "AudioStreamingDecodersTests",
+        resources: [.copy("Fixtures")]
+    ),
+]
+
+#if canImport(AVFoundation)
+products.append(
+    .library(
+        name: "AudioStreaming",
+        targets: ["AudioStreaming"]
+    )
+)
+targets.append(
+    .target(
+        name: "AudioStreaming",
+        dependencies: ["AudioStreamingAtomics", "AudioStreamingMP3", "AudioStreamingFLAC", "AudioStreamingVorbis"],
+        path: "AudioStreaming"
+    )
+)
+#endif
+
 let package = Package(
     name: "AudioStreaming",
     platforms: [
         .iOS(.v12),
     ],
-    products: [
-        .library(
-            name: "AudioStreaming",
-            targets: ["AudioStreaming"]
-        ),
-    ],
-    targets: [
-        .target(
-            name: "AudioStreaming",
-            path: "AudioStreaming"
-        )
-    ],
+    products: products,
+    targets: targets,
     swiftLanguageVersions: [.v5]
 )